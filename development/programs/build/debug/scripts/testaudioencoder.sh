@@ -0,0 +1,14 @@
+#!/bin/bash
+
+# Script to execute "testaudioencoder" program.
+#
+# Parameters:
+#   1 - PCM device to capture from. (Optional, ALSA "null" device is used if not informed)
+#
+# Version: 0.1
+# Author: Marcelo Leite
+
+# Defines the input and output directories for program execution.
+source "$(dirname ${BASH_SOURCE})/set_input_output_directories.sh";
+
+$(dirname $BASH_SOURCE)/bin/testaudioencoder ${1};
@@ -1,6 +1,6 @@
 #!/bin/bash
 
-# Script to execute "store_instant" program.
+# Script to execute "testfiletail" program.
 #
 # Version: 0.1
 # Author: Marcelo Leite
@@ -19,8 +19,4 @@ then
     fi;
 fi;
 
-${command_preffix} $(dirname ${BASH_SOURCE})/bin/store_instant "${OUTPUT_DIRECTORY}temporary/current_instant";
-
-program_exit_code=${?};
-echo "Program finished with value "${program_exit_code}".";
-exit ${program_exit_code};
+${command_preffix} $(dirname $BASH_SOURCE)/bin/testfiletail;
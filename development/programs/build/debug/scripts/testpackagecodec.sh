@@ -0,0 +1,14 @@
+#!/bin/bash
+
+# Script to execute "testpackagecodec" program.
+#
+# Parameters
+#   1 - Path of a file with the results of a previous execution to compare with. (Optional)
+#
+# Version: 0.1
+# Author: Marcelo Leite
+
+# Defines the input and output directories for program execution.
+source "$(dirname ${BASH_SOURCE})/set_input_output_directories.sh";
+
+$(dirname $BASH_SOURCE)/bin/testpackagecodec "$@";
@@ -128,6 +128,7 @@ build_release() {
     local source_files_directory;
     local output_files_directory;
     local makefile_target;
+    local additional_compile_flags;
     local build_programs_result;
 
     # Checks function parameters.
@@ -141,7 +142,10 @@ build_release() {
         makefile_target="${3}";
     fi;
 
-    build_programs "${source_files_directory}release/" "${output_files_directory}" "${makefile_target}";
+    # Trace points are removed from release programs.
+    additional_compile_flags="-DLOG_COMPILE_LEVEL=110";
+
+    build_programs "${source_files_directory}release/" "${output_files_directory}" "${makefile_target}" "${additional_compile_flags}";
     build_programs_result=${?};
     if [ ${build_programs_result} -ne 0 ];
     then
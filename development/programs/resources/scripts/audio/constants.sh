@@ -48,15 +48,3 @@ if [ -z "${audio_pipe_file}" ];
 then
     readonly audio_pipe_file="${temporary_directory}audio_pipe";
 fi;
-
-# Path to file which stores audio capture start instant.
-if [ -z "${audio_start_instant_file}" ];
-then
-    readonly audio_start_instant_file="${temporary_directory}start_audio_instant";
-fi;
-
-# Path to file which stores audio capture store instant.
-if [ -z "${audio_stop_instant_file}" ];
-then
-    readonly audio_stop_instant_file="${temporary_directory}stop_audio_instant";
-fi;
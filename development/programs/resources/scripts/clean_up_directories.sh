@@ -280,15 +280,6 @@ clean_up_audio_directory() {
         return ${generic_error};
     fi;
 
-    # Remove the latest audio record file.
-    mv "${latest_audio_record_file_name_file}" "${trash_directory}";
-    command_result=${?};
-    if [ ${command_result} -ne 0 ];
-    then
-        log ${log_message_type_error} "Error while removing latest audio file name file: ${command_result}.";
-        return ${generic_error};
-    fi;
-
     return ${success};
 }
 
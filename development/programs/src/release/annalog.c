@@ -0,0 +1,549 @@
+/*
+ * Source file of the binary log decoder program (a. k. a. Annalog).
+ *
+ * Converts binary log files written by the programs back to the text log format.
+ *
+ * Usage:
+ *  annalog [-l level] [-f function] [-t thread] file...
+ *
+ * Arguments:
+ *  -l - Inform the minimum level of the messages printed. Current valid values are "TRACE" (default), "WARNING" and "ERROR".
+ *  -f - Inform the function which messages must be printed. If not informed, messages of all functions are printed.
+ *  -t - Inform the identifier of the thread which messages must be printed. If not informed, messages of all threads are printed.
+ *
+ * Observations
+ *  This program is executed on the host which reads the log files, so it does not write log files itself and does not use log macros.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "binary_log.h"
+#include "log.h"
+#include "parameters.h"
+#include "return_codes.h"
+
+
+/*
+ * Macros.
+ */
+
+/* The argument used to define the function which messages must be printed. */
+#define PARAMETER_FUNCTION "-f"
+
+/* The argument used to define the thread which messages must be printed. */
+#define PARAMETER_THREAD "-t"
+
+/* Number of call sites added to the call site table each time it is full. */
+#define CALL_SITE_TABLE_INCREMENT 256
+
+/* Size of the buffer used to format an instant. */
+#define INSTANT_BUFFER_SIZE 32
+
+
+/*
+ * Structures.
+ */
+
+/* Call sites defined on a binary log file, indexed by their identifiers. */
+typedef struct {
+    log_call_site_t* call_sites;
+    bool* defined;
+    size_t size;
+} call_site_table_t;
+
+
+/*
+ * Variables.
+ */
+
+/* Minimum level of the messages printed. */
+int minimum_message_type = LOG_MESSAGE_TYPE_TRACE;
+
+/* Function which messages must be printed, or NULL to print messages of all functions. */
+char* function_filter = NULL;
+
+/* Identifier of the thread which messages must be printed (zero prints messages of all threads). */
+uint32_t thread_filter = 0;
+
+
+/*
+ * Function headers.
+ */
+
+/* Defines a call site on the call site table. */
+int add_call_site(call_site_table_t*, uint32_t, log_call_site_t);
+
+/* Removes all call sites of the call site table. */
+void clear_call_site_table(call_site_table_t*);
+
+/* Decodes a binary log file. */
+int decode_binary_log_file(const char*);
+
+/* Decodes the binary logs stored on a buffer. */
+int decode_binary_logs(const char*, const uint8_t*, size_t);
+
+/* Formats an instant (in nanoseconds since epoch) the same way text log files do. */
+void format_instant(char*, int64_t);
+
+/* Returns the preffix used to identify a message type. */
+const char* get_message_preffix(int);
+
+/* Prints the program usage. */
+void print_usage(const char*);
+
+/* Prints a message record as a text log line. */
+void print_record(const log_call_site_t*, uint32_t, int64_t, const uint8_t*, size_t);
+
+/* Reads the content of a file. */
+uint8_t* read_file(const char*, size_t*);
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Defines a call site on the call site table.
+ *
+ * Parameters
+ *  call_site_table - The call site table.
+ *  call_site_identifier - The identifier of the call site.
+ *  call_site - The call site decoded. The table becomes responsible for its strings.
+ *
+ * Returns
+ *  SUCCESS - If the call site was defined successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int add_call_site(call_site_table_t* call_site_table, uint32_t call_site_identifier, log_call_site_t call_site) {
+
+    log_call_site_t* call_sites;
+    bool* defined;
+    size_t size;
+
+    if ( call_site_identifier >= call_site_table->size ) {
+        size = call_site_identifier + CALL_SITE_TABLE_INCREMENT;
+
+        call_sites = realloc(call_site_table->call_sites, size*sizeof(log_call_site_t));
+        if ( call_sites == NULL ) {
+            return GENERIC_ERROR;
+        }
+        call_site_table->call_sites = call_sites;
+
+        defined = realloc(call_site_table->defined, size*sizeof(bool));
+        if ( defined == NULL ) {
+            return GENERIC_ERROR;
+        }
+        memset(defined + call_site_table->size, 0, (size - call_site_table->size)*sizeof(bool));
+        call_site_table->defined = defined;
+
+        call_site_table->size = size;
+    }
+
+    if ( call_site_table->defined[call_site_identifier] == true ) {
+        free((char*)call_site_table->call_sites[call_site_identifier].function);
+        free((char*)call_site_table->call_sites[call_site_identifier].file);
+        free((char*)call_site_table->call_sites[call_site_identifier].format);
+    }
+
+    call_site_table->call_sites[call_site_identifier] = call_site;
+    call_site_table->defined[call_site_identifier] = true;
+
+    return SUCCESS;
+}
+
+/*
+ * Removes all call sites of the call site table.
+ *
+ * Parameters
+ *  call_site_table - The call site table.
+ *
+ * Returns
+ *  Nothing.
+ */
+void clear_call_site_table(call_site_table_t* call_site_table) {
+
+    size_t counter;
+
+    for ( counter = 0; counter < call_site_table->size; counter++ ) {
+        if ( call_site_table->defined[counter] == true ) {
+            free((char*)call_site_table->call_sites[counter].function);
+            free((char*)call_site_table->call_sites[counter].file);
+            free((char*)call_site_table->call_sites[counter].format);
+            call_site_table->defined[counter] = false;
+        }
+    }
+}
+
+/*
+ * Decodes a binary log file.
+ *
+ * Parameters
+ *  file_path - Path to the binary log file.
+ *
+ * Returns
+ *  SUCCESS - If the file was decoded successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int decode_binary_log_file(const char* file_path) {
+
+    uint8_t* buffer;
+    size_t buffer_size;
+    int result;
+
+    buffer = read_file(file_path, &buffer_size);
+    if ( buffer == NULL ) {
+        return GENERIC_ERROR;
+    }
+
+    result = decode_binary_logs(file_path, buffer, buffer_size);
+
+    free(buffer);
+
+    return result;
+}
+
+/*
+ * Decodes the binary logs stored on a buffer.
+ *
+ * Parameters
+ *  file_path - Path to the binary log file, used on error messages.
+ *  buffer - The content of the binary log file.
+ *  buffer_size - Size of "buffer" parameter.
+ *
+ * Returns
+ *  SUCCESS - If the binary logs were decoded successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  A log file can contain more than one log, if it was opened again on the same second. Each log starts with a header and ends with an "end of log" record.
+ *  A log which does not end with an "end of log" record was not closed (p. ex. the program was interrupted). Its records are printed until the last one complete.
+ */
+int decode_binary_logs(const char* file_path, const uint8_t* buffer, size_t buffer_size) {
+
+    call_site_table_t call_site_table = { NULL, NULL, 0 };
+    binary_log_header_t header;
+    binary_log_record_header_t record_header;
+    log_call_site_t call_site;
+    char instant[INSTANT_BUFFER_SIZE];
+    size_t position = 0;
+    uint64_t record_time;
+    bool log_finished;
+    int result = SUCCESS;
+
+    while ( position < buffer_size && result == SUCCESS ) {
+
+        if ( decode_binary_log_header(&header, buffer + position, buffer_size - position) != SUCCESS ) {
+            fprintf(stderr, "%s: there is no binary log header on position %zu.\n", file_path, position);
+            result = GENERIC_ERROR;
+            continue;
+        }
+        position += BINARY_LOG_HEADER_SIZE;
+
+        if ( header.version != BINARY_LOG_VERSION ) {
+            fprintf(stderr, "%s: binary log version %u is not supported.\n", file_path, header.version);
+            result = GENERIC_ERROR;
+            continue;
+        }
+
+        clear_call_site_table(&call_site_table);
+        record_time = header.monotonic_time;
+
+        format_instant(instant, header.real_time);
+        printf("[%s] Log started.\n", instant);
+
+        log_finished = false;
+        while ( log_finished == false && result == SUCCESS ) {
+
+            if ( position >= buffer_size ) {
+                fprintf(stderr, "%s: log was not finished.\n", file_path);
+                break;
+            }
+
+            if ( decode_binary_log_record_header(&record_header, buffer, buffer_size, &position) != SUCCESS ) {
+                fprintf(stderr, "%s: log ends with an incomplete record.\n", file_path);
+                position = buffer_size;
+                break;
+            }
+
+            if ( record_header.call_site_definition == true ) {
+                if ( decode_binary_log_call_site(&call_site, buffer, buffer_size, &position) != SUCCESS ) {
+                    fprintf(stderr, "%s: log ends with an incomplete call site.\n", file_path);
+                    position = buffer_size;
+                    break;
+                }
+
+                if ( add_call_site(&call_site_table, record_header.call_site_identifier, call_site) != SUCCESS ) {
+                    fprintf(stderr, "Could not allocate memory to store the call sites.\n");
+                    result = GENERIC_ERROR;
+                }
+                continue;
+            }
+
+            record_time += record_header.time_elapsed;
+
+            if ( record_header.call_site_identifier == BINARY_LOG_END_OF_LOG ) {
+                format_instant(instant, header.real_time + (int64_t)(record_time - header.monotonic_time));
+                printf("[%s] Log finished.\n", instant);
+                log_finished = true;
+                continue;
+            }
+
+            if ( record_header.call_site_identifier >= call_site_table.size || call_site_table.defined[record_header.call_site_identifier] == false ) {
+                fprintf(stderr, "%s: record of call site %u, which was not defined.\n", file_path, record_header.call_site_identifier);
+            }
+            else {
+                print_record(&call_site_table.call_sites[record_header.call_site_identifier], record_header.thread_identifier, header.real_time + (int64_t)(record_time - header.monotonic_time), buffer + position, record_header.arguments_size);
+            }
+
+            position += record_header.arguments_size;
+        }
+    }
+
+    clear_call_site_table(&call_site_table);
+    free(call_site_table.call_sites);
+    free(call_site_table.defined);
+
+    return result;
+}
+
+/*
+ * Formats an instant (in nanoseconds since epoch) the same way text log files do.
+ *
+ * Parameters
+ *  buffer - Buffer where the instant will be formatted. It must have at least "INSTANT_BUFFER_SIZE" characters.
+ *  instant - The instant to be formatted.
+ *
+ * Returns
+ *  Nothing.
+ */
+void format_instant(char* buffer, int64_t instant) {
+
+    time_t seconds;
+    struct tm date;
+    size_t length;
+
+    seconds = (time_t)(instant/1000000000LL);
+    localtime_r(&seconds, &date);
+
+    length = strftime(buffer, INSTANT_BUFFER_SIZE, "%d/%m/%Y %H:%M:%S", &date);
+    snprintf(buffer + length, INSTANT_BUFFER_SIZE - length, ".%03d", (int)((instant%1000000000LL)/1000000));
+}
+
+/*
+ * Returns the preffix used to identify a message type.
+ *
+ * Parameters
+ *  message_type - The message type.
+ *
+ * Returns
+ *  The preffix of the message type.
+ */
+const char* get_message_preffix(int message_type) {
+
+    switch ( message_type ) {
+        case LOG_MESSAGE_TYPE_WARNING:
+            return LOG_WARNING_PREFFIX;
+
+        case LOG_MESSAGE_TYPE_ERROR:
+            return LOG_ERROR_PREFFIX;
+
+        default:
+            return LOG_TRACE_PREFFIX;
+    }
+}
+
+/*
+ * Main function.
+ *
+ * Parameters
+ *  argc - Number of arguments informed.
+ *  argv - The arguments informed.
+ *
+ * Returns
+ *  SUCCESS - If all files were decoded successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int main(int argc, char** argv) {
+
+    int counter;
+    int files = 0;
+    int result = SUCCESS;
+
+    for ( counter = 1; counter < argc; counter++ ) {
+        if ( strcmp(argv[counter], PARAMETER_LOG) == 0 && counter + 1 < argc ) {
+            counter++;
+            if ( strcmp(argv[counter], PARAMETER_LOG_VALUE_TRACE) == 0 ) {
+                minimum_message_type = LOG_MESSAGE_TYPE_TRACE;
+            }
+            else if ( strcmp(argv[counter], PARAMETER_LOG_VALUE_WARNING) == 0 ) {
+                minimum_message_type = LOG_MESSAGE_TYPE_WARNING;
+            }
+            else if ( strcmp(argv[counter], PARAMETER_LOG_VALUE_ERROR) == 0 ) {
+                minimum_message_type = LOG_MESSAGE_TYPE_ERROR;
+            }
+            else {
+                fprintf(stderr, "Unknown value for parameter \"log\": \"%s\".\n", argv[counter]);
+                print_usage(argv[0]);
+                return GENERIC_ERROR;
+            }
+        }
+        else if ( strcmp(argv[counter], PARAMETER_FUNCTION) == 0 && counter + 1 < argc ) {
+            counter++;
+            function_filter = argv[counter];
+        }
+        else if ( strcmp(argv[counter], PARAMETER_THREAD) == 0 && counter + 1 < argc ) {
+            counter++;
+            thread_filter = (uint32_t)strtoul(argv[counter], NULL, 10);
+            if ( thread_filter == 0 ) {
+                fprintf(stderr, "Invalid value for parameter \"thread\": \"%s\".\n", argv[counter]);
+                print_usage(argv[0]);
+                return GENERIC_ERROR;
+            }
+        }
+        else if ( argv[counter][0] == '-' ) {
+            fprintf(stderr, "Unknown argument \"%s\".\n", argv[counter]);
+            print_usage(argv[0]);
+            return GENERIC_ERROR;
+        }
+        else {
+            files++;
+            if ( decode_binary_log_file(argv[counter]) != SUCCESS ) {
+                result = GENERIC_ERROR;
+            }
+        }
+    }
+
+    if ( files == 0 ) {
+        print_usage(argv[0]);
+        return GENERIC_ERROR;
+    }
+
+    return result;
+}
+
+/*
+ * Prints the program usage.
+ *
+ * Parameters
+ *  program_name - The name used to execute the program.
+ *
+ * Returns
+ *  Nothing.
+ */
+void print_usage(const char* program_name) {
+
+    fprintf(stderr, "Converts binary log files to the text log format.\n\n");
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "\t%s [%s level] [%s function] [%s thread] file...\n\n", program_name, PARAMETER_LOG, PARAMETER_FUNCTION, PARAMETER_THREAD);
+    fprintf(stderr, "\tWhere:\n");
+    fprintf(stderr, "\t\tlevel - Minimum level of the messages printed. It can be \"%s\", \"%s\" or \"%s\".\n", PARAMETER_LOG_VALUE_TRACE, PARAMETER_LOG_VALUE_WARNING, PARAMETER_LOG_VALUE_ERROR);
+    fprintf(stderr, "\t\tfunction - Function which messages must be printed.\n");
+    fprintf(stderr, "\t\tthread - Identifier of the thread which messages must be printed.\n");
+    fprintf(stderr, "\t\tfile - Binary log file to be converted.\n");
+}
+
+/*
+ * Prints a message record as a text log line.
+ *
+ * Parameters
+ *  call_site - The call site which registered the record.
+ *  thread_identifier - The identifier of the thread which registered the record.
+ *  instant - The instant (in nanoseconds since epoch) the record was registered.
+ *  arguments - The arguments of the message encoded on the record.
+ *  arguments_size - Size of "arguments" parameter.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  Records which do not match the level, function and thread informed as program arguments are not printed.
+ */
+void print_record(const log_call_site_t* call_site, uint32_t thread_identifier, int64_t instant, const uint8_t* arguments, size_t arguments_size) {
+
+    char instant_formatted[INSTANT_BUFFER_SIZE];
+    char message[LOG_MESSAGE_BUFFER_SIZE];
+
+    if ( call_site->message_type < minimum_message_type ) {
+        return;
+    }
+
+    if ( function_filter != NULL && ( call_site->function == NULL || strcmp(call_site->function, function_filter) != 0 ) ) {
+        return;
+    }
+
+    if ( thread_filter != 0 && thread_identifier != thread_filter ) {
+        return;
+    }
+
+    format_instant(instant_formatted, instant);
+    decode_binary_log_arguments(message, LOG_MESSAGE_BUFFER_SIZE, call_site->format, arguments, arguments_size);
+
+    if ( message[0] != '\0' ) {
+        printf("[%s] [%u] %s: %s (%d): %s\n", instant_formatted, thread_identifier, get_message_preffix(call_site->message_type), call_site->function, call_site->line, message);
+    }
+    else {
+        printf("[%s] [%u] %s: %s (%d)\n", instant_formatted, thread_identifier, get_message_preffix(call_site->message_type), call_site->function, call_site->line);
+    }
+}
+
+/*
+ * Reads the content of a file.
+ *
+ * Parameters
+ *  file_path - Path to the file.
+ *  size - The variable where the size of the file will be stored.
+ *
+ * Returns
+ *  The content of the file, which must be released by the caller, or NULL if the file could not be read.
+ */
+uint8_t* read_file(const char* file_path, size_t* size) {
+
+    FILE* file;
+    struct stat file_stat;
+    uint8_t* content;
+
+    file = fopen(file_path, "rb");
+    if ( file == NULL ) {
+        fprintf(stderr, "Could not open file \"%s\".\n", file_path);
+        return NULL;
+    }
+
+    if ( fstat(fileno(file), &file_stat) != 0 ) {
+        fprintf(stderr, "Could not retrieve the size of file \"%s\".\n", file_path);
+        fclose(file);
+        return NULL;
+    }
+
+    *size = file_stat.st_size;
+    content = malloc(*size + 1);
+    if ( content == NULL ) {
+        fprintf(stderr, "Could not allocate memory to read file \"%s\".\n", file_path);
+        fclose(file);
+        return NULL;
+    }
+
+    if ( fread(content, sizeof(uint8_t), *size, file) != *size ) {
+        fprintf(stderr, "Could not read file \"%s\".\n", file_path);
+        free(content);
+        fclose(file);
+        return NULL;
+    }
+
+    fclose(file);
+
+    return content;
+}
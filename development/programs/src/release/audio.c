@@ -12,45 +12,64 @@
  * Includes.
  */
 
+#include <dirent.h>
 #include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
 
 #include "audio.h"
+#include "audio/capture.h"
+#include "audio/catalog.h"
+#include "audio/encoder.h"
+#include "audio/record_index.h"
 #include "directory.h"
 #include "file.h"
 #include "log.h"
 #include "return_codes.h"
-#include "script.h"
+#include "timestamp_board.h"
+#include "timing.h"
 
 
 /*
  * Macros.
  */
 
-/* Script name to start audio record. */
-#define START_AUDIO_RECORD_SCRIPT_NAME "start_record.sh"
+/* Path to the audio directory */
+#define AUDIO_DIRECTORY "audio/"
 
-/* Script name to stop audio record. */
-#define STOP_AUDIO_RECORD_SCRIPT_NAME "stop_record.sh"
+/* Preffix of the audio record file names. */
+#define AUDIO_RECORD_FILE_PREFFIX "audio_"
 
-/* Script name to check if device is recording. */
-#define CHECK_DEVICE_IS_RECORDING_SCRIPT_NAME "is_recording.sh"
+/* Suffix of the audio segments manifest names. */
+#define AUDIO_SEGMENTS_MANIFEST_SUFFIX ".segments"
 
-/* Script name to find the latest audio record file name. */
-#define FIND_LATEST_AUDIO_RECORD_SCRIPT_NAME "find_latest_audio_record.sh"
+/* Maximum size of a line of the audio segments manifest. */
+#define AUDIO_SEGMENTS_MANIFEST_LINE_SIZE 256
 
-/* Path to the audio directory */
-#define AUDIO_DIRECTORY "audio/"
 
-/* Name of the file where is stored the latest audio record file name. */
-#define LATEST_AUDIO_RECORD_FILE_NAME_FILE "latest_audio_record"
+/*
+ * Variables.
+ */
 
-/* File name which the start audio record instant is stored. */
-#define START_AUDIO_RECORD_INSTANT_FILE_NAME "temporary/start_audio_instant"
+/* Configuration of the audio being captured. Its sampling rate is the one accepted by the PCM device. */
+audio_capture_configuration_t audio_capture_configuration;
 
-/* File name which the stop audio record instant is stored. */
-#define STOP_AUDIO_RECORD_INSTANT_FILE_NAME "temporary/stop_audio_instant"
+/* Time of audio captured before the latest audio record was started. */
+struct timeval audio_record_pre_roll;
+
+
+/*
+ * Function headers.
+ */
+
+/* Finds the audio segments manifest of the latest audio record. */
+char* find_latest_audio_segments_manifest(char*);
+
+/* Reads the audio segments listed on an audio segments manifest. */
+int read_audio_segments_manifest(char*, char*, audio_segments_t*);
 
 
 /*
@@ -58,138 +77,229 @@
  */
 
 /*
- * Returns the latest audio record file path.
+ * Adds the latest audio record to the audio catalog with the instants it was started and stopped.
  *
  * Parameters
  *  None.
  *
  * Returns
- *  The path to the latest audio record file or NULL if there was an error.
+ *  SUCCESS - If the latest audio record was cataloged successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Audio records split into segments are cataloged segment by segment, so the instants of the whole audio record are not informed to each of them.
  */
-char* get_latest_audio_record(){
+int catalog_latest_audio_record() {
     LOG_TRACE_POINT;
 
-    char* output_directory;
-    char* result = NULL;
-    size_t result_size;
-    int script_result;
-    char* larfn_file_path;
-    int errno_value;
-    int fclose_result;
-    /* Observation: larfn - Latest audio record file name */
-    size_t larfn_file_path_length;
-    FILE* larfn_file;
-    size_t larfn_content_size;
-    char* larfn_content;
-    size_t bytes_read;
+    char* manifest_path;
+    char* audio_file_path;
+    char* audio_file_name;
+    event_timestamp_t start_timestamp;
+    event_timestamp_t stop_timestamp;
+    struct timeval start_time;
+    struct timeval stop_time;
+    int result;
+
+    manifest_path = get_audio_encoder_manifest_path();
+    audio_file_path = get_audio_encoder_file_path();
+
+    if ( manifest_path != NULL || audio_file_path == NULL ) {
+        LOG_TRACE("Latest audio record instants are not known.");
+        free(manifest_path);
+        free(audio_file_path);
+        return update_audio_catalog();
+    }
 
-    script_result = execute_script(FIND_LATEST_AUDIO_RECORD_SCRIPT_NAME);
-    LOG_TRACE_POINT;
+    result = get_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED, &start_timestamp);
+    if ( result == SUCCESS ) {
+        result = get_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STOPPED, &stop_timestamp);
+    }
 
-    if ( script_result == SUCCESS ) {
-        LOG_TRACE_POINT;
+    if ( result != SUCCESS ) {
+        LOG_ERROR("Could not retrieve the latest audio record instants.");
+        free(audio_file_path);
+        return GENERIC_ERROR;
+    }
 
-        output_directory = get_output_directory();
-        LOG_TRACE_POINT;
+    start_time = convert_nanoseconds_to_timeval(start_timestamp.real_time);
+    stop_time = convert_nanoseconds_to_timeval(stop_timestamp.real_time);
 
-        larfn_file_path_length = strlen(output_directory);
-        larfn_file_path_length += strlen(AUDIO_DIRECTORY);
-        larfn_file_path_length += strlen(LATEST_AUDIO_RECORD_FILE_NAME_FILE);
-        larfn_file_path_length += 1;
+    audio_file_name = strrchr(audio_file_path, '/');
+    audio_file_name = ( audio_file_name == NULL ? audio_file_path : audio_file_name + 1 );
 
-        larfn_file_path = (char*)malloc(larfn_file_path_length*sizeof(char));
-        strcpy(larfn_file_path, output_directory);
-        strcat(larfn_file_path, AUDIO_DIRECTORY);
-        strcat(larfn_file_path, LATEST_AUDIO_RECORD_FILE_NAME_FILE);
-        LOG_TRACE("Latest audio record file name file path: \"%s\"", larfn_file_path);
+    result = set_audio_catalog_record_instants(audio_file_name, start_time, stop_time);
+    free(audio_file_path);
+
+    if ( result != SUCCESS ) {
+        LOG_ERROR("Could not catalog the latest audio record.");
+        return GENERIC_ERROR;
+    }
 
-        larfn_file = fopen(larfn_file_path, "r");
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
 
-        if ( larfn_file == NULL ) {
-            errno_value = errno;
-            LOG_ERROR("Could not open file \"%s\".", larfn_file_path);
-            LOG_ERROR("%s", strerror(errno_value));
-            result = NULL;
-        }
-        else {
-            LOG_TRACE_POINT;
+/*
+ * Releases the memory used by a list of audio segments.
+ *
+ * Parameters
+ *  audio_segments - The list of audio segments to be released.
+ *
+ * Returns
+ *  Nothing.
+ */
+void delete_audio_segments(audio_segments_t* audio_segments) {
+    LOG_TRACE_POINT;
 
-            larfn_content_size = get_file_size(larfn_file_path);
-            larfn_content = (char*)malloc((larfn_content_size+1)*sizeof(char));
+    size_t counter;
 
-            bytes_read = fread(larfn_content, sizeof(char), larfn_content_size, larfn_file);
+    for ( counter = 0; counter < audio_segments->count; counter++ ) {
+        free(audio_segments->paths[counter]);
+    }
+    free(audio_segments->paths);
 
-            if ( ferror(larfn_file) != 0 ) {
-                errno_value = errno;
-                LOG_ERROR("Error while reading \"latest record audio file name\" file: \"%s\".", larfn_file_path);
-                LOG_ERROR("%s", strerror(errno_value));
-                free(larfn_content);
-                result = NULL;
-            }
-            else {
-                LOG_TRACE_POINT;
-
-                larfn_content[bytes_read] = 0;
-                result_size = strlen(output_directory);
-                result_size += strlen(AUDIO_DIRECTORY);
-                result_size += bytes_read;
-                result_size += 1;
-
-                result = (char*)malloc(result_size*sizeof(char));
-                memset(result, 0, result_size);
-                strcpy(result, output_directory);
-                strcat(result, AUDIO_DIRECTORY);
-                strcat(result, larfn_content);
-            }
-        }
+    audio_segments->paths = NULL;
+    audio_segments->count = 0;
 
-        fclose_result = fclose(larfn_file);
+    LOG_TRACE_POINT;
+}
 
-        if ( fclose_result != 0 ) {
-            errno_value = errno;
-            LOG_ERROR("Error while closing file \"%s\".", larfn_file_path);
-            LOG_ERROR("%s", strerror(errno_value));
-            return NULL;
+/*
+ * Finds the audio segments manifest of the latest audio record.
+ *
+ * Parameters
+ *  audio_directory - The directory which contains the audio records.
+ *
+ * Returns
+ *  The path of the audio segments manifest or NULL if the latest audio record is not split into segments.
+ *
+ * Observations
+ *  If no audio record was started since the program started, the manifest is searched on the audio directory. Audio records are named after the instant they were started, so the latest manifest is the last one in alphabetical order.
+ */
+char* find_latest_audio_segments_manifest(char* audio_directory) {
+    LOG_TRACE_POINT;
+
+    char* result;
+    char* audio_file_path;
+    DIR* directory;
+    struct dirent* entry;
+    char latest_manifest_name[AUDIO_SEGMENTS_MANIFEST_LINE_SIZE];
+    size_t name_length;
+    size_t suffix_length;
+
+    result = get_audio_encoder_manifest_path();
+    if ( result != NULL ) {
+        LOG_TRACE_POINT;
+        return result;
+    }
+
+    audio_file_path = get_audio_encoder_file_path();
+    if ( audio_file_path != NULL ) {
+        LOG_TRACE("Latest audio record is not split into segments.");
+        free(audio_file_path);
+        return NULL;
+    }
+
+    directory = opendir(audio_directory);
+    if ( directory == NULL ) {
+        LOG_ERROR("Could not open the audio directory.");
+        LOG_ERROR("%s", strerror(errno));
+        return NULL;
+    }
+
+    latest_manifest_name[0] = '\0';
+    suffix_length = strlen(AUDIO_SEGMENTS_MANIFEST_SUFFIX);
+    while ( ( entry = readdir(directory) ) != NULL ) {
+        name_length = strlen(entry->d_name);
+        if ( name_length <= suffix_length || name_length >= AUDIO_SEGMENTS_MANIFEST_LINE_SIZE ||
+             strncmp(entry->d_name, AUDIO_RECORD_FILE_PREFFIX, strlen(AUDIO_RECORD_FILE_PREFFIX)) != 0 ||
+             strcmp(entry->d_name + name_length - suffix_length, AUDIO_SEGMENTS_MANIFEST_SUFFIX) != 0 ) {
+            continue;
         }
 
-        free(larfn_file_path);
-        free(output_directory);
+        if ( strcmp(entry->d_name, latest_manifest_name) > 0 ) {
+            strcpy(latest_manifest_name, entry->d_name);
+        }
+    }
+    closedir(directory);
 
+    if ( latest_manifest_name[0] == '\0' ) {
+        LOG_TRACE("No audio segments manifest found.");
+        return NULL;
     }
 
+    result = (char*)malloc((strlen(audio_directory) + strlen(latest_manifest_name) + 1)*sizeof(char));
+    strcpy(result, audio_directory);
+    strcat(result, latest_manifest_name);
+
     LOG_TRACE_POINT;
     return result;
 }
 
 /*
- * Returns the path of the file which the start audio record instant is stored.
- * 
+ * Returns the time of audio captured before the latest audio record was started.
+ *
  * Parameters
  *  None.
  *
- * Result
- *  The path of the file which the start audio record instant is stored.
+ * Returns
+ *  The time of audio kept as pre-roll and written at the start of the latest audio record. Zero if pre-roll is disabled.
  */
-char* get_start_audio_record_instant_file_path() {
+struct timeval get_audio_record_pre_roll() {
+    LOG_TRACE_POINT;
+
+    return audio_record_pre_roll;
+}
+
+/*
+ * Returns the latest audio record file path.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The path to the latest audio record file or NULL if there was an error.
+ *
+ * Observations
+ *  The latest audio record is the one modified most recently, as informed by the audio record index. The index is locked while it is read, because the audio catalog updater also updates it.
+ */
+char* get_latest_audio_record(){
     LOG_TRACE_POINT;
 
+    const audio_record_t* latest_audio_record;
+    char* output_directory;
     char* result;
     size_t result_size;
-    char* output_directory;
+
+    lock_audio_record_index();
+
+    if ( update_audio_record_index() != SUCCESS ) {
+        LOG_ERROR("Could not update the audio record index.");
+        unlock_audio_record_index();
+        return NULL;
+    }
+
+    latest_audio_record = get_latest_indexed_audio_record();
+    if ( latest_audio_record == NULL ) {
+        LOG_ERROR("Could not find latest audio record file name.");
+        unlock_audio_record_index();
+        return NULL;
+    }
 
     output_directory = get_output_directory();
-    LOG_TRACE_POINT;
 
-    result_size = strlen(START_AUDIO_RECORD_INSTANT_FILE_NAME);
-    result_size += strlen(output_directory);
+    result_size = strlen(output_directory);
+    result_size += strlen(AUDIO_DIRECTORY);
+    result_size += strlen(latest_audio_record->name);
     result_size += 1;
 
-    result = malloc(result_size*sizeof(char));
-
-    memset(result, 0, result_size*sizeof(char));
+    result = (char*)malloc(result_size*sizeof(char));
     strcpy(result, output_directory);
-    strcat(result, START_AUDIO_RECORD_INSTANT_FILE_NAME);
+    strcat(result, AUDIO_DIRECTORY);
+    strcat(result, latest_audio_record->name);
 
+    unlock_audio_record_index();
     free(output_directory);
 
     LOG_TRACE_POINT;
@@ -197,37 +307,53 @@ char* get_start_audio_record_instant_file_path() {
 }
 
 /*
- * Returns the path of the file which the stop audio record instant is stored.
- * 
+ * Returns the audio segments of the latest audio record which will not change anymore.
+ *
  * Parameters
- *  None.
+ *  audio_segments - The list where the audio segments paths will be stored. Must be released with "delete_audio_segments".
+ *
+ * Returns
+ *  SUCCESS - If the audio segments were listed successfully.
+ *  GENERIC_ERROR - If the latest audio record is not split into segments or there was an error.
  *
- * Result
- *  The path of the file which the stop audio record instant is stored.
+ * Observations
+ *  While the audio is being recorded, the segment being written is not listed, so every audio segment returned can be transmitted safely.
  */
-char* get_stop_audio_record_instant_file_path() {
+int get_latest_audio_record_segments(audio_segments_t* audio_segments) {
     LOG_TRACE_POINT;
 
-    char* result;
-    size_t result_size;
     char* output_directory;
+    char* audio_directory;
+    char* manifest_path;
+    int result;
+
+    audio_segments->paths = NULL;
+    audio_segments->count = 0;
 
     output_directory = get_output_directory();
     LOG_TRACE_POINT;
 
-    result_size = strlen(STOP_AUDIO_RECORD_INSTANT_FILE_NAME);
-    result_size += strlen(output_directory);
-    result_size += 1;
-
-    result = malloc(result_size*sizeof(char));
+    audio_directory = (char*)malloc((strlen(output_directory) + strlen(AUDIO_DIRECTORY) + 1)*sizeof(char));
+    strcpy(audio_directory, output_directory);
+    strcat(audio_directory, AUDIO_DIRECTORY);
+    free(output_directory);
 
-    memset(result, 0, result_size*sizeof(char));
-    strcpy(result, output_directory);
-    strcat(result, STOP_AUDIO_RECORD_INSTANT_FILE_NAME);
+    manifest_path = find_latest_audio_segments_manifest(audio_directory);
+    LOG_TRACE_POINT;
 
-    free(output_directory);
+    if ( manifest_path == NULL ) {
+        LOG_ERROR("Could not find the audio segments manifest of the latest audio record.");
+        free(audio_directory);
+        return GENERIC_ERROR;
+    }
 
+    result = read_audio_segments_manifest(manifest_path, audio_directory, audio_segments);
     LOG_TRACE_POINT;
+
+    free(manifest_path);
+    free(audio_directory);
+
+    LOG_TRACE("Audio segments: %zu.", audio_segments->count);
     return result;
 }
 
@@ -240,14 +366,166 @@ char* get_stop_audio_record_instant_file_path() {
  * Returns
  *  True - If device is recording.
  *  False - If device is not recording.
+ *
+ * Observations
+ *  When pre-roll is enabled the audio capture is always running, so the device is only recording while the audio encoder is running too.
  */
 bool is_recording() {
     LOG_TRACE_POINT;
 
-    int script_result = execute_script(CHECK_DEVICE_IS_RECORDING_SCRIPT_NAME);
+    bool result = ( is_audio_encoder_running() == true && is_audio_capture_running() == true );
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Reads the audio segments listed on an audio segments manifest.
+ *
+ * Parameters
+ *  manifest_path - The path of the audio segments manifest.
+ *  audio_directory - The directory which contains the audio segments.
+ *  audio_segments - The list where the audio segments paths will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the audio segments manifest was read successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio encoder appends a whole line for each audio segment closed, so a line without its line feed is still being written and is ignored.
+ */
+int read_audio_segments_manifest(char* manifest_path, char* audio_directory, audio_segments_t* audio_segments) {
+    LOG_TRACE_POINT;
+
+    FILE* manifest_file;
+    char line[AUDIO_SEGMENTS_MANIFEST_LINE_SIZE];
+    size_t line_length;
+    size_t capacity = 0;
+    char** paths;
+    char* segment_path;
+    int result = SUCCESS;
+
+    manifest_file = fopen(manifest_path, "r");
+    if ( manifest_file == NULL ) {
+        LOG_ERROR("Could not open the audio segments manifest.");
+        LOG_ERROR("%s", strerror(errno));
+        return GENERIC_ERROR;
+    }
+
+    while ( fgets(line, AUDIO_SEGMENTS_MANIFEST_LINE_SIZE, manifest_file) != NULL ) {
+        line_length = strlen(line);
+        if ( line_length < 2 || line[line_length - 1] != '\n' ) {
+            continue;
+        }
+        line[line_length - 1] = '\0';
+
+        if ( audio_segments->count == capacity ) {
+            capacity = ( capacity == 0 ? 16 : capacity*2 );
+            paths = (char**)realloc(audio_segments->paths, capacity*sizeof(char*));
+            if ( paths == NULL ) {
+                LOG_ERROR("Could not allocate memory to list the audio segments.");
+                result = GENERIC_ERROR;
+                break;
+            }
+            audio_segments->paths = paths;
+        }
+
+        segment_path = (char*)malloc((strlen(audio_directory) + line_length)*sizeof(char));
+        if ( segment_path == NULL ) {
+            LOG_ERROR("Could not allocate memory to store an audio segment path.");
+            result = GENERIC_ERROR;
+            break;
+        }
+        strcpy(segment_path, audio_directory);
+        strcat(segment_path, line);
+        audio_segments->paths[audio_segments->count++] = segment_path;
+    }
+
+    if ( result == GENERIC_ERROR ) {
+        LOG_TRACE_POINT;
+        delete_audio_segments(audio_segments);
+    }
+    else if ( ferror(manifest_file) != 0 ) {
+        LOG_ERROR("Error while reading the audio segments manifest.");
+        delete_audio_segments(audio_segments);
+        result = GENERIC_ERROR;
+    }
+
+    fclose(manifest_file);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Reads the audio encoded to be streamed.
+ *
+ * Parameters
+ *  buffer - The buffer where the audio encoded will be stored.
+ *  buffer_size - The size of the buffer.
+ *
+ * Returns
+ *  The number of bytes read or -1 if the audio record has finished and all its audio was streamed.
+ */
+ssize_t read_audio_stream(uint8_t* buffer, size_t buffer_size) {
+    LOG_TRACE_POINT;
+
+    bool recording;
+    size_t bytes_read;
+
+    /* Checked before reading, so the audio encoded while the audio record finishes is not lost. */
+    recording = is_recording();
+
+    bytes_read = read_audio_encoder_stream(buffer, buffer_size);
+    if ( bytes_read == 0 && recording == false ) {
+        LOG_TRACE("Audio record finished.");
+        return -1;
+    }
+
+    return (ssize_t)bytes_read;
+}
+
+/*
+ * Starts capturing audio to be used as pre-roll of the audio records.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio capture was started or pre-roll is disabled.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Pre-roll is enabled through the "pre_roll_length" audio capture configuration file. While no audio record is running, only the latest "pre_roll_length" microseconds of audio are kept in memory.
+ */
+int start_audio_pre_roll() {
+    LOG_TRACE_POINT;
+
+    if ( is_audio_capture_running() == true ) {
+        LOG_TRACE("Audio capture is already running.");
+        return SUCCESS;
+    }
+
+    if ( read_audio_capture_configuration(&audio_capture_configuration) != SUCCESS ) {
+        LOG_ERROR("Could not read audio capture configuration.");
+        return GENERIC_ERROR;
+    }
 
-    LOG_TRACE_POINT;   
-    return ( script_result == SUCCESS );
+    if ( audio_capture_configuration.pre_roll_length == 0 ) {
+        LOG_TRACE("Audio pre-roll is disabled.");
+        return SUCCESS;
+    }
+
+    /* Releases an audio capture finished by an error on the PCM device. */
+    stop_audio_capture();
+
+    if ( start_audio_capture(&audio_capture_configuration) != SUCCESS ) {
+        LOG_ERROR("Could not start audio capture for pre-roll.");
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
 }
 
 /*
@@ -259,22 +537,124 @@ bool is_recording() {
  * Returns
  *  SUCCESS - If audio record was started successfully.
  *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio is captured by "muni" itself, so the start instant is published on the timestamp board as soon as the audio captured starts being delivered. The audio encoder is started afterwards on its own thread and encodes the audio captured meanwhile from the audio capture ring.
+ *  If pre-roll is enabled, the audio capture is already running and the pre-roll it kept is written at the start of the audio record. Its length is returned by "get_audio_record_pre_roll".
  */
 int start_audio_record(){
     LOG_TRACE_POINT;
 
-    int script_result;
+    audio_encoder_configuration_t audio_encoder_configuration;
+
+    timerclear(&audio_record_pre_roll);
+
+    if ( is_recording() == true ) {
+        LOG_TRACE("Device is already recording.");
+        return SUCCESS;
+    }
+
+    /* A record finished by an error on the PCM device must be released before starting a new one. */
+    if ( is_audio_encoder_running() == true ) {
+        LOG_WARNING("Previous audio record has finished unexpectedly.");
+        stop_audio_record();
+    }
+
+    if ( read_audio_encoder_configuration(&audio_encoder_configuration) != SUCCESS ) {
+        LOG_ERROR("Could not read audio encoder configuration.");
+        return GENERIC_ERROR;
+    }
+
+    if ( is_audio_capture_running() == false ) {
+        LOG_TRACE_POINT;
+
+        /* Releases an audio capture finished by an error on the PCM device. */
+        stop_audio_capture();
+
+        if ( read_audio_capture_configuration(&audio_capture_configuration) != SUCCESS ) {
+            LOG_ERROR("Could not read audio capture configuration.");
+            return GENERIC_ERROR;
+        }
+
+        if ( start_audio_capture(&audio_capture_configuration) != SUCCESS ) {
+            LOG_ERROR("Could not start audio capture.");
+            return GENERIC_ERROR;
+        }
+    }
+
+    if ( start_audio_capture_delivery(&audio_record_pre_roll) != SUCCESS ) {
+        LOG_ERROR("Could not deliver the audio captured.");
+        stop_audio_capture();
+        return GENERIC_ERROR;
+    }
+
+    publish_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED);
+
+    if ( start_audio_encoder(&audio_encoder_configuration, &audio_capture_configuration) != SUCCESS ) {
+        LOG_ERROR("Could not start audio encoder.");
+        stop_audio_capture();
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE("Pre-roll: %ld.%06ld seconds.", (long)audio_record_pre_roll.tv_sec, (long)audio_record_pre_roll.tv_usec);
+    return SUCCESS;
+}
+
+/*
+ * Starts streaming the audio being recorded.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio stream was started successfully.
+ *  GENERIC_ERROR - If the device is not recording or there was an error.
+ */
+int start_audio_stream() {
+    LOG_TRACE_POINT;
+
+    if ( is_recording() == false ) {
+        LOG_ERROR("Device is not recording.");
+        return GENERIC_ERROR;
+    }
+
+    if ( start_audio_encoder_stream() != SUCCESS ) {
+        LOG_ERROR("Could not start the audio encoder stream.");
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
 
-    script_result = execute_script(START_AUDIO_RECORD_SCRIPT_NAME);
+/*
+ * Stops capturing audio to be used as pre-roll of the audio records.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio capture was stopped or was not running.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  An audio record in progress is not interrupted.
+ */
+int stop_audio_pre_roll() {
     LOG_TRACE_POINT;
 
-    if ( script_result != SUCCESS ){
-        LOG_ERROR("Error executing start record script. Execution returned: %d.", script_result);
+    if ( is_audio_encoder_running() == true ) {
+        LOG_TRACE("Device is recording.");
+        return SUCCESS;
+    }
+
+    if ( stop_audio_capture() != SUCCESS ) {
+        LOG_ERROR("Error while stopping audio capture.");
         return GENERIC_ERROR;
     }
 
     LOG_TRACE_POINT;
-    return script_result;
+    return SUCCESS;
 }
 
 /*
@@ -290,16 +670,70 @@ int start_audio_record(){
 int stop_audio_record(){
     LOG_TRACE_POINT;
 
-    int script_result;
+    int result = SUCCESS;
+    uint64_t dropped_bytes;
+    bool keep_pre_roll;
+
+    if ( is_audio_encoder_running() == false ) {
+        LOG_TRACE("Device is not recording.");
+        return SUCCESS;
+    }
+
+    /* With pre-roll, the audio capture keeps running and only its delivery to the audio encoder is stopped. */
+    keep_pre_roll = ( get_audio_capture_pre_roll_size() > 0 && is_audio_capture_running() == true );
+
+    if ( keep_pre_roll == true ) {
+        LOG_TRACE_POINT;
+
+        if ( stop_audio_capture_delivery() != SUCCESS ) {
+            LOG_ERROR("Error while stopping audio capture delivery.");
+            result = GENERIC_ERROR;
+        }
+    }
+    else if ( stop_audio_capture() != SUCCESS ) {
+        LOG_ERROR("Error while stopping audio capture.");
+        result = GENERIC_ERROR;
+    }
+
+    publish_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STOPPED);
+
+    if ( stop_audio_encoder() != SUCCESS ) {
+        LOG_ERROR("Error while finishing audio encoder.");
+        result = GENERIC_ERROR;
+    }
 
-    script_result = execute_script(STOP_AUDIO_RECORD_SCRIPT_NAME);
+    if ( keep_pre_roll == true && resume_audio_capture_pre_roll() != SUCCESS ) {
+        LOG_ERROR("Could not resume audio pre-roll.");
+        result = GENERIC_ERROR;
+    }
+
+    dropped_bytes = get_audio_capture_dropped_bytes();
+    if ( dropped_bytes > 0 ) {
+        LOG_WARNING("%llu bytes of audio were discarded because the audio encoder was late.", (unsigned long long)dropped_bytes);
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Stops streaming the audio being recorded.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio stream was stopped successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int stop_audio_stream() {
     LOG_TRACE_POINT;
 
-    if ( script_result != SUCCESS ){
-        LOG_ERROR("Error executing stop record script. Execution returned: %d.", script_result);
+    if ( stop_audio_encoder_stream() != SUCCESS ) {
+        LOG_ERROR("Could not stop the audio encoder stream.");
         return GENERIC_ERROR;
     }
 
     LOG_TRACE_POINT;
-    return script_result;
+    return SUCCESS;
 }
@@ -0,0 +1,1058 @@
+/*
+ * This source file contains the elaboration of all components required to capture audio from a PCM device.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <alsa/asoundlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "audio/capture.h"
+#include "byte_ring.h"
+#include "directory.h"
+#include "file.h"
+#include "log.h"
+#include "return_codes.h"
+#include "timestamp_board.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Path to the audio capture configuration directory, relative to the input directory. */
+#define AUDIO_CAPTURE_CONFIGURATION_DIRECTORY "configuration/audio/capture/"
+
+/* Name of the file which contains the number of channels to capture. */
+#define AUDIO_CAPTURE_CHANNELS_FILE_NAME "channels"
+
+/* Name of the file which contains the PCM device to capture from. */
+#define AUDIO_CAPTURE_RECORD_DEVICE_FILE_NAME "record_device"
+
+/* Name of the file which contains the sample format to capture. */
+#define AUDIO_CAPTURE_SAMPLE_FORMAT_FILE_NAME "sample_format"
+
+/* Name of the file which contains the sampling rate to capture. */
+#define AUDIO_CAPTURE_SAMPLING_RATE_FILE_NAME "sampling_rate"
+
+/* Name of the file which contains the time (in microseconds) of audio the capture ring must hold. */
+#define AUDIO_CAPTURE_BUFFER_LENGTH_FILE_NAME "buffer_length"
+
+/* Name of the file which contains the time (in microseconds) of audio kept before an audio record is started. Optional. */
+#define AUDIO_CAPTURE_PRE_ROLL_LENGTH_FILE_NAME "pre_roll_length"
+
+/* Name of the file which contains the maximum memory (in bytes) used to keep the audio before an audio record is started. Optional. */
+#define AUDIO_CAPTURE_PRE_ROLL_MEMORY_FILE_NAME "pre_roll_memory"
+
+/* Maximum size of a configuration file path. */
+#define AUDIO_CAPTURE_FILE_PATH_SIZE 512
+
+/* Maximum size of a configuration value. */
+#define AUDIO_CAPTURE_CONFIGURATION_VALUE_SIZE 128
+
+/* Time (in microseconds) of each period read from the PCM device. */
+#define AUDIO_CAPTURE_PERIOD_TIME 10000
+
+/* Time (in microseconds) of audio the PCM device can hold before an overrun. */
+#define AUDIO_CAPTURE_DEVICE_BUFFER_TIME 500000
+
+/* Real-time priority of the audio capture thread. */
+#define AUDIO_CAPTURE_THREAD_PRIORITY 70
+
+/* The audio captured is only kept as pre-roll. Older audio is discarded by the audio capture thread. */
+#define AUDIO_CAPTURE_STANDBY 0
+
+/* The audio capture thread is discarding the pre-roll older than its limit. */
+#define AUDIO_CAPTURE_TRIMMING 1
+
+/* The audio captured is delivered to the thread which consumes it. */
+#define AUDIO_CAPTURE_DELIVERING 2
+
+/* The delivery was stopped. The audio left on the ring is still read, the new audio captured is discarded. */
+#define AUDIO_CAPTURE_DRAINING 3
+
+
+/*
+ * Variables.
+ */
+
+/* PCM device which audio is being captured from. */
+snd_pcm_t* audio_capture_pcm = NULL;
+
+/* Thread which reads the audio from the PCM device. */
+pthread_t audio_capture_thread;
+
+/* Indicates that the audio capture was started and not stopped yet. */
+bool audio_capture_started = false;
+
+/* Indicates that the audio capture thread must stop. */
+atomic_bool audio_capture_stopping = false;
+
+/* Indicates that the audio capture thread has finished. */
+atomic_bool audio_capture_finished = true;
+
+/* Error which finished the audio capture thread. */
+atomic_int audio_capture_error = 0;
+
+/* Number of frames read from the PCM device on each period. */
+snd_pcm_uframes_t audio_capture_period_frames = 0;
+
+/* Buffer which receives each period read from the PCM device. */
+uint8_t* audio_capture_period_buffer = NULL;
+
+/* Size of the period buffer. */
+size_t audio_capture_period_buffer_size = 0;
+
+/* Ring which holds the audio captured until it is read. */
+byte_ring_t audio_capture_ring;
+
+/* Number of bytes discarded because the audio capture ring was full. */
+atomic_uint_least64_t audio_capture_dropped_bytes = 0;
+
+/* Number of overruns recovered on the PCM device. */
+atomic_uint_least64_t audio_capture_overruns = 0;
+
+/* Event descriptor signaled when audio is captured or the capture finishes. */
+int audio_capture_event_fd = -1;
+
+/* Indicates what is done with the audio captured. */
+atomic_int audio_capture_state = AUDIO_CAPTURE_DELIVERING;
+
+/* Maximum number of bytes kept as pre-roll. Zero if pre-roll is disabled. */
+size_t audio_capture_pre_roll_size = 0;
+
+/* Size (in bytes) of a frame captured. */
+size_t audio_capture_frame_size = 0;
+
+/* Sampling rate accepted by the PCM device. */
+unsigned int audio_capture_sampling_rate = 0;
+
+
+/*
+ * Function headers.
+ */
+
+/* Configures the PCM device to capture audio. */
+int configure_audio_capture_device(audio_capture_configuration_t*);
+
+/* Creates the audio capture thread. */
+int create_audio_capture_thread();
+
+/* Checks if the delivery of the audio captured has finished. */
+bool is_audio_capture_delivery_finished();
+
+/* Prepares the buffers which hold the audio captured. */
+int prepare_audio_capture_buffers(size_t, size_t);
+
+/* Reads a value from an audio capture configuration file. */
+int read_audio_capture_configuration_file(const char*, const char*, char*, size_t);
+
+/* Reads a number from an audio capture configuration file. */
+int read_audio_capture_configuration_number(const char*, const char*, unsigned int*, bool);
+
+/* Reads the audio from the PCM device until the audio capture is stopped. */
+void* run_audio_capture(void*);
+
+/* Signals the thread waiting for audio captured. */
+void signal_audio_capture();
+
+/* Discards the pre-roll older than its limit. */
+void trim_audio_capture_pre_roll();
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Configures the PCM device to capture audio.
+ *
+ * Parameters
+ *  configuration - The audio capture configuration. Its sampling rate is updated to the one accepted by the device.
+ *
+ * Returns
+ *  SUCCESS - If the PCM device was configured successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int configure_audio_capture_device(audio_capture_configuration_t* configuration) {
+    LOG_TRACE_POINT;
+
+    snd_pcm_hw_params_t* hardware_parameters;
+    snd_pcm_format_t sample_format;
+    unsigned int sampling_rate;
+    unsigned int period_time;
+    unsigned int buffer_time;
+    int alsa_result;
+
+    sample_format = snd_pcm_format_value(configuration->sample_format);
+    if ( sample_format == SND_PCM_FORMAT_UNKNOWN ) {
+        LOG_ERROR("Unknown sample format \"%s\".", configuration->sample_format);
+        return GENERIC_ERROR;
+    }
+
+    alsa_result = snd_pcm_hw_params_malloc(&hardware_parameters);
+    if ( alsa_result < 0 ) {
+        LOG_ERROR("Could not allocate the PCM device parameters.");
+        LOG_ERROR("%s", snd_strerror(alsa_result));
+        return GENERIC_ERROR;
+    }
+
+    sampling_rate = configuration->sampling_rate;
+    period_time = AUDIO_CAPTURE_PERIOD_TIME;
+    buffer_time = AUDIO_CAPTURE_DEVICE_BUFFER_TIME;
+
+    if ( ( alsa_result = snd_pcm_hw_params_any(audio_capture_pcm, hardware_parameters) ) < 0 ) {
+        LOG_ERROR("Could not read the parameters of PCM device \"%s\".", configuration->record_device);
+    }
+    else if ( ( alsa_result = snd_pcm_hw_params_set_access(audio_capture_pcm, hardware_parameters, SND_PCM_ACCESS_RW_INTERLEAVED) ) < 0 ) {
+        LOG_ERROR("PCM device \"%s\" does not support interleaved access.", configuration->record_device);
+    }
+    else if ( ( alsa_result = snd_pcm_hw_params_set_format(audio_capture_pcm, hardware_parameters, sample_format) ) < 0 ) {
+        LOG_ERROR("PCM device \"%s\" does not support sample format \"%s\".", configuration->record_device, configuration->sample_format);
+    }
+    else if ( ( alsa_result = snd_pcm_hw_params_set_channels(audio_capture_pcm, hardware_parameters, configuration->channels) ) < 0 ) {
+        LOG_ERROR("PCM device \"%s\" does not support %u channels.", configuration->record_device, configuration->channels);
+    }
+    else if ( ( alsa_result = snd_pcm_hw_params_set_rate_near(audio_capture_pcm, hardware_parameters, &sampling_rate, NULL) ) < 0 ) {
+        LOG_ERROR("PCM device \"%s\" does not support sampling rate %u.", configuration->record_device, configuration->sampling_rate);
+    }
+    else if ( ( alsa_result = snd_pcm_hw_params_set_period_time_near(audio_capture_pcm, hardware_parameters, &period_time, NULL) ) < 0 ) {
+        LOG_ERROR("Could not define the period time of PCM device \"%s\".", configuration->record_device);
+    }
+    else if ( ( alsa_result = snd_pcm_hw_params_set_buffer_time_near(audio_capture_pcm, hardware_parameters, &buffer_time, NULL) ) < 0 ) {
+        LOG_ERROR("Could not define the buffer time of PCM device \"%s\".", configuration->record_device);
+    }
+    else if ( ( alsa_result = snd_pcm_hw_params(audio_capture_pcm, hardware_parameters) ) < 0 ) {
+        LOG_ERROR("Could not apply the parameters of PCM device \"%s\".", configuration->record_device);
+    }
+    else if ( ( alsa_result = snd_pcm_hw_params_get_period_size(hardware_parameters, &audio_capture_period_frames, NULL) ) < 0 ) {
+        LOG_ERROR("Could not read the period size of PCM device \"%s\".", configuration->record_device);
+    }
+
+    snd_pcm_hw_params_free(hardware_parameters);
+
+    if ( alsa_result < 0 ) {
+        LOG_ERROR("%s", snd_strerror(alsa_result));
+        return GENERIC_ERROR;
+    }
+
+    if ( sampling_rate != configuration->sampling_rate ) {
+        LOG_WARNING("PCM device \"%s\" does not support sampling rate %u. Capturing with %u.", configuration->record_device, configuration->sampling_rate, sampling_rate);
+        configuration->sampling_rate = sampling_rate;
+    }
+
+    LOG_TRACE("Period: %lu frames (%u microseconds). Device buffer: %u microseconds.", (unsigned long)audio_capture_period_frames, period_time, buffer_time);
+    return SUCCESS;
+}
+
+/*
+ * Creates the audio capture thread.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio capture thread was created successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The thread is created with real-time priority, so the PCM device is read on time even when the system is busy. If the process is not allowed to use real-time priority, the thread is created with the default priority.
+ */
+int create_audio_capture_thread() {
+    LOG_TRACE_POINT;
+
+    pthread_attr_t thread_attributes;
+    struct sched_param scheduling_parameters;
+    int create_result;
+
+    pthread_attr_init(&thread_attributes);
+    pthread_attr_setinheritsched(&thread_attributes, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&thread_attributes, SCHED_FIFO);
+    memset(&scheduling_parameters, 0, sizeof(struct sched_param));
+    scheduling_parameters.sched_priority = AUDIO_CAPTURE_THREAD_PRIORITY;
+    pthread_attr_setschedparam(&thread_attributes, &scheduling_parameters);
+
+    create_result = pthread_create(&audio_capture_thread, &thread_attributes, run_audio_capture, NULL);
+    pthread_attr_destroy(&thread_attributes);
+
+    if ( create_result == EPERM ) {
+        LOG_WARNING("Not allowed to capture audio with real-time priority. Capturing with default priority.");
+        create_result = pthread_create(&audio_capture_thread, NULL, run_audio_capture, NULL);
+    }
+
+    if ( create_result != 0 ) {
+        LOG_ERROR("Could not create the audio capture thread.");
+        LOG_ERROR("%s", strerror(create_result));
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the number of bytes discarded because the audio capture ring was full.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The number of bytes discarded since the audio capture has started.
+ */
+uint64_t get_audio_capture_dropped_bytes() {
+    LOG_TRACE_POINT;
+
+    return atomic_load_explicit(&audio_capture_dropped_bytes, memory_order_relaxed);
+}
+
+/*
+ * Returns the number of overruns recovered on the PCM device.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The number of overruns recovered since the audio capture has started.
+ */
+uint64_t get_audio_capture_overruns() {
+    LOG_TRACE_POINT;
+
+    return atomic_load_explicit(&audio_capture_overruns, memory_order_relaxed);
+}
+
+/*
+ * Returns the maximum number of bytes of audio kept before an audio record is started.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The maximum number of bytes kept as pre-roll or zero if pre-roll is disabled.
+ */
+size_t get_audio_capture_pre_roll_size() {
+    LOG_TRACE_POINT;
+
+    return audio_capture_pre_roll_size;
+}
+
+/*
+ * Returns the highest number of bytes waited to be read on the audio capture ring.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The highest number of bytes waited to be read since the audio capture has started.
+ */
+size_t get_audio_capture_ring_high_water_mark() {
+    LOG_TRACE_POINT;
+
+    return get_byte_ring_high_water_mark(&audio_capture_ring);
+}
+
+/*
+ * Returns the size of the audio capture ring.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The number of bytes the audio capture ring can hold.
+ */
+size_t get_audio_capture_ring_size() {
+    LOG_TRACE_POINT;
+
+    return audio_capture_ring.size;
+}
+
+/*
+ * Checks if the delivery of the audio captured has finished.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  True - If the audio capture has finished or its delivery was stopped.
+ *  False - Otherwise.
+ *
+ * Observations
+ *  This function is called by the thread which consumes the audio captured, so it must not use log macros.
+ */
+bool is_audio_capture_delivery_finished() {
+
+    return ( atomic_load_explicit(&audio_capture_finished, memory_order_acquire) == true || atomic_load_explicit(&audio_capture_state, memory_order_acquire) == AUDIO_CAPTURE_DRAINING );
+}
+
+/*
+ * Checks if audio is being captured.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  True - If audio is being captured.
+ *  False - Otherwise.
+ */
+bool is_audio_capture_running() {
+    LOG_TRACE_POINT;
+
+    return ( audio_capture_started == true && atomic_load_explicit(&audio_capture_finished, memory_order_acquire) == false );
+}
+
+/*
+ * Prepares the buffers which hold the audio captured.
+ *
+ * Parameters
+ *  period_buffer_size - Size of the buffer which receives each period read from the PCM device.
+ *  ring_size - Size of the audio capture ring. Must be a power of two.
+ *
+ * Returns
+ *  SUCCESS - If the buffers were prepared successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The buffers are kept between captures and only reallocated when their sizes change.
+ */
+int prepare_audio_capture_buffers(size_t period_buffer_size, size_t ring_size) {
+    LOG_TRACE("Period buffer size: %zu bytes. Ring size: %zu bytes.", period_buffer_size, ring_size);
+
+    if ( audio_capture_period_buffer_size != period_buffer_size ) {
+        LOG_TRACE_POINT;
+
+        free(audio_capture_period_buffer);
+        audio_capture_period_buffer = (uint8_t*)malloc(period_buffer_size);
+        audio_capture_period_buffer_size = ( audio_capture_period_buffer == NULL ? 0 : period_buffer_size );
+    }
+
+    if ( audio_capture_ring.size != ring_size ) {
+        LOG_TRACE_POINT;
+
+        delete_byte_ring(&audio_capture_ring);
+        if ( create_byte_ring(&audio_capture_ring, ring_size) != SUCCESS ) {
+            LOG_ERROR("Could not create the audio capture ring.");
+            return GENERIC_ERROR;
+        }
+    }
+
+    if ( audio_capture_period_buffer == NULL ) {
+        LOG_ERROR("Could not allocate the audio capture period buffer.");
+        return GENERIC_ERROR;
+    }
+
+    reset_byte_ring(&audio_capture_ring);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Reads the audio captured.
+ *
+ * Parameters
+ *  buffer - The buffer where the audio captured will be copied.
+ *  buffer_size - The size of the buffer.
+ *
+ * Returns
+ *  The number of bytes copied to the buffer. It can be zero if there is no audio captured waiting to be read.
+ *
+ * Observations
+ *  Only one thread can read the audio captured. This function is called by the thread which consumes the audio captured, so it must not use log macros.
+ *  The ring only holds whole periods, so the audio read is aligned to frames when the buffer size is a multiple of the frame size.
+ */
+size_t read_audio_capture(uint8_t* buffer, size_t buffer_size) {
+
+    return read_byte_ring(&audio_capture_ring, buffer, buffer_size);
+}
+
+/*
+ * Reads the audio capture configuration.
+ *
+ * Parameters
+ *  configuration - The structure where the configuration read will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the configuration was read successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The configuration is read from the same files used by the audio capture scripts, located on "configuration/audio/capture/" of the input directory.
+ */
+int read_audio_capture_configuration(audio_capture_configuration_t* configuration) {
+    LOG_TRACE_POINT;
+
+    char configuration_directory[AUDIO_CAPTURE_FILE_PATH_SIZE];
+    char* input_directory;
+    int result;
+
+    input_directory = get_input_directory();
+    if ( input_directory == NULL ) {
+        LOG_ERROR("Could not find the input directory.");
+        return GENERIC_ERROR;
+    }
+
+    snprintf(configuration_directory, AUDIO_CAPTURE_FILE_PATH_SIZE, "%s%s", input_directory, AUDIO_CAPTURE_CONFIGURATION_DIRECTORY);
+    free(input_directory);
+
+    memset(configuration, 0, sizeof(audio_capture_configuration_t));
+
+    if ( read_audio_capture_configuration_file(configuration_directory, AUDIO_CAPTURE_RECORD_DEVICE_FILE_NAME, configuration->record_device, AUDIO_CAPTURE_RECORD_DEVICE_SIZE) != SUCCESS ||
+         read_audio_capture_configuration_file(configuration_directory, AUDIO_CAPTURE_SAMPLE_FORMAT_FILE_NAME, configuration->sample_format, AUDIO_CAPTURE_SAMPLE_FORMAT_SIZE) != SUCCESS ||
+         read_audio_capture_configuration_number(configuration_directory, AUDIO_CAPTURE_CHANNELS_FILE_NAME, &configuration->channels, false) != SUCCESS ||
+         read_audio_capture_configuration_number(configuration_directory, AUDIO_CAPTURE_SAMPLING_RATE_FILE_NAME, &configuration->sampling_rate, false) != SUCCESS ||
+         read_audio_capture_configuration_number(configuration_directory, AUDIO_CAPTURE_BUFFER_LENGTH_FILE_NAME, &configuration->buffer_length, false) != SUCCESS ||
+         read_audio_capture_configuration_number(configuration_directory, AUDIO_CAPTURE_PRE_ROLL_LENGTH_FILE_NAME, &configuration->pre_roll_length, true) != SUCCESS ||
+         read_audio_capture_configuration_number(configuration_directory, AUDIO_CAPTURE_PRE_ROLL_MEMORY_FILE_NAME, &configuration->pre_roll_memory, true) != SUCCESS ) {
+        LOG_ERROR("Could not read the audio capture configuration.");
+        result = GENERIC_ERROR;
+    }
+    else {
+        LOG_TRACE("Record device: \"%s\".", configuration->record_device);
+        LOG_TRACE("Sample format: \"%s\". Channels: %u. Sampling rate: %u. Buffer length: %u microseconds.", configuration->sample_format, configuration->channels, configuration->sampling_rate, configuration->buffer_length);
+        LOG_TRACE("Pre-roll length: %u microseconds. Pre-roll memory: %u bytes.", configuration->pre_roll_length, configuration->pre_roll_memory);
+        result = SUCCESS;
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Reads a value from an audio capture configuration file.
+ *
+ * Parameters
+ *  configuration_directory - The directory which contains the configuration file.
+ *  file_name - The name of the configuration file.
+ *  value - The buffer where the value read will be stored.
+ *  value_size - The size of the buffer.
+ *
+ * Returns
+ *  SUCCESS - If the value was read successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int read_audio_capture_configuration_file(const char* configuration_directory, const char* file_name, char* value, size_t value_size) {
+    LOG_TRACE("File name: \"%s\".", file_name);
+
+    char file_path[AUDIO_CAPTURE_FILE_PATH_SIZE];
+
+    snprintf(file_path, AUDIO_CAPTURE_FILE_PATH_SIZE, "%s%s", configuration_directory, file_name);
+
+    if ( read_file_value(file_path, value, value_size) != SUCCESS ) {
+        LOG_ERROR("Could not read audio capture configuration file \"%s\".", file_name);
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Reads a number from an audio capture configuration file.
+ *
+ * Parameters
+ *  configuration_directory - The directory which contains the configuration file.
+ *  file_name - The name of the configuration file.
+ *  number - The variable where the number read will be stored.
+ *  optional - Indicates that the configuration file may not exist. In this case, the number is zero.
+ *
+ * Returns
+ *  SUCCESS - If the number was read successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Zero is only accepted on optional configuration files, where it disables the feature configured.
+ */
+int read_audio_capture_configuration_number(const char* configuration_directory, const char* file_name, unsigned int* number, bool optional) {
+    LOG_TRACE("File name: \"%s\".", file_name);
+
+    char file_path[AUDIO_CAPTURE_FILE_PATH_SIZE];
+    char value[AUDIO_CAPTURE_CONFIGURATION_VALUE_SIZE];
+    char* end;
+    unsigned long converted_value;
+
+    if ( optional == true ) {
+        LOG_TRACE_POINT;
+
+        snprintf(file_path, AUDIO_CAPTURE_FILE_PATH_SIZE, "%s%s", configuration_directory, file_name);
+        if ( file_exists(file_path) == false ) {
+            LOG_TRACE("Optional configuration file \"%s\" not found.", file_name);
+            *number = 0;
+            return SUCCESS;
+        }
+    }
+
+    if ( read_audio_capture_configuration_file(configuration_directory, file_name, value, AUDIO_CAPTURE_CONFIGURATION_VALUE_SIZE) != SUCCESS ) {
+        return GENERIC_ERROR;
+    }
+
+    errno = 0;
+    converted_value = strtoul(value, &end, 10);
+    if ( errno != 0 || *end != '\0' || ( converted_value == 0 && optional == false ) || converted_value > UINT32_MAX ) {
+        LOG_ERROR("Invalid value \"%s\" on configuration file \"%s\".", value, file_name);
+        return GENERIC_ERROR;
+    }
+
+    *number = (unsigned int)converted_value;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Resumes keeping the audio captured as pre-roll after its delivery was stopped.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio captured is kept as pre-roll again.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Must only be called after the thread which consumed the audio captured has read it all and finished.
+ */
+int resume_audio_capture_pre_roll() {
+    LOG_TRACE_POINT;
+
+    int expected_state = AUDIO_CAPTURE_DRAINING;
+
+    if ( atomic_compare_exchange_strong(&audio_capture_state, &expected_state, AUDIO_CAPTURE_STANDBY) == false ) {
+        LOG_ERROR("Audio capture delivery was not stopped.");
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Reads the audio from the PCM device until the audio capture is stopped.
+ *
+ * Parameters
+ *  argument - Not used.
+ *
+ * Returns
+ *  NULL.
+ *
+ * Observations
+ *  This function runs on the audio capture thread, so it must not use log macros. An error which cannot be recovered finishes the thread and is informed when the audio capture is stopped.
+ */
+void* run_audio_capture(void* argument) {
+
+    snd_pcm_sframes_t frames_read;
+    size_t period_size;
+    int recover_result;
+    int state;
+
+    while ( atomic_load_explicit(&audio_capture_stopping, memory_order_acquire) == false ) {
+        frames_read = snd_pcm_readi(audio_capture_pcm, audio_capture_period_buffer, audio_capture_period_frames);
+
+        if ( frames_read < 0 ) {
+            if ( frames_read == -EPIPE ) {
+                atomic_fetch_add_explicit(&audio_capture_overruns, 1, memory_order_relaxed);
+            }
+
+            recover_result = snd_pcm_recover(audio_capture_pcm, (int)frames_read, 1);
+            if ( recover_result < 0 ) {
+                atomic_store(&audio_capture_error, recover_result);
+                break;
+            }
+            continue;
+        }
+
+        period_size = (size_t)snd_pcm_frames_to_bytes(audio_capture_pcm, frames_read);
+
+        state = atomic_load_explicit(&audio_capture_state, memory_order_acquire);
+        if ( state == AUDIO_CAPTURE_DRAINING ) {
+            continue;
+        }
+
+        /* A period which does not fit on the ring is discarded whole, so the audio on the ring is kept aligned to frames. */
+        if ( write_byte_ring(&audio_capture_ring, audio_capture_period_buffer, period_size) == false ) {
+            atomic_fetch_add_explicit(&audio_capture_dropped_bytes, period_size, memory_order_relaxed);
+        }
+
+        if ( state == AUDIO_CAPTURE_STANDBY ) {
+            trim_audio_capture_pre_roll();
+        }
+        else {
+            signal_audio_capture();
+        }
+    }
+
+    atomic_store_explicit(&audio_capture_finished, true, memory_order_release);
+    signal_audio_capture();
+
+    return NULL;
+}
+
+/*
+ * Signals the thread waiting for audio captured.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  This function runs on the audio capture thread, so it must not use log macros.
+ */
+void signal_audio_capture() {
+
+    uint64_t increment = 1;
+
+    /* The write only fails if the event counter is saturated, which still wakes the waiting thread. */
+    if ( write(audio_capture_event_fd, &increment, sizeof(uint64_t)) == -1 ) {
+        return;
+    }
+}
+
+/*
+ * Starts the audio capture.
+ *
+ * Parameters
+ *  configuration - The audio capture configuration. Its sampling rate is updated to the one accepted by the device.
+ *
+ * Returns
+ *  SUCCESS - If the audio capture was started successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio is captured on a dedicated thread and kept on a ring which holds "buffer_length" microseconds of audio. The audio captured must be read through "read_audio_capture" before the ring fills up, otherwise it is discarded.
+ *  If "pre_roll_length" is informed, the audio capture starts on standby: only the latest "pre_roll_length" microseconds of audio (limited by "pre_roll_memory" bytes) are kept until "start_audio_capture_delivery" is called.
+ */
+int start_audio_capture(audio_capture_configuration_t* configuration) {
+    LOG_TRACE("Record device: \"%s\".", configuration->record_device);
+
+    int alsa_result;
+    size_t frame_size;
+    size_t period_buffer_size;
+    uint64_t ring_content_size;
+    uint64_t pre_roll_size;
+    size_t ring_size;
+
+    if ( audio_capture_started == true ) {
+        LOG_ERROR("Audio capture is already started.");
+        return GENERIC_ERROR;
+    }
+
+    if ( audio_capture_event_fd == -1 ) {
+        LOG_TRACE_POINT;
+
+        audio_capture_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ( audio_capture_event_fd == -1 ) {
+            LOG_ERROR("Could not create the audio capture event descriptor.");
+            LOG_ERROR("%s", strerror(errno));
+            return GENERIC_ERROR;
+        }
+    }
+
+    alsa_result = snd_pcm_open(&audio_capture_pcm, configuration->record_device, SND_PCM_STREAM_CAPTURE, 0);
+    if ( alsa_result < 0 ) {
+        LOG_ERROR("Could not open PCM device \"%s\".", configuration->record_device);
+        LOG_ERROR("%s", snd_strerror(alsa_result));
+        audio_capture_pcm = NULL;
+        return GENERIC_ERROR;
+    }
+
+    if ( configure_audio_capture_device(configuration) != SUCCESS ) {
+        LOG_ERROR("Could not configure PCM device \"%s\".", configuration->record_device);
+        snd_pcm_close(audio_capture_pcm);
+        audio_capture_pcm = NULL;
+        return GENERIC_ERROR;
+    }
+
+    frame_size = (size_t)snd_pcm_frames_to_bytes(audio_capture_pcm, 1);
+    period_buffer_size = frame_size*audio_capture_period_frames;
+
+    pre_roll_size = (uint64_t)configuration->sampling_rate*frame_size*configuration->pre_roll_length/1000000;
+    if ( configuration->pre_roll_memory > 0 && pre_roll_size > configuration->pre_roll_memory ) {
+        LOG_WARNING("Pre-roll limited to %u bytes of memory.", configuration->pre_roll_memory);
+        pre_roll_size = configuration->pre_roll_memory;
+    }
+    pre_roll_size -= pre_roll_size%frame_size;
+
+    /* The ring holds the pre-roll plus the audio captured while it is being read. */
+    ring_content_size = (uint64_t)configuration->sampling_rate*frame_size*configuration->buffer_length/1000000;
+    ring_content_size += pre_roll_size;
+    ring_size = 1;
+    while ( ring_size < ring_content_size || ring_size < 2*period_buffer_size ) {
+        ring_size <<= 1;
+    }
+
+    if ( prepare_audio_capture_buffers(period_buffer_size, ring_size) != SUCCESS ) {
+        snd_pcm_close(audio_capture_pcm);
+        audio_capture_pcm = NULL;
+        return GENERIC_ERROR;
+    }
+
+    audio_capture_pre_roll_size = (size_t)pre_roll_size;
+    audio_capture_frame_size = frame_size;
+    audio_capture_sampling_rate = configuration->sampling_rate;
+
+    atomic_store(&audio_capture_state, ( audio_capture_pre_roll_size > 0 ? AUDIO_CAPTURE_STANDBY : AUDIO_CAPTURE_DELIVERING ));
+    atomic_store(&audio_capture_dropped_bytes, 0);
+    atomic_store(&audio_capture_overruns, 0);
+    atomic_store(&audio_capture_error, 0);
+    atomic_store(&audio_capture_stopping, false);
+    atomic_store(&audio_capture_finished, false);
+
+    alsa_result = snd_pcm_start(audio_capture_pcm);
+    if ( alsa_result < 0 ) {
+        LOG_ERROR("Could not start capture on PCM device \"%s\".", configuration->record_device);
+        LOG_ERROR("%s", snd_strerror(alsa_result));
+        atomic_store(&audio_capture_finished, true);
+        snd_pcm_close(audio_capture_pcm);
+        audio_capture_pcm = NULL;
+        return GENERIC_ERROR;
+    }
+
+    publish_event_timestamp(TIMESTAMP_EVENT_AUDIO_CAPTURE_STARTED);
+
+    if ( create_audio_capture_thread() != SUCCESS ) {
+        atomic_store(&audio_capture_finished, true);
+        snd_pcm_drop(audio_capture_pcm);
+        snd_pcm_close(audio_capture_pcm);
+        audio_capture_pcm = NULL;
+        return GENERIC_ERROR;
+    }
+
+    audio_capture_started = true;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Starts delivering the audio captured to the thread which consumes it.
+ *
+ * Parameters
+ *  pre_roll - The variable where the time of audio captured before the delivery has started will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the audio captured is being delivered.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The pre-roll kept on standby is delivered first, so the audio read starts before this function was called. If the audio capture is already delivering, the pre-roll informed is zero.
+ */
+int start_audio_capture_delivery(struct timeval* pre_roll) {
+    LOG_TRACE_POINT;
+
+    int expected_state;
+    bool delivery_concluded = false;
+    size_t pre_roll_content_size = 0;
+    uint64_t pre_roll_time;
+
+    if ( audio_capture_started == false ) {
+        LOG_ERROR("Audio capture is not started.");
+        return GENERIC_ERROR;
+    }
+
+    while ( delivery_concluded == false ) {
+        expected_state = AUDIO_CAPTURE_STANDBY;
+        if ( atomic_compare_exchange_strong(&audio_capture_state, &expected_state, AUDIO_CAPTURE_DELIVERING) == true ) {
+            pre_roll_content_size = get_byte_ring_content_size(&audio_capture_ring);
+            delivery_concluded = true;
+            continue;
+        }
+
+        switch ( expected_state ) {
+            case AUDIO_CAPTURE_TRIMMING:
+                /* The audio capture thread releases the ring in a few instructions. */
+                sched_yield();
+                break;
+            case AUDIO_CAPTURE_DELIVERING:
+                delivery_concluded = true;
+                break;
+            default:
+                LOG_ERROR("Audio capture delivery is still being drained.");
+                return GENERIC_ERROR;
+        }
+    }
+
+    pre_roll_time = (uint64_t)( pre_roll_content_size/audio_capture_frame_size )*1000000/audio_capture_sampling_rate;
+    pre_roll->tv_sec = (time_t)( pre_roll_time/1000000 );
+    pre_roll->tv_usec = (suseconds_t)( pre_roll_time%1000000 );
+
+    LOG_TRACE("Pre-roll: %zu bytes (%ld.%06ld seconds).", pre_roll_content_size, (long)pre_roll->tv_sec, (long)pre_roll->tv_usec);
+    return SUCCESS;
+}
+
+/*
+ * Stops the audio capture.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio capture was stopped successfully or was not started.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio captured until the stop is kept on the ring, so it can still be read.
+ */
+int stop_audio_capture() {
+    LOG_TRACE_POINT;
+
+    int result = SUCCESS;
+    int capture_error;
+
+    if ( audio_capture_started == false ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    atomic_store_explicit(&audio_capture_stopping, true, memory_order_release);
+
+    if ( pthread_join(audio_capture_thread, NULL) != 0 ) {
+        LOG_ERROR("Error while waiting the audio capture thread to finish.");
+        result = GENERIC_ERROR;
+    }
+
+    capture_error = atomic_load(&audio_capture_error);
+    if ( capture_error < 0 ) {
+        LOG_ERROR("Audio capture was interrupted by an error on PCM device.");
+        LOG_ERROR("%s", snd_strerror(capture_error));
+        result = GENERIC_ERROR;
+    }
+
+    snd_pcm_drop(audio_capture_pcm);
+    snd_pcm_close(audio_capture_pcm);
+    audio_capture_pcm = NULL;
+    audio_capture_started = false;
+
+    LOG_TRACE("Overruns: %llu. Dropped bytes: %llu.", (unsigned long long)get_audio_capture_overruns(), (unsigned long long)get_audio_capture_dropped_bytes());
+    return result;
+}
+
+/*
+ * Stops delivering the audio captured to the thread which consumes it.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the delivery was stopped successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio capture keeps running. The consumer reads the audio left on the ring and then receives "AUDIO_CAPTURE_FINISHED". After it finishes, "resume_audio_capture_pre_roll" must be called to keep the pre-roll again.
+ */
+int stop_audio_capture_delivery() {
+    LOG_TRACE_POINT;
+
+    int expected_state = AUDIO_CAPTURE_DELIVERING;
+
+    if ( atomic_compare_exchange_strong(&audio_capture_state, &expected_state, AUDIO_CAPTURE_DRAINING) == false ) {
+        LOG_ERROR("Audio capture is not delivering.");
+        return GENERIC_ERROR;
+    }
+
+    signal_audio_capture();
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Discards the pre-roll older than its limit.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  This function runs on the audio capture thread, so it must not use log macros.
+ *  While on standby there is no consumer, so the audio capture thread reads the ring itself. The state is changed to "trimming" meanwhile, so the delivery cannot start while the ring is being read.
+ */
+void trim_audio_capture_pre_roll() {
+
+    int expected_state = AUDIO_CAPTURE_STANDBY;
+    size_t content_size;
+
+    if ( atomic_compare_exchange_strong(&audio_capture_state, &expected_state, AUDIO_CAPTURE_TRIMMING) == false ) {
+        return;
+    }
+
+    content_size = get_byte_ring_content_size(&audio_capture_ring);
+    if ( content_size > audio_capture_pre_roll_size ) {
+        discard_byte_ring(&audio_capture_ring, content_size - audio_capture_pre_roll_size);
+    }
+
+    atomic_store_explicit(&audio_capture_state, AUDIO_CAPTURE_STANDBY, memory_order_release);
+}
+
+/*
+ * Waits until there is audio captured to be read.
+ *
+ * Parameters
+ *  wait_time - Maximum time (in milliseconds) to wait.
+ *
+ * Returns
+ *  AUDIO_CAPTURED - If there is audio captured to be read.
+ *  AUDIO_CAPTURE_FINISHED - If the audio capture or its delivery has finished and all audio captured was read.
+ *  AUDIO_CAPTURE_WAIT_TIME_ELAPSED - If no audio was captured before the wait time has elapsed.
+ *  GENERIC_ERROR - If there was an error while waiting.
+ *
+ * Observations
+ *  This function is called by the thread which consumes the audio captured, so it must not use log macros.
+ */
+int wait_audio_capture(int wait_time) {
+
+    struct pollfd poll_descriptor;
+    uint64_t event_counter;
+    int poll_result;
+
+    if ( get_byte_ring_content_size(&audio_capture_ring) > 0 ) {
+        return AUDIO_CAPTURED;
+    }
+
+    if ( is_audio_capture_delivery_finished() == true ) {
+        /* The ring must be checked again, since the audio capture could have written on it before finishing. */
+        return ( get_byte_ring_content_size(&audio_capture_ring) > 0 ? AUDIO_CAPTURED : AUDIO_CAPTURE_FINISHED );
+    }
+
+    poll_descriptor.fd = audio_capture_event_fd;
+    poll_descriptor.events = POLLIN;
+    poll_descriptor.revents = 0;
+
+    poll_result = poll(&poll_descriptor, 1, wait_time);
+    if ( poll_result == -1 ) {
+        return ( errno == EINTR ? AUDIO_CAPTURE_WAIT_TIME_ELAPSED : GENERIC_ERROR );
+    }
+
+    if ( poll_result > 0 && read(audio_capture_event_fd, &event_counter, sizeof(uint64_t)) == -1 && errno != EAGAIN ) {
+        return GENERIC_ERROR;
+    }
+
+    if ( get_byte_ring_content_size(&audio_capture_ring) > 0 ) {
+        return AUDIO_CAPTURED;
+    }
+
+    if ( is_audio_capture_delivery_finished() == true ) {
+        return AUDIO_CAPTURE_FINISHED;
+    }
+
+    return AUDIO_CAPTURE_WAIT_TIME_ELAPSED;
+}
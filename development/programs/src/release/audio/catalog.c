@@ -0,0 +1,1020 @@
+/*
+ * This source file contains the elaboration of all components required to keep a catalog of the audio records.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "audio/catalog.h"
+#include "audio/encoder.h"
+#include "audio/record_index.h"
+#include "digest.h"
+#include "directory.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Path to the audio directory, relative to the output directory. */
+#define AUDIO_DIRECTORY "audio/"
+
+/* Name of the audio catalog file. */
+#define AUDIO_CATALOG_FILE_NAME "catalog"
+
+/* Identifies the audio catalog file. */
+#define AUDIO_CATALOG_MAGIC "ANNACTLG"
+
+/* Version of the audio catalog file layout. */
+#define AUDIO_CATALOG_VERSION 1
+
+/* Number of records the audio catalog file grows each time it is full. */
+#define AUDIO_CATALOG_GROWTH_RECORDS 256
+
+/* Maximum size of the audio catalog file path. */
+#define AUDIO_CATALOG_PATH_SIZE 512
+
+/* Maximum time (in milliseconds) the audio catalog updater waits for a change on the audio directory. */
+#define AUDIO_CATALOG_UPDATER_WAIT_TIME 1000
+
+
+/*
+ * Structures.
+ */
+
+/* Header of the audio catalog file. The records are stored right after it. */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t records_count;
+    uint32_t reserved;
+} audio_catalog_header_t;
+
+
+/*
+ * Variables.
+ */
+
+/* Path to the audio catalog file. */
+char audio_catalog_path[AUDIO_CATALOG_PATH_SIZE];
+
+/* Descriptor of the audio catalog file. -1 if the audio catalog is not started. */
+int audio_catalog_fd = -1;
+
+/* Audio catalog file mapped on memory. */
+uint8_t* audio_catalog_map = NULL;
+
+/* Size of the audio catalog file mapped on memory. */
+size_t audio_catalog_map_size = 0;
+
+/* Controls the access to the audio catalog by the commands and the audio catalog updater. */
+pthread_mutex_t audio_catalog_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Thread which keeps the audio catalog updated. */
+pthread_t audio_catalog_updater_thread;
+
+/* Indicates that the audio catalog updater was started and not stopped yet. */
+bool audio_catalog_updater_started = false;
+
+/* Requests the audio catalog updater to stop. */
+atomic_bool audio_catalog_updater_stopping = false;
+
+
+/*
+ * Function headers.
+ */
+
+/* Appends an audio record to the catalog. */
+int append_audio_catalog_record(const audio_record_t*);
+
+/* Calculates the checksum of an audio catalog record which has it pending. */
+bool calculate_audio_catalog_checksum();
+
+/* Closes the audio catalog file. */
+void close_audio_catalog();
+
+/* Compares a name with the name of an audio catalog record. */
+int compare_audio_catalog_record_name(const void*, const void*);
+
+/* Compares the names of two audio catalog records. */
+int compare_audio_catalog_record_names(const void*, const void*);
+
+/* Fills an audio catalog record with the informations of an audio record. */
+void fill_audio_catalog_record(audio_catalog_record_t*, const audio_record_t*);
+
+/* Returns the header of the audio catalog. */
+audio_catalog_header_t* get_audio_catalog_header();
+
+/* Returns a record of the audio catalog. */
+audio_catalog_record_t* get_audio_catalog_record(uint32_t);
+
+/* Returns the path of an audio record file. */
+char* get_audio_record_file_path(const char*);
+
+/* Maps the audio catalog file on memory. */
+int map_audio_catalog(size_t);
+
+/* Opens the audio catalog file. */
+int open_audio_catalog();
+
+/* Updates the audio catalog with the audio records on the index. */
+int refresh_audio_catalog();
+
+/* Keeps the audio catalog updated while the audio directory changes. */
+void* run_audio_catalog_updater(void*);
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Appends an audio record to the catalog.
+ *
+ * Parameters
+ *  audio_record - The audio record to be appended.
+ *
+ * Returns
+ *  SUCCESS - If the audio record was appended successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The record is written before the records count is increased, so an interrupted append leaves the catalog consistent.
+ */
+int append_audio_catalog_record(const audio_record_t* audio_record) {
+    LOG_TRACE_POINT;
+
+    audio_catalog_record_t* audio_catalog_record;
+    uint32_t records_count;
+    size_t required_size;
+
+    if ( strlen(audio_record->name) >= AUDIO_CATALOG_NAME_SIZE ) {
+        LOG_WARNING("Audio record file name is too long to be cataloged.");
+        return SUCCESS;
+    }
+
+    records_count = get_audio_catalog_header()->records_count;
+    required_size = sizeof(audio_catalog_header_t) + ((size_t)records_count + 1)*sizeof(audio_catalog_record_t);
+
+    if ( required_size > audio_catalog_map_size ) {
+        LOG_TRACE_POINT;
+
+        if ( map_audio_catalog(audio_catalog_map_size + AUDIO_CATALOG_GROWTH_RECORDS*sizeof(audio_catalog_record_t)) != SUCCESS ) {
+            LOG_ERROR("Could not enlarge the audio catalog.");
+            return GENERIC_ERROR;
+        }
+    }
+
+    audio_catalog_record = get_audio_catalog_record(records_count);
+    memset(audio_catalog_record, 0, sizeof(audio_catalog_record_t));
+    audio_catalog_record->record_id = records_count + 1;
+
+    fill_audio_catalog_record(audio_catalog_record, audio_record);
+    audio_catalog_record->start_instant = audio_catalog_record->stop_instant - (int64_t)audio_catalog_record->duration*1000;
+
+    get_audio_catalog_header()->records_count = records_count + 1;
+
+    LOG_TRACE("Audio record cataloged with ID %u.", audio_catalog_record->record_id);
+    return SUCCESS;
+}
+
+/*
+ * Calculates the checksum of an audio catalog record which has it pending.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  True - If a checksum was calculated.
+ *  False - If there is no checksum pending or it could not be calculated.
+ *
+ * Observations
+ *  The audio catalog is unlocked while the audio record file is read, so the commands are not delayed. The checksum is only stored if the audio record was not modified meanwhile. The most recent audio records are calculated first, since they are the ones usually requested.
+ */
+bool calculate_audio_catalog_checksum() {
+    LOG_TRACE_POINT;
+
+    audio_catalog_record_t pending_record;
+    audio_catalog_record_t* stored_record;
+    char* file_path;
+    uint64_t checksum;
+    uint32_t position;
+    bool pending = false;
+    int get_file_digest_result;
+
+    pthread_mutex_lock(&audio_catalog_mutex);
+
+    if ( audio_catalog_map != NULL ) {
+        for ( position = get_audio_catalog_header()->records_count; position > 0 && pending == false; position-- ) {
+            stored_record = get_audio_catalog_record(position - 1);
+            if ( ( stored_record->flags & ( AUDIO_CATALOG_RECORD_CHECKSUM_PENDING | AUDIO_CATALOG_RECORD_REMOVED ) ) == AUDIO_CATALOG_RECORD_CHECKSUM_PENDING ) {
+                memcpy(&pending_record, stored_record, sizeof(audio_catalog_record_t));
+                pending = true;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&audio_catalog_mutex);
+
+    if ( pending == false ) {
+        LOG_TRACE_POINT;
+        return false;
+    }
+
+    file_path = get_audio_record_file_path(pending_record.name);
+    get_file_digest_result = get_file_digest(file_path, (size_t)pending_record.size, &checksum);
+    free(file_path);
+
+    if ( get_file_digest_result != SUCCESS ) {
+        LOG_WARNING("Could not calculate the checksum of audio record %u.", pending_record.record_id);
+        return false;
+    }
+
+    pthread_mutex_lock(&audio_catalog_mutex);
+
+    if ( audio_catalog_map != NULL && pending_record.record_id <= get_audio_catalog_header()->records_count ) {
+        stored_record = get_audio_catalog_record(pending_record.record_id - 1);
+        if ( ( stored_record->flags & AUDIO_CATALOG_RECORD_CHECKSUM_PENDING ) != 0 && stored_record->size == pending_record.size && stored_record->modification_instant == pending_record.modification_instant ) {
+            stored_record->checksum = checksum;
+            stored_record->flags &= ~AUDIO_CATALOG_RECORD_CHECKSUM_PENDING;
+            msync(audio_catalog_map, audio_catalog_map_size, MS_ASYNC);
+            LOG_TRACE("Checksum of audio record %u calculated.", pending_record.record_id);
+        }
+    }
+
+    pthread_mutex_unlock(&audio_catalog_mutex);
+
+    LOG_TRACE_POINT;
+    return true;
+}
+
+/*
+ * Closes the audio catalog file.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  The audio catalog must be locked.
+ */
+void close_audio_catalog() {
+    LOG_TRACE_POINT;
+
+    if ( audio_catalog_map != NULL ) {
+        msync(audio_catalog_map, audio_catalog_map_size, MS_SYNC);
+        munmap(audio_catalog_map, audio_catalog_map_size);
+        audio_catalog_map = NULL;
+        audio_catalog_map_size = 0;
+    }
+
+    if ( audio_catalog_fd != -1 ) {
+        close(audio_catalog_fd);
+        audio_catalog_fd = -1;
+    }
+
+    LOG_TRACE_POINT;
+}
+
+/*
+ * Compares a name with the name of an audio catalog record.
+ *
+ * Parameters
+ *  name - The name.
+ *  position - Position of the audio catalog record.
+ *
+ * Returns
+ *  A negative number, zero or a positive number if the name is respectively lower, equal or greater than the audio catalog record name.
+ */
+int compare_audio_catalog_record_name(const void* name, const void* position) {
+    return strcmp((const char*)name, get_audio_catalog_record(*(const uint32_t*)position)->name);
+}
+
+/*
+ * Compares the names of two audio catalog records.
+ *
+ * Parameters
+ *  first - Position of the first audio catalog record.
+ *  second - Position of the second audio catalog record.
+ *
+ * Returns
+ *  A negative number, zero or a positive number if the first name is respectively lower, equal or greater than the second.
+ */
+int compare_audio_catalog_record_names(const void* first, const void* second) {
+    return strcmp(get_audio_catalog_record(*(const uint32_t*)first)->name, get_audio_catalog_record(*(const uint32_t*)second)->name);
+}
+
+/*
+ * Fills an audio catalog record with the informations of an audio record.
+ *
+ * Parameters
+ *  audio_catalog_record - The audio catalog record to be filled. Its ID, start instant and flags, except the pending checksum one, are not changed.
+ *  audio_record - The audio record.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  Until the record informs the instants it was started and stopped, its stop instant is its modification time.
+ *  The audio record file is not read. Its checksum is flagged as pending and calculated later by the audio catalog updater.
+ */
+void fill_audio_catalog_record(audio_catalog_record_t* audio_catalog_record, const audio_record_t* audio_record) {
+    LOG_TRACE_POINT;
+
+    strcpy(audio_catalog_record->name, audio_record->name);
+    audio_catalog_record->size = (uint64_t)audio_record->size;
+    audio_catalog_record->checksum = 0;
+    audio_catalog_record->flags |= AUDIO_CATALOG_RECORD_CHECKSUM_PENDING;
+    audio_catalog_record->duration = audio_record->duration;
+    audio_catalog_record->modification_instant = (int64_t)audio_record->modification_time.tv_sec*1000000 + audio_record->modification_time.tv_nsec/1000;
+    audio_catalog_record->stop_instant = audio_catalog_record->modification_instant;
+
+    LOG_TRACE_POINT;
+}
+
+/*
+ * Finds an audio record on the catalog.
+ *
+ * Parameters
+ *  record_id - ID of the audio record.
+ *  audio_catalog_record - The variable where the audio record informations will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the audio record was found.
+ *  AUDIO_CATALOG_RECORD_NOT_FOUND - If there is no audio record with the ID informed or its file was removed.
+ *  GENERIC_ERROR - If there was an error.
+ *
+ * Observations
+ *  The audio record IDs are their positions on the catalog, so the audio record is read directly. The audio record file is not read, so its checksum may still be pending.
+ */
+int find_audio_catalog_record(uint32_t record_id, audio_catalog_record_t* audio_catalog_record) {
+    LOG_TRACE("Record ID: %u.", record_id);
+
+    audio_catalog_record_t* stored_record;
+
+    pthread_mutex_lock(&audio_catalog_mutex);
+
+    if ( audio_catalog_fd == -1 && open_audio_catalog() != SUCCESS ) {
+        LOG_ERROR("Could not start the audio catalog.");
+        pthread_mutex_unlock(&audio_catalog_mutex);
+        return GENERIC_ERROR;
+    }
+
+    if ( record_id == 0 || record_id > get_audio_catalog_header()->records_count ) {
+        LOG_TRACE_POINT;
+        pthread_mutex_unlock(&audio_catalog_mutex);
+        return AUDIO_CATALOG_RECORD_NOT_FOUND;
+    }
+
+    stored_record = get_audio_catalog_record(record_id - 1);
+    if ( ( stored_record->flags & AUDIO_CATALOG_RECORD_REMOVED ) != 0 ) {
+        LOG_TRACE("Audio record file was removed.");
+        pthread_mutex_unlock(&audio_catalog_mutex);
+        return AUDIO_CATALOG_RECORD_NOT_FOUND;
+    }
+
+    memcpy(audio_catalog_record, stored_record, sizeof(audio_catalog_record_t));
+
+    pthread_mutex_unlock(&audio_catalog_mutex);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the header of the audio catalog.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The header of the audio catalog mapped on memory.
+ */
+audio_catalog_header_t* get_audio_catalog_header() {
+    return (audio_catalog_header_t*)audio_catalog_map;
+}
+
+/*
+ * Returns a record of the audio catalog.
+ *
+ * Parameters
+ *  position - Position of the record on the audio catalog.
+ *
+ * Returns
+ *  The record mapped on memory.
+ */
+audio_catalog_record_t* get_audio_catalog_record(uint32_t position) {
+    return (audio_catalog_record_t*)(audio_catalog_map + sizeof(audio_catalog_header_t)) + position;
+}
+
+/*
+ * Returns the path of an audio catalog record file.
+ *
+ * Parameters
+ *  audio_catalog_record - The audio catalog record.
+ *
+ * Returns
+ *  The path of the audio record file. It must be released with "free".
+ */
+char* get_audio_catalog_record_path(const audio_catalog_record_t* audio_catalog_record) {
+    LOG_TRACE_POINT;
+
+    return get_audio_record_file_path(audio_catalog_record->name);
+}
+
+/*
+ * Returns the path of an audio record file.
+ *
+ * Parameters
+ *  name - The audio record file name.
+ *
+ * Returns
+ *  The path of the audio record file. It must be released with "free".
+ */
+char* get_audio_record_file_path(const char* name) {
+    LOG_TRACE_POINT;
+
+    char* output_directory;
+    char* result;
+
+    output_directory = get_output_directory();
+
+    result = (char*)malloc((strlen(output_directory) + strlen(AUDIO_DIRECTORY) + strlen(name) + 1)*sizeof(char));
+    strcpy(result, output_directory);
+    strcat(result, AUDIO_DIRECTORY);
+    strcat(result, name);
+
+    free(output_directory);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Lists a page of the audio records on the catalog.
+ *
+ * Parameters
+ *  first_record_id - ID of the first audio record to be listed. Zero lists from the first audio record.
+ *  audio_catalog_records - The array where the audio records will be stored.
+ *  maximum_records - Maximum number of audio records to be listed.
+ *  records_count - The variable where the number of audio records listed will be stored.
+ *  next_record_id - The variable where the ID to request the next page will be stored. Zero if there are no more audio records.
+ *
+ * Returns
+ *  SUCCESS - If the audio records were listed successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Audio records whose files were removed are not listed, but keep their IDs, so the pages already listed by the remote device do not change.
+ *  Only the catalog mapped on memory is read. It is kept updated by the audio catalog updater.
+ */
+int list_audio_catalog_records(uint32_t first_record_id, audio_catalog_record_t* audio_catalog_records, size_t maximum_records, size_t* records_count, uint32_t* next_record_id) {
+    LOG_TRACE("First record ID: %u, maximum records: %zu.", first_record_id, maximum_records);
+
+    audio_catalog_record_t* stored_record;
+    uint32_t catalog_records_count;
+    uint32_t position;
+
+    pthread_mutex_lock(&audio_catalog_mutex);
+
+    if ( audio_catalog_fd == -1 && open_audio_catalog() != SUCCESS ) {
+        LOG_ERROR("Could not start the audio catalog.");
+        pthread_mutex_unlock(&audio_catalog_mutex);
+        return GENERIC_ERROR;
+    }
+
+    catalog_records_count = get_audio_catalog_header()->records_count;
+    *records_count = 0;
+
+    for ( position = ( first_record_id > 0 ? first_record_id - 1 : 0 ); position < catalog_records_count && *records_count < maximum_records; position++ ) {
+        stored_record = get_audio_catalog_record(position);
+        if ( ( stored_record->flags & AUDIO_CATALOG_RECORD_REMOVED ) != 0 ) {
+            continue;
+        }
+
+        memcpy(&audio_catalog_records[*records_count], stored_record, sizeof(audio_catalog_record_t));
+        (*records_count)++;
+    }
+
+    *next_record_id = ( position < catalog_records_count ? position + 1 : 0 );
+
+    pthread_mutex_unlock(&audio_catalog_mutex);
+
+    LOG_TRACE("Records listed: %zu, next record ID: %u.", *records_count, *next_record_id);
+    return SUCCESS;
+}
+
+/*
+ * Maps the audio catalog file on memory.
+ *
+ * Parameters
+ *  size - Size of the audio catalog file. The file is enlarged if it is smaller.
+ *
+ * Returns
+ *  SUCCESS - If the audio catalog file was mapped successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int map_audio_catalog(size_t size) {
+    LOG_TRACE("Size: %zu.", size);
+
+    struct stat file_stat;
+    uint8_t* map;
+    int errno_value;
+
+    if ( fstat(audio_catalog_fd, &file_stat) != 0 ) {
+        errno_value = errno;
+        LOG_ERROR("Could not read the audio catalog file size.");
+        LOG_ERROR("%s", strerror(errno_value));
+        return GENERIC_ERROR;
+    }
+
+    if ( (size_t)file_stat.st_size < size && ftruncate(audio_catalog_fd, (off_t)size) != 0 ) {
+        errno_value = errno;
+        LOG_ERROR("Could not enlarge the audio catalog file.");
+        LOG_ERROR("%s", strerror(errno_value));
+        return GENERIC_ERROR;
+    }
+
+    map = (uint8_t*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, audio_catalog_fd, 0);
+    if ( map == MAP_FAILED ) {
+        errno_value = errno;
+        LOG_ERROR("Could not map the audio catalog file.");
+        LOG_ERROR("%s", strerror(errno_value));
+        return GENERIC_ERROR;
+    }
+
+    if ( audio_catalog_map != NULL ) {
+        munmap(audio_catalog_map, audio_catalog_map_size);
+    }
+    audio_catalog_map = map;
+    audio_catalog_map_size = size;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Opens the audio catalog file.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio catalog file was opened successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio catalog must be locked. A catalog file which cannot be read is created again. The records of the audio files stored are recovered on the next update, but the instants they were started and stopped are lost.
+ */
+int open_audio_catalog() {
+    LOG_TRACE_POINT;
+
+    char* output_directory;
+    audio_catalog_header_t* header;
+    struct stat file_stat;
+    size_t maximum_records;
+    int errno_value;
+
+    if ( audio_catalog_fd != -1 ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    output_directory = get_output_directory();
+    snprintf(audio_catalog_path, AUDIO_CATALOG_PATH_SIZE, "%s%s%s", output_directory, AUDIO_DIRECTORY, AUDIO_CATALOG_FILE_NAME);
+    free(output_directory);
+
+    audio_catalog_fd = open(audio_catalog_path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if ( audio_catalog_fd == -1 ) {
+        errno_value = errno;
+        LOG_ERROR("Could not open the audio catalog file.");
+        LOG_ERROR("%s", strerror(errno_value));
+        return GENERIC_ERROR;
+    }
+
+    if ( fstat(audio_catalog_fd, &file_stat) != 0 ) {
+        errno_value = errno;
+        LOG_ERROR("Could not read the audio catalog file size.");
+        LOG_ERROR("%s", strerror(errno_value));
+        close_audio_catalog();
+        return GENERIC_ERROR;
+    }
+
+    if ( (size_t)file_stat.st_size < sizeof(audio_catalog_header_t) ) {
+        LOG_TRACE("Creating the audio catalog file.");
+        file_stat.st_size = 0;
+    }
+
+    if ( map_audio_catalog(( file_stat.st_size > 0 ? (size_t)file_stat.st_size : sizeof(audio_catalog_header_t) + AUDIO_CATALOG_GROWTH_RECORDS*sizeof(audio_catalog_record_t) )) != SUCCESS ) {
+        LOG_ERROR("Could not map the audio catalog file.");
+        close_audio_catalog();
+        return GENERIC_ERROR;
+    }
+
+    header = get_audio_catalog_header();
+    maximum_records = (audio_catalog_map_size - sizeof(audio_catalog_header_t))/sizeof(audio_catalog_record_t);
+
+    if ( memcmp(header->magic, AUDIO_CATALOG_MAGIC, sizeof(header->magic)) != 0 || header->version != AUDIO_CATALOG_VERSION || header->record_size != sizeof(audio_catalog_record_t) || header->records_count > maximum_records ) {
+        if ( file_stat.st_size > 0 ) {
+            LOG_WARNING("Audio catalog file is invalid. It will be created again.");
+        }
+
+        memset(audio_catalog_map, 0, audio_catalog_map_size);
+        memcpy(header->magic, AUDIO_CATALOG_MAGIC, sizeof(header->magic));
+        header->version = AUDIO_CATALOG_VERSION;
+        header->record_size = sizeof(audio_catalog_record_t);
+        header->records_count = 0;
+    }
+
+    LOG_TRACE("Audio catalog records: %u.", header->records_count);
+    return SUCCESS;
+}
+
+/*
+ * Updates the audio catalog with the audio records on the index.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio catalog was updated successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio records are read from the audio record index. New audio records are appended to the catalog, the ones modified are read again and the ones removed are flagged, keeping their IDs. The audio record being recorded is only cataloged after it is finished.
+ *  The catalog records are sorted by name once, so each audio record is found on the catalog with a binary search.
+ *  The audio catalog must be locked. The audio record index is locked while it is read. The audio record files are not read, so the audio records appended or modified have their checksums pending.
+ */
+int refresh_audio_catalog() {
+    LOG_TRACE_POINT;
+
+    const audio_record_t* audio_record;
+    audio_catalog_record_t* stored_record;
+    uint32_t* positions;
+    uint32_t* found_position;
+    bool* found;
+    uint32_t catalog_records_count;
+    uint32_t positions_count = 0;
+    uint32_t position;
+    size_t indexed_records_count;
+    size_t counter;
+    int64_t modification_instant;
+    int result = SUCCESS;
+
+    if ( audio_catalog_fd == -1 && open_audio_catalog() != SUCCESS ) {
+        LOG_ERROR("Could not start the audio catalog.");
+        return GENERIC_ERROR;
+    }
+
+    lock_audio_record_index();
+
+    if ( update_audio_record_index() != SUCCESS ) {
+        LOG_ERROR("Could not update the audio record index.");
+        unlock_audio_record_index();
+        return GENERIC_ERROR;
+    }
+
+    indexed_records_count = get_indexed_audio_records_count();
+    if ( indexed_records_count > 0 && is_audio_encoder_running() == true ) {
+        LOG_TRACE("The latest audio record is being recorded.");
+        indexed_records_count--;
+    }
+
+    catalog_records_count = get_audio_catalog_header()->records_count;
+    positions = (uint32_t*)malloc(( catalog_records_count > 0 ? catalog_records_count : 1 )*sizeof(uint32_t));
+    found = (bool*)calloc(( catalog_records_count > 0 ? catalog_records_count : 1 ), sizeof(bool));
+    if ( positions == NULL || found == NULL ) {
+        LOG_ERROR("Could not allocate memory to update the audio catalog.");
+        unlock_audio_record_index();
+        free(positions);
+        free(found);
+        return GENERIC_ERROR;
+    }
+
+    for ( position = 0; position < catalog_records_count; position++ ) {
+        if ( ( get_audio_catalog_record(position)->flags & AUDIO_CATALOG_RECORD_REMOVED ) == 0 ) {
+            positions[positions_count++] = position;
+        }
+    }
+    qsort(positions, positions_count, sizeof(uint32_t), compare_audio_catalog_record_names);
+
+    for ( counter = 0; counter < indexed_records_count && result == SUCCESS; counter++ ) {
+        audio_record = get_indexed_audio_record(counter);
+
+        found_position = NULL;
+        if ( strlen(audio_record->name) < AUDIO_CATALOG_NAME_SIZE ) {
+            found_position = (uint32_t*)bsearch(audio_record->name, positions, positions_count, sizeof(uint32_t), compare_audio_catalog_record_name);
+        }
+
+        if ( found_position == NULL ) {
+            result = append_audio_catalog_record(audio_record);
+            continue;
+        }
+
+        found[*found_position] = true;
+        stored_record = get_audio_catalog_record(*found_position);
+
+        modification_instant = (int64_t)audio_record->modification_time.tv_sec*1000000 + audio_record->modification_time.tv_nsec/1000;
+        if ( stored_record->size != (uint64_t)audio_record->size || stored_record->modification_instant != modification_instant ) {
+            LOG_TRACE("Audio record %u was modified.", stored_record->record_id);
+            fill_audio_catalog_record(stored_record, audio_record);
+        }
+    }
+
+    for ( counter = 0; counter < positions_count; counter++ ) {
+        if ( found[positions[counter]] == false ) {
+            stored_record = get_audio_catalog_record(positions[counter]);
+
+            /* The audio record being recorded is not on the index range read, but was not removed. */
+            if ( indexed_records_count < get_indexed_audio_records_count() && strcmp(stored_record->name, get_latest_indexed_audio_record()->name) == 0 ) {
+                continue;
+            }
+
+            LOG_TRACE("Audio record %u was removed.", stored_record->record_id);
+            stored_record->flags |= AUDIO_CATALOG_RECORD_REMOVED;
+        }
+    }
+
+    unlock_audio_record_index();
+
+    free(positions);
+    free(found);
+
+    msync(audio_catalog_map, audio_catalog_map_size, MS_ASYNC);
+
+    LOG_TRACE("Audio catalog records: %u.", get_audio_catalog_header()->records_count);
+    return result;
+}
+
+/*
+ * Keeps the audio catalog updated while the audio directory changes.
+ *
+ * Parameters
+ *  argument - Not used.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  The audio catalog is updated each time the audio record index descriptor informs a change. While there are checksums pending, they are calculated one at a time, so a change is noticed between two audio record files read. If the audio directory changes are not watched, the catalog is updated each "AUDIO_CATALOG_UPDATER_WAIT_TIME" milliseconds.
+ */
+void* run_audio_catalog_updater(void* argument) {
+    LOG_TRACE_POINT;
+
+    struct pollfd poll_descriptor;
+    bool update_required = true;
+    int refresh_result;
+
+    while ( atomic_load(&audio_catalog_updater_stopping) == false ) {
+
+        if ( update_required == true ) {
+            LOG_TRACE_POINT;
+
+            pthread_mutex_lock(&audio_catalog_mutex);
+            refresh_result = refresh_audio_catalog();
+            pthread_mutex_unlock(&audio_catalog_mutex);
+
+            /* The changes may not have been read, so the update is only tried again after waiting. */
+            if ( refresh_result != SUCCESS ) {
+                LOG_WARNING("Could not update the audio catalog.");
+                poll(NULL, 0, AUDIO_CATALOG_UPDATER_WAIT_TIME);
+                continue;
+            }
+        }
+
+        lock_audio_record_index();
+        poll_descriptor.fd = get_audio_record_index_fd();
+        unlock_audio_record_index();
+        poll_descriptor.events = POLLIN;
+        poll_descriptor.revents = 0;
+
+        if ( poll(&poll_descriptor, 1, 0) > 0 ) {
+            update_required = true;
+            continue;
+        }
+
+        if ( calculate_audio_catalog_checksum() == true ) {
+            update_required = false;
+            continue;
+        }
+
+        update_required = ( poll(&poll_descriptor, 1, AUDIO_CATALOG_UPDATER_WAIT_TIME) != 0 || poll_descriptor.fd == -1 );
+    }
+
+    LOG_TRACE_POINT;
+    return NULL;
+}
+
+/*
+ * Defines the start and stop instants of an audio record on the catalog.
+ *
+ * Parameters
+ *  name - The audio record file name.
+ *  start_instant - Instant the audio record was started.
+ *  stop_instant - Instant the audio record was stopped.
+ *
+ * Returns
+ *  SUCCESS - If the instants were defined successfully.
+ *  AUDIO_CATALOG_RECORD_NOT_FOUND - If the audio record is not on the catalog.
+ *  GENERIC_ERROR - If there was an error.
+ *
+ * Observations
+ *  The catalog is updated before, so an audio record just finished is cataloged. The audio record is searched from the end of the catalog, where the audio records cataloged recently are.
+ */
+int set_audio_catalog_record_instants(const char* name, struct timeval start_instant, struct timeval stop_instant) {
+    LOG_TRACE_POINT;
+
+    audio_catalog_record_t* stored_record;
+    uint32_t position;
+
+    pthread_mutex_lock(&audio_catalog_mutex);
+
+    if ( refresh_audio_catalog() != SUCCESS ) {
+        LOG_ERROR("Could not update the audio catalog.");
+        pthread_mutex_unlock(&audio_catalog_mutex);
+        return GENERIC_ERROR;
+    }
+
+    for ( position = get_audio_catalog_header()->records_count; position > 0; position-- ) {
+        stored_record = get_audio_catalog_record(position - 1);
+        if ( strcmp(stored_record->name, name) == 0 && ( stored_record->flags & AUDIO_CATALOG_RECORD_REMOVED ) == 0 ) {
+            stored_record->start_instant = (int64_t)start_instant.tv_sec*1000000 + start_instant.tv_usec;
+            stored_record->stop_instant = (int64_t)stop_instant.tv_sec*1000000 + stop_instant.tv_usec;
+            msync(audio_catalog_map, audio_catalog_map_size, MS_ASYNC);
+
+            LOG_TRACE("Instants defined for audio record %u.", stored_record->record_id);
+            pthread_mutex_unlock(&audio_catalog_mutex);
+            return SUCCESS;
+        }
+    }
+
+    pthread_mutex_unlock(&audio_catalog_mutex);
+
+    LOG_TRACE_POINT;
+    return AUDIO_CATALOG_RECORD_NOT_FOUND;
+}
+
+/*
+ * Starts the audio catalog.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio catalog was started successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  A catalog file which cannot be read is created again. The records of the audio files stored are recovered on the next update, but the instants they were started and stopped are lost.
+ */
+int start_audio_catalog() {
+    LOG_TRACE_POINT;
+
+    int result;
+
+    pthread_mutex_lock(&audio_catalog_mutex);
+    result = open_audio_catalog();
+    pthread_mutex_unlock(&audio_catalog_mutex);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Starts the audio catalog updater.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio catalog updater was started successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio catalog updater updates the catalog as soon as the audio record index informs the audio directory has changed, and calculates the checksums of the audio records cataloged. So the commands only read the catalog mapped on memory, without waiting for the audio record files to be read.
+ */
+int start_audio_catalog_updater() {
+    LOG_TRACE_POINT;
+
+    if ( audio_catalog_updater_started == true ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    atomic_store(&audio_catalog_updater_stopping, false);
+
+    if ( pthread_create(&audio_catalog_updater_thread, NULL, run_audio_catalog_updater, NULL) != 0 ) {
+        LOG_ERROR("Could not create the audio catalog updater thread.");
+        return GENERIC_ERROR;
+    }
+
+    audio_catalog_updater_started = true;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Stops the audio catalog.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - The audio catalog is always stopped successfully.
+ */
+int stop_audio_catalog() {
+    LOG_TRACE_POINT;
+
+    pthread_mutex_lock(&audio_catalog_mutex);
+    close_audio_catalog();
+    pthread_mutex_unlock(&audio_catalog_mutex);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Stops the audio catalog updater.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio catalog updater was stopped successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio catalog updater finishes the checksum it is calculating, so this function can wait the time to read an audio record file.
+ */
+int stop_audio_catalog_updater() {
+    LOG_TRACE_POINT;
+
+    if ( audio_catalog_updater_started == false ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    atomic_store(&audio_catalog_updater_stopping, true);
+    audio_catalog_updater_started = false;
+
+    if ( pthread_join(audio_catalog_updater_thread, NULL) != 0 ) {
+        LOG_ERROR("Error while waiting the audio catalog updater thread to finish.");
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Updates the audio catalog with the audio records stored.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio catalog was updated successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio records are read from the audio record index. New audio records are appended to the catalog, the ones modified are read again and the ones removed are flagged, keeping their IDs. The audio record being recorded is only cataloged after it is finished.
+ *  The audio record files are not read, so the checksums of the audio records appended or modified are calculated later by the audio catalog updater.
+ */
+int update_audio_catalog() {
+    LOG_TRACE_POINT;
+
+    int result;
+
+    pthread_mutex_lock(&audio_catalog_mutex);
+    result = refresh_audio_catalog();
+    pthread_mutex_unlock(&audio_catalog_mutex);
+
+    LOG_TRACE_POINT;
+    return result;
+}
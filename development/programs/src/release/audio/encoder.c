@@ -0,0 +1,1276 @@
+/*
+ * This source file contains the elaboration of all components required to encode the audio captured.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <lame/lame.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "audio/capture.h"
+#include "audio/encoder.h"
+#include "byte_ring.h"
+#include "directory.h"
+#include "file.h"
+#include "log.h"
+#include "return_codes.h"
+#include "timestamp_board.h"
+#include "timing.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Path to the audio encoder configuration directory, relative to the input directory. */
+#define AUDIO_ENCODER_CONFIGURATION_DIRECTORY "configuration/audio/encode/"
+
+/* Name of the file which contains the sample rate (in kilohertz) of the audio to encode. */
+#define AUDIO_ENCODER_SAMPLE_RATE_FILE_NAME "sample_rate"
+
+/* Name of the file which contains the bit width of the samples to encode. */
+#define AUDIO_ENCODER_BIT_WIDTH_FILE_NAME "bit_width"
+
+/* Name of the file which contains the channel mode of the audio files. */
+#define AUDIO_ENCODER_CHANNEL_MODE_FILE_NAME "channel_mode"
+
+/* Name of the file which contains the encode quality. */
+#define AUDIO_ENCODER_QUALITY_FILE_NAME "quality"
+
+/* Name of the file which contains the comment written on the audio files. */
+#define AUDIO_ENCODER_COMMENT_FILE_NAME "comment"
+
+/* Name of the file which contains the time (in seconds) of each audio segment. Optional. */
+#define AUDIO_ENCODER_SEGMENT_LENGTH_FILE_NAME "segment_length"
+
+/* Path to the audio directory, relative to the output directory. */
+#define AUDIO_DIRECTORY "audio/"
+
+/* Preffix of the audio file names. */
+#define AUDIO_FILE_PREFFIX "audio_"
+
+/* Suffix of the audio file names. */
+#define AUDIO_FILE_SUFFIX ".mp3"
+
+/* Suffix of the audio segments manifest names. */
+#define AUDIO_SEGMENTS_MANIFEST_SUFFIX ".segments"
+
+/* Maximum size of an audio record name. */
+#define AUDIO_ENCODER_RECORD_NAME_SIZE 64
+
+/* Maximum size of a configuration value. */
+#define AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE 32
+
+/* Only samples of this bit width can be encoded. */
+#define AUDIO_ENCODER_SUPPORTED_BIT_WIDTH 16
+
+/* Only samples of this format can be encoded. */
+#define AUDIO_ENCODER_SUPPORTED_SAMPLE_FORMAT "S16_LE"
+
+/* Size of the buffer which receives the audio captured to be encoded. Multiple of every frame size supported. */
+#define AUDIO_ENCODER_PCM_BUFFER_SIZE 18432
+
+/* Size of the buffer which receives the audio encoded. Enough for the worst case of "AUDIO_ENCODER_PCM_BUFFER_SIZE" mono samples. */
+#define AUDIO_ENCODER_MP3_BUFFER_SIZE 32768
+
+/* Size of the ring which holds the audio encoded until it is written on the audio file. */
+#define AUDIO_ENCODER_OUTPUT_RING_SIZE 1048576
+
+/* Size of the buffer used to write the audio encoded on the audio file. */
+#define AUDIO_ENCODER_WRITER_BUFFER_SIZE 65536
+
+/* Size of the ring which holds the positions where the audio encoded must be split into segments. */
+#define AUDIO_ENCODER_SEGMENT_RING_SIZE 4096
+
+/* Size of the ring which holds the audio encoded to be streamed. It limits how late the audio streamed can be. */
+#define AUDIO_ENCODER_STREAM_RING_SIZE 32768
+
+/* Time (in milliseconds) the audio encoder waits for audio captured before checking again. */
+#define AUDIO_ENCODER_WAIT_TIME 100
+
+/* Time (in milliseconds) the audio encoder waits for space on the output ring. */
+#define AUDIO_ENCODER_STALL_TIME 1
+
+/* Time (in milliseconds) the audio file writer sleeps when there is nothing to write. */
+#define AUDIO_ENCODER_WRITER_IDLE_TIME 20
+
+
+/*
+ * Variables.
+ */
+
+/* Encoder of the audio captured. */
+lame_t audio_encoder_lame = NULL;
+
+/* Number of channels of the audio being encoded. */
+unsigned int audio_encoder_channels = 0;
+
+/* Thread which encodes the audio captured. */
+pthread_t audio_encoder_thread;
+
+/* Thread which writes the audio encoded on the audio file. */
+pthread_t audio_encoder_writer_thread;
+
+/* Indicates that the audio encoder was started and not stopped yet. */
+bool audio_encoder_started = false;
+
+/* Indicates that the audio encoder thread has finished. */
+atomic_bool audio_encoder_finished = true;
+
+/* Indicates that the audio file writer could not write on the audio file. */
+atomic_bool audio_encoder_writer_failed = false;
+
+/* Error returned by the encoder which finished the audio encoder thread. */
+int audio_encoder_error = 0;
+
+/* Error number which finished the audio file writer. */
+int audio_encoder_writer_error = 0;
+
+/* Descriptor of the audio file being written. */
+int audio_encoder_file_fd = -1;
+
+/* Path of the first audio file written. */
+char audio_encoder_file_path[AUDIO_ENCODER_FILE_PATH_SIZE];
+
+/* Path of the audio file being written by the audio file writer. */
+char audio_encoder_segment_path[AUDIO_ENCODER_FILE_PATH_SIZE];
+
+/* Path of the manifest which lists the audio segments closed. Empty if the audio is not split into segments. */
+char audio_encoder_manifest_path[AUDIO_ENCODER_FILE_PATH_SIZE];
+
+/* Name of the audio record, used on its files. */
+char audio_encoder_record_name[AUDIO_ENCODER_RECORD_NAME_SIZE];
+
+/* Number of the audio segment being written. */
+unsigned int audio_encoder_segment_number = 0;
+
+/* Number of samples (per channel) of each audio segment. Zero if the audio is not split into segments. */
+uint64_t audio_encoder_segment_samples = 0;
+
+/* Number of samples (per channel) encoded on the current audio segment. */
+uint64_t audio_encoder_segment_samples_encoded = 0;
+
+/* Number of bytes sent to the audio file writer since the audio encoder has started. */
+uint64_t audio_encoder_output_position = 0;
+
+/* Ring which holds the positions of the audio encoded where a new audio segment starts. */
+byte_ring_t audio_encoder_segment_ring;
+
+/* Ring which holds the audio encoded to be streamed. */
+byte_ring_t audio_encoder_stream_ring;
+
+/* Indicates if the audio encoded must be copied to the stream ring. */
+atomic_bool audio_encoder_streaming = false;
+
+/* Ring which holds the audio encoded until it is written on the audio file. */
+byte_ring_t audio_encoder_output_ring;
+
+/* Buffer which receives the audio captured to be encoded. */
+uint8_t audio_encoder_pcm_buffer[AUDIO_ENCODER_PCM_BUFFER_SIZE];
+
+/* Buffer which receives the audio encoded. */
+uint8_t audio_encoder_mp3_buffer[AUDIO_ENCODER_MP3_BUFFER_SIZE];
+
+/* Buffer used to write the audio encoded on the audio file. */
+uint8_t audio_encoder_writer_buffer[AUDIO_ENCODER_WRITER_BUFFER_SIZE];
+
+/* Number of frames encoded since the audio encoder has started. */
+atomic_uint_least64_t audio_encoder_frames_encoded = 0;
+
+/* Time (in nanoseconds) spent encoding since the audio encoder has started. */
+atomic_uint_least64_t audio_encoder_encode_time = 0;
+
+/* Number of times the audio encoder waited for space on the output ring. */
+atomic_uint_least64_t audio_encoder_output_stalls = 0;
+
+/* Number of audio segments closed since the audio encoder has started. */
+atomic_uint_least64_t audio_encoder_segments_closed = 0;
+
+/* Number of bytes of audio encoded discarded because the stream ring was full. */
+atomic_uint_least64_t audio_encoder_stream_dropped_bytes = 0;
+
+
+/*
+ * Function headers.
+ */
+
+/* Appends the name of an audio segment closed to the audio segments manifest. */
+int append_audio_encoder_manifest(const char*);
+
+/* Closes the audio file being written. */
+int close_audio_encoder_file();
+
+/* Configures the encoder of the audio captured. */
+int configure_audio_encoder(audio_encoder_configuration_t*, audio_capture_configuration_t*);
+
+/* Creates the audio file which will receive the audio encoded. */
+int create_audio_encoder_file();
+
+/* Encodes audio samples and sends the result to the audio file writer. */
+int encode_audio_samples(uint8_t*, size_t);
+
+/* Opens the next audio file to be written. */
+int open_audio_encoder_file();
+
+/* Sends the audio encoded to the audio file writer. */
+void push_audio_encoder_output(uint8_t*, size_t);
+
+/* Reads a value from an audio encoder configuration file. */
+int read_audio_encoder_configuration_file(const char*, const char*, char*, size_t, bool);
+
+/* Finishes the current audio segment and starts a new one. */
+int rotate_audio_encoder_segment();
+
+/* Encodes the audio captured until the audio capture finishes. */
+void* run_audio_encoder(void*);
+
+/* Writes the audio encoded on the audio file until the audio encoder finishes. */
+void* run_audio_encoder_writer(void*);
+
+/* Writes content on a file of the audio record. */
+int write_audio_encoder_fd(int, uint8_t*, size_t);
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Appends the name of an audio segment closed to the audio segments manifest.
+ *
+ * Parameters
+ *  segment_path - The path of the audio segment closed.
+ *
+ * Returns
+ *  SUCCESS - If the manifest was updated successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  This function runs on the audio file writer thread, so it must not use log macros.
+ *  The manifest only lists audio segments which will not change anymore, so they can be transmitted while the audio is still being recorded.
+ */
+int append_audio_encoder_manifest(const char* segment_path) {
+
+    char line[AUDIO_ENCODER_FILE_PATH_SIZE];
+    const char* segment_name;
+    int manifest_fd;
+    int line_size;
+    int result = SUCCESS;
+
+    segment_name = strrchr(segment_path, '/');
+    segment_name = ( segment_name == NULL ? segment_path : segment_name + 1 );
+    line_size = snprintf(line, AUDIO_ENCODER_FILE_PATH_SIZE, "%s\n", segment_name);
+
+    manifest_fd = open(audio_encoder_manifest_path, O_WRONLY | O_APPEND | O_CLOEXEC);
+    if ( manifest_fd == -1 ) {
+        audio_encoder_writer_error = errno;
+        return GENERIC_ERROR;
+    }
+
+    if ( write_audio_encoder_fd(manifest_fd, (uint8_t*)line, (size_t)line_size) != SUCCESS ) {
+        result = GENERIC_ERROR;
+    }
+
+    if ( close(manifest_fd) == -1 && result == SUCCESS ) {
+        audio_encoder_writer_error = errno;
+        result = GENERIC_ERROR;
+    }
+
+    return result;
+}
+
+/*
+ * Closes the audio file being written.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio file was closed successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  This function runs on the audio file writer thread, so it must not use log macros.
+ *  If the audio is split into segments, the audio file closed is added to the audio segments manifest.
+ */
+int close_audio_encoder_file() {
+
+    if ( audio_encoder_file_fd == -1 ) {
+        return SUCCESS;
+    }
+
+    if ( close(audio_encoder_file_fd) == -1 ) {
+        audio_encoder_writer_error = errno;
+        audio_encoder_file_fd = -1;
+        return GENERIC_ERROR;
+    }
+    audio_encoder_file_fd = -1;
+
+    if ( audio_encoder_manifest_path[0] != '\0' ) {
+        if ( append_audio_encoder_manifest(audio_encoder_segment_path) != SUCCESS ) {
+            return GENERIC_ERROR;
+        }
+        atomic_fetch_add_explicit(&audio_encoder_segments_closed, 1, memory_order_relaxed);
+    }
+
+    return SUCCESS;
+}
+
+/*
+ * Configures the encoder of the audio captured.
+ *
+ * Parameters
+ *  encoder_configuration - The audio encoder configuration.
+ *  capture_configuration - The configuration of the audio being captured.
+ *
+ * Returns
+ *  SUCCESS - If the encoder was configured successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The encoder input follows the audio capture configuration, since it is what the PCM device delivers. A different sample rate on the encoder configuration is only informed.
+ */
+int configure_audio_encoder(audio_encoder_configuration_t* encoder_configuration, audio_capture_configuration_t* capture_configuration) {
+    LOG_TRACE_POINT;
+
+    MPEG_mode mode;
+
+    if ( strcmp(capture_configuration->sample_format, AUDIO_ENCODER_SUPPORTED_SAMPLE_FORMAT) != 0 || encoder_configuration->bit_width != AUDIO_ENCODER_SUPPORTED_BIT_WIDTH ) {
+        LOG_ERROR("Audio encoder only supports \"%s\" samples.", AUDIO_ENCODER_SUPPORTED_SAMPLE_FORMAT);
+        return GENERIC_ERROR;
+    }
+
+    if ( capture_configuration->channels != 1 && capture_configuration->channels != 2 ) {
+        LOG_ERROR("Audio encoder does not support %u channels.", capture_configuration->channels);
+        return GENERIC_ERROR;
+    }
+
+    switch ( encoder_configuration->channel_mode ) {
+        case 's':
+            mode = STEREO;
+            break;
+        case 'j':
+        case 'f':
+            mode = JOINT_STEREO;
+            break;
+        case 'd':
+            mode = DUAL_CHANNEL;
+            break;
+        case 'm':
+            mode = MONO;
+            break;
+        case 'a':
+            mode = NOT_SET;
+            break;
+        default:
+            LOG_ERROR("Unknown channel mode \"%c\".", encoder_configuration->channel_mode);
+            return GENERIC_ERROR;
+    }
+
+    if ( encoder_configuration->sample_rate != capture_configuration->sampling_rate ) {
+        LOG_WARNING("Audio encoder sample rate (%u) differs from audio capture sampling rate (%u). Encoding with %u.", encoder_configuration->sample_rate, capture_configuration->sampling_rate, capture_configuration->sampling_rate);
+    }
+
+    audio_encoder_lame = lame_init();
+    if ( audio_encoder_lame == NULL ) {
+        LOG_ERROR("Could not create the audio encoder.");
+        return GENERIC_ERROR;
+    }
+
+    lame_set_in_samplerate(audio_encoder_lame, (int)capture_configuration->sampling_rate);
+    lame_set_num_channels(audio_encoder_lame, (int)capture_configuration->channels);
+    lame_set_mode(audio_encoder_lame, mode);
+    lame_set_quality(audio_encoder_lame, (int)encoder_configuration->quality);
+
+    /* The audio file is written sequentially, so the tag frame which would be rewritten at its start is not used. */
+    lame_set_bWriteVbrTag(audio_encoder_lame, 0);
+
+    id3tag_init(audio_encoder_lame);
+    id3tag_set_comment(audio_encoder_lame, encoder_configuration->comment);
+
+    if ( lame_init_params(audio_encoder_lame) < 0 ) {
+        LOG_ERROR("Invalid audio encoder parameters.");
+        lame_close(audio_encoder_lame);
+        audio_encoder_lame = NULL;
+        return GENERIC_ERROR;
+    }
+
+    audio_encoder_channels = capture_configuration->channels;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Creates the audio file which will receive the audio encoded.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio file was created successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio record is named after the current instant, as the audio encoder scripts did, so it is listed by the audio record index like the records created before.
+ *  If the audio is split into segments, each segment file receives its number after the record name and an empty audio segments manifest is created along with the first segment.
+ */
+int create_audio_encoder_file() {
+    LOG_TRACE_POINT;
+
+    char* output_directory;
+    char current_time[32];
+    struct tm current_time_structure;
+    time_t current_time_seconds;
+    int manifest_fd;
+
+    output_directory = get_output_directory();
+    LOG_TRACE_POINT;
+
+    current_time_seconds = time(NULL);
+    localtime_r(&current_time_seconds, &current_time_structure);
+    strftime(current_time, sizeof(current_time), "%Y%m%d_%H%M%S", &current_time_structure);
+
+    snprintf(audio_encoder_record_name, AUDIO_ENCODER_RECORD_NAME_SIZE, "%s%s", AUDIO_FILE_PREFFIX, current_time);
+
+    audio_encoder_manifest_path[0] = '\0';
+    if ( audio_encoder_segment_samples > 0 ) {
+        LOG_TRACE_POINT;
+
+        snprintf(audio_encoder_manifest_path, AUDIO_ENCODER_FILE_PATH_SIZE, "%s%s%s%s", output_directory, AUDIO_DIRECTORY, audio_encoder_record_name, AUDIO_SEGMENTS_MANIFEST_SUFFIX);
+
+        manifest_fd = open(audio_encoder_manifest_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if ( manifest_fd == -1 ) {
+            LOG_ERROR("Could not create audio segments manifest.");
+            LOG_ERROR("%s", strerror(errno));
+            audio_encoder_manifest_path[0] = '\0';
+            free(output_directory);
+            return GENERIC_ERROR;
+        }
+        close(manifest_fd);
+    }
+
+    /* The output directory is kept on the segment path, so the next segments only replace the file name. */
+    snprintf(audio_encoder_segment_path, AUDIO_ENCODER_FILE_PATH_SIZE, "%s%s", output_directory, AUDIO_DIRECTORY);
+    free(output_directory);
+
+    audio_encoder_segment_number = 0;
+    if ( open_audio_encoder_file() != SUCCESS ) {
+        LOG_ERROR("Could not create audio file.");
+        LOG_ERROR("%s", strerror(audio_encoder_writer_error));
+        return GENERIC_ERROR;
+    }
+
+    strcpy(audio_encoder_file_path, audio_encoder_segment_path);
+
+    LOG_TRACE("Audio file: \"%s\".", strrchr(audio_encoder_file_path, '/') + 1);
+    return SUCCESS;
+}
+
+/*
+ * Encodes audio samples and sends the result to the audio file writer.
+ *
+ * Parameters
+ *  samples - The audio samples, interleaved by channel.
+ *  samples_size - The size of the audio samples in bytes. Must be aligned to frames.
+ *
+ * Returns
+ *  SUCCESS - If the samples were encoded successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  This function runs on the audio encoder thread, so it must not use log macros.
+ *  The audio segment is only rotated between two calls, so a segment can be up to one buffer of samples longer than configured.
+ */
+int encode_audio_samples(uint8_t* samples, size_t samples_size) {
+
+    int samples_per_channel;
+    int frames_before;
+    int encode_result;
+    uint64_t start_time;
+    int result = SUCCESS;
+
+    samples_per_channel = (int)( samples_size/( sizeof(short int)*audio_encoder_channels ) );
+    frames_before = lame_get_frameNum(audio_encoder_lame);
+
+    start_time = get_monotonic_time();
+    if ( audio_encoder_channels == 1 ) {
+        encode_result = lame_encode_buffer(audio_encoder_lame, (short int*)samples, NULL, samples_per_channel, audio_encoder_mp3_buffer, AUDIO_ENCODER_MP3_BUFFER_SIZE);
+    }
+    else {
+        encode_result = lame_encode_buffer_interleaved(audio_encoder_lame, (short int*)samples, samples_per_channel, audio_encoder_mp3_buffer, AUDIO_ENCODER_MP3_BUFFER_SIZE);
+    }
+    atomic_fetch_add_explicit(&audio_encoder_encode_time, (uint64_t)get_elapsed_time(start_time), memory_order_relaxed);
+
+    if ( encode_result < 0 ) {
+        audio_encoder_error = encode_result;
+        return GENERIC_ERROR;
+    }
+
+    atomic_fetch_add_explicit(&audio_encoder_frames_encoded, (uint64_t)( lame_get_frameNum(audio_encoder_lame) - frames_before ), memory_order_relaxed);
+    push_audio_encoder_output(audio_encoder_mp3_buffer, (size_t)encode_result);
+
+    if ( audio_encoder_segment_samples > 0 ) {
+        audio_encoder_segment_samples_encoded += (uint64_t)samples_per_channel;
+        if ( audio_encoder_segment_samples_encoded >= audio_encoder_segment_samples ) {
+            result = rotate_audio_encoder_segment();
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Returns the path of the audio file being encoded.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The path of the audio file being encoded or NULL if the audio encoder was never started.
+ */
+char* get_audio_encoder_file_path() {
+    LOG_TRACE_POINT;
+
+    char* result;
+
+    if ( audio_encoder_file_path[0] == '\0' ) {
+        LOG_TRACE_POINT;
+        return NULL;
+    }
+
+    result = (char*)malloc((strlen(audio_encoder_file_path) + 1)*sizeof(char));
+    strcpy(result, audio_encoder_file_path);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Returns the path of the manifest which lists the audio segments closed.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The path of the audio segments manifest or NULL if the audio is not split into segments.
+ */
+char* get_audio_encoder_manifest_path() {
+    LOG_TRACE_POINT;
+
+    char* result;
+
+    if ( audio_encoder_manifest_path[0] == '\0' ) {
+        LOG_TRACE_POINT;
+        return NULL;
+    }
+
+    result = (char*)malloc((strlen(audio_encoder_manifest_path) + 1)*sizeof(char));
+    strcpy(result, audio_encoder_manifest_path);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Returns the counters of the audio encoder.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The counters since the audio encoder has started.
+ *
+ * Observations
+ *  The average encode time of a frame is "encode_time/frames_encoded", in nanoseconds.
+ */
+audio_encoder_statistics_t get_audio_encoder_statistics() {
+    LOG_TRACE_POINT;
+
+    audio_encoder_statistics_t statistics;
+
+    statistics.capture_ring_size = get_audio_capture_ring_size();
+    statistics.capture_ring_high_water_mark = get_audio_capture_ring_high_water_mark();
+    statistics.capture_overruns = get_audio_capture_overruns();
+    statistics.capture_dropped_bytes = get_audio_capture_dropped_bytes();
+    statistics.frames_encoded = atomic_load_explicit(&audio_encoder_frames_encoded, memory_order_relaxed);
+    statistics.encode_time = atomic_load_explicit(&audio_encoder_encode_time, memory_order_relaxed);
+    statistics.output_ring_size = audio_encoder_output_ring.size;
+    statistics.output_ring_high_water_mark = get_byte_ring_high_water_mark(&audio_encoder_output_ring);
+    statistics.output_stalls = atomic_load_explicit(&audio_encoder_output_stalls, memory_order_relaxed);
+    statistics.segments_closed = atomic_load_explicit(&audio_encoder_segments_closed, memory_order_relaxed);
+    statistics.stream_dropped_bytes = atomic_load_explicit(&audio_encoder_stream_dropped_bytes, memory_order_relaxed);
+
+    LOG_TRACE_POINT;
+    return statistics;
+}
+
+/*
+ * Checks if the audio encoder is started.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  True - If the audio encoder was started and not stopped yet.
+ *  False - Otherwise.
+ */
+bool is_audio_encoder_running() {
+    LOG_TRACE_POINT;
+
+    return audio_encoder_started;
+}
+
+/*
+ * Opens the next audio file to be written.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio file was opened successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  This function runs on the audio file writer thread, so it must not use log macros.
+ */
+int open_audio_encoder_file() {
+
+    char* file_name;
+    size_t file_name_size;
+
+    file_name = strrchr(audio_encoder_segment_path, '/') + 1;
+    file_name_size = AUDIO_ENCODER_FILE_PATH_SIZE - (size_t)( file_name - audio_encoder_segment_path );
+
+    if ( audio_encoder_manifest_path[0] != '\0' ) {
+        audio_encoder_segment_number++;
+        snprintf(file_name, file_name_size, "%s_%04u%s", audio_encoder_record_name, audio_encoder_segment_number, AUDIO_FILE_SUFFIX);
+    }
+    else {
+        snprintf(file_name, file_name_size, "%s%s", audio_encoder_record_name, AUDIO_FILE_SUFFIX);
+    }
+
+    audio_encoder_file_fd = open(audio_encoder_segment_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if ( audio_encoder_file_fd == -1 ) {
+        audio_encoder_writer_error = errno;
+        return GENERIC_ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/*
+ * Sends the audio encoded to the audio file writer.
+ *
+ * Parameters
+ *  content - The audio encoded.
+ *  content_size - The size of the audio encoded.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  This function runs on the audio encoder thread, so it must not use log macros.
+ *  While the output ring is full the encoder waits for the writer, which lets the audio captured accumulate on the audio capture ring. If the writer has failed, the audio encoded is discarded.
+ *  While the audio is being streamed, the audio encoded is also copied to the stream ring. If the stream ring is full the audio encoded is discarded from the stream, so a slow stream never delays the audio encoder.
+ */
+void push_audio_encoder_output(uint8_t* content, size_t content_size) {
+
+    struct timespec stall_time;
+
+    stall_time.tv_sec = 0;
+    stall_time.tv_nsec = AUDIO_ENCODER_STALL_TIME*1000000L;
+
+    if ( content_size > 0 && atomic_load_explicit(&audio_encoder_streaming, memory_order_acquire) == true ) {
+        if ( write_byte_ring(&audio_encoder_stream_ring, content, content_size) == false ) {
+            atomic_fetch_add_explicit(&audio_encoder_stream_dropped_bytes, content_size, memory_order_relaxed);
+        }
+    }
+
+    while ( content_size > 0 && write_byte_ring(&audio_encoder_output_ring, content, content_size) == false ) {
+        if ( atomic_load_explicit(&audio_encoder_writer_failed, memory_order_acquire) == true ) {
+            return;
+        }
+        atomic_fetch_add_explicit(&audio_encoder_output_stalls, 1, memory_order_relaxed);
+        nanosleep(&stall_time, NULL);
+    }
+
+    audio_encoder_output_position += content_size;
+}
+
+/*
+ * Reads the audio encoded to be streamed.
+ *
+ * Parameters
+ *  buffer - The buffer where the audio encoded will be stored.
+ *  buffer_size - The size of the buffer.
+ *
+ * Returns
+ *  The number of bytes read. Zero if there is no audio encoded to be streamed.
+ *
+ * Observations
+ *  Only one thread can read the audio encoded to be streamed.
+ */
+size_t read_audio_encoder_stream(uint8_t* buffer, size_t buffer_size) {
+    LOG_TRACE_POINT;
+
+    if ( audio_encoder_stream_ring.size == 0 ) {
+        LOG_TRACE_POINT;
+        return 0;
+    }
+
+    return read_byte_ring(&audio_encoder_stream_ring, buffer, buffer_size);
+}
+
+/*
+ * Reads the audio encoder configuration.
+ *
+ * Parameters
+ *  configuration - The structure where the configuration read will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the configuration was read successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The configuration is read from the same files used by the audio encoder scripts, located on "configuration/audio/encode/" of the input directory.
+ */
+int read_audio_encoder_configuration(audio_encoder_configuration_t* configuration) {
+    LOG_TRACE_POINT;
+
+    char configuration_directory[AUDIO_ENCODER_FILE_PATH_SIZE];
+    char sample_rate[AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE];
+    char bit_width[AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE];
+    char channel_mode[AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE];
+    char quality[AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE];
+    char segment_length[AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE];
+    char* input_directory;
+    char* end;
+    double sample_rate_kilohertz;
+    size_t read_position;
+    size_t write_position;
+
+    input_directory = get_input_directory();
+    if ( input_directory == NULL ) {
+        LOG_ERROR("Could not find the input directory.");
+        return GENERIC_ERROR;
+    }
+
+    snprintf(configuration_directory, AUDIO_ENCODER_FILE_PATH_SIZE, "%s%s", input_directory, AUDIO_ENCODER_CONFIGURATION_DIRECTORY);
+    free(input_directory);
+
+    memset(configuration, 0, sizeof(audio_encoder_configuration_t));
+
+    if ( read_audio_encoder_configuration_file(configuration_directory, AUDIO_ENCODER_SAMPLE_RATE_FILE_NAME, sample_rate, AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE, false) != SUCCESS ||
+         read_audio_encoder_configuration_file(configuration_directory, AUDIO_ENCODER_BIT_WIDTH_FILE_NAME, bit_width, AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE, false) != SUCCESS ||
+         read_audio_encoder_configuration_file(configuration_directory, AUDIO_ENCODER_CHANNEL_MODE_FILE_NAME, channel_mode, AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE, false) != SUCCESS ||
+         read_audio_encoder_configuration_file(configuration_directory, AUDIO_ENCODER_QUALITY_FILE_NAME, quality, AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE, false) != SUCCESS ||
+         read_audio_encoder_configuration_file(configuration_directory, AUDIO_ENCODER_COMMENT_FILE_NAME, configuration->comment, AUDIO_ENCODER_COMMENT_SIZE, false) != SUCCESS ) {
+        LOG_ERROR("Could not read the audio encoder configuration.");
+        return GENERIC_ERROR;
+    }
+
+    /* The sample rate is informed in kilohertz, as the "lame" program expects. */
+    sample_rate_kilohertz = strtod(sample_rate, &end);
+    if ( *end != '\0' || sample_rate_kilohertz <= 0 ) {
+        LOG_ERROR("Invalid audio encoder sample rate \"%s\".", sample_rate);
+        return GENERIC_ERROR;
+    }
+    configuration->sample_rate = (unsigned int)( sample_rate_kilohertz*1000 + 0.5 );
+
+    configuration->bit_width = (unsigned int)strtoul(bit_width, &end, 10);
+    if ( *end != '\0' || configuration->bit_width == 0 ) {
+        LOG_ERROR("Invalid audio encoder bit width \"%s\".", bit_width);
+        return GENERIC_ERROR;
+    }
+
+    configuration->quality = (unsigned int)strtoul(quality, &end, 10);
+    if ( *end != '\0' || configuration->quality > 9 ) {
+        LOG_ERROR("Invalid audio encoder quality \"%s\".", quality);
+        return GENERIC_ERROR;
+    }
+
+    configuration->channel_mode = channel_mode[0];
+
+    if ( read_audio_encoder_configuration_file(configuration_directory, AUDIO_ENCODER_SEGMENT_LENGTH_FILE_NAME, segment_length, AUDIO_ENCODER_CONFIGURATION_VALUE_SIZE, true) != SUCCESS ) {
+        return GENERIC_ERROR;
+    }
+
+    /* Without the segment length file the audio record is written on a single file. */
+    if ( segment_length[0] != '\0' ) {
+        LOG_TRACE_POINT;
+
+        configuration->segment_length = (unsigned int)strtoul(segment_length, &end, 10);
+        if ( *end != '\0' ) {
+            LOG_ERROR("Invalid audio encoder segment length \"%s\".", segment_length);
+            return GENERIC_ERROR;
+        }
+    }
+
+    /* The comment file is escaped to be used on a shell command line. */
+    write_position = 0;
+    for ( read_position = 0; configuration->comment[read_position] != '\0'; read_position++ ) {
+        if ( configuration->comment[read_position] != '\\' ) {
+            configuration->comment[write_position++] = configuration->comment[read_position];
+        }
+    }
+    configuration->comment[write_position] = '\0';
+
+    LOG_TRACE("Sample rate: %u. Bit width: %u. Channel mode: %c. Quality: %u. Segment length: %u seconds.", configuration->sample_rate, configuration->bit_width, configuration->channel_mode, configuration->quality, configuration->segment_length);
+    return SUCCESS;
+}
+
+/*
+ * Reads a value from an audio encoder configuration file.
+ *
+ * Parameters
+ *  configuration_directory - The directory which contains the configuration file.
+ *  file_name - The name of the configuration file.
+ *  value - The buffer where the value read will be stored.
+ *  value_size - The size of the buffer.
+ *  optional - Indicates if the configuration file may not exist. In this case the value read is empty.
+ *
+ * Returns
+ *  SUCCESS - If the value was read successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int read_audio_encoder_configuration_file(const char* configuration_directory, const char* file_name, char* value, size_t value_size, bool optional) {
+    LOG_TRACE("File name: \"%s\".", file_name);
+
+    char file_path[AUDIO_ENCODER_FILE_PATH_SIZE];
+
+    snprintf(file_path, AUDIO_ENCODER_FILE_PATH_SIZE, "%s%s", configuration_directory, file_name);
+
+    if ( optional == true && file_exists(file_path) == false ) {
+        LOG_TRACE_POINT;
+        value[0] = '\0';
+        return SUCCESS;
+    }
+
+    if ( read_file_value(file_path, value, value_size) != SUCCESS ) {
+        LOG_ERROR("Could not read audio encoder configuration file \"%s\".", file_name);
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Finishes the current audio segment and starts a new one.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio segment was rotated successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  This function runs on the audio encoder thread, so it must not use log macros.
+ *  The encoder is flushed without a gap, so the segment ends on a frame boundary and the next one does not depend on its bit reservoir. The position where the next segment starts is informed to the audio file writer through the segment ring.
+ */
+int rotate_audio_encoder_segment() {
+
+    int flush_result;
+    uint64_t segment_position;
+    struct timespec stall_time;
+
+    flush_result = lame_encode_flush_nogap(audio_encoder_lame, audio_encoder_mp3_buffer, AUDIO_ENCODER_MP3_BUFFER_SIZE);
+    if ( flush_result < 0 ) {
+        audio_encoder_error = flush_result;
+        return GENERIC_ERROR;
+    }
+    push_audio_encoder_output(audio_encoder_mp3_buffer, (size_t)flush_result);
+
+    stall_time.tv_sec = 0;
+    stall_time.tv_nsec = AUDIO_ENCODER_STALL_TIME*1000000L;
+
+    segment_position = audio_encoder_output_position;
+    while ( write_byte_ring(&audio_encoder_segment_ring, (uint8_t*)&segment_position, sizeof(uint64_t)) == false ) {
+        if ( atomic_load_explicit(&audio_encoder_writer_failed, memory_order_acquire) == true ) {
+            break;
+        }
+        nanosleep(&stall_time, NULL);
+    }
+
+    if ( lame_init_bitstream(audio_encoder_lame) < 0 ) {
+        audio_encoder_error = -1;
+        return GENERIC_ERROR;
+    }
+
+    audio_encoder_segment_samples_encoded = 0;
+
+    return SUCCESS;
+}
+
+/*
+ * Encodes the audio captured until the audio capture finishes.
+ *
+ * Parameters
+ *  argument - Not used.
+ *
+ * Returns
+ *  NULL.
+ *
+ * Observations
+ *  This function runs on the audio encoder thread, so it must not use log macros. Any error is informed when the audio encoder is stopped.
+ */
+void* run_audio_encoder(void* argument) {
+
+    size_t read_size;
+    size_t content_size;
+    int flush_result;
+    bool encoder_concluded = false;
+    bool audio_encoded = false;
+
+    /* Audio is only read in whole frames. */
+    read_size = AUDIO_ENCODER_PCM_BUFFER_SIZE - AUDIO_ENCODER_PCM_BUFFER_SIZE%( sizeof(short int)*audio_encoder_channels );
+
+    while ( encoder_concluded == false ) {
+        switch ( wait_audio_capture(AUDIO_ENCODER_WAIT_TIME) ) {
+            case AUDIO_CAPTURED:
+                content_size = read_audio_capture(audio_encoder_pcm_buffer, read_size);
+                if ( encode_audio_samples(audio_encoder_pcm_buffer, content_size) != SUCCESS ) {
+                    encoder_concluded = true;
+                }
+                else if ( audio_encoded == false && content_size > 0 ) {
+                    publish_event_timestamp(TIMESTAMP_EVENT_FIRST_AUDIO_ENCODED);
+                    audio_encoded = true;
+                }
+                break;
+            case AUDIO_CAPTURE_WAIT_TIME_ELAPSED:
+                break;
+            case AUDIO_CAPTURE_FINISHED:
+                encoder_concluded = true;
+                break;
+            default:
+                audio_encoder_error = -errno;
+                encoder_concluded = true;
+                break;
+        }
+    }
+
+    flush_result = lame_encode_flush(audio_encoder_lame, audio_encoder_mp3_buffer, AUDIO_ENCODER_MP3_BUFFER_SIZE);
+    if ( flush_result < 0 ) {
+        audio_encoder_error = flush_result;
+    }
+    else {
+        push_audio_encoder_output(audio_encoder_mp3_buffer, (size_t)flush_result);
+    }
+
+    atomic_store_explicit(&audio_encoder_finished, true, memory_order_release);
+
+    return NULL;
+}
+
+/*
+ * Writes the audio encoded on the audio file until the audio encoder finishes.
+ *
+ * Parameters
+ *  argument - Not used.
+ *
+ * Returns
+ *  NULL.
+ *
+ * Observations
+ *  This function runs on the audio file writer thread, so it must not use log macros. Writing on a separate thread keeps the audio encoder from waiting on the storage.
+ *  When the audio written reaches the position of the next segment, the audio file is closed and the next one is opened. The last audio file is closed when the audio encoder finishes.
+ */
+void* run_audio_encoder_writer(void* argument) {
+
+    struct timespec idle_time;
+    size_t content_size;
+    size_t read_size;
+    uint64_t written_position = 0;
+    uint64_t segment_position = UINT64_MAX;
+    bool finished;
+    bool writer_concluded = false;
+
+    idle_time.tv_sec = 0;
+    idle_time.tv_nsec = AUDIO_ENCODER_WRITER_IDLE_TIME*1000000L;
+
+    while ( writer_concluded == false ) {
+        finished = atomic_load_explicit(&audio_encoder_finished, memory_order_acquire);
+
+        if ( segment_position == UINT64_MAX && read_byte_ring(&audio_encoder_segment_ring, (uint8_t*)&segment_position, sizeof(uint64_t)) == 0 ) {
+            segment_position = UINT64_MAX;
+        }
+
+        if ( segment_position == written_position ) {
+            if ( close_audio_encoder_file() != SUCCESS || open_audio_encoder_file() != SUCCESS ) {
+                atomic_store_explicit(&audio_encoder_writer_failed, true, memory_order_release);
+                writer_concluded = true;
+            }
+            segment_position = UINT64_MAX;
+            continue;
+        }
+
+        read_size = AUDIO_ENCODER_WRITER_BUFFER_SIZE;
+        if ( segment_position - written_position < read_size ) {
+            read_size = (size_t)( segment_position - written_position );
+        }
+
+        content_size = read_byte_ring(&audio_encoder_output_ring, audio_encoder_writer_buffer, read_size);
+        if ( content_size > 0 ) {
+            if ( write_audio_encoder_fd(audio_encoder_file_fd, audio_encoder_writer_buffer, content_size) != SUCCESS ) {
+                atomic_store_explicit(&audio_encoder_writer_failed, true, memory_order_release);
+                writer_concluded = true;
+            }
+            written_position += content_size;
+        }
+        else if ( finished == true ) {
+            writer_concluded = true;
+        }
+        else {
+            nanosleep(&idle_time, NULL);
+        }
+    }
+
+    if ( close_audio_encoder_file() != SUCCESS ) {
+        atomic_store_explicit(&audio_encoder_writer_failed, true, memory_order_release);
+    }
+
+    return NULL;
+}
+
+/*
+ * Starts the audio encoder.
+ *
+ * Parameters
+ *  encoder_configuration - The audio encoder configuration.
+ *  capture_configuration - The configuration of the audio being captured.
+ *
+ * Returns
+ *  SUCCESS - If the audio encoder was started successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio encoder reads the audio captured from the audio capture ring and encodes it on its own thread. The audio encoded is written on the audio directory by another thread, so a slow storage does not delay the encoding.
+ *  If "segment_length" is informed, the audio record is split into files of "segment_length" seconds and the ones closed are listed on the audio segments manifest.
+ */
+int start_audio_encoder(audio_encoder_configuration_t* encoder_configuration, audio_capture_configuration_t* capture_configuration) {
+    LOG_TRACE_POINT;
+
+    int create_result;
+
+    if ( audio_encoder_started == true ) {
+        LOG_ERROR("Audio encoder is already started.");
+        return GENERIC_ERROR;
+    }
+
+    if ( ( audio_encoder_output_ring.size == 0 && create_byte_ring(&audio_encoder_output_ring, AUDIO_ENCODER_OUTPUT_RING_SIZE) != SUCCESS ) ||
+         ( audio_encoder_segment_ring.size == 0 && create_byte_ring(&audio_encoder_segment_ring, AUDIO_ENCODER_SEGMENT_RING_SIZE) != SUCCESS ) ) {
+        LOG_ERROR("Could not create the audio encoder rings.");
+        return GENERIC_ERROR;
+    }
+    reset_byte_ring(&audio_encoder_output_ring);
+    reset_byte_ring(&audio_encoder_segment_ring);
+    atomic_store(&audio_encoder_streaming, false);
+
+    if ( configure_audio_encoder(encoder_configuration, capture_configuration) != SUCCESS ) {
+        LOG_ERROR("Could not configure the audio encoder.");
+        return GENERIC_ERROR;
+    }
+
+    audio_encoder_segment_samples = (uint64_t)encoder_configuration->segment_length*capture_configuration->sampling_rate;
+    audio_encoder_segment_samples_encoded = 0;
+    audio_encoder_output_position = 0;
+
+    if ( create_audio_encoder_file() != SUCCESS ) {
+        lame_close(audio_encoder_lame);
+        audio_encoder_lame = NULL;
+        return GENERIC_ERROR;
+    }
+
+    audio_encoder_error = 0;
+    audio_encoder_writer_error = 0;
+    atomic_store(&audio_encoder_frames_encoded, 0);
+    atomic_store(&audio_encoder_encode_time, 0);
+    atomic_store(&audio_encoder_output_stalls, 0);
+    atomic_store(&audio_encoder_segments_closed, 0);
+    atomic_store(&audio_encoder_stream_dropped_bytes, 0);
+    atomic_store(&audio_encoder_writer_failed, false);
+    atomic_store(&audio_encoder_finished, false);
+
+    create_result = pthread_create(&audio_encoder_writer_thread, NULL, run_audio_encoder_writer, NULL);
+    if ( create_result == 0 ) {
+        create_result = pthread_create(&audio_encoder_thread, NULL, run_audio_encoder, NULL);
+        if ( create_result != 0 ) {
+            atomic_store(&audio_encoder_finished, true);
+            pthread_join(audio_encoder_writer_thread, NULL);
+        }
+    }
+
+    if ( create_result != 0 ) {
+        LOG_ERROR("Could not create the audio encoder threads.");
+        LOG_ERROR("%s", strerror(create_result));
+        close(audio_encoder_file_fd);
+        audio_encoder_file_fd = -1;
+        lame_close(audio_encoder_lame);
+        audio_encoder_lame = NULL;
+        return GENERIC_ERROR;
+    }
+
+    audio_encoder_started = true;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Starts copying the audio encoded to the stream ring.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio stream was started successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Any audio encoded left on the stream ring by a previous stream is discarded, so the stream starts with the latest audio encoded.
+ */
+int start_audio_encoder_stream() {
+    LOG_TRACE_POINT;
+
+    if ( audio_encoder_started == false ) {
+        LOG_ERROR("Audio encoder is not started.");
+        return GENERIC_ERROR;
+    }
+
+    if ( audio_encoder_stream_ring.size == 0 && create_byte_ring(&audio_encoder_stream_ring, AUDIO_ENCODER_STREAM_RING_SIZE) != SUCCESS ) {
+        LOG_ERROR("Could not create the audio encoder stream ring.");
+        return GENERIC_ERROR;
+    }
+
+    /* Only the stream reader consumes the stream ring, so it can discard its content while the audio encoder writes on it. */
+    discard_byte_ring(&audio_encoder_stream_ring, get_byte_ring_content_size(&audio_encoder_stream_ring));
+    atomic_store_explicit(&audio_encoder_streaming, true, memory_order_release);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Stops the audio encoder.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio encoder was stopped successfully or was not started.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio encoder only finishes after encoding all audio captured, so the audio capture must be stopped before.
+ */
+int stop_audio_encoder() {
+    LOG_TRACE_POINT;
+
+    int result = SUCCESS;
+    audio_encoder_statistics_t statistics;
+
+    if ( audio_encoder_started == false ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    if ( pthread_join(audio_encoder_thread, NULL) != 0 || pthread_join(audio_encoder_writer_thread, NULL) != 0 ) {
+        LOG_ERROR("Error while waiting the audio encoder threads to finish.");
+        result = GENERIC_ERROR;
+    }
+
+    if ( audio_encoder_error != 0 ) {
+        LOG_ERROR("Audio encoder was interrupted by an error (%d).", audio_encoder_error);
+        result = GENERIC_ERROR;
+    }
+
+    if ( audio_encoder_writer_error != 0 ) {
+        LOG_ERROR("Error while writing the audio files.");
+        LOG_ERROR("%s", strerror(audio_encoder_writer_error));
+        result = GENERIC_ERROR;
+    }
+
+    lame_close(audio_encoder_lame);
+    audio_encoder_lame = NULL;
+    audio_encoder_started = false;
+
+    statistics = get_audio_encoder_statistics();
+    LOG_TRACE("Frames encoded: %llu. Encode time per frame: %llu nanoseconds.", (unsigned long long)statistics.frames_encoded, (unsigned long long)( statistics.frames_encoded == 0 ? 0 : statistics.encode_time/statistics.frames_encoded ));
+    LOG_TRACE("Capture ring high-water mark: %zu of %zu bytes. Overruns: %llu.", statistics.capture_ring_high_water_mark, statistics.capture_ring_size, (unsigned long long)statistics.capture_overruns);
+    LOG_TRACE("Output ring high-water mark: %zu of %zu bytes. Stalls: %llu.", statistics.output_ring_high_water_mark, statistics.output_ring_size, (unsigned long long)statistics.output_stalls);
+    LOG_TRACE("Audio segments closed: %llu. Stream bytes discarded: %llu.", (unsigned long long)statistics.segments_closed, (unsigned long long)statistics.stream_dropped_bytes);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Stops copying the audio encoded to the stream ring.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio stream was stopped successfully.
+ */
+int stop_audio_encoder_stream() {
+    LOG_TRACE_POINT;
+
+    atomic_store_explicit(&audio_encoder_streaming, false, memory_order_release);
+
+    LOG_TRACE("Stream bytes discarded: %llu.", (unsigned long long)atomic_load_explicit(&audio_encoder_stream_dropped_bytes, memory_order_relaxed));
+    return SUCCESS;
+}
+
+/*
+ * Writes content on a file of the audio record.
+ *
+ * Parameters
+ *  file_fd - The descriptor of the file to be written.
+ *  content - The content to be written.
+ *  content_size - The size of the content.
+ *
+ * Returns
+ *  SUCCESS - If the whole content was written successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  This function runs on the audio file writer thread, so it must not use log macros.
+ */
+int write_audio_encoder_fd(int file_fd, uint8_t* content, size_t content_size) {
+
+    ssize_t bytes_written;
+    size_t total_written = 0;
+
+    while ( total_written < content_size ) {
+        bytes_written = write(file_fd, content + total_written, content_size - total_written);
+        if ( bytes_written == -1 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            audio_encoder_writer_error = errno;
+            return GENERIC_ERROR;
+        }
+        total_written += (size_t)bytes_written;
+    }
+
+    return SUCCESS;
+}
@@ -0,0 +1,813 @@
+/*
+ * This source file contains the elaboration of all components required to keep an index of the audio records stored.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "audio/record_index.h"
+#include "directory.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Path to the audio directory, relative to the output directory. */
+#define AUDIO_DIRECTORY "audio/"
+
+/* Preffix of the audio record file names. */
+#define AUDIO_RECORD_FILE_PREFFIX "audio_"
+
+/* Suffix of the audio record file names. */
+#define AUDIO_RECORD_FILE_SUFFIX ".mp3"
+
+/* Suffix of the manifest which lists the segments of an audio record. */
+#define AUDIO_SEGMENTS_MANIFEST_SUFFIX ".segments"
+
+/* Maximum size of the audio directory path. */
+#define AUDIO_RECORD_INDEX_DIRECTORY_SIZE 512
+
+/* Number of audio records the index holds when it is created. */
+#define AUDIO_RECORD_INDEX_INITIAL_CAPACITY 64
+
+/* Events of the audio directory which change the index. */
+#define AUDIO_RECORD_INDEX_EVENTS (IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF)
+
+/* Size of the buffer used to read the audio directory events. */
+#define AUDIO_RECORD_INDEX_EVENTS_BUFFER_SIZE 4096
+
+/* Size of the ID3v2 tag header. */
+#define ID3V2_HEADER_SIZE 10
+
+
+/*
+ * Variables.
+ */
+
+/* Path to the audio directory. */
+char audio_record_index_directory[AUDIO_RECORD_INDEX_DIRECTORY_SIZE];
+
+/* Indicates that the audio record index was started and not stopped yet. */
+bool audio_record_index_started = false;
+
+/* Descriptor which informs the changes on the audio directory. -1 if the changes cannot be watched. */
+int audio_record_index_fd = -1;
+
+/* Controls the access to the index by the threads which read and update it. */
+pthread_mutex_t audio_record_index_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Audio records on the index, sorted by their modification time. */
+audio_record_t* audio_record_index_records = NULL;
+
+/* Number of audio records on the index. */
+size_t audio_record_index_count = 0;
+
+/* Number of audio records the index can hold without being enlarged. */
+size_t audio_record_index_capacity = 0;
+
+/* Bit rates (in kbit/s) of the MPEG 1 layer III frames. */
+const uint16_t mpeg1_layer3_bit_rates[] = { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0 };
+
+/* Bit rates (in kbit/s) of the MPEG 2 and 2.5 layer III frames. */
+const uint16_t mpeg2_layer3_bit_rates[] = { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0 };
+
+
+/*
+ * Function headers.
+ */
+
+/* Compares two audio records by their modification time. */
+int compare_audio_records(const void*, const void*);
+
+/* Finds the position of an audio record on the index. */
+ssize_t find_indexed_audio_record(const char*);
+
+/* Adds or updates an audio record on the index. */
+int index_audio_record(const char*);
+
+/* Checks if a file name is an audio record file name. */
+bool is_audio_record_name(const char*);
+
+/* Checks if a file name is the name of a segment of an audio record. */
+bool is_audio_segment_name(const char*);
+
+/* Reads the duration of an audio record. */
+uint32_t read_audio_record_duration(int, off_t);
+
+/* Removes an audio record from the index. */
+void remove_indexed_audio_record(const char*);
+
+/* Fills the index with the audio records on the audio directory. */
+int seed_audio_record_index();
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Compares two audio records by their modification time.
+ *
+ * Parameters
+ *  first - The first audio record.
+ *  second - The second audio record.
+ *
+ * Returns
+ *  A negative number if the first audio record is older than the second, a positive number if it is newer or zero if they are the same record.
+ *
+ * Observations
+ *  Audio records modified at the same time are sorted by their names.
+ */
+int compare_audio_records(const void* first, const void* second) {
+    const audio_record_t* first_record = (const audio_record_t*)first;
+    const audio_record_t* second_record = (const audio_record_t*)second;
+
+    if ( first_record->modification_time.tv_sec != second_record->modification_time.tv_sec ) {
+        return ( first_record->modification_time.tv_sec < second_record->modification_time.tv_sec ? -1 : 1 );
+    }
+
+    if ( first_record->modification_time.tv_nsec != second_record->modification_time.tv_nsec ) {
+        return ( first_record->modification_time.tv_nsec < second_record->modification_time.tv_nsec ? -1 : 1 );
+    }
+
+    return strcmp(first_record->name, second_record->name);
+}
+
+/*
+ * Finds the position of an audio record on the index.
+ *
+ * Parameters
+ *  name - The audio record file name.
+ *
+ * Returns
+ *  The position of the audio record on the index or -1 if it is not indexed.
+ */
+ssize_t find_indexed_audio_record(const char* name) {
+    LOG_TRACE_POINT;
+
+    size_t counter;
+
+    for ( counter = audio_record_index_count; counter > 0; counter-- ) {
+        if ( strcmp(audio_record_index_records[counter - 1].name, name) == 0 ) {
+            LOG_TRACE_POINT;
+            return (ssize_t)(counter - 1);
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return -1;
+}
+
+/*
+ * Returns the descriptor which informs the changes on the audio directory.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The descriptor, which becomes readable when the audio directory changes, or -1 if the changes are not watched.
+ *
+ * Observations
+ *  The descriptor changes if the index is started again, so it must be read again after each update.
+ */
+int get_audio_record_index_fd() {
+    LOG_TRACE_POINT;
+
+    return audio_record_index_fd;
+}
+
+/*
+ * Returns an audio record of the index.
+ *
+ * Parameters
+ *  position - Position of the audio record on the index. The oldest audio record is on position zero.
+ *
+ * Returns
+ *  The audio record or NULL if there is no audio record on the position informed.
+ *
+ * Observations
+ *  The audio record returned is only valid until the index is updated.
+ */
+const audio_record_t* get_indexed_audio_record(size_t position) {
+    LOG_TRACE("Position: %zu.", position);
+
+    if ( position >= audio_record_index_count ) {
+        LOG_TRACE_POINT;
+        return NULL;
+    }
+
+    LOG_TRACE_POINT;
+    return &audio_record_index_records[position];
+}
+
+/*
+ * Returns the number of audio records on the index.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The number of audio records on the index.
+ */
+size_t get_indexed_audio_records_count() {
+    LOG_TRACE_POINT;
+
+    return audio_record_index_count;
+}
+
+/*
+ * Returns the latest audio record of the index.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The audio record modified most recently or NULL if there is no audio record.
+ *
+ * Observations
+ *  The audio record returned is only valid until the index is updated.
+ */
+const audio_record_t* get_latest_indexed_audio_record() {
+    LOG_TRACE_POINT;
+
+    if ( audio_record_index_count == 0 ) {
+        LOG_TRACE_POINT;
+        return NULL;
+    }
+
+    LOG_TRACE_POINT;
+    return &audio_record_index_records[audio_record_index_count - 1];
+}
+
+/*
+ * Adds or updates an audio record on the index.
+ *
+ * Parameters
+ *  name - The audio record file name.
+ *
+ * Returns
+ *  SUCCESS - If the audio record was indexed successfully or it is not an audio record.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  New audio records are the most recent ones, so they are usually added at the end of the index without moving the others.
+ */
+int index_audio_record(const char* name) {
+    LOG_TRACE_POINT;
+
+    char file_path[AUDIO_RECORD_INDEX_DIRECTORY_SIZE + AUDIO_RECORD_NAME_SIZE];
+    audio_record_t audio_record;
+    audio_record_t* records;
+    struct stat file_stat;
+    size_t first;
+    size_t last;
+    size_t middle;
+    int file_fd;
+
+    remove_indexed_audio_record(name);
+
+    if ( is_audio_record_name(name) == false ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    snprintf(file_path, sizeof(file_path), "%s%s", audio_record_index_directory, name);
+
+    file_fd = open(file_path, O_RDONLY);
+    if ( file_fd == -1 ) {
+        LOG_TRACE("Audio record was removed before being indexed.");
+        return SUCCESS;
+    }
+
+    if ( fstat(file_fd, &file_stat) != 0 || S_ISREG(file_stat.st_mode) == false ) {
+        LOG_TRACE_POINT;
+        close(file_fd);
+        return SUCCESS;
+    }
+
+    strcpy(audio_record.name, name);
+    audio_record.size = file_stat.st_size;
+    audio_record.modification_time = file_stat.st_mtim;
+    audio_record.duration = read_audio_record_duration(file_fd, file_stat.st_size);
+    close(file_fd);
+
+    if ( audio_record_index_count == audio_record_index_capacity ) {
+        records = (audio_record_t*)realloc(audio_record_index_records, 2*audio_record_index_capacity*sizeof(audio_record_t));
+        if ( records == NULL ) {
+            LOG_ERROR("Could not allocate memory to enlarge the audio record index.");
+            return GENERIC_ERROR;
+        }
+        audio_record_index_records = records;
+        audio_record_index_capacity *= 2;
+    }
+
+    first = 0;
+    last = audio_record_index_count;
+    if ( last > 0 && compare_audio_records(&audio_record_index_records[last - 1], &audio_record) < 0 ) {
+        first = last;
+    }
+
+    while ( first < last ) {
+        middle = first + (last - first)/2;
+        if ( compare_audio_records(&audio_record_index_records[middle], &audio_record) < 0 ) {
+            first = middle + 1;
+        }
+        else {
+            last = middle;
+        }
+    }
+
+    memmove(&audio_record_index_records[first + 1], &audio_record_index_records[first], (audio_record_index_count - first)*sizeof(audio_record_t));
+    memcpy(&audio_record_index_records[first], &audio_record, sizeof(audio_record_t));
+    audio_record_index_count++;
+
+    LOG_TRACE("Audio records indexed: %zu.", audio_record_index_count);
+    return SUCCESS;
+}
+
+/*
+ * Checks if a file name is an audio record file name.
+ *
+ * Parameters
+ *  name - The file name.
+ *
+ * Returns
+ *  True - If the file name is an audio record file name.
+ *  False - Otherwise.
+ *
+ * Observations
+ *  The segments of an audio record are not audio records themselves, so they are not indexed.
+ */
+bool is_audio_record_name(const char* name) {
+    LOG_TRACE_POINT;
+
+    size_t name_length = strlen(name);
+    size_t preffix_length = strlen(AUDIO_RECORD_FILE_PREFFIX);
+    size_t suffix_length = strlen(AUDIO_RECORD_FILE_SUFFIX);
+
+    if ( name_length <= preffix_length + suffix_length || name_length >= AUDIO_RECORD_NAME_SIZE ) {
+        LOG_TRACE_POINT;
+        return false;
+    }
+
+    if ( strncmp(name, AUDIO_RECORD_FILE_PREFFIX, preffix_length) != 0 || strcmp(name + name_length - suffix_length, AUDIO_RECORD_FILE_SUFFIX) != 0 ) {
+        LOG_TRACE_POINT;
+        return false;
+    }
+
+    if ( is_audio_segment_name(name) == true ) {
+        LOG_TRACE("\"%s\" is an audio segment.", name);
+        return false;
+    }
+
+    LOG_TRACE_POINT;
+    return true;
+}
+
+/*
+ * Checks if a file name is the name of a segment of an audio record.
+ *
+ * Parameters
+ *  name - The file name. It must end with the audio record file suffix.
+ *
+ * Returns
+ *  True - If the file name is the name of an audio segment.
+ *  False - Otherwise.
+ *
+ * Observations
+ *  An audio segment is named after its audio record followed by an underscore and its number. As an audio record name can also end with digits, the name is only taken as a segment if the manifest of the audio record it belongs exists. The audio encoder creates this manifest before the first segment.
+ */
+bool is_audio_segment_name(const char* name) {
+    LOG_TRACE_POINT;
+
+    char manifest_path[AUDIO_RECORD_INDEX_DIRECTORY_SIZE + AUDIO_RECORD_NAME_SIZE];
+    size_t number_end = strlen(name) - strlen(AUDIO_RECORD_FILE_SUFFIX);
+    size_t number_start = number_end;
+
+    while ( number_start > 0 && isdigit((unsigned char)name[number_start - 1]) ) {
+        number_start--;
+    }
+
+    if ( number_start == number_end || number_start < 2 || name[number_start - 1] != '_' ) {
+        LOG_TRACE_POINT;
+        return false;
+    }
+
+    snprintf(manifest_path, sizeof(manifest_path), "%s%.*s%s", audio_record_index_directory, (int)(number_start - 1), name, AUDIO_SEGMENTS_MANIFEST_SUFFIX);
+
+    LOG_TRACE_POINT;
+    return ( access(manifest_path, F_OK) == 0 );
+}
+
+/*
+ * Locks the index, so other threads cannot read nor update it.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  While the audio catalog updater is running, the index must be locked around its updates and readings, including while the audio records returned are used.
+ */
+void lock_audio_record_index() {
+    LOG_TRACE_POINT;
+
+    pthread_mutex_lock(&audio_record_index_mutex);
+}
+
+/*
+ * Reads the duration of an audio record.
+ *
+ * Parameters
+ *  file_fd - Descriptor of the audio record file.
+ *  file_size - Size of the audio record file.
+ *
+ * Returns
+ *  The duration (in milliseconds) of the audio record or zero if it could not be determined.
+ *
+ * Observations
+ *  The duration is calculated from the bit rate of the first MPEG frame, so it is exact for audio records encoded with constant bit rate, as the audio encoder does. Only the ID3v2 tag and the first frame header are read.
+ */
+uint32_t read_audio_record_duration(int file_fd, off_t file_size) {
+    LOG_TRACE_POINT;
+
+    uint8_t header[ID3V2_HEADER_SIZE];
+    off_t audio_offset = 0;
+    uint32_t version;
+    uint32_t layer;
+    uint32_t bit_rate;
+
+    if ( pread(file_fd, header, ID3V2_HEADER_SIZE, 0) != ID3V2_HEADER_SIZE ) {
+        LOG_TRACE_POINT;
+        return 0;
+    }
+
+    if ( memcmp(header, "ID3", 3) == 0 ) {
+        audio_offset = ID3V2_HEADER_SIZE + ((off_t)(header[6] & 0x7f) << 21 | (header[7] & 0x7f) << 14 | (header[8] & 0x7f) << 7 | (header[9] & 0x7f));
+        if ( ( header[5] & 0x10 ) != 0 ) {
+            audio_offset += ID3V2_HEADER_SIZE;
+        }
+
+        if ( pread(file_fd, header, 4, audio_offset) != 4 ) {
+            LOG_TRACE_POINT;
+            return 0;
+        }
+    }
+
+    if ( header[0] != 0xff || ( header[1] & 0xe0 ) != 0xe0 ) {
+        LOG_TRACE("Audio record does not start with an MPEG frame.");
+        return 0;
+    }
+
+    version = ( header[1] >> 3 ) & 0x03;
+    layer = ( header[1] >> 1 ) & 0x03;
+    if ( version == 1 || layer != 1 ) {
+        LOG_TRACE("Audio record is not encoded with MPEG layer III.");
+        return 0;
+    }
+
+    bit_rate = ( version == 3 ? mpeg1_layer3_bit_rates[header[2] >> 4] : mpeg2_layer3_bit_rates[header[2] >> 4] );
+    if ( bit_rate == 0 || file_size <= audio_offset ) {
+        LOG_TRACE_POINT;
+        return 0;
+    }
+
+    LOG_TRACE_POINT;
+    return (uint32_t)((uint64_t)(file_size - audio_offset)*8/bit_rate);
+}
+
+/*
+ * Removes an audio record from the index.
+ *
+ * Parameters
+ *  name - The audio record file name.
+ *
+ * Returns
+ *  Nothing.
+ */
+void remove_indexed_audio_record(const char* name) {
+    LOG_TRACE_POINT;
+
+    ssize_t position;
+
+    position = find_indexed_audio_record(name);
+    if ( position == -1 ) {
+        LOG_TRACE_POINT;
+        return;
+    }
+
+    memmove(&audio_record_index_records[position], &audio_record_index_records[position + 1], (audio_record_index_count - position - 1)*sizeof(audio_record_t));
+    audio_record_index_count--;
+
+    LOG_TRACE_POINT;
+}
+
+/*
+ * Fills the index with the audio records on the audio directory.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the index was filled successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio records already indexed are discarded. The audio records are sorted only once, after all of them were read.
+ */
+int seed_audio_record_index() {
+    LOG_TRACE_POINT;
+
+    DIR* directory;
+    struct dirent* entry;
+    audio_record_t* audio_record;
+    audio_record_t* records;
+    struct stat file_stat;
+    int directory_fd;
+    int file_fd;
+    int errno_value;
+
+    audio_record_index_count = 0;
+
+    directory = opendir(audio_record_index_directory);
+    if ( directory == NULL ) {
+        errno_value = errno;
+        LOG_ERROR("Could not open the audio directory.");
+        LOG_ERROR("%s", strerror(errno_value));
+        return GENERIC_ERROR;
+    }
+    directory_fd = dirfd(directory);
+
+    while ( ( entry = readdir(directory) ) != NULL ) {
+        if ( is_audio_record_name(entry->d_name) == false ) {
+            continue;
+        }
+
+        file_fd = openat(directory_fd, entry->d_name, O_RDONLY);
+        if ( file_fd == -1 ) {
+            continue;
+        }
+
+        if ( fstat(file_fd, &file_stat) != 0 || S_ISREG(file_stat.st_mode) == false ) {
+            close(file_fd);
+            continue;
+        }
+
+        if ( audio_record_index_count == audio_record_index_capacity ) {
+            records = (audio_record_t*)realloc(audio_record_index_records, 2*audio_record_index_capacity*sizeof(audio_record_t));
+            if ( records == NULL ) {
+                LOG_ERROR("Could not allocate memory to enlarge the audio record index.");
+                close(file_fd);
+                closedir(directory);
+                return GENERIC_ERROR;
+            }
+            audio_record_index_records = records;
+            audio_record_index_capacity *= 2;
+        }
+
+        audio_record = &audio_record_index_records[audio_record_index_count];
+        strcpy(audio_record->name, entry->d_name);
+        audio_record->size = file_stat.st_size;
+        audio_record->modification_time = file_stat.st_mtim;
+        audio_record->duration = read_audio_record_duration(file_fd, file_stat.st_size);
+        close(file_fd);
+
+        audio_record_index_count++;
+    }
+    closedir(directory);
+
+    qsort(audio_record_index_records, audio_record_index_count, sizeof(audio_record_t), compare_audio_records);
+
+    LOG_TRACE("Audio records indexed: %zu.", audio_record_index_count);
+    return SUCCESS;
+}
+
+/*
+ * Starts the audio record index.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the audio record index was started successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The changes on the audio directory are watched before it is read, so no audio record created while the index is filled is lost. If the changes cannot be watched, the audio directory is read again on every update.
+ */
+int start_audio_record_index() {
+    LOG_TRACE_POINT;
+
+    char* output_directory;
+    int errno_value;
+
+    if ( audio_record_index_started == true ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    output_directory = get_output_directory();
+    if ( strlen(output_directory) + strlen(AUDIO_DIRECTORY) >= AUDIO_RECORD_INDEX_DIRECTORY_SIZE ) {
+        LOG_ERROR("The audio directory path is too long.");
+        free(output_directory);
+        return GENERIC_ERROR;
+    }
+    strcpy(audio_record_index_directory, output_directory);
+    strcat(audio_record_index_directory, AUDIO_DIRECTORY);
+    free(output_directory);
+
+    audio_record_index_records = (audio_record_t*)malloc(AUDIO_RECORD_INDEX_INITIAL_CAPACITY*sizeof(audio_record_t));
+    if ( audio_record_index_records == NULL ) {
+        LOG_ERROR("Could not allocate memory for the audio record index.");
+        return GENERIC_ERROR;
+    }
+    audio_record_index_capacity = AUDIO_RECORD_INDEX_INITIAL_CAPACITY;
+    audio_record_index_count = 0;
+
+    audio_record_index_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if ( audio_record_index_fd == -1 ) {
+        errno_value = errno;
+        LOG_WARNING("Could not watch the audio directory. It will be read on every update.");
+        LOG_WARNING("%s", strerror(errno_value));
+    }
+    else if ( inotify_add_watch(audio_record_index_fd, audio_record_index_directory, AUDIO_RECORD_INDEX_EVENTS) == -1 ) {
+        errno_value = errno;
+        LOG_WARNING("Could not watch the audio directory. It will be read on every update.");
+        LOG_WARNING("%s", strerror(errno_value));
+        close(audio_record_index_fd);
+        audio_record_index_fd = -1;
+    }
+
+    if ( seed_audio_record_index() != SUCCESS ) {
+        LOG_ERROR("Could not read the audio directory.");
+        if ( audio_record_index_fd != -1 ) {
+            close(audio_record_index_fd);
+            audio_record_index_fd = -1;
+        }
+        free(audio_record_index_records);
+        audio_record_index_records = NULL;
+        audio_record_index_capacity = 0;
+        return GENERIC_ERROR;
+    }
+
+    audio_record_index_started = true;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Stops the audio record index.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - The audio record index is always stopped successfully.
+ */
+int stop_audio_record_index() {
+    LOG_TRACE_POINT;
+
+    if ( audio_record_index_started == false ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    if ( audio_record_index_fd != -1 ) {
+        close(audio_record_index_fd);
+        audio_record_index_fd = -1;
+    }
+
+    free(audio_record_index_records);
+    audio_record_index_records = NULL;
+    audio_record_index_count = 0;
+    audio_record_index_capacity = 0;
+    audio_record_index_started = false;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Unlocks the index, so other threads can read and update it.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  Nothing.
+ */
+void unlock_audio_record_index() {
+    LOG_TRACE_POINT;
+
+    pthread_mutex_unlock(&audio_record_index_mutex);
+}
+
+/*
+ * Updates the audio record index with the changes made on the audio directory.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the index was updated successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The index is started if it was not. The changes are read without waiting, so only the audio records changed since the last update are read from the audio directory. If changes were lost or the audio directory was replaced, the index is started again.
+ */
+int update_audio_record_index() {
+    LOG_TRACE_POINT;
+
+    char events_buffer[AUDIO_RECORD_INDEX_EVENTS_BUFFER_SIZE] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    const struct inotify_event* event;
+    ssize_t bytes_read;
+    char* buffer_position;
+    bool restart_required = false;
+    int errno_value;
+
+    if ( audio_record_index_started == false ) {
+        LOG_TRACE_POINT;
+        return start_audio_record_index();
+    }
+
+    if ( audio_record_index_fd == -1 ) {
+        LOG_TRACE_POINT;
+        return seed_audio_record_index();
+    }
+
+    while ( restart_required == false ) {
+        bytes_read = read(audio_record_index_fd, events_buffer, AUDIO_RECORD_INDEX_EVENTS_BUFFER_SIZE);
+
+        if ( bytes_read == -1 ) {
+            errno_value = errno;
+            if ( errno_value == EAGAIN || errno_value == EWOULDBLOCK ) {
+                LOG_TRACE_POINT;
+                break;
+            }
+            if ( errno_value == EINTR ) {
+                continue;
+            }
+            LOG_ERROR("Error while reading the audio directory changes.");
+            LOG_ERROR("%s", strerror(errno_value));
+            restart_required = true;
+            break;
+        }
+
+        for ( buffer_position = events_buffer; buffer_position < events_buffer + bytes_read; buffer_position += sizeof(struct inotify_event) + event->len ) {
+            event = (const struct inotify_event*)buffer_position;
+
+            if ( ( event->mask & ( IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED ) ) != 0 ) {
+                LOG_WARNING("Changes on the audio directory were lost. Reading it again.");
+                restart_required = true;
+                break;
+            }
+
+            if ( event->len == 0 ) {
+                continue;
+            }
+
+            if ( ( event->mask & ( IN_DELETE | IN_MOVED_FROM ) ) != 0 ) {
+                remove_indexed_audio_record(event->name);
+            }
+            else if ( index_audio_record(event->name) != SUCCESS ) {
+                restart_required = true;
+                break;
+            }
+        }
+    }
+
+    if ( restart_required == true ) {
+        stop_audio_record_index();
+        LOG_TRACE_POINT;
+        return start_audio_record_index();
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
@@ -0,0 +1,1028 @@
+/*
+ * This source file contains the elaboration of all components required to encode and decode binary log files.
+ *
+ * A binary log file starts with a header, followed by records. Each record starts with a variable length integer which contains the identifier of a call site and a flag informing if the record defines the call site or registers a message of it.
+ * A call site is defined on file before its first message, with its line, message type, function, source file and message format.
+ * A message record contains the time elapsed since the previous record and the arguments of the message format, encoded without formatting.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "binary_log.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Flags accepted on a conversion specification. */
+#define CONVERSION_FLAGS "-+ #0'"
+
+/* Size of the buffer used to rebuild a conversion specification. */
+#define CONVERSION_SPECIFICATION_SIZE 32
+
+/* Maximum value accepted for width and precision of a conversion specification. */
+#define CONVERSION_MAXIMUM_FIELD_SIZE 1024
+
+/* Codes to identify the type of argument of a conversion specification. */
+#define ARGUMENT_TYPE_NONE 0
+#define ARGUMENT_TYPE_SIGNED 1
+#define ARGUMENT_TYPE_UNSIGNED 2
+#define ARGUMENT_TYPE_CHARACTER 3
+#define ARGUMENT_TYPE_DOUBLE 4
+#define ARGUMENT_TYPE_STRING 5
+#define ARGUMENT_TYPE_POINTER 6
+#define ARGUMENT_TYPE_UNSUPPORTED 7
+
+
+/*
+ * Function headers.
+ */
+
+/* Decodes a string of a call site. */
+int decode_binary_log_string(char**, const uint8_t*, size_t, size_t*);
+
+/* Encodes a string of a call site. */
+size_t encode_binary_log_string(uint8_t*, const char*);
+
+/* Returns the type of argument of a conversion. */
+int get_argument_type(char);
+
+/* Reads a double argument. */
+double read_double_argument(va_list*, const char*);
+
+/* Reads a signed integer argument. */
+int64_t read_signed_argument(va_list*, const char*);
+
+/* Reads an unsigned integer argument. */
+uint64_t read_unsigned_argument(va_list*, const char*);
+
+/* Converts a zigzag encoded integer to a signed integer. */
+int64_t zigzag_decode(uint64_t);
+
+/* Converts a signed integer to a zigzag encoded integer. */
+uint64_t zigzag_encode(int64_t);
+
+
+/*
+ * Function elaborations.
+ *
+ * These functions are used by the log module to write log records, so they must not use log macros.
+ */
+
+/*
+ * Formats a log message with its arguments decoded from a binary record.
+ *
+ * Parameters
+ *  message - Buffer where the message will be formatted.
+ *  message_size - Size of "message" buffer.
+ *  format - The format of the log message.
+ *  arguments - The arguments encoded on the binary record.
+ *  arguments_size - Size of "arguments" buffer.
+ *
+ * Returns
+ *  SUCCESS - If the message was formatted.
+ *  GENERIC_ERROR - If a parameter is invalid.
+ *
+ * Observations
+ *  If the arguments end before the format, or the format has a conversion which cannot be encoded, the rest of the format is copied without formatting.
+ */
+int decode_binary_log_arguments(char* message, size_t message_size, const char* format, const uint8_t* arguments, size_t arguments_size) {
+
+    binary_log_conversion_t conversion;
+    char specification[CONVERSION_SPECIFICATION_SIZE];
+    char string_value[LOG_MESSAGE_BUFFER_SIZE + 1];
+    const char* character;
+    size_t message_length = 0;
+    size_t specification_length;
+    size_t position = 0;
+    size_t flags_length;
+    uint64_t value;
+    double double_value;
+    int argument_type;
+    int width;
+    int precision;
+    int written;
+    bool decoding = true;
+
+    if ( message == NULL || message_size == 0 ) {
+        return GENERIC_ERROR;
+    }
+
+    if ( format == NULL ) {
+        message[0] = '\0';
+        return SUCCESS;
+    }
+
+    character = format;
+    while ( *character != '\0' && message_length < message_size - 1 ) {
+
+        if ( *character != '%' || decoding == false ) {
+            message[message_length++] = *character;
+            character++;
+            continue;
+        }
+
+        parse_binary_log_conversion(character, &conversion);
+        argument_type = get_argument_type(conversion.conversion);
+
+        if ( argument_type == ARGUMENT_TYPE_NONE ) {
+            message[message_length++] = '%';
+            character += conversion.size;
+            continue;
+        }
+
+        if ( argument_type == ARGUMENT_TYPE_UNSUPPORTED ) {
+            decoding = false;
+            continue;
+        }
+
+        flags_length = strlen(conversion.flags);
+        width = conversion.width;
+        if ( conversion.width_argument == true ) {
+            if ( decode_binary_log_varint(&value, arguments, arguments_size, &position) != SUCCESS ) {
+                decoding = false;
+                continue;
+            }
+            width = (int)zigzag_decode(value);
+
+            /* A negative width is a "-" flag followed by a positive width. */
+            if ( width < 0 ) {
+                width = -width;
+                if ( flags_length < sizeof(conversion.flags) - 1 ) {
+                    conversion.flags[flags_length++] = '-';
+                    conversion.flags[flags_length] = '\0';
+                }
+            }
+            if ( width > CONVERSION_MAXIMUM_FIELD_SIZE ) {
+                width = CONVERSION_MAXIMUM_FIELD_SIZE;
+            }
+        }
+
+        precision = conversion.precision;
+        if ( conversion.precision_argument == true ) {
+            if ( decode_binary_log_varint(&value, arguments, arguments_size, &position) != SUCCESS ) {
+                decoding = false;
+                continue;
+            }
+            precision = (int)zigzag_decode(value);
+            if ( precision > CONVERSION_MAXIMUM_FIELD_SIZE ) {
+                precision = CONVERSION_MAXIMUM_FIELD_SIZE;
+            }
+        }
+
+        if ( argument_type == ARGUMENT_TYPE_DOUBLE ) {
+            if ( position > arguments_size || arguments_size - position < sizeof(double) ) {
+                decoding = false;
+                continue;
+            }
+            memcpy(&double_value, arguments + position, sizeof(double));
+            position += sizeof(double);
+        }
+        else {
+            if ( decode_binary_log_varint(&value, arguments, arguments_size, &position) != SUCCESS ) {
+                decoding = false;
+                continue;
+            }
+        }
+
+        if ( argument_type == ARGUMENT_TYPE_STRING ) {
+            if ( value > arguments_size - position ) {
+                decoding = false;
+                continue;
+            }
+            if ( value > LOG_MESSAGE_BUFFER_SIZE ) {
+                memcpy(string_value, arguments + position, LOG_MESSAGE_BUFFER_SIZE);
+                string_value[LOG_MESSAGE_BUFFER_SIZE] = '\0';
+            }
+            else {
+                memcpy(string_value, arguments + position, value);
+                string_value[value] = '\0';
+            }
+            position += value;
+        }
+
+        /* Pointers are printed the same way "printf" does on GNU C library. */
+        if ( argument_type == ARGUMENT_TYPE_POINTER ) {
+            if ( value == 0 ) {
+                strcpy(string_value, "(nil)");
+            }
+            else {
+                snprintf(string_value, sizeof(string_value), "0x%" PRIx64, value);
+            }
+            precision = -1;
+        }
+
+        specification_length = snprintf(specification, CONVERSION_SPECIFICATION_SIZE, "%%%s", conversion.flags);
+        if ( width >= 0 ) {
+            specification_length += snprintf(specification + specification_length, CONVERSION_SPECIFICATION_SIZE - specification_length, "%d", width);
+        }
+        if ( precision >= 0 ) {
+            specification_length += snprintf(specification + specification_length, CONVERSION_SPECIFICATION_SIZE - specification_length, ".%d", precision);
+        }
+
+        switch ( argument_type ) {
+            case ARGUMENT_TYPE_SIGNED:
+                snprintf(specification + specification_length, CONVERSION_SPECIFICATION_SIZE - specification_length, "ll%c", conversion.conversion);
+                written = snprintf(message + message_length, message_size - message_length, specification, (long long)zigzag_decode(value));
+                break;
+
+            case ARGUMENT_TYPE_UNSIGNED:
+                snprintf(specification + specification_length, CONVERSION_SPECIFICATION_SIZE - specification_length, "ll%c", conversion.conversion);
+                written = snprintf(message + message_length, message_size - message_length, specification, (unsigned long long)value);
+                break;
+
+            case ARGUMENT_TYPE_CHARACTER:
+                snprintf(specification + specification_length, CONVERSION_SPECIFICATION_SIZE - specification_length, "c");
+                written = snprintf(message + message_length, message_size - message_length, specification, (int)value);
+                break;
+
+            case ARGUMENT_TYPE_DOUBLE:
+                snprintf(specification + specification_length, CONVERSION_SPECIFICATION_SIZE - specification_length, "%c", conversion.conversion);
+                written = snprintf(message + message_length, message_size - message_length, specification, double_value);
+                break;
+
+            default:
+                snprintf(specification + specification_length, CONVERSION_SPECIFICATION_SIZE - specification_length, "s");
+                written = snprintf(message + message_length, message_size - message_length, specification, string_value);
+                break;
+        }
+
+        if ( written > 0 ) {
+            message_length += written;
+            if ( message_length > message_size - 1 ) {
+                message_length = message_size - 1;
+            }
+        }
+        character += conversion.size;
+    }
+
+    message[message_length] = '\0';
+
+    return SUCCESS;
+}
+
+/*
+ * Decodes a call site from a binary log.
+ *
+ * Parameters
+ *  call_site - The variable where the call site will be stored. Its strings are allocated and must be released by the caller.
+ *  buffer - The buffer with the binary log.
+ *  buffer_size - Size of "buffer" parameter.
+ *  position - Position of the call site on buffer, after its identifier. It is moved to the end of the call site.
+ *
+ * Returns
+ *  SUCCESS - If the call site was decoded successfully.
+ *  BINARY_LOG_TRUNCATED - If the buffer ends before the call site.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int decode_binary_log_call_site(log_call_site_t* call_site, const uint8_t* buffer, size_t buffer_size, size_t* position) {
+
+    uint64_t line;
+    uint64_t message_type;
+    char* function = NULL;
+    char* file = NULL;
+    char* format = NULL;
+    int result;
+
+    result = decode_binary_log_varint(&line, buffer, buffer_size, position);
+    if ( result == SUCCESS ) {
+        result = decode_binary_log_varint(&message_type, buffer, buffer_size, position);
+    }
+    if ( result == SUCCESS ) {
+        result = decode_binary_log_string(&function, buffer, buffer_size, position);
+    }
+    if ( result == SUCCESS ) {
+        result = decode_binary_log_string(&file, buffer, buffer_size, position);
+    }
+    if ( result == SUCCESS ) {
+        result = decode_binary_log_string(&format, buffer, buffer_size, position);
+    }
+
+    if ( result != SUCCESS ) {
+        free(function);
+        free(file);
+        free(format);
+        return result;
+    }
+
+    call_site->function = function;
+    call_site->file = file;
+    call_site->format = format;
+    call_site->line = (int)line;
+    call_site->message_type = (int)message_type;
+
+    return SUCCESS;
+}
+
+/*
+ * Decodes the header of a binary log.
+ *
+ * Parameters
+ *  header - The variable where the header will be stored.
+ *  buffer - The buffer with the binary log header.
+ *  buffer_size - Size of "buffer" parameter.
+ *
+ * Returns
+ *  SUCCESS - If the header was decoded successfully.
+ *  BINARY_LOG_TRUNCATED - If the buffer is smaller than a header.
+ *  GENERIC_ERROR - If the buffer does not start with a binary log header.
+ */
+int decode_binary_log_header(binary_log_header_t* header, const uint8_t* buffer, size_t buffer_size) {
+
+    size_t position;
+
+    if ( buffer_size < BINARY_LOG_HEADER_SIZE ) {
+        return BINARY_LOG_TRUNCATED;
+    }
+
+    if ( memcmp(buffer, BINARY_LOG_MAGIC, BINARY_LOG_MAGIC_SIZE) != 0 ) {
+        return GENERIC_ERROR;
+    }
+
+    position = BINARY_LOG_MAGIC_SIZE;
+    memcpy(&header->version, buffer + position, sizeof(uint32_t));
+    position += sizeof(uint32_t);
+    memcpy(&header->real_time, buffer + position, sizeof(int64_t));
+    position += sizeof(int64_t);
+    memcpy(&header->monotonic_time, buffer + position, sizeof(uint64_t));
+
+    return SUCCESS;
+}
+
+/*
+ * Decodes the header of a binary log record.
+ *
+ * Parameters
+ *  record_header - The variable where the record header will be stored.
+ *  buffer - The buffer with the binary log.
+ *  buffer_size - Size of "buffer" parameter.
+ *  position - Position of the record on buffer. It is moved to the end of the record header.
+ *
+ * Returns
+ *  SUCCESS - If the record header was decoded successfully.
+ *  BINARY_LOG_TRUNCATED - If the buffer ends before the record header.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  If the record defines a call site, only its identifier is decoded, and the call site must be decoded through "decode_binary_log_call_site" function.
+ */
+int decode_binary_log_record_header(binary_log_record_header_t* record_header, const uint8_t* buffer, size_t buffer_size, size_t* position) {
+
+    uint64_t value;
+    int result;
+
+    memset(record_header, 0, sizeof(binary_log_record_header_t));
+
+    result = decode_binary_log_varint(&value, buffer, buffer_size, position);
+    if ( result != SUCCESS ) {
+        return result;
+    }
+
+    record_header->call_site_identifier = (uint32_t)(value >> 1);
+    record_header->call_site_definition = ( ( value & BINARY_LOG_CALL_SITE_DEFINITION ) != 0 );
+
+    if ( record_header->call_site_definition == true ) {
+        return SUCCESS;
+    }
+
+    result = decode_binary_log_varint(&value, buffer, buffer_size, position);
+    if ( result != SUCCESS ) {
+        return result;
+    }
+    record_header->thread_identifier = (uint32_t)value;
+
+    result = decode_binary_log_varint(&value, buffer, buffer_size, position);
+    if ( result != SUCCESS ) {
+        return result;
+    }
+    record_header->time_elapsed = zigzag_decode(value);
+
+    result = decode_binary_log_varint(&value, buffer, buffer_size, position);
+    if ( result != SUCCESS ) {
+        return result;
+    }
+
+    if ( value > buffer_size - *position ) {
+        return BINARY_LOG_TRUNCATED;
+    }
+    record_header->arguments_size = (size_t)value;
+
+    return SUCCESS;
+}
+
+/*
+ * Decodes a string of a call site.
+ *
+ * Parameters
+ *  string - The variable where the string will be stored. It is allocated and must be released by the caller. If the string encoded is null, it stores NULL.
+ *  buffer - The buffer with the binary log.
+ *  buffer_size - Size of "buffer" parameter.
+ *  position - Position of the string on buffer. It is moved to the end of the string.
+ *
+ * Returns
+ *  SUCCESS - If the string was decoded successfully.
+ *  BINARY_LOG_TRUNCATED - If the buffer ends before the string.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int decode_binary_log_string(char** string, const uint8_t* buffer, size_t buffer_size, size_t* position) {
+
+    uint64_t length;
+    int result;
+
+    result = decode_binary_log_varint(&length, buffer, buffer_size, position);
+    if ( result != SUCCESS ) {
+        return result;
+    }
+
+    if ( length == 0 ) {
+        *string = NULL;
+        return SUCCESS;
+    }
+    length--;
+
+    if ( length > BINARY_LOG_MAXIMUM_STRING_SIZE ) {
+        return GENERIC_ERROR;
+    }
+
+    if ( length > buffer_size - *position ) {
+        return BINARY_LOG_TRUNCATED;
+    }
+
+    *string = malloc(length + 1);
+    if ( *string == NULL ) {
+        return GENERIC_ERROR;
+    }
+
+    memcpy(*string, buffer + *position, length);
+    (*string)[length] = '\0';
+    *position += length;
+
+    return SUCCESS;
+}
+
+/*
+ * Decodes a variable length integer from a binary log.
+ *
+ * Parameters
+ *  value - The variable where the integer will be stored.
+ *  buffer - The buffer with the binary log.
+ *  buffer_size - Size of "buffer" parameter.
+ *  position - Position of the integer on buffer. It is moved to the end of the integer.
+ *
+ * Returns
+ *  SUCCESS - If the integer was decoded successfully.
+ *  BINARY_LOG_TRUNCATED - If the buffer ends before the integer.
+ *  GENERIC_ERROR - If the integer is longer than the maximum size.
+ *
+ * Observations
+ *  The integer is stored seven bits on each byte, starting by the least significant bits. The most significant bit of each byte informs if there are more bytes.
+ */
+int decode_binary_log_varint(uint64_t* value, const uint8_t* buffer, size_t buffer_size, size_t* position) {
+
+    uint64_t result = 0;
+    unsigned int shift = 0;
+    uint8_t byte;
+
+    do {
+        if ( *position >= buffer_size ) {
+            return BINARY_LOG_TRUNCATED;
+        }
+
+        if ( shift >= 7*BINARY_LOG_VARINT_MAXIMUM_SIZE ) {
+            return GENERIC_ERROR;
+        }
+
+        byte = buffer[*position];
+        (*position)++;
+
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while ( ( byte & 0x80 ) != 0 );
+
+    *value = result;
+
+    return SUCCESS;
+}
+
+/*
+ * Encodes the arguments of a log message.
+ *
+ * Parameters
+ *  buffer - The buffer where the arguments will be encoded.
+ *  buffer_size - Size of "buffer" parameter.
+ *  format - The format of the log message.
+ *  arguments - The arguments of the log message.
+ *
+ * Returns
+ *  The number of bytes encoded on buffer.
+ *
+ * Observations
+ *  Integers are encoded as variable length integers, doubles with their eight bytes and strings with their length followed by their characters.
+ *  If an argument does not fit on buffer, or the format has a conversion which cannot be encoded (like "%n"), the arguments after it are not encoded. Strings are truncated to fit on buffer.
+ */
+size_t encode_binary_log_arguments(uint8_t* buffer, size_t buffer_size, const char* format, va_list arguments) {
+
+    binary_log_conversion_t conversion;
+    va_list arguments_copy;
+    const char* character;
+    const char* string_value;
+    size_t position = 0;
+    size_t string_length;
+    double double_value;
+    int argument_type;
+    bool encoding = true;
+
+    if ( buffer == NULL || format == NULL ) {
+        return 0;
+    }
+
+    /* A "va_list" parameter may be an array, so a copy is used to read it through a pointer. */
+    va_copy(arguments_copy, arguments);
+
+    character = format;
+    while ( *character != '\0' && encoding == true ) {
+
+        if ( *character != '%' ) {
+            character++;
+            continue;
+        }
+
+        character += parse_binary_log_conversion(character, &conversion);
+        argument_type = get_argument_type(conversion.conversion);
+
+        if ( argument_type == ARGUMENT_TYPE_NONE ) {
+            continue;
+        }
+
+        if ( argument_type == ARGUMENT_TYPE_UNSUPPORTED ) {
+            encoding = false;
+            continue;
+        }
+
+        if ( conversion.width_argument == true ) {
+            if ( buffer_size - position < BINARY_LOG_VARINT_MAXIMUM_SIZE ) {
+                encoding = false;
+                continue;
+            }
+            position += encode_binary_log_varint(buffer + position, zigzag_encode(va_arg(arguments_copy, int)));
+        }
+
+        if ( conversion.precision_argument == true ) {
+            if ( buffer_size - position < BINARY_LOG_VARINT_MAXIMUM_SIZE ) {
+                encoding = false;
+                continue;
+            }
+            position += encode_binary_log_varint(buffer + position, zigzag_encode(va_arg(arguments_copy, int)));
+        }
+
+        if ( buffer_size - position < BINARY_LOG_VARINT_MAXIMUM_SIZE ) {
+            encoding = false;
+            continue;
+        }
+
+        switch ( argument_type ) {
+            case ARGUMENT_TYPE_SIGNED:
+                position += encode_binary_log_varint(buffer + position, zigzag_encode(read_signed_argument(&arguments_copy, conversion.length)));
+                break;
+
+            case ARGUMENT_TYPE_UNSIGNED:
+                position += encode_binary_log_varint(buffer + position, read_unsigned_argument(&arguments_copy, conversion.length));
+                break;
+
+            case ARGUMENT_TYPE_CHARACTER:
+                position += encode_binary_log_varint(buffer + position, (unsigned char)va_arg(arguments_copy, int));
+                break;
+
+            case ARGUMENT_TYPE_DOUBLE:
+                double_value = read_double_argument(&arguments_copy, conversion.length);
+                memcpy(buffer + position, &double_value, sizeof(double));
+                position += sizeof(double);
+                break;
+
+            case ARGUMENT_TYPE_STRING:
+                string_value = va_arg(arguments_copy, const char*);
+                if ( string_value == NULL ) {
+                    string_value = "(null)";
+                }
+                string_length = strnlen(string_value, buffer_size - position - BINARY_LOG_VARINT_MAXIMUM_SIZE);
+                position += encode_binary_log_varint(buffer + position, string_length);
+                memcpy(buffer + position, string_value, string_length);
+                position += string_length;
+                break;
+
+            case ARGUMENT_TYPE_POINTER:
+                position += encode_binary_log_varint(buffer + position, (uintptr_t)va_arg(arguments_copy, void*));
+                break;
+        }
+    }
+
+    va_end(arguments_copy);
+
+    return position;
+}
+
+/*
+ * Encodes a call site.
+ *
+ * Parameters
+ *  buffer - The buffer where the call site will be encoded. It must have at least "BINARY_LOG_CALL_SITE_MAXIMUM_SIZE" bytes.
+ *  call_site_identifier - The identifier of the call site on the binary log.
+ *  call_site - The call site to be encoded.
+ *
+ * Returns
+ *  The number of bytes encoded on buffer.
+ */
+size_t encode_binary_log_call_site(uint8_t* buffer, uint32_t call_site_identifier, const log_call_site_t* call_site) {
+
+    size_t position = 0;
+
+    position += encode_binary_log_varint(buffer + position, ((uint64_t)call_site_identifier << 1) | BINARY_LOG_CALL_SITE_DEFINITION);
+    position += encode_binary_log_varint(buffer + position, (uint64_t)call_site->line);
+    position += encode_binary_log_varint(buffer + position, (uint64_t)call_site->message_type);
+    position += encode_binary_log_string(buffer + position, call_site->function);
+    position += encode_binary_log_string(buffer + position, call_site->file);
+    position += encode_binary_log_string(buffer + position, call_site->format);
+
+    return position;
+}
+
+/*
+ * Encodes the header of a binary log.
+ *
+ * Parameters
+ *  buffer - The buffer where the header will be encoded. It must have at least "BINARY_LOG_HEADER_SIZE" bytes.
+ *  header - The header to be encoded.
+ *
+ * Returns
+ *  The number of bytes encoded on buffer.
+ */
+size_t encode_binary_log_header(uint8_t* buffer, binary_log_header_t header) {
+
+    size_t position;
+
+    memcpy(buffer, BINARY_LOG_MAGIC, BINARY_LOG_MAGIC_SIZE);
+    position = BINARY_LOG_MAGIC_SIZE;
+    memcpy(buffer + position, &header.version, sizeof(uint32_t));
+    position += sizeof(uint32_t);
+    memcpy(buffer + position, &header.real_time, sizeof(int64_t));
+    position += sizeof(int64_t);
+    memcpy(buffer + position, &header.monotonic_time, sizeof(uint64_t));
+    position += sizeof(uint64_t);
+
+    return position;
+}
+
+/*
+ * Encodes the header of a binary log record.
+ *
+ * Parameters
+ *  buffer - The buffer where the record header will be encoded. It must have at least "BINARY_LOG_RECORD_HEADER_MAXIMUM_SIZE" bytes.
+ *  call_site_identifier - The identifier of the call site which registered the record.
+ *  thread_identifier - The identifier of the thread which registered the record.
+ *  time_elapsed - Time elapsed (in nanoseconds) since the previous record. It can be negative, since records are not always written on the order they were registered.
+ *  arguments_size - Size of the arguments encoded after the record header.
+ *
+ * Returns
+ *  The number of bytes encoded on buffer.
+ */
+size_t encode_binary_log_record_header(uint8_t* buffer, uint32_t call_site_identifier, uint32_t thread_identifier, int64_t time_elapsed, size_t arguments_size) {
+
+    size_t position = 0;
+
+    position += encode_binary_log_varint(buffer + position, (uint64_t)call_site_identifier << 1);
+    position += encode_binary_log_varint(buffer + position, thread_identifier);
+    position += encode_binary_log_varint(buffer + position, zigzag_encode(time_elapsed));
+    position += encode_binary_log_varint(buffer + position, arguments_size);
+
+    return position;
+}
+
+/*
+ * Encodes a string of a call site.
+ *
+ * Parameters
+ *  buffer - The buffer where the string will be encoded.
+ *  string - The string to be encoded. It can be null.
+ *
+ * Returns
+ *  The number of bytes encoded on buffer.
+ *
+ * Observations
+ *  The string is encoded with its length plus one followed by its characters. A null string is encoded as a zero length.
+ */
+size_t encode_binary_log_string(uint8_t* buffer, const char* string) {
+
+    size_t position;
+    size_t length;
+
+    if ( string == NULL ) {
+        return encode_binary_log_varint(buffer, 0);
+    }
+
+    length = strnlen(string, BINARY_LOG_MAXIMUM_STRING_SIZE);
+    position = encode_binary_log_varint(buffer, length + 1);
+    memcpy(buffer + position, string, length);
+
+    return position + length;
+}
+
+/*
+ * Encodes a variable length integer.
+ *
+ * Parameters
+ *  buffer - The buffer where the integer will be encoded. It must have at least "BINARY_LOG_VARINT_MAXIMUM_SIZE" bytes.
+ *  value - The integer to be encoded.
+ *
+ * Returns
+ *  The number of bytes encoded on buffer.
+ */
+size_t encode_binary_log_varint(uint8_t* buffer, uint64_t value) {
+
+    size_t position = 0;
+
+    while ( value >= 0x80 ) {
+        buffer[position++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[position++] = (uint8_t)value;
+
+    return position;
+}
+
+/*
+ * Returns the type of argument of a conversion.
+ *
+ * Parameters
+ *  conversion - The conversion character.
+ *
+ * Returns
+ *  The code of the argument type.
+ */
+int get_argument_type(char conversion) {
+
+    switch ( conversion ) {
+        case '%':
+            return ARGUMENT_TYPE_NONE;
+
+        case 'd':
+        case 'i':
+            return ARGUMENT_TYPE_SIGNED;
+
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            return ARGUMENT_TYPE_UNSIGNED;
+
+        case 'c':
+            return ARGUMENT_TYPE_CHARACTER;
+
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            return ARGUMENT_TYPE_DOUBLE;
+
+        case 's':
+            return ARGUMENT_TYPE_STRING;
+
+        case 'p':
+            return ARGUMENT_TYPE_POINTER;
+
+        default:
+            return ARGUMENT_TYPE_UNSUPPORTED;
+    }
+}
+
+/*
+ * Parses a conversion specification of a log message format.
+ *
+ * Parameters
+ *  format - The format, starting on the "%" character of the conversion specification.
+ *  conversion - The variable where the conversion specification will be stored.
+ *
+ * Returns
+ *  The number of characters of the conversion specification.
+ */
+size_t parse_binary_log_conversion(const char* format, binary_log_conversion_t* conversion) {
+
+    size_t position = 1;
+    size_t flags_length = 0;
+
+    memset(conversion, 0, sizeof(binary_log_conversion_t));
+    conversion->width = -1;
+    conversion->precision = -1;
+
+    while ( format[position] != '\0' && strchr(CONVERSION_FLAGS, format[position]) != NULL ) {
+        if ( flags_length < sizeof(conversion->flags) - 1 ) {
+            conversion->flags[flags_length++] = format[position];
+        }
+        position++;
+    }
+
+    if ( format[position] == '*' ) {
+        conversion->width_argument = true;
+        position++;
+    }
+    else {
+        while ( format[position] >= '0' && format[position] <= '9' ) {
+            if ( conversion->width < 0 ) {
+                conversion->width = 0;
+            }
+            if ( conversion->width < CONVERSION_MAXIMUM_FIELD_SIZE ) {
+                conversion->width = conversion->width*10 + (format[position] - '0');
+            }
+            position++;
+        }
+    }
+
+    if ( format[position] == '.' ) {
+        position++;
+        if ( format[position] == '*' ) {
+            conversion->precision_argument = true;
+            position++;
+        }
+        else {
+            conversion->precision = 0;
+            while ( format[position] >= '0' && format[position] <= '9' ) {
+                if ( conversion->precision < CONVERSION_MAXIMUM_FIELD_SIZE ) {
+                    conversion->precision = conversion->precision*10 + (format[position] - '0');
+                }
+                position++;
+            }
+        }
+    }
+
+    if ( ( format[position] == 'h' && format[position + 1] == 'h' ) || ( format[position] == 'l' && format[position + 1] == 'l' ) ) {
+        conversion->length[0] = format[position];
+        conversion->length[1] = format[position + 1];
+        position += 2;
+    }
+    else if ( format[position] != '\0' && strchr("hljztLq", format[position]) != NULL ) {
+        conversion->length[0] = format[position];
+        position++;
+    }
+
+    conversion->conversion = format[position];
+    if ( format[position] != '\0' ) {
+        position++;
+    }
+
+    conversion->size = position;
+
+    return position;
+}
+
+/*
+ * Reads a double argument.
+ *
+ * Parameters
+ *  arguments - The arguments of the log message.
+ *  length - The length modifier of the conversion specification.
+ *
+ * Returns
+ *  The value of the argument.
+ */
+double read_double_argument(va_list* arguments, const char* length) {
+
+    if ( strcmp(length, "L") == 0 ) {
+        return (double)va_arg(*arguments, long double);
+    }
+
+    return va_arg(*arguments, double);
+}
+
+/*
+ * Reads a signed integer argument.
+ *
+ * Parameters
+ *  arguments - The arguments of the log message.
+ *  length - The length modifier of the conversion specification.
+ *
+ * Returns
+ *  The value of the argument.
+ */
+int64_t read_signed_argument(va_list* arguments, const char* length) {
+
+    if ( strcmp(length, "ll") == 0 || strcmp(length, "q") == 0 ) {
+        return va_arg(*arguments, long long);
+    }
+
+    if ( strcmp(length, "l") == 0 ) {
+        return va_arg(*arguments, long);
+    }
+
+    if ( strcmp(length, "j") == 0 ) {
+        return va_arg(*arguments, intmax_t);
+    }
+
+    if ( strcmp(length, "z") == 0 ) {
+        return (ssize_t)va_arg(*arguments, size_t);
+    }
+
+    if ( strcmp(length, "t") == 0 ) {
+        return va_arg(*arguments, ptrdiff_t);
+    }
+
+    if ( strcmp(length, "hh") == 0 ) {
+        return (signed char)va_arg(*arguments, int);
+    }
+
+    if ( strcmp(length, "h") == 0 ) {
+        return (short)va_arg(*arguments, int);
+    }
+
+    return va_arg(*arguments, int);
+}
+
+/*
+ * Reads an unsigned integer argument.
+ *
+ * Parameters
+ *  arguments - The arguments of the log message.
+ *  length - The length modifier of the conversion specification.
+ *
+ * Returns
+ *  The value of the argument.
+ */
+uint64_t read_unsigned_argument(va_list* arguments, const char* length) {
+
+    if ( strcmp(length, "ll") == 0 || strcmp(length, "q") == 0 ) {
+        return va_arg(*arguments, unsigned long long);
+    }
+
+    if ( strcmp(length, "l") == 0 ) {
+        return va_arg(*arguments, unsigned long);
+    }
+
+    if ( strcmp(length, "j") == 0 ) {
+        return va_arg(*arguments, uintmax_t);
+    }
+
+    if ( strcmp(length, "z") == 0 ) {
+        return va_arg(*arguments, size_t);
+    }
+
+    if ( strcmp(length, "t") == 0 ) {
+        return (uint64_t)va_arg(*arguments, ptrdiff_t);
+    }
+
+    if ( strcmp(length, "hh") == 0 ) {
+        return (unsigned char)va_arg(*arguments, unsigned int);
+    }
+
+    if ( strcmp(length, "h") == 0 ) {
+        return (unsigned short)va_arg(*arguments, unsigned int);
+    }
+
+    return va_arg(*arguments, unsigned int);
+}
+
+/*
+ * Converts a zigzag encoded integer to a signed integer.
+ *
+ * Parameters
+ *  value - The zigzag encoded integer.
+ *
+ * Returns
+ *  The signed integer.
+ */
+int64_t zigzag_decode(uint64_t value) {
+
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+/*
+ * Converts a signed integer to a zigzag encoded integer.
+ *
+ * Parameters
+ *  value - The signed integer.
+ *
+ * Returns
+ *  The zigzag encoded integer, which keeps small negative values small.
+ */
+uint64_t zigzag_encode(int64_t value) {
+
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
@@ -13,16 +13,22 @@
  */
 
 #include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
 #include <libgen.h>
 #include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "bluetooth/package/codes.h"
 #include "bluetooth/communication.h"
 #include "bluetooth/connection.h"
+#include "bluetooth/event_loop.h"
+#include "digest.h"
 #include "file.h"
 #include "log.h"
 #include "return_codes.h"
-#include "wait_time.h"
 
 
 /*
@@ -32,35 +38,158 @@
 /* Maximum attempts to write content on a connection socket. */
 #define MAXIMUM_WRITE_ATTEMPTS 10
 
-/* Maximum attempts to read content from a connection socket. */
-#define MAXIMUM_READ_ATTEMPTS 30
+/* Time (in milliseconds) to wait for a package to arrive on a connection socket. */
+#define RECEIVE_PACKAGE_TIMEOUT 9000
 
-/* Size of the buffer to store file data chunks. */
-#define DATA_CHUNK_BUFFER_SIZE 1024*64
+/* Time (in milliseconds) to wait for a package confirmation to arrive on a connection socket. */
+#define RECEIVE_CONFIRMATION_TIMEOUT 9000
+
+/* Time (in milliseconds) to wait for a connection socket to accept content again after a write error. */
+#define WRITE_RETRY_TIMEOUT 150
+
+/* Size of the file data chunks sent on each "send file chunk" package. */
+#define DATA_CHUNK_SIZE 1024*64
+
+/* Time (in milliseconds) to wait for a file chunk confirmation before sending it again. */
+#define FILE_CHUNK_CONFIRMATION_TIMEOUT 5000
+
+/* Maximum times a file chunk can be sent again due to confirmation timeout. */
+#define MAXIMUM_FILE_CHUNK_RETRANSMISSIONS 3
+
+/* Size of a confirmation package. */
+#define CONFIRMATION_PACKAGE_SIZE (PACKAGE_PREAMBLE_SIZE + sizeof(uint32_t) + PACKAGE_TRAILER_SIZE)
+
+/* Maximum size of the data sent on each stream chunk. */
+#define STREAM_CHUNK_SIZE 4096
+
+/* Maximum time (in milliseconds) the stream content is held before being sent on an incomplete stream chunk. */
+#define STREAM_CHUNK_MAXIMUM_DELAY 250
+
+/* Time (in milliseconds) to wait for a package while there is no stream content to send. */
+#define STREAM_POLL_TIMEOUT 20
+
+/* Time (in milliseconds) to wait for a stream chunk confirmation before considering it lost. */
+#define STREAM_CHUNK_CONFIRMATION_TIMEOUT 2000
+
+/* Number of file digests kept, so the same file content is not read again each time it is sent. */
+#define FILE_DIGEST_CACHE_SIZE 32
+
+
+/*
+ * Structures.
+ */
+
+/* A file chunk sent which is waiting for its confirmation. */
+typedef struct {
+    uint8_t preamble[SEND_FILE_CHUNK_PACKAGE_PREAMBLE_SIZE];
+    uint32_t package_id;
+    off_t offset;
+    size_t size;
+    uint64_t deadline;
+    int retransmissions;
+    bool confirmed;
+} file_chunk_t;
+
+/* The file chunks sent which are still waiting for their confirmations. */
+typedef struct {
+    file_chunk_t chunks[MAXIMUM_TRANSMISSION_WINDOW_SIZE];
+    size_t first;
+    size_t count;
+} transmission_window_t;
+
+/* A stream chunk sent which is waiting for its confirmation. */
+typedef struct {
+    uint32_t package_id;
+    size_t size;
+    uint64_t deadline;
+    bool confirmed;
+} stream_chunk_t;
+
+/* The stream chunks sent which are still waiting for their confirmations. */
+typedef struct {
+    stream_chunk_t chunks[MAXIMUM_TRANSMISSION_WINDOW_SIZE];
+    size_t first;
+    size_t count;
+} stream_window_t;
+
+/* The digest of a file content, identified by the file path, size and modification time. */
+typedef struct {
+    char file_path[TRANSFER_FILE_PATH_SIZE];
+    size_t file_size;
+    struct timespec modification_time;
+    uint64_t file_digest;
+} file_digest_cache_entry_t;
+
+
+/*
+ * Variables.
+ */
+
+/* Number of packages which can be sent without waiting for their confirmations. */
+uint32_t _transmission_window_size = DEFAULT_TRANSMISSION_WINDOW_SIZE;
+
+/* Buffer used to encode the packages sent. */
+uint8_t _package_buffer[PACKAGE_MAXIMUM_SIZE];
+
+/* Buffer used to gather the stream content sent on each stream chunk. */
+uint8_t _stream_buffer[STREAM_CHUNK_SIZE];
+
+/* Statistics of the latest stream sent. */
+stream_statistics_t _stream_statistics;
+
+/* Digests of the latest files sent. */
+file_digest_cache_entry_t file_digest_cache[FILE_DIGEST_CACHE_SIZE];
+
+/* Position of the file digest cache where the next digest will be stored. */
+size_t file_digest_cache_position = 0;
 
 
 /*
  * Function headers.
  */
 
+/* Checks if a file can be sent and returns its size. */
+int check_file_to_send(char*, size_t*);
+
+/* Returns the digest of the first bytes of a file, reading it only if the digest is not cached. */
+int get_transfer_file_digest(char*, size_t, uint64_t*);
+
 /* Receives a confirmation package. */
 int receive_confirmation(int, package_t);
 
+/* Receives the confirmations of the file chunks sent. */
+int receive_file_chunk_confirmations(int, transmission_window_t*);
+
+/* Receives the packages sent by the remote device while a stream is being sent. */
+int receive_stream_packages(int, stream_window_t*, package_t*);
+
+/* Sends again the file chunks which were not confirmed yet. */
+int resend_file_chunks(int, int, transmission_window_t*);
+
 /* Sends a confirmation package. */
 int send_confirmation(int, package_t);
 
 /* Sends a chunk of data read from a file. */
-int send_file_chunk(int, size_t, uint8_t*);
+int send_file_chunk(int, int, file_chunk_t*);
 
 /* Sends a file content. */
-int send_file_content(int, char*, size_t);
+int send_file_content(int, char*, size_t, size_t);
 
 /* Sends a file header. */
-int send_file_header(int, size_t, const char*);
+int send_file_header(int, size_t, const char*, size_t, uint32_t, uint64_t);
 
 /* Sends a file trailer. */
 int send_file_trailer(int);
 
+/* Sends a chunk of stream content. */
+int send_stream_chunk(int, uint8_t*, size_t, stream_window_t*);
+
+/* Sends a file transfer, from the offset informed until the end of the transfer. */
+int send_transfer(int, transfer_t*, size_t);
+
+/* Starts a file transfer, registering it on the journal if it is interrupted. */
+int start_transfer(int, transfer_t*, size_t);
+
 
 /*
  * Function elaborations.
@@ -117,6 +246,136 @@ int check_connection(int socket_fd) {
     return result;
 }
 
+/*
+ * Checks if a file can be sent and returns its size.
+ *
+ * Parameters
+ *  file_path - Path to the file to be sent.
+ *  file_size - The variable where the file size will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the file can be sent.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int check_file_to_send(char* file_path, size_t* file_size) {
+    LOG_TRACE("File path: \"%s\".", file_path);
+
+    if ( file_exists(file_path) == false ) {
+        LOG_ERROR("File \"%s\" does not exist.", file_path);
+        return GENERIC_ERROR;
+    }
+
+    if ( file_is_readable(file_path) == false ) {
+        LOG_ERROR("File \"%s\" is not readable.", file_path);
+        return GENERIC_ERROR;
+    }
+
+    if ( strlen(file_path) >= TRANSFER_FILE_PATH_SIZE ) {
+        LOG_ERROR("File path \"%s\" is too long.", file_path);
+        return GENERIC_ERROR;
+    }
+
+    *file_size = get_file_size(file_path);
+    LOG_TRACE_POINT;
+
+    if ( *file_size == -1 ) {
+        LOG_ERROR("Could not determine the \"%s\" file size.", file_path);
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the digest of the first bytes of a file, reading it only if the digest is not cached.
+ *
+ * Parameters
+ *  file_path - Path to the file.
+ *  file_size - Number of bytes of the file which digest must be calculated.
+ *  file_digest - The variable where the digest will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the digest was returned successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  A digest cached is only used while the file keeps the same modification time, so a file changed is read again.
+ */
+int get_transfer_file_digest(char* file_path, size_t file_size, uint64_t* file_digest) {
+    LOG_TRACE("File path: \"%s\", file size: %zu.", file_path, file_size);
+
+    struct stat file_stat;
+    file_digest_cache_entry_t* cache_entry;
+    size_t counter;
+
+    if ( stat(file_path, &file_stat) != 0 ) {
+        LOG_ERROR("Could not retrieve the status of file \"%s\".", file_path);
+        return GENERIC_ERROR;
+    }
+
+    for ( counter = 0; counter < FILE_DIGEST_CACHE_SIZE; counter++ ) {
+        cache_entry = &file_digest_cache[counter];
+        if ( cache_entry->file_size == file_size &&
+             cache_entry->modification_time.tv_sec == file_stat.st_mtim.tv_sec &&
+             cache_entry->modification_time.tv_nsec == file_stat.st_mtim.tv_nsec &&
+             strcmp(cache_entry->file_path, file_path) == 0 ) {
+            LOG_TRACE("File digest cached: 0x%016" PRIx64 ".", cache_entry->file_digest);
+            *file_digest = cache_entry->file_digest;
+            return SUCCESS;
+        }
+    }
+
+    if ( get_file_digest(file_path, file_size, file_digest) != SUCCESS ) {
+        LOG_ERROR("Could not calculate the digest of file \"%s\".", file_path);
+        return GENERIC_ERROR;
+    }
+
+    cache_entry = &file_digest_cache[file_digest_cache_position];
+    file_digest_cache_position = ( file_digest_cache_position + 1 ) % FILE_DIGEST_CACHE_SIZE;
+
+    strcpy(cache_entry->file_path, file_path);
+    cache_entry->file_size = file_size;
+    cache_entry->modification_time = file_stat.st_mtim;
+    cache_entry->file_digest = *file_digest;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the statistics of the latest stream sent.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The number of bytes of the latest stream sent on stream chunks, the ones sent on stream chunks not confirmed before their deadlines, and the ones read from the stream content provider but discarded without being sent.
+ *
+ * Observations
+ *  The bytes not confirmed are also counted as sent, since the remote device may have received them.
+ */
+stream_statistics_t get_stream_statistics() {
+    LOG_TRACE_POINT;
+
+    return _stream_statistics;
+}
+
+/*
+ * Returns the number of packages which can be sent without waiting for their confirmations.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The number of packages which can be sent without waiting for their confirmations.
+ */
+uint32_t get_transmission_window_size() {
+    LOG_TRACE_POINT;
+
+    return _transmission_window_size;
+}
+
 /*
  * Receives a confirmation package.
  *
@@ -134,53 +393,42 @@ int receive_confirmation(int socket_fd, package_t package) {
 
     bool read_concluded = false;
     byte_array_t byte_array_readed;
-    retry_informations_t retry_informations;
-    package_t package_received;
+    uint64_t deadline;
+    package_view_t package_received;
     int wait_result;
-    int convertion_result;
+    int decode_result;
     int result;
-    int read_socket_content_result;
+    int read_socket_package_result;
 
-    retry_informations = create_retry_informations(MAXIMUM_READ_ATTEMPTS);
+    deadline = get_event_loop_time() + RECEIVE_CONFIRMATION_TIMEOUT;
     LOG_TRACE_POINT;
 
-    memset(&package_received, 0, sizeof(package_t));
-
-    byte_array_readed.size = 0;
-    byte_array_readed.data = NULL;
-
     while ( read_concluded == false ) {
         LOG_TRACE_POINT;
 
-        delete_byte_array(&byte_array_readed);
-        LOG_TRACE_POINT;
-
-        read_socket_content_result = read_socket_content(socket_fd, &byte_array_readed);
+        read_socket_package_result = read_socket_package(socket_fd, &byte_array_readed);
         LOG_TRACE_POINT;
 
-        switch (read_socket_content_result) {
+        switch (read_socket_package_result) {
 
             case SUCCESS:
                 LOG_TRACE_POINT;
 
-                delete_package(package_received);
+                decode_result = decode_package(&package_received, byte_array_readed);
                 LOG_TRACE_POINT;
 
-                convertion_result = convert_byte_array_to_package(&package_received, byte_array_readed);
-                LOG_TRACE_POINT;
-
-                if ( convertion_result == GENERIC_ERROR ) {
+                if ( decode_result == GENERIC_ERROR ) {
                     LOG_TRACE_POINT;
-                    LOG_ERROR("Error while converting byte array to package.");
+                    LOG_ERROR("Error while decoding byte array to package.");
                     result = GENERIC_ERROR;
                     read_concluded = true;
                 }
                 else {
                     LOG_TRACE_POINT;
 
-                    if ( package_received.type_code == CONFIRMATION_CODE ) {
+                    if ( package_received.package.type_code == CONFIRMATION_CODE ) {
                         LOG_TRACE_POINT;
-                        if ( package_received.content.confirmation_content->package_id == package.id ) {
+                        if ( package_received.package.content.confirmation_content->package_id == package.id ) {
                             LOG_TRACE_POINT;
                             read_concluded = true;
                             result = SUCCESS;
@@ -194,27 +442,27 @@ int receive_confirmation(int socket_fd, package_t package) {
 
             case NO_CONTENT_TO_READ:
                 LOG_TRACE_POINT;
-                wait_result = wait_time(&retry_informations);
+                wait_result = wait_socket_event(socket_fd, SOCKET_EVENT_READ, deadline);
 
                 switch (wait_result) {
-                    case SUCCESS:
-                        LOG_TRACE_POINT
-                            break;
+                    case SOCKET_EVENT_OCCURRED:
+                        LOG_TRACE_POINT;
+                        break;
 
-                    case GENERIC_ERROR:
-                        LOG_ERROR("Error while waiting to read the package confirmation from connection.");
+                    case DEADLINE_REACHED:
+                        LOG_ERROR("Package confirmation was not received before its deadline.");
                         read_concluded = true;
                         result = GENERIC_ERROR;
                         break;
 
-                    case MAXIMUM_RETRY_ATTEMPTS_REACHED:
-                        LOG_ERROR("Maximum read attempts reached.");
+                    case GENERIC_ERROR:
+                        LOG_ERROR("Error while waiting to read the package confirmation from connection.");
                         read_concluded = true;
                         result = GENERIC_ERROR;
                         break;
 
                     default:
-                        LOG_ERROR("Unknown return code from \"wait_time\" function.");
+                        LOG_ERROR("Unknown return code from \"wait_socket_event\" function.");
                         read_concluded = true;
                         result = GENERIC_ERROR;
                         break;
@@ -235,19 +483,142 @@ int receive_confirmation(int socket_fd, package_t package) {
                 break;
 
             default:
-                LOG_ERROR("Unknown result received from \"read_socket_content\" function: %d.", read_socket_content_result);
+                LOG_ERROR("Unknown result received from \"read_socket_package\" function: %d.", read_socket_package_result);
                 read_concluded = true;
                 result = GENERIC_ERROR;
                 break;
         }
     }
 
-    delete_byte_array(&byte_array_readed);
     LOG_TRACE_POINT;
+    return result;
+}
 
-    delete_package(package_received);
-    LOG_TRACE_POINT;
+/*
+ * Receives the confirmations of the file chunks sent.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to receive the confirmations.
+ *  transmission_window - The file chunks waiting for confirmation.
+ *
+ * Returns
+ *  SUCCESS - If at least one confirmation was received or the oldest file chunk not confirmed reached its deadline.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Confirmations can be received in any order. The confirmed file chunks at the start of the window are removed from it.
+ */
+int receive_file_chunk_confirmations(int socket_fd, transmission_window_t* transmission_window) {
+    LOG_TRACE("File chunks waiting for confirmation: %zu.", transmission_window->count);
+
+    int result = SUCCESS;
+    bool receive_concluded = false;
+    int confirmations_received = 0;
+    int read_socket_package_result;
+    int wait_socket_event_result;
+    uint64_t deadline = 0;
+    size_t counter;
+    file_chunk_t* file_chunk;
+    byte_array_t byte_array_readed;
+    package_view_t package_received;
+
+    while ( receive_concluded == false ) {
+        LOG_TRACE_POINT;
+
+        read_socket_package_result = read_socket_package(socket_fd, &byte_array_readed);
+        LOG_TRACE_POINT;
+
+        switch (read_socket_package_result) {
+
+            case SUCCESS:
+                LOG_TRACE_POINT;
+
+                if ( decode_package(&package_received, byte_array_readed) != SUCCESS ) {
+                    LOG_ERROR("Error while decoding byte array to package.");
+                    result = GENERIC_ERROR;
+                    receive_concluded = true;
+                    break;
+                }
+
+                if ( package_received.package.type_code == CONFIRMATION_CODE ) {
+                    LOG_TRACE_POINT;
+
+                    for ( counter = 0; counter < transmission_window->count; counter++ ) {
+                        file_chunk = &transmission_window->chunks[(transmission_window->first + counter) % MAXIMUM_TRANSMISSION_WINDOW_SIZE];
+                        if ( file_chunk->package_id == package_received.package.content.confirmation_content->package_id ) {
+                            LOG_TRACE("File chunk package 0x%x confirmed.", file_chunk->package_id);
+                            file_chunk->confirmed = true;
+                            confirmations_received++;
+                            break;
+                        }
+                    }
+                }
+                else {
+                    LOG_TRACE("The package received is being ignored. It is not a confirmation code.");
+                }
+                break;
+
+            case NO_CONTENT_TO_READ:
+                LOG_TRACE_POINT;
+
+                if ( confirmations_received > 0 ) {
+                    LOG_TRACE_POINT;
+                    receive_concluded = true;
+                    break;
+                }
+
+                for ( counter = 0; counter < transmission_window->count; counter++ ) {
+                    file_chunk = &transmission_window->chunks[(transmission_window->first + counter) % MAXIMUM_TRANSMISSION_WINDOW_SIZE];
+                    if ( file_chunk->confirmed == false ) {
+                        deadline = file_chunk->deadline;
+                        break;
+                    }
+                }
+
+                wait_socket_event_result = wait_socket_event(socket_fd, SOCKET_EVENT_READ, deadline);
+                LOG_TRACE_POINT;
+
+                switch (wait_socket_event_result) {
+                    case SOCKET_EVENT_OCCURRED:
+                        LOG_TRACE_POINT;
+                        break;
+
+                    case DEADLINE_REACHED:
+                        LOG_TRACE("File chunk confirmation deadline reached.");
+                        receive_concluded = true;
+                        break;
+
+                    default:
+                        LOG_ERROR("Error while waiting for file chunk confirmations.");
+                        result = GENERIC_ERROR;
+                        receive_concluded = true;
+                        break;
+                }
+                break;
+
+            case DEVICE_DISCONNECTED:
+                LOG_TRACE_POINT;
+
+                result = DEVICE_DISCONNECTED;
+                receive_concluded = true;
+                break;
+
+            default:
+                LOG_ERROR("Error while reading file chunk confirmations.");
+
+                result = GENERIC_ERROR;
+                receive_concluded = true;
+                break;
+        }
+    }
+
+    while ( transmission_window->count > 0 && transmission_window->chunks[transmission_window->first].confirmed == true ) {
+        transmission_window->first = (transmission_window->first + 1) % MAXIMUM_TRANSMISSION_WINDOW_SIZE;
+        transmission_window->count--;
+    }
 
+    LOG_TRACE("File chunks still waiting for confirmation: %zu.", transmission_window->count);
     return result;
 }
 
@@ -269,13 +640,13 @@ int receive_package(int socket_fd, package_t* package) {
 
     int result = SUCCESS;
     byte_array_t received_byte_array;
-    retry_informations_t retry_informations;
+    uint64_t deadline;
     bool receive_concluded;
     int wait_result;
     int convertion_result;
     int read_socket_content_result;
 
-    retry_informations = create_retry_informations(MAXIMUM_READ_ATTEMPTS);
+    deadline = get_event_loop_time() + RECEIVE_PACKAGE_TIMEOUT;
     LOG_TRACE_POINT;
 
     received_byte_array.size = 0;
@@ -309,16 +680,16 @@ int receive_package(int socket_fd, package_t* package) {
             case NO_CONTENT_TO_READ:
                 LOG_TRACE_POINT;
 
-                wait_result = wait_time(&retry_informations);
+                wait_result = wait_socket_event(socket_fd, SOCKET_EVENT_READ, deadline);
                 LOG_TRACE_POINT;
 
                 switch (wait_result) {
-                    case SUCCESS:
+                    case SOCKET_EVENT_OCCURRED:
                         LOG_TRACE_POINT;
                         break;
 
-                    case MAXIMUM_RETRY_ATTEMPTS_REACHED:
-                        LOG_TRACE("Maximum receive attempts reached.");
+                    case DEADLINE_REACHED:
+                        LOG_TRACE("No package received before deadline.");
                         receive_concluded = true;
                         result = NO_PACKAGE_RECEIVED;
                         break;
@@ -359,70 +730,347 @@ int receive_package(int socket_fd, package_t* package) {
 }
 
 /*
- * Sends a confirmation package.
+ * Receives the packages sent by the remote device while a stream is being sent.
  *
  * Parameters
- *  socket_fd - The connection socket file descriptor to send the package.
- *  package - The package to be confirmed.
+ *  socket_fd - The connection socket file descriptor to receive the packages.
+ *  stream_window - The stream chunks waiting for confirmation.
+ *  package - The variable to store a command package received.
  *
  * Returns
- *  SUCCESS - If the confirmation package was send successfully.
+ *  SUCCESS - If all packages available were received and none of them requests the stream to stop.
+ *  STREAM_STOPPED - If the remote device requested the stream to stop.
+ *  STREAM_INTERRUPTED - If the remote device sent another command. The command package is stored on "package".
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
  *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  This function does not wait for packages. The confirmed stream chunks at the start of the window are removed from it, as well as the ones which reached their deadline. A stream chunk not confirmed is never sent again, since the audio it contains would arrive too late to be played.
  */
-int send_confirmation(int socket_fd, package_t package_to_confirm) {
-    LOG_TRACE_POINT;
-
-    int result;
-    package_t confirmation_package;
-    byte_array_t confirmation_package_byte_array;
-    bool send_concluded = false;
-    int write_result;
-    int wait_result;
-    int convertion_result;
-    retry_informations_t retry_informations;
-
-    confirmation_package = create_confirmation_package(package_to_confirm.id);
+int receive_stream_packages(int socket_fd, stream_window_t* stream_window, package_t* package) {
     LOG_TRACE_POINT;
 
-    convertion_result = convert_package_to_byte_array(&confirmation_package_byte_array, confirmation_package);
-    LOG_TRACE_POINT;
+    int result = SUCCESS;
+    bool receive_concluded = false;
+    int read_socket_package_result;
+    size_t counter;
+    uint64_t current_time;
+    stream_chunk_t* stream_chunk;
+    byte_array_t byte_array_readed;
+    package_view_t package_received;
 
-    if ( convertion_result == GENERIC_ERROR ) {
-        LOG_ERROR("Error converting confirmation package to byte array.");
-        result = GENERIC_ERROR;
-    }
-    else {
+    while ( receive_concluded == false ) {
         LOG_TRACE_POINT;
 
-        retry_informations = create_retry_informations(MAXIMUM_WRITE_ATTEMPTS);
+        read_socket_package_result = read_socket_package(socket_fd, &byte_array_readed);
         LOG_TRACE_POINT;
 
-        while ( send_concluded == false ) {
-            LOG_TRACE_POINT;
+        switch (read_socket_package_result) {
 
-            write_result = write_content_on_socket(socket_fd, confirmation_package_byte_array); 
-            LOG_TRACE_POINT;
+            case SUCCESS:
+                LOG_TRACE_POINT;
 
-            if ( write_result == GENERIC_ERROR ) {
-                LOG_ERROR("Error while writing confirmaton package on socket.");
+                if ( decode_package(&package_received, byte_array_readed) != SUCCESS ) {
+                    LOG_ERROR("Error while decoding byte array to package.");
+                    result = GENERIC_ERROR;
+                    receive_concluded = true;
+                    break;
+                }
 
-                wait_result = wait_time(&retry_informations);
-                LOG_TRACE_POINT;
+                switch (package_received.package.type_code) {
 
-                switch (wait_result) {
-                    case SUCCESS:
+                    case CONFIRMATION_CODE:
                         LOG_TRACE_POINT;
+
+                        for ( counter = 0; counter < stream_window->count; counter++ ) {
+                            stream_chunk = &stream_window->chunks[(stream_window->first + counter) % MAXIMUM_TRANSMISSION_WINDOW_SIZE];
+                            if ( stream_chunk->package_id == package_received.package.content.confirmation_content->package_id ) {
+                                stream_chunk->confirmed = true;
+                                break;
+                            }
+                        }
                         break;
 
-                    case MAXIMUM_RETRY_ATTEMPTS_REACHED:
-                        LOG_ERROR("Maximum read attempts reached.");
-                        send_concluded = true;
-                        result = GENERIC_ERROR;
+                    case CHECK_CONNECTION_CODE:
+                        LOG_TRACE("Connection checked by device during stream.");
+
+                        send_confirmation(socket_fd, package_received.package);
                         break;
 
-                    default:
-                        LOG_ERROR("Error while waiting to read the package confirmation from connection.");
-                        send_concluded = true;
+                    case STOP_STREAM_CODE:
+                        LOG_TRACE("Remote device requested the stream to stop.");
+
+                        send_confirmation(socket_fd, package_received.package);
+                        result = STREAM_STOPPED;
+                        receive_concluded = true;
+                        break;
+
+                    default:
+                        LOG_TRACE("Stream interrupted by a package of type 0x%x.", package_received.package.type_code);
+
+                        if ( convert_byte_array_to_package(package, byte_array_readed) != SUCCESS ) {
+                            LOG_ERROR("Error while converting received byte array to package.");
+                            result = GENERIC_ERROR;
+                        }
+                        else {
+                            send_confirmation(socket_fd, *package);
+                            result = STREAM_INTERRUPTED;
+                        }
+                        receive_concluded = true;
+                        break;
+                }
+                break;
+
+            case NO_CONTENT_TO_READ:
+                LOG_TRACE_POINT;
+                receive_concluded = true;
+                break;
+
+            case DEVICE_DISCONNECTED:
+                LOG_TRACE_POINT;
+
+                result = DEVICE_DISCONNECTED;
+                receive_concluded = true;
+                break;
+
+            default:
+                LOG_ERROR("Error while reading packages during stream.");
+
+                result = GENERIC_ERROR;
+                receive_concluded = true;
+                break;
+        }
+    }
+
+    current_time = get_event_loop_time();
+    while ( stream_window->count > 0 ) {
+        stream_chunk = &stream_window->chunks[stream_window->first];
+        if ( stream_chunk->confirmed == false && stream_chunk->deadline > current_time ) {
+            break;
+        }
+
+        if ( stream_chunk->confirmed == false ) {
+            LOG_WARNING("Stream chunk package 0x%x was not confirmed before its deadline.", stream_chunk->package_id);
+            _stream_statistics.bytes_unconfirmed += stream_chunk->size;
+        }
+        stream_window->first = (stream_window->first + 1) % MAXIMUM_TRANSMISSION_WINDOW_SIZE;
+        stream_window->count--;
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Sends again the file chunks which were not confirmed yet.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the file chunks.
+ *  file_fd - The descriptor of the file which the chunks were read.
+ *  transmission_window - The file chunks waiting for confirmation.
+ *
+ * Returns
+ *  SUCCESS - If the oldest file chunk did not reach its deadline or if the file chunks were sent again successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  When the oldest file chunk reaches its deadline, all file chunks not confirmed are sent again in their original order and with their original package ids, so the remote device can discard the ones it has already received.
+ */
+int resend_file_chunks(int socket_fd, int file_fd, transmission_window_t* transmission_window) {
+    LOG_TRACE_POINT;
+
+    int send_file_chunk_result;
+    size_t counter;
+    file_chunk_t* file_chunk;
+
+    if ( transmission_window->count == 0 ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    file_chunk = &transmission_window->chunks[transmission_window->first];
+    if ( get_event_loop_time() < file_chunk->deadline ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    if ( file_chunk->retransmissions >= MAXIMUM_FILE_CHUNK_RETRANSMISSIONS ) {
+        LOG_ERROR("Did not receive confirmation for package id 0x%x.", file_chunk->package_id);
+        return GENERIC_ERROR;
+    }
+
+    LOG_WARNING("Confirmation of package id 0x%x not received. Sending %zu file chunk(s) again.", file_chunk->package_id, transmission_window->count);
+
+    for ( counter = 0; counter < transmission_window->count; counter++ ) {
+        file_chunk = &transmission_window->chunks[(transmission_window->first + counter) % MAXIMUM_TRANSMISSION_WINDOW_SIZE];
+
+        if ( file_chunk->confirmed == true ) {
+            LOG_TRACE_POINT;
+            continue;
+        }
+
+        file_chunk->retransmissions++;
+
+        send_file_chunk_result = send_file_chunk(socket_fd, file_fd, file_chunk);
+        LOG_TRACE_POINT;
+
+        if ( send_file_chunk_result != SUCCESS ) {
+            LOG_TRACE_POINT;
+            return send_file_chunk_result;
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Resumes a file transfer interrupted.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the file.
+ *  transfer_id - Identifier of the transfer to be resumed.
+ *  file_offset - Number of bytes of the file the remote device already has.
+ *
+ * Returns
+ *  SUCCESS - If the transfer was resumed and concluded successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  TRANSFER_NOT_FOUND - If the transfer is not registered on the journal.
+ *  TRANSFER_CHANGED - If the file transferred does not have the same content anymore.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Only the file content registered when the transfer started is sent, even if the file has grown since then.
+ */
+int resume_transfer(int socket_fd, uint32_t transfer_id, size_t file_offset) {
+    LOG_TRACE("Transfer ID: 0x%08x, file offset: %zu.", transfer_id, file_offset);
+
+    transfer_t transfer;
+    uint64_t file_digest;
+    int find_result;
+
+    find_result = find_transfer(transfer_id, &transfer);
+    LOG_TRACE_POINT;
+
+    switch ( find_result ) {
+
+        case SUCCESS:
+            LOG_TRACE_POINT;
+            break;
+
+        case TRANSFER_NOT_FOUND:
+            LOG_WARNING("Transfer 0x%08x is not registered.", transfer_id);
+            return TRANSFER_NOT_FOUND;
+
+        default:
+            LOG_ERROR("Error while searching transfer 0x%08x.", transfer_id);
+            return GENERIC_ERROR;
+    }
+
+    if ( file_exists(transfer.file_path) == false || get_file_size(transfer.file_path) < transfer.file_size ) {
+        LOG_WARNING("The file of transfer 0x%08x does not exist or is smaller than when transferred.", transfer_id);
+        return TRANSFER_CHANGED;
+    }
+
+    if ( get_transfer_file_digest(transfer.file_path, transfer.file_size, &file_digest) != SUCCESS ) {
+        LOG_ERROR("Could not calculate the digest of the file of transfer 0x%08x.", transfer_id);
+        return GENERIC_ERROR;
+    }
+
+    if ( file_digest != transfer.file_digest ) {
+        LOG_WARNING("The file of transfer 0x%08x has changed since it was transferred.", transfer_id);
+        return TRANSFER_CHANGED;
+    }
+
+    if ( file_offset > transfer.file_size ) {
+        LOG_WARNING("The offset informed is beyond the end of transfer 0x%08x. Sending the whole file.", transfer_id);
+        file_offset = 0;
+    }
+
+    LOG_TRACE_POINT;
+    return send_transfer(socket_fd, &transfer, file_offset);
+}
+
+/*
+ * Sends a confirmation package.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the package.
+ *  package - The package to be confirmed.
+ *
+ * Returns
+ *  SUCCESS - If the confirmation package was send successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The confirmation package is built and encoded on the stack, so no memory is allocated to send it.
+ */
+int send_confirmation(int socket_fd, package_t package_to_confirm) {
+    LOG_TRACE_POINT;
+
+    int result;
+    package_t confirmation_package;
+    confirmation_content_t confirmation_content;
+    uint8_t confirmation_package_buffer[CONFIRMATION_PACKAGE_SIZE];
+    byte_array_t confirmation_package_byte_array;
+    bool send_concluded = false;
+    int write_result;
+    int wait_result;
+    int encode_result;
+    int write_attempts = 0;
+
+    confirmation_content.package_id = package_to_confirm.id;
+    confirmation_package = create_package(CONFIRMATION_CODE);
+    confirmation_package.content.confirmation_content = &confirmation_content;
+    LOG_TRACE_POINT;
+
+    confirmation_package_byte_array.data = confirmation_package_buffer;
+    encode_result = encode_package(confirmation_package_buffer, sizeof(confirmation_package_buffer), confirmation_package, &confirmation_package_byte_array.size);
+    LOG_TRACE_POINT;
+
+    if ( encode_result == GENERIC_ERROR ) {
+        LOG_ERROR("Error encoding confirmation package.");
+        result = GENERIC_ERROR;
+    }
+    else {
+        LOG_TRACE_POINT;
+
+        while ( send_concluded == false ) {
+            LOG_TRACE_POINT;
+
+            write_result = write_content_on_socket(socket_fd, confirmation_package_byte_array); 
+            LOG_TRACE_POINT;
+
+            if ( write_result == DEVICE_DISCONNECTED ) {
+                LOG_TRACE_POINT;
+                send_concluded = true;
+                result = DEVICE_DISCONNECTED;
+            }
+            else if ( write_result == GENERIC_ERROR ) {
+                LOG_ERROR("Error while writing confirmaton package on socket.");
+
+                write_attempts++;
+                if ( write_attempts >= MAXIMUM_WRITE_ATTEMPTS ) {
+                    LOG_ERROR("Maximum write attempts reached.");
+                    send_concluded = true;
+                    result = GENERIC_ERROR;
+                    break;
+                }
+
+                wait_result = wait_socket_event(socket_fd, SOCKET_EVENT_WRITE, get_event_loop_time() + WRITE_RETRY_TIMEOUT);
+                LOG_TRACE_POINT;
+
+                switch (wait_result) {
+                    case SOCKET_EVENT_OCCURRED:
+                    case DEADLINE_REACHED:
+                        LOG_TRACE_POINT;
+                        break;
+
+                    default:
+                        LOG_ERROR("Error while waiting to read the package confirmation from connection.");
+                        send_concluded = true;
                         result = GENERIC_ERROR;
                         break;
                 }
@@ -436,12 +1084,7 @@ int send_confirmation(int socket_fd, package_t package_to_confirm) {
         }
     }
 
-    delete_package(confirmation_package);
-    LOG_TRACE_POINT;
-
-    delete_byte_array(&confirmation_package_byte_array);
     LOG_TRACE_POINT;
-
     return result;
 }
 
@@ -502,119 +1145,392 @@ int send_disconnect_signal(int socket_fd) {
 int send_file(int socket_fd, char* file_path) {
     LOG_TRACE("File path: \"%s\".", file_path);
 
-    char* file_name;
+    return send_file_tail(socket_fd, file_path, 0, DIGEST_INITIAL_VALUE);
+}
+
+/*
+ * Sends the bytes of a file after the ones a remote device already has.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the file.
+ *  file_path - Path to the file to be sent.
+ *  file_offset - Number of bytes of the file the remote device already has.
+ *  prefix_digest - Digest of the bytes the remote device already has.
+ *
+ * Returns
+ *  SUCCESS - If the file was sent successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  If the file is smaller than the offset informed or its first bytes do not match the digest informed, the whole file is sent. The file header informs the offset of the first byte sent, so the remote device knows if it must discard the bytes it has.
+ */
+int send_file_tail(int socket_fd, char* file_path, size_t file_offset, uint64_t prefix_digest) {
+    LOG_TRACE("File path: \"%s\", file offset: %zu.", file_path, file_offset);
+
+    uint64_t file_digest;
     size_t file_size;
-    int send_result;
+    transfer_t transfer;
 
-    if ( file_exists(file_path) == false ) {
-        LOG_ERROR("File \"%s\" does not exist.", file_path);
+    if ( check_file_to_send(file_path, &file_size) != SUCCESS ) {
+        LOG_ERROR("File \"%s\" cannot be sent.", file_path);
         return GENERIC_ERROR;
     }
 
-    if ( file_is_readable(file_path) == false ) {
-        LOG_ERROR("File \"%s\" is not readable.", file_path);
+    if ( file_offset > file_size ) {
+        LOG_WARNING("File \"%s\" is smaller than the offset informed. Sending the whole file.", file_path);
+        file_offset = 0;
+    }
+
+    if ( file_offset > 0 ) {
+        if ( get_file_digest(file_path, file_offset, &file_digest) != SUCCESS ) {
+            LOG_ERROR("Could not calculate the digest of file \"%s\".", file_path);
+            return GENERIC_ERROR;
+        }
+
+        if ( file_digest != prefix_digest ) {
+            LOG_WARNING("The first bytes of file \"%s\" do not match the digest informed. Sending the whole file.", file_path);
+            file_offset = 0;
+        }
+    }
+
+    if ( get_transfer_file_digest(file_path, file_size, &file_digest) != SUCCESS ) {
+        LOG_ERROR("Could not calculate the digest of file \"%s\".", file_path);
         return GENERIC_ERROR;
     }
 
-    file_size = get_file_size(file_path);
+    strcpy(transfer.file_path, file_path);
+    transfer.file_size = file_size;
+    transfer.file_digest = file_digest;
+
     LOG_TRACE_POINT;
+    return start_transfer(socket_fd, &transfer, file_offset);
+}
 
-    if ( file_size == -1 ) {
-        LOG_ERROR("Could not determine the \"%s\" file size.", file_path);
+/*
+ * Sends a file which digest is already known through a connection.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the file.
+ *  file_path - Path to the file to be sent.
+ *  file_size - Size of the file when its digest was calculated.
+ *  file_digest - Digest of the file content.
+ *
+ * Returns
+ *  SUCCESS - If the file was sent successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The file is not read to calculate its digest, so the transfer starts without waiting. If the file size has changed since the digest was calculated, the digest is calculated again.
+ */
+int send_file_with_digest(int socket_fd, char* file_path, size_t file_size, uint64_t file_digest) {
+    LOG_TRACE("File path: \"%s\", file size: %zu, file digest: 0x%016" PRIx64 ".", file_path, file_size, file_digest);
+
+    size_t current_file_size;
+    transfer_t transfer;
+
+    if ( check_file_to_send(file_path, &current_file_size) != SUCCESS ) {
+        LOG_ERROR("File \"%s\" cannot be sent.", file_path);
         return GENERIC_ERROR;
     }
 
-    file_name = basename(file_path);
-    LOG_TRACE("File name: \"%s\".", file_name);
+    if ( current_file_size != file_size ) {
+        LOG_WARNING("File \"%s\" has changed since its digest was calculated.", file_path);
+        return send_file(socket_fd, file_path);
+    }
+
+    strcpy(transfer.file_path, file_path);
+    transfer.file_size = file_size;
+    transfer.file_digest = file_digest;
 
-    send_result = send_file_header(socket_fd, file_size, file_name);
     LOG_TRACE_POINT;
+    return start_transfer(socket_fd, &transfer, 0);
+}
 
-    switch ( send_result ) {
+/*
+ * Sends a chunk of data read from a file.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the file chunk.
+ *  file_fd - The descriptor of the file to send the chunk.
+ *  file_chunk - The file chunk to be sent.
+ *
+ * Returns
+ *  SUCCESS - If the file chunk was sent successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The package fields are written from the file chunk preamble and the chunk data is moved from the file to the socket by the kernel, so the data is never copied to user space.
+ *  This function does not wait for the file chunk confirmation. Its deadline is defined to be checked later.
+ */
+int send_file_chunk(int socket_fd, int file_fd, file_chunk_t* file_chunk){
+    LOG_TRACE("Package id: 0x%x, offset: %jd, chunk size: %zu.", file_chunk->package_id, (intmax_t)file_chunk->offset, file_chunk->size);
+
+    int write_result;
+    uint32_t package_trailer = PACKAGE_TRAILER;
+    byte_array_t preamble_byte_array;
+    byte_array_t trailer_byte_array;
+
+    preamble_byte_array.size = SEND_FILE_CHUNK_PACKAGE_PREAMBLE_SIZE;
+    preamble_byte_array.data = file_chunk->preamble;
+    trailer_byte_array.size = PACKAGE_TRAILER_SIZE;
+    trailer_byte_array.data = (uint8_t*)&package_trailer;
+
+    write_result = write_content_on_socket(socket_fd, preamble_byte_array);
+    LOG_TRACE_POINT;
+
+    if ( write_result == SUCCESS ) {
+        LOG_TRACE_POINT;
+
+        write_result = write_file_content_on_socket(socket_fd, file_fd, file_chunk->offset, file_chunk->size);
+        LOG_TRACE_POINT;
+    }
+
+    if ( write_result == SUCCESS ) {
+        LOG_TRACE_POINT;
+
+        write_result = write_content_on_socket(socket_fd, trailer_byte_array);
+        LOG_TRACE_POINT;
+    }
+
+    switch (write_result) {
 
         case SUCCESS:
             LOG_TRACE_POINT;
+
+            file_chunk->deadline = get_event_loop_time() + FILE_CHUNK_CONFIRMATION_TIMEOUT;
             break;
 
         case DEVICE_DISCONNECTED:
             LOG_TRACE_POINT;
-            return DEVICE_DISCONNECTED;
             break;
 
         default:
-            LOG_ERROR("Error while sending file header.");
-            return GENERIC_ERROR;
+            LOG_ERROR("Error while sending the file chunk.");
+            write_result = GENERIC_ERROR;
             break;
     }
 
-    send_result = send_file_content(socket_fd, file_path, file_size);
     LOG_TRACE_POINT;
+    return write_result;
+}
 
-    switch ( send_result ) {
+/*
+ * Sends a file content.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the file content.
+ *  file_path - The file path to send its content.
+ *  file_size - Size of the file to be sent.
+ *  file_offset - Position of the first byte of the file to be sent.
+ *
+ * Returns
+ *  SUCCESS - If the content was sent successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Up to "transmission window size" file chunks are sent without waiting for their confirmations. A new chunk is sent as soon as the oldest one is confirmed.
+ */
+int send_file_content(int socket_fd, char* file_path, size_t file_size, size_t file_offset) {
+    LOG_TRACE("File size: %zu, file offset: %zu, file path: \"%s\", window size: %u.", file_size, file_offset, file_path, _transmission_window_size);
 
-        case SUCCESS:
+    bool send_content_concluded = false;
+    int errno_value;
+    int file_fd;
+    size_t total_bytes_sent = file_offset;
+    int close_result;
+    int send_result;
+    int result = SUCCESS;
+    file_chunk_t* file_chunk;
+    transmission_window_t transmission_window;
+
+    file_fd = open(file_path, O_RDONLY);
+
+    if ( file_fd == -1 ) {
+        errno_value = errno;
+        LOG_ERROR("Could not open file \"%s\".", file_path);
+        LOG_ERROR("%s", strerror(errno_value));
+        return GENERIC_ERROR;
+    }
+
+    /* Informs the kernel the file will be read sequentially, so it can read ahead more aggressively. */
+    posix_fadvise(file_fd, file_offset, 0, POSIX_FADV_SEQUENTIAL);
+
+    transmission_window.first = 0;
+    transmission_window.count = 0;
+
+    while ( send_content_concluded == false ) {
+        LOG_TRACE_POINT;
+
+        send_result = SUCCESS;
+
+        while ( transmission_window.count < _transmission_window_size && total_bytes_sent < file_size ) {
             LOG_TRACE_POINT;
-            break;
 
-        case DEVICE_DISCONNECTED:
+            file_chunk = &transmission_window.chunks[(transmission_window.first + transmission_window.count) % MAXIMUM_TRANSMISSION_WINDOW_SIZE];
+            file_chunk->offset = total_bytes_sent;
+            file_chunk->size = file_size - total_bytes_sent;
+            if ( file_chunk->size > DATA_CHUNK_SIZE ) {
+                file_chunk->size = DATA_CHUNK_SIZE;
+            }
+            file_chunk->retransmissions = 0;
+            file_chunk->confirmed = false;
+
+            if ( write_send_file_chunk_package_preamble(file_chunk->preamble, &file_chunk->package_id, file_chunk->size) != SUCCESS ) {
+                LOG_ERROR("Error while writing the file chunk package preamble.");
+                send_result = GENERIC_ERROR;
+                break;
+            }
+
+            send_result = send_file_chunk(socket_fd, file_fd, file_chunk);
             LOG_TRACE_POINT;
-            return DEVICE_DISCONNECTED;
-            break;
 
-        default:
-            LOG_ERROR("Error while sending file content.");
-            return GENERIC_ERROR;
-            break;
+            if ( send_result != SUCCESS ) {
+                LOG_TRACE_POINT;
+                break;
+            }
+
+            transmission_window.count++;
+            total_bytes_sent += file_chunk->size;
+            LOG_TRACE("Bytes sent: %zu, total bytes sent: %zu.", file_chunk->size, total_bytes_sent);
+        }
+
+        if ( send_result == SUCCESS ) {
+            LOG_TRACE_POINT;
+
+            if ( transmission_window.count == 0 ) {
+                LOG_TRACE("All file chunks were confirmed.");
+                send_content_concluded = true;
+                break;
+            }
+
+            send_result = receive_file_chunk_confirmations(socket_fd, &transmission_window);
+            LOG_TRACE_POINT;
+        }
+
+        if ( send_result == SUCCESS ) {
+            LOG_TRACE_POINT;
+
+            send_result = resend_file_chunks(socket_fd, file_fd, &transmission_window);
+            LOG_TRACE_POINT;
+        }
+
+        switch ( send_result ) {
+
+            case SUCCESS:
+                LOG_TRACE_POINT;
+                break;
+
+            case DEVICE_DISCONNECTED:
+                LOG_TRACE_POINT;
+
+                send_content_concluded = true;
+                result = DEVICE_DISCONNECTED;
+                break;
+
+            default:
+                LOG_ERROR("Error while sending file data chunks.");
+
+                send_content_concluded = true;
+                result = GENERIC_ERROR;
+                break;
+        }
+    }
+
+    close_result = close(file_fd);
+
+    if ( close_result != 0 ) {
+        errno_value = errno;
+        LOG_ERROR("Error while closing file \"%s\".", file_path);
+        LOG_ERROR("%s", strerror(errno_value));
+        result =  GENERIC_ERROR;
     }
 
-    send_result = send_file_trailer(socket_fd);
     LOG_TRACE_POINT;
+    return result;
+}
 
-    switch ( send_result ) {
+/*
+ * Sends a file header.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the file header.
+ *  file_size - Size of the file to be sent.
+ *  file_name - The name of the file to be sent.
+ *  file_offset - Position of the first byte of the file to be sent.
+ *  transfer_id - Identifier of the file transfer. Zero if the transfer cannot be resumed.
+ *  file_digest - Digest of the whole file content.
+ *
+ * Returns
+ *  SUCCESS - If the file header was sent successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int send_file_header(int socket_fd, size_t file_size, const char* file_name, size_t file_offset, uint32_t transfer_id, uint64_t file_digest){
+    LOG_TRACE_POINT;
+
+    int result = SUCCESS;
+    int send_package_result;
+    package_t send_file_header_package;
+
+    send_file_header_package = create_send_file_header_package(file_size, file_name, file_offset, transfer_id, file_digest);
+    LOG_TRACE_POINT;
+
+    send_package_result = send_package(socket_fd, send_file_header_package);
+    LOG_TRACE_POINT;
+
+    switch ( send_package_result ) {
 
         case SUCCESS:
             LOG_TRACE_POINT;
+
+            result = SUCCESS;
             break;
 
         case DEVICE_DISCONNECTED:
             LOG_TRACE_POINT;
-            return DEVICE_DISCONNECTED;
+
+            result = DEVICE_DISCONNECTED;
             break;
 
         default:
-            LOG_ERROR("Error while sending file trailer.");
-            return GENERIC_ERROR;
+
+            LOG_ERROR("Error while sending the file header.");
+            result = GENERIC_ERROR;
             break;
     }
 
+    delete_package(send_file_header_package);
+
     LOG_TRACE_POINT;
-    return SUCCESS;
+    return result;
 }
 
 /*
- * Sends a chunk of data read from a file.
+ * Sends a file trailer.
  *
  * Parameters
- *  socket_fd - The connection socket file descriptor to send the file chunk.
- *  chunk_size - Size of the chunk to be sent.
- *  chunk_data - The chunk of data to be sent.
+ *  socket_fd - The connection socket file descriptor to send the file trailer.
  *
  * Returns
- *  SUCCESS - If the file chunk was sent successfully.
+ *  SUCCESS - If the file trailer was sent successfully.
  *  DEVICE_DISCONNECTED - If the device was disconnected.
  *  GENERIC_ERROR - Otherwise.
  */
-int send_file_chunk(int socket_fd, size_t chunk_size, uint8_t* chunk_data){
+int send_file_trailer(int socket_fd){
     LOG_TRACE_POINT;
 
     int result = SUCCESS;
     int send_package_result;
-    package_t send_file_chunk_package;
+    package_t send_file_trailer_package;
 
-    send_file_chunk_package = create_send_file_chunk_package(chunk_size, chunk_data);
+    send_file_trailer_package = create_send_file_trailer_package();
     LOG_TRACE_POINT;
 
-    send_package_result = send_package(socket_fd, send_file_chunk_package);
+    send_package_result = send_package(socket_fd, send_file_trailer_package);
     LOG_TRACE_POINT;
 
     switch ( send_package_result ) {
@@ -633,327 +1549,521 @@ int send_file_chunk(int socket_fd, size_t chunk_size, uint8_t* chunk_data){
 
         default:
 
-            LOG_ERROR("Error while sending the file chunk.");
+            LOG_ERROR("Error while sending the file trailer.");
             result = GENERIC_ERROR;
             break;
     }
 
-    delete_package(send_file_chunk_package);
+    delete_package(send_file_trailer_package);
 
     LOG_TRACE_POINT;
     return result;
 }
 
 /*
- * Sends a file content.
+ * Sends a package through a connection.
  *
  * Parameters
- *  socket_fd - The connection socket file descriptor to send the file content.
- *  file_path - The file path to send its content. 
+ *  socket_fd - The connection socket file descriptor to send the package.
+ *  package - The package to be sent.
+ *
+ *  Returns
+ *   SUCCESS - If the package was sent successfuly.
+ *   DEVICE_DISCONNECTED - If the device was disconnected.
+ *   GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The package is encoded on the package buffer of this module, so "send_package" must not be called concurrently.
+ */
+int send_package(int socket_fd, package_t package) {
+    LOG_TRACE_POINT;
+
+    int result = GENERIC_ERROR;
+    int write_result;
+    int wait_result;
+    int receive_confirmation_result;
+    int encode_result;
+    bool write_concluded = false;
+    int write_attempts = 0;
+    byte_array_t package_byte_array;
+
+    package_byte_array.data = _package_buffer;
+    encode_result = encode_package(_package_buffer, sizeof(_package_buffer), package, &package_byte_array.size);
+    LOG_TRACE_POINT;
+
+    if ( encode_result == GENERIC_ERROR ) {
+        LOG_ERROR("Error while encoding package.");
+        return GENERIC_ERROR;
+    }
+
+    while (write_concluded == false ) {
+        LOG_TRACE_POINT;
+
+        write_result = write_content_on_socket(socket_fd, package_byte_array);
+        LOG_TRACE_POINT;
+
+        if ( write_result == SUCCESS ) {
+            LOG_TRACE_POINT;
+
+            receive_confirmation_result = receive_confirmation(socket_fd, package);
+            LOG_TRACE_POINT;
+
+            switch (receive_confirmation_result) {
+
+                case SUCCESS:
+                    LOG_TRACE_POINT;
+
+                    write_concluded = true;
+                    result = SUCCESS;
+                    break;
+
+                case DEVICE_DISCONNECTED:
+                    LOG_TRACE_POINT;
+                    write_concluded = true;
+                    result = DEVICE_DISCONNECTED;
+                    break;
+
+                default:
+                    LOG_ERROR("Did not receive confirmation for package id 0x%x.", package.id);
+
+                    write_concluded = true;
+                    result = GENERIC_ERROR;
+                    break;
+            }
+
+        } else if ( write_result == DEVICE_DISCONNECTED ) {
+            LOG_TRACE_POINT;
+            write_concluded = true;
+            result = DEVICE_DISCONNECTED;
+        } else {
+            LOG_TRACE_POINT;
+
+            write_attempts++;
+            if ( write_attempts >= MAXIMUM_WRITE_ATTEMPTS ) {
+                LOG_ERROR("Maximum write attempts reached.");
+                write_concluded = true;
+                result = GENERIC_ERROR;
+                break;
+            }
+
+            wait_result = wait_socket_event(socket_fd, SOCKET_EVENT_WRITE, get_event_loop_time() + WRITE_RETRY_TIMEOUT);
+            LOG_TRACE_POINT;
+
+            switch (wait_result) {
+                case SOCKET_EVENT_OCCURRED:
+                case DEADLINE_REACHED:
+                    LOG_TRACE_POINT;
+                    break;
+
+                default:
+                    LOG_ERROR("Error while waiting to retry writing package.");
+                    write_concluded = true;
+                    result = GENERIC_ERROR;
+                    break;
+            }
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Sends a stream through a connection.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the stream.
+ *  stream_name - The name informed to the remote device on the stream header.
+ *  read_stream - The function which provides the stream content. It must return the number of bytes read, which can be zero, or -1 when the stream is over.
+ *  package - The variable to store a command package received while the stream was being sent.
  *
  * Returns
- *  SUCCESS - If the content was sent successfully.
+ *  SUCCESS - If the stream was over or the remote device requested it to stop.
+ *  STREAM_INTERRUPTED - If the remote device sent another command. The command package is stored on "package" and must be deleted by the caller.
  *  DEVICE_DISCONNECTED - If the device was disconnected.
  *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  A stream is sent like a file of unknown size: a file header with size zero, followed by file chunks and a file trailer.
+ *  Up to "transmission window size" stream chunks are sent without waiting for their confirmations. While the window is full the stream content is not read, so a slow connection makes the content provider discard content instead of delaying it.
+ *  The bytes sent, not confirmed and discarded by this function are available through "get_stream_statistics" function after the stream is concluded.
  */
-int send_file_content(int socket_fd, char* file_path, size_t file_size) {
-    LOG_TRACE("File size: %zu, file path: \"%s\".", file_size, file_path);
+int send_stream(int socket_fd, const char* stream_name, ssize_t (*read_stream)(uint8_t*, size_t), package_t* package) {
+    LOG_TRACE("Stream name: \"%s\", window size: %u.", stream_name, _transmission_window_size);
 
-    bool send_content_concluded = false;
-    int errno_value;
-    uint8_t* data_chunk_buffer;
-    size_t bytes_read;
-    size_t total_bytes_read = 0; 
-    FILE* file;
-    int fclose_result;
+    int result = SUCCESS;
     int send_result;
-    int result;
-
-    file = fopen(file_path, "r");
+    int wait_result;
+    bool stream_concluded = false;
+    bool stream_over = false;
+    ssize_t read_result;
+    size_t content_size = 0;
+    uint64_t content_deadline = 0;
+    uint64_t chunks_sent = 0;
+    stream_window_t stream_window;
+
+    send_result = send_file_header(socket_fd, 0, stream_name, 0, 0, 0);
+    LOG_TRACE_POINT;
 
-    if ( file == NULL ) {
-        errno_value = errno;
-        LOG_ERROR("Could not open file \"%s\".", file_path);
-        LOG_ERROR("%s", strerror(errno_value));
-        return GENERIC_ERROR;
+    if ( send_result != SUCCESS ) {
+        LOG_ERROR("Error while sending stream header.");
+        return send_result;
     }
 
-    data_chunk_buffer = malloc(DATA_CHUNK_BUFFER_SIZE*sizeof(uint8_t));
+    stream_window.first = 0;
+    stream_window.count = 0;
+
+    _stream_statistics.bytes_sent = 0;
+    _stream_statistics.bytes_unconfirmed = 0;
+    _stream_statistics.bytes_discarded = 0;
 
-    while (send_content_concluded == false ) {
+    while ( stream_concluded == false ) {
         LOG_TRACE_POINT;
 
-        bytes_read = fread(data_chunk_buffer, sizeof(uint8_t), DATA_CHUNK_BUFFER_SIZE, file);
+        send_result = SUCCESS;
 
-        if ( ferror(file) != 0 ) {
-            LOG_ERROR("Error while reading \"%s\" file data chunk.", file_path);
-            send_content_concluded = true;
-            result = GENERIC_ERROR;
+        if ( stream_over == false && content_size < STREAM_CHUNK_SIZE ) {
+            read_result = read_stream(_stream_buffer + content_size, STREAM_CHUNK_SIZE - content_size);
+            if ( read_result < 0 ) {
+                LOG_TRACE("Stream content is over.");
+                stream_over = true;
+            }
+            else if ( read_result > 0 ) {
+                if ( content_size == 0 ) {
+                    content_deadline = get_event_loop_time() + STREAM_CHUNK_MAXIMUM_DELAY;
+                }
+                content_size += (size_t)read_result;
+            }
         }
 
-        total_bytes_read += bytes_read;
-        LOG_TRACE("Bytes read: %zu, total bytes read: %zu.", bytes_read, total_bytes_read);
+        if ( content_size > 0 && stream_window.count < _transmission_window_size &&
+             ( content_size == STREAM_CHUNK_SIZE || stream_over == true || get_event_loop_time() >= content_deadline ) ) {
+            LOG_TRACE_POINT;
 
-        if ( feof(file) != 0 ){
+            send_result = send_stream_chunk(socket_fd, _stream_buffer, content_size, &stream_window);
             LOG_TRACE_POINT;
-            send_content_concluded = true;
 
-            if (total_bytes_read != file_size) {
-                LOG_ERROR("File reading concluded, but the total bytes sent is different from file size");
-                LOG_ERROR("File size: %zu, total read: %zu.", file_size, total_bytes_read);
-                result = GENERIC_ERROR;
-            } else {
-                LOG_TRACE_POINT;
-                result = SUCCESS;
+            if ( send_result == SUCCESS ) {
+                _stream_statistics.bytes_sent += content_size;
+                chunks_sent++;
             }
+            else {
+                _stream_statistics.bytes_discarded += content_size;
+            }
+            content_size = 0;
         }
 
-        if ( bytes_read > 0 ) {
-            send_result = send_file_chunk(socket_fd, bytes_read, data_chunk_buffer);
+        if ( send_result == SUCCESS ) {
             LOG_TRACE_POINT;
 
-            switch ( send_result ) {
+            send_result = receive_stream_packages(socket_fd, &stream_window, package);
+            LOG_TRACE_POINT;
+        }
 
-                case SUCCESS:
-                    LOG_TRACE_POINT;
-                    break;
-                    
-                case DEVICE_DISCONNECTED:
-                    LOG_TRACE_POINT;
+        switch ( send_result ) {
 
-                    send_content_concluded = true;
-                    result = DEVICE_DISCONNECTED;
+            case SUCCESS:
+                LOG_TRACE_POINT;
+
+                if ( stream_over == true && content_size == 0 ) {
+                    LOG_TRACE_POINT;
+                    stream_concluded = true;
                     break;
+                }
 
-                case GENERIC_ERROR:
-                    LOG_ERROR("Error while sending file data chunk.");
+                wait_result = wait_socket_event(socket_fd, SOCKET_EVENT_READ, get_event_loop_time() + STREAM_POLL_TIMEOUT);
+                LOG_TRACE_POINT;
 
-                    send_content_concluded = true;
+                if ( wait_result != SOCKET_EVENT_OCCURRED && wait_result != DEADLINE_REACHED ) {
+                    LOG_ERROR("Error while waiting for packages during stream.");
+                    stream_concluded = true;
                     result = GENERIC_ERROR;
-                    break;
-            }
+                }
+                break;
+
+            case STREAM_STOPPED:
+                LOG_TRACE_POINT;
+
+                stream_concluded = true;
+                result = SUCCESS;
+                break;
+
+            case STREAM_INTERRUPTED:
+            case DEVICE_DISCONNECTED:
+                LOG_TRACE_POINT;
+
+                stream_concluded = true;
+                result = send_result;
+                break;
+
+            default:
+                LOG_ERROR("Error while sending stream.");
+
+                stream_concluded = true;
+                result = GENERIC_ERROR;
+                break;
         }
     }
 
-    fclose_result = fclose(file);
+    _stream_statistics.bytes_discarded += content_size;
 
-    if ( fclose_result != 0 ) {
-        errno_value = errno;
-        LOG_ERROR("Error while closing file \"%s\".", file_path);
-        LOG_ERROR("%s", strerror(errno_value));
-        result =  GENERIC_ERROR;
-    }
+    LOG_TRACE("Stream chunks sent: %llu, bytes sent: %llu, bytes not confirmed: %llu, bytes discarded: %llu.", (unsigned long long)chunks_sent,
+              (unsigned long long)_stream_statistics.bytes_sent, (unsigned long long)_stream_statistics.bytes_unconfirmed, (unsigned long long)_stream_statistics.bytes_discarded);
+
+    if ( result == SUCCESS || result == STREAM_INTERRUPTED ) {
+        LOG_TRACE_POINT;
+
+        send_result = send_file_trailer(socket_fd);
+        LOG_TRACE_POINT;
 
-    free(data_chunk_buffer);
+        if ( send_result != SUCCESS ) {
+            LOG_ERROR("Error while sending stream trailer.");
+            if ( result == STREAM_INTERRUPTED ) {
+                delete_package(*package);
+            }
+            result = send_result;
+        }
+    }
 
     LOG_TRACE_POINT;
     return result;
 }
 
 /*
- * Sends a file header.
+ * Sends a chunk of stream content.
  *
  * Parameters
- *  socket_fd - The connection socket file descriptor to send the file header.
- *  file_size - Size of the file to be sent.
- *  file_name - The name of the file to be sent.
+ *  socket_fd - The connection socket file descriptor to send the stream chunk.
+ *  content - The stream content to be sent.
+ *  content_size - The size of the stream content.
+ *  stream_window - The stream chunks waiting for confirmation.
  *
  * Returns
- *  SUCCESS - If the file header was sent successfully.
+ *  SUCCESS - If the stream chunk was sent successfully.
  *  DEVICE_DISCONNECTED - If the device was disconnected.
  *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  This function does not wait for the stream chunk confirmation. Its deadline is defined to be checked later.
  */
-int send_file_header(int socket_fd, size_t file_size, const char* file_name){
-    LOG_TRACE_POINT;
+int send_stream_chunk(int socket_fd, uint8_t* content, size_t content_size, stream_window_t* stream_window) {
+    LOG_TRACE("Chunk size: %zu.", content_size);
 
-    int result = SUCCESS;
-    int send_package_result;
-    package_t send_file_header_package;
+    int write_result;
+    uint8_t preamble[SEND_FILE_CHUNK_PACKAGE_PREAMBLE_SIZE];
+    uint32_t package_trailer = PACKAGE_TRAILER;
+    byte_array_t byte_array;
+    stream_chunk_t* stream_chunk;
 
-    send_file_header_package = create_send_file_header_package(file_size, file_name);
-    LOG_TRACE_POINT;
+    stream_chunk = &stream_window->chunks[(stream_window->first + stream_window->count) % MAXIMUM_TRANSMISSION_WINDOW_SIZE];
 
-    send_package_result = send_package(socket_fd, send_file_header_package);
+    if ( write_send_file_chunk_package_preamble(preamble, &stream_chunk->package_id, content_size) != SUCCESS ) {
+        LOG_ERROR("Error while writing the stream chunk package preamble.");
+        return GENERIC_ERROR;
+    }
+
+    byte_array.size = SEND_FILE_CHUNK_PACKAGE_PREAMBLE_SIZE;
+    byte_array.data = preamble;
+    write_result = write_content_on_socket(socket_fd, byte_array);
     LOG_TRACE_POINT;
 
-    switch ( send_package_result ) {
+    if ( write_result == SUCCESS ) {
+        LOG_TRACE_POINT;
+
+        byte_array.size = content_size;
+        byte_array.data = content;
+        write_result = write_content_on_socket(socket_fd, byte_array);
+        LOG_TRACE_POINT;
+    }
+
+    if ( write_result == SUCCESS ) {
+        LOG_TRACE_POINT;
+
+        byte_array.size = PACKAGE_TRAILER_SIZE;
+        byte_array.data = (uint8_t*)&package_trailer;
+        write_result = write_content_on_socket(socket_fd, byte_array);
+        LOG_TRACE_POINT;
+    }
+
+    switch (write_result) {
 
         case SUCCESS:
             LOG_TRACE_POINT;
 
-            result = SUCCESS;
+            stream_chunk->size = content_size;
+            stream_chunk->deadline = get_event_loop_time() + STREAM_CHUNK_CONFIRMATION_TIMEOUT;
+            stream_chunk->confirmed = false;
+            stream_window->count++;
             break;
 
         case DEVICE_DISCONNECTED:
             LOG_TRACE_POINT;
-
-            result = DEVICE_DISCONNECTED;
             break;
 
         default:
-
-            LOG_ERROR("Error while sending the file header.");
-            result = GENERIC_ERROR;
+            LOG_ERROR("Error while sending the stream chunk.");
+            write_result = GENERIC_ERROR;
             break;
     }
 
-    delete_package(send_file_header_package);
-
     LOG_TRACE_POINT;
-    return result;
+    return write_result;
 }
 
 /*
- * Sends a file trailer.
+ * Sends a file transfer, from the offset informed until the end of the transfer.
  *
  * Parameters
- *  socket_fd - The connection socket file descriptor to send the file trailer.
+ *  socket_fd - The connection socket file descriptor to send the file.
+ *  transfer - The transfer to be sent.
+ *  file_offset - Position of the first byte of the file to be sent.
  *
  * Returns
- *  SUCCESS - If the file trailer was sent successfully.
+ *  SUCCESS - If the transfer was sent successfully.
  *  DEVICE_DISCONNECTED - If the device was disconnected.
  *  GENERIC_ERROR - Otherwise.
  */
-int send_file_trailer(int socket_fd){
-    LOG_TRACE_POINT;
+int send_transfer(int socket_fd, transfer_t* transfer, size_t file_offset) {
+    LOG_TRACE("Transfer ID: 0x%08x, file size: %zu, file offset: %zu.", transfer->transfer_id, transfer->file_size, file_offset);
 
-    int result = SUCCESS;
-    int send_package_result;
-    package_t send_file_trailer_package;
+    char* file_name;
+    int send_result;
 
-    send_file_trailer_package = create_send_file_trailer_package();
-    LOG_TRACE_POINT;
+    file_name = basename(transfer->file_path);
+    LOG_TRACE("File name: \"%s\".", file_name);
 
-    send_package_result = send_package(socket_fd, send_file_trailer_package);
+    send_result = send_file_header(socket_fd, transfer->file_size, file_name, file_offset, transfer->transfer_id, transfer->file_digest);
     LOG_TRACE_POINT;
 
-    switch ( send_package_result ) {
+    switch ( send_result ) {
 
         case SUCCESS:
             LOG_TRACE_POINT;
-
-            result = SUCCESS;
             break;
 
         case DEVICE_DISCONNECTED:
             LOG_TRACE_POINT;
-
-            result = DEVICE_DISCONNECTED;
+            return DEVICE_DISCONNECTED;
             break;
 
         default:
-
-            LOG_ERROR("Error while sending the file trailer.");
-            result = GENERIC_ERROR;
+            LOG_ERROR("Error while sending file header.");
+            return GENERIC_ERROR;
             break;
     }
 
-    delete_package(send_file_trailer_package);
-
-    LOG_TRACE_POINT;
-    return result;
-}
-
-/*
- * Sends a package through a connection.
- *
- * Parameters
- *  socket_fd - The connection socket file descriptor to send the package.
- *  package - The package to be sent.
- *
- *  Returns
- *   SUCCESS - If the package was sent successfuly.
- *   DEVICE_DISCONNECTED - If the device was disconnected.
- *   GENERIC_ERROR - Otherwise.
- */
-int send_package(int socket_fd, package_t package) {
+    send_result = send_file_content(socket_fd, transfer->file_path, transfer->file_size, file_offset);
     LOG_TRACE_POINT;
 
-    int result = GENERIC_ERROR;
-    int write_result;
-    int wait_result;
-    int receive_confirmation_result;
-    int convertion_result;
-    bool write_concluded = false;
-    retry_informations_t retry_informations;
-    byte_array_t package_byte_array;
+    switch ( send_result ) {
 
-    retry_informations = create_retry_informations(MAXIMUM_WRITE_ATTEMPTS);
-    LOG_TRACE_POINT;
+        case SUCCESS:
+            LOG_TRACE_POINT;
+            break;
 
-    convertion_result = convert_package_to_byte_array(&package_byte_array, package);
-    LOG_TRACE_POINT;
+        case DEVICE_DISCONNECTED:
+            LOG_TRACE_POINT;
+            return DEVICE_DISCONNECTED;
+            break;
 
-    if ( convertion_result == GENERIC_ERROR ) {
-        LOG_ERROR("Error while converting package to byte array.");
-        return GENERIC_ERROR;
+        default:
+            LOG_ERROR("Error while sending file content.");
+            return GENERIC_ERROR;
+            break;
     }
 
-    while (write_concluded == false ) {
-        LOG_TRACE_POINT;
+    send_result = send_file_trailer(socket_fd);
+    LOG_TRACE_POINT;
 
-        write_result = write_content_on_socket(socket_fd, package_byte_array);
-        LOG_TRACE_POINT;
+    switch ( send_result ) {
 
-        if ( write_result == SUCCESS ) {
+        case SUCCESS:
             LOG_TRACE_POINT;
+            break;
 
-            receive_confirmation_result = receive_confirmation(socket_fd, package);
+        case DEVICE_DISCONNECTED:
             LOG_TRACE_POINT;
+            return DEVICE_DISCONNECTED;
+            break;
 
-            switch (receive_confirmation_result) {
+        default:
+            LOG_ERROR("Error while sending file trailer.");
+            return GENERIC_ERROR;
+            break;
+    }
 
-                case SUCCESS:
-                    LOG_TRACE_POINT;
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
 
-                    write_concluded = true;
-                    result = SUCCESS;
-                    break;
+/*
+ * Defines the number of packages which can be sent without waiting for their confirmations.
+ *
+ * Parameters
+ *  window_size - The number of packages requested.
+ *
+ * Returns
+ *  The number of packages accepted, limited between 1 and MAXIMUM_TRANSMISSION_WINDOW_SIZE.
+ */
+uint32_t set_transmission_window_size(uint32_t window_size) {
+    LOG_TRACE("Window size requested: %u.", window_size);
 
-                case DEVICE_DISCONNECTED:
-                    LOG_TRACE_POINT;
-                    write_concluded = true;
-                    result = DEVICE_DISCONNECTED;
-                    break;
+    if ( window_size < 1 ) {
+        LOG_TRACE_POINT;
+        window_size = 1;
+    }
 
-                default:
-                    LOG_ERROR("Did not receive confirmation for package id 0x%x.", package.id);
+    if ( window_size > MAXIMUM_TRANSMISSION_WINDOW_SIZE ) {
+        LOG_TRACE_POINT;
+        window_size = MAXIMUM_TRANSMISSION_WINDOW_SIZE;
+    }
 
-                    write_concluded = true;
-                    result = GENERIC_ERROR;
-                    break;
-            }
+    _transmission_window_size = window_size;
 
-        } else {
-            LOG_TRACE_POINT;
+    LOG_TRACE("Window size defined: %u.", _transmission_window_size);
+    return _transmission_window_size;
+}
 
-            wait_result = wait_time(&retry_informations);
-            LOG_TRACE_POINT;
+/*
+ * Starts a file transfer, registering it on the journal if it is interrupted.
+ *
+ * Parameters
+ *  socket_fd - The connection socket file descriptor to send the file.
+ *  transfer - The transfer to be sent. Its identifier is defined by this function.
+ *  file_offset - Position of the first byte of the file to be sent.
+ *
+ * Returns
+ *  SUCCESS - If the transfer was sent successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Only transfers which can be resumed (the ones interrupted) are written on the journal, so a transfer concluded does not cost a journal write.
+ */
+int start_transfer(int socket_fd, transfer_t* transfer, size_t file_offset) {
+    LOG_TRACE("File size: %zu, file offset: %zu.", transfer->file_size, file_offset);
 
-            switch (wait_result) {
-                case SUCCESS:
-                    LOG_TRACE_POINT;
-                    break;
+    int send_result;
 
-                case MAXIMUM_RETRY_ATTEMPTS_REACHED:
-                    LOG_ERROR("Maximum write attempts reached.");
-                    write_concluded = true;
-                    result = GENERIC_ERROR;
-                    break;
+    if ( reserve_transfer(transfer) != SUCCESS ) {
+        LOG_WARNING("Could not reserve the transfer of file \"%s\". It will not be possible to resume it.", transfer->file_path);
+        transfer->transfer_id = 0;
+        transfer->registered = true;
+    }
 
-                default:
-                    LOG_ERROR("Error while waiting to retry writing package.");
-                    write_concluded = true;
-                    result = GENERIC_ERROR;
-                    break;
-            }
+    send_result = send_transfer(socket_fd, transfer, file_offset);
+    LOG_TRACE_POINT;
+
+    if ( send_result != SUCCESS && transfer->registered == false ) {
+        LOG_TRACE_POINT;
+
+        if ( register_transfer(transfer) != SUCCESS ) {
+            LOG_WARNING("Could not register the transfer of file \"%s\". It will not be possible to resume it.", transfer->file_path);
         }
     }
 
-    delete_byte_array(&package_byte_array);
-
     LOG_TRACE_POINT;
-    return result;
+    return send_result;
 }
 
 /*
@@ -963,20 +2073,21 @@ int send_package(int socket_fd, package_t package) {
  *  socket_fd - The connection socket file descriptor to send the command result.
  *  command_result - The command result to be sent.
  *  execution_delay - The command execution delay to be sent.
+ *  pre_roll - The length of audio captured before the command to be sent. Commands which do not start an audio record must send it cleared.
  *
  * Returns
  *  SUCCESS - If the command result was send sucessfully.
  *  DEVICE_DISCONNECTED - If the device was disconnected.
  *  GENERIC_ERROR - Otherwise.
  */
-int transmit_command_result(int socket_fd, int command_result, struct timeval execution_delay) {
+int transmit_command_result(int socket_fd, int command_result, struct timeval execution_delay, struct timeval pre_roll) {
     LOG_TRACE_POINT;
 
     int result = SUCCESS;
     int send_package_result;
     package_t command_result_package;
 
-    command_result_package = create_command_result_package(command_result, execution_delay);
+    command_result_package = create_command_result_package(command_result, execution_delay, pre_roll);
     LOG_TRACE_POINT;
 
     send_package_result = send_package(socket_fd, command_result_package);
@@ -15,11 +15,15 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <sys/time.h>
 #include <unistd.h>
 
 #include "bluetooth/package/codes.h"
+#include "bluetooth/package/package.h"
+#include "bluetooth/transport/transport.h"
 #include "bluetooth/connection.h"
+#include "bluetooth/event_loop.h"
 #include "log.h"
 #include "return_codes.h"
 
@@ -28,13 +32,33 @@
  * Macros.
  */
 
-/* Size of the buffer to read content from the socket. */
-#define READ_CONTENT_BUFFER_SIZE 1024
+/* Size of the buffer which stores the content received from a socket. */
+#define RECEIVE_BUFFER_SIZE (PACKAGE_MAXIMUM_SIZE*2)
+
+/* Maximum number of sockets which can have a receive buffer at the same time. */
+#define MAXIMUM_RECEIVE_BUFFERS 4
+
+/* Size of the buffer used to copy file content when the kernel cannot transfer it directly to the socket. */
+#define FILE_COPY_BUFFER_SIZE 4096
 
 /* Error code received through "errno" variable when the connection was reseted by the peer. */
 #define ERROR_CODE_CONNECTION_RESET_BY_PEER 104
 
 
+/*
+ * Structures.
+ */
+
+/* Stores the content received from a socket which was not consumed yet. */
+typedef struct {
+    bool in_use;
+    int socket_fd;
+    uint8_t* data;
+    size_t start;
+    size_t end;
+} receive_buffer_t;
+
+
 /*
  * Variables.
  */
@@ -42,6 +66,29 @@
 /* Time to wait for a content to be read on socket. */
 const struct timeval _read_wait_time = { .tv_sec = 0, .tv_usec = 0 };
 
+/* Receive buffers of the sockets being read. */
+receive_buffer_t _receive_buffers[MAXIMUM_RECEIVE_BUFFERS];
+
+
+/*
+ * Function headers.
+ */
+
+/* Extracts a complete package from a receive buffer. */
+int extract_package_from_receive_buffer(receive_buffer_t*, byte_array_t*);
+
+/* Reads the content available on a socket into its receive buffer. */
+int fill_receive_buffer(receive_buffer_t*);
+
+/* Returns the receive buffer of a socket. */
+receive_buffer_t* get_receive_buffer(int);
+
+/* Releases the receive buffer of a socket. */
+int release_receive_buffer(int);
+
+/* Copies a file content to a socket through a user space buffer. */
+int copy_file_content_to_socket(int, int, off_t, size_t);
+
 
 /*
  * Function elaborations.
@@ -63,7 +110,13 @@ int close_socket(int socket_fd){
     int result;
     int close_result;
 
-    close_result = close(socket_fd);
+    release_receive_buffer(socket_fd);
+    LOG_TRACE_POINT;
+
+    release_event_loop(socket_fd);
+    LOG_TRACE_POINT;
+
+    close_result = close_transport(socket_fd);
     if (close_result < 0 ) {
         LOG_ERROR("Error while closing socket.");
         LOG_ERROR("%s", strerror(errno));
@@ -96,16 +149,12 @@ int check_socket_content(int socket_fd, struct timeval check_time) {
     LOG_TRACE_POINT;
 
     int result;
-    int select_result;
-    fd_set socket_fd_set;
+    int poll_result;
 
-    FD_ZERO(&socket_fd_set);
-    FD_SET(socket_fd, &socket_fd_set);
-    select_result = select((socket_fd+1), &socket_fd_set, (fd_set*)NULL, (fd_set*)NULL, &check_time);
-    FD_CLR(socket_fd, &socket_fd_set);
-    LOG_TRACE("Select result: %d.", select_result);
+    poll_result = poll_transport(socket_fd, check_time);
+    LOG_TRACE("Poll result: %d.", poll_result);
 
-    switch (select_result) {
+    switch (poll_result) {
         case 0:
             LOG_TRACE("No content on socket.");
             result = NO_CONTENT_TO_READ;
@@ -127,72 +176,243 @@ int check_socket_content(int socket_fd, struct timeval check_time) {
 }
 
 /*
- * Reads content from a socket.
+ * Copies a file content to a socket through a user space buffer.
  *
  * Parameters
- *  socket_fd - The socket communication file descriptor to read content.
- *  byte_array - The structure to store content read from socket.
+ *  socket_fd - The socket communication file descriptor to write the content.
+ *  file_fd - The descriptor of the file to read the content.
+ *  offset - The file position to start reading the content.
+ *  size - Size of the content to be copied.
+ *
+ * Returns
+ *  SUCCESS - If the content was written successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Used only when the kernel refuses to transfer the file content straight to the socket.
+ */
+int copy_file_content_to_socket(int socket_fd, int file_fd, off_t offset, size_t size) {
+    LOG_TRACE("Socket file descriptor: %d, file descriptor: %d, offset: %jd, size: %zu.", socket_fd, file_fd, (intmax_t)offset, size);
+
+    uint8_t buffer[FILE_COPY_BUFFER_SIZE];
+    byte_array_t byte_array;
+    size_t total_copied = 0;
+    size_t bytes_to_read;
+    ssize_t bytes_read;
+    int errno_value;
+    int write_result;
+
+    byte_array.data = buffer;
+
+    while ( total_copied < size ) {
+        LOG_TRACE_POINT;
+
+        bytes_to_read = size - total_copied;
+        if ( bytes_to_read > FILE_COPY_BUFFER_SIZE ) {
+            bytes_to_read = FILE_COPY_BUFFER_SIZE;
+        }
+
+        bytes_read = pread(file_fd, buffer, bytes_to_read, offset + total_copied);
+
+        if ( bytes_read == -1 ) {
+            errno_value = errno;
+            if ( errno_value == EINTR ) {
+                LOG_TRACE_POINT;
+                continue;
+            }
+
+            LOG_ERROR("Error while reading file content.");
+            LOG_ERROR("%s", strerror(errno_value));
+            return GENERIC_ERROR;
+        }
+
+        if ( bytes_read == 0 ) {
+            LOG_ERROR("File ended before the content requested could be read.");
+            return GENERIC_ERROR;
+        }
+
+        byte_array.size = bytes_read;
+        write_result = write_content_on_socket(socket_fd, byte_array);
+        if ( write_result != SUCCESS ) {
+            LOG_ERROR("Error while writing file content on socket.");
+            return write_result;
+        }
+
+        total_copied += bytes_read;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Extracts a complete package from a receive buffer.
+ *
+ * Parameters
+ *  receive_buffer - The receive buffer to extract the package from.
+ *  byte_array - The structure to store the position and size of the package extracted.
+ *
+ * Returns
+ *  SUCCESS - If a complete package was extracted from the receive buffer.
+ *  NO_CONTENT_TO_READ - If the receive buffer does not have a complete package yet.
+ *
+ * Observations
+ *  Packages are framed by the content size informed on their preamble. Bytes which do not belong to a valid package are discarded.
+ *  The package is not copied: the byte array points to the receive buffer data, which is kept untouched until the next read on the socket.
+ */
+int extract_package_from_receive_buffer(receive_buffer_t* receive_buffer, byte_array_t* byte_array) {
+    LOG_TRACE("Buffered content: %zu byte(s).", receive_buffer->end - receive_buffer->start);
+
+    int result;
+    bool extraction_concluded = false;
+    uint8_t* package_start;
+    size_t available;
+    size_t discarded = 0;
+    size_t package_size;
+    uint32_t header;
+    uint32_t content_size;
+    uint32_t trailer;
+
+    while ( extraction_concluded == false ) {
+        LOG_TRACE_POINT;
+
+        package_start = receive_buffer->data + receive_buffer->start;
+        available = receive_buffer->end - receive_buffer->start;
+
+        if ( available < sizeof(uint32_t) ) {
+            LOG_TRACE_POINT;
+            extraction_concluded = true;
+            result = NO_CONTENT_TO_READ;
+            break;
+        }
+
+        memcpy(&header, package_start, sizeof(uint32_t));
+        if ( header != PACKAGE_HEADER ) {
+            receive_buffer->start++;
+            discarded++;
+            continue;
+        }
+
+        if ( available < PACKAGE_PREAMBLE_SIZE ) {
+            LOG_TRACE("Package preamble not completely received.");
+            extraction_concluded = true;
+            result = NO_CONTENT_TO_READ;
+            break;
+        }
+
+        memcpy(&content_size, package_start + PACKAGE_PREAMBLE_SIZE - sizeof(uint32_t), sizeof(uint32_t));
+        if ( content_size > PACKAGE_MAXIMUM_CONTENT_SIZE ) {
+            LOG_WARNING("Package content size informed (%u bytes) is greater than the maximum allowed. Discarding package header.", content_size);
+            receive_buffer->start += sizeof(uint32_t);
+            discarded += sizeof(uint32_t);
+            continue;
+        }
+
+        package_size = PACKAGE_PREAMBLE_SIZE + content_size + PACKAGE_TRAILER_SIZE;
+        if ( available < package_size ) {
+            LOG_TRACE("Package not completely received (%zu of %zu byte(s)).", available, package_size);
+            extraction_concluded = true;
+            result = NO_CONTENT_TO_READ;
+            break;
+        }
+
+        memcpy(&trailer, package_start + package_size - PACKAGE_TRAILER_SIZE, sizeof(uint32_t));
+        if ( trailer != PACKAGE_TRAILER ) {
+            LOG_WARNING("Package trailer not found at the position informed by its content size. Discarding package header.");
+            receive_buffer->start += sizeof(uint32_t);
+            discarded += sizeof(uint32_t);
+            continue;
+        }
+
+        LOG_TRACE("Found a package with %zu byte(s).", package_size);
+        byte_array->data = package_start;
+        byte_array->size = package_size;
+
+        receive_buffer->start += package_size;
+        extraction_concluded = true;
+        result = SUCCESS;
+    }
+
+    if ( discarded > 0 ) {
+        LOG_WARNING("%zu byte(s) discarded while searching for a package.", discarded);
+    }
+
+    if ( receive_buffer->start == receive_buffer->end ) {
+        LOG_TRACE_POINT;
+        receive_buffer->start = 0;
+        receive_buffer->end = 0;
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Reads the content available on a socket into its receive buffer.
+ *
+ * Parameters
+ *  receive_buffer - The receive buffer of the socket to be read.
  *
  * Returns
- *  SUCCESS - If a content was successfully read from socket.
+ *  SUCCESS - If content was read from the socket.
  *  NO_CONTENT_TO_READ - If there was no content to read from socket.
  *  DEVICE_DISCONNECTED - When the connection was lost.
  *  GENERIC_ERROR - If there was an error reading the socket.
  */
-int read_socket_content(int socket_fd, byte_array_t* byte_array) {
-    LOG_TRACE("Socket file descriptor: %d", socket_fd);
+int fill_receive_buffer(receive_buffer_t* receive_buffer) {
+    LOG_TRACE("Socket file descriptor: %d", receive_buffer->socket_fd);
 
     int result;
-    struct timeval read_wait_time = _read_wait_time;
-    int select_result;
-    uint8_t buffer[READ_CONTENT_BUFFER_SIZE];
-    uint32_t* array_pointer = (uint32_t*)buffer;
-    ssize_t content_size = 0;
+    int check_socket_content_result;
     ssize_t total_read;
-    bool error = false;
-    bool done_reading = false;
+    size_t buffered;
     int errno_value;
-    int copy_content_result;
-
-    delete_byte_array(byte_array);
-    LOG_TRACE_POINT;
 
-    while (done_reading == false ) {
+    /* Moves the content not consumed yet to the beginning of the buffer. */
+    if ( receive_buffer->start > 0 ) {
         LOG_TRACE_POINT;
 
-        select_result = check_socket_content(socket_fd, read_wait_time);
-        LOG_TRACE_POINT;
+        buffered = receive_buffer->end - receive_buffer->start;
+        memmove(receive_buffer->data, receive_buffer->data + receive_buffer->start, buffered);
+        receive_buffer->start = 0;
+        receive_buffer->end = buffered;
+    }
 
-        switch (select_result) {
-            case NO_CONTENT_TO_READ:
-                LOG_TRACE("No content to be read on socket.");
-                done_reading = true;
-                result = NO_CONTENT_TO_READ;
-                break;
+    if ( receive_buffer->end >= RECEIVE_BUFFER_SIZE ) {
+        LOG_ERROR("Receive buffer is full.");
+        return GENERIC_ERROR;
+    }
 
-            case GENERIC_ERROR:
-                LOG_ERROR("Error while waiting for a content to read on socket.");
-                done_reading = true;
-                error = true;
-                result = GENERIC_ERROR;
-                break;
+    check_socket_content_result = check_socket_content(receive_buffer->socket_fd, _read_wait_time);
+    LOG_TRACE_POINT;
 
-            case CONTENT_TO_READ:
-                LOG_TRACE("There is content to read on socket.");
+    switch (check_socket_content_result) {
+        case NO_CONTENT_TO_READ:
+            LOG_TRACE("No content to be read on socket.");
+            result = NO_CONTENT_TO_READ;
+            break;
 
-                total_read = read(socket_fd, array_pointer, sizeof(uint32_t));
-                switch (total_read){
-                    case 0:
-                        LOG_ERROR("There is content available on socket, but it could not be read.");
-                        error = true;
-                        done_reading = true;
-                        result = GENERIC_ERROR;
-                        break;
+        case CONTENT_TO_READ:
+            LOG_TRACE("There is content to read on socket.");
 
-                    case -1:
-                        errno_value = errno;
+            total_read = read_transport(receive_buffer->socket_fd, receive_buffer->data + receive_buffer->end, RECEIVE_BUFFER_SIZE - receive_buffer->end);
+            switch (total_read) {
+                case 0:
+                    LOG_TRACE("Connection closed by the remote device.");
+                    result = DEVICE_DISCONNECTED;
+                    break;
+
+                case -1:
+                    errno_value = errno;
+
+                    if ( errno_value == EAGAIN || errno_value == EINTR ) {
+                        LOG_TRACE_POINT;
+                        result = NO_CONTENT_TO_READ;
+                    }
+                    else {
                         LOG_ERROR("Error while reading socket content.");
                         LOG_ERROR("%d: %s", errno_value, strerror(errno_value));
+
                         /* Check if the error code returned is informing that the connection was reseted by the peer. */
                         if  ( errno_value == ERROR_CODE_CONNECTION_RESET_BY_PEER ) {
                             LOG_TRACE_POINT;
@@ -201,51 +421,235 @@ int read_socket_content(int socket_fd, byte_array_t* byte_array) {
                             LOG_TRACE_POINT;
                             result = GENERIC_ERROR;
                         }
+                    }
+                    break;
+
+                default:
+                    LOG_TRACE("%zd byte(s) read from socket.", total_read);
+                    receive_buffer->end += total_read;
+                    result = SUCCESS;
+                    break;
+            }
+            break;
 
-                        error = true;
-                        done_reading = true;
-                        break;
+        case GENERIC_ERROR:
+            LOG_ERROR("Error while waiting for a content to read on socket.");
+            result = GENERIC_ERROR;
+            break;
 
-                    default:
-                        LOG_TRACE_POINT;
-                        content_size += total_read;
-                        if ( *array_pointer == PACKAGE_TRAILER ) {
-                            LOG_TRACE("Found a package trailer.");
-                            done_reading = true;
-                            result = SUCCESS;
-                        }
-                        array_pointer = (uint32_t*)(buffer+content_size);
-                        break;
+        default:
+            LOG_ERROR("Unkown return code from \"check_socket_content\" function.");
+            result = GENERIC_ERROR;
+            break;
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Returns the receive buffer of a socket.
+ *
+ * Parameters
+ *  socket_fd - The socket communication file descriptor.
+ *
+ * Returns
+ *  The receive buffer of the socket, or NULL if there was an error creating it.
+ *
+ * Observations
+ *  The receive buffer is created on the first call for a socket and released when it is closed through "close_socket" function.
+ */
+receive_buffer_t* get_receive_buffer(int socket_fd) {
+    LOG_TRACE_POINT;
+
+    int counter;
+    receive_buffer_t* free_receive_buffer = NULL;
+
+    for ( counter = 0; counter < MAXIMUM_RECEIVE_BUFFERS; counter++ ) {
+        if ( _receive_buffers[counter].in_use == true ) {
+            if ( _receive_buffers[counter].socket_fd == socket_fd ) {
+                LOG_TRACE_POINT;
+                return &_receive_buffers[counter];
+            }
+        }
+        else {
+            if ( free_receive_buffer == NULL ) {
+                free_receive_buffer = &_receive_buffers[counter];
+            }
+        }
+    }
+
+    if ( free_receive_buffer == NULL ) {
+        LOG_ERROR("There are no receive buffers available for socket %d.", socket_fd);
+        return NULL;
+    }
+
+    free_receive_buffer->data = (uint8_t*)malloc(RECEIVE_BUFFER_SIZE*sizeof(uint8_t));
+    if ( free_receive_buffer->data == NULL ) {
+        LOG_ERROR("Could not allocate %zu bytes to receive content from socket.", RECEIVE_BUFFER_SIZE);
+        return NULL;
+    }
+
+    free_receive_buffer->socket_fd = socket_fd;
+    free_receive_buffer->start = 0;
+    free_receive_buffer->end = 0;
+    free_receive_buffer->in_use = true;
+
+    LOG_TRACE_POINT;
+    return free_receive_buffer;
+}
+
+/*
+ * Reads a package from a socket.
+ *
+ * Parameters
+ *  socket_fd - The socket communication file descriptor to read content.
+ *  byte_array - The structure to store the package read from socket.
+ *
+ * Returns
+ *  SUCCESS - If a package was successfully read from socket.
+ *  NO_CONTENT_TO_READ - If there was no complete package to read from socket.
+ *  DEVICE_DISCONNECTED - When the connection was lost.
+ *  GENERIC_ERROR - If there was an error reading the socket.
+ *
+ * Observations
+ *  The package is copied from the receive buffer, so the byte array must be deleted through "delete_byte_array" function. To read a package without copying it, use "read_socket_package" function.
+ */
+int read_socket_content(int socket_fd, byte_array_t* byte_array) {
+    LOG_TRACE("Socket file descriptor: %d", socket_fd);
+
+    int result;
+    byte_array_t package_byte_array;
+    int read_socket_package_result;
+
+    delete_byte_array(byte_array);
+    LOG_TRACE_POINT;
+
+    read_socket_package_result = read_socket_package(socket_fd, &package_byte_array);
+    LOG_TRACE_POINT;
+
+    switch (read_socket_package_result) {
+        case SUCCESS:
+            LOG_TRACE_POINT;
+
+            if ( copy_content_to_byte_array(byte_array, package_byte_array.data, package_byte_array.size) == SUCCESS ) {
+                LOG_TRACE_POINT;
+                result = SUCCESS;
+            }
+            else {
+                LOG_ERROR("Could not copy package from receive buffer.");
+                result = GENERIC_ERROR;
+            }
+            break;
+
+        default:
+            LOG_TRACE_POINT;
+            result = read_socket_package_result;
+            break;
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Reads a package from a socket without copying it.
+ *
+ * Parameters
+ *  socket_fd - The socket communication file descriptor to read content.
+ *  byte_array - The structure to store the position and size of the package read.
+ *
+ * Returns
+ *  SUCCESS - If a package was successfully read from socket.
+ *  NO_CONTENT_TO_READ - If there was no complete package to read from socket.
+ *  DEVICE_DISCONNECTED - When the connection was lost.
+ *  GENERIC_ERROR - If there was an error reading the socket.
+ *
+ * Observations
+ *  Content is read from socket in large blocks and kept on a receive buffer until a complete package is available. The content of an incomplete package is kept for the next call.
+ *  The byte array points to the socket receive buffer. It is valid until the next read or close of the socket and must not be deleted.
+ */
+int read_socket_package(int socket_fd, byte_array_t* byte_array) {
+    LOG_TRACE("Socket file descriptor: %d", socket_fd);
+
+    int result;
+    bool done_reading = false;
+    receive_buffer_t* receive_buffer;
+    int extract_result;
+    int fill_result;
+
+    receive_buffer = get_receive_buffer(socket_fd);
+    LOG_TRACE_POINT;
+
+    if ( receive_buffer == NULL ) {
+        LOG_ERROR("Could not retrieve the receive buffer of socket %d.", socket_fd);
+        return GENERIC_ERROR;
+    }
+
+    while ( done_reading == false ) {
+        LOG_TRACE_POINT;
+
+        extract_result = extract_package_from_receive_buffer(receive_buffer, byte_array);
+        LOG_TRACE_POINT;
+
+        switch (extract_result) {
+            case SUCCESS:
+                LOG_TRACE("Package read from socket.");
+                done_reading = true;
+                result = SUCCESS;
+                break;
+
+            case NO_CONTENT_TO_READ:
+                LOG_TRACE_POINT;
+
+                fill_result = fill_receive_buffer(receive_buffer);
+                LOG_TRACE_POINT;
+
+                if ( fill_result != SUCCESS ) {
+                    LOG_TRACE_POINT;
+                    done_reading = true;
+                    result = fill_result;
                 }
-                LOG_TRACE("Content size: %zu byte(s).", content_size);
                 break;
 
             default:
-                LOG_ERROR("Unkown return code from \"check_socket_content\" function.");
-                error = true;
+                LOG_ERROR("Error while extracting package from receive buffer.");
+                done_reading = true;
+                result = GENERIC_ERROR;
                 break;
         }
     }
 
-    if ( error == true ) {
-        LOG_TRACE_POINT;
+    LOG_TRACE_POINT;
+    return result;
+}
 
-        delete_byte_array(byte_array);
-        LOG_TRACE_POINT;
-    } else {
-        copy_content_result = copy_content_to_byte_array(byte_array, buffer, content_size);
-        LOG_TRACE_POINT;
+/*
+ * Releases the receive buffer of a socket.
+ *
+ * Parameters
+ *  socket_fd - The socket communication file descriptor.
+ *
+ * Returns
+ *  SUCCESS - If the receive buffer was released or the socket did not have one.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int release_receive_buffer(int socket_fd) {
+    LOG_TRACE_POINT;
 
-        if ( copy_content_result != SUCCESS ) {
-            delete_byte_array(byte_array);
-            LOG_TRACE_POINT;
+    int counter;
 
-            result = GENERIC_ERROR;
+    for ( counter = 0; counter < MAXIMUM_RECEIVE_BUFFERS; counter++ ) {
+        if ( _receive_buffers[counter].in_use == true && _receive_buffers[counter].socket_fd == socket_fd ) {
+            LOG_TRACE("Releasing receive buffer of socket %d.", socket_fd);
+
+            free(_receive_buffers[counter].data);
+            memset(&_receive_buffers[counter], 0, sizeof(receive_buffer_t));
         }
     }
 
     LOG_TRACE_POINT;
-    return result;
+    return SUCCESS;
 }
 
 /*
@@ -257,52 +661,142 @@ int read_socket_content(int socket_fd, byte_array_t* byte_array) {
  *
  * Returns
  *  SUCCESS - If content was written successfully.
+ *  DEVICE_DISCONNECTED - When the connection was lost.
  *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  Partial writes are continued from the byte where they stopped, so the content is never written twice on the socket.
  */
 int write_content_on_socket(int socket_fd, byte_array_t byte_array) {
     LOG_TRACE_POINT;
 
-    size_t write_result;
+    ssize_t write_result;
     size_t total_written = 0;
     bool concluded = false;
     int errno_value;
     int result = SUCCESS;
 
-    while (concluded == false ) {
+    while ( concluded == false && total_written < byte_array.size ) {
         LOG_TRACE_POINT;
 
-        write_result = write(socket_fd, byte_array.data, byte_array.size);
+        write_result = write_transport(socket_fd, byte_array.data + total_written, byte_array.size - total_written);
         switch (write_result) {
             case -1:
                 errno_value = errno;
-                LOG_ERROR("Error while writing content on socket.");
-                LOG_ERROR("%s", strerror(errno_value));
 
+                switch (errno_value) {
+                    case EINTR:
+                    case EAGAIN:
+                        LOG_TRACE_POINT;
+                        break;
+
+                    case EPIPE:
+                    case ERROR_CODE_CONNECTION_RESET_BY_PEER:
+                        LOG_TRACE("Connection lost while writing content on socket.");
+                        result = DEVICE_DISCONNECTED;
+                        concluded = true;
+                        break;
+
+                    default:
+                        LOG_ERROR("Error while writing content on socket.");
+                        LOG_ERROR("%s", strerror(errno_value));
+                        result = GENERIC_ERROR;
+                        concluded = true;
+                        break;
+                }
+                break;
+
+            case 0:
+                LOG_ERROR("The content was not written on socket.");
                 result = GENERIC_ERROR;
                 concluded = true;
                 break;
 
-            case 0:
-                LOG_TRACE_POINT;
+            default:
+                total_written += (size_t)write_result;
+                LOG_TRACE("%zu of %zu byte(s) written on socket.", total_written, byte_array.size);
+                break;
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Writes a file content on socket.
+ *
+ * Parameters
+ *  socket_fd - The socket communication file descriptor to write the content.
+ *  file_fd - The descriptor of the file to read the content.
+ *  offset - The file position to start reading the content.
+ *  size - Size of the content to be written.
+ *
+ * Returns
+ *  SUCCESS - If the content was written successfully.
+ *  DEVICE_DISCONNECTED - When the connection was lost.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The content is moved from the file to the socket by the kernel through "sendfile", without being copied to user space. If the kernel does not support it for the descriptors informed, the content is copied through a small buffer instead.
+ */
+int write_file_content_on_socket(int socket_fd, int file_fd, off_t offset, size_t size) {
+    LOG_TRACE("Socket file descriptor: %d, file descriptor: %d, offset: %jd, size: %zu.", socket_fd, file_fd, (intmax_t)offset, size);
+
+    ssize_t sendfile_result;
+    off_t current_offset = offset;
+    size_t total_written = 0;
+    int errno_value;
+    int result = SUCCESS;
+    bool concluded = false;
+
+    while ( concluded == false && total_written < size ) {
+        LOG_TRACE_POINT;
+
+        sendfile_result = sendfile(socket_fd, file_fd, &current_offset, size - total_written);
+        switch (sendfile_result) {
+            case -1:
+                errno_value = errno;
+
+                switch (errno_value) {
+                    case EINTR:
+                    case EAGAIN:
+                        LOG_TRACE_POINT;
+                        break;
+
+                    case EINVAL:
+                    case ENOSYS:
+                        LOG_TRACE("Kernel cannot send file content directly to socket. Copying it instead.");
+                        result = copy_file_content_to_socket(socket_fd, file_fd, current_offset, size - total_written);
+                        concluded = true;
+                        break;
+
+                    case EPIPE:
+                    case ERROR_CODE_CONNECTION_RESET_BY_PEER:
+                        LOG_TRACE("Connection lost while sending file content.");
+                        result = DEVICE_DISCONNECTED;
+                        concluded = true;
+                        break;
 
-                if ( byte_array.size != 0 ) {
-                    LOG_ERROR("The content was not written on socket.");
-                    result = GENERIC_ERROR;
-                    concluded = true;
+                    default:
+                        LOG_ERROR("Error while sending file content on socket.");
+                        LOG_ERROR("%s", strerror(errno_value));
+                        result = GENERIC_ERROR;
+                        concluded = true;
+                        break;
                 }
                 break;
 
-            default:
-                LOG_TRACE("%zu byte(s) written on socket.", write_result);
+            case 0:
+                LOG_ERROR("File ended before the content requested could be sent.");
+                result = GENERIC_ERROR;
+                concluded = true;
                 break;
-        }
 
-        total_written += write_result;
-        LOG_TRACE("%zu of %zu byte(s) written on socket.", total_written, byte_array.size);
-        if ( total_written >= byte_array.size ) {
-            LOG_TRACE_POINT;
-            concluded = true;
-            result = SUCCESS;
+            default:
+                total_written += sendfile_result;
+                LOG_TRACE("%zu of %zu byte(s) of file content written on socket.", total_written, size);
+                break;
         }
     }
 
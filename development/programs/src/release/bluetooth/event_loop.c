@@ -0,0 +1,367 @@
+/*
+ * This source file contains the elaboration of all components required to wait for socket events and deadlines.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bluetooth/event_loop.h"
+#include "log.h"
+#include "return_codes.h"
+#include "timing.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Maximum number of sockets which can have an event loop at the same time. */
+#define MAXIMUM_EVENT_LOOPS 4
+
+/* Maximum number of events returned on each wait (the socket and its deadline timer). */
+#define MAXIMUM_EVENTS 2
+
+
+/*
+ * Structures.
+ */
+
+/* Stores the descriptors used to wait for events of a socket. */
+typedef struct {
+    bool in_use;
+    int socket_fd;
+    int epoll_fd;
+    int timer_fd;
+    uint32_t events;
+} event_loop_t;
+
+
+/*
+ * Variables.
+ */
+
+/* Event loops of the sockets being waited. */
+event_loop_t _event_loops[MAXIMUM_EVENT_LOOPS];
+
+
+/*
+ * Function headers.
+ */
+
+/* Defines the deadline of an event loop. */
+int define_event_loop_deadline(event_loop_t*, uint64_t);
+
+/* Defines the socket events waited by an event loop. */
+int define_event_loop_events(event_loop_t*, uint32_t);
+
+/* Returns the event loop of a socket. */
+event_loop_t* get_event_loop(int);
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Defines the deadline of an event loop.
+ *
+ * Parameters
+ *  event_loop - The event loop to define the deadline.
+ *  deadline - The monotonic time (in milliseconds) which the deadline will be reached.
+ *
+ * Returns
+ *  SUCCESS - If the deadline was defined successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Defining a new deadline also discards any expiration of the previous one which was not consumed yet. A deadline already reached expires immediately.
+ */
+int define_event_loop_deadline(event_loop_t* event_loop, uint64_t deadline) {
+    LOG_TRACE("Deadline: %llu.", (unsigned long long)deadline);
+
+    struct itimerspec timer_specification;
+
+    memset(&timer_specification, 0, sizeof(struct itimerspec));
+    timer_specification.it_value.tv_sec = deadline/1000;
+    timer_specification.it_value.tv_nsec = (deadline%1000)*1000000;
+
+    /* An "it_value" of zero would disarm the timer instead of expiring it. */
+    if ( timer_specification.it_value.tv_sec == 0 && timer_specification.it_value.tv_nsec == 0 ) {
+        timer_specification.it_value.tv_nsec = 1;
+    }
+
+    if ( timerfd_settime(event_loop->timer_fd, TFD_TIMER_ABSTIME, &timer_specification, NULL) == -1 ) {
+        LOG_ERROR("Could not define event loop deadline.");
+        LOG_ERROR("%s", strerror(errno));
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Defines the socket events waited by an event loop.
+ *
+ * Parameters
+ *  event_loop - The event loop to define the events.
+ *  events - The socket events to be waited.
+ *
+ * Returns
+ *  SUCCESS - If the events were defined successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int define_event_loop_events(event_loop_t* event_loop, uint32_t events) {
+    LOG_TRACE("Events: 0x%x.", events);
+
+    struct epoll_event epoll_event;
+
+    if ( event_loop->events == events ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    memset(&epoll_event, 0, sizeof(struct epoll_event));
+    epoll_event.events = events;
+    epoll_event.data.fd = event_loop->socket_fd;
+
+    if ( epoll_ctl(event_loop->epoll_fd, EPOLL_CTL_MOD, event_loop->socket_fd, &epoll_event) == -1 ) {
+        LOG_ERROR("Could not define the events waited on socket %d.", event_loop->socket_fd);
+        LOG_ERROR("%s", strerror(errno));
+        return GENERIC_ERROR;
+    }
+
+    event_loop->events = events;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the event loop of a socket.
+ *
+ * Parameters
+ *  socket_fd - The socket file descriptor.
+ *
+ * Returns
+ *  The event loop of the socket or NULL if it was not possible to create it.
+ *
+ * Observations
+ *  If the socket does not have an event loop yet, a new one is created. It must be released through "release_event_loop" function when the socket is closed.
+ */
+event_loop_t* get_event_loop(int socket_fd) {
+    LOG_TRACE_POINT;
+
+    int counter;
+    event_loop_t* free_event_loop = NULL;
+    struct epoll_event epoll_event;
+
+    for ( counter = 0; counter < MAXIMUM_EVENT_LOOPS; counter++ ) {
+        if ( _event_loops[counter].in_use == true ) {
+            if ( _event_loops[counter].socket_fd == socket_fd ) {
+                LOG_TRACE_POINT;
+                return &_event_loops[counter];
+            }
+        }
+        else {
+            if ( free_event_loop == NULL ) {
+                free_event_loop = &_event_loops[counter];
+            }
+        }
+    }
+
+    if ( free_event_loop == NULL ) {
+        LOG_ERROR("There are no event loops available for socket %d.", socket_fd);
+        return NULL;
+    }
+
+    free_event_loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if ( free_event_loop->epoll_fd == -1 ) {
+        LOG_ERROR("Could not create event loop for socket %d.", socket_fd);
+        LOG_ERROR("%s", strerror(errno));
+        return NULL;
+    }
+
+    free_event_loop->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if ( free_event_loop->timer_fd == -1 ) {
+        LOG_ERROR("Could not create deadline timer for socket %d.", socket_fd);
+        LOG_ERROR("%s", strerror(errno));
+        close(free_event_loop->epoll_fd);
+        return NULL;
+    }
+
+    memset(&epoll_event, 0, sizeof(struct epoll_event));
+    epoll_event.events = EPOLLIN;
+    epoll_event.data.fd = free_event_loop->timer_fd;
+
+    if ( epoll_ctl(free_event_loop->epoll_fd, EPOLL_CTL_ADD, free_event_loop->timer_fd, &epoll_event) == -1 ) {
+        LOG_ERROR("Could not add deadline timer to event loop of socket %d.", socket_fd);
+        LOG_ERROR("%s", strerror(errno));
+        close(free_event_loop->timer_fd);
+        close(free_event_loop->epoll_fd);
+        return NULL;
+    }
+
+    memset(&epoll_event, 0, sizeof(struct epoll_event));
+    epoll_event.events = SOCKET_EVENT_READ;
+    epoll_event.data.fd = socket_fd;
+
+    if ( epoll_ctl(free_event_loop->epoll_fd, EPOLL_CTL_ADD, socket_fd, &epoll_event) == -1 ) {
+        LOG_ERROR("Could not add socket %d to its event loop.", socket_fd);
+        LOG_ERROR("%s", strerror(errno));
+        close(free_event_loop->timer_fd);
+        close(free_event_loop->epoll_fd);
+        return NULL;
+    }
+
+    free_event_loop->socket_fd = socket_fd;
+    free_event_loop->events = SOCKET_EVENT_READ;
+    free_event_loop->in_use = true;
+
+    LOG_TRACE_POINT;
+    return free_event_loop;
+}
+
+/*
+ * Returns the current monotonic time in milliseconds.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The current monotonic time in milliseconds.
+ *
+ * Observations
+ *  Deadlines informed to "wait_socket_event" function must be based on this time.
+ */
+uint64_t get_event_loop_time() {
+    return get_monotonic_time()/NANOSECONDS_PER_MILLISECOND;
+}
+
+/*
+ * Releases the event loop of a socket.
+ *
+ * Parameters
+ *  socket_fd - The socket file descriptor.
+ *
+ * Returns
+ *  SUCCESS - This function always returns SUCCESS.
+ */
+int release_event_loop(int socket_fd) {
+    LOG_TRACE_POINT;
+
+    int counter;
+
+    for ( counter = 0; counter < MAXIMUM_EVENT_LOOPS; counter++ ) {
+        if ( _event_loops[counter].in_use == true && _event_loops[counter].socket_fd == socket_fd ) {
+            LOG_TRACE("Releasing event loop of socket %d.", socket_fd);
+
+            close(_event_loops[counter].timer_fd);
+            close(_event_loops[counter].epoll_fd);
+            memset(&_event_loops[counter], 0, sizeof(event_loop_t));
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Waits until an event occurs on a socket or a deadline is reached.
+ *
+ * Parameters
+ *  socket_fd - The socket file descriptor.
+ *  events - The socket events to be waited ("SOCKET_EVENT_READ" and/or "SOCKET_EVENT_WRITE").
+ *  deadline - The monotonic time (in milliseconds) to stop waiting, based on "get_event_loop_time" function.
+ *
+ * Returns
+ *  SOCKET_EVENT_OCCURRED - If an event requested occurred on socket.
+ *  DEADLINE_REACHED - If the deadline was reached before an event occurred on socket.
+ *  GENERIC_ERROR - If there was an error while waiting.
+ *
+ * Observations
+ *  An error or a hang up on socket is also reported as SOCKET_EVENT_OCCURRED, so the caller can identify it on its next read or write.
+ */
+int wait_socket_event(int socket_fd, uint32_t events, uint64_t deadline) {
+    LOG_TRACE("Socket: %d, events: 0x%x, deadline: %llu.", socket_fd, events, (unsigned long long)deadline);
+
+    int result;
+    bool wait_concluded = false;
+    event_loop_t* event_loop;
+    struct epoll_event epoll_events[MAXIMUM_EVENTS];
+    uint64_t expirations;
+    int events_received;
+    int counter;
+
+    event_loop = get_event_loop(socket_fd);
+    if ( event_loop == NULL ) {
+        LOG_ERROR("Could not get the event loop of socket %d.", socket_fd);
+        return GENERIC_ERROR;
+    }
+
+    if ( define_event_loop_events(event_loop, events) != SUCCESS ) {
+        LOG_ERROR("Could not define the events to wait on socket %d.", socket_fd);
+        return GENERIC_ERROR;
+    }
+
+    if ( define_event_loop_deadline(event_loop, deadline) != SUCCESS ) {
+        LOG_ERROR("Could not define the deadline to wait on socket %d.", socket_fd);
+        return GENERIC_ERROR;
+    }
+
+    while ( wait_concluded == false ) {
+        LOG_TRACE_POINT;
+
+        events_received = epoll_wait(event_loop->epoll_fd, epoll_events, MAXIMUM_EVENTS, -1);
+
+        if ( events_received == -1 ) {
+            if ( errno == EINTR ) {
+                LOG_TRACE_POINT;
+                continue;
+            }
+
+            LOG_ERROR("Error while waiting for events on socket %d.", socket_fd);
+            LOG_ERROR("%s", strerror(errno));
+            result = GENERIC_ERROR;
+            wait_concluded = true;
+            break;
+        }
+
+        /* The socket event is checked first, so content which arrives along with the deadline is not lost. */
+        for ( counter = 0; counter < events_received; counter++ ) {
+            if ( epoll_events[counter].data.fd == socket_fd ) {
+                LOG_TRACE("Event 0x%x occurred on socket %d.", epoll_events[counter].events, socket_fd);
+                result = SOCKET_EVENT_OCCURRED;
+                wait_concluded = true;
+            }
+        }
+
+        if ( wait_concluded == false ) {
+            LOG_TRACE_POINT;
+
+            if ( read(event_loop->timer_fd, &expirations, sizeof(uint64_t)) == sizeof(uint64_t) ) {
+                LOG_TRACE("Deadline reached on socket %d.", socket_fd);
+                result = DEADLINE_REACHED;
+                wait_concluded = true;
+            }
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
@@ -0,0 +1,248 @@
+/*
+ * This source file contains the elaboration of all components required to create and manipulate "audio catalog page" package contents.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bluetooth/package/content/audio_catalog_page.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Converts a byte array to an "audio catalog page" package content.
+ *
+ * Parameters
+ *  audio_catalog_page_content - The variable where the "audio catalog page" package content will be stored.
+ *  byte_array - The byte array with information of the "audio catalog page" package content.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was converted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int convert_byte_array_to_audio_catalog_page_content(audio_catalog_page_content_t* audio_catalog_page_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    audio_catalog_page_content_t decoded_audio_catalog_page_content;
+    size_t records_size;
+    uint8_t* records_data;
+
+    if ( decode_audio_catalog_page_content(&decoded_audio_catalog_page_content, byte_array) != SUCCESS ) {
+        LOG_ERROR("Could not decode the \"audio catalog page\" package content.");
+        return GENERIC_ERROR;
+    }
+
+    records_size = (size_t)decoded_audio_catalog_page_content.records_count*AUDIO_CATALOG_RECORD_SIZE;
+    records_data = (uint8_t*)malloc(( records_size > 0 ? records_size : 1 )*sizeof(uint8_t));
+    if ( records_data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"audio catalog page\" package content.");
+        return GENERIC_ERROR;
+    }
+    memcpy(records_data, decoded_audio_catalog_page_content.records_data, records_size);
+
+    memcpy(audio_catalog_page_content, &decoded_audio_catalog_page_content, sizeof(audio_catalog_page_content_t));
+    audio_catalog_page_content->records_data = records_data;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Creates an "audio catalog page" package content.
+ *
+ * Parameters
+ *  next_record_id - ID of the first audio record of the next page. Zero if there are no more audio records.
+ *  records_count - Number of audio records on the page.
+ *  audio_catalog_records - The audio records of the page.
+ *
+ * Returns
+ *  An "audio catalog page" package content with the informations provided.
+ */
+audio_catalog_page_content_t* create_audio_catalog_page_content(uint32_t next_record_id, uint32_t records_count, const audio_catalog_record_t* audio_catalog_records){
+    LOG_TRACE("Next record ID: %u, records count: %u.", next_record_id, records_count);
+
+    audio_catalog_page_content_t* audio_catalog_page_content;
+    size_t records_size;
+
+    records_size = (size_t)records_count*AUDIO_CATALOG_RECORD_SIZE;
+
+    audio_catalog_page_content = (audio_catalog_page_content_t*)malloc(sizeof(audio_catalog_page_content_t));
+    audio_catalog_page_content->next_record_id = next_record_id;
+    audio_catalog_page_content->records_count = records_count;
+    audio_catalog_page_content->records_data = (uint8_t*)malloc(( records_size > 0 ? records_size : 1 )*sizeof(uint8_t));
+    memcpy(audio_catalog_page_content->records_data, audio_catalog_records, records_size);
+
+    LOG_TRACE_POINT;
+    return audio_catalog_page_content;
+}
+
+/*
+ * Creates a byte array containing the "audio catalog page" package content.
+ *
+ * Parameters
+ *  audio_catalog_page_content - The "audio catalog page" package content with the informations to build the byte array.
+ *
+ * Returns
+ *  A byte array structure with the audio catalog page package content informations.
+ */
+byte_array_t create_audio_catalog_page_content_byte_array(audio_catalog_page_content_t audio_catalog_page_content) {
+    LOG_TRACE_POINT;
+
+    byte_array_t byte_array;
+
+    byte_array.size = get_audio_catalog_page_content_size(audio_catalog_page_content);
+    byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"audio catalog page\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
+
+    encode_audio_catalog_page_content(byte_array.data, audio_catalog_page_content);
+
+    LOG_TRACE_POINT;
+    return byte_array;
+}
+
+/*
+ * Decodes a byte array to an "audio catalog page" package content without allocating memory.
+ *
+ * Parameters
+ *  audio_catalog_page_content - The variable where the "audio catalog page" package content will be stored.
+ *  byte_array - The byte array with the "audio catalog page" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  The "records_data" field of the content points to the byte array informed, so it is only valid while the byte array is. The content decoded must not be deleted.
+ */
+int decode_audio_catalog_page_content(audio_catalog_page_content_t* audio_catalog_page_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+
+    content_size = 2*sizeof(uint32_t);
+    if ( byte_array.size < content_size ) {
+        LOG_ERROR("The byte array size does not match an audio catalog page content.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&audio_catalog_page_content->next_record_id, byte_array.data, sizeof(uint32_t));
+    memcpy(&audio_catalog_page_content->records_count, byte_array.data + sizeof(uint32_t), sizeof(uint32_t));
+
+    if ( audio_catalog_page_content->records_count > AUDIO_CATALOG_PAGE_MAXIMUM_RECORDS ) {
+        LOG_ERROR("The audio catalog page has more records than allowed.");
+        return GENERIC_ERROR;
+    }
+
+    content_size += (size_t)audio_catalog_page_content->records_count*AUDIO_CATALOG_RECORD_SIZE;
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The records count informed on byte array does not match its size.");
+        return GENERIC_ERROR;
+    }
+
+    audio_catalog_page_content->records_data = byte_array.data + 2*sizeof(uint32_t);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Deletes an "audio catalog page" package content.
+ *
+ * Parameters
+ *  audio_catalog_page_content - The "audio catalog page" package content to be deleted.
+ *
+ * Returns
+ *  SUCCESS - If the content was deleted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int delete_audio_catalog_page_content(audio_catalog_page_content_t* audio_catalog_page_content) {
+    LOG_TRACE_POINT;
+
+    free(audio_catalog_page_content->records_data);
+    free(audio_catalog_page_content);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Encodes an "audio catalog page" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_audio_catalog_page_content_size" function.
+ *  audio_catalog_page_content - The "audio catalog page" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_audio_catalog_page_content(uint8_t* buffer, audio_catalog_page_content_t audio_catalog_page_content) {
+    LOG_TRACE_POINT;
+
+    memcpy(buffer, &audio_catalog_page_content.next_record_id, sizeof(uint32_t));
+    memcpy(buffer + sizeof(uint32_t), &audio_catalog_page_content.records_count, sizeof(uint32_t));
+    memcpy(buffer + 2*sizeof(uint32_t), audio_catalog_page_content.records_data, (size_t)audio_catalog_page_content.records_count*AUDIO_CATALOG_RECORD_SIZE);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Reads an audio record of an "audio catalog page" package content.
+ *
+ * Parameters
+ *  audio_catalog_page_content - The "audio catalog page" package content.
+ *  position - Position of the audio record on the page.
+ *  audio_catalog_record - The variable where the audio record will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the audio record was read successfully.
+ *  GENERIC_ERROR - If there is no audio record on the position informed.
+ *
+ * Observations
+ *  The audio records are copied from the content, so they can be read even if the content is not aligned.
+ */
+int get_audio_catalog_page_record(audio_catalog_page_content_t audio_catalog_page_content, uint32_t position, audio_catalog_record_t* audio_catalog_record) {
+    LOG_TRACE("Position: %u.", position);
+
+    if ( position >= audio_catalog_page_content.records_count ) {
+        LOG_ERROR("There is no audio record on position %u of the audio catalog page.", position);
+        return GENERIC_ERROR;
+    }
+
+    memcpy(audio_catalog_record, audio_catalog_page_content.records_data + (size_t)position*AUDIO_CATALOG_RECORD_SIZE, AUDIO_CATALOG_RECORD_SIZE);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of an "audio catalog page" package content when encoded.
+ *
+ * Parameters
+ *  audio_catalog_page_content - The "audio catalog page" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_audio_catalog_page_content_size(audio_catalog_page_content_t audio_catalog_page_content) {
+    return 2*sizeof(uint32_t) + (size_t)audio_catalog_page_content.records_count*AUDIO_CATALOG_RECORD_SIZE;
+}
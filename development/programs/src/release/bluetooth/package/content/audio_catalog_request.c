@@ -0,0 +1,174 @@
+/*
+ * This source file contains the elaboration of all components required to create and manipulate "audio catalog request" package contents.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+
+#include "bluetooth/package/content/audio_catalog_request.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Converts a byte array to a "audio catalog request" package content.
+ *
+ * Parameters
+ *  audio_catalog_request_content - The variable where the "audio catalog request" package content will be stored.
+ *  byte_array - The byte array with information of the "audio catalog request" package content.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was converted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int convert_byte_array_to_audio_catalog_request_content(audio_catalog_request_content_t* audio_catalog_request_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    return decode_audio_catalog_request_content(audio_catalog_request_content, byte_array);
+}
+
+/*
+ * Creates a "audio catalog request" package content.
+ *
+ * Parameters
+ *  first_record_id - ID of the first audio record to be listed. Zero lists from the first audio record.
+ *  records_count - Maximum number of audio records to be listed.
+ *
+ * Returns
+ *  A "audio catalog request" package content with the informations provided.
+ */
+audio_catalog_request_content_t* create_audio_catalog_request_content(uint32_t first_record_id, uint32_t records_count){
+    LOG_TRACE("First record ID: %u, records count: %u.", first_record_id, records_count);
+
+    audio_catalog_request_content_t* audio_catalog_request_content;
+
+    audio_catalog_request_content = (audio_catalog_request_content_t*)malloc(sizeof(audio_catalog_request_content_t));
+    audio_catalog_request_content->first_record_id = first_record_id;
+    audio_catalog_request_content->records_count = records_count;
+
+    LOG_TRACE_POINT;
+    return audio_catalog_request_content;
+}
+
+/*
+ * Creates a byte array containing the "audio catalog request" package content.
+ *
+ * Parameters
+ *  audio_catalog_request_content - The "audio catalog request" package content with the informations to build the byte array.
+ *
+ * Returns
+ *  A byte array structure with the audio catalog request package content informations.
+ */
+byte_array_t create_audio_catalog_request_content_byte_array(audio_catalog_request_content_t audio_catalog_request_content) {
+    LOG_TRACE_POINT;
+
+    byte_array_t byte_array;
+
+    byte_array.size = get_audio_catalog_request_content_size(audio_catalog_request_content);
+    byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"audio catalog request\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
+
+    encode_audio_catalog_request_content(byte_array.data, audio_catalog_request_content);
+
+    LOG_TRACE_POINT;
+    return byte_array;
+}
+
+/*
+ * Decodes a byte array to a "audio catalog request" package content without allocating memory.
+ *
+ * Parameters
+ *  audio_catalog_request_content - The variable where the "audio catalog request" package content will be stored.
+ *  byte_array - The byte array with the "audio catalog request" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int decode_audio_catalog_request_content(audio_catalog_request_content_t* audio_catalog_request_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+
+    content_size = sizeof(uint32_t);
+    content_size += sizeof(uint32_t);
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The byte array size does not match a audio catalog request content.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&audio_catalog_request_content->first_record_id, byte_array.data, sizeof(uint32_t));
+    memcpy(&audio_catalog_request_content->records_count, byte_array.data + sizeof(uint32_t), sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Deletes a "audio catalog request" package content.
+ *
+ * Parameters
+ *  audio_catalog_request_content - The "audio catalog request" package content to be deleted.
+ *
+ * Returns
+ *  SUCCESS - If the content was deleted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int delete_audio_catalog_request_content(audio_catalog_request_content_t* audio_catalog_request_content) {
+    LOG_TRACE_POINT;
+
+    free(audio_catalog_request_content);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Encodes a "audio catalog request" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_audio_catalog_request_content_size" function.
+ *  audio_catalog_request_content - The "audio catalog request" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_audio_catalog_request_content(uint8_t* buffer, audio_catalog_request_content_t audio_catalog_request_content) {
+    LOG_TRACE_POINT;
+
+    memcpy(buffer, &audio_catalog_request_content.first_record_id, sizeof(uint32_t));
+    memcpy(buffer + sizeof(uint32_t), &audio_catalog_request_content.records_count, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a "audio catalog request" package content when encoded.
+ *
+ * Parameters
+ *  audio_catalog_request_content - The "audio catalog request" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_audio_catalog_request_content_size(audio_catalog_request_content_t audio_catalog_request_content) {
+    return 2*sizeof(uint32_t);
+}
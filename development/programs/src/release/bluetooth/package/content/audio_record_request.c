@@ -0,0 +1,169 @@
+/*
+ * This source file contains the elaboration of all components required to create and manipulate "audio record request" package contents.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+
+#include "bluetooth/package/content/audio_record_request.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Converts a byte array to an "audio record request" package content.
+ *
+ * Parameters
+ *  audio_record_request_content - The variable where the "audio record request" package content will be stored.
+ *  byte_array - The byte array with information of the "audio record request" package content.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was converted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int convert_byte_array_to_audio_record_request_content(audio_record_request_content_t* audio_record_request_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    return decode_audio_record_request_content(audio_record_request_content, byte_array);
+}
+
+/*
+ * Creates an "audio record request" package content.
+ *
+ * Parameters
+ *  record_id - ID of the audio record on the catalog.
+ *
+ * Returns
+ *  An "audio record request" package content with the audio record ID informed.
+ */
+audio_record_request_content_t* create_audio_record_request_content(uint32_t record_id){
+    LOG_TRACE("Record ID: %u.", record_id);
+
+    audio_record_request_content_t* audio_record_request_content;
+
+    audio_record_request_content = (audio_record_request_content_t*)malloc(sizeof(audio_record_request_content_t));
+    audio_record_request_content->record_id = record_id;
+
+    LOG_TRACE_POINT;
+    return audio_record_request_content;
+}
+
+/*
+ * Creates a byte array containing the "audio record request" package content.
+ *
+ * Parameters
+ *  audio_record_request_content - The "audio record request" package content with the informations to build the byte array.
+ *
+ * Returns
+ *  A byte array structure with the audio record request package content informations.
+ */
+byte_array_t create_audio_record_request_content_byte_array(audio_record_request_content_t audio_record_request_content) {
+    LOG_TRACE_POINT;
+
+    byte_array_t byte_array;
+
+    byte_array.size = get_audio_record_request_content_size(audio_record_request_content);
+    byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"audio record request\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
+
+    encode_audio_record_request_content(byte_array.data, audio_record_request_content);
+
+    LOG_TRACE_POINT;
+    return byte_array;
+}
+
+/*
+ * Decodes a byte array to an "audio record request" package content without allocating memory.
+ *
+ * Parameters
+ *  audio_record_request_content - The variable where the "audio record request" package content will be stored.
+ *  byte_array - The byte array with the "audio record request" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int decode_audio_record_request_content(audio_record_request_content_t* audio_record_request_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+
+    content_size = sizeof(uint32_t);
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The byte array size does not match an audio record request content.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&audio_record_request_content->record_id, byte_array.data, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Deletes an "audio record request" package content.
+ *
+ * Parameters
+ *  audio_record_request_content - The "audio record request" package content to be deleted.
+ *
+ * Returns
+ *  SUCCESS - If the content was deleted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int delete_audio_record_request_content(audio_record_request_content_t* audio_record_request_content) {
+    LOG_TRACE_POINT;
+
+    free(audio_record_request_content);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Encodes an "audio record request" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_audio_record_request_content_size" function.
+ *  audio_record_request_content - The "audio record request" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_audio_record_request_content(uint8_t* buffer, audio_record_request_content_t audio_record_request_content) {
+    LOG_TRACE_POINT;
+
+    memcpy(buffer, &audio_record_request_content.record_id, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of an "audio record request" package content when encoded.
+ *
+ * Parameters
+ *  audio_record_request_content - The "audio record request" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_audio_record_request_content_size(audio_record_request_content_t audio_record_request_content) {
+    return sizeof(uint32_t);
+}
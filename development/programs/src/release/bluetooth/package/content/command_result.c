@@ -13,6 +13,7 @@
  */
 
 #include <stdlib.h>
+#include <sys/time.h>
 
 #include "bluetooth/package/content/command_result.h"
 #include "log.h"
@@ -37,25 +38,7 @@
 int convert_byte_array_to_command_result_content(command_result_content_t* command_result_content, byte_array_t byte_array) {
     LOG_TRACE_POINT;
 
-    size_t content_size;
-    uint8_t* array_pointer;
-
-    content_size = 0;
-    content_size += sizeof(uint32_t);
-    content_size += sizeof(struct timeval);
-
-    if ( byte_array.size != content_size ) {
-        LOG_ERROR("The byte array size does not match a command result content.");
-        return GENERIC_ERROR;
-    }
-
-    array_pointer = byte_array.data;
-    memcpy(&command_result_content->result_code, array_pointer, sizeof(uint32_t));
-    array_pointer += sizeof(uint32_t);
-    memcpy(&command_result_content->execution_delay, array_pointer, sizeof(struct timeval));
-
-    LOG_TRACE_POINT;
-    return SUCCESS;
+    return decode_command_result_content(command_result_content, byte_array);
 }
 
 /*
@@ -64,18 +47,20 @@ int convert_byte_array_to_command_result_content(command_result_content_t* comma
  * Parameters
  *  result_code - The command result code to be stored in the content.
  *  execution_delay - The command execution delay to be stored in the content.
+ *  pre_roll - The time of audio recorded before the command was received. Zero for commands which do not start an audio record.
  *
  * Returns
  *  A "command result" package content with the informations provided.
  */
-command_result_content_t* create_command_result_content(uint32_t result_code, struct timeval execution_delay) {
-    LOG_TRACE("Result code: 0x%x, Execution delay: %ld.%06ld.", result_code, execution_delay.tv_sec, execution_delay.tv_usec);
+command_result_content_t* create_command_result_content(uint32_t result_code, struct timeval execution_delay, struct timeval pre_roll) {
+    LOG_TRACE("Result code: 0x%x, Execution delay: %ld.%06ld, Pre-roll: %ld.%06ld.", result_code, execution_delay.tv_sec, execution_delay.tv_usec, pre_roll.tv_sec, pre_roll.tv_usec);
 
     command_result_content_t* command_result_content;
     command_result_content = (command_result_content_t*)malloc(sizeof(command_result_content_t));
 
     command_result_content->result_code = result_code;
     command_result_content->execution_delay = execution_delay;
+    command_result_content->pre_roll = pre_roll;
 
     LOG_TRACE_POINT;
     return command_result_content;
@@ -94,20 +79,65 @@ byte_array_t create_command_result_content_byte_array(command_result_content_t c
     LOG_TRACE_POINT;
 
     byte_array_t byte_array;
-    uint8_t* array_pointer;
 
-    byte_array.size = sizeof(uint32_t) + sizeof(struct timeval);
+    byte_array.size = get_command_result_content_size(command_result_content);
     byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"command result\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
 
-    array_pointer = byte_array.data;
+    encode_command_result_content(byte_array.data, command_result_content);
 
-    memcpy(array_pointer, &command_result_content.result_code, sizeof(uint32_t));
+    LOG_TRACE_POINT;
+    return byte_array;
+}
+
+/*
+ * Decodes a byte array to a "command result" package content without allocating memory.
+ *
+ * Parameters
+ *  command_result_content - The variable where the "command result" package content will be stored.
+ *  byte_array - The byte array with the "command result" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  The pre-roll is optional on the byte array. If it is not present, the pre-roll decoded is zero.
+ */
+int decode_command_result_content(command_result_content_t* command_result_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+    uint8_t* array_pointer;
+
+    content_size = 0;
+    content_size += sizeof(uint32_t);
+    content_size += sizeof(struct timeval);
+
+    if ( byte_array.size != content_size && byte_array.size != content_size + sizeof(struct timeval) ) {
+        LOG_ERROR("The byte array size does not match a command result content.");
+        return GENERIC_ERROR;
+    }
+
+    array_pointer = byte_array.data;
+    memcpy(&command_result_content->result_code, array_pointer, sizeof(uint32_t));
     array_pointer += sizeof(uint32_t);
+    memcpy(&command_result_content->execution_delay, array_pointer, sizeof(struct timeval));
+    array_pointer += sizeof(struct timeval);
 
-    memcpy(array_pointer, &command_result_content.execution_delay, sizeof(struct timeval));
+    if ( byte_array.size > content_size ) {
+        memcpy(&command_result_content->pre_roll, array_pointer, sizeof(struct timeval));
+    }
+    else {
+        timerclear(&command_result_content->pre_roll);
+    }
 
     LOG_TRACE_POINT;
-    return byte_array;
+    return SUCCESS;
 }
 
 /*
@@ -128,3 +158,48 @@ int delete_command_result_content(command_result_content_t* command_result_conte
     LOG_TRACE_POINT;
     return SUCCESS;
 }
+
+/*
+ * Encodes a "command result" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_command_result_content_size" function.
+ *  command_result_content - The "command result" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ *
+ * Observations
+ *  The pre-roll is only encoded when it is not zero, so remote devices which do not know it keep receiving the same content.
+ */
+int encode_command_result_content(uint8_t* buffer, command_result_content_t command_result_content) {
+    LOG_TRACE_POINT;
+
+    uint8_t* array_pointer = buffer;
+
+    memcpy(array_pointer, &command_result_content.result_code, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+
+    memcpy(array_pointer, &command_result_content.execution_delay, sizeof(struct timeval));
+    array_pointer += sizeof(struct timeval);
+
+    if ( timerisset(&command_result_content.pre_roll) ) {
+        memcpy(array_pointer, &command_result_content.pre_roll, sizeof(struct timeval));
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a "command result" package content when encoded.
+ *
+ * Parameters
+ *  command_result_content - The "command result" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_command_result_content_size(command_result_content_t command_result_content) {
+    return sizeof(uint32_t) + sizeof(struct timeval) + ( timerisset(&command_result_content.pre_roll) ? sizeof(struct timeval) : 0 );
+}
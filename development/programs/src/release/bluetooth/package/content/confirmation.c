@@ -37,18 +37,7 @@
 int convert_byte_array_to_confirmation_content(confirmation_content_t* confirmation_content, byte_array_t byte_array) {
     LOG_TRACE_POINT;
 
-    size_t content_size;
-
-    content_size = sizeof(uint32_t);
-    if ( byte_array.size != content_size ) {
-        LOG_ERROR("The byte array size does not match a confirmation content.");
-        return GENERIC_ERROR;
-    }
-
-    memcpy(&confirmation_content->package_id, byte_array.data, sizeof(uint32_t));
-
-    LOG_TRACE_POINT;
-    return SUCCESS;
+    return decode_confirmation_content(confirmation_content, byte_array);
 }
 
 /*
@@ -86,14 +75,48 @@ byte_array_t create_confirmation_content_byte_array(confirmation_content_t confi
 
     byte_array_t byte_array;
 
-    byte_array.size = sizeof(uint32_t);
+    byte_array.size = get_confirmation_content_size(confirmation_content);
     byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
-    memcpy(byte_array.data, &confirmation_content.package_id, sizeof(uint32_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"confirmation\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
+
+    encode_confirmation_content(byte_array.data, confirmation_content);
 
     LOG_TRACE_POINT;
     return byte_array;
 }
 
+/*
+ * Decodes a byte array to a "confirmation" package content without allocating memory.
+ *
+ * Parameters
+ *  confirmation_content - The variable where the "confirmation" package content will be stored.
+ *  byte_array - The byte array with the "confirmation" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int decode_confirmation_content(confirmation_content_t* confirmation_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+
+    content_size = sizeof(uint32_t);
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The byte array size does not match a confirmation content.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&confirmation_content->package_id, byte_array.data, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
 /*
  * Deletes a "confirmation" package content.
  *
@@ -110,3 +133,35 @@ int delete_confirmation_content(confirmation_content_t* confirmation_content) {
     LOG_TRACE_POINT;
     return SUCCESS;
 }
+
+/*
+ * Encodes a "confirmation" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_confirmation_content_size" function.
+ *  confirmation_content - The "confirmation" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_confirmation_content(uint8_t* buffer, confirmation_content_t confirmation_content) {
+    LOG_TRACE_POINT;
+
+    memcpy(buffer, &confirmation_content.package_id, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a "confirmation" package content when encoded.
+ *
+ * Parameters
+ *  confirmation_content - The "confirmation" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_confirmation_content_size(confirmation_content_t confirmation_content) {
+    return sizeof(uint32_t);
+}
@@ -42,12 +42,17 @@ int convert_byte_array_to_content(content_t* content, byte_array_t byte_array, u
     int convertion_result;
     content_t temporary_content;
 
+    temporary_content.confirmation_content = NULL;
+
     switch (package_type_code) {
         case CHECK_CONNECTION_CODE:
         case DISCONNECT_CODE:
         case REQUEST_AUDIO_FILE_CODE:
+        case REQUEST_AUDIO_SEGMENTS_CODE:
         case START_RECORD_CODE:
+        case START_STREAM_CODE:
         case STOP_RECORD_CODE:
+        case STOP_STREAM_CODE:
             LOG_TRACE_POINT;
             /* These types of package does not have content. */
             convertion_result = SUCCESS;
@@ -101,6 +106,54 @@ int convert_byte_array_to_content(content_t* content, byte_array_t byte_array, u
             LOG_TRACE_POINT;
             break;
 
+        case REQUEST_AUDIO_FILE_TAIL_CODE:
+            LOG_TRACE_POINT;
+
+            temporary_content.file_tail_content = (file_tail_content_t*)malloc(sizeof(file_tail_content_t));
+            convertion_result = convert_byte_array_to_file_tail_content(temporary_content.file_tail_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case AUDIO_CATALOG_PAGE_CODE:
+            LOG_TRACE_POINT;
+
+            temporary_content.audio_catalog_page_content = (audio_catalog_page_content_t*)malloc(sizeof(audio_catalog_page_content_t));
+            convertion_result = convert_byte_array_to_audio_catalog_page_content(temporary_content.audio_catalog_page_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case REQUEST_AUDIO_CATALOG_CODE:
+            LOG_TRACE_POINT;
+
+            temporary_content.audio_catalog_request_content = (audio_catalog_request_content_t*)malloc(sizeof(audio_catalog_request_content_t));
+            convertion_result = convert_byte_array_to_audio_catalog_request_content(temporary_content.audio_catalog_request_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case REQUEST_AUDIO_RECORD_CODE:
+            LOG_TRACE_POINT;
+
+            temporary_content.audio_record_request_content = (audio_record_request_content_t*)malloc(sizeof(audio_record_request_content_t));
+            convertion_result = convert_byte_array_to_audio_record_request_content(temporary_content.audio_record_request_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case RESUME_TRANSFER_CODE:
+            LOG_TRACE_POINT;
+
+            temporary_content.resume_transfer_content = (resume_transfer_content_t*)malloc(sizeof(resume_transfer_content_t));
+            convertion_result = convert_byte_array_to_resume_transfer_content(temporary_content.resume_transfer_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case WINDOW_SIZE_CODE:
+            LOG_TRACE_POINT;
+
+            temporary_content.window_size_content = (window_size_content_t*)malloc(sizeof(window_size_content_t));
+            convertion_result = convert_byte_array_to_window_size_content(temporary_content.window_size_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
         default:
             LOG_WARNING("Unknown package type: 0x%x.", package_type_code);
             convertion_result = GENERIC_ERROR;
@@ -109,6 +162,9 @@ int convert_byte_array_to_content(content_t* content, byte_array_t byte_array, u
 
     if ( convertion_result != SUCCESS ) {
         LOG_ERROR("Error while converting byte array to content.");
+
+        /* All content structures are stored on a single pointer of the union. */
+        free(temporary_content.confirmation_content);
         return GENERIC_ERROR;
     }
 
@@ -180,6 +236,48 @@ byte_array_t create_content_byte_array(content_t content, uint32_t package_type)
             LOG_TRACE_POINT;
             break;
 
+        case REQUEST_AUDIO_FILE_TAIL_CODE:
+            LOG_TRACE_POINT;
+
+            byte_array = create_file_tail_content_byte_array(*content.file_tail_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case AUDIO_CATALOG_PAGE_CODE:
+            LOG_TRACE_POINT;
+
+            byte_array = create_audio_catalog_page_content_byte_array(*content.audio_catalog_page_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case REQUEST_AUDIO_CATALOG_CODE:
+            LOG_TRACE_POINT;
+
+            byte_array = create_audio_catalog_request_content_byte_array(*content.audio_catalog_request_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case REQUEST_AUDIO_RECORD_CODE:
+            LOG_TRACE_POINT;
+
+            byte_array = create_audio_record_request_content_byte_array(*content.audio_record_request_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case RESUME_TRANSFER_CODE:
+            LOG_TRACE_POINT;
+
+            byte_array = create_resume_transfer_content_byte_array(*content.resume_transfer_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case WINDOW_SIZE_CODE:
+            LOG_TRACE_POINT;
+
+            byte_array = create_window_size_content_byte_array(*content.window_size_content);
+            LOG_TRACE_POINT;
+            break;
+
         default:
             LOG_ERROR("Unkown package type.");
             byte_array.size = 0;
@@ -191,6 +289,154 @@ byte_array_t create_content_byte_array(content_t content, uint32_t package_type)
     return byte_array;
 }
 
+/*
+ * Decodes a byte array to a package content without allocating memory.
+ *
+ * Parameters
+ *  content - The package content variable to store the informations obtained from the byte array.
+ *  content_storage - The variable where the content structure will be stored. The content informed points to it.
+ *  byte_array - The byte array with the package content informations.
+ *  package_type_code - The type of the package content stored by the byte array.
+ *
+ * Returns
+ *  SUCCESS - If the content was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  Variable size fields of the content (file names, error messages and file chunk data) point to the byte array informed. The content decoded must not be deleted.
+ */
+int decode_content(content_t* content, content_storage_t* content_storage, byte_array_t byte_array, uint32_t package_type_code) {
+    LOG_TRACE("Byte array size: %zu, package type: 0x%x.", byte_array.size, package_type_code);
+
+    int decode_result;
+
+    content->confirmation_content = NULL;
+
+    switch (package_type_code) {
+        case CHECK_CONNECTION_CODE:
+        case DISCONNECT_CODE:
+        case REQUEST_AUDIO_FILE_CODE:
+        case REQUEST_AUDIO_SEGMENTS_CODE:
+        case START_RECORD_CODE:
+        case START_STREAM_CODE:
+        case STOP_RECORD_CODE:
+        case STOP_STREAM_CODE:
+            LOG_TRACE_POINT;
+            /* These types of package does not have content. */
+            decode_result = SUCCESS;
+            break;
+
+        case CONFIRMATION_CODE:
+            LOG_TRACE_POINT;
+
+            content->confirmation_content = &content_storage->confirmation_content;
+            decode_result = decode_confirmation_content(content->confirmation_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case COMMAND_RESULT_CODE:
+            LOG_TRACE_POINT;
+
+            content->command_result_content = &content_storage->command_result_content;
+            decode_result = decode_command_result_content(content->command_result_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case ERROR_CODE:
+            LOG_TRACE_POINT;
+
+            content->error_content = &content_storage->error_content;
+            decode_result = decode_error_content(content->error_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case SEND_FILE_CHUNK_CODE:
+            LOG_TRACE_POINT;
+
+            content->send_file_chunk_content = &content_storage->send_file_chunk_content;
+            decode_result = decode_send_file_chunk_content(content->send_file_chunk_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case SEND_FILE_HEADER_CODE:
+            LOG_TRACE_POINT;
+
+            content->send_file_header_content = &content_storage->send_file_header_content;
+            decode_result = decode_send_file_header_content(content->send_file_header_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case SEND_FILE_TRAILER_CODE:
+            LOG_TRACE_POINT;
+
+            content->send_file_trailer_content = &content_storage->send_file_trailer_content;
+            decode_result = decode_send_file_trailer_content(content->send_file_trailer_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case REQUEST_AUDIO_FILE_TAIL_CODE:
+            LOG_TRACE_POINT;
+
+            content->file_tail_content = &content_storage->file_tail_content;
+            decode_result = decode_file_tail_content(content->file_tail_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case AUDIO_CATALOG_PAGE_CODE:
+            LOG_TRACE_POINT;
+
+            content->audio_catalog_page_content = &content_storage->audio_catalog_page_content;
+            decode_result = decode_audio_catalog_page_content(content->audio_catalog_page_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case REQUEST_AUDIO_CATALOG_CODE:
+            LOG_TRACE_POINT;
+
+            content->audio_catalog_request_content = &content_storage->audio_catalog_request_content;
+            decode_result = decode_audio_catalog_request_content(content->audio_catalog_request_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case REQUEST_AUDIO_RECORD_CODE:
+            LOG_TRACE_POINT;
+
+            content->audio_record_request_content = &content_storage->audio_record_request_content;
+            decode_result = decode_audio_record_request_content(content->audio_record_request_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case RESUME_TRANSFER_CODE:
+            LOG_TRACE_POINT;
+
+            content->resume_transfer_content = &content_storage->resume_transfer_content;
+            decode_result = decode_resume_transfer_content(content->resume_transfer_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        case WINDOW_SIZE_CODE:
+            LOG_TRACE_POINT;
+
+            content->window_size_content = &content_storage->window_size_content;
+            decode_result = decode_window_size_content(content->window_size_content, byte_array);
+            LOG_TRACE_POINT;
+            break;
+
+        default:
+            LOG_WARNING("Unknown package type: 0x%x.", package_type_code);
+            decode_result = GENERIC_ERROR;
+            break;
+    }
+
+    if ( decode_result != SUCCESS ) {
+        LOG_ERROR("Error while decoding byte array to content.");
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
 /*
  * Deletes the content of a package.
  *
@@ -204,14 +450,17 @@ byte_array_t create_content_byte_array(content_t content, uint32_t package_type)
 int delete_content(uint32_t package_type, content_t content){
     LOG_TRACE("Package type: 0x%x.", package_type);
 
-    int result;
+    int result = SUCCESS;
 
     switch(package_type) {
         case CHECK_CONNECTION_CODE:
         case DISCONNECT_CODE:
         case REQUEST_AUDIO_FILE_CODE:
+        case REQUEST_AUDIO_SEGMENTS_CODE:
         case START_RECORD_CODE:
+        case START_STREAM_CODE:
         case STOP_RECORD_CODE:
+        case STOP_STREAM_CODE:
             LOG_TRACE("This package type doesn't have a content.");
             break;
 
@@ -257,6 +506,48 @@ int delete_content(uint32_t package_type, content_t content){
             LOG_TRACE_POINT;
             break;
 
+        case REQUEST_AUDIO_FILE_TAIL_CODE:
+            LOG_TRACE_POINT;
+
+            result = delete_file_tail_content(content.file_tail_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case AUDIO_CATALOG_PAGE_CODE:
+            LOG_TRACE_POINT;
+
+            result = delete_audio_catalog_page_content(content.audio_catalog_page_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case REQUEST_AUDIO_CATALOG_CODE:
+            LOG_TRACE_POINT;
+
+            result = delete_audio_catalog_request_content(content.audio_catalog_request_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case REQUEST_AUDIO_RECORD_CODE:
+            LOG_TRACE_POINT;
+
+            result = delete_audio_record_request_content(content.audio_record_request_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case RESUME_TRANSFER_CODE:
+            LOG_TRACE_POINT;
+
+            result = delete_resume_transfer_content(content.resume_transfer_content);
+            LOG_TRACE_POINT;
+            break;
+
+        case WINDOW_SIZE_CODE:
+            LOG_TRACE_POINT;
+
+            result = delete_window_size_content(content.window_size_content);
+            LOG_TRACE_POINT;
+            break;
+
         default:
             LOG_ERROR("Unknown package type.");
             result = GENERIC_ERROR;
@@ -267,3 +558,183 @@ int delete_content(uint32_t package_type, content_t content){
     return result;
 }
 
+/*
+ * Encodes a package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_content_size" function.
+ *  content - The package content to be encoded.
+ *  package_type - Type of the package which the content was extracted.
+ *
+ * Returns
+ *  SUCCESS - If the content was encoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int encode_content(uint8_t* buffer, content_t content, uint32_t package_type) {
+    LOG_TRACE("Package type: 0x%x.", package_type);
+
+    int result = SUCCESS;
+
+    switch (package_type) {
+        case CHECK_CONNECTION_CODE:
+        case DISCONNECT_CODE:
+        case REQUEST_AUDIO_FILE_CODE:
+        case REQUEST_AUDIO_SEGMENTS_CODE:
+        case START_RECORD_CODE:
+        case START_STREAM_CODE:
+        case STOP_RECORD_CODE:
+        case STOP_STREAM_CODE:
+            LOG_TRACE("This type of package does not have a content.");
+            break;
+
+        case CONFIRMATION_CODE:
+            LOG_TRACE_POINT;
+
+            encode_confirmation_content(buffer, *content.confirmation_content);
+            break;
+
+        case COMMAND_RESULT_CODE:
+            LOG_TRACE_POINT;
+
+            encode_command_result_content(buffer, *content.command_result_content);
+            break;
+
+        case ERROR_CODE:
+            LOG_TRACE_POINT;
+
+            encode_error_content(buffer, *content.error_content);
+            break;
+
+        case SEND_FILE_CHUNK_CODE:
+            LOG_TRACE_POINT;
+
+            encode_send_file_chunk_content(buffer, *content.send_file_chunk_content);
+            break;
+
+        case SEND_FILE_HEADER_CODE:
+            LOG_TRACE_POINT;
+
+            encode_send_file_header_content(buffer, *content.send_file_header_content);
+            break;
+
+        case SEND_FILE_TRAILER_CODE:
+            LOG_TRACE_POINT;
+
+            encode_send_file_trailer_content(buffer, *content.send_file_trailer_content);
+            break;
+
+        case REQUEST_AUDIO_FILE_TAIL_CODE:
+            LOG_TRACE_POINT;
+
+            encode_file_tail_content(buffer, *content.file_tail_content);
+            break;
+
+        case AUDIO_CATALOG_PAGE_CODE:
+            LOG_TRACE_POINT;
+
+            encode_audio_catalog_page_content(buffer, *content.audio_catalog_page_content);
+            break;
+
+        case REQUEST_AUDIO_CATALOG_CODE:
+            LOG_TRACE_POINT;
+
+            encode_audio_catalog_request_content(buffer, *content.audio_catalog_request_content);
+            break;
+
+        case REQUEST_AUDIO_RECORD_CODE:
+            LOG_TRACE_POINT;
+
+            encode_audio_record_request_content(buffer, *content.audio_record_request_content);
+            break;
+
+        case RESUME_TRANSFER_CODE:
+            LOG_TRACE_POINT;
+
+            encode_resume_transfer_content(buffer, *content.resume_transfer_content);
+            break;
+
+        case WINDOW_SIZE_CODE:
+            LOG_TRACE_POINT;
+
+            encode_window_size_content(buffer, *content.window_size_content);
+            break;
+
+        default:
+            LOG_ERROR("Unkown package type.");
+            result = GENERIC_ERROR;
+            break;
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Returns the size of a package content when encoded.
+ *
+ * Parameters
+ *  content - The package content.
+ *  package_type - Type of the package which the content was extracted.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded. Packages without content and unknown package types have size zero.
+ */
+size_t get_content_size(content_t content, uint32_t package_type) {
+
+    size_t content_size = 0;
+
+    switch (package_type) {
+        case CONFIRMATION_CODE:
+            content_size = get_confirmation_content_size(*content.confirmation_content);
+            break;
+
+        case COMMAND_RESULT_CODE:
+            content_size = get_command_result_content_size(*content.command_result_content);
+            break;
+
+        case ERROR_CODE:
+            content_size = get_error_content_size(*content.error_content);
+            break;
+
+        case SEND_FILE_CHUNK_CODE:
+            content_size = get_send_file_chunk_content_size(*content.send_file_chunk_content);
+            break;
+
+        case SEND_FILE_HEADER_CODE:
+            content_size = get_send_file_header_content_size(*content.send_file_header_content);
+            break;
+
+        case SEND_FILE_TRAILER_CODE:
+            content_size = get_send_file_trailer_content_size(*content.send_file_trailer_content);
+            break;
+
+        case REQUEST_AUDIO_FILE_TAIL_CODE:
+            content_size = get_file_tail_content_size(*content.file_tail_content);
+            break;
+
+        case AUDIO_CATALOG_PAGE_CODE:
+            content_size = get_audio_catalog_page_content_size(*content.audio_catalog_page_content);
+            break;
+
+        case REQUEST_AUDIO_CATALOG_CODE:
+            content_size = get_audio_catalog_request_content_size(*content.audio_catalog_request_content);
+            break;
+
+        case REQUEST_AUDIO_RECORD_CODE:
+            content_size = get_audio_record_request_content_size(*content.audio_record_request_content);
+            break;
+
+        case RESUME_TRANSFER_CODE:
+            content_size = get_resume_transfer_content_size(*content.resume_transfer_content);
+            break;
+
+        case WINDOW_SIZE_CODE:
+            content_size = get_window_size_content_size(*content.window_size_content);
+            break;
+
+        default:
+            break;
+    }
+
+    return content_size;
+}
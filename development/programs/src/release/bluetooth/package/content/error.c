@@ -37,39 +37,23 @@
 int convert_byte_array_to_error_content(error_content_t* error_content, byte_array_t byte_array) {
     LOG_TRACE_POINT;
 
-    size_t content_size;
-    uint8_t* array_pointer;
-    error_content_t* temporary_error_content;
-
-    content_size = sizeof(uint32_t);
-    content_size += sizeof(uint32_t);
+    error_content_t decoded_error_content;
+    uint8_t* error_message;
 
-    if ( byte_array.size < content_size ) {
-        LOG_ERROR("The byte array size does not match an error content.");
+    if ( decode_error_content(&decoded_error_content, byte_array) != SUCCESS ) {
+        LOG_ERROR("Could not decode the \"error\" package content.");
         return GENERIC_ERROR;
     }
 
-    array_pointer = byte_array.data;
-    temporary_error_content = (error_content_t*)malloc(sizeof(error_content_t));
-
-    memcpy(&temporary_error_content->error_code, array_pointer, sizeof(uint32_t));
-    array_pointer += sizeof(uint32_t);
-    memcpy(&temporary_error_content->error_message_size, array_pointer, sizeof(uint32_t));
-    array_pointer += sizeof(uint32_t);
-
-    content_size += temporary_error_content->error_message_size;
-
-    if ( byte_array.size != content_size ) {
-        LOG_ERROR("The byte array error message length does not match it's message length.");
-        free(temporary_error_content);
+    error_message = (uint8_t*)malloc(decoded_error_content.error_message_size*sizeof(uint8_t));
+    if ( error_message == NULL && decoded_error_content.error_message_size > 0 ) {
+        LOG_ERROR("Could not allocate memory to store the \"error\" package content.");
         return GENERIC_ERROR;
     }
+    memcpy(error_message, decoded_error_content.error_message, decoded_error_content.error_message_size*sizeof(uint8_t));
 
-    temporary_error_content->error_message = (uint8_t*)malloc(temporary_error_content->error_message_size*sizeof(uint8_t));
-    memcpy(temporary_error_content->error_message, array_pointer, temporary_error_content->error_message_size*sizeof(uint8_t));
-
-    memcpy(error_content, temporary_error_content, sizeof(error_content_t));
-    free(temporary_error_content);
+    memcpy(error_content, &decoded_error_content, sizeof(error_content_t));
+    error_content->error_message = error_message;
 
     LOG_TRACE_POINT;
     return SUCCESS;
@@ -116,22 +100,66 @@ byte_array_t create_error_content_byte_array(error_content_t error_content) {
 
     byte_array_t byte_array;
 
-    byte_array.size = 0;
-    byte_array.size += sizeof(uint32_t);
-    byte_array.size += sizeof(uint32_t);
-    byte_array.size += error_content.error_message_size;
-
+    byte_array.size = get_error_content_size(error_content);
     byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
-    uint8_t* array_pointer = byte_array.data;
-    memcpy(array_pointer, &error_content.error_code, sizeof(uint32_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"error\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
+
+    encode_error_content(byte_array.data, error_content);
+
+    LOG_TRACE_POINT;
+    return byte_array;
+}
+
+/*
+ * Decodes a byte array to an "error" package content without allocating memory.
+ *
+ * Parameters
+ *  error_content - The variable where the "error" package content will be stored.
+ *  byte_array - The byte array with the "error" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  The "error_message" field of the content points to the byte array informed, so it is only valid while the byte array is. The content decoded must not be deleted.
+ */
+int decode_error_content(error_content_t* error_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+    uint8_t* array_pointer;
+
+    content_size = sizeof(uint32_t);
+    content_size += sizeof(uint32_t);
+
+    if ( byte_array.size < content_size ) {
+        LOG_ERROR("The byte array size does not match an error content.");
+        return GENERIC_ERROR;
+    }
+
+    array_pointer = byte_array.data;
+
+    memcpy(&error_content->error_code, array_pointer, sizeof(uint32_t));
     array_pointer += sizeof(uint32_t);
-    memcpy(array_pointer, &error_content.error_message_size, sizeof(uint32_t));
+    memcpy(&error_content->error_message_size, array_pointer, sizeof(uint32_t));
     array_pointer += sizeof(uint32_t);
-    memcpy(array_pointer, error_content.error_message, error_content.error_message_size);
 
+    content_size += error_content->error_message_size;
+
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The byte array error message length does not match it's message length.");
+        return GENERIC_ERROR;
+    }
+
+    error_content->error_message = array_pointer;
 
     LOG_TRACE_POINT;
-    return byte_array;
+    return SUCCESS;
 }
 
 /*
@@ -153,3 +181,41 @@ int delete_error_content(error_content_t* error_content) {
     LOG_TRACE_POINT;
     return SUCCESS;
 }
+
+/*
+ * Encodes an "error" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_error_content_size" function.
+ *  error_content - The "error" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_error_content(uint8_t* buffer, error_content_t error_content) {
+    LOG_TRACE_POINT;
+
+    uint8_t* array_pointer = buffer;
+
+    memcpy(array_pointer, &error_content.error_code, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &error_content.error_message_size, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, error_content.error_message, error_content.error_message_size);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of an "error" package content when encoded.
+ *
+ * Parameters
+ *  error_content - The "error" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_error_content_size(error_content_t error_content) {
+    return 2*sizeof(uint32_t) + error_content.error_message_size;
+}
@@ -0,0 +1,174 @@
+/*
+ * This source file contains the elaboration of all components required to create and manipulate "file tail" package contents.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+
+#include "bluetooth/package/content/file_tail.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Converts a byte array to a "file tail" package content.
+ *
+ * Parameters
+ *  file_tail_content - The variable where the "file tail" package content will be stored.
+ *  byte_array - The byte array with information of the "file tail" package content.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was converted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int convert_byte_array_to_file_tail_content(file_tail_content_t* file_tail_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    return decode_file_tail_content(file_tail_content, byte_array);
+}
+
+/*
+ * Creates a "file tail" package content.
+ *
+ * Parameters
+ *  file_offset - The number of bytes of the file the remote device already has.
+ *  prefix_digest - The digest of the bytes the remote device already has.
+ *
+ * Returns
+ *  A "file tail" package content with the informations provided.
+ */
+file_tail_content_t* create_file_tail_content(uint32_t file_offset, uint64_t prefix_digest){
+    LOG_TRACE("File offset: %u, prefix digest: 0x%016llx.", file_offset, (unsigned long long)prefix_digest);
+
+    file_tail_content_t* file_tail_content;
+
+    file_tail_content = (file_tail_content_t*)malloc(sizeof(file_tail_content_t));
+    file_tail_content->file_offset = file_offset;
+    file_tail_content->prefix_digest = prefix_digest;
+
+    LOG_TRACE_POINT;
+    return file_tail_content;
+}
+
+/*
+ * Creates a byte array containing the "file tail" package content.
+ *
+ * Parameters
+ *  file_tail_content - The "file tail" package content with the informations to build the byte array.
+ *
+ * Returns
+ *  A byte array structure with the file tail package content informations.
+ */
+byte_array_t create_file_tail_content_byte_array(file_tail_content_t file_tail_content) {
+    LOG_TRACE_POINT;
+
+    byte_array_t byte_array;
+
+    byte_array.size = get_file_tail_content_size(file_tail_content);
+    byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"file tail\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
+
+    encode_file_tail_content(byte_array.data, file_tail_content);
+
+    LOG_TRACE_POINT;
+    return byte_array;
+}
+
+/*
+ * Decodes a byte array to a "file tail" package content without allocating memory.
+ *
+ * Parameters
+ *  file_tail_content - The variable where the "file tail" package content will be stored.
+ *  byte_array - The byte array with the "file tail" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int decode_file_tail_content(file_tail_content_t* file_tail_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+
+    content_size = sizeof(uint32_t);
+    content_size += sizeof(uint64_t);
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The byte array size does not match a file tail content.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&file_tail_content->file_offset, byte_array.data, sizeof(uint32_t));
+    memcpy(&file_tail_content->prefix_digest, byte_array.data + sizeof(uint32_t), sizeof(uint64_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Deletes a "file tail" package content.
+ *
+ * Parameters
+ *  file_tail_content - The "file tail" package content to be deleted.
+ *
+ * Returns
+ *  SUCCESS - If the content was deleted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int delete_file_tail_content(file_tail_content_t* file_tail_content) {
+    LOG_TRACE_POINT;
+
+    free(file_tail_content);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Encodes a "file tail" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_file_tail_content_size" function.
+ *  file_tail_content - The "file tail" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_file_tail_content(uint8_t* buffer, file_tail_content_t file_tail_content) {
+    LOG_TRACE_POINT;
+
+    memcpy(buffer, &file_tail_content.file_offset, sizeof(uint32_t));
+    memcpy(buffer + sizeof(uint32_t), &file_tail_content.prefix_digest, sizeof(uint64_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a "file tail" package content when encoded.
+ *
+ * Parameters
+ *  file_tail_content - The "file tail" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_file_tail_content_size(file_tail_content_t file_tail_content) {
+    return sizeof(uint32_t) + sizeof(uint64_t);
+}
@@ -0,0 +1,174 @@
+/*
+ * This source file contains the elaboration of all components required to create and manipulate "resume transfer" package contents.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+
+#include "bluetooth/package/content/resume_transfer.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Converts a byte array to a "resume transfer" package content.
+ *
+ * Parameters
+ *  resume_transfer_content - The variable where the "resume transfer" package content will be stored.
+ *  byte_array - The byte array with information of the "resume transfer" package content.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was converted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int convert_byte_array_to_resume_transfer_content(resume_transfer_content_t* resume_transfer_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    return decode_resume_transfer_content(resume_transfer_content, byte_array);
+}
+
+/*
+ * Creates a "resume transfer" package content.
+ *
+ * Parameters
+ *  transfer_id - Identifier of the transfer to be resumed.
+ *  file_offset - The number of bytes of the file the remote device already has.
+ *
+ * Returns
+ *  A "resume transfer" package content with the informations provided.
+ */
+resume_transfer_content_t* create_resume_transfer_content(uint32_t transfer_id, uint32_t file_offset){
+    LOG_TRACE("Transfer ID: 0x%08x, file offset: %u.", transfer_id, file_offset);
+
+    resume_transfer_content_t* resume_transfer_content;
+
+    resume_transfer_content = (resume_transfer_content_t*)malloc(sizeof(resume_transfer_content_t));
+    resume_transfer_content->transfer_id = transfer_id;
+    resume_transfer_content->file_offset = file_offset;
+
+    LOG_TRACE_POINT;
+    return resume_transfer_content;
+}
+
+/*
+ * Creates a byte array containing the "resume transfer" package content.
+ *
+ * Parameters
+ *  resume_transfer_content - The "resume transfer" package content with the informations to build the byte array.
+ *
+ * Returns
+ *  A byte array structure with the resume transfer package content informations.
+ */
+byte_array_t create_resume_transfer_content_byte_array(resume_transfer_content_t resume_transfer_content) {
+    LOG_TRACE_POINT;
+
+    byte_array_t byte_array;
+
+    byte_array.size = get_resume_transfer_content_size(resume_transfer_content);
+    byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"resume transfer\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
+
+    encode_resume_transfer_content(byte_array.data, resume_transfer_content);
+
+    LOG_TRACE_POINT;
+    return byte_array;
+}
+
+/*
+ * Decodes a byte array to a "resume transfer" package content without allocating memory.
+ *
+ * Parameters
+ *  resume_transfer_content - The variable where the "resume transfer" package content will be stored.
+ *  byte_array - The byte array with the "resume transfer" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int decode_resume_transfer_content(resume_transfer_content_t* resume_transfer_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+
+    content_size = sizeof(uint32_t);
+    content_size += sizeof(uint32_t);
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The byte array size does not match a resume transfer content.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&resume_transfer_content->transfer_id, byte_array.data, sizeof(uint32_t));
+    memcpy(&resume_transfer_content->file_offset, byte_array.data + sizeof(uint32_t), sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Deletes a "resume transfer" package content.
+ *
+ * Parameters
+ *  resume_transfer_content - The "resume transfer" package content to be deleted.
+ *
+ * Returns
+ *  SUCCESS - If the content was deleted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int delete_resume_transfer_content(resume_transfer_content_t* resume_transfer_content) {
+    LOG_TRACE_POINT;
+
+    free(resume_transfer_content);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Encodes a "resume transfer" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_resume_transfer_content_size" function.
+ *  resume_transfer_content - The "resume transfer" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_resume_transfer_content(uint8_t* buffer, resume_transfer_content_t resume_transfer_content) {
+    LOG_TRACE_POINT;
+
+    memcpy(buffer, &resume_transfer_content.transfer_id, sizeof(uint32_t));
+    memcpy(buffer + sizeof(uint32_t), &resume_transfer_content.file_offset, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a "resume transfer" package content when encoded.
+ *
+ * Parameters
+ *  resume_transfer_content - The "resume transfer" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_resume_transfer_content_size(resume_transfer_content_t resume_transfer_content) {
+    return 2*sizeof(uint32_t);
+}
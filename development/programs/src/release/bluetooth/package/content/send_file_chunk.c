@@ -38,48 +38,25 @@
 int convert_byte_array_to_send_file_chunk_content(send_file_chunk_content_t* send_file_chunk_content, byte_array_t byte_array) {
     LOG_TRACE_POINT;
 
-    size_t content_size;
-    uint8_t* array_pointer;
+    send_file_chunk_content_t decoded_send_file_chunk_content;
+    uint8_t* chunk_data;
 
-    content_size = sizeof(uint32_t);
-    content_size += sizeof(uint32_t);
-    send_file_chunk_content_t* temporary_send_file_chunk_content;
-
-    if ( byte_array.size < content_size ) {
-        LOG_ERROR("The byte array size does not match a send file chunk content.");
+    if ( decode_send_file_chunk_content(&decoded_send_file_chunk_content, byte_array) != SUCCESS ) {
+        LOG_ERROR("Could not decode the \"send file chunk\" package content.");
         return GENERIC_ERROR;
     }
 
-    array_pointer = byte_array.data;
-
-    temporary_send_file_chunk_content = (send_file_chunk_content_t*)malloc(sizeof(send_file_chunk_content_t));
-
-    memcpy(&temporary_send_file_chunk_content->file_content, array_pointer, sizeof(uint32_t));
-
-    if ( temporary_send_file_chunk_content->file_content != SEND_FILE_CHUNK_CONTENT_CODE ) {
-        LOG_ERROR("Could not find the send file chunk content code.");
+    chunk_data = (uint8_t*)malloc(decoded_send_file_chunk_content.chunk_size*sizeof(uint8_t));
+    if ( chunk_data == NULL && decoded_send_file_chunk_content.chunk_size > 0 ) {
+        LOG_ERROR("Could not allocate memory to store the \"send file chunk\" package content.");
         return GENERIC_ERROR;
     }
+    memcpy(chunk_data, decoded_send_file_chunk_content.chunk_data, decoded_send_file_chunk_content.chunk_size*sizeof(uint8_t));
 
-    array_pointer += sizeof(uint32_t);
-    memcpy(&temporary_send_file_chunk_content->chunk_size, array_pointer, sizeof(uint32_t));
-    LOG_TRACE("Chunk size: 0x%02x.", temporary_send_file_chunk_content->chunk_size);
-
-    content_size += temporary_send_file_chunk_content->chunk_size;
-
-    if ( byte_array.size != content_size ) {
-        LOG_ERROR("The chunk size informed on byte array does not match it's chunk size.");
-        free(temporary_send_file_chunk_content);
-        return GENERIC_ERROR;
-    }
-    array_pointer += sizeof(uint32_t);
-
-    temporary_send_file_chunk_content->chunk_data = (uint8_t*)malloc(temporary_send_file_chunk_content->chunk_size*sizeof(uint8_t));
-    memcpy(temporary_send_file_chunk_content->chunk_data, array_pointer, temporary_send_file_chunk_content->chunk_size*sizeof(uint8_t));
-
-    memcpy(send_file_chunk_content, temporary_send_file_chunk_content, sizeof(send_file_chunk_content_t));
-    free(temporary_send_file_chunk_content);
+    memcpy(send_file_chunk_content, &decoded_send_file_chunk_content, sizeof(send_file_chunk_content_t));
+    send_file_chunk_content->chunk_data = chunk_data;
 
+    LOG_TRACE_POINT;
     return SUCCESS;
 }
 
@@ -122,22 +99,72 @@ byte_array_t create_send_file_chunk_content_byte_array(send_file_chunk_content_t
 
     byte_array_t byte_array;
 
-    byte_array.size = 0;
-    byte_array.size += sizeof(uint32_t);
-    byte_array.size += sizeof(uint32_t);
-    byte_array.size += send_file_chunk_content.chunk_size;
-
+    byte_array.size = get_send_file_chunk_content_size(send_file_chunk_content);
     byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
-    uint8_t* array_pointer = byte_array.data;
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"send file chunk\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
 
-    memcpy(array_pointer, &send_file_chunk_content.file_content, sizeof(uint32_t));
+    encode_send_file_chunk_content(byte_array.data, send_file_chunk_content);
+
+    LOG_TRACE_POINT;
+    return byte_array;
+}
+
+/*
+ * Decodes a byte array to a "send file chunk" package content without allocating memory.
+ *
+ * Parameters
+ *  send_file_chunk_content - The variable where the "send file chunk" package content will be stored.
+ *  byte_array - The byte array with the "send file chunk" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  The "chunk_data" field of the content points to the byte array informed, so it is only valid while the byte array is. The content decoded must not be deleted.
+ */
+int decode_send_file_chunk_content(send_file_chunk_content_t* send_file_chunk_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+    uint8_t* array_pointer;
+
+    content_size = sizeof(uint32_t);
+    content_size += sizeof(uint32_t);
+
+    if ( byte_array.size < content_size ) {
+        LOG_ERROR("The byte array size does not match a send file chunk content.");
+        return GENERIC_ERROR;
+    }
+
+    array_pointer = byte_array.data;
+
+    memcpy(&send_file_chunk_content->file_content, array_pointer, sizeof(uint32_t));
     array_pointer += sizeof(uint32_t);
-    memcpy(array_pointer, &send_file_chunk_content.chunk_size, sizeof(uint32_t));
+
+    if ( send_file_chunk_content->file_content != SEND_FILE_CHUNK_CONTENT_CODE ) {
+        LOG_ERROR("Could not find the send file chunk content code.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&send_file_chunk_content->chunk_size, array_pointer, sizeof(uint32_t));
     array_pointer += sizeof(uint32_t);
-    memcpy(array_pointer, send_file_chunk_content.chunk_data, send_file_chunk_content.chunk_size);
+
+    content_size += send_file_chunk_content->chunk_size;
+
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The chunk size informed on byte array does not match it's chunk size.");
+        return GENERIC_ERROR;
+    }
+
+    send_file_chunk_content->chunk_data = array_pointer;
 
     LOG_TRACE_POINT;
-    return byte_array;
+    return SUCCESS;
 }
 
 /*
@@ -158,3 +185,41 @@ int delete_send_file_chunk_content(send_file_chunk_content_t* send_file_chunk_co
     LOG_TRACE_POINT;
     return SUCCESS;
 }
+
+/*
+ * Encodes a "send file chunk" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_send_file_chunk_content_size" function.
+ *  send_file_chunk_content - The "send file chunk" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_send_file_chunk_content(uint8_t* buffer, send_file_chunk_content_t send_file_chunk_content) {
+    LOG_TRACE_POINT;
+
+    uint8_t* array_pointer = buffer;
+
+    memcpy(array_pointer, &send_file_chunk_content.file_content, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &send_file_chunk_content.chunk_size, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, send_file_chunk_content.chunk_data, send_file_chunk_content.chunk_size);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a "send file chunk" package content when encoded.
+ *
+ * Parameters
+ *  send_file_chunk_content - The "send file chunk" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_send_file_chunk_content_size(send_file_chunk_content_t send_file_chunk_content) {
+    return 2*sizeof(uint32_t) + send_file_chunk_content.chunk_size;
+}
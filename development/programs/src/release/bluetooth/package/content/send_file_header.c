@@ -38,52 +38,23 @@
 int convert_byte_array_to_send_file_header_content(send_file_header_content_t* send_file_header_content, byte_array_t byte_array) {
     LOG_TRACE_POINT;
 
-    size_t content_size;
-    uint8_t* array_pointer;
-    send_file_header_content_t* temporary_send_file_header_content;
-
-    content_size = sizeof(uint32_t);
-    content_size += sizeof(uint32_t);
-    content_size += sizeof(uint32_t);
-
-    if ( byte_array.size < content_size ) {
-        LOG_ERROR("The byte array size does not match a send file header result content.");
-        return GENERIC_ERROR;
-    }
-
-    array_pointer = byte_array.data;
-
-    temporary_send_file_header_content = (send_file_header_content_t*)malloc(sizeof(send_file_header_content_t));
-    memcpy(&temporary_send_file_header_content->file_header, array_pointer, sizeof(uint32_t));
-    LOG_TRACE_POINT;
+    send_file_header_content_t decoded_send_file_header_content;
+    uint8_t* file_name;
 
-    if ( temporary_send_file_header_content->file_header != SEND_FILE_HEADER_CONTENT_CODE ) {
-        LOG_ERROR("The content header does not match a send file header content.");
+    if ( decode_send_file_header_content(&decoded_send_file_header_content, byte_array) != SUCCESS ) {
+        LOG_ERROR("Could not decode the \"send file header\" package content.");
         return GENERIC_ERROR;
     }
 
-    array_pointer += sizeof(uint32_t);
-
-    memcpy(&temporary_send_file_header_content->file_size, array_pointer, sizeof(uint32_t));
-    array_pointer += sizeof(uint32_t);
-    LOG_TRACE_POINT;
-
-    memcpy(&temporary_send_file_header_content->file_name_size, array_pointer, sizeof(uint32_t));
-    LOG_TRACE_POINT;
-
-    content_size += temporary_send_file_header_content->file_name_size;
-
-    if ( byte_array.size != content_size ) {
-        LOG_ERROR("The file name size on byte array does not match is content.");
-        free(temporary_send_file_header_content);
+    file_name = (uint8_t*)malloc(decoded_send_file_header_content.file_name_size*sizeof(uint8_t));
+    if ( file_name == NULL && decoded_send_file_header_content.file_name_size > 0 ) {
+        LOG_ERROR("Could not allocate memory to store the \"send file header\" package content.");
         return GENERIC_ERROR;
     }
+    memcpy(file_name, decoded_send_file_header_content.file_name, decoded_send_file_header_content.file_name_size*sizeof(uint8_t));
 
-    array_pointer += sizeof(uint32_t);
-
-    temporary_send_file_header_content->file_name = (uint8_t*)malloc(temporary_send_file_header_content->file_name_size*sizeof(uint8_t));
-    memcpy(temporary_send_file_header_content->file_name, array_pointer, temporary_send_file_header_content->file_name_size*sizeof(uint8_t));
-    memcpy(send_file_header_content, temporary_send_file_header_content, sizeof(send_file_header_content_t));
+    memcpy(send_file_header_content, &decoded_send_file_header_content, sizeof(send_file_header_content_t));
+    send_file_header_content->file_name = file_name;
 
     LOG_TRACE_POINT;
     return SUCCESS;
@@ -96,12 +67,15 @@ int convert_byte_array_to_send_file_header_content(send_file_header_content_t* s
  *  file_size - Size of the file to be informed on the content.
  *  file_name_size - Size of the file name to be informed on the content.
  *  file_name - Name of the file to be informed on the content.
+ *  file_offset - Position of the first byte of the file which will be sent.
+ *  transfer_id - Identifier of the file transfer, used to resume it. Zero if the transfer cannot be resumed.
+ *  file_digest - Digest of the whole file content.
  *
  * Returns
  *  A "send file header" content with the file informations.
  */
-send_file_header_content_t* create_send_file_header_content(uint32_t file_size, uint32_t file_name_size, uint8_t* file_name) {
-    LOG_TRACE("File size: 0x%x bytes, file name size: 0x%x.", file_size, file_name_size);
+send_file_header_content_t* create_send_file_header_content(uint32_t file_size, uint32_t file_name_size, uint8_t* file_name, uint32_t file_offset, uint32_t transfer_id, uint64_t file_digest) {
+    LOG_TRACE("File size: 0x%x bytes, file name size: 0x%x, file offset: 0x%x, transfer ID: 0x%08x.", file_size, file_name_size, file_offset, transfer_id);
 
     send_file_header_content_t* send_file_header_content;
 
@@ -111,6 +85,9 @@ send_file_header_content_t* create_send_file_header_content(uint32_t file_size,
     send_file_header_content->file_header = SEND_FILE_HEADER_CONTENT_CODE;
     send_file_header_content->file_size = file_size;
     send_file_header_content->file_name_size = file_name_size;
+    send_file_header_content->file_offset = file_offset;
+    send_file_header_content->transfer_id = transfer_id;
+    send_file_header_content->file_digest = file_digest;
 
     send_file_header_content->file_name = (uint8_t*)malloc(file_name_size*sizeof(uint8_t));
     memcpy(send_file_header_content->file_name, file_name, file_name_size);
@@ -133,32 +110,88 @@ byte_array_t create_send_file_header_content_byte_array(send_file_header_content
 
     byte_array_t byte_array;
 
-    byte_array.size = 0;
-    byte_array.size += sizeof(uint32_t);
-    byte_array.size += sizeof(uint32_t);
-    byte_array.size += sizeof(uint32_t);
-    byte_array.size += send_file_header_content.file_name_size;
-
+    byte_array.size = get_send_file_header_content_size(send_file_header_content);
     byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
-    uint8_t* array_pointer = byte_array.data;
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"send file header\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
+
+    encode_send_file_header_content(byte_array.data, send_file_header_content);
+
     LOG_TRACE_POINT;
+    return byte_array;
+}
 
-    memcpy(array_pointer, &send_file_header_content.file_header, sizeof(uint32_t));
-    array_pointer += sizeof(uint32_t);
+/*
+ * Decodes a byte array to a "send file header" package content without allocating memory.
+ *
+ * Parameters
+ *  send_file_header_content - The variable where the "send file header" package content will be stored.
+ *  byte_array - The byte array with the "send file header" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  The "file_name" field of the content points to the byte array informed, so it is only valid while the byte array is. The content decoded must not be deleted.
+ *  Contents without the transfer informations are also accepted, since they are sent on transfers which cannot be resumed.
+ */
+int decode_send_file_header_content(send_file_header_content_t* send_file_header_content, byte_array_t byte_array) {
     LOG_TRACE_POINT;
 
-    memcpy(array_pointer, &send_file_header_content.file_size, sizeof(uint32_t));
+    size_t content_size;
+    uint8_t* array_pointer;
+
+    content_size = sizeof(uint32_t);
+    content_size += sizeof(uint32_t);
+    content_size += sizeof(uint32_t);
+
+    if ( byte_array.size < content_size ) {
+        LOG_ERROR("The byte array size does not match a send file header result content.");
+        return GENERIC_ERROR;
+    }
+
+    array_pointer = byte_array.data;
+
+    memcpy(&send_file_header_content->file_header, array_pointer, sizeof(uint32_t));
     array_pointer += sizeof(uint32_t);
-    LOG_TRACE_POINT;
 
-    memcpy(array_pointer, &send_file_header_content.file_name_size, sizeof(uint32_t));
+    if ( send_file_header_content->file_header != SEND_FILE_HEADER_CONTENT_CODE ) {
+        LOG_ERROR("The content header does not match a send file header content.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&send_file_header_content->file_size, array_pointer, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(&send_file_header_content->file_name_size, array_pointer, sizeof(uint32_t));
     array_pointer += sizeof(uint32_t);
-    LOG_TRACE_POINT;
 
-    memcpy(array_pointer, send_file_header_content.file_name, send_file_header_content.file_name_size);
+    content_size += send_file_header_content->file_name_size;
+
+    if ( byte_array.size != content_size && byte_array.size != content_size + SEND_FILE_HEADER_TRANSFER_INFORMATIONS_SIZE ) {
+        LOG_ERROR("The file name size on byte array does not match is content.");
+        return GENERIC_ERROR;
+    }
+
+    send_file_header_content->file_name = array_pointer;
+    array_pointer += send_file_header_content->file_name_size;
+
+    send_file_header_content->file_offset = 0;
+    send_file_header_content->transfer_id = 0;
+    send_file_header_content->file_digest = 0;
+    if ( byte_array.size > content_size ) {
+        memcpy(&send_file_header_content->file_offset, array_pointer, sizeof(uint32_t));
+        array_pointer += sizeof(uint32_t);
+        memcpy(&send_file_header_content->transfer_id, array_pointer, sizeof(uint32_t));
+        array_pointer += sizeof(uint32_t);
+        memcpy(&send_file_header_content->file_digest, array_pointer, sizeof(uint64_t));
+    }
 
     LOG_TRACE_POINT;
-    return byte_array;
+    return SUCCESS;
 }
 
 /*
@@ -180,3 +213,61 @@ int delete_send_file_header_content(send_file_header_content_t* send_file_header
     LOG_TRACE_POINT;
     return SUCCESS;
 }
+
+/*
+ * Encodes a "send file header" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_send_file_header_content_size" function.
+ *  send_file_header_content - The "send file header" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ *
+ * Observations
+ *  The file offset, transfer ID and file digest are only encoded when the transfer can be resumed or the file is not sent from its start, so streams are informed with the same content as before.
+ */
+int encode_send_file_header_content(uint8_t* buffer, send_file_header_content_t send_file_header_content) {
+    LOG_TRACE_POINT;
+
+    uint8_t* array_pointer = buffer;
+
+    memcpy(array_pointer, &send_file_header_content.file_header, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &send_file_header_content.file_size, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &send_file_header_content.file_name_size, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, send_file_header_content.file_name, send_file_header_content.file_name_size);
+    array_pointer += send_file_header_content.file_name_size;
+
+    if ( send_file_header_content.file_offset > 0 || send_file_header_content.transfer_id != 0 ) {
+        memcpy(array_pointer, &send_file_header_content.file_offset, sizeof(uint32_t));
+        array_pointer += sizeof(uint32_t);
+        memcpy(array_pointer, &send_file_header_content.transfer_id, sizeof(uint32_t));
+        array_pointer += sizeof(uint32_t);
+        memcpy(array_pointer, &send_file_header_content.file_digest, sizeof(uint64_t));
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a "send file header" package content when encoded.
+ *
+ * Parameters
+ *  send_file_header_content - The "send file header" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_send_file_header_content_size(send_file_header_content_t send_file_header_content) {
+    size_t content_size = 3*sizeof(uint32_t) + send_file_header_content.file_name_size;
+
+    if ( send_file_header_content.file_offset > 0 || send_file_header_content.transfer_id != 0 ) {
+        content_size += SEND_FILE_HEADER_TRANSFER_INFORMATIONS_SIZE;
+    }
+
+    return content_size;
+}
@@ -38,19 +38,7 @@
 int convert_byte_array_to_send_file_trailer_content(send_file_trailer_content_t* send_file_trailer_content, byte_array_t byte_array) {
     LOG_TRACE_POINT;
 
-    size_t content_size;
-
-    content_size = sizeof(uint32_t);
-
-    if ( byte_array.size != content_size ) {
-        LOG_ERROR("The byte array size does not match a send file trailer content.");
-        return GENERIC_ERROR;
-    }
-
-    memcpy(&send_file_trailer_content->file_trailer, byte_array.data, sizeof(uint32_t));
-
-    LOG_TRACE_POINT;
-    return SUCCESS;
+    return decode_send_file_trailer_content(send_file_trailer_content, byte_array);
 }
 
 /*
@@ -88,16 +76,49 @@ byte_array_t create_send_file_trailer_content_byte_array(send_file_trailer_conte
 
     byte_array_t byte_array;
 
-    byte_array.size = 0;
-    byte_array.size += sizeof(uint32_t);
+    byte_array.size = get_send_file_trailer_content_size(send_file_trailer_content);
     byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"send file trailer\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
 
-    memcpy(byte_array.data, &send_file_trailer_content.file_trailer, sizeof(uint32_t));
+    encode_send_file_trailer_content(byte_array.data, send_file_trailer_content);
 
     LOG_TRACE_POINT;
     return byte_array;
 }
 
+/*
+ * Decodes a byte array to a "send file trailer" package content without allocating memory.
+ *
+ * Parameters
+ *  send_file_trailer_content - The variable where the "send file trailer" package content will be stored.
+ *  byte_array - The byte array with the "send file trailer" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int decode_send_file_trailer_content(send_file_trailer_content_t* send_file_trailer_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+
+    content_size = sizeof(uint32_t);
+
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The byte array size does not match a send file trailer content.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&send_file_trailer_content->file_trailer, byte_array.data, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
 /*
  * Deletes the information of a "send file trailer" package content.
  * 
@@ -117,3 +138,34 @@ int delete_send_file_trailer_content(send_file_trailer_content_t* send_file_trai
     return SUCCESS;
 }
 
+/*
+ * Encodes a "send file trailer" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_send_file_trailer_content_size" function.
+ *  send_file_trailer_content - The "send file trailer" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_send_file_trailer_content(uint8_t* buffer, send_file_trailer_content_t send_file_trailer_content) {
+    LOG_TRACE_POINT;
+
+    memcpy(buffer, &send_file_trailer_content.file_trailer, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a "send file trailer" package content when encoded.
+ *
+ * Parameters
+ *  send_file_trailer_content - The "send file trailer" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_send_file_trailer_content_size(send_file_trailer_content_t send_file_trailer_content) {
+    return sizeof(uint32_t);
+}
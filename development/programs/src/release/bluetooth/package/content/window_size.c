@@ -0,0 +1,169 @@
+/*
+ * This source file contains the elaboration of all components required to create and manipulate "window size" package contents.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+
+#include "bluetooth/package/content/window_size.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Converts a byte array to a "window size" package content.
+ *
+ * Parameters
+ *  window_size_content - The variable where the "window size" package content will be stored.
+ *  byte_array - The byte array with information of the "window size" package content.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was converted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int convert_byte_array_to_window_size_content(window_size_content_t* window_size_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    return decode_window_size_content(window_size_content, byte_array);
+}
+
+/*
+ * Creates a "window size" package content.
+ *
+ * Parameters
+ *  window_size - The number of packages which can be sent without waiting for their confirmations.
+ *
+ * Returns
+ *  A "window size" package content with the window size informed.
+ */
+window_size_content_t* create_window_size_content(uint32_t window_size){
+    LOG_TRACE("Window size: %u.", window_size);
+
+    window_size_content_t* window_size_content;
+
+    window_size_content = (window_size_content_t*)malloc(sizeof(window_size_content_t));
+    window_size_content->window_size = window_size;
+
+    LOG_TRACE_POINT;
+    return window_size_content;
+}
+
+/*
+ * Creates a byte array containing the "window size" package content.
+ *
+ * Parameters
+ *  window_size_content - The "window size" package content with the informations to build the byte array.
+ *
+ * Returns
+ *  A byte array structure with the window size package content informations.
+ */
+byte_array_t create_window_size_content_byte_array(window_size_content_t window_size_content) {
+    LOG_TRACE_POINT;
+
+    byte_array_t byte_array;
+
+    byte_array.size = get_window_size_content_size(window_size_content);
+    byte_array.data = (uint8_t*)malloc(byte_array.size*sizeof(uint8_t));
+    if ( byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the \"window size\" package content.");
+        byte_array.size = 0;
+        return byte_array;
+    }
+
+    encode_window_size_content(byte_array.data, window_size_content);
+
+    LOG_TRACE_POINT;
+    return byte_array;
+}
+
+/*
+ * Decodes a byte array to a "window size" package content without allocating memory.
+ *
+ * Parameters
+ *  window_size_content - The variable where the "window size" package content will be stored.
+ *  byte_array - The byte array with the "window size" package content informations.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int decode_window_size_content(window_size_content_t* window_size_content, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    size_t content_size;
+
+    content_size = sizeof(uint32_t);
+    if ( byte_array.size != content_size ) {
+        LOG_ERROR("The byte array size does not match a window size content.");
+        return GENERIC_ERROR;
+    }
+
+    memcpy(&window_size_content->window_size, byte_array.data, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Deletes a "window size" package content.
+ *
+ * Parameters
+ *  window_size_content - The "window size" package content to be deleted.
+ *
+ * Returns
+ *  SUCCESS - If the content was deleted successfully.
+ *  GENERIC ERROR - Otherwise.
+ */
+int delete_window_size_content(window_size_content_t* window_size_content) {
+    LOG_TRACE_POINT;
+
+    free(window_size_content);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Encodes a "window size" package content on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the content. It must have at least the size returned by "get_window_size_content_size" function.
+ *  window_size_content - The "window size" package content to be encoded.
+ *
+ * Returns
+ *  SUCCESS - The content is always encoded successfully.
+ */
+int encode_window_size_content(uint8_t* buffer, window_size_content_t window_size_content) {
+    LOG_TRACE_POINT;
+
+    memcpy(buffer, &window_size_content.window_size, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a "window size" package content when encoded.
+ *
+ * Parameters
+ *  window_size_content - The "window size" package content.
+ *
+ * Returns
+ *  The size (in bytes) of the content encoded.
+ */
+size_t get_window_size_content_size(window_size_content_t window_size_content) {
+    return sizeof(uint32_t);
+}
@@ -18,6 +18,7 @@
 
 #include "bluetooth/package/package.h"
 #include "bluetooth/package/codes.h"
+#include "bluetooth/package/content/codes.h"
 #include "log.h"
 #include "random.h"
 #include "return_codes.h"
@@ -27,12 +28,12 @@
  * Function declarations.
  */
 
-/* Creates a new package. */
-package_t create_package(uint32_t);
-
 /* Crates a new package id. */
 uint32_t create_package_id();
 
+/* Reads the fields of a package which surround its content. */
+int read_package_fields(package_t*, byte_array_t*, byte_array_t);
+
 
 /*
  * Function elaborations.
@@ -48,74 +49,29 @@ uint32_t create_package_id();
  * Returns
  *  SUCCESS - If the byte array convertion was done successfully.
  *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The package content is copied from the byte array, so the package must be deleted through "delete_package" function. To read a package without copying its content, use "decode_package" function.
  */
 int convert_byte_array_to_package(package_t* package, byte_array_t byte_array) {
     LOG_TRACE_POINT;
 
     package_t temporary_package;
     byte_array_t content_byte_array;
-    size_t package_size;
-    uint8_t* array_pointer;
     int convert_byte_array_to_content_result;
 
-    package_size = sizeof(uint32_t);
-    package_size += sizeof(uint32_t);
-    package_size += sizeof(uint32_t);
-    package_size += sizeof(uint32_t);
-
-    if ( byte_array.size < package_size ) {
-        LOG_ERROR("Invalid package size. It must be at least %zu bytes to be a package.", package_size);
+    if ( read_package_fields(&temporary_package, &content_byte_array, byte_array) != SUCCESS ) {
+        LOG_ERROR("Byte array is not a valid package.");
         return GENERIC_ERROR;
     }
 
-    array_pointer = byte_array.data;
-    memcpy(&temporary_package.header, array_pointer, sizeof(uint32_t));
-    LOG_TRACE_POINT;
-
-    if (temporary_package.header != PACKAGE_HEADER) {
-        LOG_ERROR("Byte array is not a package.");
-        return GENERIC_ERROR;
-    }
-
-    array_pointer += sizeof(uint32_t);
-
-    memcpy(&temporary_package.id, array_pointer, sizeof(uint32_t));
-    LOG_TRACE("Package id: 0x%x.", temporary_package.id);
-    array_pointer += sizeof(uint32_t);
-
-    memcpy(&temporary_package.type_code, array_pointer, sizeof(uint32_t));
-    LOG_TRACE("Package type: 0x%x.", temporary_package.type_code);
-    array_pointer += sizeof(uint32_t);
-
-    content_byte_array.size = byte_array.size - package_size;
-    LOG_TRACE("Package content size: %zu bytes.", content_byte_array.size);
-
-    if ( content_byte_array.size > 0 ) {
-        content_byte_array.data = (uint8_t*)malloc(content_byte_array.size*sizeof(uint8_t));
-        memcpy(content_byte_array.data, array_pointer, content_byte_array.size*sizeof(uint8_t));
-    }
-
     convert_byte_array_to_content_result = convert_byte_array_to_content(&temporary_package.content, content_byte_array, temporary_package.type_code);
     if ( convert_byte_array_to_content_result != SUCCESS ) {
         LOG_ERROR("Error while converting byte array data to package content.");
         return GENERIC_ERROR;
     }
 
-    array_pointer += content_byte_array.size*sizeof(uint8_t);
-    memcpy(&temporary_package.trailer, array_pointer, sizeof(uint32_t));
-
-    if ( content_byte_array.size > 0 ) {
-        LOG_TRACE_POINT;
-
-        delete_byte_array(&content_byte_array);
-        LOG_TRACE_POINT;
-    }
-
-    package->header = temporary_package.header;
-    package->id = temporary_package.id;
-    package->type_code = temporary_package.type_code;
-    package->content = temporary_package.content;
-    package->trailer = temporary_package.trailer;
+    *package = temporary_package;
 
     LOG_TRACE_POINT;
     return SUCCESS;
@@ -131,48 +87,54 @@ int convert_byte_array_to_package(package_t* package, byte_array_t byte_array) {
  * Returns
  *  SUCCESS - If the conversion was made successfully.
  *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  The byte array data is allocated by this function. To write a package on a buffer already allocated, use "encode_package" function.
  */
 int convert_package_to_byte_array(byte_array_t* byte_array, package_t package) {
     LOG_TRACE_POINT;
 
     byte_array_t temporary_byte_array;
+    size_t package_size;
 
-    temporary_byte_array.size = 0;
-    temporary_byte_array.size += sizeof(uint32_t);
-    temporary_byte_array.size += sizeof(uint32_t);
-    temporary_byte_array.size += sizeof(uint32_t);
-    temporary_byte_array.size += sizeof(uint32_t);
-
-    byte_array_t content_byte_array = create_content_byte_array(package.content, package.type_code);
-    LOG_TRACE_POINT;
-
-    temporary_byte_array.size += content_byte_array.size;
+    temporary_byte_array.size = get_package_size(package);
     temporary_byte_array.data = (uint8_t*)malloc(temporary_byte_array.size*sizeof(uint8_t));
+    if ( temporary_byte_array.data == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the package.");
+        return GENERIC_ERROR;
+    }
 
-    uint8_t* array_pointer = temporary_byte_array.data;
-    memcpy(array_pointer, &package.header, sizeof(uint32_t));
-    array_pointer += sizeof(uint32_t);
-    memcpy(array_pointer, &package.id, sizeof(uint32_t));
-    array_pointer += sizeof(uint32_t);
-    memcpy(array_pointer, &package.type_code, sizeof(uint32_t));
-    array_pointer += sizeof(uint32_t);
-    memcpy(array_pointer, content_byte_array.data, content_byte_array.size);
-    array_pointer += content_byte_array.size;
-    memcpy(array_pointer, &package.trailer, sizeof(uint32_t));
-    LOG_TRACE_POINT;
+    if ( encode_package(temporary_byte_array.data, temporary_byte_array.size, package, &package_size) != SUCCESS ) {
+        LOG_ERROR("Error while encoding package.");
+        delete_byte_array(&temporary_byte_array);
+        return GENERIC_ERROR;
+    }
 
-    delete_byte_array(&content_byte_array);
-    LOG_TRACE_POINT;
+    *byte_array = temporary_byte_array;
 
-    byte_array->size = temporary_byte_array.size;
-    byte_array->data = (uint8_t*)malloc(temporary_byte_array.size*sizeof(uint8_t));
-    memcpy(byte_array->data, temporary_byte_array.data, temporary_byte_array.size*sizeof(uint8_t));
     LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Creates an "audio catalog page" package.
+ *
+ * Parameters
+ *  next_record_id - ID of the first audio record of the next page. Zero if there are no more audio records.
+ *  records_count - Number of audio records on the page.
+ *  audio_catalog_records - The audio records of the page.
+ *
+ * Returns
+ *  An "audio catalog page" package with the informations provided.
+ */
+package_t create_audio_catalog_page_package(uint32_t next_record_id, uint32_t records_count, const audio_catalog_record_t* audio_catalog_records) {
+    LOG_TRACE("Next record ID: %u, records count: %u.", next_record_id, records_count);
 
-    delete_byte_array(&temporary_byte_array);
+    package_t package = create_package(AUDIO_CATALOG_PAGE_CODE);
+    package.content.audio_catalog_page_content = create_audio_catalog_page_content(next_record_id, records_count, audio_catalog_records);
 
     LOG_TRACE_POINT;
-    return SUCCESS;
+    return package;
 }
 
 /*
@@ -199,15 +161,16 @@ package_t create_check_connection_package() {
  * Parameters
  *  command_result - The command result to be informed on the package.
  *  execution_delay - The command execution delay to be informed on the package.
+ *  pre_roll - The time of audio recorded before the command was received. Zero for commands which do not start an audio record.
  *
  * Returns
  *  A "command result" package with the information provided.
  */
-package_t create_command_result_package(uint32_t command_result, struct timeval execution_delay) {
+package_t create_command_result_package(uint32_t command_result, struct timeval execution_delay, struct timeval pre_roll) {
     LOG_TRACE("Command result: 0x%x, Execution delay: %ld.%06ld.", command_result, execution_delay.tv_sec, execution_delay.tv_usec);
 
     package_t package = create_package(COMMAND_RESULT_CODE);
-    package.content.command_result_content = create_command_result_content(command_result, execution_delay);
+    package.content.command_result_content = create_command_result_content(command_result, execution_delay, pre_roll);
 
     LOG_TRACE_POINT;
     return package;
@@ -318,16 +281,92 @@ uint32_t create_package_id() {
     LOG_TRACE_POINT;
 
     uint32_t new_id;
-    uint8_t* random_bytes;
-   
-    random_bytes = generate_random_bytes(sizeof(uint32_t));
-    memcpy(&new_id, random_bytes, sizeof(uint32_t));
-    free(random_bytes);
+
+    fill_random_bytes((uint8_t*)&new_id, sizeof(uint32_t));
 
     LOG_TRACE("Package ID created: 0x%x.", new_id);
     return new_id;
 }
 
+/*
+ * Creates a "request audio catalog" package.
+ *
+ * Parameters
+ *  first_record_id - ID of the first audio record to be listed. Zero lists from the first audio record.
+ *  records_count - Maximum number of audio records to be listed.
+ *
+ * Returns
+ *  A "request audio catalog" package with the informations provided.
+ */
+package_t create_request_audio_catalog_package(uint32_t first_record_id, uint32_t records_count) {
+    LOG_TRACE("First record ID: %u, records count: %u.", first_record_id, records_count);
+
+    package_t package = create_package(REQUEST_AUDIO_CATALOG_CODE);
+    package.content.audio_catalog_request_content = create_audio_catalog_request_content(first_record_id, records_count);
+
+    LOG_TRACE_POINT;
+    return package;
+}
+
+/*
+ * Creates a "request audio file tail" package.
+ *
+ * Parameters
+ *  file_offset - The number of bytes of the latest audio record the remote device already has.
+ *  prefix_digest - The digest of the bytes the remote device already has.
+ *
+ * Returns
+ *  A "request audio file tail" package with the informations provided.
+ */
+package_t create_request_audio_file_tail_package(uint32_t file_offset, uint64_t prefix_digest) {
+    LOG_TRACE("File offset: %u.", file_offset);
+
+    package_t package = create_package(REQUEST_AUDIO_FILE_TAIL_CODE);
+    package.content.file_tail_content = create_file_tail_content(file_offset, prefix_digest);
+
+    LOG_TRACE_POINT;
+    return package;
+}
+
+/*
+ * Creates a "request audio record" package.
+ *
+ * Parameters
+ *  record_id - ID of the audio record on the audio catalog.
+ *
+ * Returns
+ *  A "request audio record" package with the informations provided.
+ */
+package_t create_request_audio_record_package(uint32_t record_id) {
+    LOG_TRACE("Record ID: %u.", record_id);
+
+    package_t package = create_package(REQUEST_AUDIO_RECORD_CODE);
+    package.content.audio_record_request_content = create_audio_record_request_content(record_id);
+
+    LOG_TRACE_POINT;
+    return package;
+}
+
+/*
+ * Creates a "resume transfer" package.
+ *
+ * Parameters
+ *  transfer_id - Identifier of the file transfer to be resumed.
+ *  file_offset - The number of bytes of the file the remote device already has.
+ *
+ * Returns
+ *  A "resume transfer" package with the informations provided.
+ */
+package_t create_resume_transfer_package(uint32_t transfer_id, uint32_t file_offset) {
+    LOG_TRACE("Transfer ID: 0x%08x, file offset: %u.", transfer_id, file_offset);
+
+    package_t package = create_package(RESUME_TRANSFER_CODE);
+    package.content.resume_transfer_content = create_resume_transfer_content(transfer_id, file_offset);
+
+    LOG_TRACE_POINT;
+    return package;
+}
+
 /*
  * Creates a "send file chunk" package.
  *
@@ -356,19 +395,22 @@ package_t create_send_file_chunk_package(size_t chunk_size, uint8_t* chunk_data)
  * Parameters
  *  file_size - The size of the file to be informed on the package.
  *  file_name - The name of the file to be informed on the package.
+ *  file_offset - Position of the first byte of the file which will be sent.
+ *  transfer_id - Identifier of the file transfer. Zero if the transfer cannot be resumed.
+ *  file_digest - Digest of the whole file content.
  *
  * Returns
  *  A "send file header" package with the information provided.
  */
-package_t create_send_file_header_package(size_t file_size, const char* file_name){
-    LOG_TRACE("File size: %zu bytes, file name: \"%s\".", file_size, file_name);
+package_t create_send_file_header_package(size_t file_size, const char* file_name, size_t file_offset, uint32_t transfer_id, uint64_t file_digest){
+    LOG_TRACE("File size: %zu bytes, file name: \"%s\", file offset: %zu, transfer ID: 0x%08x.", file_size, file_name, file_offset, transfer_id);
 
     size_t file_name_size = strlen(file_name);
     uint8_t* file_name_content = (uint8_t*)malloc(file_name_size*sizeof(uint8_t));
     memcpy(file_name_content, file_name, file_name_size);
 
     package_t package = create_package(SEND_FILE_HEADER_CODE);
-    package.content.send_file_header_content = create_send_file_header_content(file_size, file_name_size, file_name_content);
+    package.content.send_file_header_content = create_send_file_header_content(file_size, file_name_size, file_name_content, file_offset, transfer_id, file_digest);
 
     free(file_name_content);
 
@@ -395,6 +437,58 @@ package_t create_send_file_trailer_package() {
     return package;
 }
 
+/*
+ * Creates a "window size" package.
+ *
+ * Parameters
+ *  window_size - The number of packages which can be sent without waiting for their confirmations.
+ *
+ * Returns
+ *  A "window size" package with the window size informed.
+ */
+package_t create_window_size_package(uint32_t window_size) {
+    LOG_TRACE("Window size: %u.", window_size);
+
+    package_t package = create_package(WINDOW_SIZE_CODE);
+    package.content.window_size_content = create_window_size_content(window_size);
+
+    LOG_TRACE_POINT;
+    return package;
+}
+
+/*
+ * Decodes a byte array to a package without allocating memory.
+ *
+ * Parameters
+ *  package_view - The variable which will receive the package decoded. Its "package" field holds the package.
+ *  byte_array - The byte array to be decoded.
+ *
+ * Returns
+ *  SUCCESS - If the byte array was decoded successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The package content is stored on the package view and its variable size fields point to the byte array, so the package is only valid while both are. The package decoded must not be deleted.
+ */
+int decode_package(package_view_t* package_view, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    byte_array_t content_byte_array;
+
+    if ( read_package_fields(&package_view->package, &content_byte_array, byte_array) != SUCCESS ) {
+        LOG_ERROR("Byte array is not a valid package.");
+        return GENERIC_ERROR;
+    }
+
+    if ( decode_content(&package_view->package.content, &package_view->content_storage, content_byte_array, package_view->package.type_code) != SUCCESS ) {
+        LOG_ERROR("Error while decoding package content.");
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
 /*
  * Deletes a package.
  *
@@ -415,3 +509,196 @@ int delete_package(package_t package) {
     LOG_TRACE_POINT;
     return result;
 }
+
+/*
+ * Encodes a package on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer to store the package.
+ *  buffer_size - Size of the buffer.
+ *  package - The package to be encoded.
+ *  package_size - The variable to store the number of bytes written on buffer.
+ *
+ * Returns
+ *  SUCCESS - If the package was encoded successfully.
+ *  GENERIC_ERROR - If the buffer is too small or the package content is invalid.
+ */
+int encode_package(uint8_t* buffer, size_t buffer_size, package_t package, size_t* package_size) {
+    LOG_TRACE_POINT;
+
+    uint8_t* array_pointer;
+    size_t content_size;
+    uint32_t content_size_field;
+
+    content_size = get_content_size(package.content, package.type_code);
+    if ( content_size > PACKAGE_MAXIMUM_CONTENT_SIZE ) {
+        LOG_ERROR("Package content size (%zu bytes) is greater than the maximum allowed (%d bytes).", content_size, PACKAGE_MAXIMUM_CONTENT_SIZE);
+        return GENERIC_ERROR;
+    }
+
+    if ( buffer_size < PACKAGE_PREAMBLE_SIZE + content_size + PACKAGE_TRAILER_SIZE ) {
+        LOG_ERROR("Buffer size (%zu bytes) is not enough to store the package (%zu bytes).", buffer_size, PACKAGE_PREAMBLE_SIZE + content_size + PACKAGE_TRAILER_SIZE);
+        return GENERIC_ERROR;
+    }
+
+    content_size_field = content_size;
+
+    array_pointer = buffer;
+    memcpy(array_pointer, &package.header, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &package.id, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &package.type_code, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &content_size_field, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+
+    if ( content_size > 0 ) {
+        LOG_TRACE_POINT;
+
+        if ( encode_content(array_pointer, package.content, package.type_code) != SUCCESS ) {
+            LOG_ERROR("Error while encoding package content.");
+            return GENERIC_ERROR;
+        }
+        array_pointer += content_size;
+    }
+
+    memcpy(array_pointer, &package.trailer, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+
+    *package_size = array_pointer - buffer;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Returns the size of a package when encoded.
+ *
+ * Parameters
+ *  package - The package.
+ *
+ * Returns
+ *  The size (in bytes) of the package encoded.
+ */
+size_t get_package_size(package_t package) {
+    LOG_TRACE_POINT;
+
+    return PACKAGE_PREAMBLE_SIZE + get_content_size(package.content, package.type_code) + PACKAGE_TRAILER_SIZE;
+}
+
+/*
+ * Reads the fields of a package which surround its content.
+ *
+ * Parameters
+ *  package - The variable to store the package header, id, type code and trailer.
+ *  content_byte_array - The variable to store the position and size of the package content inside the byte array.
+ *  byte_array - The byte array with the package.
+ *
+ * Returns
+ *  SUCCESS - If the byte array has a valid package.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int read_package_fields(package_t* package, byte_array_t* content_byte_array, byte_array_t byte_array) {
+    LOG_TRACE_POINT;
+
+    uint32_t content_size;
+    uint8_t* array_pointer;
+
+    if ( byte_array.size < ( PACKAGE_PREAMBLE_SIZE + PACKAGE_TRAILER_SIZE ) ) {
+        LOG_ERROR("Invalid package size. It must be at least %zu bytes to be a package.", ( PACKAGE_PREAMBLE_SIZE + PACKAGE_TRAILER_SIZE ));
+        return GENERIC_ERROR;
+    }
+
+    array_pointer = byte_array.data;
+    memcpy(&package->header, array_pointer, sizeof(uint32_t));
+    LOG_TRACE_POINT;
+
+    if (package->header != PACKAGE_HEADER) {
+        LOG_ERROR("Byte array is not a package.");
+        return GENERIC_ERROR;
+    }
+
+    array_pointer += sizeof(uint32_t);
+
+    memcpy(&package->id, array_pointer, sizeof(uint32_t));
+    LOG_TRACE("Package id: 0x%x.", package->id);
+    array_pointer += sizeof(uint32_t);
+
+    memcpy(&package->type_code, array_pointer, sizeof(uint32_t));
+    LOG_TRACE("Package type: 0x%x.", package->type_code);
+    array_pointer += sizeof(uint32_t);
+
+    memcpy(&content_size, array_pointer, sizeof(uint32_t));
+    LOG_TRACE("Package content size: %u bytes.", content_size);
+    array_pointer += sizeof(uint32_t);
+
+    if ( content_size > PACKAGE_MAXIMUM_CONTENT_SIZE || byte_array.size != ( PACKAGE_PREAMBLE_SIZE + content_size + PACKAGE_TRAILER_SIZE ) ) {
+        LOG_ERROR("The content size informed on package (%u bytes) does not match the byte array size (%zu bytes).", content_size, byte_array.size);
+        return GENERIC_ERROR;
+    }
+
+    content_byte_array->data = array_pointer;
+    content_byte_array->size = content_size;
+
+    array_pointer += content_size;
+    memcpy(&package->trailer, array_pointer, sizeof(uint32_t));
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Writes the fields of a "send file chunk" package which precede its chunk data.
+ *
+ * Parameters
+ *  buffer - The buffer to write the fields. Must have at least SEND_FILE_CHUNK_PACKAGE_PREAMBLE_SIZE bytes.
+ *  package_id - The variable to store the id of the package created.
+ *  chunk_size - Size of the data chunk which will follow the fields written.
+ *
+ * Returns
+ *  SUCCESS - If the fields were written successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The bytes written are the same as the ones produced by "convert_package_to_byte_array" for a "send file chunk" package, allowing the chunk data and the package trailer to be sent straight after them without copying the data to a package.
+ */
+int write_send_file_chunk_package_preamble(uint8_t* buffer, uint32_t* package_id, size_t chunk_size) {
+    LOG_TRACE("Chunk size: %zu bytes.", chunk_size);
+
+    uint8_t* array_pointer;
+    package_t package;
+    uint32_t content_size;
+    uint32_t file_content = SEND_FILE_CHUNK_CONTENT_CODE;
+    uint32_t chunk_size_field;
+
+    content_size = 2*sizeof(uint32_t) + chunk_size;
+
+    if ( content_size > PACKAGE_MAXIMUM_CONTENT_SIZE ) {
+        LOG_ERROR("Package content size (%u bytes) is greater than the maximum allowed (%d bytes).", content_size, PACKAGE_MAXIMUM_CONTENT_SIZE);
+        return GENERIC_ERROR;
+    }
+
+    package = create_package(SEND_FILE_CHUNK_CODE);
+    LOG_TRACE_POINT;
+
+    chunk_size_field = chunk_size;
+
+    array_pointer = buffer;
+    memcpy(array_pointer, &package.header, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &package.id, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &package.type_code, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &content_size, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &file_content, sizeof(uint32_t));
+    array_pointer += sizeof(uint32_t);
+    memcpy(array_pointer, &chunk_size_field, sizeof(uint32_t));
+
+    *package_id = package.id;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
@@ -20,7 +20,10 @@
 #include <bluetooth/sdp_lib.h>
 #include <stdint.h>
 
+#include "bluetooth/transport/rfcomm.h"
+#include "bluetooth/transport/transport.h"
 #include "bluetooth/connection.h"
+#include "bluetooth/event_loop.h"
 #include "bluetooth/service.h"
 #include "log.h"
 #include "return_codes.h"
@@ -30,9 +33,6 @@
  * Macros.
  */
 
-/* The RFCOMM channel used to provide the service. */
-#define RFCOMM_CHANNEL 27
-
 /* The bluetooth service UUID. */
 #define SERVICE_UUID 0x964b93f5, 0xe6111001, 0x555e228d, 0x667c5017
 
@@ -45,9 +45,8 @@
 /* The bluetooth service description. */
 #define SERVICE_DESCRIPTION "A service to create a communication between the audio recorder and a remote device."
 
-/* Wait time to check a connection attempt. */
-#define CHECK_CONNECTION_WAIT_TIME_SECONDS 5
-#define CHECK_CONNECTION_WAIT_TIME_MICROSECONDS 0
+/* Wait time (in milliseconds) to check a connection attempt. */
+#define CHECK_CONNECTION_WAIT_TIME 5000
 
 
 /*
@@ -73,12 +72,6 @@ const uint8_t _rfcomm_channel = RFCOMM_CHANNEL;
 /* The bluetooth service informations. */
 const bluetooth_service_infos_t bluetooth_service_infos = { .uuid = { SERVICE_UUID}, .name = SERVICE_NAME, .provider = SERVICE_PROVIDER, .description = SERVICE_DESCRIPTION};
 
-/* Wait time to check a connection attempt. */
-const struct timeval _check_connection_wait_time = { .tv_sec = CHECK_CONNECTION_WAIT_TIME_SECONDS, .tv_usec = CHECK_CONNECTION_WAIT_TIME_MICROSECONDS };
-
-/* Local address to check connection attempt. */
-const struct sockaddr_rc local_address = { .rc_family = AF_BLUETOOTH, .rc_bdaddr = *BDADDR_ANY, .rc_channel = RFCOMM_CHANNEL };
-
 
 /*
  * Variables.
@@ -87,6 +80,9 @@ const struct sockaddr_rc local_address = { .rc_family = AF_BLUETOOTH, .rc_bdaddr
 /* Session indicating the connection to bluetooth service provider. */
 sdp_session_t* sdp_connect_session = NULL;
 
+/* Socket which listens for connection attempts. */
+int _listening_socket_fd = -1;
+
 
 /*
  * Function elaborations.
@@ -102,95 +98,113 @@ sdp_session_t* sdp_connect_session = NULL;
  *  CONNECTION_STABLISHED - If a connection was stablished.
  *  NO_CONNECTION - If no connection was stablished.
  *  GENERIC_ERROR - If there was an error while checking a connection attempt.
+ *
+ * Observations
+ *  The listening socket is created on the first check and kept open until "close_listening_socket" is called, so connection attempts realized between checks wait on its queue and are accepted on the next check.
  */
 int check_connection_attempt(int* socket_fd) {
     LOG_TRACE_POINT;
 
-    int listening_socket_file_descriptor;
     int client_socket_file_descriptor;
-    int close_socket_result;
     int result;
-    struct sockaddr_rc remote_device_address = { 0 };
-    char remote_device_address_string[19] = { 0 };
-    char remote_device_name[256] = { 0 };
-    socklen_t address_length;
-    struct timeval check_connection_wait_time;
-    int check_socket_content_result;
-
-    if ( is_bluetooth_service_registered() == false ) {
+    int wait_socket_event_result;
+
+    if ( is_bluetooth_transport() == true && is_bluetooth_service_registered() == false ) {
         LOG_ERROR("Bluetooth service is not registered.");
         return GENERIC_ERROR;
     }
 
-    address_length = sizeof(struct sockaddr_rc);
-    check_connection_wait_time = _check_connection_wait_time;
+    if ( _listening_socket_fd == -1 ) {
+        LOG_TRACE_POINT;
 
-    /* Allocates a socket to listen to connections. */
-    listening_socket_file_descriptor = socket(AF_BLUETOOTH, SOCK_STREAM, BTPROTO_RFCOMM);
-    if ( listening_socket_file_descriptor <= 0 ) {
-        LOG_ERROR("Could not create socket to listen for connections.");
-        return GENERIC_ERROR;
+        /* Allocates a socket to listen to connections. */
+        if ( listen_transport_connections(&_listening_socket_fd) != SUCCESS ) {
+            LOG_ERROR("Could not create socket to listen for connections.");
+            _listening_socket_fd = -1;
+            return GENERIC_ERROR;
+        }
     }
-
-    bind(listening_socket_file_descriptor, (struct sockaddr *)&local_address, sizeof(local_address));
-    LOG_TRACE_POINT;
-
-    /* Listens for connections on socket, defining the listening queue to a maximum of one. */
-    listen(listening_socket_file_descriptor, 1);
     LOG_TRACE("Checking connection.");
 
-    check_socket_content_result = check_socket_content(listening_socket_file_descriptor, check_connection_wait_time); 
+    wait_socket_event_result = wait_socket_event(_listening_socket_fd, SOCKET_EVENT_READ, get_event_loop_time() + CHECK_CONNECTION_WAIT_TIME);
     LOG_TRACE_POINT;
 
-    switch (check_socket_content_result) {
-        case NO_CONTENT_TO_READ:
+    switch (wait_socket_event_result) {
+        case DEADLINE_REACHED:
             LOG_TRACE("No connections.");
 
             result = NO_CONNECTION;
             break;
 
         case GENERIC_ERROR:
-            LOG_TRACE("Error while checking bluetooth service socket.");
+            LOG_TRACE("Error while checking service socket.");
 
             result = GENERIC_ERROR;
             break;
 
-        case CONTENT_TO_READ:
+        case SOCKET_EVENT_OCCURRED:
             LOG_TRACE("Connection attempt initialized.");
 
             /* Accepts one connection from the listening socket. */
-            client_socket_file_descriptor = accept(listening_socket_file_descriptor, (struct sockaddr *)&remote_device_address, &address_length);
-
-            /* Converts the device address on a human-readable address. */
-            ba2str( &remote_device_address.rc_bdaddr, remote_device_address_string );
-
-            /* Requests remote device name. */
-            if (hci_read_remote_name(client_socket_file_descriptor, &(remote_device_address.rc_bdaddr), sizeof(remote_device_name), remote_device_name, 0) < 0 ){
-                LOG_TRACE("Connected with device \"%s\".", remote_device_address_string);
-            }
-            else {
-                LOG_TRACE("Connected with device \"%s\" (%s).", remote_device_name, remote_device_address_string); 
+            if ( accept_transport_connection(_listening_socket_fd, &client_socket_file_descriptor) != SUCCESS ) {
+                LOG_ERROR("Could not accept connection.");
+                result = GENERIC_ERROR;
+                break;
             }
+
             *socket_fd = client_socket_file_descriptor;
             result = CONNECTION_STABLISHED;
             break;
 
         default:
-            LOG_ERROR("Unknown result received from \"check_socket_content\" function.");
+            LOG_ERROR("Unknown result received from \"wait_socket_event\" function.");
             result = GENERIC_ERROR;
             break;
     }
 
-    close_socket_result = close_socket(listening_socket_file_descriptor);
+    /* A listening socket with errors is discarded, so a new one is created on the next check. */
+    if ( result == GENERIC_ERROR ) {
+        LOG_TRACE_POINT;
+
+        close_listening_socket();
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Closes the socket which listens for connection attempts.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the listening socket was closed successfully or if there was no listening socket.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int close_listening_socket() {
+    LOG_TRACE_POINT;
+
+    int close_socket_result;
+
+    if ( _listening_socket_fd == -1 ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    close_socket_result = close_socket(_listening_socket_fd);
     LOG_TRACE_POINT;
 
+    _listening_socket_fd = -1;
+
     if ( close_socket_result != SUCCESS ) {
-        LOG_ERROR("Error while closing socket connection.");
-        result = GENERIC_ERROR;
+        LOG_ERROR("Error while closing listening socket.");
+        return GENERIC_ERROR;
     }
 
     LOG_TRACE_POINT;
-    return result;
+    return SUCCESS;
 }
 
 /*
@@ -0,0 +1,451 @@
+/*
+ * This source file contains the elaboration of all components required to register file transfers, so they can be resumed after a disconnection.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bluetooth/transfer_journal.h"
+#include "directory.h"
+#include "log.h"
+#include "random.h"
+#include "return_codes.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Directory, inside the output directory, where the transfer journal is stored. */
+#define TRANSFER_JOURNAL_DIRECTORY "transfers/"
+
+/* Name of the transfer journal file. */
+#define TRANSFER_JOURNAL_FILE_NAME "journal"
+
+/* Suffix of the file written before replacing the transfer journal. */
+#define TRANSFER_JOURNAL_TEMPORARY_SUFFIX ".tmp"
+
+/* Maximum number of transfers kept on the journal. */
+#define MAXIMUM_JOURNAL_TRANSFERS 16
+
+/* Size of the transfer journal file path. */
+#define TRANSFER_JOURNAL_PATH_SIZE 512
+
+/* Size of a line of the transfer journal. */
+#define TRANSFER_JOURNAL_LINE_SIZE (TRANSFER_FILE_PATH_SIZE + 64)
+
+
+/*
+ * Function headers.
+ */
+
+/* Creates an identifier not used by the transfers registered on the journal. */
+uint32_t create_transfer_id(transfer_t*, size_t);
+
+/* Finds the transfer registered on the journal with the same file content. */
+transfer_t* find_file_transfer(transfer_t*, size_t, transfer_t*);
+
+/* Builds the transfer journal file path. */
+int get_transfer_journal_path(char*, size_t);
+
+/* Reads the transfers registered on the journal. */
+int read_transfer_journal(transfer_t*, size_t*);
+
+/* Writes the transfers on the journal. */
+int write_transfer_journal(transfer_t*, size_t);
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Creates an identifier not used by the transfers registered on the journal.
+ *
+ * Parameters
+ *  transfers - The transfers registered on the journal.
+ *  transfers_count - Number of transfers registered on the journal.
+ *
+ * Returns
+ *  The identifier created. It is never zero.
+ */
+uint32_t create_transfer_id(transfer_t* transfers, size_t transfers_count) {
+    LOG_TRACE_POINT;
+
+    uint32_t transfer_id;
+    size_t counter;
+
+    do {
+        fill_random_bytes((uint8_t*)&transfer_id, sizeof(uint32_t));
+        for ( counter = 0; counter < transfers_count; counter++ ) {
+            if ( transfers[counter].transfer_id == transfer_id ) {
+                transfer_id = 0;
+                break;
+            }
+        }
+    } while ( transfer_id == 0 );
+
+    LOG_TRACE_POINT;
+    return transfer_id;
+}
+
+/*
+ * Finds the transfer registered on the journal with the same file content.
+ *
+ * Parameters
+ *  transfers - The transfers registered on the journal.
+ *  transfers_count - Number of transfers registered on the journal.
+ *  transfer - The transfer which file content must be found.
+ *
+ * Returns
+ *  The transfer registered with the same file path, size and digest or NULL if there is none.
+ */
+transfer_t* find_file_transfer(transfer_t* transfers, size_t transfers_count, transfer_t* transfer) {
+    LOG_TRACE_POINT;
+
+    size_t counter;
+
+    for ( counter = 0; counter < transfers_count; counter++ ) {
+        if ( transfers[counter].file_size == transfer->file_size &&
+             transfers[counter].file_digest == transfer->file_digest &&
+             strcmp(transfers[counter].file_path, transfer->file_path) == 0 ) {
+            LOG_TRACE_POINT;
+            return &transfers[counter];
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return NULL;
+}
+
+/*
+ * Finds a transfer registered on the journal.
+ *
+ * Parameters
+ *  transfer_id - Identifier of the transfer.
+ *  transfer - The variable where the transfer found will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the transfer was found.
+ *  TRANSFER_NOT_FOUND - If the transfer is not registered on the journal.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int find_transfer(uint32_t transfer_id, transfer_t* transfer) {
+    LOG_TRACE("Transfer ID: 0x%08x.", transfer_id);
+
+    transfer_t transfers[MAXIMUM_JOURNAL_TRANSFERS];
+    size_t transfers_count;
+    size_t counter;
+
+    if ( read_transfer_journal(transfers, &transfers_count) != SUCCESS ) {
+        LOG_ERROR("Could not read the transfer journal.");
+        return GENERIC_ERROR;
+    }
+
+    for ( counter = 0; counter < transfers_count; counter++ ) {
+        if ( transfers[counter].transfer_id == transfer_id ) {
+            LOG_TRACE_POINT;
+            memcpy(transfer, &transfers[counter], sizeof(transfer_t));
+            return SUCCESS;
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return TRANSFER_NOT_FOUND;
+}
+
+/*
+ * Builds the transfer journal file path.
+ *
+ * Parameters
+ *  journal_path - The buffer where the path will be stored.
+ *  journal_path_size - Size of the buffer.
+ *
+ * Returns
+ *  SUCCESS - If the path was built successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The journal directory is created if it does not exist.
+ */
+int get_transfer_journal_path(char* journal_path, size_t journal_path_size) {
+    LOG_TRACE_POINT;
+
+    char* output_directory;
+    int errno_value;
+    int print_result;
+
+    output_directory = get_output_directory();
+
+    print_result = snprintf(journal_path, journal_path_size, "%s%s", output_directory, TRANSFER_JOURNAL_DIRECTORY);
+    if ( print_result < 0 || (size_t)print_result >= journal_path_size ) {
+        LOG_ERROR("The transfer journal directory path is too long.");
+        free(output_directory);
+        return GENERIC_ERROR;
+    }
+
+    if ( mkdir(journal_path, 0755) != 0 && errno != EEXIST ) {
+        errno_value = errno;
+        LOG_ERROR("Could not create the transfer journal directory.");
+        LOG_ERROR("%s", strerror(errno_value));
+        free(output_directory);
+        return GENERIC_ERROR;
+    }
+
+    print_result = snprintf(journal_path, journal_path_size, "%s%s%s", output_directory, TRANSFER_JOURNAL_DIRECTORY, TRANSFER_JOURNAL_FILE_NAME);
+    free(output_directory);
+
+    if ( print_result < 0 || (size_t)print_result >= journal_path_size ) {
+        LOG_ERROR("The transfer journal file path is too long.");
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Reads the transfers registered on the journal.
+ *
+ * Parameters
+ *  transfers - The array where the transfers will be stored. It must hold "MAXIMUM_JOURNAL_TRANSFERS" transfers.
+ *  transfers_count - The variable where the number of transfers read will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the journal was read successfully or it does not exist yet.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Lines which could not be understood are ignored, so a journal partially written does not prevent the other transfers from being resumed.
+ */
+int read_transfer_journal(transfer_t* transfers, size_t* transfers_count) {
+    LOG_TRACE_POINT;
+
+    char journal_path[TRANSFER_JOURNAL_PATH_SIZE];
+    char line[TRANSFER_JOURNAL_LINE_SIZE];
+    FILE* journal_file;
+    transfer_t* transfer;
+    uint64_t file_size;
+
+    *transfers_count = 0;
+
+    if ( get_transfer_journal_path(journal_path, TRANSFER_JOURNAL_PATH_SIZE) != SUCCESS ) {
+        LOG_ERROR("Could not build the transfer journal path.");
+        return GENERIC_ERROR;
+    }
+
+    journal_file = fopen(journal_path, "r");
+    if ( journal_file == NULL ) {
+        LOG_TRACE("There is no transfer journal yet.");
+        return SUCCESS;
+    }
+
+    while ( *transfers_count < MAXIMUM_JOURNAL_TRANSFERS && fgets(line, TRANSFER_JOURNAL_LINE_SIZE, journal_file) != NULL ) {
+        transfer = &transfers[*transfers_count];
+        line[strcspn(line, "\n")] = 0;
+
+        if ( sscanf(line, "%" SCNx32 " %" SCNu64 " %" SCNx64 " %1023[^\n]", &transfer->transfer_id, &file_size, &transfer->file_digest, transfer->file_path) != 4 || transfer->transfer_id == 0 ) {
+            LOG_WARNING("Ignoring an invalid line on the transfer journal.");
+            continue;
+        }
+
+        transfer->file_size = file_size;
+        transfer->registered = true;
+        (*transfers_count)++;
+    }
+
+    fclose(journal_file);
+
+    LOG_TRACE("Transfers read: %zu.", *transfers_count);
+    return SUCCESS;
+}
+
+/*
+ * Registers a transfer on the journal.
+ *
+ * Parameters
+ *  transfer - The transfer to be registered. If its identifier is zero, it is defined by this function.
+ *
+ * Returns
+ *  SUCCESS - If the transfer was registered successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  If the same file content is already registered, its identifier is kept, so a remote device can still resume a transfer after requesting the file again. Only the latest "MAXIMUM_JOURNAL_TRANSFERS" transfers are kept.
+ *  The journal is written and synchronized to the storage, so this function should only be called for transfers which must be resumed.
+ */
+int register_transfer(transfer_t* transfer) {
+    LOG_TRACE("File size: %zu.", transfer->file_size);
+
+    transfer_t transfers[MAXIMUM_JOURNAL_TRANSFERS];
+    size_t transfers_count;
+    transfer_t* registered_transfer;
+
+    if ( read_transfer_journal(transfers, &transfers_count) != SUCCESS ) {
+        LOG_ERROR("Could not read the transfer journal.");
+        return GENERIC_ERROR;
+    }
+
+    registered_transfer = find_file_transfer(transfers, transfers_count, transfer);
+    if ( registered_transfer != NULL ) {
+        LOG_TRACE("Transfer already registered with ID 0x%08x.", registered_transfer->transfer_id);
+        transfer->transfer_id = registered_transfer->transfer_id;
+        return SUCCESS;
+    }
+
+    if ( transfer->transfer_id == 0 ) {
+        LOG_TRACE_POINT;
+        transfer->transfer_id = create_transfer_id(transfers, transfers_count);
+    }
+
+    if ( transfers_count == MAXIMUM_JOURNAL_TRANSFERS ) {
+        memmove(&transfers[0], &transfers[1], (MAXIMUM_JOURNAL_TRANSFERS - 1)*sizeof(transfer_t));
+        transfers_count--;
+    }
+    memcpy(&transfers[transfers_count], transfer, sizeof(transfer_t));
+    transfers_count++;
+
+    if ( write_transfer_journal(transfers, transfers_count) != SUCCESS ) {
+        LOG_ERROR("Could not write the transfer journal.");
+        return GENERIC_ERROR;
+    }
+    transfer->registered = true;
+
+    LOG_TRACE("Transfer registered with ID 0x%08x.", transfer->transfer_id);
+    return SUCCESS;
+}
+
+/*
+ * Defines the identifier of a transfer without registering it on the journal.
+ *
+ * Parameters
+ *  transfer - The transfer which identifier will be defined.
+ *
+ * Returns
+ *  SUCCESS - If the transfer identifier was defined successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  If the same file content is already registered, its identifier is used. Otherwise a new identifier is created, and the transfer must be registered through "register_transfer" function if it is interrupted.
+ *  The journal is only read, so a transfer which concludes does not cost a journal write.
+ */
+int reserve_transfer(transfer_t* transfer) {
+    LOG_TRACE("File size: %zu.", transfer->file_size);
+
+    transfer_t transfers[MAXIMUM_JOURNAL_TRANSFERS];
+    size_t transfers_count;
+    transfer_t* registered_transfer;
+
+    if ( read_transfer_journal(transfers, &transfers_count) != SUCCESS ) {
+        LOG_ERROR("Could not read the transfer journal.");
+        return GENERIC_ERROR;
+    }
+
+    registered_transfer = find_file_transfer(transfers, transfers_count, transfer);
+    if ( registered_transfer != NULL ) {
+        LOG_TRACE("Transfer already registered with ID 0x%08x.", registered_transfer->transfer_id);
+        transfer->transfer_id = registered_transfer->transfer_id;
+        transfer->registered = true;
+        return SUCCESS;
+    }
+
+    transfer->transfer_id = create_transfer_id(transfers, transfers_count);
+    transfer->registered = false;
+
+    LOG_TRACE("Transfer reserved with ID 0x%08x.", transfer->transfer_id);
+    return SUCCESS;
+}
+
+/*
+ * Writes the transfers on the journal.
+ *
+ * Parameters
+ *  transfers - The transfers to be written.
+ *  transfers_count - Number of transfers to be written.
+ *
+ * Returns
+ *  SUCCESS - If the journal was written successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The transfers are written on a temporary file which replaces the journal, so a power loss while writing it does not lose the transfers already registered.
+ */
+int write_transfer_journal(transfer_t* transfers, size_t transfers_count) {
+    LOG_TRACE("Transfers count: %zu.", transfers_count);
+
+    char journal_path[TRANSFER_JOURNAL_PATH_SIZE];
+    char temporary_path[TRANSFER_JOURNAL_PATH_SIZE];
+    FILE* journal_file;
+    size_t counter;
+    int errno_value;
+    int result = SUCCESS;
+
+    if ( get_transfer_journal_path(journal_path, TRANSFER_JOURNAL_PATH_SIZE) != SUCCESS ) {
+        LOG_ERROR("Could not build the transfer journal path.");
+        return GENERIC_ERROR;
+    }
+
+    if ( strlen(journal_path) + strlen(TRANSFER_JOURNAL_TEMPORARY_SUFFIX) >= TRANSFER_JOURNAL_PATH_SIZE ) {
+        LOG_ERROR("The transfer journal temporary file path is too long.");
+        return GENERIC_ERROR;
+    }
+    strcpy(temporary_path, journal_path);
+    strcat(temporary_path, TRANSFER_JOURNAL_TEMPORARY_SUFFIX);
+
+    journal_file = fopen(temporary_path, "w");
+    if ( journal_file == NULL ) {
+        errno_value = errno;
+        LOG_ERROR("Could not open the transfer journal temporary file.");
+        LOG_ERROR("%s", strerror(errno_value));
+        return GENERIC_ERROR;
+    }
+
+    for ( counter = 0; counter < transfers_count; counter++ ) {
+        if ( fprintf(journal_file, "%08" PRIx32 " %" PRIu64 " %016" PRIx64 " %s\n", transfers[counter].transfer_id, (uint64_t)transfers[counter].file_size, transfers[counter].file_digest, transfers[counter].file_path) < 0 ) {
+            result = GENERIC_ERROR;
+            break;
+        }
+    }
+
+    if ( fflush(journal_file) != 0 || fsync(fileno(journal_file)) != 0 ) {
+        result = GENERIC_ERROR;
+    }
+
+    if ( fclose(journal_file) != 0 ) {
+        result = GENERIC_ERROR;
+    }
+
+    if ( result != SUCCESS ) {
+        errno_value = errno;
+        LOG_ERROR("Error while writing the transfer journal temporary file.");
+        LOG_ERROR("%s", strerror(errno_value));
+        remove(temporary_path);
+        return GENERIC_ERROR;
+    }
+
+    if ( rename(temporary_path, journal_path) != 0 ) {
+        errno_value = errno;
+        LOG_ERROR("Could not replace the transfer journal.");
+        LOG_ERROR("%s", strerror(errno_value));
+        remove(temporary_path);
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
@@ -0,0 +1,133 @@
+/*
+ * This source file contains the elaboration of all components required to communicate through bluetooth RFCOMM sockets.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/hci.h>
+#include <bluetooth/hci_lib.h>
+#include <bluetooth/rfcomm.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "bluetooth/transport/rfcomm.h"
+#include "bluetooth/transport/transport.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Constants.
+ */
+
+/* Local address to listen for connections. */
+const struct sockaddr_rc _rfcomm_local_address = { .rc_family = AF_BLUETOOTH, .rc_bdaddr = *BDADDR_ANY, .rc_channel = RFCOMM_CHANNEL };
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Accepts a connection from a listening RFCOMM socket.
+ *
+ * Parameters
+ *  listening_fd - The listening socket file descriptor.
+ *  connection_fd - The variable to store the connection socket file descriptor.
+ *
+ * Returns
+ *  SUCCESS - If the connection was accepted successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int accept_rfcomm_connection(int listening_fd, int* connection_fd) {
+    LOG_TRACE("Listening socket file descriptor: %d.", listening_fd);
+
+    int client_socket_file_descriptor;
+    struct sockaddr_rc remote_device_address = { 0 };
+    char remote_device_address_string[19] = { 0 };
+    char remote_device_name[256] = { 0 };
+    socklen_t address_length;
+
+    address_length = sizeof(struct sockaddr_rc);
+
+    /* Accepts one connection from the listening socket. */
+    client_socket_file_descriptor = accept(listening_fd, (struct sockaddr *)&remote_device_address, &address_length);
+    if ( client_socket_file_descriptor < 0 ) {
+        LOG_ERROR("Could not accept connection.");
+        LOG_ERROR("%s", strerror(errno));
+        return GENERIC_ERROR;
+    }
+
+    /* Converts the device address on a human-readable address. */
+    ba2str( &remote_device_address.rc_bdaddr, remote_device_address_string );
+
+    /* Requests remote device name. */
+    if (hci_read_remote_name(client_socket_file_descriptor, &(remote_device_address.rc_bdaddr), sizeof(remote_device_name), remote_device_name, 0) < 0 ){
+        LOG_TRACE("Connected with device \"%s\".", remote_device_address_string);
+    }
+    else {
+        LOG_TRACE("Connected with device \"%s\" (%s).", remote_device_name, remote_device_address_string); 
+    }
+
+    *connection_fd = client_socket_file_descriptor;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Creates a RFCOMM socket which listens for connections.
+ *
+ * Parameters
+ *  address - Not used. Connections are always listened on RFCOMM_CHANNEL, which is the channel informed on the bluetooth service.
+ *  listening_fd - The variable to store the listening socket file descriptor.
+ *
+ * Returns
+ *  SUCCESS - If the socket was created successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int listen_rfcomm_connections(const char* address, int* listening_fd) {
+    LOG_TRACE_POINT;
+
+    int listening_socket_file_descriptor;
+
+    if ( address != NULL ) {
+        LOG_WARNING("Address \"%s\" ignored. RFCOMM transport always listens on channel %d.", address, RFCOMM_CHANNEL);
+    }
+
+    /* Allocates a socket to listen to connections. */
+    listening_socket_file_descriptor = socket(AF_BLUETOOTH, SOCK_STREAM | SOCK_CLOEXEC, BTPROTO_RFCOMM);
+    if ( listening_socket_file_descriptor <= 0 ) {
+        LOG_ERROR("Could not create socket to listen for connections.");
+        return GENERIC_ERROR;
+    }
+
+    if ( bind(listening_socket_file_descriptor, (struct sockaddr *)&_rfcomm_local_address, sizeof(_rfcomm_local_address)) != 0 ) {
+        LOG_ERROR("Could not bind socket to RFCOMM channel %d.", RFCOMM_CHANNEL);
+        LOG_ERROR("%s", strerror(errno));
+        close(listening_socket_file_descriptor);
+        return GENERIC_ERROR;
+    }
+
+    /* Listens for connections on socket, keeping a queue of pending connection attempts. */
+    if ( listen(listening_socket_file_descriptor, TRANSPORT_LISTEN_BACKLOG) != 0 ) {
+        LOG_ERROR("Could not listen for connections on socket.");
+        LOG_ERROR("%s", strerror(errno));
+        close(listening_socket_file_descriptor);
+        return GENERIC_ERROR;
+    }
+
+    *listening_fd = listening_socket_file_descriptor;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
@@ -0,0 +1,143 @@
+/*
+ * This source file contains the elaboration of all components required to communicate through TCP sockets on loopback interface.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "bluetooth/transport/tcp.h"
+#include "bluetooth/transport/transport.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Accepts a connection from a listening TCP socket.
+ *
+ * Parameters
+ *  listening_fd - The listening socket file descriptor.
+ *  connection_fd - The variable to store the connection socket file descriptor.
+ *
+ * Returns
+ *  SUCCESS - If the connection was accepted successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Nagle's algorithm is disabled on the connection, since packages are small and must be confirmed before the next ones are sent.
+ */
+int accept_tcp_connection(int listening_fd, int* connection_fd) {
+    LOG_TRACE("Listening socket file descriptor: %d.", listening_fd);
+
+    int client_socket_file_descriptor;
+    int no_delay = 1;
+    struct sockaddr_in remote_address;
+    socklen_t address_length;
+
+    address_length = sizeof(struct sockaddr_in);
+
+    client_socket_file_descriptor = accept(listening_fd, (struct sockaddr *)&remote_address, &address_length);
+    if ( client_socket_file_descriptor < 0 ) {
+        LOG_ERROR("Could not accept connection.");
+        LOG_ERROR("%s", strerror(errno));
+        return GENERIC_ERROR;
+    }
+
+    if ( setsockopt(client_socket_file_descriptor, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay)) != 0 ) {
+        LOG_WARNING("Could not disable Nagle's algorithm on connection.");
+    }
+
+    LOG_TRACE("Connected with \"%s:%d\".", inet_ntoa(remote_address.sin_addr), ntohs(remote_address.sin_port));
+
+    *connection_fd = client_socket_file_descriptor;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Creates a TCP socket which listens for connections on loopback interface.
+ *
+ * Parameters
+ *  address - The TCP port to listen for connections. If NULL, TCP_DEFAULT_PORT is used.
+ *  listening_fd - The variable to store the listening socket file descriptor.
+ *
+ * Returns
+ *  SUCCESS - If the socket was created successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int listen_tcp_connections(const char* address, int* listening_fd) {
+    LOG_TRACE_POINT;
+
+    int listening_socket_file_descriptor;
+    int reuse_address = 1;
+    int port;
+    struct sockaddr_in local_address;
+
+    if ( address == NULL ) {
+        LOG_TRACE_POINT;
+        port = TCP_DEFAULT_PORT;
+    }
+    else {
+        LOG_TRACE_POINT;
+        port = atoi(address);
+    }
+
+    if ( port <= 0 || port > 65535 ) {
+        LOG_ERROR("Invalid TCP port \"%s\".", address);
+        return GENERIC_ERROR;
+    }
+
+    listening_socket_file_descriptor = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if ( listening_socket_file_descriptor < 0 ) {
+        LOG_ERROR("Could not create socket to listen for connections.");
+        LOG_ERROR("%s", strerror(errno));
+        return GENERIC_ERROR;
+    }
+
+    setsockopt(listening_socket_file_descriptor, SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof(reuse_address));
+
+    memset(&local_address, 0, sizeof(struct sockaddr_in));
+    local_address.sin_family = AF_INET;
+    local_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    local_address.sin_port = htons(port);
+
+    if ( bind(listening_socket_file_descriptor, (struct sockaddr *)&local_address, sizeof(local_address)) != 0 ) {
+        LOG_ERROR("Could not bind socket to loopback port %d.", port);
+        LOG_ERROR("%s", strerror(errno));
+        close(listening_socket_file_descriptor);
+        return GENERIC_ERROR;
+    }
+
+    /* Listens for connections on socket, keeping a queue of pending connection attempts. */
+    if ( listen(listening_socket_file_descriptor, TRANSPORT_LISTEN_BACKLOG) != 0 ) {
+        LOG_ERROR("Could not listen for connections on socket.");
+        LOG_ERROR("%s", strerror(errno));
+        close(listening_socket_file_descriptor);
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE("Listening for connections on loopback port %d.", port);
+    *listening_fd = listening_socket_file_descriptor;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
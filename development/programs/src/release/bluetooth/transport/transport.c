@@ -0,0 +1,327 @@
+/*
+ * This source file contains the elaboration of all components required to select and use the transport which carries the communication with remote devices.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "bluetooth/transport/rfcomm.h"
+#include "bluetooth/transport/tcp.h"
+#include "bluetooth/transport/transport.h"
+#include "bluetooth/transport/unix_socket.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function headers.
+ */
+
+/* Closes a socket descriptor. */
+int close_socket_descriptor(int);
+
+/* Waits until a socket descriptor has content to be read. */
+int poll_socket_descriptor(int, struct timeval);
+
+/* Reads content from a socket descriptor. */
+ssize_t read_socket_descriptor(int, void*, size_t);
+
+/* Writes content on a socket descriptor. */
+ssize_t write_socket_descriptor(int, const void*, size_t);
+
+
+/*
+ * Constants.
+ */
+
+/* Transports available. The first one is used if no other is defined. */
+const transport_t _transports[] = {
+    { .name = TRANSPORT_RFCOMM, .bluetooth = true, .listen = listen_rfcomm_connections, .accept = accept_rfcomm_connection, .read = read_socket_descriptor, .write = write_socket_descriptor, .close = close_socket_descriptor, .poll = poll_socket_descriptor },
+    { .name = TRANSPORT_UNIX, .bluetooth = false, .listen = listen_unix_socket_connections, .accept = accept_unix_socket_connection, .read = read_socket_descriptor, .write = write_socket_descriptor, .close = close_socket_descriptor, .poll = poll_socket_descriptor },
+    { .name = TRANSPORT_TCP, .bluetooth = false, .listen = listen_tcp_connections, .accept = accept_tcp_connection, .read = read_socket_descriptor, .write = write_socket_descriptor, .close = close_socket_descriptor, .poll = poll_socket_descriptor }
+};
+
+
+/*
+ * Variables.
+ */
+
+/* The transport in use. */
+const transport_t* _transport = &_transports[0];
+
+/* Address used by the transport to listen for connections. If NULL, the transport uses its default address. */
+char* _transport_address = NULL;
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Accepts a connection from a listening transport descriptor.
+ *
+ * Parameters
+ *  listening_fd - The listening descriptor.
+ *  connection_fd - The variable to store the connection descriptor.
+ *
+ * Returns
+ *  SUCCESS - If the connection was accepted successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int accept_transport_connection(int listening_fd, int* connection_fd) {
+    LOG_TRACE_POINT;
+
+    return _transport->accept(listening_fd, connection_fd);
+}
+
+/*
+ * Closes a socket descriptor.
+ *
+ * Parameters
+ *  socket_fd - The socket descriptor to be closed.
+ *
+ * Returns
+ *  The same values returned by "close" function.
+ */
+int close_socket_descriptor(int socket_fd) {
+    return close(socket_fd);
+}
+
+/*
+ * Closes a transport descriptor.
+ *
+ * Parameters
+ *  transport_fd - The descriptor to be closed.
+ *
+ * Returns
+ *  The same values returned by "close" function.
+ */
+int close_transport(int transport_fd) {
+    LOG_TRACE_POINT;
+
+    return _transport->close(transport_fd);
+}
+
+/*
+ * Returns the current transport.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The current transport.
+ */
+const transport_t* get_transport() {
+    LOG_TRACE_POINT;
+
+    return _transport;
+}
+
+/*
+ * Checks if the current transport uses bluetooth.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  True - If the current transport uses bluetooth.
+ *  False - Otherwise.
+ */
+bool is_bluetooth_transport() {
+    LOG_TRACE_POINT;
+
+    return _transport->bluetooth;
+}
+
+/*
+ * Creates a transport descriptor which listens for connections.
+ *
+ * Parameters
+ *  listening_fd - The variable to store the listening descriptor.
+ *
+ * Returns
+ *  SUCCESS - If the listening descriptor was created successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int listen_transport_connections(int* listening_fd) {
+    LOG_TRACE("Transport: \"%s\".", _transport->name);
+
+    return _transport->listen(_transport_address, listening_fd);
+}
+
+/*
+ * Waits until a socket descriptor has content to be read.
+ *
+ * Parameters
+ *  socket_fd - The socket descriptor to be checked.
+ *  wait_time - Maximum time to wait for content.
+ *
+ * Returns
+ *  The same values returned by "select" function.
+ */
+int poll_socket_descriptor(int socket_fd, struct timeval wait_time) {
+
+    int select_result;
+    fd_set socket_fd_set;
+
+    FD_ZERO(&socket_fd_set);
+    FD_SET(socket_fd, &socket_fd_set);
+    select_result = select((socket_fd+1), &socket_fd_set, (fd_set*)NULL, (fd_set*)NULL, &wait_time);
+
+    return select_result;
+}
+
+/*
+ * Waits until a transport descriptor has content to be read.
+ *
+ * Parameters
+ *  transport_fd - The descriptor to be checked.
+ *  wait_time - Maximum time to wait for content.
+ *
+ * Returns
+ *  A positive value if there is content to be read, 0 if the wait time expired and -1 if there was an error.
+ */
+int poll_transport(int transport_fd, struct timeval wait_time) {
+    LOG_TRACE_POINT;
+
+    return _transport->poll(transport_fd, wait_time);
+}
+
+/*
+ * Reads content from a socket descriptor.
+ *
+ * Parameters
+ *  socket_fd - The socket descriptor to read content.
+ *  buffer - The buffer to store the content read.
+ *  size - Maximum size of the content to be read.
+ *
+ * Returns
+ *  The same values returned by "read" function.
+ */
+ssize_t read_socket_descriptor(int socket_fd, void* buffer, size_t size) {
+    return read(socket_fd, buffer, size);
+}
+
+/*
+ * Reads content from a transport descriptor.
+ *
+ * Parameters
+ *  transport_fd - The descriptor to read content.
+ *  buffer - The buffer to store the content read.
+ *  size - Maximum size of the content to be read.
+ *
+ * Returns
+ *  The number of bytes read, 0 if the connection was closed and -1 if there was an error.
+ */
+ssize_t read_transport(int transport_fd, void* buffer, size_t size) {
+    LOG_TRACE_POINT;
+
+    return _transport->read(transport_fd, buffer, size);
+}
+
+/*
+ * Defines the transport to be used.
+ *
+ * Parameters
+ *  transport_name - Name of the transport ("RFCOMM", "UNIX" or "TCP").
+ *
+ * Returns
+ *  SUCCESS - If the transport was defined successfully.
+ *  GENERIC_ERROR - If the transport name is unknown.
+ */
+int set_transport(const char* transport_name) {
+    LOG_TRACE("Transport name: \"%s\".", transport_name);
+
+    size_t counter;
+
+    for ( counter = 0; counter < sizeof(_transports)/sizeof(transport_t); counter++ ) {
+        if ( strcmp(_transports[counter].name, transport_name) == 0 ) {
+            LOG_TRACE_POINT;
+
+            _transport = &_transports[counter];
+            return SUCCESS;
+        }
+    }
+
+    LOG_ERROR("Unknown transport \"%s\".", transport_name);
+    return GENERIC_ERROR;
+}
+
+/*
+ * Defines the address used by the transport to listen for connections.
+ *
+ * Parameters
+ *  address - The address to listen for connections. Its format depends on the transport in use (a port for "TCP", a socket file path for "UNIX").
+ *
+ * Returns
+ *  SUCCESS - If the address was defined successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int set_transport_address(const char* address) {
+    LOG_TRACE("Address: \"%s\".", address);
+
+    free(_transport_address);
+    _transport_address = NULL;
+
+    if ( address != NULL ) {
+        LOG_TRACE_POINT;
+
+        _transport_address = (char*)malloc((strlen(address)+1)*sizeof(char));
+        if ( _transport_address == NULL ) {
+            LOG_ERROR("Could not allocate memory to store transport address.");
+            return GENERIC_ERROR;
+        }
+        strcpy(_transport_address, address);
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Writes content on a socket descriptor.
+ *
+ * Parameters
+ *  socket_fd - The socket descriptor to write content.
+ *  buffer - The content to be written.
+ *  size - Size of the content to be written.
+ *
+ * Returns
+ *  The same values returned by "send" function.
+ *
+ * Observations
+ *  A write on a connection closed by the remote device fails with "EPIPE" instead of raising "SIGPIPE".
+ */
+ssize_t write_socket_descriptor(int socket_fd, const void* buffer, size_t size) {
+    return send(socket_fd, buffer, size, MSG_NOSIGNAL);
+}
+
+/*
+ * Writes content on a transport descriptor.
+ *
+ * Parameters
+ *  transport_fd - The descriptor to write content.
+ *  buffer - The content to be written.
+ *  size - Size of the content to be written.
+ *
+ * Returns
+ *  The number of bytes written or -1 if there was an error.
+ */
+ssize_t write_transport(int transport_fd, const void* buffer, size_t size) {
+    LOG_TRACE_POINT;
+
+    return _transport->write(transport_fd, buffer, size);
+}
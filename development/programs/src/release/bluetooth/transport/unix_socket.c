@@ -0,0 +1,131 @@
+/*
+ * This source file contains the elaboration of all components required to communicate through local (AF_UNIX) sockets.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "bluetooth/transport/unix_socket.h"
+#include "bluetooth/transport/transport.h"
+#include "directory.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Accepts a connection from a listening local socket.
+ *
+ * Parameters
+ *  listening_fd - The listening socket file descriptor.
+ *  connection_fd - The variable to store the connection socket file descriptor.
+ *
+ * Returns
+ *  SUCCESS - If the connection was accepted successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int accept_unix_socket_connection(int listening_fd, int* connection_fd) {
+    LOG_TRACE("Listening socket file descriptor: %d.", listening_fd);
+
+    int client_socket_file_descriptor;
+
+    client_socket_file_descriptor = accept(listening_fd, NULL, NULL);
+    if ( client_socket_file_descriptor < 0 ) {
+        LOG_ERROR("Could not accept connection.");
+        LOG_ERROR("%s", strerror(errno));
+        return GENERIC_ERROR;
+    }
+
+    *connection_fd = client_socket_file_descriptor;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Creates a local socket which listens for connections.
+ *
+ * Parameters
+ *  address - Path of the socket file. If NULL, UNIX_SOCKET_DEFAULT_FILE_NAME is created on output directory.
+ *  listening_fd - The variable to store the listening socket file descriptor.
+ *
+ * Returns
+ *  SUCCESS - If the socket was created successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  A previous socket file left on the path informed is removed.
+ */
+int listen_unix_socket_connections(const char* address, int* listening_fd) {
+    LOG_TRACE_POINT;
+
+    int listening_socket_file_descriptor;
+    char* output_directory;
+    struct sockaddr_un local_address;
+
+    memset(&local_address, 0, sizeof(struct sockaddr_un));
+    local_address.sun_family = AF_UNIX;
+
+    if ( address == NULL ) {
+        LOG_TRACE_POINT;
+
+        output_directory = get_output_directory();
+        snprintf(local_address.sun_path, sizeof(local_address.sun_path), "%s%s", output_directory, UNIX_SOCKET_DEFAULT_FILE_NAME);
+        free(output_directory);
+    }
+    else {
+        LOG_TRACE_POINT;
+
+        if ( strlen(address) >= sizeof(local_address.sun_path) ) {
+            LOG_ERROR("Socket file path \"%s\" is too long.", address);
+            return GENERIC_ERROR;
+        }
+        strcpy(local_address.sun_path, address);
+    }
+
+    listening_socket_file_descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if ( listening_socket_file_descriptor < 0 ) {
+        LOG_ERROR("Could not create socket to listen for connections.");
+        LOG_ERROR("%s", strerror(errno));
+        return GENERIC_ERROR;
+    }
+
+    unlink(local_address.sun_path);
+
+    if ( bind(listening_socket_file_descriptor, (struct sockaddr *)&local_address, sizeof(local_address)) != 0 ) {
+        LOG_ERROR("Could not bind socket to \"%s\".", local_address.sun_path);
+        LOG_ERROR("%s", strerror(errno));
+        close(listening_socket_file_descriptor);
+        return GENERIC_ERROR;
+    }
+
+    /* Listens for connections on socket, keeping a queue of pending connection attempts. */
+    if ( listen(listening_socket_file_descriptor, TRANSPORT_LISTEN_BACKLOG) != 0 ) {
+        LOG_ERROR("Could not listen for connections on socket.");
+        LOG_ERROR("%s", strerror(errno));
+        close(listening_socket_file_descriptor);
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE("Listening for connections on \"%s\".", local_address.sun_path);
+    *listening_fd = listening_socket_file_descriptor;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
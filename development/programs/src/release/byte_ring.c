@@ -0,0 +1,266 @@
+/*
+ * This source file contains the elaboration of all components required to exchange bytes between two threads through a ring.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "byte_ring.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Creates a byte ring.
+ *
+ * Parameters
+ *  byte_ring - The byte ring to be created.
+ *  minimum_size - The minimum number of bytes the ring must hold. The size is rounded up to a power of two.
+ *
+ * Returns
+ *  SUCCESS - If the byte ring was created successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The ring is written once after allocation, so the thread writing on it does not wait for its pages to be mapped.
+ */
+int create_byte_ring(byte_ring_t* byte_ring, size_t minimum_size) {
+    LOG_TRACE("Minimum size: %zu.", minimum_size);
+
+    size_t size = 1;
+
+    while ( size < minimum_size ) {
+        size <<= 1;
+    }
+
+    byte_ring->data = (uint8_t*)malloc(size);
+    if ( byte_ring->data == NULL ) {
+        LOG_ERROR("Could not allocate %zu bytes for the byte ring.", size);
+        byte_ring->size = 0;
+        return GENERIC_ERROR;
+    }
+
+    memset(byte_ring->data, 0, size);
+    byte_ring->size = size;
+    reset_byte_ring(byte_ring);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Deletes a byte ring.
+ *
+ * Parameters
+ *  byte_ring - The byte ring to be deleted.
+ *
+ * Returns
+ *  SUCCESS - If the byte ring was deleted successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int delete_byte_ring(byte_ring_t* byte_ring) {
+    LOG_TRACE_POINT;
+
+    if ( byte_ring == NULL ) {
+        LOG_ERROR("Byte ring is null.");
+        return GENERIC_ERROR;
+    }
+
+    free(byte_ring->data);
+    byte_ring->data = NULL;
+    byte_ring->size = 0;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Discards bytes waiting to be read from a byte ring.
+ *
+ * Parameters
+ *  byte_ring - The byte ring which content will be discarded.
+ *  size - The number of bytes to be discarded, starting from the oldest.
+ *
+ * Returns
+ *  The number of bytes discarded. It is less than requested if there are not enough bytes waiting to be read.
+ *
+ * Observations
+ *  Only the thread which reads the ring can discard its content. This function is called by audio threads, so it must not use log macros.
+ */
+size_t discard_byte_ring(byte_ring_t* byte_ring, size_t size) {
+
+    size_t read_position;
+    size_t content_size;
+
+    read_position = atomic_load_explicit(&byte_ring->read_position, memory_order_relaxed);
+    content_size = atomic_load_explicit(&byte_ring->write_position, memory_order_acquire) - read_position;
+
+    if ( size > content_size ) {
+        size = content_size;
+    }
+
+    atomic_store_explicit(&byte_ring->read_position, read_position + size, memory_order_release);
+
+    return size;
+}
+
+/*
+ * Returns the number of bytes waiting to be read from a byte ring.
+ *
+ * Parameters
+ *  byte_ring - The byte ring to be checked.
+ *
+ * Returns
+ *  The number of bytes waiting to be read.
+ *
+ * Observations
+ *  This function can be called by the threads which write and read the ring, so it must not use log macros.
+ */
+size_t get_byte_ring_content_size(byte_ring_t* byte_ring) {
+
+    return atomic_load_explicit(&byte_ring->write_position, memory_order_acquire) - atomic_load_explicit(&byte_ring->read_position, memory_order_acquire);
+}
+
+/*
+ * Returns the highest number of bytes waited to be read from a byte ring.
+ *
+ * Parameters
+ *  byte_ring - The byte ring to be checked.
+ *
+ * Returns
+ *  The highest number of bytes waited to be read since the ring was reset.
+ *
+ * Observations
+ *  This function can be called by the threads which write and read the ring, so it must not use log macros.
+ */
+size_t get_byte_ring_high_water_mark(byte_ring_t* byte_ring) {
+
+    return atomic_load_explicit(&byte_ring->high_water_mark, memory_order_relaxed);
+}
+
+/*
+ * Reads bytes from a byte ring.
+ *
+ * Parameters
+ *  byte_ring - The byte ring to be read.
+ *  buffer - The buffer where the bytes read will be copied.
+ *  buffer_size - The size of the buffer.
+ *
+ * Returns
+ *  The number of bytes copied to the buffer. It can be zero if there is nothing waiting to be read.
+ *
+ * Observations
+ *  Only one thread can read a byte ring. This function is called by audio threads, so it must not use log macros.
+ */
+size_t read_byte_ring(byte_ring_t* byte_ring, uint8_t* buffer, size_t buffer_size) {
+
+    size_t read_position;
+    size_t content_size;
+    size_t offset;
+    size_t first_part_size;
+
+    read_position = atomic_load_explicit(&byte_ring->read_position, memory_order_relaxed);
+    content_size = atomic_load_explicit(&byte_ring->write_position, memory_order_acquire) - read_position;
+
+    if ( content_size > buffer_size ) {
+        content_size = buffer_size;
+    }
+
+    if ( content_size == 0 ) {
+        return 0;
+    }
+
+    offset = read_position & ( byte_ring->size - 1 );
+    first_part_size = byte_ring->size - offset;
+    if ( first_part_size > content_size ) {
+        first_part_size = content_size;
+    }
+
+    memcpy(buffer, byte_ring->data + offset, first_part_size);
+    memcpy(buffer + first_part_size, byte_ring->data, content_size - first_part_size);
+
+    atomic_store_explicit(&byte_ring->read_position, read_position + content_size, memory_order_release);
+
+    return content_size;
+}
+
+/*
+ * Discards the content of a byte ring.
+ *
+ * Parameters
+ *  byte_ring - The byte ring to be reset.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  Must only be called while no thread is reading or writing the ring.
+ */
+void reset_byte_ring(byte_ring_t* byte_ring) {
+
+    atomic_store(&byte_ring->write_position, 0);
+    atomic_store(&byte_ring->read_position, 0);
+    atomic_store(&byte_ring->high_water_mark, 0);
+}
+
+/*
+ * Writes bytes on a byte ring.
+ *
+ * Parameters
+ *  byte_ring - The byte ring to be written.
+ *  content - The bytes to be written.
+ *  content_size - The number of bytes to be written.
+ *
+ * Returns
+ *  True - If the bytes were written.
+ *  False - If the ring does not have space for all bytes. Nothing is written in this case.
+ *
+ * Observations
+ *  Only one thread can write on a byte ring. This function is called by audio threads, so it must not use log macros.
+ */
+bool write_byte_ring(byte_ring_t* byte_ring, const uint8_t* content, size_t content_size) {
+
+    size_t write_position;
+    size_t content_waiting;
+    size_t offset;
+    size_t first_part_size;
+
+    write_position = atomic_load_explicit(&byte_ring->write_position, memory_order_relaxed);
+    content_waiting = write_position - atomic_load_explicit(&byte_ring->read_position, memory_order_acquire);
+
+    if ( content_size > byte_ring->size - content_waiting ) {
+        return false;
+    }
+
+    offset = write_position & ( byte_ring->size - 1 );
+    first_part_size = byte_ring->size - offset;
+    if ( first_part_size > content_size ) {
+        first_part_size = content_size;
+    }
+
+    memcpy(byte_ring->data + offset, content, first_part_size);
+    memcpy(byte_ring->data, content + first_part_size, content_size - first_part_size);
+
+    atomic_store_explicit(&byte_ring->write_position, write_position + content_size, memory_order_release);
+
+    content_waiting += content_size;
+    if ( content_waiting > atomic_load_explicit(&byte_ring->high_water_mark, memory_order_relaxed) ) {
+        atomic_store_explicit(&byte_ring->high_water_mark, content_waiting, memory_order_relaxed);
+    }
+
+    return true;
+}
@@ -0,0 +1,279 @@
+/*
+ * This source file contains the elaboration of all components required to calculate digests of file contents.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "digest.h"
+#include "log.h"
+#include "return_codes.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Multiplier used to update the digest on each byte. */
+#define DIGEST_PRIME 0x100000001b3ULL
+
+/* Size of the blocks read from a file to calculate its digest. */
+#define DIGEST_BLOCK_SIZE 1024*64
+
+/* Number of bytes read from the start and from the end of a file prefix to check it was not rewritten. */
+#define DIGEST_CHECK_SIZE 1024*4
+
+
+/*
+ * Structures.
+ */
+
+/* The last digest calculated from a file, so the digest of a growing file can continue from where it stopped. */
+typedef struct {
+    char file_path[PATH_MAX];
+    dev_t device;
+    ino_t inode;
+    off_t file_size;
+    struct timespec modification_time;
+    size_t length;
+    uint64_t digest;
+    uint64_t check_digest;
+    bool valid;
+} file_digest_cache_t;
+
+
+/*
+ * Variables.
+ */
+
+/* The last digest calculated from a file by each thread. Each thread keeps its own, so the audio catalog updater neither races with the commands nor discards the digest of a file being transferred. */
+_Thread_local file_digest_cache_t _file_digest_cache = { .valid = false };
+
+
+/*
+ * Function headers.
+ */
+
+/* Calculates the digest of the bytes at the start and at the end of a file prefix. */
+int get_file_check_digest(int, size_t, uint8_t*, uint64_t*);
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Calculates the digest of the bytes at the start and at the end of a file prefix.
+ *
+ * Parameters
+ *  file_fd - Descriptor of the file.
+ *  length - Number of bytes of the file prefix.
+ *  buffer - A buffer with at least "DIGEST_CHECK_SIZE" bytes to read the file.
+ *  check_digest - The variable where the digest will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the digest was calculated successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Only "DIGEST_CHECK_SIZE" bytes are read from each end of the prefix, so the digest is a cheap sample to find out a file was rewritten. It does not replace the digest of the whole prefix.
+ */
+int get_file_check_digest(int file_fd, size_t length, uint8_t* buffer, uint64_t* check_digest) {
+    LOG_TRACE("Length: %zu.", length);
+
+    size_t check_size = ( length < DIGEST_CHECK_SIZE ? length : DIGEST_CHECK_SIZE );
+    uint64_t result_digest = DIGEST_INITIAL_VALUE;
+
+    if ( check_size > 0 ) {
+        if ( pread(file_fd, buffer, check_size, 0) != (ssize_t)check_size ) {
+            LOG_TRACE_POINT;
+            return GENERIC_ERROR;
+        }
+        result_digest = update_digest(result_digest, buffer, check_size);
+
+        if ( pread(file_fd, buffer, check_size, length - check_size) != (ssize_t)check_size ) {
+            LOG_TRACE_POINT;
+            return GENERIC_ERROR;
+        }
+        result_digest = update_digest(result_digest, buffer, check_size);
+    }
+
+    *check_digest = result_digest;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Calculates the digest of the first bytes of a file.
+ *
+ * Parameters
+ *  file_path - Path to the file.
+ *  length - Number of bytes from the file start to calculate the digest.
+ *  digest - The variable where the digest will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the digest was calculated successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Audio records are only appended while recorded, so the digest of the last file is kept and a later request for a longer prefix of the same file only reads the bytes appended since then. The digest kept is discarded if the file was modified without growing, if its modification time went back or if the bytes sampled from the prefix digested changed, which happens when the file is rewritten and then grows on the same inode.
+ *  The digest is kept for the thread which calculated it, so this function can be called by several threads.
+ */
+int get_file_digest(char* file_path, size_t length, uint64_t* digest) {
+    LOG_TRACE("File path: \"%s\", length: %zu.", file_path, length);
+
+    int errno_value;
+    int file_fd;
+    struct stat file_stat;
+    uint8_t* buffer;
+    size_t position = 0;
+    size_t read_size;
+    ssize_t read_result;
+    uint64_t result_digest = DIGEST_INITIAL_VALUE;
+    uint64_t check_digest;
+    bool continue_digest;
+    int result = SUCCESS;
+
+    file_fd = open(file_path, O_RDONLY);
+    if ( file_fd == -1 ) {
+        errno_value = errno;
+        LOG_ERROR("Could not open file \"%s\".", file_path);
+        LOG_ERROR("%s", strerror(errno_value));
+        return GENERIC_ERROR;
+    }
+
+    if ( fstat(file_fd, &file_stat) != 0 || (size_t)file_stat.st_size < length ) {
+        LOG_ERROR("File \"%s\" does not have %zu bytes.", file_path, length);
+        close(file_fd);
+        return GENERIC_ERROR;
+    }
+
+    buffer = (uint8_t*)malloc(DIGEST_BLOCK_SIZE);
+    if ( buffer == NULL ) {
+        LOG_ERROR("Could not allocate memory to read file \"%s\".", file_path);
+        close(file_fd);
+        return GENERIC_ERROR;
+    }
+
+    continue_digest = ( _file_digest_cache.valid == true &&
+                        _file_digest_cache.device == file_stat.st_dev &&
+                        _file_digest_cache.inode == file_stat.st_ino &&
+                        _file_digest_cache.length <= length &&
+                        ( file_stat.st_mtim.tv_sec > _file_digest_cache.modification_time.tv_sec ||
+                          ( file_stat.st_mtim.tv_sec == _file_digest_cache.modification_time.tv_sec &&
+                            file_stat.st_mtim.tv_nsec >= _file_digest_cache.modification_time.tv_nsec ) ) &&
+                        ( file_stat.st_size > _file_digest_cache.file_size ||
+                          ( file_stat.st_size == _file_digest_cache.file_size &&
+                            file_stat.st_mtim.tv_sec == _file_digest_cache.modification_time.tv_sec &&
+                            file_stat.st_mtim.tv_nsec == _file_digest_cache.modification_time.tv_nsec ) ) &&
+                        strcmp(_file_digest_cache.file_path, file_path) == 0 );
+
+    if ( continue_digest == true && file_stat.st_size != _file_digest_cache.file_size ) {
+        LOG_TRACE_POINT;
+
+        if ( get_file_check_digest(file_fd, _file_digest_cache.length, buffer, &check_digest) != SUCCESS || check_digest != _file_digest_cache.check_digest ) {
+            LOG_TRACE("File was rewritten since its digest was calculated.");
+            continue_digest = false;
+        }
+    }
+
+    if ( continue_digest == true ) {
+        LOG_TRACE("Continuing digest from byte %zu.", _file_digest_cache.length);
+        position = _file_digest_cache.length;
+        result_digest = _file_digest_cache.digest;
+    }
+
+    while ( position < length ) {
+        read_size = length - position;
+        if ( read_size > DIGEST_BLOCK_SIZE ) {
+            read_size = DIGEST_BLOCK_SIZE;
+        }
+
+        read_result = pread(file_fd, buffer, read_size, position);
+        if ( read_result <= 0 ) {
+            errno_value = errno;
+            LOG_ERROR("Error while reading file \"%s\".", file_path);
+            LOG_ERROR("%s", strerror(errno_value));
+            result = GENERIC_ERROR;
+            break;
+        }
+
+        result_digest = update_digest(result_digest, buffer, read_result);
+        position += read_result;
+    }
+
+    if ( result == SUCCESS && get_file_check_digest(file_fd, length, buffer, &check_digest) != SUCCESS ) {
+        LOG_ERROR("Error while reading file \"%s\".", file_path);
+        result = GENERIC_ERROR;
+    }
+
+    free(buffer);
+    close(file_fd);
+
+    if ( result != SUCCESS ) {
+        LOG_TRACE_POINT;
+        return result;
+    }
+
+    if ( strlen(file_path) < PATH_MAX ) {
+        strcpy(_file_digest_cache.file_path, file_path);
+        _file_digest_cache.device = file_stat.st_dev;
+        _file_digest_cache.inode = file_stat.st_ino;
+        _file_digest_cache.file_size = file_stat.st_size;
+        _file_digest_cache.modification_time = file_stat.st_mtim;
+        _file_digest_cache.length = length;
+        _file_digest_cache.digest = result_digest;
+        _file_digest_cache.check_digest = check_digest;
+        _file_digest_cache.valid = true;
+    }
+
+    *digest = result_digest;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Updates a digest with more content.
+ *
+ * Parameters
+ *  digest - The digest of the content before this one. "DIGEST_INITIAL_VALUE" if there was no content before.
+ *  content - The content to update the digest.
+ *  content_size - Size of the content.
+ *
+ * Returns
+ *  The digest updated.
+ *
+ * Observations
+ *  The digest is a 64-bit FNV-1a hash. It detects files which differ from what the remote device has, but it must not be used where content can be forged.
+ */
+uint64_t update_digest(uint64_t digest, const uint8_t* content, size_t content_size) {
+    LOG_TRACE("Content size: %zu.", content_size);
+
+    size_t counter;
+
+    for ( counter = 0; counter < content_size; counter++ ) {
+        digest ^= content[counter];
+        digest *= DIGEST_PRIME;
+    }
+
+    LOG_TRACE_POINT;
+    return digest;
+}
@@ -43,5 +43,8 @@ const char* error_messages[] = {
     ERROR_MESSAGE_019,
     ERROR_MESSAGE_020,
     ERROR_MESSAGE_021,
-    ERROR_MESSAGE_022
+    ERROR_MESSAGE_022,
+    ERROR_MESSAGE_023,
+    ERROR_MESSAGE_024,
+    ERROR_MESSAGE_025
 };
@@ -13,7 +13,9 @@
  */
 
 #include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -155,3 +157,58 @@ size_t get_file_size(char* file_path) {
     }
 
 } */
+
+/*
+ * Reads the value stored on the first line of a file.
+ *
+ * Parameters
+ *  file_path - Path to the file to be read.
+ *  value - The buffer where the value read will be stored.
+ *  value_size - The size of the buffer.
+ *
+ * Returns
+ *  SUCCESS - If the value was read successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The line break and any blank characters at the end of the line are not stored on the value.
+ */
+int read_file_value(char* file_path, char* value, size_t value_size) {
+    LOG_TRACE("File path: \"%s\".", file_path);
+
+    FILE* file;
+    size_t value_length;
+    int result;
+
+    file = fopen(file_path, "r");
+    if ( file == NULL ) {
+        LOG_ERROR("Could not open file \"%s\".", file_path);
+        LOG_ERROR("%s", strerror(errno));
+        return GENERIC_ERROR;
+    }
+
+    if ( fgets(value, value_size, file) == NULL ) {
+        LOG_ERROR("Could not read a value from file \"%s\".", file_path);
+        result = GENERIC_ERROR;
+    }
+    else {
+        value_length = strcspn(value, "\r\n");
+        while ( value_length > 0 && ( value[value_length - 1] == ' ' || value[value_length - 1] == '\t' ) ) {
+            value_length--;
+        }
+        value[value_length] = '\0';
+
+        if ( value[0] == '\0' ) {
+            LOG_ERROR("File \"%s\" does not have a value.", file_path);
+            result = GENERIC_ERROR;
+        }
+        else {
+            result = SUCCESS;
+        }
+    }
+
+    fclose(file);
+
+    LOG_TRACE_POINT;
+    return result;
+}
@@ -16,28 +16,64 @@
  * Includes.
  */
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/time.h>
+#include <sys/types.h>
+
+
+/*
+ * Structures.
+ */
+
+/* Paths of the audio segments of an audio record. */
+typedef struct {
+    char** paths;
+    size_t count;
+} audio_segments_t;
 
 
 /*
  * Function headers.
  */
 
+/* Adds the latest audio record to the audio catalog with the instants it was started and stopped. */
+int catalog_latest_audio_record();
+
+/* Releases the memory used by a list of audio segments. */
+void delete_audio_segments(audio_segments_t*);
+
+/* Returns the time of audio captured before the latest audio record was started. */
+struct timeval get_audio_record_pre_roll();
+
 /* Returns the latest audio record file path. */
 char* get_latest_audio_record();
 
-/* Returns the path of the file which the start audio record instant is stored. */
-char* get_start_audio_record_instant_file_path();
-
-/* Returns the path of the file which the stop audio record instant is stored. */
-char* get_stop_audio_record_instant_file_path();
+/* Returns the audio segments of the latest audio record which will not change anymore. */
+int get_latest_audio_record_segments(audio_segments_t*);
 
 /* Checks if device is recording. */
 bool is_recording();
 
+/* Reads the audio encoded to be streamed. */
+ssize_t read_audio_stream(uint8_t*, size_t);
+
+/* Starts capturing audio to be used as pre-roll of the audio records. */
+int start_audio_pre_roll();
+
 /* Starts audio record. */
 int start_audio_record();
 
+/* Starts streaming the audio being recorded. */
+int start_audio_stream();
+
+/* Stops capturing audio to be used as pre-roll of the audio records. */
+int stop_audio_pre_roll();
+
 /* Stops audio record. */
 int stop_audio_record();
 
+/* Stops streaming the audio being recorded. */
+int stop_audio_stream();
+
 #endif
@@ -0,0 +1,107 @@
+/*
+ * This header file contains the declaration of all components required to capture audio from a PCM device.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef AUDIO_CAPTURE_H
+#define AUDIO_CAPTURE_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/time.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Code returned when there is audio captured waiting to be read. */
+#define AUDIO_CAPTURED 50
+
+/* Code returned when the audio capture or its delivery has finished and all audio captured was read. */
+#define AUDIO_CAPTURE_FINISHED 51
+
+/* Code returned when no audio was captured before the wait time has elapsed. */
+#define AUDIO_CAPTURE_WAIT_TIME_ELAPSED 52
+
+/* Maximum size of the record device name. */
+#define AUDIO_CAPTURE_RECORD_DEVICE_SIZE 128
+
+/* Maximum size of the sample format name. */
+#define AUDIO_CAPTURE_SAMPLE_FORMAT_SIZE 32
+
+
+/*
+ * Structures.
+ */
+
+/* Configuration used to capture audio. */
+typedef struct {
+    char record_device[AUDIO_CAPTURE_RECORD_DEVICE_SIZE];
+    char sample_format[AUDIO_CAPTURE_SAMPLE_FORMAT_SIZE];
+    unsigned int channels;
+    unsigned int sampling_rate;
+    unsigned int buffer_length;
+    unsigned int pre_roll_length;
+    unsigned int pre_roll_memory;
+} audio_capture_configuration_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Returns the number of bytes discarded because the audio capture ring was full. */
+uint64_t get_audio_capture_dropped_bytes();
+
+/* Returns the number of overruns recovered on the PCM device. */
+uint64_t get_audio_capture_overruns();
+
+/* Returns the maximum number of bytes of audio kept before an audio record is started. */
+size_t get_audio_capture_pre_roll_size();
+
+/* Returns the highest number of bytes waited to be read on the audio capture ring. */
+size_t get_audio_capture_ring_high_water_mark();
+
+/* Returns the size of the audio capture ring. */
+size_t get_audio_capture_ring_size();
+
+/* Checks if audio is being captured. */
+bool is_audio_capture_running();
+
+/* Reads the audio captured. */
+size_t read_audio_capture(uint8_t*, size_t);
+
+/* Reads the audio capture configuration. */
+int read_audio_capture_configuration(audio_capture_configuration_t*);
+
+/* Resumes keeping the audio captured as pre-roll after its delivery was stopped. */
+int resume_audio_capture_pre_roll();
+
+/* Starts the audio capture. */
+int start_audio_capture(audio_capture_configuration_t*);
+
+/* Starts delivering the audio captured to the thread which consumes it. */
+int start_audio_capture_delivery(struct timeval*);
+
+/* Stops the audio capture. */
+int stop_audio_capture();
+
+/* Stops delivering the audio captured to the thread which consumes it. */
+int stop_audio_capture_delivery();
+
+/* Waits until there is audio captured to be read. */
+int wait_audio_capture(int);
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * This header file contains the declaration of all components required to keep a catalog of the audio records.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef AUDIO_CATALOG_H
+#define AUDIO_CATALOG_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/time.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Code returned when an audio record is not on the catalog. */
+#define AUDIO_CATALOG_RECORD_NOT_FOUND 50
+
+/* Maximum size of an audio record file name on the catalog. */
+#define AUDIO_CATALOG_NAME_SIZE 64
+
+/* Size of an audio catalog record when stored or transmitted. */
+#define AUDIO_CATALOG_RECORD_SIZE 120
+
+/* Flag of the audio catalog records whose audio record file was removed. */
+#define AUDIO_CATALOG_RECORD_REMOVED 0x00000001
+
+/* Flag of the audio catalog records whose checksum was not calculated yet. */
+#define AUDIO_CATALOG_RECORD_CHECKSUM_PENDING 0x00000002
+
+
+/*
+ * Structures.
+ */
+
+/* Informations of an audio record on the catalog. Instants are in microseconds since the epoch and the duration is in milliseconds. Its fields are aligned, so the records can be read directly from the catalog file. */
+typedef struct {
+    uint32_t record_id;
+    uint32_t flags;
+    uint64_t size;
+    uint64_t checksum;
+    int64_t start_instant;
+    int64_t stop_instant;
+    int64_t modification_instant;
+    uint32_t duration;
+    uint32_t reserved;
+    char name[AUDIO_CATALOG_NAME_SIZE];
+} audio_catalog_record_t;
+
+_Static_assert(sizeof(audio_catalog_record_t) == AUDIO_CATALOG_RECORD_SIZE, "Audio catalog records must not have padding.");
+
+
+/*
+ * Function headers.
+ */
+
+/* Finds an audio record on the catalog. */
+int find_audio_catalog_record(uint32_t, audio_catalog_record_t*);
+
+/* Returns the path of an audio catalog record file. */
+char* get_audio_catalog_record_path(const audio_catalog_record_t*);
+
+/* Lists a page of the audio records on the catalog. */
+int list_audio_catalog_records(uint32_t, audio_catalog_record_t*, size_t, size_t*, uint32_t*);
+
+/* Defines the start and stop instants of an audio record on the catalog. */
+int set_audio_catalog_record_instants(const char*, struct timeval, struct timeval);
+
+/* Starts the audio catalog. */
+int start_audio_catalog();
+
+/* Starts the audio catalog updater. */
+int start_audio_catalog_updater();
+
+/* Stops the audio catalog. */
+int stop_audio_catalog();
+
+/* Stops the audio catalog updater. */
+int stop_audio_catalog_updater();
+
+/* Updates the audio catalog with the audio records stored. */
+int update_audio_catalog();
+
+#endif
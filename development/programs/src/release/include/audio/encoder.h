@@ -0,0 +1,101 @@
+/*
+ * This header file contains the declaration of all components required to encode the audio captured.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef AUDIO_ENCODER_H
+#define AUDIO_ENCODER_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "audio/capture.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Maximum size of the comment written on the audio files. */
+#define AUDIO_ENCODER_COMMENT_SIZE 256
+
+/* Maximum size of an audio file path. */
+#define AUDIO_ENCODER_FILE_PATH_SIZE 512
+
+
+/*
+ * Structures.
+ */
+
+/* Configuration used to encode audio. */
+typedef struct {
+    unsigned int sample_rate;
+    unsigned int bit_width;
+    char channel_mode;
+    unsigned int quality;
+    unsigned int segment_length;
+    char comment[AUDIO_ENCODER_COMMENT_SIZE];
+} audio_encoder_configuration_t;
+
+/* Counters of the audio encoder. */
+typedef struct {
+    size_t capture_ring_size;
+    size_t capture_ring_high_water_mark;
+    uint64_t capture_overruns;
+    uint64_t capture_dropped_bytes;
+    uint64_t frames_encoded;
+    uint64_t encode_time;
+    size_t output_ring_size;
+    size_t output_ring_high_water_mark;
+    uint64_t output_stalls;
+    uint64_t segments_closed;
+    uint64_t stream_dropped_bytes;
+} audio_encoder_statistics_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Returns the path of the audio file being encoded. */
+char* get_audio_encoder_file_path();
+
+/* Returns the path of the manifest which lists the audio segments closed. */
+char* get_audio_encoder_manifest_path();
+
+/* Returns the counters of the audio encoder. */
+audio_encoder_statistics_t get_audio_encoder_statistics();
+
+/* Checks if the audio encoder is started. */
+bool is_audio_encoder_running();
+
+/* Reads the audio encoder configuration. */
+int read_audio_encoder_configuration(audio_encoder_configuration_t*);
+
+/* Reads the audio encoded to be streamed. */
+size_t read_audio_encoder_stream(uint8_t*, size_t);
+
+/* Starts the audio encoder. */
+int start_audio_encoder(audio_encoder_configuration_t*, audio_capture_configuration_t*);
+
+/* Starts copying the audio encoded to the stream ring. */
+int start_audio_encoder_stream();
+
+/* Stops the audio encoder. */
+int stop_audio_encoder();
+
+/* Stops copying the audio encoded to the stream ring. */
+int stop_audio_encoder_stream();
+
+#endif
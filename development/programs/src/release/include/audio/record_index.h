@@ -0,0 +1,77 @@
+/*
+ * This header file contains the declaration of all components required to keep an index of the audio records stored.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef AUDIO_RECORD_INDEX_H
+#define AUDIO_RECORD_INDEX_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <time.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Maximum size of an audio record file name. */
+#define AUDIO_RECORD_NAME_SIZE 256
+
+
+/*
+ * Structures.
+ */
+
+/* An audio record stored on the audio directory. */
+typedef struct {
+    char name[AUDIO_RECORD_NAME_SIZE];
+    off_t size;
+    struct timespec modification_time;
+    uint32_t duration;
+} audio_record_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Returns the descriptor which informs the changes on the audio directory. */
+int get_audio_record_index_fd();
+
+/* Returns an audio record of the index. */
+const audio_record_t* get_indexed_audio_record(size_t);
+
+/* Returns the number of audio records on the index. */
+size_t get_indexed_audio_records_count();
+
+/* Returns the latest audio record of the index. */
+const audio_record_t* get_latest_indexed_audio_record();
+
+/* Locks the index, so other threads cannot read nor update it. */
+void lock_audio_record_index();
+
+/* Starts the audio record index. */
+int start_audio_record_index();
+
+/* Stops the audio record index. */
+int stop_audio_record_index();
+
+/* Unlocks the index, so other threads can read and update it. */
+void unlock_audio_record_index();
+
+/* Updates the audio record index with the changes made on the audio directory. */
+int update_audio_record_index();
+
+#endif
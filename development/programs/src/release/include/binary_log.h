@@ -0,0 +1,135 @@
+/*
+ * This header file contains the declaration of all components required to encode and decode binary log files.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef BINARY_LOG_H
+#define BINARY_LOG_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Characters which identify a binary log file. */
+#define BINARY_LOG_MAGIC "ANNALOG"
+
+/* Size of the characters which identify a binary log file (including the null character). */
+#define BINARY_LOG_MAGIC_SIZE 8
+
+/* Version of the binary log format. */
+#define BINARY_LOG_VERSION 2
+
+/* Size of a binary log header when encoded. */
+#define BINARY_LOG_HEADER_SIZE (BINARY_LOG_MAGIC_SIZE + sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint64_t))
+
+/* Call site identifier of the record which informs the log was finished. */
+#define BINARY_LOG_END_OF_LOG 0
+
+/* Flag set on the first integer of a record to inform it defines a call site. The other bits store the call site identifier. */
+#define BINARY_LOG_CALL_SITE_DEFINITION 1
+
+/* Maximum size of a variable length integer when encoded. */
+#define BINARY_LOG_VARINT_MAXIMUM_SIZE 10
+
+/* Maximum size of a record header (call site identifier, thread identifier, timestamp and arguments size) when encoded. */
+#define BINARY_LOG_RECORD_HEADER_MAXIMUM_SIZE (4*BINARY_LOG_VARINT_MAXIMUM_SIZE)
+
+/* Maximum size of each string of a call site when encoded. Longer strings are truncated. */
+#define BINARY_LOG_MAXIMUM_STRING_SIZE 255
+
+/* Maximum size of a call site when encoded. */
+#define BINARY_LOG_CALL_SITE_MAXIMUM_SIZE (3*BINARY_LOG_VARINT_MAXIMUM_SIZE + 3*(BINARY_LOG_VARINT_MAXIMUM_SIZE + BINARY_LOG_MAXIMUM_STRING_SIZE))
+
+/* Code returned when the binary log data ends before the element being decoded. */
+#define BINARY_LOG_TRUNCATED 50
+
+
+/*
+ * Structures.
+ */
+
+/* Informations stored on the beginning of a binary log file. */
+typedef struct {
+    uint32_t version;
+    int64_t real_time;
+    uint64_t monotonic_time;
+} binary_log_header_t;
+
+/* Informations stored on the beginning of a binary log record. */
+typedef struct {
+    uint32_t call_site_identifier;
+    bool call_site_definition;
+    uint32_t thread_identifier;
+    int64_t time_elapsed;
+    size_t arguments_size;
+} binary_log_record_header_t;
+
+/* A conversion specification of a log message format. */
+typedef struct {
+    char flags[8];
+    bool width_argument;
+    int width;
+    bool precision_argument;
+    int precision;
+    char length[3];
+    char conversion;
+    size_t size;
+} binary_log_conversion_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Formats a log message with its arguments decoded from a binary record. */
+int decode_binary_log_arguments(char*, size_t, const char*, const uint8_t*, size_t);
+
+/* Decodes a call site from a binary log. */
+int decode_binary_log_call_site(log_call_site_t*, const uint8_t*, size_t, size_t*);
+
+/* Decodes the header of a binary log. */
+int decode_binary_log_header(binary_log_header_t*, const uint8_t*, size_t);
+
+/* Decodes the header of a binary log record. */
+int decode_binary_log_record_header(binary_log_record_header_t*, const uint8_t*, size_t, size_t*);
+
+/* Decodes a variable length integer from a binary log. */
+int decode_binary_log_varint(uint64_t*, const uint8_t*, size_t, size_t*);
+
+/* Encodes the arguments of a log message. */
+size_t encode_binary_log_arguments(uint8_t*, size_t, const char*, va_list);
+
+/* Encodes a call site. */
+size_t encode_binary_log_call_site(uint8_t*, uint32_t, const log_call_site_t*);
+
+/* Encodes the header of a binary log. */
+size_t encode_binary_log_header(uint8_t*, binary_log_header_t);
+
+/* Encodes the header of a binary log record. */
+size_t encode_binary_log_record_header(uint8_t*, uint32_t, uint32_t, int64_t, size_t);
+
+/* Encodes a variable length integer. */
+size_t encode_binary_log_varint(uint8_t*, uint64_t);
+
+/* Parses a conversion specification of a log message format. */
+size_t parse_binary_log_conversion(const char*, binary_log_conversion_t*);
+
+#endif
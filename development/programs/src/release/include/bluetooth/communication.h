@@ -16,10 +16,12 @@
  * Includes.
  */
 
+#include <sys/types.h>
 #include <time.h>
 
 /* #include "../connection/connection.h" */
 #include "bluetooth/package/package.h"
+#include "bluetooth/transfer_journal.h"
 
 /*
  * Macros.
@@ -28,6 +30,33 @@
 /* Code returned when no package was received. */
 #define NO_PACKAGE_RECEIVED 50
 
+/* Code returned when a stream was interrupted by another command received. */
+#define STREAM_INTERRUPTED 51
+
+/* Code returned when the remote device requested a stream to stop. */
+#define STREAM_STOPPED 52
+
+/* Code returned when the file of a transfer has changed since it was transferred. */
+#define TRANSFER_CHANGED 53
+
+/* Default number of packages which can be sent without waiting for their confirmations. */
+#define DEFAULT_TRANSMISSION_WINDOW_SIZE 1
+
+/* Maximum number of packages which can be sent without waiting for their confirmations. */
+#define MAXIMUM_TRANSMISSION_WINDOW_SIZE 32
+
+
+/*
+ * Structures.
+ */
+
+/* Number of bytes of the latest stream sent, by what happened to them. */
+typedef struct {
+    uint64_t bytes_sent;
+    uint64_t bytes_unconfirmed;
+    uint64_t bytes_discarded;
+} stream_statistics_t;
+
 
 /*
  * Function headers.
@@ -36,20 +65,41 @@
 /* Checks if a device is connected. */
 int check_connection(int);
 
+/* Returns the statistics of the latest stream sent. */
+stream_statistics_t get_stream_statistics();
+
+/* Returns the number of packages which can be sent without waiting for their confirmations. */
+uint32_t get_transmission_window_size();
+
 /* Receives a package from a connection. */
 int receive_package(int, package_t*);
 
+/* Resumes a file transfer interrupted. */
+int resume_transfer(int, uint32_t, size_t);
+
 /* Sends a disconnect signal through a connection. */
 int send_disconnect_signal(int);
 
 /* Sends a file through a connection. */
 int send_file(int, char*);
 
+/* Sends the bytes of a file after the ones a remote device already has. */
+int send_file_tail(int, char*, size_t, uint64_t);
+
+/* Sends a file which digest is already known through a connection. */
+int send_file_with_digest(int, char*, size_t, uint64_t);
+
 /* Sends a package through a connection. */
 int send_package(int, package_t);
 
+/* Sends a stream through a connection. */
+int send_stream(int, const char*, ssize_t (*)(uint8_t*, size_t), package_t*);
+
+/* Defines the number of packages which can be sent without waiting for their confirmations. */
+uint32_t set_transmission_window_size(uint32_t);
+
 /* Transmits a command result. */
-int transmit_command_result(int, int, struct timeval);
+int transmit_command_result(int, int, struct timeval, struct timeval);
 
 /* Transmits an error. */
 int transmit_error(int, int, const char*);
@@ -18,6 +18,7 @@
 
 /* #include <stdbool.h> */
 /* #include <time.h> */
+#include <sys/types.h>
 
 #include "byte_array.h"
 
@@ -46,7 +47,13 @@ int check_socket_content(int, struct timeval);
 /* Reads content from the socket. */
 int read_socket_content(int, byte_array_t*);
 
+/* Reads a package from the socket without copying it. */
+int read_socket_package(int, byte_array_t*);
+
 /* Writes content on socket. */
 int write_content_on_socket(int, byte_array_t);
 
+/* Writes a file content on socket. */
+int write_file_content_on_socket(int, int, off_t, size_t);
+
 #endif
@@ -0,0 +1,53 @@
+/*
+ * This header file contains the declaration of all components required to wait for socket events and deadlines.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+#ifndef BLUETOOTH_EVENT_LOOP_H
+#define BLUETOOTH_EVENT_LOOP_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+#include <sys/epoll.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Code returned when the event requested occurred on socket. */
+#define SOCKET_EVENT_OCCURRED 50
+
+/* Code returned when the deadline was reached before the event requested occurred on socket. */
+#define DEADLINE_REACHED 51
+
+/* Event which indicates that the socket has content to be read. */
+#define SOCKET_EVENT_READ EPOLLIN
+
+/* Event which indicates that the socket can receive content to be written. */
+#define SOCKET_EVENT_WRITE EPOLLOUT
+
+
+/*
+ * Function headers.
+ */
+
+/* Returns the current monotonic time in milliseconds. */
+uint64_t get_event_loop_time();
+
+/* Releases the event loop of a socket. */
+int release_event_loop(int);
+
+/* Waits until an event occurs on a socket or a deadline is reached. */
+int wait_socket_event(int, uint32_t, uint64_t);
+
+#endif
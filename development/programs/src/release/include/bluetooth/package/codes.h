@@ -16,6 +16,9 @@
  * Macros.
  */
 
+/* Code used on packages which store a page of the audio catalog. */
+#define AUDIO_CATALOG_PAGE_CODE 0x9e05b7c2
+
 /* Code to specify that a package is to check the connection. */
 #define CHECK_CONNECTION_CODE 0xd12f48d4
 
@@ -31,9 +34,24 @@
 /* Code used on packages which stores error messages. */
 #define ERROR_CODE 0x89c09f5a
 
+/* Code used on packages when a remote device is requesting a page of the audio catalog. */
+#define REQUEST_AUDIO_CATALOG_CODE 0x3a7c91d5
+
 /* Code used on packages when a remote device is requesting the latest audio recorded. */
 #define REQUEST_AUDIO_FILE_CODE 0x42a27b9b
 
+/* Code used on packages when a remote device is requesting the bytes of the latest audio recorded which it does not have yet. */
+#define REQUEST_AUDIO_FILE_TAIL_CODE 0x26c95d0e
+
+/* Code used on packages when a remote device is requesting an audio record of the audio catalog. */
+#define REQUEST_AUDIO_RECORD_CODE 0x51d8e4a3
+
+/* Code used on packages when a remote device is requesting the segments closed of the latest audio record. */
+#define REQUEST_AUDIO_SEGMENTS_CODE 0x7d3e58a6
+
+/* Code used on packages when a remote device is requesting to resume a file transfer interrupted. */
+#define RESUME_TRANSFER_CODE 0x6b1f0c37
+
 /* Code used on packages to inform it has a chunk of file. */
 #define SEND_FILE_CHUNK_CODE 0x0f0f769f
 
@@ -46,9 +64,18 @@
 /* Code used on packages to request the device to start audio record. */
 #define START_RECORD_CODE 0x11d2bb74
 
+/* Code used on packages to request the device to stream the audio being recorded. */
+#define START_STREAM_CODE 0x5c84e03a
+
 /* Code used on packages to request the device to stop audio record. */
 #define STOP_RECORD_CODE 0xa1f6d1e5
 
+/* Code used on packages to request the device to stop streaming the audio being recorded. */
+#define STOP_STREAM_CODE 0xe39a6f21
+
+/* Code used on packages to negotiate how many packages can be sent without waiting for their confirmations. */
+#define WINDOW_SIZE_CODE 0x6e2b0c93
+
 /* Code used to specify the start position of a package. */
 #define PACKAGE_HEADER 0xf0037142
 
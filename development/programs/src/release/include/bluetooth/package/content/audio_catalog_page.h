@@ -0,0 +1,73 @@
+/*
+ * This header file contains the declaration of all components required to create and manipulate the "audio catalog page" package content.
+ *
+ * Version: 
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+#ifndef CONTENT_AUDIO_CATALOG_PAGE_H
+#define CONTENT_AUDIO_CATALOG_PAGE_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+
+#include "audio/catalog.h"
+#include "byte_array.h"
+
+
+/*
+ * Macros.
+ */
+
+/* Maximum number of audio records on an "audio catalog page" package. */
+#define AUDIO_CATALOG_PAGE_MAXIMUM_RECORDS 256
+
+
+/*
+ * Structure definitions.
+ */
+
+/* The content of an "audio catalog page" package. The audio records are kept encoded and must be read with "get_audio_catalog_page_record". */
+typedef struct {
+    uint32_t next_record_id;
+    uint32_t records_count;
+    uint8_t* records_data;
+} audio_catalog_page_content_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Converts a byte array to an "audio catalog page" package content. */
+int convert_byte_array_to_audio_catalog_page_content(audio_catalog_page_content_t*, byte_array_t);
+
+/* Creates an "audio catalog page" package content. */
+audio_catalog_page_content_t* create_audio_catalog_page_content(uint32_t, uint32_t, const audio_catalog_record_t*);
+
+/* Creates a byte array containing an "audio catalog page" package content. */
+byte_array_t create_audio_catalog_page_content_byte_array(audio_catalog_page_content_t);
+
+/* Decodes a byte array to an "audio catalog page" package content without allocating memory. */
+int decode_audio_catalog_page_content(audio_catalog_page_content_t*, byte_array_t);
+
+/* Deletes the information of an "audio catalog page" package content. */
+int delete_audio_catalog_page_content(audio_catalog_page_content_t*);
+
+/* Encodes an "audio catalog page" package content on a buffer. */
+int encode_audio_catalog_page_content(uint8_t*, audio_catalog_page_content_t);
+
+/* Reads an audio record of an "audio catalog page" package content. */
+int get_audio_catalog_page_record(audio_catalog_page_content_t, uint32_t, audio_catalog_record_t*);
+
+/* Returns the size of an "audio catalog page" package content when encoded. */
+size_t get_audio_catalog_page_content_size(audio_catalog_page_content_t);
+
+#endif
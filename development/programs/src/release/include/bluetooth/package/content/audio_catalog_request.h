@@ -0,0 +1,60 @@
+/*
+ * This header file contains the declaration of all components required to create and manipulate the "audio catalog request" package content.
+ *
+ * Version: 
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+#ifndef CONTENT_AUDIO_CATALOG_REQUEST_H
+#define CONTENT_AUDIO_CATALOG_REQUEST_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+
+#include "byte_array.h"
+
+
+/*
+ * Structure definitions.
+ */
+
+/* The content of a "audio catalog request" package. */
+typedef struct {
+    uint32_t first_record_id;
+    uint32_t records_count;
+} audio_catalog_request_content_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Converts a byte array to a "audio catalog request" package content. */
+int convert_byte_array_to_audio_catalog_request_content(audio_catalog_request_content_t*, byte_array_t);
+
+/* Creates a "audio catalog request" package content. */
+audio_catalog_request_content_t* create_audio_catalog_request_content(uint32_t, uint32_t);
+
+/* Creates a byte array containing a "audio catalog request" package content. */
+byte_array_t create_audio_catalog_request_content_byte_array(audio_catalog_request_content_t);
+
+/* Decodes a byte array to a "audio catalog request" package content without allocating memory. */
+int decode_audio_catalog_request_content(audio_catalog_request_content_t*, byte_array_t);
+
+/* Deletes the information of a "audio catalog request" package content. */
+int delete_audio_catalog_request_content(audio_catalog_request_content_t*);
+
+/* Encodes a "audio catalog request" package content on a buffer. */
+int encode_audio_catalog_request_content(uint8_t*, audio_catalog_request_content_t);
+
+/* Returns the size of a "audio catalog request" package content when encoded. */
+size_t get_audio_catalog_request_content_size(audio_catalog_request_content_t);
+
+#endif
@@ -0,0 +1,59 @@
+/*
+ * This header file contains the declaration of all components required to create and manipulate the "audio record request" package content.
+ *
+ * Version: 
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+#ifndef CONTENT_AUDIO_RECORD_REQUEST_H
+#define CONTENT_AUDIO_RECORD_REQUEST_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+
+#include "byte_array.h"
+
+
+/*
+ * Structure definitions.
+ */
+
+/* The content of an "audio record request" package. */
+typedef struct {
+    uint32_t record_id;
+} audio_record_request_content_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Converts a byte array to an "audio record request" package content. */
+int convert_byte_array_to_audio_record_request_content(audio_record_request_content_t*, byte_array_t);
+
+/* Creates an "audio record request" package content. */
+audio_record_request_content_t* create_audio_record_request_content(uint32_t);
+
+/* Creates a byte array containing an "audio record request" package content. */
+byte_array_t create_audio_record_request_content_byte_array(audio_record_request_content_t);
+
+/* Decodes a byte array to an "audio record request" package content without allocating memory. */
+int decode_audio_record_request_content(audio_record_request_content_t*, byte_array_t);
+
+/* Deletes the information of an "audio record request" package content. */
+int delete_audio_record_request_content(audio_record_request_content_t*);
+
+/* Encodes an "audio record request" package content on a buffer. */
+int encode_audio_record_request_content(uint8_t*, audio_record_request_content_t);
+
+/* Returns the size of an "audio record request" package content when encoded. */
+size_t get_audio_record_request_content_size(audio_record_request_content_t);
+
+#endif
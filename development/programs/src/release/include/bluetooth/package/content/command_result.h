@@ -30,6 +30,7 @@
 typedef struct {
     uint32_t result_code;
     struct timeval execution_delay;
+    struct timeval pre_roll;
 } command_result_content_t;
 
 
@@ -41,12 +42,21 @@ typedef struct {
 int convert_byte_array_to_command_result_content(command_result_content_t*, byte_array_t);
 
 /* Creates a "command result" package content. */
-command_result_content_t* create_command_result_content(uint32_t, struct timeval);
+command_result_content_t* create_command_result_content(uint32_t, struct timeval, struct timeval);
 
 /* Creates a byte array containing a "command result" package content. */
 byte_array_t create_command_result_content_byte_array(command_result_content_t);
 
+/* Decodes a byte array to a "command result" package content without allocating memory. */
+int decode_command_result_content(command_result_content_t*, byte_array_t);
+
 /* Deletes the information of a "command result" package content. */
 int delete_command_result_content(command_result_content_t*);
 
+/* Encodes a "command result" package content on a buffer. */
+int encode_command_result_content(uint8_t*, command_result_content_t);
+
+/* Returns the size of a "command result" package content when encoded. */
+size_t get_command_result_content_size(command_result_content_t);
+
 #endif
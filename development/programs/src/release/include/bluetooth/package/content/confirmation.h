@@ -44,7 +44,16 @@ confirmation_content_t* create_confirmation_content(uint32_t);
 /* Creates a byte array containing a "confirmation" package content. */
 byte_array_t create_confirmation_content_byte_array(confirmation_content_t);
 
+/* Decodes a byte array to a "confirmation" package content without allocating memory. */
+int decode_confirmation_content(confirmation_content_t*, byte_array_t);
+
 /* Deletes the information of a "confirmation" package content. */
 int delete_confirmation_content(confirmation_content_t*);
 
+/* Encodes a "confirmation" package content on a buffer. */
+int encode_confirmation_content(uint8_t*, confirmation_content_t);
+
+/* Returns the size of a "confirmation" package content when encoded. */
+size_t get_confirmation_content_size(confirmation_content_t);
+
 #endif
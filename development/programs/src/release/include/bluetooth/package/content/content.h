@@ -16,12 +16,18 @@
  * Includes.
  */
 
+#include "bluetooth/package/content/audio_catalog_page.h"
+#include "bluetooth/package/content/audio_catalog_request.h"
+#include "bluetooth/package/content/audio_record_request.h"
 #include "bluetooth/package/content/command_result.h"
 #include "bluetooth/package/content/confirmation.h"
 #include "bluetooth/package/content/error.h"
+#include "bluetooth/package/content/file_tail.h"
+#include "bluetooth/package/content/resume_transfer.h"
 #include "bluetooth/package/content/send_file_chunk.h"
 #include "bluetooth/package/content/send_file_header.h"
 #include "bluetooth/package/content/send_file_trailer.h"
+#include "bluetooth/package/content/window_size.h"
 
 
 /*
@@ -30,14 +36,36 @@
 
 /* Stores the bluetooth package content. */
 typedef union {
+    audio_catalog_page_content_t* audio_catalog_page_content;
+    audio_catalog_request_content_t* audio_catalog_request_content;
+    audio_record_request_content_t* audio_record_request_content;
     confirmation_content_t* confirmation_content; 
     error_content_t* error_content;
+    file_tail_content_t* file_tail_content;
     command_result_content_t* command_result_content;
+    resume_transfer_content_t* resume_transfer_content;
     send_file_chunk_content_t* send_file_chunk_content;
     send_file_header_content_t* send_file_header_content;
     send_file_trailer_content_t* send_file_trailer_content;
+    window_size_content_t* window_size_content;
 } content_t;
 
+/* Stores the structure of a bluetooth package content, so it can be decoded without memory allocation. */
+typedef union {
+    audio_catalog_page_content_t audio_catalog_page_content;
+    audio_catalog_request_content_t audio_catalog_request_content;
+    audio_record_request_content_t audio_record_request_content;
+    confirmation_content_t confirmation_content; 
+    error_content_t error_content;
+    file_tail_content_t file_tail_content;
+    command_result_content_t command_result_content;
+    resume_transfer_content_t resume_transfer_content;
+    send_file_chunk_content_t send_file_chunk_content;
+    send_file_header_content_t send_file_header_content;
+    send_file_trailer_content_t send_file_trailer_content;
+    window_size_content_t window_size_content;
+} content_storage_t;
+
 
 /*
  * Function declarations.
@@ -49,7 +77,16 @@ int convert_byte_array_to_content(content_t*, byte_array_t, uint32_t);
 /* Creates a byte array storing the informations of the package content. */
 byte_array_t create_content_byte_array(content_t, uint32_t);
 
+/* Decodes a byte array to a package content without allocating memory. */
+int decode_content(content_t*, content_storage_t*, byte_array_t, uint32_t);
+
 /* Deletes the content of a package. */
 int delete_content(uint32_t, content_t);
 
+/* Encodes a package content on a buffer. */
+int encode_content(uint8_t*, content_t, uint32_t);
+
+/* Returns the size of a package content when encoded. */
+size_t get_content_size(content_t, uint32_t);
+
 #endif
@@ -46,7 +46,16 @@ error_content_t* create_error_content(uint32_t, uint32_t, uint8_t*);
 /* Creates a byte array containing an "error" package content. */
 byte_array_t create_error_content_byte_array(error_content_t);
 
+/* Decodes a byte array to a "error" package content without allocating memory. */
+int decode_error_content(error_content_t*, byte_array_t);
+
 /* Deletes the information of an error package content. */
 int delete_error_content(error_content_t*);
 
+/* Encodes a "error" package content on a buffer. */
+int encode_error_content(uint8_t*, error_content_t);
+
+/* Returns the size of a "error" package content when encoded. */
+size_t get_error_content_size(error_content_t);
+
 #endif
@@ -0,0 +1,60 @@
+/*
+ * This header file contains the declaration of all components required to create and manipulate the "file tail" package content.
+ *
+ * Version: 
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+#ifndef CONTENT_FILE_TAIL_H
+#define CONTENT_FILE_TAIL_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+
+#include "byte_array.h"
+
+
+/*
+ * Structure definitions.
+ */
+
+/* The content of a "file tail" package. */
+typedef struct {
+    uint32_t file_offset;
+    uint64_t prefix_digest;
+} file_tail_content_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Converts a byte array to a "file tail" package content. */
+int convert_byte_array_to_file_tail_content(file_tail_content_t*, byte_array_t);
+
+/* Creates a "file tail" package content. */
+file_tail_content_t* create_file_tail_content(uint32_t, uint64_t);
+
+/* Creates a byte array containing a "file tail" package content. */
+byte_array_t create_file_tail_content_byte_array(file_tail_content_t);
+
+/* Decodes a byte array to a "file tail" package content without allocating memory. */
+int decode_file_tail_content(file_tail_content_t*, byte_array_t);
+
+/* Deletes the information of a "file tail" package content. */
+int delete_file_tail_content(file_tail_content_t*);
+
+/* Encodes a "file tail" package content on a buffer. */
+int encode_file_tail_content(uint8_t*, file_tail_content_t);
+
+/* Returns the size of a "file tail" package content when encoded. */
+size_t get_file_tail_content_size(file_tail_content_t);
+
+#endif
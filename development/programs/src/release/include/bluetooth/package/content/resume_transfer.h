@@ -0,0 +1,60 @@
+/*
+ * This header file contains the declaration of all components required to create and manipulate the "resume transfer" package content.
+ *
+ * Version: 
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+#ifndef CONTENT_RESUME_TRANSFER_H
+#define CONTENT_RESUME_TRANSFER_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+
+#include "byte_array.h"
+
+
+/*
+ * Structure definitions.
+ */
+
+/* The content of a "resume transfer" package. */
+typedef struct {
+    uint32_t transfer_id;
+    uint32_t file_offset;
+} resume_transfer_content_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Converts a byte array to a "resume transfer" package content. */
+int convert_byte_array_to_resume_transfer_content(resume_transfer_content_t*, byte_array_t);
+
+/* Creates a "resume transfer" package content. */
+resume_transfer_content_t* create_resume_transfer_content(uint32_t, uint32_t);
+
+/* Creates a byte array containing a "resume transfer" package content. */
+byte_array_t create_resume_transfer_content_byte_array(resume_transfer_content_t);
+
+/* Decodes a byte array to a "resume transfer" package content without allocating memory. */
+int decode_resume_transfer_content(resume_transfer_content_t*, byte_array_t);
+
+/* Deletes the information of a "resume transfer" package content. */
+int delete_resume_transfer_content(resume_transfer_content_t*);
+
+/* Encodes a "resume transfer" package content on a buffer. */
+int encode_resume_transfer_content(uint8_t*, resume_transfer_content_t);
+
+/* Returns the size of a "resume transfer" package content when encoded. */
+size_t get_resume_transfer_content_size(resume_transfer_content_t);
+
+#endif
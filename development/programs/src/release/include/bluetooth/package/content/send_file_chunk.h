@@ -46,7 +46,16 @@ send_file_chunk_content_t* create_send_file_chunk_content(size_t, uint8_t*);
 /* Creates a byte array containing a "send file chunk" package content. */
 byte_array_t create_send_file_chunk_content_byte_array(send_file_chunk_content_t);
 
+/* Decodes a byte array to a "send file chunk" package content without allocating memory. */
+int decode_send_file_chunk_content(send_file_chunk_content_t*, byte_array_t);
+
 /* Deletes the information of a "send file chunk" package content. */
 int delete_send_file_chunk_content(send_file_chunk_content_t*);
 
+/* Encodes a "send file chunk" package content on a buffer. */
+int encode_send_file_chunk_content(uint8_t*, send_file_chunk_content_t);
+
+/* Returns the size of a "send file chunk" package content when encoded. */
+size_t get_send_file_chunk_content_size(send_file_chunk_content_t);
+
 #endif
@@ -21,6 +21,14 @@
 #include "byte_array.h"
 
 
+/*
+ * Macros.
+ */
+
+/* Size of the transfer informations encoded after the file name. */
+#define SEND_FILE_HEADER_TRANSFER_INFORMATIONS_SIZE (2*sizeof(uint32_t) + sizeof(uint64_t))
+
+
 /*
  * Structure definitions.
  */
@@ -31,6 +39,9 @@ typedef struct {
     uint32_t file_size;
     uint32_t file_name_size;
     uint8_t* file_name;
+    uint32_t file_offset;
+    uint32_t transfer_id;
+    uint64_t file_digest;
 } send_file_header_content_t;
 
 
@@ -42,12 +53,21 @@ typedef struct {
 int convert_byte_array_to_send_file_header_content(send_file_header_content_t*, byte_array_t);
 
 /* Creates a "send file header" package content. */
-send_file_header_content_t* create_send_file_header_content(uint32_t, uint32_t, uint8_t*);
+send_file_header_content_t* create_send_file_header_content(uint32_t, uint32_t, uint8_t*, uint32_t, uint32_t, uint64_t);
 
 /* Creates a byte array containing a "send file header" package content. */
 byte_array_t create_send_file_header_content_byte_array(send_file_header_content_t);
 
+/* Decodes a byte array to a "send file header" package content without allocating memory. */
+int decode_send_file_header_content(send_file_header_content_t*, byte_array_t);
+
 /* Deletes the information of a "send file header" package content. */
 int delete_send_file_header_content(send_file_header_content_t*);
 
+/* Encodes a "send file header" package content on a buffer. */
+int encode_send_file_header_content(uint8_t*, send_file_header_content_t);
+
+/* Returns the size of a "send file header" package content when encoded. */
+size_t get_send_file_header_content_size(send_file_header_content_t);
+
 #endif
@@ -44,8 +44,17 @@ send_file_trailer_content_t* create_send_file_trailer_content();
 /* Creates a byte array containing the "send file trailer" package content. */
 byte_array_t create_send_file_trailer_content_byte_array(send_file_trailer_content_t);
 
+/* Decodes a byte array to a "send file trailer" package content without allocating memory. */
+int decode_send_file_trailer_content(send_file_trailer_content_t*, byte_array_t);
+
 /* Deletes the information of a "send file trailer" package content. */
 int delete_send_file_trailer_content(send_file_trailer_content_t*);
 
+/* Encodes a "send file trailer" package content on a buffer. */
+int encode_send_file_trailer_content(uint8_t*, send_file_trailer_content_t);
+
+/* Returns the size of a "send file trailer" package content when encoded. */
+size_t get_send_file_trailer_content_size(send_file_trailer_content_t);
+
 
 #endif
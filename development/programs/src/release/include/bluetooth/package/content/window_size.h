@@ -0,0 +1,59 @@
+/*
+ * This header file contains the declaration of all components required to create and manipulate the "window size" package content.
+ *
+ * Version: 
+ *  0.1
+ *
+ * Author: 
+ *  Marcelo Leite
+ */
+
+#ifndef CONTENT_WINDOW_SIZE_H
+#define CONTENT_WINDOW_SIZE_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+
+#include "byte_array.h"
+
+
+/*
+ * Structure definitions.
+ */
+
+/* The content of a "window size" package. */
+typedef struct {
+    uint32_t window_size;
+} window_size_content_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Converts a byte array to a "window size" package content. */
+int convert_byte_array_to_window_size_content(window_size_content_t*, byte_array_t);
+
+/* Creates a "window size" package content. */
+window_size_content_t* create_window_size_content(uint32_t);
+
+/* Creates a byte array containing a "window size" package content. */
+byte_array_t create_window_size_content_byte_array(window_size_content_t);
+
+/* Decodes a byte array to a "window size" package content without allocating memory. */
+int decode_window_size_content(window_size_content_t*, byte_array_t);
+
+/* Deletes the information of a "window size" package content. */
+int delete_window_size_content(window_size_content_t*);
+
+/* Encodes a "window size" package content on a buffer. */
+int encode_window_size_content(uint8_t*, window_size_content_t);
+
+/* Returns the size of a "window size" package content when encoded. */
+size_t get_window_size_content_size(window_size_content_t);
+
+#endif
@@ -23,6 +23,26 @@
 #include "bluetooth/package/content/content.h"
 
 
+/*
+ * Macros.
+ */
+
+/* Size of the package fields which precede its content (header, id, type code and content size). */
+#define PACKAGE_PREAMBLE_SIZE (4*sizeof(uint32_t))
+
+/* Size of the package trailer field. */
+#define PACKAGE_TRAILER_SIZE sizeof(uint32_t)
+
+/* Maximum size of a package content. */
+#define PACKAGE_MAXIMUM_CONTENT_SIZE (1024*128)
+
+/* Maximum size of a package. */
+#define PACKAGE_MAXIMUM_SIZE (PACKAGE_PREAMBLE_SIZE + PACKAGE_MAXIMUM_CONTENT_SIZE + PACKAGE_TRAILER_SIZE)
+
+/* Size of the "send file chunk" package fields which precede its chunk data. */
+#define SEND_FILE_CHUNK_PACKAGE_PREAMBLE_SIZE (PACKAGE_PREAMBLE_SIZE + 2*sizeof(uint32_t))
+
+
 /*
  * Structure definitions.
  */
@@ -36,6 +56,12 @@ typedef struct {
     uint32_t trailer;
 } package_t;
 
+/* A package decoded without memory allocation, along with the storage of its content structure. */
+typedef struct {
+    package_t package;
+    content_storage_t content_storage;
+} package_view_t;
+
 
 /*
  * Function headers.
@@ -47,11 +73,17 @@ int convert_byte_array_to_package(package_t*, byte_array_t);
 /* Converts a package to a byte array. */
 int convert_package_to_byte_array(byte_array_t*, package_t);
 
+/* Creates a package without content. */
+package_t create_package(uint32_t);
+
+/* Creates an audio catalog page package. */
+package_t create_audio_catalog_page_package(uint32_t, uint32_t, const audio_catalog_record_t*);
+
 /* Creates a check connection package. */
 package_t create_check_connection_package();
 
 /* Creates a command result package. */
-package_t create_command_result_package(uint32_t, struct timeval); 
+package_t create_command_result_package(uint32_t, struct timeval, struct timeval); 
 
 /* Creates a confirmation package. */
 package_t create_confirmation_package(uint32_t); 
@@ -62,16 +94,43 @@ package_t create_disconnect_package();
 /* Creates an error package. */
 package_t create_error_package(uint32_t, const char*); 
 
+/* Creates a request audio catalog package. */
+package_t create_request_audio_catalog_package(uint32_t, uint32_t);
+
+/* Creates a request audio file tail package. */
+package_t create_request_audio_file_tail_package(uint32_t, uint64_t);
+
+/* Creates a request audio record package. */
+package_t create_request_audio_record_package(uint32_t);
+
+/* Creates a resume transfer package. */
+package_t create_resume_transfer_package(uint32_t, uint32_t);
+
 /* Creates a send file chunk package. */
 package_t create_send_file_chunk_package(size_t, uint8_t*);
 
 /* Creates a send file header package. */
-package_t create_send_file_header_package(size_t, const char*);
+package_t create_send_file_header_package(size_t, const char*, size_t, uint32_t, uint64_t);
 
 /* Creates a send file trailer package. */
 package_t create_send_file_trailer_package();
 
+/* Creates a window size package. */
+package_t create_window_size_package(uint32_t);
+
+/* Decodes a byte array to a package without allocating memory. */
+int decode_package(package_view_t*, byte_array_t);
+
 /* Deletes a package. */
 int delete_package(package_t);
 
+/* Encodes a package on a buffer. */
+int encode_package(uint8_t*, size_t, package_t, size_t*);
+
+/* Returns the size of a package when encoded. */
+size_t get_package_size(package_t);
+
+/* Writes the fields of a "send file chunk" package which precede its chunk data. */
+int write_send_file_chunk_package_preamble(uint8_t*, uint32_t*, size_t);
+
 #endif
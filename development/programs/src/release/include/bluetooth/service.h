@@ -32,6 +32,9 @@
 /* Checks if there is a bluetooth connection attempt. */
 int check_connection_attempt(int*);
 
+/* Closes the socket which listens for connection attempts. */
+int close_listening_socket();
+
 /* Checks is bluetooth service is registered. */
 bool is_bluetooth_service_registered();
 
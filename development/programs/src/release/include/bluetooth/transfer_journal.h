@@ -0,0 +1,62 @@
+/*
+ * This header file contains the declaration of all components required to register file transfers, so they can be resumed after a disconnection.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef BLUETOOTH_TRANSFER_JOURNAL_H
+#define BLUETOOTH_TRANSFER_JOURNAL_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Code returned when a transfer is not registered on the journal. */
+#define TRANSFER_NOT_FOUND 50
+
+/* Maximum size of the file path of a transfer. */
+#define TRANSFER_FILE_PATH_SIZE 1024
+
+
+/*
+ * Structures.
+ */
+
+/* A file transfer registered on the journal. */
+typedef struct {
+    uint32_t transfer_id;
+    size_t file_size;
+    uint64_t file_digest;
+    bool registered;
+    char file_path[TRANSFER_FILE_PATH_SIZE];
+} transfer_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Finds a transfer registered on the journal. */
+int find_transfer(uint32_t, transfer_t*);
+
+/* Registers a transfer on the journal. */
+int register_transfer(transfer_t*);
+
+/* Defines the identifier of a transfer without registering it on the journal. */
+int reserve_transfer(transfer_t*);
+
+#endif
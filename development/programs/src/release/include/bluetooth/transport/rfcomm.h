@@ -0,0 +1,33 @@
+/*
+ * This header file contains the declaration of all components required to communicate through bluetooth RFCOMM sockets.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef BLUETOOTH_TRANSPORT_RFCOMM_H
+#define BLUETOOTH_TRANSPORT_RFCOMM_H
+
+
+/*
+ * Macros.
+ */
+
+/* The RFCOMM channel used to provide the service. */
+#define RFCOMM_CHANNEL 27
+
+
+/*
+ * Function headers.
+ */
+
+/* Accepts a connection from a listening RFCOMM socket. */
+int accept_rfcomm_connection(int, int*);
+
+/* Creates a RFCOMM socket which listens for connections. */
+int listen_rfcomm_connections(const char*, int*);
+
+#endif
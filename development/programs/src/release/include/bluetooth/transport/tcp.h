@@ -0,0 +1,33 @@
+/*
+ * This header file contains the declaration of all components required to communicate through TCP sockets on loopback interface.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef BLUETOOTH_TRANSPORT_TCP_H
+#define BLUETOOTH_TRANSPORT_TCP_H
+
+
+/*
+ * Macros.
+ */
+
+/* TCP port used when no address is informed. */
+#define TCP_DEFAULT_PORT 27027
+
+
+/*
+ * Function headers.
+ */
+
+/* Accepts a connection from a listening TCP socket. */
+int accept_tcp_connection(int, int*);
+
+/* Creates a TCP socket which listens for connections on loopback interface. */
+int listen_tcp_connections(const char*, int*);
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * This header file contains the declaration of all components required to select and use the transport which carries the communication with remote devices.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef BLUETOOTH_TRANSPORT_H
+#define BLUETOOTH_TRANSPORT_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdbool.h>
+#include <sys/time.h>
+#include <sys/types.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Name of the transport which uses bluetooth RFCOMM sockets. */
+#define TRANSPORT_RFCOMM "RFCOMM"
+
+/* Name of the transport which uses local (AF_UNIX) sockets. */
+#define TRANSPORT_UNIX "UNIX"
+
+/* Name of the transport which uses TCP sockets on loopback interface. */
+#define TRANSPORT_TCP "TCP"
+
+/* Maximum connection attempts kept on the listening queue while no connection is being accepted. */
+#define TRANSPORT_LISTEN_BACKLOG 4
+
+
+/*
+ * Structure definitions.
+ */
+
+/* The operations provided by a transport. */
+typedef struct {
+    const char* name;
+    bool bluetooth;
+    int (*listen)(const char*, int*);
+    int (*accept)(int, int*);
+    ssize_t (*read)(int, void*, size_t);
+    ssize_t (*write)(int, const void*, size_t);
+    int (*close)(int);
+    int (*poll)(int, struct timeval);
+} transport_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Accepts a connection from a listening transport descriptor. */
+int accept_transport_connection(int, int*);
+
+/* Closes a transport descriptor. */
+int close_transport(int);
+
+/* Returns the current transport. */
+const transport_t* get_transport();
+
+/* Checks if the current transport uses bluetooth. */
+bool is_bluetooth_transport();
+
+/* Creates a transport descriptor which listens for connections. */
+int listen_transport_connections(int*);
+
+/* Waits until a transport descriptor has content to be read. */
+int poll_transport(int, struct timeval);
+
+/* Reads content from a transport descriptor. */
+ssize_t read_transport(int, void*, size_t);
+
+/* Defines the transport to be used. */
+int set_transport(const char*);
+
+/* Defines the address used by the transport to listen for connections. */
+int set_transport_address(const char*);
+
+/* Writes content on a transport descriptor. */
+ssize_t write_transport(int, const void*, size_t);
+
+#endif
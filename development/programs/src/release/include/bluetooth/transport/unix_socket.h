@@ -0,0 +1,33 @@
+/*
+ * This header file contains the declaration of all components required to communicate through local (AF_UNIX) sockets.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef BLUETOOTH_TRANSPORT_UNIX_SOCKET_H
+#define BLUETOOTH_TRANSPORT_UNIX_SOCKET_H
+
+
+/*
+ * Macros.
+ */
+
+/* Name of the socket file created on output directory when no address is informed. */
+#define UNIX_SOCKET_DEFAULT_FILE_NAME "muni.socket"
+
+
+/*
+ * Function headers.
+ */
+
+/* Accepts a connection from a listening local socket. */
+int accept_unix_socket_connection(int, int*);
+
+/* Creates a local socket which listens for connections. */
+int listen_unix_socket_connections(const char*, int*);
+
+#endif
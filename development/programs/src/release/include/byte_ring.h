@@ -0,0 +1,67 @@
+/*
+ * This header file contains the declaration of all components required to exchange bytes between two threads through a ring.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef BYTE_RING_H
+#define BYTE_RING_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * Structures.
+ */
+
+/* Structure to store a ring written by one thread and read by another. */
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    atomic_size_t write_position;
+    atomic_size_t read_position;
+    atomic_size_t high_water_mark;
+} byte_ring_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Creates a byte ring. */
+int create_byte_ring(byte_ring_t*, size_t);
+
+/* Deletes a byte ring. */
+int delete_byte_ring(byte_ring_t*);
+
+/* Discards bytes waiting to be read from a byte ring. */
+size_t discard_byte_ring(byte_ring_t*, size_t);
+
+/* Returns the number of bytes waiting to be read from a byte ring. */
+size_t get_byte_ring_content_size(byte_ring_t*);
+
+/* Returns the highest number of bytes waited to be read from a byte ring. */
+size_t get_byte_ring_high_water_mark(byte_ring_t*);
+
+/* Reads bytes from a byte ring. */
+size_t read_byte_ring(byte_ring_t*, uint8_t*, size_t);
+
+/* Discards the content of a byte ring. */
+void reset_byte_ring(byte_ring_t*);
+
+/* Writes bytes on a byte ring. */
+bool write_byte_ring(byte_ring_t*, const uint8_t*, size_t);
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * This header file contains the declaration of all components required to calculate digests of file contents.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef DIGEST_H
+#define DIGEST_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Digest of an empty content. */
+#define DIGEST_INITIAL_VALUE 0xcbf29ce484222325ULL
+
+
+/*
+ * Function headers.
+ */
+
+/* Calculates the digest of the first bytes of a file. */
+int get_file_digest(char*, size_t, uint64_t*);
+
+/* Updates a digest with more content. */
+uint64_t update_digest(uint64_t, const uint8_t*, size_t);
+
+#endif
@@ -40,6 +40,9 @@
 #define ERROR_MESSAGE_020 "Could not send file content."
 #define ERROR_MESSAGE_021 "Could not send file trailer."
 #define ERROR_MESSAGE_022 "Could not close connection gracefully."
+#define ERROR_MESSAGE_023 "Transfer not found."
+#define ERROR_MESSAGE_024 "File changed since it was transferred."
+#define ERROR_MESSAGE_025 "Audio record not found."
 
 
 /*
@@ -31,6 +31,9 @@ bool file_is_readable(char*);
 /* Returns the file size in bytes. */
 size_t get_file_size(char*);
 
+/* Reads the value stored on the first line of a file. */
+int read_file_value(char*, char*, size_t);
+
 /* Reads a chunk of the specified file. */
 /* int read_file_chunk(char*, uint8_t*, long int, size_t); */
 
@@ -45,32 +45,26 @@ typedef struct instant_t {
  * Function headers.
  */
 
-/* Converts an structure "instant" to an structure "timeval" */
-struct timeval convert_instant_to_timeval(instant_t);
-
 /* Formats an instant as a human-readable string. */
 char* format_instant_to_read(instant_t); 
 
+/* Formats an instant as a human-readable string on a buffer. */
+int format_instant_to_read_buffer(char*, struct timespec);
+
 /* Formats the instant as a string to sort files. */
 char* format_instant_to_sort_files(instant_t);
 
 /* Retrieves the current instant */
 instant_t get_instant();
 
-/* Calculates the difference between two instants. */
-int get_instant_difference (instant_t*, instant_t,  instant_t);
-
 /* Retrieves the current instant formatted as a string to sort files. */
 char* get_instant_file_formatted();
 
 /* Retrieves the current instant formatted as a human-readable string. */
 char* get_instant_read_formatted();
 
-/* Retrieves an instant stored on a file. */
-int retrieve_instant_from_file(instant_t*, char*);
-
-/* Stores the current instant on a file. */
-int store_current_instant(char*);
+/* Formats the current instant as a human-readable string on a buffer. */
+int get_instant_read_formatted_buffer(char*);
 
 #endif
 
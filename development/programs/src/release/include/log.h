@@ -17,6 +17,7 @@
  */
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h> 
 #include <string.h>
 
@@ -37,55 +38,98 @@
 /* Size of buffer which stores the message to be written on log. */
 #define LOG_MESSAGE_BUFFER_SIZE 256
 
+/* Minimum level of the log messages compiled. Log macros of lower levels are removed from the program. */
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_MESSAGE_TYPE_TRACE
+#endif
+
+/* Checks if messages of a level must be logged, before any formatting is done. */
+#define LOG_LEVEL_ENABLED(x) ( (x) >= LOG_COMPILE_LEVEL && (x) >= _log_level )
+
+/* Preffixes used to identify message levels. */
+#define LOG_TRACE_PREFFIX "TRACE"
+#define LOG_WARNING_PREFFIX "WARNING"
+#define LOG_ERROR_PREFFIX "ERROR"
+
+/* Code to identify log files written as text. */
+#define LOG_FORMAT_TEXT 120
+
+/* Code to identify log files written as binary records. */
+#define LOG_FORMAT_BINARY 125
+
+/* Name of the section which stores the call sites of log macros. */
+#define LOG_CALL_SITES_SECTION "anna_log_call_sites"
+
+/* Retrieves the format of a log macro arguments. */
+#define _LOG_FORMAT(x, ...) (x)
+
+/* Declares the call site of a log macro on the call sites section. */
+#define _LOG_CALL_SITE(x, y) static const log_call_site_t _log_call_site __attribute__((section(LOG_CALL_SITES_SECTION), used, aligned(8))) = { __func__, __FILE__, (y), __LINE__, (x) }
+
 /* Registers a warning message. */
-#define LOG_WARNING(...) if (_log_writing_message == false){\
+#define LOG_WARNING(...) if (LOG_LEVEL_ENABLED(LOG_MESSAGE_TYPE_WARNING) && _log_writing_message == false){\
+    _LOG_CALL_SITE(LOG_MESSAGE_TYPE_WARNING, _LOG_FORMAT(__VA_ARGS__, ""));\
     _log_writing_message = true;\
-    sprintf(_log_message_buffer, __VA_ARGS__);\
-    write_log_message(LOG_MESSAGE_TYPE_WARNING, __func__, __LINE__, _log_message_buffer);\
-    memset(_log_message_buffer, 0, LOG_MESSAGE_BUFFER_SIZE);\
+    write_log_call_site(&_log_call_site, __VA_ARGS__);\
     _log_writing_message = false;\
 }
 
 /* Registers a log message. */
-#define LOG(x, y) if (_log_writing_message == false){\
+#define LOG(x, y) if (LOG_LEVEL_ENABLED(x) && _log_writing_message == false){\
+    _LOG_CALL_SITE((x), "%s");\
     _log_writing_message=true;\
-    write_log_message((x), __func__, __LINE__, (y));\
+    write_log_call_site(&_log_call_site, "%s", (y));\
     _log_writing_message=false;\
 }
 
 /* Registers an error message. */
-#define LOG_ERROR(...) if (_log_writing_message == false){\
+#define LOG_ERROR(...) if (LOG_LEVEL_ENABLED(LOG_MESSAGE_TYPE_ERROR) && _log_writing_message == false){\
+    _LOG_CALL_SITE(LOG_MESSAGE_TYPE_ERROR, _LOG_FORMAT(__VA_ARGS__, ""));\
     _log_writing_message=true;\
-    sprintf(_log_message_buffer, __VA_ARGS__);\
-    write_log_message(LOG_MESSAGE_TYPE_ERROR, __func__, __LINE__, _log_message_buffer);\
-    memset(_log_message_buffer, 0, LOG_MESSAGE_BUFFER_SIZE);\
+    write_log_call_site(&_log_call_site, __VA_ARGS__);\
     _log_writing_message=false;\
 }
 
 /* Registers a trace message. */
-#define LOG_TRACE(...) if (_log_writing_message == false){\
-    sprintf(_log_message_buffer, __VA_ARGS__);\
-    LOG_TRACE_POINT;\
+#define LOG_TRACE(...) if (LOG_LEVEL_ENABLED(LOG_MESSAGE_TYPE_TRACE) && _log_writing_message == false){\
+    _LOG_CALL_SITE(LOG_MESSAGE_TYPE_TRACE, _LOG_FORMAT(__VA_ARGS__, ""));\
+    _log_writing_message=true;\
+    write_log_call_site(&_log_call_site, __VA_ARGS__);\
+    _log_writing_message=false;\
 }
 
 /* Macro to registers a trace point. */
-#define LOG_TRACE_POINT if (_log_writing_message == false){\
+#define LOG_TRACE_POINT if (LOG_LEVEL_ENABLED(LOG_MESSAGE_TYPE_TRACE) && _log_writing_message == false){\
+    _LOG_CALL_SITE(LOG_MESSAGE_TYPE_TRACE, NULL);\
     _log_writing_message=true;\
-    write_log_message(LOG_MESSAGE_TYPE_TRACE, __func__, __LINE__, _log_message_buffer);\
-    memset(_log_message_buffer, 0, LOG_MESSAGE_BUFFER_SIZE);\
+    write_log_trace_point(&_log_call_site);\
     _log_writing_message=false;\
 }
 
 
+/*
+ * Structures.
+ */
+
+/* The place of a log macro on source code. */
+typedef struct __attribute__((aligned(8))) {
+    const char* function;
+    const char* file;
+    const char* format;
+    int line;
+    int message_type;
+} log_call_site_t;
+
+
 /*
  * Variables.
  */
 
-/* Buffer which the elaborated log messages are stored. */
-extern char _log_message_buffer[LOG_MESSAGE_BUFFER_SIZE];
+/* Indicates if a log messsage is being written by the current thread. */
+extern _Thread_local bool _log_writing_message;
 
-/* Indicates if a log messsage is being written. */
-extern bool _log_writing_message;
+/* Current log level. */
+extern int _log_level;
 
 
 /*
@@ -104,15 +148,27 @@ int finish_shell_script_log();
 /* Returns the current log directory. */
 char* get_log_directory();
 
+/* Returns the number of log messages discarded because the log ring was full. */
+uint64_t get_log_dropped_messages();
+
+/* Returns the number of log records waiting to be written by the log writer. */
+size_t get_log_pending_records();
+
 /* Returns the current log file name. */
 char* get_log_file_name();
 
 /* Returns the current log file path. */
 char* get_log_file_path();
 
+/* Returns the format of the log files. */
+int get_log_format();
+
 /* Returns the current log level. */
 int get_log_level();
 
+/* Returns the identifier of the current thread written on log records. */
+int get_log_thread_identifier();
+
 /* Indicates if a log file is open. */
 bool is_log_open();
 
@@ -125,13 +181,22 @@ int open_log_file(char*);
 /* Defines the directory to store log files. */
 int set_log_directory(const char*);
 
+/* Defines the format of the log files. */
+int set_log_format(int);
+
 /* Defines the current level of log file. */ 
 int set_log_level(int);
 
 /* Starts shell script log. */
 int start_shell_script_log(char*, int);
 
+/* Writes the message of a log macro call site. */
+int write_log_call_site(const log_call_site_t*, const char*, ...) __attribute__((format(printf, 2, 3)));
+
 /* Writes a log message. */
 int write_log_message(const int, const char*, const int, const char*);
 
+/* Writes the trace point of a log macro call site. */
+int write_log_trace_point(const log_call_site_t*);
+
 #endif
@@ -27,4 +27,28 @@
 /* The argument value used to define "error" level for program execution. */
 #define PARAMETER_LOG_VALUE_ERROR "ERROR"
 
+/* The argument used to define the format of the program log file. */
+#define PARAMETER_LOG_MODE "-m"
+
+/* The argument value used to write the program log file as text. */
+#define PARAMETER_LOG_MODE_VALUE_TEXT "TEXT"
+
+/* The argument value used to write the program log file as binary records (read through "annalog" program). */
+#define PARAMETER_LOG_MODE_VALUE_BINARY "BINARY"
+
+/* The argument used to define the transport used to communicate with remote devices. */
+#define PARAMETER_TRANSPORT "-t"
+
+/* The argument value used to communicate through bluetooth RFCOMM sockets. */
+#define PARAMETER_TRANSPORT_VALUE_RFCOMM "RFCOMM"
+
+/* The argument value used to communicate through local (AF_UNIX) sockets. */
+#define PARAMETER_TRANSPORT_VALUE_UNIX "UNIX"
+
+/* The argument value used to communicate through TCP loopback sockets. */
+#define PARAMETER_TRANSPORT_VALUE_TCP "TCP"
+
+/* The argument used to define the address which the transport listens for connections. */
+#define PARAMETER_TRANSPORT_ADDRESS "-a"
+
 #endif
@@ -15,6 +15,7 @@
  * Includes.
  */
 
+#include <stddef.h>
 #include <stdint.h>
 
 
@@ -22,6 +23,9 @@
  * Function specifications.
  */
 
+/* Fills a buffer with random bytes. */
+void fill_random_bytes(uint8_t*, size_t);
+
 /* Generates an array of random bytes */
 uint8_t* generate_random_bytes(size_t);
 
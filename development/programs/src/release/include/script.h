@@ -1,10 +1,10 @@
 /*
  * This header file contains the declaration of all components required to execute bash scripts.
  *
- * Version: 
+ * Version:
  *  0.1
  *
- * Author: 
+ * Author:
  *  Marcelo Leite
  */
 
@@ -13,10 +13,55 @@
 
 
 /*
- * Function elaborations.
+ * Includes.
+ */
+
+#include <stdint.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Time (in milliseconds) a script can run before it is terminated, if no other is informed. */
+#define SCRIPT_DEFAULT_TIMEOUT 10000
+
+/* Code returned when a script was terminated for exceeding its time limit (the same used by "timeout" command). */
+#define SCRIPT_TIMED_OUT 124
+
+/* Maximum size of a script name kept on statistics. */
+#define SCRIPT_STATISTICS_NAME_SIZE 64
+
+
+/*
+ * Structures.
+ */
+
+/* Execution statistics of a script. */
+typedef struct {
+    char script_name[SCRIPT_STATISTICS_NAME_SIZE];
+    uint32_t executions;
+    uint32_t failures;
+    uint32_t timeouts;
+    uint64_t total_time;
+    uint64_t maximum_time;
+} script_statistics_t;
+
+
+/*
+ * Function headers.
  */
 
 /* Executes a bash script. */
 int execute_script(char*);
 
+/* Executes a bash script with the arguments and time limit informed. */
+int execute_script_with_arguments(const char*, char* const[], int);
+
+/* Returns the execution statistics of a script. */
+int get_script_statistics(const char*, script_statistics_t*);
+
+/* Writes the execution statistics of all scripts on log. */
+void log_script_statistics();
+
 #endif
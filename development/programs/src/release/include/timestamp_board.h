@@ -0,0 +1,76 @@
+/*
+ * This header file contains the declaration of all components required to publish and read the instants events happened.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef TIMESTAMP_BOARD_H
+#define TIMESTAMP_BOARD_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Code returned when the instant of an event was never published. */
+#define TIMESTAMP_NOT_PUBLISHED 50
+
+/* The audio capture started reading the PCM device. */
+#define TIMESTAMP_EVENT_AUDIO_CAPTURE_STARTED 0
+
+/* The audio encoder encoded the first audio of an audio record. */
+#define TIMESTAMP_EVENT_FIRST_AUDIO_ENCODED 1
+
+/* An audio record was started. */
+#define TIMESTAMP_EVENT_AUDIO_RECORD_STARTED 2
+
+/* An audio record was stopped. */
+#define TIMESTAMP_EVENT_AUDIO_RECORD_STOPPED 3
+
+/* A command was received from the remote device. */
+#define TIMESTAMP_EVENT_COMMAND_RECEIVED 4
+
+/* Number of events on the timestamp board. */
+#define TIMESTAMP_EVENTS 5
+
+
+/*
+ * Structures.
+ */
+
+/* The instant an event happened. */
+typedef struct {
+    uint64_t monotonic_time;
+    int64_t real_time;
+    uint32_t publications;
+} event_timestamp_t;
+
+
+/*
+ * Function headers.
+ */
+
+/* Discards the instant published for an event. */
+int clear_event_timestamp(int);
+
+/* Reads the latest instant published for an event. */
+int get_event_timestamp(int, event_timestamp_t*);
+
+/* Returns the time (in nanoseconds) elapsed between the latest instants published for two events. */
+int get_events_interval(int, int, int64_t*);
+
+/* Publishes the current instant for an event. */
+int publish_event_timestamp(int);
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * This header file contains the declaration of all components required to measure time intervals.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+#ifndef TIMING_H
+#define TIMING_H
+
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+#include <sys/time.h>
+#include <time.h>
+
+
+/*
+ * Macros.
+ */
+
+/* Number of nanoseconds on a second. */
+#define NANOSECONDS_PER_SECOND 1000000000LL
+
+/* Number of nanoseconds on a millisecond. */
+#define NANOSECONDS_PER_MILLISECOND 1000000LL
+
+/* Number of nanoseconds on a microsecond. */
+#define NANOSECONDS_PER_MICROSECOND 1000LL
+
+
+/*
+ * Function headers.
+ */
+
+/* Converts a time interval in nanoseconds to a "timespec" structure. */
+struct timespec convert_nanoseconds_to_timespec(int64_t);
+
+/* Converts a time interval in nanoseconds to a "timeval" structure. */
+struct timeval convert_nanoseconds_to_timeval(int64_t);
+
+/* Returns the time (in nanoseconds) elapsed since the system booted, including the time it was suspended. */
+uint64_t get_boot_time();
+
+/* Returns the monotonic time (in nanoseconds) elapsed since an instant. */
+int64_t get_elapsed_time(uint64_t);
+
+/* Returns the current monotonic time in nanoseconds. */
+uint64_t get_monotonic_time();
+
+/* Returns the difference (in nanoseconds) between two times. */
+int64_t get_time_difference(uint64_t, uint64_t);
+
+#endif
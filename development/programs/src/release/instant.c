@@ -13,7 +13,7 @@
  */
 
 #include <errno.h>
-#include <math.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
@@ -33,46 +33,24 @@
 /* Length of miliseconds formatted as a string. */
 #define STRING_MILISECONDS_LENGTH 4
 
-/* Ratio between a microsecond and a second. */
-#define MILISECONDS_ON_A_SECOND 1000000.0
-
-/* Ratio between a microseconds and a minute. */
-#define MILISECONDS_ON_A_MINUTE MILISECONDS_ON_A_SECOND * 60.0
-
-/* Ratio between a microseconds and an hour. */
-#define MILISECONDS_ON_AN_HOUR MILISECONDS_ON_A_MINUTE * 60
-
 
 /*
- * Function elaborations.
+ * Variables.
  */
 
-/*
- * Converts an structure "instant" to an structure "timeval"
- *
- * Parameters
- *  instant - Instant to be converted.
- *
- * Returns
- *  An struct "timeval" with the current instant stored.
- *
- * Observations
- *  Currently this function only considers microseconds, seconds, minutes and hours on conversion.
- */
-struct timeval convert_instant_to_timeval(instant_t instant) {
-    LOG_TRACE_POINT;
+/* Indicates if the current thread has a date cached to format instants. */
+_Thread_local bool read_date_cached = false;
 
-    struct timeval result;
+/* Second of the date cached by the current thread. */
+_Thread_local time_t read_date_cached_second;
 
-    result.tv_usec = instant.useconds;
+/* Date cached by the current thread, formatted as "dd/mm/YYYY HH:MM:SS". */
+_Thread_local char read_date_cached_string[STRING_DATE_LENGTH + 1];
 
-    result.tv_sec  = instant.date.tm_sec;
-    result.tv_sec += instant.date.tm_min*60;
-    result.tv_sec += instant.date.tm_hour*60*60;
 
-    LOG_TRACE_POINT;
-    return result;
-}
+/*
+ * Function elaborations.
+ */
 
 /*
  * Formats an instant as a human-readable string.
@@ -117,6 +95,58 @@ char* format_instant_to_read(instant_t instant) {
     return result;
 }
 
+/*
+ * Formats an instant as a human-readable string on a buffer.
+ *
+ * Parameters
+ *  buffer - The buffer where the instant will be formatted. It must have at least "TIME_STRING_READ_LENGTH + 1" characters.
+ *  instant - The instant to be formatted.
+ *
+ * Returns
+ *  SUCCESS - If the instant was formatted successfully.
+ *  GENERIC_ERROR - Otherwise. In this case, an empty string is written on buffer.
+ *
+ * Observations
+ *  Each thread keeps the date of the last second formatted, so "localtime_r" and "strftime" are called only once a second.
+ *  The miliseconds are written on the cached date without allocating memory.
+ *  This function is used to format log messages, so it must not use log macros.
+ */
+int format_instant_to_read_buffer(char* buffer, struct timespec instant) {
+
+    struct tm date;
+    int miliseconds;
+
+    if ( buffer == NULL ) {
+        return GENERIC_ERROR;
+    }
+
+    if ( read_date_cached == false || read_date_cached_second != instant.tv_sec ) {
+        if ( localtime_r(&instant.tv_sec, &date) == NULL ) {
+            buffer[0] = '\0';
+            return GENERIC_ERROR;
+        }
+
+        if ( strftime(read_date_cached_string, STRING_DATE_LENGTH + 1, "%d/%m/%Y %H:%M:%S", &date) != STRING_DATE_LENGTH ) {
+            read_date_cached = false;
+            buffer[0] = '\0';
+            return GENERIC_ERROR;
+        }
+        read_date_cached_second = instant.tv_sec;
+        read_date_cached = true;
+    }
+
+    miliseconds = instant.tv_nsec/1000000;
+
+    memcpy(buffer, read_date_cached_string, STRING_DATE_LENGTH);
+    buffer[STRING_DATE_LENGTH] = '.';
+    buffer[STRING_DATE_LENGTH + 1] = '0' + miliseconds/100;
+    buffer[STRING_DATE_LENGTH + 2] = '0' + (miliseconds/10)%10;
+    buffer[STRING_DATE_LENGTH + 3] = '0' + miliseconds%10;
+    buffer[TIME_STRING_READ_LENGTH] = '\0';
+
+    return SUCCESS;
+}
+
 /*
  * Formats the instant as a string to sort files. 
  *
@@ -178,69 +208,6 @@ instant_t get_instant() {
     return instant;
 }
 
-/*
- * Returns the difference between two instants.
- *
- * Parameters
- *   result - Variable where the result will be stored.
- *   instant_1 - First operator to calculate the difference.
- *   instant_2 - Second operator to calculate the differente.
- *
- * Returns
- *   SUCCESS - If the difference was calculated correctly.
- *   GENERIC_ERROR - Otherwise.
- *
- * Observations
- *  Currently this function only considers microseconds, seconds, minutes and hours to calculate the difference.
- */
-int get_instant_difference(instant_t* result, instant_t instant_1, instant_t instant_2) {
-    LOG_TRACE_POINT;
-
-    if ( result == NULL ) {
-        LOG_ERROR("Result variable pointer is null.");
-        return GENERIC_ERROR;
-    }
-
-    float total_useconds_1;
-    float total_useconds_2;
-    float total_useconds_result;
-
-    total_useconds_1 = ((float)instant_1.useconds);
-    total_useconds_1 += ((float)instant_1.date.tm_sec * MILISECONDS_ON_A_SECOND);
-    total_useconds_1 += ((float)instant_1.date.tm_min * MILISECONDS_ON_A_MINUTE);
-    total_useconds_1 += ((float)instant_1.date.tm_hour * MILISECONDS_ON_AN_HOUR);
-    LOG_TRACE("Microseconds on operator 1: %f.", total_useconds_1);
-
-    total_useconds_2 = ((float)instant_2.useconds);
-    total_useconds_2 += ((float)instant_2.date.tm_sec * MILISECONDS_ON_A_SECOND);
-    total_useconds_2 += ((float)instant_2.date.tm_min * MILISECONDS_ON_A_MINUTE);
-    total_useconds_2 += ((float)instant_2.date.tm_hour * MILISECONDS_ON_AN_HOUR);
-    LOG_TRACE("Microseconds on operator 2: %f.", total_useconds_2);
-
-    if ( total_useconds_2 > total_useconds_1 ) {
-        LOG_ERROR("Instant registered on second operator is later than first operator.");
-        return GENERIC_ERROR;
-    }
-
-    total_useconds_result = total_useconds_1 - total_useconds_2;
-    memset(result, 0, sizeof(instant_t));
-    LOG_TRACE_POINT;
-
-    result->date.tm_hour = (int)floor(total_useconds_result / (MILISECONDS_ON_AN_HOUR));
-    total_useconds_result -= (float)result->date.tm_hour * MILISECONDS_ON_AN_HOUR;
-
-    result->date.tm_min = (int)floor(total_useconds_result / (MILISECONDS_ON_A_MINUTE));
-    total_useconds_result -= (float)result->date.tm_min * MILISECONDS_ON_A_MINUTE;
-
-    result->date.tm_sec = (int)floor(total_useconds_result / (MILISECONDS_ON_A_SECOND));
-    total_useconds_result -= (float)result->date.tm_sec * MILISECONDS_ON_A_SECOND;
-
-    result->useconds = total_useconds_result;
-
-    LOG_TRACE_POINT;
-    return SUCCESS;
-}
-
 /*
  * Retrieves the current instant formatted as a string to sort files. 
  *
@@ -290,121 +257,28 @@ char* get_instant_read_formatted() {
 }
 
 /*
- * Retrieves an instant stored on a file.
- * 
- * Parameters
- *  instant - Pointer to the variable which the instant will be stored.
- *  file_path - Path to the file which the instant is stored.
- *
- * Returns
- *   SUCCESS - If the instant was retrieved successfully.
- *   GENERIC_ERROR - Otherwise.
- */
-int retrieve_instant_from_file(instant_t* instant, char* file_path) {
-    LOG_TRACE("File to retrieve the instant: %s.", file_path);
-
-    if ( file_path == NULL ) {
-        LOG_ERROR("File path informed is null.");
-        return GENERIC_ERROR;
-    }
-
-    if ( instant == NULL ) {
-        LOG_ERROR("Variable pointer to store the instant is null.");
-        return GENERIC_ERROR;
-    }
-
-    FILE* input_file;
-    char* pointer;
-    int errno_value;
-    size_t instant_size;
-    int counter;
-    int fclose_result;
-
-    input_file = fopen(file_path, "rb");
-    if ( input_file == NULL ) {
-        errno_value = errno;
-        LOG_ERROR("Error while opening file \"%s\".", file_path);
-        LOG_ERROR("%s\n.", strerror(errno_value));
-        return GENERIC_ERROR;
-    }
-
-    memset(instant, 0, sizeof(instant_t));
-    pointer = (char*)instant;
-
-    instant_size = sizeof(instant_t);
-    for (counter = 0; counter < instant_size; counter++) {
-        *pointer = fgetc(input_file);
-        pointer += sizeof(char);
-    }
-    LOG_TRACE_POINT;
-
-    fclose_result = fclose(input_file);
-    if (fclose_result != 0 ) {
-        errno_value = errno;
-        fprintf(stderr, "Error while closing file \"%s\".\n", file_path);
-        fprintf(stderr, "%s\n.", strerror(errno_value));
-        return GENERIC_ERROR;
-    }
-
-    LOG_TRACE_POINT;
-    return SUCCESS;
-}
-
-
-/*
- * Stores the current instant on a file.
+ * Formats the current instant as a human-readable string on a buffer.
  *
  * Parameters
- *  file_path - Path to the file to store current instant.
+ *  buffer - The buffer where the current instant will be formatted. It must have at least "TIME_STRING_READ_LENGTH + 1" characters.
  *
  * Returns
- *  SUCCESS - If current instant was stored correctly.
- *  GENERIC_ERROR - Otherwise.
+ *  SUCCESS - If the current instant was formatted successfully.
+ *  GENERIC_ERROR - Otherwise. In this case, an empty string is written on buffer.
+ *
+ * Observations
+ *  This function is used to format log messages, so it must not use log macros.
  */
-int store_current_instant(char* file_path) {
-    LOG_TRACE("File to store current instant: \"%s\".", file_path);
-
-    if ( file_path == NULL ) {
-        LOG_ERROR("File path informed is invalid.");
-        return GENERIC_ERROR;
-    }
-
-    FILE* output_file;
-    int errno_value;
-    int fclose_result;
-    char* pointer;
-    instant_t instant;
-    size_t instant_size;
-    int counter;
-
-    output_file = fopen(file_path, "wb");
-    if ( output_file == NULL ) {
-        errno_value = errno;
-        fprintf(stderr, "Error while opening file \"%s\".\n", file_path);
-        fprintf(stderr, "%s\n.", strerror(errno_value));
-        return GENERIC_ERROR;
-    }
+int get_instant_read_formatted_buffer(char* buffer) {
 
-    instant = get_instant();
-    LOG_TRACE_POINT;
+    struct timespec current_time;
 
-    pointer = (char*)&instant;
-    instant_size = sizeof(instant_t);
-    for (counter = 0; counter < instant_size; counter++) {
-        fputc((int)*pointer, output_file);
-        pointer += sizeof(char);
-    }
-    LOG_TRACE_POINT;
-
-    fclose_result = fclose(output_file);
-    if (fclose_result != 0 ) {
-        errno_value = errno;
-        fprintf(stderr, "Error while closing file \"%s\".\n", file_path);
-        fprintf(stderr, "%s\n.", strerror(errno_value));
+    if ( clock_gettime(CLOCK_REALTIME, &current_time) != 0 ) {
+        if ( buffer != NULL ) {
+            buffer[0] = '\0';
+        }
         return GENERIC_ERROR;
     }
 
-    LOG_TRACE_POINT;
-    return SUCCESS;
+    return format_instant_to_read_buffer(buffer, current_time);
 }
-
@@ -15,15 +15,25 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
 
+#include "binary_log.h"
 #include "directory.h"
 #include "instant.h"
 #include "log.h"
 #include "return_codes.h"
 #include "script.h"
+#include "timing.h"
 
 
 /*
@@ -33,11 +43,6 @@
 /* Default directory to log files. */
 #define DEFAULT_LOG_DIRECTORY "./logs/"
 
-/* Preffixes used to identify message levels. */
-#define LOG_TRACE_PREFFIX "TRACE"
-#define LOG_WARNING_PREFFIX "WARNING"
-#define LOG_ERROR_PREFFIX "ERROR"
-
 /* Script to start shell script log. */
 #define SHELL_SCRIPT_START_LOG "start_log.sh"
 
@@ -59,28 +64,63 @@
 /* Suffix to identify log files. */
 #define LOG_FILE_SUFFIX ".log"
 
-/* Length of error messsage buffer. */
-#define ERROR_MESSAGE_BUFFER_LENGTH 1024
+/* Suffix to identify binary log files. */
+#define LOG_BINARY_FILE_SUFFIX ".alog"
 
 /* Size of variable that stored the log directory. */
 #define LOG_DIRECTORY_SIZE 512
 
+/* Number of log records which can wait to be written. Must be a power of two. */
+#define LOG_RING_SIZE 1024
+
+/* Time (in milliseconds) the log writer sleeps when there are no records to write. */
+#define LOG_WRITER_IDLE_TIME 5
+
+/* Size of the buffer used to format a log record. */
+#define LOG_RECORD_FORMAT_BUFFER_SIZE 1024
+
+/* Message written when log messages were discarded because the log ring was full. */
+#define LOG_DROPPED_MESSAGES_FORMAT "%llu log message(s) discarded because the log ring was full."
+
+/* Format of the messages written through "write_log_message" function on binary log files. */
+#define LOG_MESSAGE_BINARY_FORMAT "%s (%d): %s"
+
 /* Prints an error message. */
-#define _LOG_PRINT_ERROR(x) fprintf(stderr, "[%s] %s: (%s, %d): %s\n", get_instant_read_formatted(), LOG_ERROR_PREFFIX, __func__, __LINE__, (x))
+#define _LOG_PRINT_ERROR(x) {\
+    char _log_error_instant[TIME_STRING_READ_LENGTH + 1];\
+    get_instant_read_formatted_buffer(_log_error_instant);\
+    fprintf(stderr, "[%s] %s: (%s, %d): %s\n", _log_error_instant, LOG_ERROR_PREFFIX, __func__, __LINE__, (x));\
+}
 
 
 /*
- * Variables.
+ * Structures.
  */
 
-/* Log message buffer. */
-char _log_message_buffer[LOG_MESSAGE_BUFFER_SIZE];
+/* A log message captured and waiting to be written by the log writer. */
+typedef struct {
+    atomic_size_t sequence;
+    int message_type;
+    const char* tag;
+    int index;
+    int thread_identifier;
+    struct timespec instant;
+    const log_call_site_t* call_site;
+    uint64_t timestamp;
+    size_t arguments_size;
+    char message[LOG_MESSAGE_BUFFER_SIZE];
+} log_record_t;
 
-/* Indicates that a message is being written. */
-bool _log_writing_message = false;
 
-/* Error message. */
-char error_message[ERROR_MESSAGE_BUFFER_LENGTH];
+/*
+ * Variables.
+ */
+
+/* Indicates that a message is being written by the current thread. */
+_Thread_local bool _log_writing_message = false;
+
+/* Identifier of the current thread written on log records. */
+_Thread_local int log_thread_identifier = 0;
 
 /* Current directory to store log files. */
 char log_directory[LOG_DIRECTORY_SIZE];
@@ -91,6 +131,9 @@ bool log_directory_initialized = false;
 /* Current log file. */
 FILE* log_file = NULL;
 
+/* Controls the access to the current log file, so records of different threads are not mixed. */
+pthread_mutex_t log_file_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /* Current log file name. */
 char* log_file_name = NULL;
 
@@ -98,19 +141,104 @@ char* log_file_name = NULL;
 char* log_file_path = NULL;
 
 /* Current log level. */
-int log_level = LOG_MESSAGE_TYPE_TRACE;
+int _log_level = LOG_MESSAGE_TYPE_TRACE;
 
 /* Indicates if start log level is defined. */
 bool start_log_level_defined = false;
 
+/* Records waiting to be written by the log writer. */
+log_record_t log_ring[LOG_RING_SIZE];
+
+/* Position of the next record to be captured on the log ring. */
+atomic_size_t log_ring_enqueue_position = 0;
+
+/* Position of the next record to be written from the log ring. */
+atomic_size_t log_ring_dequeue_position = 0;
+
+/* Number of threads capturing a record on the log ring. */
+atomic_int log_ring_producers = 0;
+
+/* Number of log messages discarded because the log ring was full. */
+atomic_uint_least64_t log_dropped_messages = 0;
+
+/* Number of discarded log messages already informed on log file. */
+uint64_t log_dropped_messages_informed = 0;
+
+/* Indicates if the log writer is running. */
+atomic_bool log_writer_running = false;
+
+/* Indicates if the log writer must finish. */
+atomic_bool log_writer_finishing = false;
+
+/* Thread which writes the log records. */
+pthread_t log_writer_thread;
+
+/* Indicates if the log writer fork handler was registered. */
+bool log_writer_fork_handler_registered = false;
+
+/* Format of the log files opened. */
+int log_format = LOG_FORMAT_TEXT;
+
+/* Indicates if the current log file is written as binary records. */
+atomic_bool log_binary_format_active = false;
+
+/* Time (in nanoseconds) of the latest record written on the binary log file. */
+uint64_t log_binary_latest_timestamp;
+
+/* Indicates (one bit per call site) which call sites were already defined on the binary log file. */
+uint8_t* log_call_sites_defined = NULL;
+
+/* First and last call sites of log macros, placed by the linker on the call sites section. */
+extern const log_call_site_t __start_anna_log_call_sites[];
+extern const log_call_site_t __stop_anna_log_call_sites[];
+
 
 /*
  * Function headers.
  */
 
+/* Captures the message of a call site on the log ring or writes it on the binary log file. */
+int capture_binary_log_record(const log_call_site_t*, const char*, va_list*);
+
+/* Claims a record of the log ring to be filled. */
+log_record_t* claim_log_record(size_t*);
+
+/* Captures a log message on the log ring. */
+bool enqueue_log_record(const int, const char*, const int, const char*);
+
+/* Publishes a record of the log ring to be written. */
+void publish_log_record(log_record_t*, size_t);
+
+/* Writes a record on the binary log file. */
+void write_binary_log_record(FILE*, const log_call_site_t*, int, uint64_t, const uint8_t*, size_t);
+
 /* Format a message to be logged. */
 int format_log_message(char*, int, const int, const char*, const int, const char*);
 
+/* Formats a log record. */
+int format_log_record(char*, size_t, log_record_t*);
+
+/* Locks the log file before a process is forked. */
+void lock_log_file_on_fork();
+
+/* Stops using the log writer on a child process. */
+void release_log_writer_on_fork();
+
+/* Unlocks the log file on the parent process after it is forked. */
+void unlock_log_file_on_fork();
+
+/* Writes the log records captured until the log writer is finished. */
+void* run_log_writer(void*);
+
+/* Starts the log writer. */
+int start_log_writer();
+
+/* Stops the log writer, writing all records captured. */
+int stop_log_writer();
+
+/* Writes the log records available on the log ring. */
+size_t write_log_records(FILE*);
+
 /* Initializes log directory. */
 int initialize_log_directory();
 
@@ -125,6 +253,109 @@ int undefine_shell_start_log_level();
  * Function elaborations.
  */
 
+/*
+ * Captures the message of a call site on the log ring or writes it on the binary log file.
+ *
+ * Parameters
+ *  call_site - The call site of the log macro.
+ *  format - The format of the message.
+ *  arguments - The arguments of the message format. If it is null, the call site is a trace point without message.
+ *
+ * Returns
+ *  SUCCESS - The message is always captured, unless the log ring is full.
+ *
+ * Observations
+ *  Only the arguments of the message are encoded on the record. Its text is formatted by "annalog" program when the binary log file is read.
+ *  While the log writer is not running the record is written directly on file, holding the log file lock.
+ *  This function must not use log macros, since it is called while a message is being logged.
+ */
+int capture_binary_log_record(const log_call_site_t* call_site, const char* format, va_list* arguments) {
+
+    log_record_t* log_record;
+    uint8_t arguments_buffer[LOG_MESSAGE_BUFFER_SIZE];
+    size_t arguments_size = 0;
+    size_t position;
+    uint64_t timestamp;
+
+    timestamp = get_monotonic_time();
+
+    atomic_fetch_add(&log_ring_producers, 1);
+    if ( atomic_load(&log_writer_running) == true ) {
+        log_record = claim_log_record(&position);
+        if ( log_record == NULL ) {
+            atomic_fetch_add_explicit(&log_dropped_messages, 1, memory_order_relaxed);
+            atomic_fetch_sub(&log_ring_producers, 1);
+            return SUCCESS;
+        }
+
+        log_record->call_site = call_site;
+        log_record->thread_identifier = get_log_thread_identifier();
+        log_record->timestamp = timestamp;
+        log_record->arguments_size = 0;
+        if ( arguments != NULL ) {
+            log_record->arguments_size = encode_binary_log_arguments((uint8_t*)log_record->message, LOG_MESSAGE_BUFFER_SIZE, format, *arguments);
+        }
+
+        publish_log_record(log_record, position);
+        atomic_fetch_sub(&log_ring_producers, 1);
+        return SUCCESS;
+    }
+    atomic_fetch_sub(&log_ring_producers, 1);
+
+    if ( arguments != NULL ) {
+        arguments_size = encode_binary_log_arguments(arguments_buffer, LOG_MESSAGE_BUFFER_SIZE, format, *arguments);
+    }
+
+    pthread_mutex_lock(&log_file_mutex);
+    if ( log_binary_format_active == true ) {
+        write_binary_log_record(log_file, call_site, get_log_thread_identifier(), timestamp, arguments_buffer, arguments_size);
+        fflush(log_file);
+    }
+    pthread_mutex_unlock(&log_file_mutex);
+
+    return SUCCESS;
+}
+
+/*
+ * Claims a record of the log ring to be filled.
+ *
+ * Parameters
+ *  position - The variable where the position of the record claimed will be stored.
+ *
+ * Returns
+ *  The record claimed or NULL if the log ring is full.
+ *
+ * Observations
+ *  The log ring is a bounded lock free queue: each record has a sequence number which indicates if it is free to be claimed or ready to be written.
+ *  The record claimed must be published through "publish_log_record" function.
+ *  This function must not use log macros, since it is called while a message is being logged.
+ */
+log_record_t* claim_log_record(size_t* position) {
+
+    log_record_t* log_record;
+    size_t sequence;
+    intptr_t difference;
+
+    *position = atomic_load_explicit(&log_ring_enqueue_position, memory_order_relaxed);
+    while ( true ) {
+        log_record = &log_ring[*position & (LOG_RING_SIZE - 1)];
+        sequence = atomic_load_explicit(&log_record->sequence, memory_order_acquire);
+        difference = (intptr_t)sequence - (intptr_t)*position;
+
+        if ( difference == 0 ) {
+            if ( atomic_compare_exchange_weak_explicit(&log_ring_enqueue_position, position, *position + 1, memory_order_relaxed, memory_order_relaxed) ) {
+                return log_record;
+            }
+        }
+        else if ( difference < 0 ) {
+            return NULL;
+        }
+        else {
+            *position = atomic_load_explicit(&log_ring_enqueue_position, memory_order_relaxed);
+        }
+    }
+}
+
 /*
  * Closes a log file.
  *
@@ -138,22 +369,44 @@ int undefine_shell_start_log_level();
 int close_log_file() {
     LOG_TRACE_POINT;
 
+    char instant_read_formatted[TIME_STRING_READ_LENGTH + 1];
+    uint8_t end_of_log_record[BINARY_LOG_RECORD_HEADER_MAXIMUM_SIZE];
+    size_t end_of_log_record_size;
+    int fclose_result;
+
     if ( is_log_open() == false ) {
         LOG_ERROR("There is not a log file opened.\n");
         return GENERIC_ERROR;
     }
 
-    char* instant_read_formatted = get_instant_read_formatted();
+    stop_log_writer();
     LOG_TRACE_POINT;
 
-    fprintf(log_file, "[%s] Log finished.\n", instant_read_formatted);
-    free(instant_read_formatted);
+    /* No log macro can be used while the log file is locked. */
+    pthread_mutex_lock(&log_file_mutex);
+
+    if ( log_binary_format_active == true ) {
+        end_of_log_record_size = encode_binary_log_record_header(end_of_log_record, BINARY_LOG_END_OF_LOG, get_log_thread_identifier(), get_elapsed_time(log_binary_latest_timestamp), 0);
+        fwrite(end_of_log_record, sizeof(uint8_t), end_of_log_record_size, log_file);
 
-    if ( fclose(log_file) != 0 ) {
+        log_binary_format_active = false;
+        free(log_call_sites_defined);
+        log_call_sites_defined = NULL;
+    }
+    else {
+        get_instant_read_formatted_buffer(instant_read_formatted);
+        fprintf(log_file, "[%s] Log finished.\n", instant_read_formatted);
+    }
+
+    fclose_result = fclose(log_file);
+    log_file=NULL;
+
+    pthread_mutex_unlock(&log_file_mutex);
+
+    if ( fclose_result != 0 ) {
         LOG_ERROR("Error while closing log file.\n");
         return GENERIC_ERROR; 
     }
-    log_file=NULL;
 
     free(log_file_name);
     log_file_name=NULL;
@@ -180,6 +433,7 @@ char* create_log_file_name(char* log_file_preffix){
     char* result;
     int log_file_preffix_length;
     char* current_time_file_formatted;
+    char* log_file_suffix;
 
     if ( log_file_preffix == NULL ) {
         LOG_ERROR("Log file preffix is null.\n");
@@ -188,14 +442,21 @@ char* create_log_file_name(char* log_file_preffix){
 
     log_file_preffix_length = strlen(log_file_preffix);
 
-    result = malloc((log_file_preffix_length+TIME_STRING_FILE_LENGTH+strlen(LOG_FILE_SUFFIX)+2)*sizeof(char));
+    if ( log_format == LOG_FORMAT_BINARY ) {
+        log_file_suffix = LOG_BINARY_FILE_SUFFIX;
+    }
+    else {
+        log_file_suffix = LOG_FILE_SUFFIX;
+    }
+
+    result = malloc((log_file_preffix_length+TIME_STRING_FILE_LENGTH+strlen(log_file_suffix)+2)*sizeof(char));
 
     strcpy(result, log_file_preffix);
     strcat(result, "_");
     current_time_file_formatted = get_instant_file_formatted();
     strcat(result, current_time_file_formatted);
     free(current_time_file_formatted);
-    strcat(result, LOG_FILE_SUFFIX);
+    strcat(result, log_file_suffix);
 
     LOG_TRACE_POINT;
     return result;
@@ -215,13 +476,16 @@ int define_start_log_level(int start_log_level) {
     LOG_TRACE_POINT;
 
     int result;
-    char command[256];
+    char start_log_level_argument[16];
+    char* arguments[2];
     int script_result;
     int start_log_level_result;
 
-    sprintf(command, "%s %d", SHELL_SCRIPT_DEFINE_START_LOG_LEVEL, start_log_level);
+    sprintf(start_log_level_argument, "%d", start_log_level);
+    arguments[0] = start_log_level_argument;
+    arguments[1] = NULL;
 
-    script_result = execute_script(command);
+    script_result = execute_script_with_arguments(SHELL_SCRIPT_DEFINE_START_LOG_LEVEL, arguments, SCRIPT_DEFAULT_TIMEOUT);
     LOG_TRACE_POINT;
 
     if ( script_result == SUCCESS ) {
@@ -249,6 +513,52 @@ int define_start_log_level(int start_log_level) {
     return result;
 }
 
+/*
+ * Captures a log message on the log ring.
+ *
+ * Parameters
+ *  message_type - Type of log message.
+ *  tag - Tag to identify log message origin. It must be valid until the log writer is stopped.
+ *  index - Index to identify log message origin.
+ *  message - Message to be written (optional).
+ *
+ * Returns
+ *  True - If the message was captured.
+ *  False - If the log ring is full.
+ *
+ * Observations
+ *  This function must not use log macros, since it is called while a message is being logged.
+ */
+bool enqueue_log_record(const int message_type, const char* tag, const int index, const char* message) {
+
+    log_record_t* log_record;
+    size_t position;
+    size_t message_length;
+
+    log_record = claim_log_record(&position);
+    if ( log_record == NULL ) {
+        return false;
+    }
+
+    log_record->call_site = NULL;
+    log_record->message_type = message_type;
+    log_record->tag = tag;
+    log_record->index = index;
+    log_record->thread_identifier = get_log_thread_identifier();
+    clock_gettime(CLOCK_REALTIME, &log_record->instant);
+
+    message_length = 0;
+    if ( message != NULL ) {
+        message_length = strnlen(message, LOG_MESSAGE_BUFFER_SIZE - 1);
+        memcpy(log_record->message, message, message_length);
+    }
+    log_record->message[message_length] = '\0';
+
+    publish_log_record(log_record, position);
+
+    return true;
+}
+
 /*
  * Finishes a shell script log file.
  *
@@ -312,21 +622,13 @@ int finish_shell_script_log(){
  *  GENERIC ERROR - Otherwise.
  *
  * Observations
- *  The formatted message is returned through "buffer" parameter.
+ *  The formatted message is returned through "buffer" parameter. A message longer than "buffer_size" is truncated.
  */
 int format_log_message(char* buffer, int buffer_size, const int message_type, const char* tag, const int index, const char* message) {
     LOG_TRACE_POINT;
 
     char* preffix;
-    int preffix_length;
-    int tag_length;
-    char string_index[20];
-    int string_index_length;
-    char* temporary_buffer;
-    int temporary_buffer_length;
-    int message_length;
-    int additional_characters;
-    char* instant_read_formatted;
+    char instant_read_formatted[TIME_STRING_READ_LENGTH + 1];
 
     /* Check "buffer" parameter. */
     if ( buffer == NULL ) {
@@ -364,54 +666,77 @@ int format_log_message(char* buffer, int buffer_size, const int message_type, co
             break;
     }
 
-    preffix_length=strlen(preffix);
-
     /* Check "tag" parameter. */
     if ( tag == NULL ) {
         LOG_ERROR("Message tag is null.\n");
         return GENERIC_ERROR;
     }
 
-    tag_length=strlen(tag);
-
-    /* Check "index" parameter. */
-    sprintf(string_index, "%d", index);
-    string_index_length = strlen(string_index);
+    get_instant_read_formatted_buffer(instant_read_formatted);
+    LOG_TRACE_POINT;
 
-    if ( message != NULL ) {
+    if ( message != NULL && message[0] != '\0' ) {
         LOG_TRACE_POINT;
-        message_length = strlen(message) + 2;
-        additional_characters=10;
+        snprintf(buffer, buffer_size, "[%s] [%d] %s: %s (%d): %s", instant_read_formatted, get_log_thread_identifier(), preffix, tag, index, message);
     }
     else {
         LOG_TRACE_POINT;
-        message_length = 0;
-        additional_characters=8;
+        snprintf(buffer, buffer_size, "[%s] [%d] %s: %s (%d)", instant_read_formatted, get_log_thread_identifier(), preffix, tag, index);
     }
 
-    temporary_buffer_length = TIME_STRING_READ_LENGTH + preffix_length+tag_length + string_index_length + message_length + additional_characters + 1;
-    temporary_buffer = malloc(temporary_buffer_length*sizeof(char));
-
-    instant_read_formatted = get_instant_read_formatted();
     LOG_TRACE_POINT;
+    return SUCCESS;
+}
 
-    if ( message != NULL && strlen(message) > 0 ) {
-        LOG_TRACE_POINT;
-        sprintf(temporary_buffer, "[%s] %s: %s (%s): %s", instant_read_formatted, preffix, tag, string_index, message);
+/*
+ * Formats a log record.
+ *
+ * Parameters
+ *  buffer - Buffer where the log record will be formatted.
+ *  buffer_size - Size of "buffer" parameter.
+ *  log_record - The log record to be formatted.
+ *
+ * Returns
+ *  The number of characters written on buffer.
+ *
+ * Observations
+ *  The log record is formatted the same way as "format_log_message" function does, using the instant it was captured.
+ *  This function runs on the log writer, so it must not use log macros.
+ */
+int format_log_record(char* buffer, size_t buffer_size, log_record_t* log_record) {
+
+    char* preffix;
+    char string_date[TIME_STRING_READ_LENGTH + 1];
+    int length;
+
+    switch (log_record->message_type) {
+        case LOG_MESSAGE_TYPE_WARNING:
+            preffix = LOG_WARNING_PREFFIX;
+            break;
+
+        case LOG_MESSAGE_TYPE_ERROR:
+            preffix = LOG_ERROR_PREFFIX;
+            break;
+
+        default:
+            preffix = LOG_TRACE_PREFFIX;
+            break;
+    }
+
+    format_instant_to_read_buffer(string_date, log_record->instant);
+
+    if ( log_record->message[0] != '\0' ) {
+        length = snprintf(buffer, buffer_size, "[%s] [%d] %s: %s (%d): %s\n", string_date, log_record->thread_identifier, preffix, log_record->tag, log_record->index, log_record->message);
     }
     else {
-        LOG_TRACE_POINT;
-        sprintf(temporary_buffer, "[%s] %s: %s (%s)", instant_read_formatted, preffix, tag, string_index);
+        length = snprintf(buffer, buffer_size, "[%s] [%d] %s: %s (%d)\n", string_date, log_record->thread_identifier, preffix, log_record->tag, log_record->index);
     }
-    free(instant_read_formatted);
 
-    strcpy(buffer, temporary_buffer);
-
-    free(temporary_buffer);
-    temporary_buffer = NULL;
+    if ( length >= (int)buffer_size ) {
+        length = buffer_size - 1;
+    }
 
-    LOG_TRACE_POINT;
-    return SUCCESS;
+    return length;
 }
 
 /*
@@ -438,6 +763,41 @@ char* get_log_directory() {
     return log_directory;
 }
 
+/*
+ * Returns the number of log messages discarded because the log ring was full.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The number of log messages discarded since the program started.
+ */
+uint64_t get_log_dropped_messages() {
+    LOG_TRACE_POINT;
+
+    return atomic_load_explicit(&log_dropped_messages, memory_order_relaxed);
+}
+
+/*
+ * Returns the number of log records waiting to be written by the log writer.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The number of log records claimed on the log ring and not written yet.
+ *
+ * Observations
+ *  The value is only a snapshot, since other threads can log messages at the same time. It allows a program to wait for the log writer before logging a burst of messages.
+ *  This function must not use log macros, since a trace point would add a record to the ones it is waiting for.
+ */
+size_t get_log_pending_records() {
+
+    size_t dequeue_position = atomic_load_explicit(&log_ring_dequeue_position, memory_order_acquire);
+
+    return atomic_load_explicit(&log_ring_enqueue_position, memory_order_relaxed) - dequeue_position;
+}
+
 /*
  * Returns the current log file name.
  *
@@ -483,6 +843,21 @@ char* get_log_file_path() {
     return log_file_path;
 }
 
+/*
+ * Returns the format of the log files.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The format of the log files ("LOG_FORMAT_TEXT" or "LOG_FORMAT_BINARY").
+ */
+int get_log_format() {
+    LOG_TRACE_POINT;
+
+    return log_format;
+}
+
 /*
  * Returns the current log level.
  *
@@ -494,7 +869,29 @@ char* get_log_file_path() {
  */
 int get_log_level() {
     LOG_TRACE_POINT;
-    return log_level;
+    return _log_level;
+}
+
+/*
+ * Returns the identifier of the current thread written on log records.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The identifier of the current thread on kernel, the same presented by system tools (like "top -H").
+ *
+ * Observations
+ *  The identifier is retrieved once for each thread.
+ *  This function must not use log macros, since it is called while a message is being logged.
+ */
+int get_log_thread_identifier() {
+
+    if ( log_thread_identifier == 0 ) {
+        log_thread_identifier = (int)syscall(SYS_gettid);
+    }
+
+    return log_thread_identifier;
 }
 
 /*
@@ -581,6 +978,23 @@ bool is_shell_log_activated(){
     return result;
 }
 
+/*
+ * Locks the log file before a process is forked.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  The lock is held during the fork, so the child process does not copy the log file while another thread is writing on it.
+ */
+void lock_log_file_on_fork() {
+
+    pthread_mutex_lock(&log_file_mutex);
+}
+
 /*
  * Opens a log file.
  *
@@ -596,7 +1010,12 @@ int open_log_file(char* log_file_preffix){
 
     int log_file_name_length;
     int log_directory_length;
-    char* instant_read_formatted;
+    char instant_read_formatted[TIME_STRING_READ_LENGTH + 1];
+    binary_log_header_t header;
+    uint8_t header_buffer[BINARY_LOG_HEADER_SIZE];
+    size_t header_size;
+    struct timespec real_time;
+    FILE* opened_log_file;
 
     if ( log_file_preffix == NULL ) {
         LOG_ERROR("Log file preffix is null.");
@@ -627,21 +1046,134 @@ int open_log_file(char* log_file_preffix){
     strcat(log_file_path, log_file_name);
 
     errno = 0;
-    log_file = fopen(log_file_path, "a");
+    opened_log_file = fopen(log_file_path, "a");
 
-    if ( log_file == NULL || errno != 0 ) {
+    if ( opened_log_file == NULL || errno != 0 ) {
         LOG_ERROR("Could not open log file \"%s\".\n", log_file_path);
         return GENERIC_ERROR;
     }
 
-    instant_read_formatted = get_instant_read_formatted();
-    fprintf(log_file, "[%s] Log started.\n", instant_read_formatted);
-    free(instant_read_formatted);
+    /* Other threads only write on the log file after its header. */
+    if ( log_format == LOG_FORMAT_BINARY ) {
+        log_call_sites_defined = calloc((__stop_anna_log_call_sites - __start_anna_log_call_sites)/8 + 1, sizeof(uint8_t));
+        if ( log_call_sites_defined == NULL ) {
+            fclose(opened_log_file);
+            LOG_ERROR("Could not allocate memory to control the call sites defined on binary log file.");
+            return GENERIC_ERROR;
+        }
+
+        header.version = BINARY_LOG_VERSION;
+        header.monotonic_time = get_monotonic_time();
+        clock_gettime(CLOCK_REALTIME, &real_time);
+        header.real_time = (int64_t)real_time.tv_sec*NANOSECONDS_PER_SECOND + real_time.tv_nsec;
+
+        header_size = encode_binary_log_header(header_buffer, header);
+        fwrite(header_buffer, sizeof(uint8_t), header_size, opened_log_file);
+        fflush(opened_log_file);
+
+        log_binary_latest_timestamp = header.monotonic_time;
+    }
+    else {
+        get_instant_read_formatted_buffer(instant_read_formatted);
+        fprintf(opened_log_file, "[%s] Log started.\n", instant_read_formatted);
+        fflush(opened_log_file);
+    }
+
+    pthread_mutex_lock(&log_file_mutex);
+    log_file = opened_log_file;
+    log_binary_format_active = ( log_format == LOG_FORMAT_BINARY );
+    pthread_mutex_unlock(&log_file_mutex);
+
+    if ( start_log_writer() != SUCCESS ) {
+        LOG_WARNING("Could not start the log writer. Log messages will be written synchronously.");
+    }
 
     LOG_TRACE_POINT;
     return SUCCESS;
 }
 
+/*
+ * Publishes a record of the log ring to be written.
+ *
+ * Parameters
+ *  log_record - The record claimed through "claim_log_record" function.
+ *  position - The position of the record claimed.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  This function must not use log macros, since it is called while a message is being logged.
+ */
+void publish_log_record(log_record_t* log_record, size_t position) {
+
+    atomic_store_explicit(&log_record->sequence, position + 1, memory_order_release);
+}
+
+/*
+ * Stops using the log writer on a child process.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  Threads are not copied to a child process, so it must write its log messages synchronously.
+ *  Records written by a child process would be mixed with the records of its parent on a binary log file, so the child process writes its log messages on standard output.
+ *  The log file lock was held by the parent process during the fork (through "lock_log_file_on_fork" function), so it is released here.
+ */
+void release_log_writer_on_fork() {
+
+    atomic_store(&log_writer_running, false);
+    atomic_store(&log_ring_producers, 0);
+    log_thread_identifier = 0;
+
+    if ( log_binary_format_active == true ) {
+        log_binary_format_active = false;
+        log_file = NULL;
+    }
+
+    pthread_mutex_unlock(&log_file_mutex);
+}
+
+/*
+ * Writes the log records captured until the log writer is finished.
+ *
+ * Parameters
+ *  argument - Not used.
+ *
+ * Returns
+ *  NULL.
+ *
+ * Observations
+ *  This function runs on the log writer thread, so it must not use log macros.
+ */
+void* run_log_writer(void* argument) {
+
+    struct timespec idle_time;
+    bool finishing = false;
+    size_t records_written;
+
+    idle_time.tv_sec = 0;
+    idle_time.tv_nsec = LOG_WRITER_IDLE_TIME*1000000L;
+
+    while ( finishing == false ) {
+        finishing = atomic_load_explicit(&log_writer_finishing, memory_order_acquire);
+
+        pthread_mutex_lock(&log_file_mutex);
+        records_written = write_log_records(log_file);
+        pthread_mutex_unlock(&log_file_mutex);
+
+        if ( records_written == 0 && finishing == false ) {
+            nanosleep(&idle_time, NULL);
+        }
+    }
+
+    return NULL;
+}
+
 /*
  * Defines the directory to store log files.
  *
@@ -684,6 +1216,38 @@ int set_log_directory(const char* new_log_directory){
     return SUCCESS;
 }
 
+/*
+ * Defines the format of the log files.
+ *
+ * Parameters
+ *  new_log_format - The new log format ("LOG_FORMAT_TEXT" or "LOG_FORMAT_BINARY").
+ *
+ * Returns
+ *  SUCCESS - If the log format was defined correctly.
+ *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  The format is used by the next log file opened. Binary log files can be read through "annalog" program.
+ */
+int set_log_format(int new_log_format) {
+    LOG_TRACE_POINT;
+
+    if ( new_log_format != LOG_FORMAT_TEXT && new_log_format != LOG_FORMAT_BINARY ) {
+        LOG_ERROR("Unknown log format: %d.", new_log_format);
+        return GENERIC_ERROR;
+    }
+
+    if ( is_log_open() == true ) {
+        LOG_ERROR("Cannot change log format while log file is open.");
+        return GENERIC_ERROR;
+    }
+
+    log_format = new_log_format;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
 /*
  * Defines the current level of log file.
  *
@@ -701,7 +1265,8 @@ int set_log_directory(const char* new_log_directory){
 int set_log_level(int new_log_level) {
     LOG_TRACE_POINT;
 
-    char command[256];
+    char new_log_level_argument[16];
+    char* arguments[2];
     int script_result;
     int result;
 
@@ -711,14 +1276,16 @@ int set_log_level(int new_log_level) {
         return GENERIC_ERROR;
     }
 
-    sprintf(command, "%s %d", SHELL_SCRIPT_CHANGE_LOG_LEVEL, new_log_level);
+    sprintf(new_log_level_argument, "%d", new_log_level);
+    arguments[0] = new_log_level_argument;
+    arguments[1] = NULL;
 
-    script_result = execute_script(command);
+    script_result = execute_script_with_arguments(SHELL_SCRIPT_CHANGE_LOG_LEVEL, arguments, SCRIPT_DEFAULT_TIMEOUT);
     LOG_TRACE_POINT;
 
     if ( script_result == SUCCESS ) {
         LOG_TRACE_POINT;
-        log_level = new_log_level;
+        _log_level = new_log_level;
         result = SUCCESS;
     }
     else {
@@ -730,6 +1297,58 @@ int set_log_level(int new_log_level) {
     return result;
 }
 
+/*
+ * Starts the log writer.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the log writer was started successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The log writer is a thread which formats and writes the messages captured on the log ring, so the code logging them does not wait for the file writing.
+ */
+int start_log_writer() {
+    LOG_TRACE_POINT;
+
+    size_t counter;
+
+    if ( atomic_load(&log_writer_running) == true ) {
+        LOG_ERROR("Log writer is already running.");
+        return GENERIC_ERROR;
+    }
+
+    for ( counter = 0; counter < LOG_RING_SIZE; counter++ ) {
+        atomic_store_explicit(&log_ring[counter].sequence, counter, memory_order_relaxed);
+    }
+    atomic_store(&log_ring_enqueue_position, 0);
+    atomic_store(&log_ring_dequeue_position, 0);
+    log_dropped_messages_informed = atomic_load(&log_dropped_messages);
+    atomic_store(&log_writer_finishing, false);
+
+    if ( log_writer_fork_handler_registered == false ) {
+        LOG_TRACE_POINT;
+
+        if ( pthread_atfork(lock_log_file_on_fork, unlock_log_file_on_fork, release_log_writer_on_fork) != 0 ) {
+            LOG_ERROR("Could not register the log writer fork handler.");
+            return GENERIC_ERROR;
+        }
+        log_writer_fork_handler_registered = true;
+    }
+
+    if ( pthread_create(&log_writer_thread, NULL, run_log_writer, NULL) != 0 ) {
+        LOG_ERROR("Could not create the log writer thread.");
+        return GENERIC_ERROR;
+    }
+
+    atomic_store_explicit(&log_writer_running, true, memory_order_release);
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
 /*
  * Starts shell script log.
  *
@@ -746,11 +1365,15 @@ int start_shell_script_log(char* log_preffix, int log_level){
 
     int result;
     int script_result;
-    char command[256];
+    char log_level_argument[16];
+    char* arguments[3];
 
-    sprintf(command, "%s \"%s\" %d", SHELL_SCRIPT_START_LOG, log_preffix, log_level);
+    sprintf(log_level_argument, "%d", log_level);
+    arguments[0] = log_preffix;
+    arguments[1] = log_level_argument;
+    arguments[2] = NULL;
 
-    script_result = execute_script(command);
+    script_result = execute_script_with_arguments(SHELL_SCRIPT_START_LOG, arguments, SCRIPT_DEFAULT_TIMEOUT);
     LOG_TRACE_POINT;
 
     if ( script_result == SUCCESS ) {
@@ -766,6 +1389,44 @@ int start_shell_script_log(char* log_preffix, int log_level){
     return result;
 }
 
+/*
+ * Stops the log writer, writing all records captured.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  SUCCESS - If the log writer was stopped or was not running.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Threads which found the log writer running finish capturing their records before the log writer is finished, so no record captured is left on the log ring.
+ */
+int stop_log_writer() {
+    LOG_TRACE_POINT;
+
+    if ( atomic_load(&log_writer_running) == false ) {
+        LOG_TRACE_POINT;
+        return SUCCESS;
+    }
+
+    atomic_store(&log_writer_running, false);
+
+    while ( atomic_load(&log_ring_producers) > 0 ) {
+        sched_yield();
+    }
+
+    atomic_store_explicit(&log_writer_finishing, true, memory_order_release);
+
+    if ( pthread_join(log_writer_thread, NULL) != 0 ) {
+        LOG_ERROR("Error while waiting the log writer to finish.");
+        return GENERIC_ERROR;
+    }
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
 /*
  * Undefines the start log level for shell scripts.
  *
@@ -798,6 +1459,97 @@ int undefine_shell_start_log_level() {
     return result;
 }
 
+/*
+ * Unlocks the log file on the parent process after it is forked.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  Nothing.
+ */
+void unlock_log_file_on_fork() {
+
+    pthread_mutex_unlock(&log_file_mutex);
+}
+
+/*
+ * Writes a record on the binary log file.
+ *
+ * Parameters
+ *  output_file - The binary log file.
+ *  call_site - The call site which registered the record.
+ *  thread_identifier - The identifier of the thread which registered the record.
+ *  timestamp - The monotonic time (in nanoseconds) the record was registered.
+ *  arguments - The arguments of the message encoded.
+ *  arguments_size - Size of "arguments" parameter.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  The call site is defined on file before its first record. Its identifier is its position on the call sites section plus one.
+ *  The log file lock must be held while this function is executed.
+ *  This function is called by the log writer, so it must not use log macros.
+ */
+void write_binary_log_record(FILE* output_file, const log_call_site_t* call_site, int thread_identifier, uint64_t timestamp, const uint8_t* arguments, size_t arguments_size) {
+
+    uint8_t buffer[BINARY_LOG_CALL_SITE_MAXIMUM_SIZE];
+    size_t call_site_index;
+    size_t size;
+
+    call_site_index = call_site - __start_anna_log_call_sites;
+
+    if ( call_site_index < (size_t)(__stop_anna_log_call_sites - __start_anna_log_call_sites) && ( log_call_sites_defined[call_site_index/8] & (1 << (call_site_index%8)) ) == 0 ) {
+        size = encode_binary_log_call_site(buffer, call_site_index + 1, call_site);
+        fwrite(buffer, sizeof(uint8_t), size, output_file);
+        log_call_sites_defined[call_site_index/8] |= (1 << (call_site_index%8));
+    }
+
+    size = encode_binary_log_record_header(buffer, call_site_index + 1, thread_identifier, get_time_difference(timestamp, log_binary_latest_timestamp), arguments_size);
+    fwrite(buffer, sizeof(uint8_t), size, output_file);
+    fwrite(arguments, sizeof(uint8_t), arguments_size, output_file);
+
+    log_binary_latest_timestamp = timestamp;
+}
+
+/*
+ * Writes the message of a log macro call site.
+ *
+ * Parameters
+ *  call_site - The call site of the log macro.
+ *  format - The format of the message.
+ *  ... - The arguments of the message format.
+ *
+ * Returns
+ *  SUCCESS - If the message was written successfully.
+ *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  On text log files the message is formatted and written through "write_log_message" function. On binary log files only the arguments are encoded.
+ *  This function must not use log macros, since it is called while a message is being logged.
+ */
+int write_log_call_site(const log_call_site_t* call_site, const char* format, ...) {
+
+    char message[LOG_MESSAGE_BUFFER_SIZE];
+    va_list arguments;
+    int result;
+
+    va_start(arguments, format);
+
+    if ( log_binary_format_active == true ) {
+        result = capture_binary_log_record(call_site, format, &arguments);
+    }
+    else {
+        vsnprintf(message, LOG_MESSAGE_BUFFER_SIZE, format, arguments);
+        result = write_log_message(call_site->message_type, call_site->function, call_site->line, message);
+    }
+
+    va_end(arguments);
+
+    return result;
+}
+
 /* 
  * Writes a log message.
  *
@@ -814,13 +1566,15 @@ int undefine_shell_start_log_level() {
  * Observations
  *  Use constants defined on header file to fill "message_type" parameter.
  *  Parameter "message" is optional if message is a trace information.
+ *  While a log file is open the message is only captured on the log ring, and the log writer formats and writes it on file. If the log ring is full the message is discarded.
+ *  Otherwise the message is written holding the log file lock, so messages of different threads are not mixed.
  */
 int write_log_message(const int message_type, const char* tag, const int index, const char* message){
     LOG_TRACE_POINT;
 
-    const int formatted_message_length = 1024;
-    char* formatted_message;
+    char formatted_message[LOG_RECORD_FORMAT_BUFFER_SIZE];
     FILE* output_file;
+    int print_result;
 
     /* Check "message_type" parameter. */
     if ( message_type != LOG_MESSAGE_TYPE_TRACE && message_type != LOG_MESSAGE_TYPE_WARNING && message_type != LOG_MESSAGE_TYPE_ERROR ) {
@@ -828,7 +1582,7 @@ int write_log_message(const int message_type, const char* tag, const int index,
         return GENERIC_ERROR;
     }
 
-    if ( message_type >= log_level ) {
+    if ( message_type >= _log_level ) {
 
         /* Check "tag" parameter. */
         if ( tag == NULL ) {
@@ -842,30 +1596,158 @@ int write_log_message(const int message_type, const char* tag, const int index,
             return GENERIC_ERROR;
         }
 
-        formatted_message = malloc(formatted_message_length*sizeof(char));
+        /* On binary log files the message is registered by a call site of this function, one for each message type. */
+        if ( log_binary_format_active == true ) {
+            if ( message_type == LOG_MESSAGE_TYPE_ERROR ) {
+                _LOG_CALL_SITE(LOG_MESSAGE_TYPE_ERROR, LOG_MESSAGE_BINARY_FORMAT);
+                return write_log_call_site(&_log_call_site, LOG_MESSAGE_BINARY_FORMAT, tag, index, ( message != NULL ? message : "" ));
+            }
+            else if ( message_type == LOG_MESSAGE_TYPE_WARNING ) {
+                _LOG_CALL_SITE(LOG_MESSAGE_TYPE_WARNING, LOG_MESSAGE_BINARY_FORMAT);
+                return write_log_call_site(&_log_call_site, LOG_MESSAGE_BINARY_FORMAT, tag, index, ( message != NULL ? message : "" ));
+            }
+            else {
+                _LOG_CALL_SITE(LOG_MESSAGE_TYPE_TRACE, LOG_MESSAGE_BINARY_FORMAT);
+                return write_log_call_site(&_log_call_site, LOG_MESSAGE_BINARY_FORMAT, tag, index, ( message != NULL ? message : "" ));
+            }
+        }
+
+        atomic_fetch_add(&log_ring_producers, 1);
+        if ( atomic_load(&log_writer_running) == true ) {
+            if ( enqueue_log_record(message_type, tag, index, message) == false ) {
+                atomic_fetch_add_explicit(&log_dropped_messages, 1, memory_order_relaxed);
+            }
+            atomic_fetch_sub(&log_ring_producers, 1);
+            return SUCCESS;
+        }
+        atomic_fetch_sub(&log_ring_producers, 1);
 
-        format_log_message(formatted_message, formatted_message_length, message_type, tag, index, message);
+        format_log_message(formatted_message, LOG_RECORD_FORMAT_BUFFER_SIZE, message_type, tag, index, message);
         LOG_TRACE_POINT;
 
-        if ( is_log_open() == true ) {
-            LOG_TRACE_POINT;
+        /* No log macro can be used while the log file is locked. */
+        pthread_mutex_lock(&log_file_mutex);
+
+        if ( log_file != NULL ) {
             output_file = log_file;
         }
         else {
-            LOG_TRACE_POINT;
             output_file = stdout;
         }
 
-        if ( fprintf(output_file, "%s\n", formatted_message) < 0 ) {
+        print_result = fprintf(output_file, "%s\n", formatted_message);
+        fflush(output_file);
+
+        pthread_mutex_unlock(&log_file_mutex);
+
+        if ( print_result < 0 ) {
             LOG_ERROR("Error printing log message.\n");
             return GENERIC_ERROR;
         }
+    }
 
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Writes the log records available on the log ring.
+ *
+ * Parameters
+ *  output_file - The file to write the log records.
+ *
+ * Returns
+ *  The number of log records written.
+ *
+ * Observations
+ *  Only the log writer removes records from the log ring. The number of messages discarded since the last call is also written on file.
+ *  The log file lock must be held while this function is executed.
+ *  This function runs on the log writer thread, so it must not use log macros.
+ */
+size_t write_log_records(FILE* output_file) {
+
+    char buffer[LOG_RECORD_FORMAT_BUFFER_SIZE];
+    log_record_t* log_record;
+    log_record_t dropped_messages_record;
+    size_t records_written = 0;
+    size_t dequeue_position;
+    size_t sequence;
+    uint64_t dropped_messages;
+    uint8_t arguments[BINARY_LOG_VARINT_MAXIMUM_SIZE];
+    size_t arguments_size;
+    int length;
+
+    dequeue_position = atomic_load_explicit(&log_ring_dequeue_position, memory_order_relaxed);
+    while ( true ) {
+        log_record = &log_ring[dequeue_position & (LOG_RING_SIZE - 1)];
+        sequence = atomic_load_explicit(&log_record->sequence, memory_order_acquire);
+        if ( sequence != dequeue_position + 1 ) {
+            break;
+        }
+
+        if ( log_record->call_site != NULL ) {
+            write_binary_log_record(output_file, log_record->call_site, log_record->thread_identifier, log_record->timestamp, (uint8_t*)log_record->message, log_record->arguments_size);
+        }
+        else {
+            length = format_log_record(buffer, LOG_RECORD_FORMAT_BUFFER_SIZE, log_record);
+            fwrite(buffer, sizeof(char), length, output_file);
+        }
+
+        atomic_store_explicit(&log_record->sequence, dequeue_position + LOG_RING_SIZE, memory_order_release);
+        dequeue_position++;
+        atomic_store_explicit(&log_ring_dequeue_position, dequeue_position, memory_order_release);
+        records_written++;
+    }
+
+    dropped_messages = atomic_load_explicit(&log_dropped_messages, memory_order_relaxed);
+    if ( dropped_messages != log_dropped_messages_informed ) {
+        if ( log_binary_format_active == true ) {
+            _LOG_CALL_SITE(LOG_MESSAGE_TYPE_WARNING, LOG_DROPPED_MESSAGES_FORMAT);
+            arguments_size = encode_binary_log_varint(arguments, dropped_messages - log_dropped_messages_informed);
+            write_binary_log_record(output_file, &_log_call_site, get_log_thread_identifier(), get_monotonic_time(), arguments, arguments_size);
+        }
+        else {
+            dropped_messages_record.message_type = LOG_MESSAGE_TYPE_WARNING;
+            dropped_messages_record.tag = __func__;
+            dropped_messages_record.index = __LINE__;
+            dropped_messages_record.thread_identifier = get_log_thread_identifier();
+            clock_gettime(CLOCK_REALTIME, &dropped_messages_record.instant);
+            snprintf(dropped_messages_record.message, LOG_MESSAGE_BUFFER_SIZE, LOG_DROPPED_MESSAGES_FORMAT, (unsigned long long)(dropped_messages - log_dropped_messages_informed));
+
+            length = format_log_record(buffer, LOG_RECORD_FORMAT_BUFFER_SIZE, &dropped_messages_record);
+            fwrite(buffer, sizeof(char), length, output_file);
+        }
+
+        log_dropped_messages_informed = dropped_messages;
+        records_written++;
+    }
+
+    if ( records_written > 0 ) {
         fflush(output_file);
+    }
 
-        free(formatted_message);
+    return records_written;
+}
+
+/*
+ * Writes the trace point of a log macro call site.
+ *
+ * Parameters
+ *  call_site - The call site of the log macro.
+ *
+ * Returns
+ *  SUCCESS - If the trace point was written successfully.
+ *  GENERIC ERROR - Otherwise.
+ *
+ * Observations
+ *  On binary log files a trace point is registered without arguments.
+ *  This function must not use log macros, since it is called while a message is being logged.
+ */
+int write_log_trace_point(const log_call_site_t* call_site) {
+
+    if ( log_binary_format_active == true ) {
+        return capture_binary_log_record(call_site, NULL, NULL);
     }
 
-    LOG_TRACE_POINT;
-    return SUCCESS;
+    return write_log_message(call_site->message_type, call_site->function, call_site->line, "");
 }
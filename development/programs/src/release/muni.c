@@ -3,6 +3,9 @@
  *
  * Arguments:
  *  -l - Inform the log level which the program must be executed with. Current valid values are "TRACE", "WARNING" and "ERROR".
+ *  -m - Inform the format of the program log file. Current valid values are "TEXT" (default) and "BINARY". Binary log files are read through "annalog" program.
+ *  -t - Inform the transport used to communicate with remote devices. Current valid values are "RFCOMM" (default), "UNIX" and "TCP".
+ *  -a - Inform the address which the transport listens for connections. A port for "TCP" (default 27027) or a socket file path for "UNIX" (default "muni.socket" on output directory). Ignored by "RFCOMM".
  *
  * Version:
  *  0.1
@@ -15,18 +18,25 @@
  * Includes.
  */
 
+#include <signal.h>
 #include <stdlib.h>
 
 #include "audio.h"
+#include "audio/catalog.h"
+#include "audio/record_index.h"
 #include "bluetooth/service.h"
 #include "bluetooth/communication.h"
 #include "bluetooth/connection.h"
 #include "bluetooth/package/codes.h"
 #include "bluetooth/package/package.h"
-#include "instant.h"
+#include "bluetooth/transport/transport.h"
+#include "error_messages.h"
 #include "log.h"
 #include "parameters.h"
 #include "return_codes.h"
+#include "script.h"
+#include "timestamp_board.h"
+#include "timing.h"
 
 
 /*
@@ -36,6 +46,18 @@
 /* Maximum errors tolerated by the program while receiving packages from a remote device. */
 #define MAX_RECEIVE_PACKAGE_ERRORS_TOLERATED 5
 
+/* Name informed to the remote device when the audio being recorded is streamed. */
+#define AUDIO_STREAM_NAME "audio_stream.mp3"
+
+/* Error code informed when the transfer requested to be resumed is not registered. */
+#define TRANSFER_NOT_FOUND_ERROR_CODE 23
+
+/* Error code informed when the file of the transfer requested to be resumed has changed. */
+#define TRANSFER_CHANGED_ERROR_CODE 24
+
+/* Error code informed when the audio record requested is not on the audio catalog. */
+#define AUDIO_RECORD_NOT_FOUND_ERROR_CODE 25
+
 /* Preffix to identify the program log file. */
 #define PROGRAM_LOG_FILE_PREFFIX "muni_program"
 
@@ -52,6 +74,15 @@ int check_argument(char*, char*);
 /* Checks the program argument "log". */
 int check_argument_log(char*);
 
+/* Checks the program argument "log mode". */
+int check_argument_log_mode(char*);
+
+/* Checks the program argument "transport". */
+int check_argument_transport(char*);
+
+/* Checks the program argument "transport address". */
+int check_argument_transport_address(char*);
+
 /* Checks the program arguments. */
 int check_arguments(int, char**);
 
@@ -61,15 +92,36 @@ int check_command_received(int, package_t);
 /* Executes the device disconnection processes. */
 int command_disconnect(int);
 
+/* Resumes a file transfer interrupted by a disconnection. */
+int command_resume_transfer(int, package_t);
+
+/* Defines the transmission window size requested by the remote device. */
+int command_set_transmission_window_size(int, package_t);
+
 /* Starts audio recording. */
 int command_start_audio_record(int);
 
 /* Stops audio recording. */
 int command_stop_audio_record(int);
 
+/* Streams the audio being recorded. */
+int command_stream_audio_record(int);
+
+/* Transmits a page of the audio catalog. */
+int command_transmit_audio_catalog(int, package_t);
+
+/* Transmits an audio record of the audio catalog. */
+int command_transmit_audio_record(int, package_t);
+
+/* Transmits the segments closed of the latest audio record. */
+int command_transmit_audio_record_segments(int);
+
 /* Transmits the latest audio recorded. */
 int command_transmit_latest_audio_record(int);
 
+/* Transmits the bytes of the latest audio record the remote device does not have. */
+int command_transmit_latest_audio_record_tail(int, package_t);
+
 /* Finish both program and script logs. */
 int finish_logs();
 
@@ -115,6 +167,9 @@ int check_argument(char* argument, char* value) {
 
     int result;
     int check_argument_log_result;
+    int check_argument_log_mode_result;
+    int check_argument_transport_result;
+    int check_argument_transport_address_result;
     
     if ( strcmp(argument, PARAMETER_LOG) == 0 ) {
         LOG_TRACE_POINT;
@@ -131,6 +186,51 @@ int check_argument(char* argument, char* value) {
             result = GENERIC_ERROR;
         }
     }
+    else if ( strcmp(argument, PARAMETER_LOG_MODE) == 0 ) {
+        LOG_TRACE_POINT;
+
+        check_argument_log_mode_result = check_argument_log_mode(value);
+        LOG_TRACE_POINT;
+
+        if ( check_argument_log_mode_result == SUCCESS ) {
+            LOG_TRACE_POINT;
+            result = SUCCESS;
+        }
+        else {
+            LOG_TRACE_POINT;
+            result = GENERIC_ERROR;
+        }
+    }
+    else if ( strcmp(argument, PARAMETER_TRANSPORT) == 0 ) {
+        LOG_TRACE_POINT;
+
+        check_argument_transport_result = check_argument_transport(value);
+        LOG_TRACE_POINT;
+
+        if ( check_argument_transport_result == SUCCESS ) {
+            LOG_TRACE_POINT;
+            result = SUCCESS;
+        }
+        else {
+            LOG_TRACE_POINT;
+            result = GENERIC_ERROR;
+        }
+    }
+    else if ( strcmp(argument, PARAMETER_TRANSPORT_ADDRESS) == 0 ) {
+        LOG_TRACE_POINT;
+
+        check_argument_transport_address_result = check_argument_transport_address(value);
+        LOG_TRACE_POINT;
+
+        if ( check_argument_transport_address_result == SUCCESS ) {
+            LOG_TRACE_POINT;
+            result = SUCCESS;
+        }
+        else {
+            LOG_TRACE_POINT;
+            result = GENERIC_ERROR;
+        }
+    }
     else {
         LOG_ERROR("Unknown argument \"%s\".", argument);
         result = GENERIC_ERROR;
@@ -223,6 +323,114 @@ int check_argument_log(char* value) {
     return result;
 }
 
+/*
+ * Checks the program argument for log mode.
+ *
+ * Parameters
+ *  value - Value informed for log mode argument.
+ *
+ * Returns
+ *  SUCCESS - If log mode argument was checked successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int check_argument_log_mode(char* value) {
+    LOG_TRACE_POINT;
+
+    int result;
+
+    if ( value == NULL ) {
+        LOG_ERROR("No value defined to \"log mode\" argument.");
+        result = GENERIC_ERROR;
+    }
+    else {
+        LOG_TRACE("Value for argument log mode: \"%s\".", value);
+
+        if ( strcmp(value, PARAMETER_LOG_MODE_VALUE_TEXT) == 0 ) {
+            LOG_TRACE_POINT;
+
+            result = set_log_format(LOG_FORMAT_TEXT);
+        }
+        else if ( strcmp(value, PARAMETER_LOG_MODE_VALUE_BINARY) == 0 ) {
+            LOG_TRACE_POINT;
+
+            result = set_log_format(LOG_FORMAT_BINARY);
+        }
+        else {
+            LOG_ERROR("Unknown value for parameter \"log mode\".");
+            result = GENERIC_ERROR;
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Checks the program argument for transport.
+ *
+ * Parameters
+ *  value - Value informed for transport argument.
+ *
+ * Returns
+ *  SUCCESS - If transport argument was checked successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int check_argument_transport(char* value) {
+    LOG_TRACE_POINT;
+
+    int result;
+
+    if ( value == NULL ) {
+        LOG_ERROR("No value defined to \"transport\" argument.");
+        result = GENERIC_ERROR;
+    }
+    else {
+        LOG_TRACE("Value for argument transport: \"%s\".", value);
+
+        if ( strcmp(value, PARAMETER_TRANSPORT_VALUE_RFCOMM) == 0 || strcmp(value, PARAMETER_TRANSPORT_VALUE_UNIX) == 0 || strcmp(value, PARAMETER_TRANSPORT_VALUE_TCP) == 0 ) {
+            LOG_TRACE_POINT;
+
+            result = set_transport(value);
+        }
+        else {
+            LOG_ERROR("Unknown value for parameter \"transport\".");
+            result = GENERIC_ERROR;
+        }
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Checks the program argument for transport address.
+ *
+ * Parameters
+ *  value - Value informed for transport address argument.
+ *
+ * Returns
+ *  SUCCESS - If transport address argument was checked successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+int check_argument_transport_address(char* value) {
+    LOG_TRACE_POINT;
+
+    int result;
+
+    if ( value == NULL ) {
+        LOG_ERROR("No value defined to \"transport address\" argument.");
+        result = GENERIC_ERROR;
+    }
+    else {
+        LOG_TRACE("Value for argument transport address: \"%s\".", value);
+
+        result = set_transport_address(value);
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
 /*
  * Checks the program arguments.
  *
@@ -250,6 +458,7 @@ int check_arguments(int argc, char** argv) {
     }
     else {
         LOG_TRACE_POINT;
+        result = SUCCESS;
 
         for (counter = 1; counter < argc; counter++ ) {
             LOG_TRACE_POINT;
@@ -321,12 +530,43 @@ int check_command_received(int btc_socket_fd, package_t package) {
     int result;
     int command_execution_result;
 
+    publish_event_timestamp(TIMESTAMP_EVENT_COMMAND_RECEIVED);
+
     switch (package.type_code) {
         case CHECK_CONNECTION_CODE:
             LOG_TRACE("Connection checked by device.");
             result = SUCCESS;
             break;
 
+        case WINDOW_SIZE_CODE:
+            LOG_TRACE_POINT;
+
+            command_execution_result = command_set_transmission_window_size(btc_socket_fd, package);
+            LOG_TRACE_POINT;
+
+            switch ( command_execution_result ) {
+
+                case SUCCESS:
+                    LOG_TRACE_POINT;
+
+                    result = SUCCESS;
+                    break;
+
+                case DEVICE_DISCONNECTED:
+                    LOG_TRACE_POINT;
+
+                    result = DEVICE_DISCONNECTED;
+                    break;
+
+                default:
+                    LOG_TRACE_POINT;
+
+                    result = GENERIC_ERROR;
+                    break;
+            }
+            break;
+
+        case AUDIO_CATALOG_PAGE_CODE:
         case CONFIRMATION_CODE:
         case COMMAND_RESULT_CODE:
         case ERROR_CODE:
@@ -349,6 +589,35 @@ int check_command_received(int btc_socket_fd, package_t package) {
             result = DEVICE_DISCONNECTED;
             break;
 
+        case REQUEST_AUDIO_CATALOG_CODE:
+            LOG_TRACE_POINT;
+
+            command_execution_result = command_transmit_audio_catalog(btc_socket_fd, package);
+            LOG_TRACE_POINT;
+
+            switch ( command_execution_result ) {
+
+                case SUCCESS:
+                    LOG_TRACE_POINT;
+
+                    result = SUCCESS;
+                    break;
+
+                case DEVICE_DISCONNECTED:
+                    LOG_TRACE_POINT;
+
+                    result = DEVICE_DISCONNECTED;
+                    break;
+
+                default:
+                    LOG_TRACE_POINT;
+
+                    result = GENERIC_ERROR;
+                    break;
+            }
+
+            break;
+
         case REQUEST_AUDIO_FILE_CODE:
             LOG_TRACE_POINT;
 
@@ -378,6 +647,122 @@ int check_command_received(int btc_socket_fd, package_t package) {
 
             break;
 
+        case REQUEST_AUDIO_FILE_TAIL_CODE:
+            LOG_TRACE_POINT;
+
+            command_execution_result = command_transmit_latest_audio_record_tail(btc_socket_fd, package);
+            LOG_TRACE_POINT;
+
+            switch ( command_execution_result ) {
+
+                case SUCCESS:
+                    LOG_TRACE_POINT;
+
+                    result = SUCCESS;
+                    break;
+
+                case DEVICE_DISCONNECTED:
+                    LOG_TRACE_POINT;
+
+                    result = DEVICE_DISCONNECTED;
+                    break;
+
+                default:
+                    LOG_TRACE_POINT;
+
+                    result = GENERIC_ERROR;
+                    break;
+            }
+
+            break;
+
+        case REQUEST_AUDIO_RECORD_CODE:
+            LOG_TRACE_POINT;
+
+            command_execution_result = command_transmit_audio_record(btc_socket_fd, package);
+            LOG_TRACE_POINT;
+
+            switch ( command_execution_result ) {
+
+                case SUCCESS:
+                    LOG_TRACE_POINT;
+
+                    result = SUCCESS;
+                    break;
+
+                case DEVICE_DISCONNECTED:
+                    LOG_TRACE_POINT;
+
+                    result = DEVICE_DISCONNECTED;
+                    break;
+
+                default:
+                    LOG_TRACE_POINT;
+
+                    result = GENERIC_ERROR;
+                    break;
+            }
+
+            break;
+
+        case REQUEST_AUDIO_SEGMENTS_CODE:
+            LOG_TRACE_POINT;
+
+            command_execution_result = command_transmit_audio_record_segments(btc_socket_fd);
+            LOG_TRACE_POINT;
+
+            switch ( command_execution_result ) {
+
+                case SUCCESS:
+                    LOG_TRACE_POINT;
+
+                    result = SUCCESS;
+                    break;
+
+                case DEVICE_DISCONNECTED:
+                    LOG_TRACE_POINT;
+
+                    result = DEVICE_DISCONNECTED;
+                    break;
+
+                default:
+                    LOG_TRACE_POINT;
+
+                    result = GENERIC_ERROR;
+                    break;
+            }
+
+            break;
+
+        case RESUME_TRANSFER_CODE:
+            LOG_TRACE_POINT;
+
+            command_execution_result = command_resume_transfer(btc_socket_fd, package);
+            LOG_TRACE_POINT;
+
+            switch ( command_execution_result ) {
+
+                case SUCCESS:
+                    LOG_TRACE_POINT;
+
+                    result = SUCCESS;
+                    break;
+
+                case DEVICE_DISCONNECTED:
+                    LOG_TRACE_POINT;
+
+                    result = DEVICE_DISCONNECTED;
+                    break;
+
+                default:
+                    LOG_TRACE_POINT;
+
+                    result = GENERIC_ERROR;
+                    break;
+            }
+
+            break;
+
         case START_RECORD_CODE:
             LOG_TRACE_POINT;
 
@@ -435,43 +820,282 @@ int check_command_received(int btc_socket_fd, package_t package) {
 
             break;
 
-        default:
-            LOG_ERROR("Unrecognized package type: 0x%08x.", package.type_code);
-            result = GENERIC_ERROR;
-            break;
+        case START_STREAM_CODE:
+            LOG_TRACE_POINT;
+
+            /* The command which interrupted the stream is checked by the stream command itself. */
+            result = command_stream_audio_record(btc_socket_fd);
+            LOG_TRACE_POINT;
+            break;
+
+        case STOP_STREAM_CODE:
+            LOG_TRACE("No audio stream to be stopped.");
+            result = SUCCESS;
+            break;
+
+        default:
+            LOG_ERROR("Unrecognized package type: 0x%08x.", package.type_code);
+            result = GENERIC_ERROR;
+            break;
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Executes the device disconnection processes.
+ *
+ * Parameters
+ *  btc_socket_fd - The bluetooth communication's socket file descriptor to the remote device.
+ *
+ * Return
+ *  SUCCESS - If remote device was disconnected successfully.
+ *  GENERIC_ERROR - Otherwise.
+ */
+
+int command_disconnect(int btc_socket_fd) {
+    LOG_TRACE_POINT;
+
+    int result;
+    int close_socket_result;
+
+    close_socket_result = close_socket(btc_socket_fd);
+    LOG_TRACE_POINT;
+
+    if ( close_socket_result != SUCCESS ) {
+        LOG_ERROR("Error while disconnecting remote device.");
+        return GENERIC_ERROR;
+    }
+    else {
+        LOG_TRACE_POINT;
+        result = SUCCESS;
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Resumes a file transfer interrupted by a disconnection.
+ *
+ * Parameters
+ *  btc_socket_fd - The bluetooth communication's socket file descriptor to the remote device.
+ *  package - The "resume transfer" package received, with the transfer identifier and the number of bytes the remote device has.
+ *
+ * Returns
+ *  SUCCESS - If the transfer was resumed successfully or the remote device was informed that it cannot be resumed.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  If the transfer is not registered or its file has changed, an error package is sent, so the remote device knows it must request the file again.
+ */
+int command_resume_transfer(int btc_socket_fd, package_t package) {
+    LOG_TRACE("Transfer ID: 0x%08x, file offset: %u.", package.content.resume_transfer_content->transfer_id, package.content.resume_transfer_content->file_offset);
+
+    int resume_result;
+    int result;
+
+    resume_result = resume_transfer(btc_socket_fd, package.content.resume_transfer_content->transfer_id, package.content.resume_transfer_content->file_offset);
+    LOG_TRACE_POINT;
+
+    switch ( resume_result ) {
+
+        case SUCCESS:
+            LOG_TRACE_POINT;
+            result = SUCCESS;
+            break;
+
+        case DEVICE_DISCONNECTED:
+            LOG_TRACE_POINT;
+            result = DEVICE_DISCONNECTED;
+            break;
+
+        case TRANSFER_NOT_FOUND:
+            LOG_TRACE_POINT;
+            result = transmit_error(btc_socket_fd, TRANSFER_NOT_FOUND_ERROR_CODE, ERROR_MESSAGE_023);
+            break;
+
+        case TRANSFER_CHANGED:
+            LOG_TRACE_POINT;
+            result = transmit_error(btc_socket_fd, TRANSFER_CHANGED_ERROR_CODE, ERROR_MESSAGE_024);
+            break;
+
+        default:
+            LOG_ERROR("Error while resuming transfer.");
+            result = GENERIC_ERROR;
+            break;
+    }
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Defines the transmission window size requested by the remote device.
+ *
+ * Parameters
+ *  socket_fd - The bluetooth connection socket file descriptor to inform the transmission window size accepted.
+ *  package - The "window size" package received.
+ *
+ * Returns
+ *  SUCCESS - If the transmission window size was defined and informed successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The window size requested is limited to the maximum supported and the value accepted is sent back to the remote device on a "window size" package.
+ */
+int command_set_transmission_window_size(int socket_fd, package_t package) {
+    LOG_TRACE("Window size requested: %u.", package.content.window_size_content->window_size);
+
+    int result;
+    int send_package_result;
+    uint32_t window_size;
+    package_t window_size_package;
+
+    window_size = set_transmission_window_size(package.content.window_size_content->window_size);
+    LOG_TRACE_POINT;
+
+    window_size_package = create_window_size_package(window_size);
+    LOG_TRACE_POINT;
+
+    send_package_result = send_package(socket_fd, window_size_package);
+    LOG_TRACE_POINT;
+
+    switch ( send_package_result ) {
+
+        case SUCCESS:
+            LOG_TRACE_POINT;
+
+            result = SUCCESS;
+            break;
+
+        case DEVICE_DISCONNECTED:
+            LOG_TRACE_POINT;
+
+            result = DEVICE_DISCONNECTED;
+            break;
+
+        default:
+            LOG_ERROR("Error while sending the transmission window size accepted.");
+            result = GENERIC_ERROR;
+            break;
+    }
+
+    delete_package(window_size_package);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Starts audio recording.
+ *
+ * Parameters
+ *  socket_fd - The bluetooth connection socket file descriptor to send the result of the "start audio record" command.
+ *
+ * Result
+ *  SUCCESS - If audio recording started successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The command result is always sent. If the start instant is not available, it is sent without an execution delay.
+ */
+int command_start_audio_record(int socket_fd){
+    LOG_TRACE_POINT;
+
+    int result;
+    int start_audio_record_result;
+    struct timeval execution_delay;
+    event_timestamp_t start_audio_record_timestamp;
+    int64_t command_execution_time;
+
+    start_audio_record_result = start_audio_record();
+    LOG_TRACE_POINT;
+
+    /* The instant of a previous audio record must not be informed as the start of one which has failed. */
+    if ( start_audio_record_result != SUCCESS ) {
+        LOG_TRACE_POINT;
+        clear_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED);
+    }
+
+    if ( get_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED, &start_audio_record_timestamp) == SUCCESS ) {
+        LOG_TRACE_POINT;
+        execution_delay = convert_nanoseconds_to_timeval(get_elapsed_time(start_audio_record_timestamp.monotonic_time));
+    }
+    else {
+        if ( start_audio_record_result == SUCCESS ) {
+            LOG_ERROR("Error while retrieving start record instant.");
+        }
+        timerclear(&execution_delay);
+    }
+    LOG_TRACE_POINT;
+
+    if ( get_events_interval(TIMESTAMP_EVENT_COMMAND_RECEIVED, TIMESTAMP_EVENT_AUDIO_RECORD_STARTED, &command_execution_time) == SUCCESS ) {
+        LOG_TRACE("Time from command received to audio record started: %lld us.", (long long)(command_execution_time/NANOSECONDS_PER_MICROSECOND));
     }
 
+    result = transmit_command_result(socket_fd, start_audio_record_result, execution_delay, get_audio_record_pre_roll());
+
     LOG_TRACE_POINT;
     return result;
 }
 
 /*
- * Executes the device disconnection processes.
+ * Stops audio recording.
  *
  * Parameters
- *  btc_socket_fd - The bluetooth communication's socket file descriptor to the remote device.
+ *  socket_fd - The bluetooth connection socket file descriptor to send the result of the "stop audio record" command.
  *
- * Return
- *  SUCCESS - If remote device was disconnected successfully.
+ * Result
+ *  SUCCESS - If audio record stopped successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
  *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The command result is always sent. If the stop instant is not available, it is sent without an execution delay.
  */
-
-int command_disconnect(int btc_socket_fd) {
+int command_stop_audio_record(int socket_fd){
     LOG_TRACE_POINT;
 
     int result;
-    int close_socket_result;
+    int stop_audio_record_result;
+    struct timeval execution_delay;
+    event_timestamp_t stop_audio_record_timestamp;
+    struct timeval pre_roll;
 
-    close_socket_result = close_socket(btc_socket_fd);
+    stop_audio_record_result = stop_audio_record();
     LOG_TRACE_POINT;
 
-    if ( close_socket_result != SUCCESS ) {
-        LOG_ERROR("Error while disconnecting remote device.");
-        return GENERIC_ERROR;
+    /* The instant of a previous audio record must not be informed as the stop of one which has failed. */
+    if ( stop_audio_record_result != SUCCESS ) {
+        LOG_TRACE_POINT;
+        clear_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STOPPED);
     }
-    else {
+
+    if ( get_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STOPPED, &stop_audio_record_timestamp) == SUCCESS ) {
         LOG_TRACE_POINT;
-        result = SUCCESS;
+        execution_delay = convert_nanoseconds_to_timeval(get_elapsed_time(stop_audio_record_timestamp.monotonic_time));
+    }
+    else {
+        if ( stop_audio_record_result == SUCCESS ) {
+            LOG_ERROR("Error while retrieving stop record instant.");
+        }
+        timerclear(&execution_delay);
+    }
+    LOG_TRACE_POINT;
+
+    timerclear(&pre_roll);
+
+    result = transmit_command_result(socket_fd, stop_audio_record_result, execution_delay, pre_roll);
+    LOG_TRACE_POINT;
+
+    /* The audio record is cataloged after the command result is sent, so reading it does not delay the result. */
+    if ( stop_audio_record_result == SUCCESS && catalog_latest_audio_record() != SUCCESS ) {
+        LOG_WARNING("Could not catalog the audio record.");
     }
 
     LOG_TRACE_POINT;
@@ -479,63 +1103,134 @@ int command_disconnect(int btc_socket_fd) {
 }
 
 /*
- * Starts audio recording.
+ * Streams the audio being recorded.
  *
  * Parameters
- *  socket_fd - The bluetooth connection socket file descriptor to send the result of the "start audio record" command.
+ *  btc_socket_fd - The bluetooth communication's socket file descriptor to the remote device.
  *
- * Result
- *  SUCCESS - If audio recording started successfully.
+ * Returns
+ *  SUCCESS - If the audio was streamed until the remote device requested it to stop or the audio record finished.
  *  DEVICE_DISCONNECTED - If the device was disconnected.
- *  GENERIC_ERROR - Otherwise.
+ *  GENERIC_ERROR - If there was an error.
+ *  Any code returned by "check_command_received" - If the stream was interrupted by another command.
+ *
+ * Observations
+ *  A command result is sent before the stream, informing if it could be started. The stream is sent as a file of unknown size and lasts until the remote device sends a "stop stream" package, sends another command or the audio record finishes.
  */
-int command_start_audio_record(int socket_fd){
+int command_stream_audio_record(int btc_socket_fd) {
     LOG_TRACE_POINT;
 
     int result;
-    int start_audio_record_result;
-    int send_package_result;
+    int start_audio_stream_result;
+    int send_stream_result;
     struct timeval execution_delay;
-    char* start_audio_instant_file_path;
-    instant_t start_audio_record_instant;
-    int retrieve_instant_from_file_result;
-    instant_t current_instant;
-    instant_t difference;
-    int get_instant_difference_result;
-    package_t command_result_package;
+    struct timeval pre_roll;
+    package_t package;
 
-    start_audio_record_result = start_audio_record();
+    start_audio_stream_result = start_audio_stream();
     LOG_TRACE_POINT;
 
-    start_audio_instant_file_path = get_start_audio_record_instant_file_path();
+    timerclear(&execution_delay);
+    timerclear(&pre_roll);
+    result = transmit_command_result(btc_socket_fd, start_audio_stream_result, execution_delay, pre_roll);
     LOG_TRACE_POINT;
 
-    retrieve_instant_from_file_result  = retrieve_instant_from_file(&start_audio_record_instant, start_audio_instant_file_path);
-    LOG_TRACE_POINT;
+    if ( result != SUCCESS || start_audio_stream_result != SUCCESS ) {
+        LOG_TRACE_POINT;
 
-    if ( retrieve_instant_from_file_result != SUCCESS ) {
-        LOG_ERROR("Error while retrieving start record instant.");
-        return GENERIC_ERROR;
+        if ( start_audio_stream_result == SUCCESS ) {
+            stop_audio_stream();
+        }
+        return ( result == DEVICE_DISCONNECTED ? DEVICE_DISCONNECTED : GENERIC_ERROR );
     }
 
-    current_instant = get_instant();
+    send_stream_result = send_stream(btc_socket_fd, AUDIO_STREAM_NAME, read_audio_stream, &package);
     LOG_TRACE_POINT;
 
-    get_instant_difference_result = get_instant_difference(&difference, current_instant, start_audio_record_instant);
+    stop_audio_stream();
     LOG_TRACE_POINT;
 
-    if ( get_instant_difference_result != SUCCESS ) {
-        LOG_ERROR("Error while calculating difference between the start audio record time and current instant.");
-        return GENERIC_ERROR;
+    switch ( send_stream_result ) {
+
+        case SUCCESS:
+            LOG_TRACE_POINT;
+            result = SUCCESS;
+            break;
+
+        case STREAM_INTERRUPTED:
+            LOG_TRACE_POINT;
+
+            result = check_command_received(btc_socket_fd, package);
+            LOG_TRACE_POINT;
+
+            delete_package(package);
+            break;
+
+        case DEVICE_DISCONNECTED:
+            LOG_TRACE_POINT;
+            result = DEVICE_DISCONNECTED;
+            break;
+
+        default:
+            LOG_ERROR("Error while streaming the audio being recorded.");
+            result = GENERIC_ERROR;
+            break;
     }
 
-    execution_delay = convert_instant_to_timeval(difference);
     LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Transmits a page of the audio catalog.
+ *
+ * Parameters
+ *  btc_socket_fd - The bluetooth communication's socket file descriptor to the remote device.
+ *  package - The package received, which informs the first audio record and the number of audio records requested.
+ *
+ * Returns
+ *  SUCCESS - If the audio catalog page was transmitted successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The number of audio records is limited to the maximum of a page. The page informs the ID to request the next one, so the remote device can browse the catalog without receiving it all at once.
+ *  The catalog is kept updated by the audio catalog updater, so the page is read from memory without reading the audio directory. Audio records whose checksums are still being calculated are flagged.
+ */
+int command_transmit_audio_catalog(int btc_socket_fd, package_t package) {
+    LOG_TRACE("First record ID: %u, records count: %u.", package.content.audio_catalog_request_content->first_record_id, package.content.audio_catalog_request_content->records_count);
+
+    int result;
+    int send_package_result;
+    size_t maximum_records;
+    size_t records_count;
+    uint32_t next_record_id;
+    audio_catalog_record_t* audio_catalog_records;
+    package_t audio_catalog_page_package;
+
+    maximum_records = package.content.audio_catalog_request_content->records_count;
+    if ( maximum_records == 0 || maximum_records > AUDIO_CATALOG_PAGE_MAXIMUM_RECORDS ) {
+        maximum_records = AUDIO_CATALOG_PAGE_MAXIMUM_RECORDS;
+    }
 
-    command_result_package = create_command_result_package(start_audio_record_result, execution_delay);
+    audio_catalog_records = (audio_catalog_record_t*)malloc(maximum_records*sizeof(audio_catalog_record_t));
+    if ( audio_catalog_records == NULL ) {
+        LOG_ERROR("Could not allocate memory to list the audio catalog.");
+        return GENERIC_ERROR;
+    }
+
+    if ( list_audio_catalog_records(package.content.audio_catalog_request_content->first_record_id, audio_catalog_records, maximum_records, &records_count, &next_record_id) != SUCCESS ) {
+        LOG_ERROR("Could not list the audio catalog.");
+        free(audio_catalog_records);
+        return GENERIC_ERROR;
+    }
+
+    audio_catalog_page_package = create_audio_catalog_page_package(next_record_id, (uint32_t)records_count, audio_catalog_records);
     LOG_TRACE_POINT;
 
-    send_package_result = send_package(socket_fd, command_result_package);
+    free(audio_catalog_records);
+
+    send_package_result = send_package(btc_socket_fd, audio_catalog_page_package);
     LOG_TRACE_POINT;
 
     switch ( send_package_result ) {
@@ -551,76 +1246,65 @@ int command_start_audio_record(int socket_fd){
             break;
 
         default:
-            LOG_TRACE_POINT;
+            LOG_ERROR("Error while sending the audio catalog page.");
             result = GENERIC_ERROR;
             break;
     }
 
+    delete_package(audio_catalog_page_package);
+
     LOG_TRACE_POINT;
     return result;
 }
 
 /*
- * Stops audio recording.
+ * Transmits an audio record of the audio catalog.
  *
  * Parameters
- *  socket_fd - The bluetooth connection socket file descriptor to send the result of the "stop audio record" command.
+ *  btc_socket_fd - The bluetooth communication's socket file descriptor to the remote device.
+ *  package - The package received, which informs the ID of the audio record requested.
  *
- * Result
- *  SUCCESS - If audio record stopped successfully.
+ * Returns
+ *  SUCCESS - If the audio record was transmitted successfully or an error was informed to the remote device.
  *  DEVICE_DISCONNECTED - If the device was disconnected.
  *  GENERIC_ERROR - Otherwise.
  */
-int command_stop_audio_record(int socket_fd){
-    LOG_TRACE_POINT;
+int command_transmit_audio_record(int btc_socket_fd, package_t package) {
+    LOG_TRACE("Record ID: %u.", package.content.audio_record_request_content->record_id);
 
     int result;
-    int stop_audio_record_result;
-    int send_package_result;
-    package_t command_result_package;
-    struct timeval execution_delay;
-    char* stop_audio_instant_file_path;
-    instant_t stop_audio_record_instant;
-    int retrieve_instant_from_file_result;
-    instant_t current_instant;
-    int get_instant_difference_result;
-    instant_t difference;
-
-    stop_audio_record_result = stop_audio_record();
-    LOG_TRACE_POINT;
-
-    stop_audio_instant_file_path = get_stop_audio_record_instant_file_path();
-    LOG_TRACE_POINT;
+    int find_result;
+    int send_file_result;
+    audio_catalog_record_t audio_catalog_record;
+    char* audio_record_file_path;
 
-    retrieve_instant_from_file_result  = retrieve_instant_from_file(&stop_audio_record_instant, stop_audio_instant_file_path);
+    find_result = find_audio_catalog_record(package.content.audio_record_request_content->record_id, &audio_catalog_record);
     LOG_TRACE_POINT;
 
-    if ( retrieve_instant_from_file_result != SUCCESS ) {
-        LOG_ERROR("Error while retrieving stop record instant.");
-        return GENERIC_ERROR;
+    if ( find_result == AUDIO_CATALOG_RECORD_NOT_FOUND ) {
+        LOG_TRACE_POINT;
+        return transmit_error(btc_socket_fd, AUDIO_RECORD_NOT_FOUND_ERROR_CODE, ERROR_MESSAGE_025);
     }
 
-    current_instant = get_instant();
-    LOG_TRACE_POINT;
-
-    get_instant_difference_result = get_instant_difference(&difference, current_instant, stop_audio_record_instant);
-    LOG_TRACE_POINT;
-
-    if ( get_instant_difference_result != SUCCESS ) {
-        LOG_ERROR("Error while calculating difference between the stop audio record time and current instant.");
+    if ( find_result != SUCCESS ) {
+        LOG_ERROR("Could not find the audio record on the audio catalog.");
         return GENERIC_ERROR;
     }
 
-    execution_delay = convert_instant_to_timeval(difference);
-    LOG_TRACE_POINT;
-
-    command_result_package = create_command_result_package(stop_audio_record_result, execution_delay);
-    LOG_TRACE_POINT;
+    audio_record_file_path = get_audio_catalog_record_path(&audio_catalog_record);
 
-    send_package_result = send_package(socket_fd, command_result_package);
+    /* A checksum not calculated yet by the audio catalog updater is calculated when the file is sent. */
+    if ( ( audio_catalog_record.flags & AUDIO_CATALOG_RECORD_CHECKSUM_PENDING ) != 0 ) {
+        LOG_TRACE_POINT;
+        send_file_result = send_file(btc_socket_fd, audio_record_file_path);
+    }
+    else {
+        LOG_TRACE_POINT;
+        send_file_result = send_file_with_digest(btc_socket_fd, audio_record_file_path, audio_catalog_record.size, audio_catalog_record.checksum);
+    }
     LOG_TRACE_POINT;
 
-    switch ( send_package_result ) {
+    switch ( send_file_result ) {
 
         case SUCCESS:
             LOG_TRACE_POINT;
@@ -633,11 +1317,70 @@ int command_stop_audio_record(int socket_fd){
             break;
 
         default:
-            LOG_TRACE_POINT;
+            LOG_ERROR("Error sending audio record file.");
             result = GENERIC_ERROR;
             break;
     }
 
+    free(audio_record_file_path);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Transmits the segments closed of the latest audio record.
+ *
+ * Parameters
+ *  btc_socket_fd - The bluetooth communication's socket file descriptor to the remote device.
+ *
+ * Returns
+ *  SUCCESS - If all audio segments were sent successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  The audio record may still be running. In this case only the audio segments already closed are sent and the remote device may request them again later to receive the new ones.
+ */
+int command_transmit_audio_record_segments(int btc_socket_fd) {
+    LOG_TRACE_POINT;
+
+    int result = SUCCESS;
+    int send_file_result;
+    size_t counter;
+    audio_segments_t audio_segments;
+
+    if ( get_latest_audio_record_segments(&audio_segments) != SUCCESS ) {
+        LOG_ERROR("Could not obtain the audio segments of the latest audio record.");
+        return GENERIC_ERROR;
+    }
+
+    for ( counter = 0; counter < audio_segments.count && result == SUCCESS; counter++ ) {
+        LOG_TRACE("Sending audio segment %zu of %zu.", counter + 1, audio_segments.count);
+
+        send_file_result = send_file(btc_socket_fd, audio_segments.paths[counter]);
+        LOG_TRACE_POINT;
+
+        switch ( send_file_result ) {
+
+            case SUCCESS:
+                LOG_TRACE_POINT;
+                break;
+
+            case DEVICE_DISCONNECTED:
+                LOG_TRACE_POINT;
+                result = DEVICE_DISCONNECTED;
+                break;
+
+            default:
+                LOG_ERROR("Error sending audio segment.");
+                result = GENERIC_ERROR;
+                break;
+        }
+    }
+
+    delete_audio_segments(&audio_segments);
+
     LOG_TRACE_POINT;
     return result;
 }
@@ -704,6 +1447,64 @@ int command_transmit_latest_audio_record(int btc_socket_fd){
     return result;
 }
 
+/*
+ * Transmits the bytes of the latest audio record the remote device does not have.
+ *
+ * Parameters
+ *  btc_socket_fd - The bluetooth communication's socket file descriptor to the remote device.
+ *  package - The "request audio file tail" package received, with the number of bytes the remote device has and their digest.
+ *
+ * Returns
+ *  SUCCESS - If the latest audio record file tail was sent successfully.
+ *  DEVICE_DISCONNECTED - If the device was disconnected.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  If the bytes the remote device has do not match the latest audio record, the whole file is sent.
+ */
+int command_transmit_latest_audio_record_tail(int btc_socket_fd, package_t package){
+    LOG_TRACE("File offset: %u.", package.content.file_tail_content->file_offset);
+
+    int result;
+    int send_file_result;
+    char* latest_audio_record_file_path;
+
+    latest_audio_record_file_path = get_latest_audio_record();
+    LOG_TRACE_POINT;
+
+    if ( latest_audio_record_file_path == NULL || strlen(latest_audio_record_file_path) <= 0 ) {
+        LOG_ERROR("Could not obtain the latest audio record file path.");
+        free(latest_audio_record_file_path);
+        return GENERIC_ERROR;
+    }
+
+    send_file_result = send_file_tail(btc_socket_fd, latest_audio_record_file_path, package.content.file_tail_content->file_offset, package.content.file_tail_content->prefix_digest);
+    LOG_TRACE_POINT;
+
+    switch ( send_file_result ) {
+
+        case SUCCESS:
+            LOG_TRACE_POINT;
+            result = SUCCESS;
+            break;
+
+        case DEVICE_DISCONNECTED:
+            LOG_TRACE_POINT;
+            result = DEVICE_DISCONNECTED;
+            break;
+
+        default:
+            LOG_ERROR("Error sending latest audio record file tail.");
+            result = GENERIC_ERROR;
+            break;
+    }
+
+    free(latest_audio_record_file_path);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
 /*
  * Finish both program and script logs.
  *
@@ -759,15 +1560,38 @@ int finish_processes(){
 
     int result;
     int finish_logs_result;
-    int unregister_bluetooth_service_result;
+    int unregister_bluetooth_service_result = SUCCESS;
+    int close_listening_socket_result;
+
+    if ( stop_audio_pre_roll() != SUCCESS ) {
+        LOG_ERROR("Error stopping audio pre-roll.");
+    }
 
-    unregister_bluetooth_service_result = unregister_bluetooth_service();
+    stop_audio_catalog_updater();
+    stop_audio_catalog();
+    stop_audio_record_index();
+
+    close_listening_socket_result = close_listening_socket();
     LOG_TRACE_POINT;
 
-    if ( unregister_bluetooth_service_result != SUCCESS ) {
-        LOG_ERROR("Error unregistering bluetooth service.");
+    if ( close_listening_socket_result != SUCCESS ) {
+        LOG_ERROR("Error closing the socket which listens for connections.");
+    }
+
+    /* Only bluetooth transports have a service registered. */
+    if ( is_bluetooth_transport() == true ) {
+        LOG_TRACE_POINT;
+
+        unregister_bluetooth_service_result = unregister_bluetooth_service();
+        LOG_TRACE_POINT;
+
+        if ( unregister_bluetooth_service_result != SUCCESS ) {
+            LOG_ERROR("Error unregistering bluetooth service.");
+        }
     }
 
+    log_script_statistics();
+
     finish_logs_result = finish_logs();
     LOG_TRACE_POINT;
 
@@ -775,7 +1599,7 @@ int finish_processes(){
         LOG_ERROR("Error finishing log.");
     }
 
-    if ( unregister_bluetooth_service_result != SUCCESS || finish_logs_result != SUCCESS ) {
+    if ( close_listening_socket_result != SUCCESS || unregister_bluetooth_service_result != SUCCESS || finish_logs_result != SUCCESS ) {
         LOG_TRACE_POINT;
         result = GENERIC_ERROR;
     } 
@@ -818,6 +1642,11 @@ int main(int argc, char** argv){
         return GENERIC_ERROR;
     }
 
+    /* A remote device which disconnects while content is written must be reported as "DEVICE_DISCONNECTED" instead of finishing the program. */
+    if ( signal(SIGPIPE, SIG_IGN) == SIG_ERR ) {
+        LOG_WARNING("Could not ignore the signal of writes on connections closed.");
+    }
+
     start_processes_result = start_processes();
     LOG_TRACE_POINT;
 
@@ -933,6 +1762,10 @@ int remote_device_communication_loop(int btc_socket_fd) {
     bool device_connected = true;
     int error_counter = 0;
 
+    /* Each remote device must negotiate its own transmission window size. */
+    set_transmission_window_size(DEFAULT_TRANSMISSION_WINDOW_SIZE);
+    LOG_TRACE_POINT;
+
     while ( device_connected == true ) {
         LOG_TRACE_POINT;
 
@@ -1146,11 +1979,42 @@ int start_processes(){
     if ( start_logs_result == SUCCESS ) {
         LOG_TRACE_POINT;
 
-        register_bluetooth_service_result = register_bluetooth_service();
+        /* Only bluetooth transports require the service to be registered. */
+        if ( is_bluetooth_transport() == true ) {
+            LOG_TRACE_POINT;
+
+            register_bluetooth_service_result = register_bluetooth_service();
+        }
+        else {
+            LOG_TRACE("Transport \"%s\" does not require a bluetooth service.", get_transport()->name);
+
+            register_bluetooth_service_result = SUCCESS;
+        }
         LOG_TRACE_POINT;
 
         if ( register_bluetooth_service_result == SUCCESS ) {
             LOG_TRACE_POINT;
+
+            /* Without pre-roll the device still records, so an error here does not stop the program. */
+            if ( start_audio_pre_roll() != SUCCESS ) {
+                LOG_WARNING("Could not start audio pre-roll.");
+            }
+
+            /* Without the index the audio directory is read again when the latest audio record is requested. */
+            if ( start_audio_record_index() != SUCCESS ) {
+                LOG_WARNING("Could not start the audio record index.");
+            }
+
+            /* The audio catalog is started again when a remote device requests it. */
+            if ( start_audio_catalog() != SUCCESS ) {
+                LOG_WARNING("Could not start the audio catalog.");
+            }
+
+            /* Without the updater the audio catalog is only updated when an audio record is stopped. */
+            if ( start_audio_catalog_updater() != SUCCESS ) {
+                LOG_WARNING("Could not start the audio catalog updater.");
+            }
+
             result = SUCCESS;
         } 
         else {
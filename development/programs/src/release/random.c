@@ -40,22 +40,20 @@ void initialize_random_byte_generator();
  */
 
 /*
- * Generates an array of random bytes.
+ * Fills a buffer with random bytes.
  *
  * Parameters
- *  array_size - The size of the random bytes array.
+ *  buffer - The buffer to be filled.
+ *  buffer_size - The size of the buffer.
  *
  * Returns
- *  An array with random byte values.
+ *  Nothing.
  */
-uint8_t* generate_random_bytes(size_t array_size) {
+void fill_random_bytes(uint8_t* buffer, size_t buffer_size) {
     LOG_TRACE_POINT;
 
-    uint8_t* byte_array;
     size_t count;
 
-    byte_array = (uint8_t*)malloc(array_size*sizeof(uint8_t));
-
     if ( initialized == false ) {
         LOG_TRACE_POINT;
 
@@ -63,10 +61,35 @@ uint8_t* generate_random_bytes(size_t array_size) {
         LOG_TRACE_POINT;
     }
 
-    for ( count = 0; count < array_size; count++ ) {
-        byte_array[count] = rand();
+    for ( count = 0; count < buffer_size; count++ ) {
+        buffer[count] = rand();
     }
 
+    LOG_TRACE_POINT;
+}
+
+/*
+ * Generates an array of random bytes.
+ *
+ * Parameters
+ *  array_size - The size of the random bytes array.
+ *
+ * Returns
+ *  An array with random byte values.
+ */
+uint8_t* generate_random_bytes(size_t array_size) {
+    LOG_TRACE_POINT;
+
+    uint8_t* byte_array;
+
+    byte_array = (uint8_t*)malloc(array_size*sizeof(uint8_t));
+    if ( byte_array == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the random bytes.");
+        return NULL;
+    }
+
+    fill_random_bytes(byte_array, array_size);
+
     LOG_TRACE_POINT;
     return byte_array;
 }
@@ -1,10 +1,12 @@
 /*
  * This source file contains the elaboration of all components required to execute bash scripts.
  *
- * Version: 
+ * Scripts are executed directly through "posix_spawn" (their interpreter is defined on their first line), without starting a shell to interpret a command line. Everything a script writes on its standard output and error is written on program log.
+ *
+ * Version:
  *  0.1
  *
- * Author: 
+ * Author:
  *  Marcelo Leite
  */
 
@@ -12,13 +14,25 @@
  * Includes.
  */
 
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include "directory.h"
 #include "log.h"
 #include "return_codes.h"
 #include "script.h"
+#include "timing.h"
 
 
 /*
@@ -28,11 +42,153 @@
 /* Path to script directory. */
 #define SCRIPT_DIRECTORY "scripts/"
 
+/* Maximum number of arguments a script can receive. */
+#define MAXIMUM_SCRIPT_ARGUMENTS 16
+
+/* Maximum number of scripts with execution statistics. */
+#define MAXIMUM_SCRIPT_STATISTICS 32
+
+/* Size of the buffer which stores a line written by a script. */
+#define SCRIPT_OUTPUT_LINE_SIZE 160
+
+/* Time (in milliseconds) between checks to find out if a script has finished. */
+#define SCRIPT_WAIT_INTERVAL 10
+
+
+/*
+ * Structures.
+ */
+
+/* An output (standard output or error) of a script being executed. */
+typedef struct {
+    int fd;
+    bool error_output;
+    char line[SCRIPT_OUTPUT_LINE_SIZE];
+    size_t line_length;
+} script_output_t;
+
+
+/*
+ * Variables.
+ */
+
+/* Environment of the program, inherited by the scripts. */
+extern char** environ;
+
+/* Execution statistics of the scripts. */
+script_statistics_t script_statistics[MAXIMUM_SCRIPT_STATISTICS];
+
+/* Number of scripts with execution statistics. */
+size_t script_statistics_count = 0;
+
+/* Controls the access to the execution statistics. */
+pthread_mutex_t script_statistics_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+/*
+ * Function headers.
+ */
+
+/* Closes the output of a script, writing its last line on log. */
+void close_script_output(script_output_t*, const char*);
+
+/* Creates the path to a script. */
+char* create_script_path(const char*);
+
+/* Returns the execution statistics of a script, creating them if required. */
+script_statistics_t* find_script_statistics(const char*);
+
+/* Opens a file descriptor which becomes readable when a script finishes. */
+int open_script_process_fd(pid_t);
+
+/* Opens a pipe to receive a script output. */
+int open_script_output(script_output_t*, int*, bool);
+
+/* Reads the content written by a script on one of its outputs. */
+bool read_script_output(script_output_t*, const char*);
+
+/* Updates the execution statistics of a script. */
+void update_script_statistics(const char*, int, uint64_t);
+
+/* Waits for a script to finish, writing its outputs on log. */
+int wait_script(pid_t, script_output_t*, const char*, uint64_t, int);
+
+/* Writes a line written by a script on log. */
+void write_script_output_line(script_output_t*, const char*);
+
 
 /*
  * Function elaborations.
  */
 
+/*
+ * Closes the output of a script, writing its last line on log.
+ *
+ * Parameters
+ *  script_output - The script output to be closed.
+ *  script_name - Name of the script which produced the output.
+ *
+ * Returns
+ *  Nothing.
+ */
+void close_script_output(script_output_t* script_output, const char* script_name) {
+    LOG_TRACE_POINT;
+
+    if ( script_output->fd < 0 ) {
+        LOG_TRACE_POINT;
+        return;
+    }
+
+    write_script_output_line(script_output, script_name);
+    close(script_output->fd);
+    script_output->fd = -1;
+
+    LOG_TRACE_POINT;
+}
+
+/*
+ * Creates the path to a script.
+ *
+ * Parameters
+ *  script_name - Name of the script.
+ *
+ * Returns
+ *  The path to the script or NULL if there was an error while creating it.
+ *
+ * Observations
+ *  The path must be released with "free" after its use.
+ */
+char* create_script_path(const char* script_name) {
+    LOG_TRACE_POINT;
+
+    char* input_directory;
+    char* script_path;
+    size_t script_path_length;
+
+    input_directory = get_input_directory();
+    if ( input_directory == NULL ) {
+        LOG_ERROR("Could not retrieve the input directory.");
+        return NULL;
+    }
+
+    script_path_length = strlen(input_directory) + strlen(SCRIPT_DIRECTORY) + strlen(script_name);
+
+    script_path = malloc((script_path_length+1)*sizeof(char));
+    if ( script_path == NULL ) {
+        LOG_ERROR("Could not allocate memory to store the script path.");
+        free(input_directory);
+        return NULL;
+    }
+
+    strcpy(script_path, input_directory);
+    strcat(script_path, SCRIPT_DIRECTORY);
+    strcat(script_path, script_name);
+    free(input_directory);
+
+    LOG_TRACE_POINT;
+    return script_path;
+}
+
 /*
  * Executes a shell script.
  *
@@ -41,39 +197,553 @@
  *
  * Returns
  *  The exit value received from the script execution or GENERIC_ERROR if there was an error while trying to execute the script.
+ *
+ * Observations
+ *  The script is executed without arguments and with the default time limit.
  */
 int execute_script(char* script_name){
     LOG_TRACE_POINT;
 
-    int script_name_length;
-    char* input_directory;
-    int input_directory_length;
+    return execute_script_with_arguments(script_name, NULL, SCRIPT_DEFAULT_TIMEOUT);
+}
+
+/*
+ * Executes a shell script with the arguments and time limit informed.
+ *
+ * Parameters
+ *  script_name - Path of the script to be executed, relative to the script directory.
+ *  arguments - The arguments to the script, terminated by a NULL pointer. It can be NULL if the script does not receive arguments.
+ *  timeout - Time limit (in milliseconds) for the script execution. If it is zero or negative the script has no time limit.
+ *
+ * Returns
+ *  The exit value received from the script execution.
+ *  SCRIPT_TIMED_OUT - If the script was terminated for exceeding its time limit.
+ *  GENERIC_ERROR - If there was an error while trying to execute the script.
+ *
+ * Observations
+ *  The script and all processes it started are killed if the time limit is exceeded.
+ */
+int execute_script_with_arguments(const char* script_name, char* const arguments[], int timeout) {
+    LOG_TRACE_POINT;
+
     char* script_path;
-    int script_path_length;
+    char* script_arguments[MAXIMUM_SCRIPT_ARGUMENTS+2];
+    size_t argument_counter;
+    script_output_t script_outputs[2];
+    int output_fds[2];
+    int error_fds[2];
+    posix_spawn_file_actions_t file_actions;
+    posix_spawnattr_t spawn_attributes;
+    sigset_t signal_set;
+    uint64_t start_time;
+    pid_t script_pid;
+    int spawn_result;
     int script_result;
+    uint64_t elapsed_time;
 
     if ( script_name == NULL ) {
         LOG_ERROR("Script name cannot be null.");
         return GENERIC_ERROR;
     }
 
-    script_name_length=strlen(script_name);
+    LOG_TRACE("Script: \"%s\", time limit: %d ms.", script_name, timeout);
 
-    input_directory=get_input_directory();
-    input_directory_length=strlen(input_directory);
-    input_directory_length+=strlen(SCRIPT_DIRECTORY);
+    script_path = create_script_path(script_name);
+    if ( script_path == NULL ) {
+        LOG_ERROR("Could not create the path to script \"%s\".", script_name);
+        return GENERIC_ERROR;
+    }
 
-    script_path_length=input_directory_length+script_name_length;
+    script_arguments[0] = script_path;
+    argument_counter = 0;
+    if ( arguments != NULL ) {
+        while ( arguments[argument_counter] != NULL ) {
+            if ( argument_counter >= MAXIMUM_SCRIPT_ARGUMENTS ) {
+                LOG_ERROR("Script \"%s\" has more than %d arguments.", script_name, MAXIMUM_SCRIPT_ARGUMENTS);
+                free(script_path);
+                return GENERIC_ERROR;
+            }
+            script_arguments[argument_counter+1] = arguments[argument_counter];
+            argument_counter++;
+        }
+    }
+    script_arguments[argument_counter+1] = NULL;
 
-    script_path=malloc((script_path_length+1)*sizeof(char));
+    if ( open_script_output(&script_outputs[0], output_fds, false) != SUCCESS ) {
+        LOG_ERROR("Could not create a pipe to receive the standard output of script \"%s\".", script_name);
+        free(script_path);
+        return GENERIC_ERROR;
+    }
 
-    strcpy(script_path, input_directory);
-    strcat(script_path, SCRIPT_DIRECTORY);
-    strcat(script_path, script_name);
-    LOG_TRACE("%s", script_path);
+    if ( open_script_output(&script_outputs[1], error_fds, true) != SUCCESS ) {
+        LOG_ERROR("Could not create a pipe to receive the standard error of script \"%s\".", script_name);
+        close(output_fds[1]);
+        close_script_output(&script_outputs[0], script_name);
+        free(script_path);
+        return GENERIC_ERROR;
+    }
 
-    script_result = system(script_path);
+    posix_spawn_file_actions_init(&file_actions);
+    posix_spawn_file_actions_addopen(&file_actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&file_actions, output_fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&file_actions, error_fds[1], STDERR_FILENO);
 
-    LOG_TRACE_POINT;
+    /* The script runs on its own process group, so it can be terminated along with every process it started. */
+    posix_spawnattr_init(&spawn_attributes);
+    posix_spawnattr_setflags(&spawn_attributes, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK);
+    posix_spawnattr_setpgroup(&spawn_attributes, 0);
+    sigfillset(&signal_set);
+    posix_spawnattr_setsigdefault(&spawn_attributes, &signal_set);
+    sigemptyset(&signal_set);
+    posix_spawnattr_setsigmask(&spawn_attributes, &signal_set);
+
+    start_time = get_monotonic_time();
+
+    spawn_result = posix_spawn(&script_pid, script_path, &file_actions, &spawn_attributes, script_arguments, environ);
+
+    posix_spawnattr_destroy(&spawn_attributes);
+    posix_spawn_file_actions_destroy(&file_actions);
+    close(output_fds[1]);
+    close(error_fds[1]);
+    free(script_path);
+
+    if ( spawn_result != 0 ) {
+        LOG_ERROR("Could not execute script \"%s\".", script_name);
+        LOG_ERROR("%s", strerror(spawn_result));
+        close_script_output(&script_outputs[0], script_name);
+        close_script_output(&script_outputs[1], script_name);
+        update_script_statistics(script_name, GENERIC_ERROR, get_elapsed_time(start_time)/NANOSECONDS_PER_MICROSECOND);
+        return GENERIC_ERROR;
+    }
+
+    script_result = wait_script(script_pid, script_outputs, script_name, start_time, timeout);
+
+    elapsed_time = get_elapsed_time(start_time)/NANOSECONDS_PER_MICROSECOND;
+    update_script_statistics(script_name, script_result, elapsed_time);
+
+    LOG_TRACE("Script \"%s\" returned %d after %llu us.", script_name, script_result, (unsigned long long)elapsed_time);
     return script_result;
 }
+
+/*
+ * Returns the execution statistics of a script, creating them if required.
+ *
+ * Parameters
+ *  script_name - Name of the script.
+ *
+ * Returns
+ *  The execution statistics of the script or NULL if there is no space to store statistics of another script.
+ *
+ * Observations
+ *  The statistics mutex must be locked before calling this function.
+ */
+script_statistics_t* find_script_statistics(const char* script_name) {
+    LOG_TRACE_POINT;
+
+    script_statistics_t* current_script_statistics;
+    size_t counter;
+
+    for ( counter = 0; counter < script_statistics_count; counter++ ) {
+        if ( strncmp(script_statistics[counter].script_name, script_name, SCRIPT_STATISTICS_NAME_SIZE-1) == 0 ) {
+            LOG_TRACE_POINT;
+            return &script_statistics[counter];
+        }
+    }
+
+    if ( script_statistics_count >= MAXIMUM_SCRIPT_STATISTICS ) {
+        LOG_TRACE_POINT;
+        return NULL;
+    }
+
+    current_script_statistics = &script_statistics[script_statistics_count++];
+    memset(current_script_statistics, 0, sizeof(script_statistics_t));
+    strncpy(current_script_statistics->script_name, script_name, SCRIPT_STATISTICS_NAME_SIZE-1);
+
+    LOG_TRACE_POINT;
+    return current_script_statistics;
+}
+
+/*
+ * Returns the execution statistics of a script.
+ *
+ * Parameters
+ *  script_name - Name of the script.
+ *  statistics - The variable where the statistics will be copied.
+ *
+ * Returns
+ *  SUCCESS - If the statistics were copied successfully.
+ *  GENERIC_ERROR - If the script was never executed.
+ *
+ * Observations
+ *  Times are informed in microseconds.
+ */
+int get_script_statistics(const char* script_name, script_statistics_t* statistics) {
+    LOG_TRACE_POINT;
+
+    size_t counter;
+    int result = GENERIC_ERROR;
+
+    pthread_mutex_lock(&script_statistics_mutex);
+    for ( counter = 0; counter < script_statistics_count; counter++ ) {
+        if ( strncmp(script_statistics[counter].script_name, script_name, SCRIPT_STATISTICS_NAME_SIZE-1) == 0 ) {
+            *statistics = script_statistics[counter];
+            result = SUCCESS;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&script_statistics_mutex);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Writes the execution statistics of all scripts on log.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  Nothing.
+ */
+void log_script_statistics() {
+    LOG_TRACE_POINT;
+
+    script_statistics_t* current_script_statistics;
+    size_t counter;
+
+    pthread_mutex_lock(&script_statistics_mutex);
+    for ( counter = 0; counter < script_statistics_count; counter++ ) {
+        current_script_statistics = &script_statistics[counter];
+        LOG_TRACE("Script \"%s\": %u executions, %u failures, %u timeouts, average time: %llu us, maximum time: %llu us.",
+                  current_script_statistics->script_name,
+                  current_script_statistics->executions,
+                  current_script_statistics->failures,
+                  current_script_statistics->timeouts,
+                  (unsigned long long)(current_script_statistics->total_time/current_script_statistics->executions),
+                  (unsigned long long)current_script_statistics->maximum_time);
+    }
+    pthread_mutex_unlock(&script_statistics_mutex);
+
+    LOG_TRACE_POINT;
+}
+
+/*
+ * Opens a file descriptor which becomes readable when a script finishes.
+ *
+ * Parameters
+ *  script_pid - Process ID of the script.
+ *
+ * Returns
+ *  The file descriptor or -1 if the system does not provide it.
+ *
+ * Observations
+ *  Without this file descriptor the end of the script is checked periodically.
+ */
+int open_script_process_fd(pid_t script_pid) {
+    LOG_TRACE_POINT;
+
+#ifdef SYS_pidfd_open
+    return (int)syscall(SYS_pidfd_open, script_pid, 0);
+#else
+    return -1;
+#endif
+}
+
+/*
+ * Opens a pipe to receive a script output.
+ *
+ * Parameters
+ *  script_output - The script output which will read the pipe.
+ *  pipe_fds - The variable where the pipe file descriptors will be stored.
+ *  error_output - Indicates if the pipe will receive the standard error of the script.
+ *
+ * Returns
+ *  SUCCESS - If the pipe was opened successfully.
+ *  GENERIC_ERROR - Otherwise.
+ *
+ * Observations
+ *  Both pipe ends are closed on other programs executed, so scripts started concurrently do not keep each other's pipes open. The read end does not block.
+ */
+int open_script_output(script_output_t* script_output, int* pipe_fds, bool error_output) {
+    LOG_TRACE_POINT;
+
+    int errno_value;
+
+    if ( pipe(pipe_fds) != 0 ) {
+        errno_value = errno;
+        LOG_ERROR("Could not create pipe.");
+        LOG_ERROR("%s", strerror(errno_value));
+        return GENERIC_ERROR;
+    }
+
+    fcntl(pipe_fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(pipe_fds[1], F_SETFD, FD_CLOEXEC);
+    fcntl(pipe_fds[0], F_SETFL, fcntl(pipe_fds[0], F_GETFL) | O_NONBLOCK);
+
+    script_output->fd = pipe_fds[0];
+    script_output->error_output = error_output;
+    script_output->line_length = 0;
+
+    LOG_TRACE_POINT;
+    return SUCCESS;
+}
+
+/*
+ * Reads the content written by a script on one of its outputs.
+ *
+ * Parameters
+ *  script_output - The script output to be read.
+ *  script_name - Name of the script which produced the output.
+ *
+ * Returns
+ *  True if the output is still open. False if it was closed.
+ *
+ * Observations
+ *  Each line read is written on log. The output is closed when the script closes it or on any error.
+ */
+bool read_script_output(script_output_t* script_output, const char* script_name) {
+    LOG_TRACE_POINT;
+
+    char buffer[256];
+    ssize_t read_result;
+    ssize_t counter;
+
+    read_result = read(script_output->fd, buffer, sizeof(buffer));
+    if ( read_result < 0 && ( errno == EAGAIN || errno == EINTR ) ) {
+        LOG_TRACE_POINT;
+        return true;
+    }
+
+    if ( read_result <= 0 ) {
+        LOG_TRACE_POINT;
+        close_script_output(script_output, script_name);
+        return false;
+    }
+
+    for ( counter = 0; counter < read_result; counter++ ) {
+        if ( buffer[counter] == '\n' ) {
+            write_script_output_line(script_output, script_name);
+            continue;
+        }
+
+        if ( script_output->line_length == SCRIPT_OUTPUT_LINE_SIZE-1 ) {
+            write_script_output_line(script_output, script_name);
+        }
+        script_output->line[script_output->line_length++] = buffer[counter];
+    }
+
+    LOG_TRACE_POINT;
+    return true;
+}
+
+/*
+ * Updates the execution statistics of a script.
+ *
+ * Parameters
+ *  script_name - Name of the script.
+ *  script_result - Result of the script execution.
+ *  elapsed_time - Time (in microseconds) the script execution took.
+ *
+ * Returns
+ *  Nothing.
+ */
+void update_script_statistics(const char* script_name, int script_result, uint64_t elapsed_time) {
+    LOG_TRACE_POINT;
+
+    script_statistics_t* current_script_statistics;
+
+    pthread_mutex_lock(&script_statistics_mutex);
+
+    current_script_statistics = find_script_statistics(script_name);
+    if ( current_script_statistics != NULL ) {
+        current_script_statistics->executions++;
+        if ( script_result != SUCCESS ) {
+            current_script_statistics->failures++;
+        }
+        if ( script_result == SCRIPT_TIMED_OUT ) {
+            current_script_statistics->timeouts++;
+        }
+        current_script_statistics->total_time += elapsed_time;
+        if ( elapsed_time > current_script_statistics->maximum_time ) {
+            current_script_statistics->maximum_time = elapsed_time;
+        }
+    }
+
+    pthread_mutex_unlock(&script_statistics_mutex);
+
+    LOG_TRACE_POINT;
+}
+
+/*
+ * Waits for a script to finish, writing its outputs on log.
+ *
+ * Parameters
+ *  script_pid - Process ID of the script.
+ *  script_outputs - The standard output and error of the script.
+ *  script_name - Name of the script.
+ *  start_time - The monotonic time (in nanoseconds) the script was started.
+ *  timeout - Time limit (in milliseconds) for the script execution. If it is zero or negative the script has no time limit.
+ *
+ * Returns
+ *  The exit value received from the script execution.
+ *  SCRIPT_TIMED_OUT - If the script was terminated for exceeding its time limit.
+ *  GENERIC_ERROR - If the script was terminated by a signal or there was an error while waiting for it.
+ *
+ * Observations
+ *  The outputs are closed before the function returns. Processes started by the script may keep its outputs open after it finishes, so the function does not wait for the outputs to be closed.
+ */
+int wait_script(pid_t script_pid, script_output_t* script_outputs, const char* script_name, uint64_t start_time, int timeout) {
+    LOG_TRACE_POINT;
+
+    struct pollfd poll_fds[3];
+    script_output_t* polled_outputs[2];
+    nfds_t poll_count;
+    nfds_t outputs_count;
+    nfds_t counter;
+    int process_fd;
+    int64_t remaining_time;
+    int poll_timeout;
+    int script_status;
+    int errno_value;
+    pid_t wait_result;
+    bool script_finished = false;
+    int result = GENERIC_ERROR;
+
+    process_fd = open_script_process_fd(script_pid);
+
+    while ( true ) {
+        wait_result = waitpid(script_pid, &script_status, WNOHANG);
+        if ( wait_result == script_pid ) {
+            LOG_TRACE_POINT;
+            script_finished = true;
+            break;
+        }
+
+        if ( wait_result < 0 && errno != EINTR ) {
+            errno_value = errno;
+            LOG_ERROR("Error while waiting for script \"%s\".", script_name);
+            LOG_ERROR("%s", strerror(errno_value));
+            break;
+        }
+
+        outputs_count = 0;
+        for ( counter = 0; counter < 2; counter++ ) {
+            if ( script_outputs[counter].fd >= 0 ) {
+                poll_fds[outputs_count].fd = script_outputs[counter].fd;
+                poll_fds[outputs_count].events = POLLIN;
+                poll_fds[outputs_count].revents = 0;
+                polled_outputs[outputs_count] = &script_outputs[counter];
+                outputs_count++;
+            }
+        }
+
+        poll_count = outputs_count;
+        if ( process_fd >= 0 ) {
+            poll_fds[poll_count].fd = process_fd;
+            poll_fds[poll_count].events = POLLIN;
+            poll_fds[poll_count].revents = 0;
+            poll_count++;
+            poll_timeout = -1;
+        }
+        else {
+            /* Once the outputs are closed the script is about to finish. */
+            poll_timeout = ( outputs_count > 0 ? SCRIPT_WAIT_INTERVAL : 1 );
+        }
+
+        if ( timeout > 0 ) {
+            remaining_time = (int64_t)timeout - get_elapsed_time(start_time)/NANOSECONDS_PER_MILLISECOND;
+            if ( remaining_time <= 0 ) {
+                LOG_WARNING("Script \"%s\" exceeded its time limit of %d ms and will be terminated.", script_name, timeout);
+                kill(-script_pid, SIGKILL);
+                while ( waitpid(script_pid, &script_status, 0) < 0 && errno == EINTR );
+                result = SCRIPT_TIMED_OUT;
+                break;
+            }
+
+            if ( poll_timeout < 0 || remaining_time < poll_timeout ) {
+                poll_timeout = (int)remaining_time;
+            }
+        }
+
+        if ( poll(poll_fds, poll_count, poll_timeout) < 0 && errno != EINTR ) {
+            errno_value = errno;
+            LOG_ERROR("Error while waiting for outputs of script \"%s\".", script_name);
+            LOG_ERROR("%s", strerror(errno_value));
+            kill(-script_pid, SIGKILL);
+            while ( waitpid(script_pid, &script_status, 0) < 0 && errno == EINTR );
+            break;
+        }
+
+        for ( counter = 0; counter < outputs_count; counter++ ) {
+            if ( poll_fds[counter].revents != 0 ) {
+                read_script_output(polled_outputs[counter], script_name);
+            }
+        }
+    }
+
+    if ( script_finished == true ) {
+        LOG_TRACE_POINT;
+
+        /* Reads what is left on the outputs. */
+        for ( counter = 0; counter < 2; counter++ ) {
+            poll_fds[0].fd = script_outputs[counter].fd;
+            poll_fds[0].events = POLLIN;
+            while ( script_outputs[counter].fd >= 0 && poll(poll_fds, 1, 0) > 0 ) {
+                read_script_output(&script_outputs[counter], script_name);
+            }
+        }
+
+        if ( WIFEXITED(script_status) ) {
+            LOG_TRACE_POINT;
+            result = WEXITSTATUS(script_status);
+        }
+        else {
+            LOG_WARNING("Script \"%s\" was terminated by signal %d.", script_name, WTERMSIG(script_status));
+            result = GENERIC_ERROR;
+        }
+    }
+
+    if ( process_fd >= 0 ) {
+        close(process_fd);
+    }
+    close_script_output(&script_outputs[0], script_name);
+    close_script_output(&script_outputs[1], script_name);
+
+    LOG_TRACE_POINT;
+    return result;
+}
+
+/*
+ * Writes a line written by a script on log.
+ *
+ * Parameters
+ *  script_output - The script output which contains the line.
+ *  script_name - Name of the script which produced the line.
+ *
+ * Returns
+ *  Nothing.
+ *
+ * Observations
+ *  Lines written on standard error are logged as warnings.
+ */
+void write_script_output_line(script_output_t* script_output, const char* script_name) {
+    LOG_TRACE_POINT;
+
+    if ( script_output->line_length == 0 ) {
+        LOG_TRACE_POINT;
+        return;
+    }
+
+    script_output->line[script_output->line_length] = 0;
+    script_output->line_length = 0;
+
+    if ( script_output->error_output == true ) {
+        LOG_WARNING("%s: %s", script_name, script_output->line);
+    }
+    else {
+        LOG_TRACE("%s: %s", script_name, script_output->line);
+    }
+
+    LOG_TRACE_POINT;
+}
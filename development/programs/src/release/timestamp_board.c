@@ -0,0 +1,240 @@
+/*
+ * This source file contains the elaboration of all components required to publish and read the instants events happened.
+ *
+ * Each event has a slot protected by a sequence counter (a "seqlock"). A publisher makes the counter odd, writes the instant and makes it even again; a reader retries until it reads the same even counter before and after the instant. Publishing and reading never block on a lock nor call the system, so the audio capture and encoder threads can publish their instants while the commands read them.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "return_codes.h"
+#include "timestamp_board.h"
+#include "timing.h"
+
+
+/*
+ * Structures.
+ */
+
+/* A slot of the timestamp board. */
+typedef struct {
+    atomic_uint sequence;
+    atomic_uint_least64_t monotonic_time;
+    atomic_int_least64_t real_time;
+    atomic_uint publications;
+} timestamp_slot_t;
+
+
+/*
+ * Variables.
+ */
+
+/* Slots of the events on the timestamp board. */
+timestamp_slot_t timestamp_board[TIMESTAMP_EVENTS];
+
+
+/*
+ * Function headers.
+ */
+
+/* Starts writing on a slot of the timestamp board. */
+unsigned int lock_timestamp_slot(timestamp_slot_t*);
+
+
+/*
+ * Function elaborations.
+ *
+ * These functions run on the audio capture and encoder threads, so they do not use log macros.
+ */
+
+/*
+ * Discards the instant published for an event.
+ *
+ * Parameters
+ *  event - The event code.
+ *
+ * Returns
+ *  SUCCESS - If the instant was discarded successfully.
+ *  GENERIC_ERROR - If the event code is unknown.
+ *
+ * Observations
+ *  After this function, reading the event returns "TIMESTAMP_NOT_PUBLISHED" until a new instant is published, so an instant of a previous event is not taken as the latest one.
+ */
+int clear_event_timestamp(int event) {
+
+    timestamp_slot_t* slot;
+    unsigned int sequence;
+
+    if ( event < 0 || event >= TIMESTAMP_EVENTS ) {
+        return GENERIC_ERROR;
+    }
+
+    slot = &timestamp_board[event];
+    sequence = lock_timestamp_slot(slot);
+
+    atomic_store_explicit(&slot->monotonic_time, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->real_time, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->publications, 0, memory_order_relaxed);
+
+    atomic_store_explicit(&slot->sequence, sequence + 2, memory_order_release);
+
+    return SUCCESS;
+}
+
+/*
+ * Reads the latest instant published for an event.
+ *
+ * Parameters
+ *  event - The event code.
+ *  event_timestamp - The variable where the instant will be stored.
+ *
+ * Returns
+ *  SUCCESS - If the instant was read successfully.
+ *  TIMESTAMP_NOT_PUBLISHED - If no instant was published for the event.
+ *  GENERIC_ERROR - If the event code is unknown.
+ */
+int get_event_timestamp(int event, event_timestamp_t* event_timestamp) {
+
+    timestamp_slot_t* slot;
+    unsigned int start_sequence;
+    unsigned int end_sequence;
+
+    if ( event < 0 || event >= TIMESTAMP_EVENTS ) {
+        return GENERIC_ERROR;
+    }
+
+    slot = &timestamp_board[event];
+
+    do {
+        start_sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if ( start_sequence & 1 ) {
+            sched_yield();
+            continue;
+        }
+
+        event_timestamp->monotonic_time = atomic_load_explicit(&slot->monotonic_time, memory_order_relaxed);
+        event_timestamp->real_time = atomic_load_explicit(&slot->real_time, memory_order_relaxed);
+        event_timestamp->publications = atomic_load_explicit(&slot->publications, memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        end_sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    } while ( ( start_sequence & 1 ) || start_sequence != end_sequence );
+
+    if ( event_timestamp->publications == 0 ) {
+        return TIMESTAMP_NOT_PUBLISHED;
+    }
+
+    return SUCCESS;
+}
+
+/*
+ * Returns the time (in nanoseconds) elapsed between the latest instants published for two events.
+ *
+ * Parameters
+ *  first_event - The event code of the first event.
+ *  second_event - The event code of the second event.
+ *  interval - The variable where the time elapsed from the first to the second event will be stored. It is negative if the second event happened first.
+ *
+ * Returns
+ *  SUCCESS - If the interval was calculated successfully.
+ *  TIMESTAMP_NOT_PUBLISHED - If no instant was published for one of the events.
+ *  GENERIC_ERROR - If an event code is unknown.
+ */
+int get_events_interval(int first_event, int second_event, int64_t* interval) {
+
+    event_timestamp_t first_timestamp;
+    event_timestamp_t second_timestamp;
+    int result;
+
+    result = get_event_timestamp(first_event, &first_timestamp);
+    if ( result != SUCCESS ) {
+        return result;
+    }
+
+    result = get_event_timestamp(second_event, &second_timestamp);
+    if ( result != SUCCESS ) {
+        return result;
+    }
+
+    *interval = get_time_difference(second_timestamp.monotonic_time, first_timestamp.monotonic_time);
+    return SUCCESS;
+}
+
+/*
+ * Starts writing on a slot of the timestamp board.
+ *
+ * Parameters
+ *  slot - The slot to be written.
+ *
+ * Returns
+ *  The even sequence the slot had before being locked. The slot is released storing this sequence plus two.
+ */
+unsigned int lock_timestamp_slot(timestamp_slot_t* slot) {
+
+    unsigned int sequence;
+
+    /* Writers of the same event take turns making the sequence odd. */
+    sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    while ( true ) {
+        if ( sequence & 1 ) {
+            sched_yield();
+            sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+            continue;
+        }
+
+        if ( atomic_compare_exchange_weak_explicit(&slot->sequence, &sequence, sequence + 1, memory_order_acquire, memory_order_relaxed) == true ) {
+            break;
+        }
+    }
+    atomic_thread_fence(memory_order_release);
+
+    return sequence;
+}
+
+/*
+ * Publishes the current instant for an event.
+ *
+ * Parameters
+ *  event - The event code.
+ *
+ * Returns
+ *  SUCCESS - If the instant was published successfully.
+ *  GENERIC_ERROR - If the event code is unknown.
+ *
+ * Observations
+ *  The instant is stored with the monotonic time, to measure intervals, and the real time (in nanoseconds since the epoch), to inform when the event happened.
+ */
+int publish_event_timestamp(int event) {
+
+    timestamp_slot_t* slot;
+    unsigned int sequence;
+    struct timespec real_time;
+
+    if ( event < 0 || event >= TIMESTAMP_EVENTS ) {
+        return GENERIC_ERROR;
+    }
+
+    slot = &timestamp_board[event];
+    sequence = lock_timestamp_slot(slot);
+
+    clock_gettime(CLOCK_REALTIME, &real_time);
+    atomic_store_explicit(&slot->monotonic_time, get_monotonic_time(), memory_order_relaxed);
+    atomic_store_explicit(&slot->real_time, (int64_t)real_time.tv_sec*NANOSECONDS_PER_SECOND + real_time.tv_nsec, memory_order_relaxed);
+    atomic_store_explicit(&slot->publications, atomic_load_explicit(&slot->publications, memory_order_relaxed) + 1, memory_order_relaxed);
+
+    atomic_store_explicit(&slot->sequence, sequence + 2, memory_order_release);
+
+    return SUCCESS;
+}
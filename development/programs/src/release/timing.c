@@ -0,0 +1,165 @@
+/*
+ * This source file contains the elaboration of all components required to measure time intervals.
+ *
+ * Times are kept as 64-bit nanosecond counts taken from clocks which are not affected by changes on system date, so intervals are exact across midnight, daylight saving time and date adjustments.
+ *
+ * Version:
+ *  0.1
+ *
+ * Author:
+ *  Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include "timing.h"
+
+
+/*
+ * Function headers.
+ */
+
+/* Returns the time of a clock in nanoseconds. */
+uint64_t get_clock_time(clockid_t);
+
+
+/*
+ * Function elaborations.
+ *
+ * These functions are called on every package and by threads which must not log, so they do not use log macros.
+ */
+
+/*
+ * Converts a time interval in nanoseconds to a "timespec" structure.
+ *
+ * Parameters
+ *  nanoseconds - The time interval (in nanoseconds). It can be negative.
+ *
+ * Returns
+ *  A "timespec" structure with the time interval. Its nanoseconds field is never negative.
+ */
+struct timespec convert_nanoseconds_to_timespec(int64_t nanoseconds) {
+
+    struct timespec result;
+    int64_t remainder;
+
+    result.tv_sec = (time_t)(nanoseconds/NANOSECONDS_PER_SECOND);
+    remainder = nanoseconds%NANOSECONDS_PER_SECOND;
+    if ( remainder < 0 ) {
+        result.tv_sec--;
+        remainder += NANOSECONDS_PER_SECOND;
+    }
+    result.tv_nsec = (long)remainder;
+
+    return result;
+}
+
+/*
+ * Converts a time interval in nanoseconds to a "timeval" structure.
+ *
+ * Parameters
+ *  nanoseconds - The time interval (in nanoseconds). It can be negative.
+ *
+ * Returns
+ *  A "timeval" structure with the time interval. Its microseconds field is never negative.
+ */
+struct timeval convert_nanoseconds_to_timeval(int64_t nanoseconds) {
+
+    struct timespec time_interval;
+    struct timeval result;
+
+    time_interval = convert_nanoseconds_to_timespec(nanoseconds);
+    result.tv_sec = time_interval.tv_sec;
+    result.tv_usec = (suseconds_t)(time_interval.tv_nsec/NANOSECONDS_PER_MICROSECOND);
+
+    return result;
+}
+
+/*
+ * Returns the time (in nanoseconds) elapsed since the system booted, including the time it was suspended.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The current boot time in nanoseconds.
+ *
+ * Observations
+ *  If the system does not provide a boot time clock, the monotonic time is returned.
+ */
+uint64_t get_boot_time() {
+
+#ifdef CLOCK_BOOTTIME
+    return get_clock_time(CLOCK_BOOTTIME);
+#else
+    return get_clock_time(CLOCK_MONOTONIC);
+#endif
+}
+
+/*
+ * Returns the time of a clock in nanoseconds.
+ *
+ * Parameters
+ *  clock_id - The clock to be read.
+ *
+ * Returns
+ *  The time of the clock in nanoseconds or zero if the clock could not be read.
+ */
+uint64_t get_clock_time(clockid_t clock_id) {
+
+    struct timespec current_time;
+
+    if ( clock_gettime(clock_id, &current_time) != 0 ) {
+        return 0;
+    }
+
+    return (uint64_t)current_time.tv_sec*NANOSECONDS_PER_SECOND + (uint64_t)current_time.tv_nsec;
+}
+
+/*
+ * Returns the monotonic time (in nanoseconds) elapsed since an instant.
+ *
+ * Parameters
+ *  start_time - The instant, retrieved through "get_monotonic_time" function.
+ *
+ * Returns
+ *  The time elapsed (in nanoseconds) since the instant.
+ */
+int64_t get_elapsed_time(uint64_t start_time) {
+    return get_time_difference(get_monotonic_time(), start_time);
+}
+
+/*
+ * Returns the current monotonic time in nanoseconds.
+ *
+ * Parameters
+ *  None.
+ *
+ * Returns
+ *  The current monotonic time in nanoseconds.
+ *
+ * Observations
+ *  The monotonic time does not advance while the system is suspended. Use "get_boot_time" when that time must be counted.
+ */
+uint64_t get_monotonic_time() {
+    return get_clock_time(CLOCK_MONOTONIC);
+}
+
+/*
+ * Returns the difference (in nanoseconds) between two times.
+ *
+ * Parameters
+ *  time_1 - The time to subtract from.
+ *  time_2 - The time to be subtracted.
+ *
+ * Returns
+ *  The difference between the first and the second time. It is negative if the second time is later than the first.
+ *
+ * Observations
+ *  Both times must be retrieved from the same clock.
+ */
+int64_t get_time_difference(uint64_t time_1, uint64_t time_2) {
+    return (int64_t)(time_1 - time_2);
+}
@@ -11,13 +11,29 @@
 
 #include <stdio.h>
 #include <stdlib.h> 
+#include <string.h>
 #include <unistd.h>
 
 #include "audio.h"
+#include "audio/catalog.h"
+#include "audio/record_index.h"
+#include "directory.h"
+#include "return_codes.h"
+
+/*
+ * Definitions.
+ */
+#define TEST_AUDIO_RECORD_SIZE 16000
+#define TEST_AUDIO_CATALOG_PAGE_SIZE 2
 
 /*
  * Function headers.
  */
+void create_test_audio_record(const char*, const char*, size_t);
+void print_audio_catalog();
+void print_latest_indexed_audio_record();
+void test_audio_catalog();
+void test_audio_record_index();
 void test_start_stop_audio_record();
 void test_get_latest_audio_record();
 
@@ -31,11 +47,233 @@ void test_get_latest_audio_record();
  */
 int main(int argc, char** argv){
 
+    test_audio_record_index();
+    test_audio_catalog();
     test_get_latest_audio_record();
     test_start_stop_audio_record();
     return 0;
 }
 
+/*
+ * Creates an audio record with a single MPEG 1 layer III frame header (128 kbit/s) followed by silence.
+ */
+void create_test_audio_record(const char* audio_directory, const char* name, size_t size) {
+    uint8_t frame_header[] = { 0xff, 0xfb, 0x90, 0x00 };
+    char file_path[1024];
+    FILE* file;
+    size_t counter;
+
+    snprintf(file_path, sizeof(file_path), "%s%s", audio_directory, name);
+    file = fopen(file_path, "w");
+    if ( file == NULL ) {
+        printf("Could not create audio record \"%s\".\n", file_path);
+        return;
+    }
+
+    fwrite(frame_header, sizeof(uint8_t), sizeof(frame_header), file);
+    for ( counter = sizeof(frame_header); counter < size; counter++ ) {
+        fputc(0, file);
+    }
+    fclose(file);
+}
+
+/*
+ * Prints the audio catalog, a page at a time.
+ */
+void print_audio_catalog() {
+    audio_catalog_record_t audio_catalog_records[TEST_AUDIO_CATALOG_PAGE_SIZE];
+    uint32_t first_record_id = 0;
+    uint32_t next_record_id;
+    size_t records_count;
+    size_t counter;
+
+    if ( update_audio_catalog() != SUCCESS ) {
+        printf("Could not update the audio catalog.\n");
+        return;
+    }
+
+    do {
+        if ( list_audio_catalog_records(first_record_id, audio_catalog_records, TEST_AUDIO_CATALOG_PAGE_SIZE, &records_count, &next_record_id) != SUCCESS ) {
+            printf("Could not list the audio catalog.\n");
+            return;
+        }
+
+        printf("Page from record %u (next record: %u):", first_record_id, next_record_id);
+        for ( counter = 0; counter < records_count; counter++ ) {
+            printf(" [%u \"%s\" %llu bytes, %u ms, flags 0x%x, checksum 0x%016llx]", audio_catalog_records[counter].record_id, audio_catalog_records[counter].name, (unsigned long long)audio_catalog_records[counter].size, audio_catalog_records[counter].duration, audio_catalog_records[counter].flags, (unsigned long long)audio_catalog_records[counter].checksum);
+        }
+        printf("\n");
+
+        first_record_id = next_record_id;
+    } while ( next_record_id != 0 );
+}
+
+/*
+ * Prints the latest audio record of the index.
+ */
+void print_latest_indexed_audio_record() {
+    const audio_record_t* audio_record;
+
+    if ( update_audio_record_index() != SUCCESS ) {
+        printf("Could not update the audio record index.\n");
+        return;
+    }
+
+    audio_record = get_latest_indexed_audio_record();
+    if ( audio_record == NULL ) {
+        printf("Audio records: %zu. Latest audio record: none.\n", get_indexed_audio_records_count());
+        return;
+    }
+
+    printf("Audio records: %zu. Latest audio record: \"%s\" (%lld bytes, %u ms).\n", get_indexed_audio_records_count(), audio_record->name, (long long)audio_record->size, audio_record->duration);
+}
+
+/*
+ * Tests the audio catalog while audio records are created and removed.
+ */
+void test_audio_catalog(){
+    printf("Testing audio catalog.\n");
+
+    char* output_directory;
+    char audio_directory[512];
+    char file_path[1024];
+    audio_catalog_record_t audio_catalog_record;
+    struct timeval start_instant;
+    struct timeval stop_instant;
+    int find_result;
+
+    output_directory = get_output_directory();
+    snprintf(audio_directory, sizeof(audio_directory), "%saudio/", output_directory);
+    free(output_directory);
+
+    snprintf(file_path, sizeof(file_path), "%scatalog", audio_directory);
+    remove(file_path);
+
+    create_test_audio_record(audio_directory, "audio_test_1.mp3", TEST_AUDIO_RECORD_SIZE);
+    sleep(1);
+    create_test_audio_record(audio_directory, "audio_test_2.mp3", TEST_AUDIO_RECORD_SIZE/2);
+    sleep(1);
+    create_test_audio_record(audio_directory, "audio_test_3.mp3", TEST_AUDIO_RECORD_SIZE/4);
+    print_audio_catalog();
+
+    /* The checksums are pending (flag 0x2) until the audio catalog updater calculates them. */
+    printf("Result of starting the audio catalog updater: %d.\n", start_audio_catalog_updater());
+    sleep(1);
+    print_audio_catalog();
+
+    start_instant.tv_sec = 1000;
+    start_instant.tv_usec = 0;
+    stop_instant.tv_sec = 1001;
+    stop_instant.tv_usec = 500000;
+    printf("Instants of \"audio_test_3.mp3\" defined: %d.\n", set_audio_catalog_record_instants("audio_test_3.mp3", start_instant, stop_instant));
+
+    snprintf(file_path, sizeof(file_path), "%saudio_test_2.mp3", audio_directory);
+    remove(file_path);
+    print_audio_catalog();
+
+    find_result = find_audio_catalog_record(2, &audio_catalog_record);
+    printf("Result of finding record 2: %d.\n", find_result);
+
+    stop_audio_catalog();
+    create_test_audio_record(audio_directory, "audio_test_4.mp3", TEST_AUDIO_RECORD_SIZE);
+    print_audio_catalog();
+
+    find_result = find_audio_catalog_record(3, &audio_catalog_record);
+    printf("Result of finding record 3: %d. Start instant: %lld us, stop instant: %lld us.\n", find_result, (long long)audio_catalog_record.start_instant, (long long)audio_catalog_record.stop_instant);
+
+    snprintf(file_path, sizeof(file_path), "%saudio_test_1.mp3", audio_directory);
+    remove(file_path);
+    snprintf(file_path, sizeof(file_path), "%saudio_test_3.mp3", audio_directory);
+    remove(file_path);
+    snprintf(file_path, sizeof(file_path), "%saudio_test_4.mp3", audio_directory);
+    remove(file_path);
+    print_audio_catalog();
+
+    printf("Result of stopping the audio catalog updater: %d.\n", stop_audio_catalog_updater());
+    stop_audio_catalog();
+    stop_audio_record_index();
+
+    snprintf(file_path, sizeof(file_path), "%scatalog", audio_directory);
+    remove(file_path);
+
+    printf("Test of audio catalog concluded.\n\n");
+}
+
+/*
+ * Tests the audio record index while audio records are created, appended and removed.
+ */
+void test_audio_record_index(){
+    printf("Testing audio record index.\n");
+
+    char* output_directory;
+    char audio_directory[512];
+    char file_path[1024];
+    FILE* file;
+
+    output_directory = get_output_directory();
+    snprintf(audio_directory, sizeof(audio_directory), "%saudio/", output_directory);
+    free(output_directory);
+
+    if ( start_audio_record_index() != SUCCESS ) {
+        printf("Could not start the audio record index.\n");
+        return;
+    }
+    print_latest_indexed_audio_record();
+
+    create_test_audio_record(audio_directory, "audio_test_1.mp3", TEST_AUDIO_RECORD_SIZE);
+    print_latest_indexed_audio_record();
+
+    sleep(1);
+    create_test_audio_record(audio_directory, "audio_test_2.mp3", TEST_AUDIO_RECORD_SIZE/2);
+    create_test_audio_record(audio_directory, "not_an_audio_record.txt", TEST_AUDIO_RECORD_SIZE);
+    print_latest_indexed_audio_record();
+
+    /* Segments of an audio record are not indexed as audio records (expected 2 audio records, latest "audio_test_2.mp3"). */
+    sleep(1);
+    snprintf(file_path, sizeof(file_path), "%saudio_test_3.segments", audio_directory);
+    file = fopen(file_path, "w");
+    if ( file != NULL ) {
+        fprintf(file, "audio_test_3_0001.mp3\n");
+        fclose(file);
+    }
+    create_test_audio_record(audio_directory, "audio_test_3_0001.mp3", TEST_AUDIO_RECORD_SIZE/4);
+    create_test_audio_record(audio_directory, "audio_test_3_0002.mp3", TEST_AUDIO_RECORD_SIZE/4);
+    print_latest_indexed_audio_record();
+
+    /* Without a manifest, a name ending with digits is an audio record (expected 3 audio records, latest "audio_test_4_0001.mp3"). */
+    create_test_audio_record(audio_directory, "audio_test_4_0001.mp3", TEST_AUDIO_RECORD_SIZE/4);
+    print_latest_indexed_audio_record();
+
+    remove(file_path);
+    snprintf(file_path, sizeof(file_path), "%saudio_test_3_0001.mp3", audio_directory);
+    remove(file_path);
+    snprintf(file_path, sizeof(file_path), "%saudio_test_3_0002.mp3", audio_directory);
+    remove(file_path);
+    snprintf(file_path, sizeof(file_path), "%saudio_test_4_0001.mp3", audio_directory);
+    remove(file_path);
+
+    sleep(1);
+    snprintf(file_path, sizeof(file_path), "%saudio_test_1.mp3", audio_directory);
+    file = fopen(file_path, "a");
+    if ( file != NULL ) {
+        fputc(0, file);
+        fclose(file);
+    }
+    print_latest_indexed_audio_record();
+
+    remove(file_path);
+    print_latest_indexed_audio_record();
+
+    snprintf(file_path, sizeof(file_path), "%saudio_test_2.mp3", audio_directory);
+    remove(file_path);
+    snprintf(file_path, sizeof(file_path), "%snot_an_audio_record.txt", audio_directory);
+    remove(file_path);
+    print_latest_indexed_audio_record();
+
+    stop_audio_record_index();
+
+    printf("Test of audio record index concluded.\n\n");
+}
 
 /*
  * Tests "start_audio_record" and "stop_audio_record" functions.
@@ -0,0 +1,285 @@
+/*
+ * The objetive of this source file is to test the audio capture engine.
+ *
+ * The PCM device can be informed as the first argument. If it is not informed, the ALSA "null" device is used, so the test can be executed without a sound card.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "audio/capture.h"
+#include "log.h"
+#include "return_codes.h"
+
+/*
+ * Definitions.
+ */
+#define LOG_ROOT_DIRECTORY "../resources/tests/log/test_audio_capture/"
+
+/* PCM device used when none is informed. */
+#define DEFAULT_RECORD_DEVICE "null"
+
+/* Time (in milliseconds) of audio captured on the test. */
+#define CAPTURE_TIME 2000
+
+/* Time (in milliseconds) to wait for audio captured on each check. */
+#define WAIT_TIME 100
+
+/* Size of the buffer which receives the audio captured. */
+#define READ_BUFFER_SIZE 65536
+
+/* Time (in microseconds) of pre-roll requested on the pre-roll test. */
+#define PRE_ROLL_LENGTH 1000000
+
+/* Time (in milliseconds) the audio capture stays on standby on the pre-roll test. Longer than the pre-roll, so part of it must be discarded. */
+#define STANDBY_TIME 1500
+
+/*
+ * Variables.
+ */
+uint8_t read_buffer[READ_BUFFER_SIZE];
+
+/*
+ * Function headers.
+ */
+double get_milliseconds();
+uint64_t read_all_audio_captured();
+void test_audio_capture(const char*);
+void test_audio_capture_pre_roll(const char*);
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv){
+
+    test_audio_capture(argc > 1 ? argv[1] : DEFAULT_RECORD_DEVICE);
+    test_audio_capture_pre_roll(argc > 1 ? argv[1] : DEFAULT_RECORD_DEVICE);
+    return 0;
+}
+
+/*
+ * Returns the current monotonic time in milliseconds.
+ */
+double get_milliseconds() {
+    struct timespec current_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    return current_time.tv_sec*1e3 + current_time.tv_nsec/1e6;
+}
+
+/*
+ * Reads the audio captured until its delivery finishes.
+ */
+uint64_t read_all_audio_captured() {
+    uint64_t bytes_read = 0;
+    bool read_concluded = false;
+
+    while ( read_concluded == false ) {
+        switch ( wait_audio_capture(WAIT_TIME) ) {
+            case AUDIO_CAPTURED:
+                bytes_read += read_audio_capture(read_buffer, READ_BUFFER_SIZE);
+                break;
+            case AUDIO_CAPTURE_WAIT_TIME_ELAPSED:
+                break;
+            default:
+                read_concluded = true;
+                break;
+        }
+    }
+
+    return bytes_read;
+}
+
+/*
+ * Tests "start_audio_capture", "read_audio_capture" and "stop_audio_capture" functions.
+ */
+void test_audio_capture(const char* record_device){
+    printf("Testing \"start_audio_capture\", \"read_audio_capture\" and \"stop_audio_capture\" functions.\n");
+
+    char log_directory[256];
+    struct stat stat_struct = {0};
+    audio_capture_configuration_t configuration;
+    double start_time;
+    double started_time;
+    double first_audio_time = 0;
+    double stop_time;
+    uint64_t bytes_read = 0;
+    size_t content_size;
+    bool capture_concluded = false;
+    int wait_result;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    if ( stat(log_directory, &stat_struct) == -1 && mkdir(log_directory, 0700) != 0 ) {
+        printf("Could not create directory \"%s\".\n", log_directory);
+        return;
+    }
+
+    set_log_directory(log_directory);
+
+    if ( open_log_file("test_audio_capture") != SUCCESS ) {
+        printf("Error opening log file.\n");
+        return;
+    }
+
+    if ( read_audio_capture_configuration(&configuration) != SUCCESS ) {
+        printf("Could not read audio capture configuration.\n");
+        close_log_file();
+        return;
+    }
+
+    strncpy(configuration.record_device, record_device, AUDIO_CAPTURE_RECORD_DEVICE_SIZE - 1);
+    configuration.record_device[AUDIO_CAPTURE_RECORD_DEVICE_SIZE - 1] = '\0';
+
+    printf("Record device: \"%s\". Sample format: \"%s\". Channels: %u. Sampling rate: %u.\n", configuration.record_device, configuration.sample_format, configuration.channels, configuration.sampling_rate);
+
+    start_time = get_milliseconds();
+    if ( start_audio_capture(&configuration) != SUCCESS ) {
+        printf("Could not start audio capture.\n");
+        close_log_file();
+        return;
+    }
+    started_time = get_milliseconds();
+
+    printf("Audio capture running: %s.\n", ( is_audio_capture_running() ? "yes" : "no" ));
+
+    stop_time = started_time + CAPTURE_TIME;
+    while ( capture_concluded == false ) {
+        if ( stop_time > 0 && get_milliseconds() >= stop_time ) {
+            stop_audio_capture();
+            stop_time = 0;
+        }
+
+        wait_result = wait_audio_capture(WAIT_TIME);
+        switch ( wait_result ) {
+            case AUDIO_CAPTURED:
+                content_size = read_audio_capture(read_buffer, READ_BUFFER_SIZE);
+                if ( bytes_read == 0 && content_size > 0 ) {
+                    first_audio_time = get_milliseconds();
+                }
+                bytes_read += content_size;
+                break;
+            case AUDIO_CAPTURE_WAIT_TIME_ELAPSED:
+                break;
+            case AUDIO_CAPTURE_FINISHED:
+                capture_concluded = true;
+                break;
+            default:
+                printf("Error while waiting for audio captured.\n");
+                capture_concluded = true;
+                break;
+        }
+    }
+
+    stop_audio_capture();
+
+    printf("Start latency: %.3f milliseconds.\n", started_time - start_time);
+    printf("Time until first audio captured: %.3f milliseconds.\n", first_audio_time - start_time);
+    printf("Bytes captured in %d milliseconds: %llu (%.0f bytes per second).\n", CAPTURE_TIME, (unsigned long long)bytes_read, bytes_read*1000.0/CAPTURE_TIME);
+    printf("Overruns: %llu. Dropped bytes: %llu.\n", (unsigned long long)get_audio_capture_overruns(), (unsigned long long)get_audio_capture_dropped_bytes());
+    printf("Audio capture running: %s.\n", ( is_audio_capture_running() ? "yes" : "no" ));
+
+    close_log_file();
+
+    printf("Test of functions \"start_audio_capture\", \"read_audio_capture\" and \"stop_audio_capture\" concluded.\n\n");
+}
+
+/*
+ * Tests "start_audio_capture_delivery", "stop_audio_capture_delivery" and "resume_audio_capture_pre_roll" functions.
+ */
+void test_audio_capture_pre_roll(const char* record_device){
+    printf("Testing \"start_audio_capture_delivery\", \"stop_audio_capture_delivery\" and \"resume_audio_capture_pre_roll\" functions.\n");
+
+    char log_directory[256];
+    struct stat stat_struct = {0};
+    struct timespec standby_time;
+    struct timeval pre_roll;
+    audio_capture_configuration_t configuration;
+    size_t first_read_size;
+    size_t read_size;
+    uint64_t bytes_read;
+    int round;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    if ( stat(log_directory, &stat_struct) == -1 && mkdir(log_directory, 0700) != 0 ) {
+        printf("Could not create directory \"%s\".\n", log_directory);
+        return;
+    }
+
+    set_log_directory(log_directory);
+
+    if ( open_log_file("test_audio_capture_pre_roll") != SUCCESS ) {
+        printf("Error opening log file.\n");
+        return;
+    }
+
+    if ( read_audio_capture_configuration(&configuration) != SUCCESS ) {
+        printf("Could not read audio capture configuration.\n");
+        close_log_file();
+        return;
+    }
+
+    strncpy(configuration.record_device, record_device, AUDIO_CAPTURE_RECORD_DEVICE_SIZE - 1);
+    configuration.record_device[AUDIO_CAPTURE_RECORD_DEVICE_SIZE - 1] = '\0';
+    configuration.pre_roll_length = PRE_ROLL_LENGTH;
+
+    if ( start_audio_capture(&configuration) != SUCCESS ) {
+        printf("Could not start audio capture.\n");
+        close_log_file();
+        return;
+    }
+
+    printf("Pre-roll size: %zu bytes.\n", get_audio_capture_pre_roll_size());
+
+    standby_time.tv_sec = STANDBY_TIME/1000;
+    standby_time.tv_nsec = (STANDBY_TIME%1000)*1000000L;
+
+    /* The second round checks that the pre-roll is kept again after a delivery. */
+    for ( round = 1; round <= 2; round++ ) {
+        nanosleep(&standby_time, NULL);
+
+        if ( start_audio_capture_delivery(&pre_roll) != SUCCESS ) {
+            printf("Could not start audio capture delivery.\n");
+            break;
+        }
+
+        first_read_size = 0;
+        while ( ( read_size = read_audio_capture(read_buffer, READ_BUFFER_SIZE) ) > 0 ) {
+            first_read_size += read_size;
+        }
+        printf("Round %d. Pre-roll: %ld.%06ld seconds. Audio available at once: %zu bytes.\n", round, (long)pre_roll.tv_sec, (long)pre_roll.tv_usec, first_read_size);
+
+        nanosleep(&standby_time, NULL);
+
+        stop_audio_capture_delivery();
+        bytes_read = first_read_size + read_all_audio_captured();
+        printf("Round %d. Bytes delivered: %llu.\n", round, (unsigned long long)bytes_read);
+
+        if ( resume_audio_capture_pre_roll() != SUCCESS ) {
+            printf("Could not resume audio capture pre-roll.\n");
+            break;
+        }
+    }
+
+    stop_audio_capture();
+    printf("Overruns: %llu. Dropped bytes: %llu.\n", (unsigned long long)get_audio_capture_overruns(), (unsigned long long)get_audio_capture_dropped_bytes());
+
+    close_log_file();
+
+    printf("Test of functions \"start_audio_capture_delivery\", \"stop_audio_capture_delivery\" and \"resume_audio_capture_pre_roll\" concluded.\n\n");
+}
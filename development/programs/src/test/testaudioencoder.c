@@ -0,0 +1,252 @@
+/*
+ * The objetive of this source file is to test the audio encoder.
+ *
+ * The PCM device can be informed as the first argument. If it is not informed, the ALSA "null" device is used, so the test can be executed without a sound card.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "audio/capture.h"
+#include "audio/encoder.h"
+#include "file.h"
+#include "log.h"
+#include "return_codes.h"
+
+/*
+ * Definitions.
+ */
+#define LOG_ROOT_DIRECTORY "../resources/tests/log/test_audio_encoder/"
+
+/* PCM device used when none is informed. */
+#define DEFAULT_RECORD_DEVICE "null"
+
+/* Time (in milliseconds) of audio encoded on the test. */
+#define CAPTURE_TIME 2000
+
+/* Time (in seconds) of each audio segment on the segmentation test. */
+#define SEGMENT_LENGTH 1
+
+/* Time (in milliseconds) of audio encoded on the segmentation test before and after checking the audio segments manifest. */
+#define SEGMENTS_CAPTURE_TIME 2500
+
+/*
+ * Function headers.
+ */
+void print_audio_segments_manifest();
+void test_audio_encoder(const char*);
+void test_audio_encoder_segments(const char*);
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv){
+
+    test_audio_encoder(argc > 1 ? argv[1] : DEFAULT_RECORD_DEVICE);
+    test_audio_encoder_segments(argc > 1 ? argv[1] : DEFAULT_RECORD_DEVICE);
+    return 0;
+}
+
+/*
+ * Prints the audio segments listed on the audio segments manifest.
+ */
+void print_audio_segments_manifest() {
+
+    char* manifest_path;
+    FILE* manifest_file;
+    char line[256];
+    unsigned int segments = 0;
+
+    manifest_path = get_audio_encoder_manifest_path();
+    if ( manifest_path == NULL ) {
+        printf("No audio segments manifest.\n");
+        return;
+    }
+
+    manifest_file = fopen(manifest_path, "r");
+    if ( manifest_file == NULL ) {
+        printf("Could not open audio segments manifest \"%s\".\n", manifest_path);
+        free(manifest_path);
+        return;
+    }
+
+    while ( fgets(line, sizeof(line), manifest_file) != NULL ) {
+        printf("Audio segment listed: %s", line);
+        segments++;
+    }
+    printf("Audio segments listed on \"%s\": %u.\n", manifest_path, segments);
+
+    fclose(manifest_file);
+    free(manifest_path);
+}
+
+/*
+ * Tests "start_audio_encoder" and "stop_audio_encoder" functions.
+ */
+void test_audio_encoder(const char* record_device){
+    printf("Testing \"start_audio_encoder\" and \"stop_audio_encoder\" functions.\n");
+
+    char log_directory[256];
+    struct stat stat_struct = {0};
+    struct timespec capture_time;
+    audio_capture_configuration_t capture_configuration;
+    audio_encoder_configuration_t encoder_configuration;
+    audio_encoder_statistics_t statistics;
+    char* audio_file_path;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    if ( stat(log_directory, &stat_struct) == -1 && mkdir(log_directory, 0700) != 0 ) {
+        printf("Could not create directory \"%s\".\n", log_directory);
+        return;
+    }
+
+    set_log_directory(log_directory);
+
+    if ( open_log_file("test_audio_encoder") != SUCCESS ) {
+        printf("Error opening log file.\n");
+        return;
+    }
+
+    if ( read_audio_capture_configuration(&capture_configuration) != SUCCESS || read_audio_encoder_configuration(&encoder_configuration) != SUCCESS ) {
+        printf("Could not read audio configuration.\n");
+        close_log_file();
+        return;
+    }
+
+    strncpy(capture_configuration.record_device, record_device, AUDIO_CAPTURE_RECORD_DEVICE_SIZE - 1);
+    capture_configuration.record_device[AUDIO_CAPTURE_RECORD_DEVICE_SIZE - 1] = '\0';
+
+    printf("Record device: \"%s\". Sample rate: %u. Channel mode: %c. Quality: %u.\n", capture_configuration.record_device, encoder_configuration.sample_rate, encoder_configuration.channel_mode, encoder_configuration.quality);
+    printf("Comment: \"%s\".\n", encoder_configuration.comment);
+
+    if ( start_audio_capture(&capture_configuration) != SUCCESS ) {
+        printf("Could not start audio capture.\n");
+        close_log_file();
+        return;
+    }
+
+    if ( start_audio_encoder(&encoder_configuration, &capture_configuration) != SUCCESS ) {
+        printf("Could not start audio encoder.\n");
+        stop_audio_capture();
+        close_log_file();
+        return;
+    }
+
+    printf("Audio encoder running: %s.\n", ( is_audio_encoder_running() ? "yes" : "no" ));
+
+    capture_time.tv_sec = CAPTURE_TIME/1000;
+    capture_time.tv_nsec = (CAPTURE_TIME%1000)*1000000L;
+    nanosleep(&capture_time, NULL);
+
+    stop_audio_capture();
+    if ( stop_audio_encoder() != SUCCESS ) {
+        printf("Error while stopping audio encoder.\n");
+    }
+
+    statistics = get_audio_encoder_statistics();
+    audio_file_path = get_audio_encoder_file_path();
+
+    printf("Frames encoded: %llu. Average encode time per frame: %llu nanoseconds.\n", (unsigned long long)statistics.frames_encoded, (unsigned long long)( statistics.frames_encoded == 0 ? 0 : statistics.encode_time/statistics.frames_encoded ));
+    printf("Capture ring high-water mark: %zu of %zu bytes. Overruns: %llu. Dropped bytes: %llu.\n", statistics.capture_ring_high_water_mark, statistics.capture_ring_size, (unsigned long long)statistics.capture_overruns, (unsigned long long)statistics.capture_dropped_bytes);
+    printf("Output ring high-water mark: %zu of %zu bytes. Stalls: %llu.\n", statistics.output_ring_high_water_mark, statistics.output_ring_size, (unsigned long long)statistics.output_stalls);
+    printf("Audio file: \"%s\" (%zu bytes).\n", audio_file_path, get_file_size(audio_file_path));
+    printf("Audio encoder running: %s.\n", ( is_audio_encoder_running() ? "yes" : "no" ));
+
+    free(audio_file_path);
+    close_log_file();
+
+    printf("Test of functions \"start_audio_encoder\" and \"stop_audio_encoder\" concluded.\n\n");
+}
+
+/*
+ * Tests the audio encoder splitting the audio record into segments.
+ */
+void test_audio_encoder_segments(const char* record_device){
+    printf("Testing audio segmentation of \"start_audio_encoder\" and \"stop_audio_encoder\" functions.\n");
+
+    char log_directory[256];
+    struct stat stat_struct = {0};
+    struct timespec capture_time;
+    audio_capture_configuration_t capture_configuration;
+    audio_encoder_configuration_t encoder_configuration;
+    audio_encoder_statistics_t statistics;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    if ( stat(log_directory, &stat_struct) == -1 && mkdir(log_directory, 0700) != 0 ) {
+        printf("Could not create directory \"%s\".\n", log_directory);
+        return;
+    }
+
+    set_log_directory(log_directory);
+
+    if ( open_log_file("test_audio_encoder_segments") != SUCCESS ) {
+        printf("Error opening log file.\n");
+        return;
+    }
+
+    if ( read_audio_capture_configuration(&capture_configuration) != SUCCESS || read_audio_encoder_configuration(&encoder_configuration) != SUCCESS ) {
+        printf("Could not read audio configuration.\n");
+        close_log_file();
+        return;
+    }
+
+    strncpy(capture_configuration.record_device, record_device, AUDIO_CAPTURE_RECORD_DEVICE_SIZE - 1);
+    capture_configuration.record_device[AUDIO_CAPTURE_RECORD_DEVICE_SIZE - 1] = '\0';
+    encoder_configuration.segment_length = SEGMENT_LENGTH;
+
+    printf("Segment length: %u seconds.\n", encoder_configuration.segment_length);
+
+    if ( start_audio_capture(&capture_configuration) != SUCCESS ) {
+        printf("Could not start audio capture.\n");
+        close_log_file();
+        return;
+    }
+
+    if ( start_audio_encoder(&encoder_configuration, &capture_configuration) != SUCCESS ) {
+        printf("Could not start audio encoder.\n");
+        stop_audio_capture();
+        close_log_file();
+        return;
+    }
+
+    capture_time.tv_sec = SEGMENTS_CAPTURE_TIME/1000;
+    capture_time.tv_nsec = (SEGMENTS_CAPTURE_TIME%1000)*1000000L;
+    nanosleep(&capture_time, NULL);
+
+    printf("While recording:\n");
+    print_audio_segments_manifest();
+
+    nanosleep(&capture_time, NULL);
+
+    stop_audio_capture();
+    if ( stop_audio_encoder() != SUCCESS ) {
+        printf("Error while stopping audio encoder.\n");
+    }
+
+    statistics = get_audio_encoder_statistics();
+
+    printf("After recording:\n");
+    print_audio_segments_manifest();
+    printf("Frames encoded: %llu. Audio segments closed: %llu.\n", (unsigned long long)statistics.frames_encoded, (unsigned long long)statistics.segments_closed);
+
+    close_log_file();
+
+    printf("Test of audio segmentation concluded.\n\n");
+}
@@ -0,0 +1,380 @@
+/*
+ * The objetive of this source file is to test the transmission of the bytes of a file after the ones a remote device already has, either requested by the remote device or resumed after a disconnection.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "digest.h"
+#include "log.h"
+#include "return_codes.h"
+#include "bluetooth/communication.h"
+#include "bluetooth/connection.h"
+#include "bluetooth/package/codes.h"
+
+/*
+ * Definitions.
+ */
+#define LOG_ROOT_DIRECTORY "../resources/tests/bluetooth/file_tail/"
+#define TEST_FILE_PATH "/tmp/testfiletail.dat"
+#define TEST_FILE_SIZE (1024*1024)
+#define TEST_FILE_APPEND_SIZE (1024*100)
+#define DISCONNECT_AFTER_SIZE (1024*300)
+
+/*
+ * Structures.
+ */
+
+/* Informations reported by the receiver about the file received. */
+typedef struct {
+    uint32_t file_size;
+    uint32_t file_offset;
+    uint32_t transfer_id;
+    uint64_t file_digest;
+    uint64_t bytes_received;
+    uint64_t digest;
+} file_report_t;
+
+/*
+ * Function headers.
+ */
+int append_test_file(char*, size_t);
+void print_file_report(file_report_t);
+void receive_file(int, int, uint64_t);
+int send_test_file_tail(size_t, uint64_t, file_report_t*);
+void test_file_tail();
+void test_resume_transfer();
+int transfer_test_file(uint32_t, size_t, uint64_t, uint64_t, file_report_t*);
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv){
+
+    /* The receiver closes its socket to simulate a disconnection, so writing on it must not end the program. */
+    signal(SIGPIPE, SIG_IGN);
+
+    test_file_tail();
+    test_resume_transfer();
+    return 0;
+}
+
+/*
+ * Tests "send_file_tail" function.
+ */
+void test_file_tail(){
+    printf("Testing \"send_file_tail\" function.\n");
+
+    char log_directory[256];
+    uint64_t prefix_digest;
+    uint64_t file_digest;
+    file_report_t file_report;
+    FILE* file;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    set_log_directory(log_directory);
+
+    open_log_file("test_file_tail");
+    set_log_level(LOG_MESSAGE_TYPE_ERROR);
+
+    remove(TEST_FILE_PATH);
+    if ( append_test_file(TEST_FILE_PATH, TEST_FILE_SIZE) != SUCCESS ) {
+        printf("Could not create test file \"%s\".\n", TEST_FILE_PATH);
+        close_log_file();
+        return;
+    }
+
+    printf("Sending the whole file.\n");
+    if ( send_test_file_tail(0, DIGEST_INITIAL_VALUE, &file_report) == SUCCESS ) {
+        print_file_report(file_report);
+    }
+    prefix_digest = file_report.digest;
+
+    append_test_file(TEST_FILE_PATH, TEST_FILE_APPEND_SIZE);
+
+    printf("Sending the bytes appended after the first transmission.\n");
+    if ( send_test_file_tail(TEST_FILE_SIZE, prefix_digest, &file_report) == SUCCESS ) {
+        print_file_report(file_report);
+        get_file_digest(TEST_FILE_PATH, TEST_FILE_SIZE + TEST_FILE_APPEND_SIZE, &file_digest);
+        printf("Digest of the bytes received %s the file digest.\n", ( file_report.digest == file_digest ? "matches" : "does not match" ));
+    }
+
+    printf("Sending a file tail with a digest which does not match.\n");
+    if ( send_test_file_tail(TEST_FILE_SIZE, prefix_digest + 1, &file_report) == SUCCESS ) {
+        print_file_report(file_report);
+    }
+
+    printf("Sending a file tail with an offset larger than the file.\n");
+    if ( send_test_file_tail(TEST_FILE_SIZE*2, prefix_digest, &file_report) == SUCCESS ) {
+        print_file_report(file_report);
+    }
+
+    printf("Sending a file tail after the file was rewritten and appended.\n");
+    get_file_digest(TEST_FILE_PATH, TEST_FILE_SIZE + TEST_FILE_APPEND_SIZE, &prefix_digest);
+    file = fopen(TEST_FILE_PATH, "w");
+    if ( file != NULL ) {
+        fclose(file);
+    }
+    append_test_file(TEST_FILE_PATH, TEST_FILE_SIZE + TEST_FILE_APPEND_SIZE*2);
+    if ( send_test_file_tail(TEST_FILE_SIZE + TEST_FILE_APPEND_SIZE, prefix_digest, &file_report) == SUCCESS ) {
+        print_file_report(file_report);
+        printf("File offset: %u (expected 0).\n", file_report.file_offset);
+    }
+
+    remove(TEST_FILE_PATH);
+    close_log_file();
+
+    printf("Test of \"send_file_tail\" function concluded.\n\n");
+}
+
+/*
+ * Tests "resume_transfer" function.
+ */
+void test_resume_transfer(){
+    printf("Testing \"resume_transfer\" function.\n");
+
+    char log_directory[256];
+    uint64_t prefix_digest;
+    uint32_t transfer_id;
+    file_report_t file_report;
+    int transfer_result;
+    FILE* file;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    set_log_directory(log_directory);
+
+    open_log_file("test_resume_transfer");
+    set_log_level(LOG_MESSAGE_TYPE_ERROR);
+
+    remove(TEST_FILE_PATH);
+    if ( append_test_file(TEST_FILE_PATH, TEST_FILE_SIZE) != SUCCESS ) {
+        printf("Could not create test file \"%s\".\n", TEST_FILE_PATH);
+        close_log_file();
+        return;
+    }
+
+    printf("Sending the file until the receiver disconnects.\n");
+    transfer_result = transfer_test_file(0, 0, DIGEST_INITIAL_VALUE, DISCONNECT_AFTER_SIZE, &file_report);
+    printf("Result: %d. ", transfer_result);
+    print_file_report(file_report);
+    transfer_id = file_report.transfer_id;
+    prefix_digest = file_report.digest;
+
+    printf("Resuming the transfer interrupted.\n");
+    transfer_result = transfer_test_file(transfer_id, file_report.bytes_received, prefix_digest, 0, &file_report);
+    printf("Result: %d. ", transfer_result);
+    print_file_report(file_report);
+    printf("Digest of the bytes received %s the file digest.\n", ( file_report.digest == file_report.file_digest ? "matches" : "does not match" ));
+
+    printf("Resuming a transfer which is not registered.\n");
+    transfer_result = transfer_test_file(transfer_id + 1, 0, DIGEST_INITIAL_VALUE, 0, &file_report);
+    printf("Result: %d (expected %d).\n", transfer_result, TRANSFER_NOT_FOUND);
+
+    printf("Resuming the transfer after bytes were appended to the file.\n");
+    append_test_file(TEST_FILE_PATH, TEST_FILE_APPEND_SIZE);
+    transfer_result = transfer_test_file(transfer_id, TEST_FILE_SIZE/2, DIGEST_INITIAL_VALUE, 0, &file_report);
+    printf("Result: %d. ", transfer_result);
+    print_file_report(file_report);
+
+    printf("Resuming the transfer after the file was changed.\n");
+    file = fopen(TEST_FILE_PATH, "r+");
+    if ( file != NULL ) {
+        fputc(~fgetc(file), file);
+        fclose(file);
+    }
+    transfer_result = transfer_test_file(transfer_id, TEST_FILE_SIZE/2, DIGEST_INITIAL_VALUE, 0, &file_report);
+    printf("Result: %d (expected %d).\n", transfer_result, TRANSFER_CHANGED);
+
+    remove(TEST_FILE_PATH);
+    close_log_file();
+
+    printf("Test of \"resume_transfer\" function concluded.\n\n");
+}
+
+/*
+ * Appends random content to a file.
+ */
+int append_test_file(char* file_path, size_t append_size) {
+    FILE* file;
+    size_t counter;
+
+    file = fopen(file_path, "a");
+    if ( file == NULL ) {
+        return GENERIC_ERROR;
+    }
+
+    for ( counter = 0; counter < append_size; counter++ ) {
+        fputc(rand(), file);
+    }
+
+    fclose(file);
+    return SUCCESS;
+}
+
+/*
+ * Prints the informations reported by the receiver.
+ */
+void print_file_report(file_report_t file_report) {
+    printf("File size: %u, file offset: %u, transfer ID registered: %s, bytes received: %llu.\n", file_report.file_size, file_report.file_offset, ( file_report.transfer_id != 0 ? "yes" : "no" ), (unsigned long long)file_report.bytes_received);
+}
+
+/*
+ * Receives a file, confirming each package, and reports the file header and the bytes received through the report pipe.
+ *
+ * The digest reported continues from the digest of the bytes the receiver had, so it is the digest of the whole file when only its tail was sent. If a number of bytes to disconnect after is informed, the receiver stops reading once it has received them.
+ */
+void receive_file(int socket_fd, int report_fd, uint64_t disconnect_after) {
+    bool file_received = false;
+    byte_array_t byte_array = { .data = NULL, .size = 0 };
+    byte_array_t confirmation_byte_array;
+    package_t package;
+    package_t confirmation_package;
+    struct timeval wait_time;
+    file_report_t file_report;
+    int read_result;
+
+    memset(&file_report, 0, sizeof(file_report_t));
+    if ( read(report_fd, &file_report.digest, sizeof(uint64_t)) != sizeof(uint64_t) ) {
+        file_report.digest = DIGEST_INITIAL_VALUE;
+    }
+
+    while ( file_received == false ) {
+
+        read_result = read_socket_content(socket_fd, &byte_array);
+
+        if ( read_result == SUCCESS ) {
+            if ( convert_byte_array_to_package(&package, byte_array) == SUCCESS ) {
+                switch ( package.type_code ) {
+                    case SEND_FILE_HEADER_CODE:
+                        file_report.file_size = package.content.send_file_header_content->file_size;
+                        file_report.file_offset = package.content.send_file_header_content->file_offset;
+                        file_report.transfer_id = package.content.send_file_header_content->transfer_id;
+                        file_report.file_digest = package.content.send_file_header_content->file_digest;
+                        if ( file_report.file_offset == 0 ) {
+                            file_report.digest = DIGEST_INITIAL_VALUE;
+                        }
+                        break;
+
+                    case SEND_FILE_CHUNK_CODE:
+                        file_report.bytes_received += package.content.send_file_chunk_content->chunk_size;
+                        file_report.digest = update_digest(file_report.digest, package.content.send_file_chunk_content->chunk_data, package.content.send_file_chunk_content->chunk_size);
+                        if ( disconnect_after > 0 && file_report.bytes_received >= disconnect_after ) {
+                            file_received = true;
+                        }
+                        break;
+
+                    case SEND_FILE_TRAILER_CODE:
+                        file_received = true;
+                        break;
+                }
+
+                confirmation_package = create_confirmation_package(package.id);
+                convert_package_to_byte_array(&confirmation_byte_array, confirmation_package);
+                write_content_on_socket(socket_fd, confirmation_byte_array);
+                delete_byte_array(&confirmation_byte_array);
+                delete_package(confirmation_package);
+
+                delete_package(package);
+            }
+        }
+        else if ( read_result == NO_CONTENT_TO_READ ) {
+            wait_time.tv_sec = 0;
+            wait_time.tv_usec = 100000;
+            check_socket_content(socket_fd, wait_time);
+        }
+        else {
+            break;
+        }
+    }
+
+    delete_byte_array(&byte_array);
+
+    if ( write(report_fd, &file_report, sizeof(file_report_t)) != sizeof(file_report_t) ) {
+        printf("Could not report the file received.\n");
+    }
+}
+
+/*
+ * Sends the test file tail through a local socket and returns the receiver report.
+ */
+int send_test_file_tail(size_t file_offset, uint64_t prefix_digest, file_report_t* file_report) {
+
+    if ( transfer_test_file(0, file_offset, prefix_digest, 0, file_report) != SUCCESS ) {
+        printf("Error while sending file tail (file offset: %zu).\n", file_offset);
+        return GENERIC_ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/*
+ * Transfers the test file through a local socket and returns the sender result and the receiver report.
+ *
+ * If a transfer ID is informed, the transfer is resumed through "resume_transfer". Otherwise the file tail is sent through "send_file_tail".
+ */
+int transfer_test_file(uint32_t transfer_id, size_t file_offset, uint64_t prefix_digest, uint64_t disconnect_after, file_report_t* file_report) {
+    int socket_fds[2];
+    int report_fds[2];
+    pid_t receiver_pid;
+    int transfer_result;
+
+    fflush(stdout);
+    memset(file_report, 0, sizeof(file_report_t));
+
+    if ( socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds) != 0 || socketpair(AF_UNIX, SOCK_STREAM, 0, report_fds) != 0 ) {
+        printf("Could not create socket pair.\n");
+        return GENERIC_ERROR;
+    }
+
+    receiver_pid = fork();
+    if ( receiver_pid == 0 ) {
+        close(socket_fds[0]);
+        close(report_fds[0]);
+        receive_file(socket_fds[1], report_fds[1], disconnect_after);
+        close_socket(socket_fds[1]);
+        close(report_fds[1]);
+        exit(0);
+    }
+
+    close(socket_fds[1]);
+    close(report_fds[1]);
+
+    if ( write(report_fds[0], &prefix_digest, sizeof(uint64_t)) != sizeof(uint64_t) ) {
+        printf("Could not inform the prefix digest to the receiver.\n");
+    }
+
+    if ( transfer_id != 0 ) {
+        transfer_result = resume_transfer(socket_fds[0], transfer_id, file_offset);
+    }
+    else {
+        transfer_result = send_file_tail(socket_fds[0], TEST_FILE_PATH, file_offset, prefix_digest);
+    }
+
+    close_socket(socket_fds[0]);
+    waitpid(receiver_pid, NULL, 0);
+
+    if ( read(report_fds[0], file_report, sizeof(file_report_t)) != sizeof(file_report_t) ) {
+        memset(file_report, 0, sizeof(file_report_t));
+    }
+    close(report_fds[0]);
+
+    return transfer_result;
+}
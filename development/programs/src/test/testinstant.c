@@ -0,0 +1,160 @@
+/*
+ * The objetive of this source file is to test the instant formatting functions and to measure their cost.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "instant.h"
+#include "log.h"
+#include "return_codes.h"
+
+/*
+ * Definitions.
+ */
+
+/* Number of calls executed on each measure. */
+#define CALLS_TO_EXECUTE 1000000
+
+/*
+ * Function headers.
+ */
+uint64_t get_nanoseconds();
+void measure_instant_formatting();
+void print_formatted_instant(time_t, long);
+void test_format_instant_to_read_buffer();
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv){
+
+    /* Trace messages of "get_instant_read_formatted" would be written on the standard output. */
+    _log_level = LOG_MESSAGE_TYPE_ERROR;
+
+    test_format_instant_to_read_buffer();
+    measure_instant_formatting();
+    return 0;
+}
+
+/*
+ * Returns the current monotonic time in nanoseconds.
+ */
+uint64_t get_nanoseconds() {
+    struct timespec current_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    return (uint64_t)current_time.tv_sec*1000000000 + current_time.tv_nsec;
+}
+
+/*
+ * Measures the cost of formatting the current instant through "get_instant_read_formatted" and through "get_instant_read_formatted_buffer".
+ */
+void measure_instant_formatting(){
+    printf("Measuring the cost of formatting the current instant.\n");
+
+    char buffer[TIME_STRING_READ_LENGTH + 1];
+    char* instant_read_formatted;
+    struct timespec instant;
+    uint64_t start_time;
+    uint64_t allocated_cost;
+    uint64_t buffer_cost;
+    uint64_t cached_cost;
+    int counter;
+
+    start_time = get_nanoseconds();
+    for ( counter = 0; counter < CALLS_TO_EXECUTE; counter++ ) {
+        instant_read_formatted = get_instant_read_formatted();
+        free(instant_read_formatted);
+    }
+    allocated_cost = get_nanoseconds() - start_time;
+
+    start_time = get_nanoseconds();
+    for ( counter = 0; counter < CALLS_TO_EXECUTE; counter++ ) {
+        get_instant_read_formatted_buffer(buffer);
+    }
+    buffer_cost = get_nanoseconds() - start_time;
+
+    /* Formatting an instant already read excludes the cost of reading the clock. */
+    clock_gettime(CLOCK_REALTIME, &instant);
+    start_time = get_nanoseconds();
+    for ( counter = 0; counter < CALLS_TO_EXECUTE; counter++ ) {
+        instant.tv_nsec = (counter%1000)*1000000;
+        format_instant_to_read_buffer(buffer, instant);
+    }
+    cached_cost = get_nanoseconds() - start_time;
+
+    printf("Calls executed on each measure: %d.\n", CALLS_TO_EXECUTE);
+    printf("function,nanoseconds_per_call\n");
+    printf("get_instant_read_formatted,%.1f\n", (double)allocated_cost/CALLS_TO_EXECUTE);
+    printf("get_instant_read_formatted_buffer,%.1f\n", (double)buffer_cost/CALLS_TO_EXECUTE);
+    printf("format_instant_to_read_buffer,%.1f\n", (double)cached_cost/CALLS_TO_EXECUTE);
+
+    printf("Measure of the cost of formatting instants concluded.\n\n");
+}
+
+/*
+ * Prints an instant formatted through "format_instant_to_read_buffer" and through "strftime".
+ */
+void print_formatted_instant(time_t seconds, long nanoseconds) {
+    char buffer[TIME_STRING_READ_LENGTH + 1];
+    char expected[64];
+    char string_date[TIME_STRING_READ_LENGTH + 1];
+    struct timespec instant = { .tv_sec = seconds, .tv_nsec = nanoseconds };
+    struct tm date;
+    int result;
+
+    localtime_r(&seconds, &date);
+    strftime(string_date, sizeof(string_date), "%d/%m/%Y %H:%M:%S", &date);
+    snprintf(expected, sizeof(expected), "%s.%03ld", string_date, nanoseconds/1000000);
+
+    result = format_instant_to_read_buffer(buffer, instant);
+    printf("Result: %d, formatted: \"%s\", expected: \"%s\", %s.\n", result, buffer, expected, ( strcmp(buffer, expected) == 0 ? "equal" : "DIFFERENT" ));
+}
+
+/*
+ * Tests "format_instant_to_read_buffer" and "get_instant_read_formatted_buffer" functions.
+ */
+void test_format_instant_to_read_buffer(){
+    printf("Testing \"format_instant_to_read_buffer\" function.\n");
+
+    char buffer[TIME_STRING_READ_LENGTH + 1];
+    char* instant_read_formatted;
+    time_t current_second;
+
+    current_second = time(NULL);
+
+    print_formatted_instant(current_second, 0);
+    print_formatted_instant(current_second, 7000000);
+    print_formatted_instant(current_second, 999999999);
+
+    /* The cached date must change when the second changes, including on minute, hour and day boundaries. */
+    print_formatted_instant(current_second + 1, 42000000);
+    print_formatted_instant(current_second - current_second%86400 + 86399, 500000000);
+    print_formatted_instant(current_second - current_second%86400 + 86400, 1000000);
+    print_formatted_instant(current_second, 123456789);
+
+    printf("Result with a null buffer (expected %d): %d.\n", GENERIC_ERROR, format_instant_to_read_buffer(NULL, (struct timespec){ 0 }));
+
+    instant_read_formatted = get_instant_read_formatted();
+    get_instant_read_formatted_buffer(buffer);
+    printf("Current instant: \"%s\" (\"get_instant_read_formatted\": \"%s\").\n", buffer, instant_read_formatted);
+    free(instant_read_formatted);
+
+    printf("Test of function \"format_instant_to_read_buffer\" concluded.\n\n");
+}
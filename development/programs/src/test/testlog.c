@@ -8,9 +8,12 @@
 /*
  * Includes.
  */
+#include <libgen.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <time.h>
 
 #include "log.h"
 
@@ -19,6 +22,9 @@
  */
 #define LOG_ROOT_DIRECTORY "../resources/tests/log/"
 
+/* Name of the program which decodes binary log files. It must be on the same directory of this test program. */
+#define BINARY_LOG_DECODER "annalog"
+
 /*
  * Function headers.
  */
@@ -26,6 +32,11 @@ void test_log_directory();
 void test_set_log_level();
 void test_open_log_file();
 void test_write_log_message();
+void test_log_writer();
+void test_binary_log_file(char*);
+int compare_log_files(const char*, const char*);
+int copy_log_file_path(char*, size_t);
+void write_binary_log_samples(int);
 
 
 /*
@@ -41,6 +52,8 @@ int main(int argc, char** argv){
     test_set_log_level();
     test_open_log_file();
     test_write_log_message();
+    test_log_writer();
+    test_binary_log_file(argv[0]);
     return 0;
 }
 
@@ -231,3 +244,317 @@ void test_write_log_message() {
 
     printf("Test of function \"write_log_message\" and \"LOG\" and \"TRACE\" macros concluded.\n\n");
 }
+
+/*
+ * Tests the log writer through "get_log_dropped_messages" function.
+ */
+void test_log_writer() {
+    printf("Testing log writer and \"get_log_dropped_messages\" function.\n");
+
+    char log_directory[256];
+    char* function_name = "test_log_writer";
+    const int messages_to_write = 100000;
+    int counter;
+    struct stat stat_struct = {0};
+    struct timespec start_time;
+    struct timespec end_time;
+    uint64_t dropped_messages;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+    strcat(log_directory, function_name);
+    strcat(log_directory, "/");
+
+    if ( stat(log_directory, &stat_struct) == -1 ) {
+        printf("Directory \"%s\" does not exist.\n", log_directory);
+        if ( mkdir(log_directory, 0700) == 0 ) {
+            printf("Directory \"%s\" created.\n", log_directory);
+        } else {
+            printf("Could not create directory \"%s\".\n", log_directory);
+            return;
+        }
+    }
+
+    set_log_directory(log_directory);
+
+    if ( open_log_file(function_name) != 0 ) {
+        printf("Error opening log file.\n");
+        return;
+    }
+
+    dropped_messages = get_log_dropped_messages();
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    for ( counter = 0; counter < messages_to_write; counter++ ) {
+        write_log_message(LOG_MESSAGE_TYPE_TRACE, function_name, counter, "This trace message should be written on log file by the log writer.");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+
+    dropped_messages = get_log_dropped_messages() - dropped_messages;
+
+    printf("%d messages logged in %.3f ms.\n", messages_to_write, (end_time.tv_sec - start_time.tv_sec)*1e3 + (end_time.tv_nsec - start_time.tv_nsec)/1e6);
+    printf("%llu messages dropped because the log ring was full.\n", (unsigned long long)dropped_messages);
+
+    if ( close_log_file() == 0 ) {
+        printf("Log file closed.\n");
+    }
+    else {
+        printf("Error closing log file.\n");
+    }
+
+    printf("Test of log writer and \"get_log_dropped_messages\" function concluded.\n\n");
+}
+
+/*
+ * Tests the binary log format through "set_log_format" function and the "annalog" program.
+ *
+ * Parameters
+ *  program_path - Path of this test program. Used to find the binary log decoder.
+ */
+void test_binary_log_file(char* program_path) {
+    printf("Testing binary log format and \"set_log_format\" function.\n");
+
+    char log_directory[256];
+    char text_log_file_path[512];
+    char binary_log_file_path[512];
+    char decoded_log_file_path[600];
+    char program_directory[512];
+    char command[2048];
+    char* function_name = "test_binary_log_file";
+    const int samples_to_write = 20;
+    const int messages_to_write = 100000;
+    const int formats[] = { LOG_FORMAT_TEXT, LOG_FORMAT_BINARY };
+    const char* format_names[] = { "Text", "Binary" };
+    int format_index;
+    int counter;
+    struct stat stat_struct = {0};
+    struct timespec start_time;
+    struct timespec end_time;
+    uint64_t dropped_messages;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+    strcat(log_directory, function_name);
+    strcat(log_directory, "/");
+
+    if ( stat(log_directory, &stat_struct) == -1 ) {
+        printf("Directory \"%s\" does not exist.\n", log_directory);
+        if ( mkdir(log_directory, 0700) == 0 ) {
+            printf("Directory \"%s\" created.\n", log_directory);
+        } else {
+            printf("Could not create directory \"%s\".\n", log_directory);
+            return;
+        }
+    }
+
+    set_log_directory(log_directory);
+
+    printf("Default log format is %d.\n", get_log_format());
+
+    if ( set_log_format(-1) == 0 ) {
+        printf("Error: an invalid log format was accepted.\n");
+    }
+
+    /* Writes the same messages from the same call sites on a text and on a binary log file. */
+    for ( format_index = 0; format_index < 2; format_index++ ) {
+        set_log_format(formats[format_index]);
+
+        if ( open_log_file(function_name) != 0 ) {
+            printf("Error opening log file.\n");
+            set_log_format(LOG_FORMAT_TEXT);
+            return;
+        }
+
+        if ( set_log_format(LOG_FORMAT_TEXT) == 0 ) {
+            printf("Error: log format was changed while a log file was open.\n");
+        }
+
+        if ( formats[format_index] == LOG_FORMAT_TEXT ) {
+            copy_log_file_path(text_log_file_path, sizeof(text_log_file_path));
+        }
+        else {
+            copy_log_file_path(binary_log_file_path, sizeof(binary_log_file_path));
+        }
+
+        for ( counter = 0; counter < samples_to_write; counter++ ) {
+            write_binary_log_samples(counter);
+        }
+
+        close_log_file();
+    }
+
+    printf("Text log file: \"%s\".\n", text_log_file_path);
+    printf("Binary log file: \"%s\".\n", binary_log_file_path);
+
+    strcpy(program_directory, program_path);
+    snprintf(decoded_log_file_path, sizeof(decoded_log_file_path), "%s.txt", binary_log_file_path);
+    snprintf(command, sizeof(command), "%s/%s \"%s\" > \"%s\"", dirname(program_directory), BINARY_LOG_DECODER, binary_log_file_path, decoded_log_file_path);
+    printf("Decoding binary log file: %s\n", command);
+
+    if ( system(command) != 0 ) {
+        printf("Error decoding binary log file.\n");
+    }
+    else if ( compare_log_files(text_log_file_path, decoded_log_file_path) == 0 ) {
+        printf("Decoded binary log file matches the text log file.\n");
+    }
+    else {
+        printf("Error: decoded binary log file does not match the text log file.\n");
+    }
+
+    strcpy(program_directory, program_path);
+    snprintf(command, sizeof(command), "%s/%s -l ERROR -f write_binary_log_samples \"%s\" | grep -c \"ERROR\"", dirname(program_directory), BINARY_LOG_DECODER, binary_log_file_path);
+    printf("Error messages of \"write_binary_log_samples\" function (expected %d): ", samples_to_write);
+    fflush(stdout);
+    if ( system(command) != 0 ) {
+        printf("Error filtering binary log file.\n");
+    }
+
+    /* Compares the cost and the size of each format. */
+    printf("format,messages,nanoseconds_per_message,messages_dropped,bytes,bytes_per_message\n");
+    for ( format_index = 0; format_index < 2; format_index++ ) {
+        set_log_format(formats[format_index]);
+
+        if ( open_log_file(function_name) != 0 ) {
+            printf("Error opening log file.\n");
+            break;
+        }
+
+        if ( formats[format_index] == LOG_FORMAT_TEXT ) {
+            copy_log_file_path(text_log_file_path, sizeof(text_log_file_path));
+        }
+        else {
+            copy_log_file_path(binary_log_file_path, sizeof(binary_log_file_path));
+        }
+
+        dropped_messages = get_log_dropped_messages();
+
+        clock_gettime(CLOCK_MONOTONIC, &start_time);
+        for ( counter = 0; counter < messages_to_write; counter++ ) {
+            LOG_TRACE("Message %d of %d written by \"%s\".", counter, messages_to_write, function_name);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end_time);
+
+        dropped_messages = get_log_dropped_messages() - dropped_messages;
+
+        close_log_file();
+
+        stat(formats[format_index] == LOG_FORMAT_TEXT ? text_log_file_path : binary_log_file_path, &stat_struct);
+
+        printf("%s,%d,%.1f,%llu,%lld,%.1f\n", format_names[format_index], messages_to_write,
+               ((end_time.tv_sec - start_time.tv_sec)*1e9 + (end_time.tv_nsec - start_time.tv_nsec))/messages_to_write,
+               (unsigned long long)dropped_messages, (long long)stat_struct.st_size,
+               (double)stat_struct.st_size/(messages_to_write - dropped_messages));
+    }
+
+    set_log_format(LOG_FORMAT_TEXT);
+
+    printf("Test of binary log format and \"set_log_format\" function concluded.\n\n");
+}
+
+/*
+ * Compares two log files ignoring the instant written on the beginning of each line.
+ *
+ * Parameters
+ *  first_file_path - Path to the first log file.
+ *  second_file_path - Path to the second log file.
+ *
+ * Returns
+ *  0 - If both log files have the same lines.
+ *  1 - Otherwise.
+ */
+int compare_log_files(const char* first_file_path, const char* second_file_path) {
+
+    FILE* first_file;
+    FILE* second_file;
+    char first_line[1024];
+    char second_line[1024];
+    char* first_content;
+    char* second_content;
+    char* first_result;
+    char* second_result;
+    int line = 0;
+    int result = 0;
+
+    first_file = fopen(first_file_path, "r");
+    second_file = fopen(second_file_path, "r");
+
+    if ( first_file == NULL || second_file == NULL ) {
+        printf("Could not open log files to compare.\n");
+        if ( first_file != NULL ) {
+            fclose(first_file);
+        }
+        if ( second_file != NULL ) {
+            fclose(second_file);
+        }
+        return 1;
+    }
+
+    do {
+        first_result = fgets(first_line, sizeof(first_line), first_file);
+        second_result = fgets(second_line, sizeof(second_line), second_file);
+        line++;
+
+        if ( first_result == NULL || second_result == NULL ) {
+            if ( first_result != second_result ) {
+                printf("Log files have a different number of lines.\n");
+                result = 1;
+            }
+        }
+        else {
+            first_content = strstr(first_line, "] ");
+            second_content = strstr(second_line, "] ");
+
+            if ( first_content == NULL || second_content == NULL || strcmp(first_content, second_content) != 0 ) {
+                printf("Line %d differs:\n%s%s", line, first_line, second_line);
+                result = 1;
+            }
+        }
+    } while ( first_result != NULL && second_result != NULL && result == 0 );
+
+    fclose(first_file);
+    fclose(second_file);
+
+    return result;
+}
+
+/*
+ * Copies the path of the current log file.
+ *
+ * Parameters
+ *  buffer - Buffer where the log file path will be copied to.
+ *  size - Size of the buffer.
+ *
+ * Returns
+ *  0 - If the log file path was copied successfully.
+ *  1 - Otherwise.
+ */
+int copy_log_file_path(char* buffer, size_t size) {
+
+    char* log_file_path = get_log_file_path();
+
+    if ( log_file_path == NULL ) {
+        buffer[0] = 0;
+        return 1;
+    }
+
+    snprintf(buffer, size, "%s", log_file_path);
+    return 0;
+}
+
+/*
+ * Writes log messages with a sample of the conversions accepted on log formats.
+ *
+ * Parameters
+ *  counter - Value used on message arguments.
+ */
+void write_binary_log_samples(int counter) {
+    LOG_TRACE_POINT;
+
+    static int sample_variable;
+    char* null_string = NULL;
+
+    LOG_TRACE("Counter: %d, hexadecimal: 0x%04x, octal: %o, negative: %ld.", counter, counter, counter, -(long)counter);
+    LOG_TRACE("String: \"%s\", width: [%*d], precision: %.3f, character: %c, percentage: 100%%.", "sample", 6, counter, counter/7.0, 'A' + counter%26);
+    LOG_WARNING("Size: %zu, maximum unsigned long long: %llu, minimum long long: %lld, pointer: %p.", (size_t)counter*3, 18446744073709551615ULL, -9223372036854775807LL - 1, (void*)&sample_variable);
+    LOG_ERROR("Null string: %s, short: %hd, character: %hhu, scientific: %e, left: [%-5d].", null_string, (short)-counter, (unsigned char)counter, counter*1e10, counter);
+
+    LOG_TRACE_POINT;
+}
@@ -0,0 +1,214 @@
+/*
+ * The objetive of this source file is to measure the cost of a trace point for each log level and for trace points removed at compilation.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdint.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "log.h"
+#include "return_codes.h"
+
+/*
+ * Definitions.
+ */
+#define LOG_ROOT_DIRECTORY "../resources/tests/log/test_log_level/"
+
+/* Number of trace points executed on each measure. */
+#define TRACE_POINTS_TO_EXECUTE 1000000
+
+/* Number of trace points executed before waiting for the log writer. Must fit on the log ring (1024 records). */
+#define TRACE_POINTS_PER_BATCH 500
+
+/* Time (in microseconds) waited between checks of the log records not written yet. */
+#define LOG_WRITER_WAIT_TIME 100
+
+/*
+ * Function headers.
+ */
+double get_nanoseconds();
+int measure_trace_points(const char*);
+int measure_trace_points_compiled_out(const char*);
+int print_measure(const char*, const char*, double, uint64_t);
+int test_log_level();
+void wait_log_writer();
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv){
+
+    return test_log_level();
+}
+
+/*
+ * Measures the cost of "LOG_TRACE_POINT" and "LOG_TRACE" macros for each log level.
+ *
+ * Returns
+ *  0 - If every measure was made without discarding log messages.
+ *  1 - Otherwise.
+ */
+int test_log_level(){
+    printf("Measuring the cost of \"LOG_TRACE_POINT\" and \"LOG_TRACE\" macros for each log level.\n");
+
+    char log_directory[256];
+    struct stat stat_struct = {0};
+    int result = 0;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    if ( stat(log_directory, &stat_struct) == -1 && mkdir(log_directory, 0700) != 0 ) {
+        printf("Could not create directory \"%s\".\n", log_directory);
+        return 1;
+    }
+
+    set_log_directory(log_directory);
+
+    if ( open_log_file("test_log_level") != SUCCESS ) {
+        printf("Error opening log file.\n");
+        return 1;
+    }
+
+    printf("Trace points executed on each measure: %d.\n", TRACE_POINTS_TO_EXECUTE);
+    printf("configuration,macro,nanoseconds_per_call,messages_dropped\n");
+
+    set_log_level(LOG_MESSAGE_TYPE_TRACE);
+    result |= measure_trace_points("level_trace");
+
+    set_log_level(LOG_MESSAGE_TYPE_WARNING);
+    result |= measure_trace_points("level_warning");
+
+    set_log_level(LOG_MESSAGE_TYPE_ERROR);
+    result |= measure_trace_points("level_error");
+
+    set_log_level(LOG_MESSAGE_TYPE_TRACE);
+    result |= measure_trace_points_compiled_out("compile_level_warning");
+
+    close_log_file();
+
+    printf("Measure of \"LOG_TRACE_POINT\" and \"LOG_TRACE\" macros concluded%s.\n\n", ( result == 0 ? "" : " with log messages dropped" ));
+
+    return result;
+}
+
+/*
+ * Returns the current monotonic time in nanoseconds.
+ */
+double get_nanoseconds() {
+    struct timespec current_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    return current_time.tv_sec*1e9 + current_time.tv_nsec;
+}
+
+/*
+ * Prints the cost of a macro and the number of log messages dropped while it was measured.
+ *
+ * Returns
+ *  0 - If no log message was dropped.
+ *  1 - Otherwise.
+ */
+int print_measure(const char* configuration, const char* macro, double elapsed_time, uint64_t dropped_messages) {
+    printf("%s,%s,%.2f,%llu\n", configuration, macro, elapsed_time/TRACE_POINTS_TO_EXECUTE, (unsigned long long)dropped_messages);
+    fflush(stdout);
+
+    return ( dropped_messages == 0 ? 0 : 1 );
+}
+
+/*
+ * Waits until the log writer wrote every log record.
+ */
+void wait_log_writer() {
+    struct timespec wait_time;
+
+    wait_time.tv_sec = 0;
+    wait_time.tv_nsec = LOG_WRITER_WAIT_TIME*1000L;
+
+    while ( get_log_pending_records() > 0 ) {
+        nanosleep(&wait_time, NULL);
+    }
+}
+
+/*
+ * Measures the cost of the trace macros compiled with the default compile log level.
+ *
+ * Observations
+ *  The trace points are executed in batches which fit on the log ring and the log writer is waited between them, out of the time measured, so no message is dropped.
+ */
+int measure_trace_points(const char* configuration) {
+    int counter;
+    int batch_counter;
+    double start_time;
+    double elapsed_time;
+    uint64_t dropped_messages;
+    int result = 0;
+
+    elapsed_time = 0;
+    dropped_messages = get_log_dropped_messages();
+    for ( counter = 0; counter < TRACE_POINTS_TO_EXECUTE; counter += TRACE_POINTS_PER_BATCH ) {
+        wait_log_writer();
+        start_time = get_nanoseconds();
+        for ( batch_counter = 0; batch_counter < TRACE_POINTS_PER_BATCH; batch_counter++ ) {
+            LOG_TRACE_POINT;
+        }
+        elapsed_time += get_nanoseconds() - start_time;
+    }
+    result |= print_measure(configuration, "LOG_TRACE_POINT", elapsed_time, get_log_dropped_messages() - dropped_messages);
+
+    elapsed_time = 0;
+    dropped_messages = get_log_dropped_messages();
+    for ( counter = 0; counter < TRACE_POINTS_TO_EXECUTE; counter += TRACE_POINTS_PER_BATCH ) {
+        wait_log_writer();
+        start_time = get_nanoseconds();
+        for ( batch_counter = 0; batch_counter < TRACE_POINTS_PER_BATCH; batch_counter++ ) {
+            LOG_TRACE("Chunk size: %d bytes.", counter + batch_counter);
+        }
+        elapsed_time += get_nanoseconds() - start_time;
+    }
+    result |= print_measure(configuration, "LOG_TRACE", elapsed_time, get_log_dropped_messages() - dropped_messages);
+
+    return result;
+}
+
+/*
+ * The functions below are compiled with trace macros removed, as a build which defines "LOG_COMPILE_LEVEL" does.
+ */
+#undef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_MESSAGE_TYPE_WARNING
+
+/*
+ * Measures the cost of the trace macros removed at compilation.
+ */
+int measure_trace_points_compiled_out(const char* configuration) {
+    int counter;
+    double start_time;
+    uint64_t dropped_messages;
+    int result = 0;
+
+    dropped_messages = get_log_dropped_messages();
+    start_time = get_nanoseconds();
+    for ( counter = 0; counter < TRACE_POINTS_TO_EXECUTE; counter++ ) {
+        LOG_TRACE_POINT;
+    }
+    result |= print_measure(configuration, "LOG_TRACE_POINT", get_nanoseconds() - start_time, get_log_dropped_messages() - dropped_messages);
+
+    dropped_messages = get_log_dropped_messages();
+    start_time = get_nanoseconds();
+    for ( counter = 0; counter < TRACE_POINTS_TO_EXECUTE; counter++ ) {
+        LOG_TRACE("Chunk size: %d bytes.", counter);
+    }
+    result |= print_measure(configuration, "LOG_TRACE", get_nanoseconds() - start_time, get_log_dropped_messages() - dropped_messages);
+
+    return result;
+}
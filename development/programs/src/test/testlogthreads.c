@@ -0,0 +1,497 @@
+/*
+ * The objetive of this source file is to test the log functions with several threads logging at the same time.
+ *
+ * Each thread writes numbered messages as fast as it can. Through the log writer the threads write bursts of messages which
+ * fit together on the log ring and wait for the log writer between them. The log file is read afterwards to check that no
+ * message was lost, that the messages of each thread are in order and with its thread identifier, and that no line was mixed
+ * with another.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <fcntl.h>
+#include <libgen.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "timing.h"
+
+/*
+ * Definitions.
+ */
+
+/* Directory where the log files are written. */
+#define LOG_ROOT_DIRECTORY "../resources/tests/log/"
+
+/* Preffix of the log files written. */
+#define LOG_FILE_PREFFIX "test_log_threads"
+
+/* Name of the program which decodes binary log files. It must be on the same directory of this test program. */
+#define BINARY_LOG_DECODER "annalog"
+
+/* Number of threads logging at the same time. */
+#define THREADS 8
+
+/* Number of messages written by each thread through the log writer. */
+#define MESSAGES_PER_THREAD 50000
+
+/* Number of messages written by each thread before waiting for the log writer. The bursts of all threads must fit on the log ring (1024 records). */
+#define BURST_MESSAGES 64
+
+/* Time (in microseconds) waited between checks of the log records not written yet. */
+#define LOG_WRITER_WAIT_TIME 100
+
+/* Number of messages written by each thread while the log writer is not running. */
+#define SYNCHRONOUS_MESSAGES_PER_THREAD 5000
+
+/* Size of the buffer used to read log file lines. */
+#define LINE_BUFFER_SIZE 1024
+
+/*
+ * Structures.
+ */
+
+/* Informations of a thread which writes log messages. */
+typedef struct {
+    int index;
+    int messages;
+    int thread_identifier;
+    bool throttled;
+    pthread_barrier_t* barrier;
+    pthread_barrier_t* burst_barrier;
+} log_thread_t;
+
+/* Results of the verification of a log file. */
+typedef struct {
+    long records[THREADS];
+    long dropped_messages;
+    long out_of_order;
+    long wrong_thread;
+    long corrupted;
+} log_check_t;
+
+/*
+ * Function headers.
+ */
+int check_log_file(const char*, log_thread_t*, int, log_check_t*);
+int create_directory(const char*);
+int run_log_threads(log_thread_t*, int, bool, uint64_t*);
+int test_log_threads(char*, const char*, int, const char*);
+int test_synchronous_log_threads(const char*);
+void wait_log_writer(log_thread_t*);
+void* write_thread_messages(void*);
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv) {
+
+    char log_directory[256];
+    int result = 0;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+    strcat(log_directory, LOG_FILE_PREFFIX);
+    strcat(log_directory, "/");
+
+    if ( create_directory(LOG_ROOT_DIRECTORY) != 0 || create_directory(log_directory) != 0 ) {
+        return 1;
+    }
+
+    set_log_directory(log_directory);
+    /* Only the messages of the threads are logged, so every message discarded is one of them. */
+    set_log_level(LOG_MESSAGE_TYPE_WARNING);
+
+    printf("format,threads,messages,records_found,messages_dropped,out_of_order,wrong_thread,corrupted,nanoseconds_per_message,result\n");
+
+    result |= test_synchronous_log_threads(log_directory);
+    result |= test_log_threads(argv[0], "Text", LOG_FORMAT_TEXT, log_directory);
+    result |= test_log_threads(argv[0], "Binary", LOG_FORMAT_BINARY, log_directory);
+
+    return result;
+}
+
+/*
+ * Checks the messages written by the threads on a text log file.
+ *
+ * Parameters
+ *  log_file_path - Path to the text log file.
+ *  log_threads - The threads which wrote the messages.
+ *  messages - Number of messages written by each thread.
+ *  log_check - The variable where the results of the verification will be stored.
+ *
+ * Returns
+ *  0 - If every message was found or informed as discarded, in order, and no line was mixed.
+ *  1 - Otherwise.
+ */
+int check_log_file(const char* log_file_path, log_thread_t* log_threads, int messages, log_check_t* log_check) {
+
+    FILE* log_file;
+    char line[LINE_BUFFER_SIZE];
+    char preffix[16];
+    char function[64];
+    char* content;
+    int last_message[THREADS];
+    int thread_identifier;
+    int line_number;
+    int thread_index;
+    int message;
+    int total;
+    unsigned long long dropped_messages;
+    long records = 0;
+    int counter;
+
+    log_file = fopen(log_file_path, "r");
+    if ( log_file == NULL ) {
+        printf("Could not open log file \"%s\".\n", log_file_path);
+        return 1;
+    }
+
+    memset(log_check, 0, sizeof(log_check_t));
+    for ( counter = 0; counter < THREADS; counter++ ) {
+        last_message[counter] = -1;
+    }
+
+    while ( fgets(line, LINE_BUFFER_SIZE, log_file) != NULL ) {
+
+        /* Log files opened on the same second are appended, so only the last log is checked. */
+        if ( strstr(line, "] Log started.") != NULL ) {
+            memset(log_check, 0, sizeof(log_check_t));
+            for ( counter = 0; counter < THREADS; counter++ ) {
+                last_message[counter] = -1;
+            }
+            continue;
+        }
+
+        if ( strstr(line, "log message(s) discarded") != NULL ) {
+            content = strstr(line, "): ");
+            if ( content != NULL && sscanf(content + 3, "%llu", &dropped_messages) == 1 ) {
+                log_check->dropped_messages += dropped_messages;
+            }
+            else {
+                log_check->corrupted++;
+            }
+            continue;
+        }
+
+        if ( strstr(line, "Thread ") == NULL ) {
+            continue;
+        }
+
+        if ( sscanf(line, "[%*[^]]] [%d] %15[A-Z]: %63s (%d): Thread %d message %d of %d.", &thread_identifier, preffix, function, &line_number, &thread_index, &message, &total) != 7 ||
+             thread_index < 0 || thread_index >= THREADS || total != messages || line[strlen(line) - 1] != '\n' ) {
+            log_check->corrupted++;
+            continue;
+        }
+
+        if ( thread_identifier != log_threads[thread_index].thread_identifier ) {
+            log_check->wrong_thread++;
+        }
+
+        if ( message <= last_message[thread_index] ) {
+            log_check->out_of_order++;
+        }
+        last_message[thread_index] = message;
+
+        log_check->records[thread_index]++;
+    }
+
+    fclose(log_file);
+
+    for ( counter = 0; counter < THREADS; counter++ ) {
+        records += log_check->records[counter];
+    }
+
+    if ( records + log_check->dropped_messages != (long)THREADS*messages || log_check->out_of_order != 0 || log_check->wrong_thread != 0 || log_check->corrupted != 0 ) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Creates a directory if it does not exist.
+ *
+ * Parameters
+ *  directory - The directory to be created.
+ *
+ * Returns
+ *  0 - If the directory exists or was created.
+ *  1 - Otherwise.
+ */
+int create_directory(const char* directory) {
+
+    struct stat stat_struct = {0};
+
+    if ( stat(directory, &stat_struct) == -1 && mkdir(directory, 0700) != 0 ) {
+        printf("Could not create directory \"%s\".\n", directory);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Runs the threads which write log messages, starting all of them at the same time.
+ *
+ * Parameters
+ *  log_threads - The threads to be executed.
+ *  messages - Number of messages written by each thread.
+ *  throttled - Indicates if the threads must wait for the log writer after each burst of messages.
+ *  elapsed_time - The variable where the time (in nanoseconds) spent by the threads will be stored.
+ *
+ * Returns
+ *  0 - If all threads were executed.
+ *  1 - Otherwise.
+ */
+int run_log_threads(log_thread_t* log_threads, int messages, bool throttled, uint64_t* elapsed_time) {
+
+    pthread_t threads[THREADS];
+    pthread_barrier_t barrier;
+    pthread_barrier_t burst_barrier;
+    uint64_t start_time;
+    int counter;
+    int result = 0;
+
+    pthread_barrier_init(&barrier, NULL, THREADS + 1);
+    pthread_barrier_init(&burst_barrier, NULL, THREADS);
+
+    for ( counter = 0; counter < THREADS; counter++ ) {
+        log_threads[counter].index = counter;
+        log_threads[counter].messages = messages;
+        log_threads[counter].thread_identifier = 0;
+        log_threads[counter].throttled = throttled;
+        log_threads[counter].barrier = &barrier;
+        log_threads[counter].burst_barrier = &burst_barrier;
+
+        if ( pthread_create(&threads[counter], NULL, write_thread_messages, &log_threads[counter]) != 0 ) {
+            printf("Could not create thread %d.\n", counter);
+            exit(1);
+        }
+    }
+
+    pthread_barrier_wait(&barrier);
+    start_time = get_monotonic_time();
+
+    for ( counter = 0; counter < THREADS; counter++ ) {
+        if ( pthread_join(threads[counter], NULL) != 0 ) {
+            result = 1;
+        }
+    }
+
+    *elapsed_time = get_elapsed_time(start_time);
+
+    pthread_barrier_destroy(&barrier);
+    pthread_barrier_destroy(&burst_barrier);
+
+    return result;
+}
+
+/*
+ * Tests several threads logging through the log writer.
+ *
+ * Parameters
+ *  program_path - Path of this test program. Used to find the binary log decoder.
+ *  format_name - Name of the log format presented on results.
+ *  log_format - The format of the log file.
+ *  log_directory - Directory where the log file is written.
+ *
+ * Returns
+ *  0 - If every message was written on log file.
+ *  1 - Otherwise.
+ *
+ * Observations
+ *  The threads wait for the log writer after each burst of messages, so no message may be discarded. The time per message includes these waits.
+ */
+int test_log_threads(char* program_path, const char* format_name, int log_format, const char* log_directory) {
+
+    log_thread_t log_threads[THREADS];
+    log_check_t log_check;
+    char log_file_path[512];
+    char text_log_file_path[600];
+    char program_directory[512];
+    char command[2048];
+    uint64_t elapsed_time;
+    uint64_t dropped_messages;
+    long records = 0;
+    int result;
+    int counter;
+
+    set_log_format(log_format);
+
+    if ( open_log_file(LOG_FILE_PREFFIX) != 0 ) {
+        printf("Error opening log file.\n");
+        set_log_format(LOG_FORMAT_TEXT);
+        return 1;
+    }
+    snprintf(log_file_path, sizeof(log_file_path), "%s", get_log_file_path());
+
+    dropped_messages = get_log_dropped_messages();
+
+    result = run_log_threads(log_threads, MESSAGES_PER_THREAD, true, &elapsed_time);
+
+    close_log_file();
+    set_log_format(LOG_FORMAT_TEXT);
+
+    dropped_messages = get_log_dropped_messages() - dropped_messages;
+
+    if ( log_format == LOG_FORMAT_BINARY ) {
+        strcpy(program_directory, program_path);
+        snprintf(text_log_file_path, sizeof(text_log_file_path), "%s.txt", log_file_path);
+        snprintf(command, sizeof(command), "%s/%s \"%s\" > \"%s\"", dirname(program_directory), BINARY_LOG_DECODER, log_file_path, text_log_file_path);
+        if ( system(command) != 0 ) {
+            printf("Error decoding binary log file: %s\n", command);
+            return 1;
+        }
+    }
+    else {
+        snprintf(text_log_file_path, sizeof(text_log_file_path), "%s", log_file_path);
+    }
+
+    result |= check_log_file(text_log_file_path, log_threads, MESSAGES_PER_THREAD, &log_check);
+
+    /* No message may be discarded, and every message discarded must be informed on log file. */
+    if ( dropped_messages != 0 || (uint64_t)log_check.dropped_messages != dropped_messages ) {
+        result = 1;
+    }
+
+    for ( counter = 0; counter < THREADS; counter++ ) {
+        records += log_check.records[counter];
+    }
+
+    printf("%s,%d,%d,%ld,%ld,%ld,%ld,%ld,%.1f,%s\n", format_name, THREADS, THREADS*MESSAGES_PER_THREAD, records, log_check.dropped_messages,
+           log_check.out_of_order, log_check.wrong_thread, log_check.corrupted, (double)elapsed_time/(THREADS*MESSAGES_PER_THREAD), ( result == 0 ? "OK" : "FAILED" ));
+
+    return result;
+}
+
+/*
+ * Tests several threads logging while the log writer is not running.
+ *
+ * Parameters
+ *  log_directory - Directory where the messages are written.
+ *
+ * Returns
+ *  0 - If every message was written on standard output.
+ *  1 - Otherwise.
+ *
+ * Observations
+ *  Without a log file open the messages are written on standard output, which is redirected to a file during the test.
+ */
+int test_synchronous_log_threads(const char* log_directory) {
+
+    log_thread_t log_threads[THREADS];
+    log_check_t log_check;
+    char output_file_path[512];
+    uint64_t elapsed_time;
+    long records = 0;
+    int standard_output;
+    int output_file;
+    int result;
+    int counter;
+
+    snprintf(output_file_path, sizeof(output_file_path), "%s%s_synchronous.log", log_directory, LOG_FILE_PREFFIX);
+
+    output_file = open(output_file_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if ( output_file == -1 ) {
+        printf("Could not create file \"%s\".\n", output_file_path);
+        return 1;
+    }
+
+    fflush(stdout);
+    standard_output = dup(STDOUT_FILENO);
+    dup2(output_file, STDOUT_FILENO);
+    close(output_file);
+
+    result = run_log_threads(log_threads, SYNCHRONOUS_MESSAGES_PER_THREAD, false, &elapsed_time);
+
+    fflush(stdout);
+    dup2(standard_output, STDOUT_FILENO);
+    close(standard_output);
+
+    result |= check_log_file(output_file_path, log_threads, SYNCHRONOUS_MESSAGES_PER_THREAD, &log_check);
+
+    /* No message is discarded while the log writer is not running. */
+    if ( log_check.dropped_messages != 0 ) {
+        result = 1;
+    }
+
+    for ( counter = 0; counter < THREADS; counter++ ) {
+        records += log_check.records[counter];
+    }
+
+    printf("Synchronous,%d,%d,%ld,%ld,%ld,%ld,%ld,%.1f,%s\n", THREADS, THREADS*SYNCHRONOUS_MESSAGES_PER_THREAD, records, log_check.dropped_messages,
+           log_check.out_of_order, log_check.wrong_thread, log_check.corrupted, (double)elapsed_time/(THREADS*SYNCHRONOUS_MESSAGES_PER_THREAD), ( result == 0 ? "OK" : "FAILED" ));
+
+    return result;
+}
+
+/*
+ * Waits until the log writer wrote every log record.
+ *
+ * Parameters
+ *  log_thread - The informations of the thread.
+ *
+ * Observations
+ *  Every thread waits for the others to finish their bursts, so the bursts of all threads never exceed the log ring.
+ */
+void wait_log_writer(log_thread_t* log_thread) {
+
+    struct timespec wait_time;
+
+    wait_time.tv_sec = 0;
+    wait_time.tv_nsec = LOG_WRITER_WAIT_TIME*1000L;
+
+    if ( pthread_barrier_wait(log_thread->burst_barrier) == PTHREAD_BARRIER_SERIAL_THREAD ) {
+        while ( get_log_pending_records() > 0 ) {
+            nanosleep(&wait_time, NULL);
+        }
+    }
+
+    pthread_barrier_wait(log_thread->burst_barrier);
+}
+
+/*
+ * Writes the numbered messages of a thread.
+ *
+ * Parameters
+ *  argument - The informations of the thread.
+ *
+ * Returns
+ *  NULL.
+ */
+void* write_thread_messages(void* argument) {
+
+    log_thread_t* log_thread = (log_thread_t*)argument;
+    int counter;
+
+    log_thread->thread_identifier = get_log_thread_identifier();
+
+    pthread_barrier_wait(log_thread->barrier);
+
+    for ( counter = 0; counter < log_thread->messages; counter++ ) {
+        LOG_WARNING("Thread %d message %d of %d.", log_thread->index, counter, log_thread->messages);
+
+        if ( log_thread->throttled == true && ( ( counter + 1 ) % BURST_MESSAGES == 0 || counter + 1 == log_thread->messages ) ) {
+            wait_log_writer(log_thread);
+        }
+    }
+
+    return NULL;
+}
@@ -50,13 +50,14 @@ int main(int argc, char** argv){
 
 
 /*
- * Tests "convert_byte_array_to_package", "convert_package_to_byte_array", "create_check_connection_package", "create_command_result_package", "create_confirmation_package", "create_disconnect_package", "create_error_package", "create_send_file_chunk_package", "create_send_file_header_package", "create_send_file_trailer_package" and "delete_package" functions.
+ * Tests "convert_byte_array_to_package", "convert_package_to_byte_array", "create_check_connection_package", "create_command_result_package", "create_confirmation_package", "create_disconnect_package", "create_error_package", "create_send_file_chunk_package", "create_send_file_header_package", "create_send_file_trailer_package", "create_window_size_package" and "delete_package" functions.
  */
 void test_packages(){
-    printf("Testing \"convert_byte_array_to_package\", \"convert_package_to_byte_array\", \"create_check_connection_package\", \"create_command_result_package\", \"create_confirmation_package\", \"create_disconnect_package\", \"create_error_package\", \"create_send_file_chunk_package\", \"create_send_file_header_package\", \"create_send_file_trailer_package\" and \"delete_package\" functions.\n");
+    printf("Testing \"convert_byte_array_to_package\", \"convert_package_to_byte_array\", \"create_check_connection_package\", \"create_command_result_package\", \"create_confirmation_package\", \"create_disconnect_package\", \"create_error_package\", \"create_send_file_chunk_package\", \"create_send_file_header_package\", \"create_send_file_trailer_package\", \"create_window_size_package\" and \"delete_package\" functions.\n");
 
     char log_directory[256];
     struct timeval execution_time;
+    struct timeval pre_roll_time;
     
     strcpy(log_directory, LOG_ROOT_DIRECTORY);
     /* strcat(log_directory, "test_packages/"); */
@@ -78,7 +79,10 @@ void test_packages(){
     printf("-----------------------\n");
     printf("Command result package:\n");
     printf("-----------------------\n");
-    package_t command_result_package  = create_command_result_package(0x2236, execution_time);
+    pre_roll_time.tv_sec = 1;
+    pre_roll_time.tv_usec = 500000;
+
+    package_t command_result_package  = create_command_result_package(0x2236, execution_time, pre_roll_time);
     test_package(command_result_package);
     delete_package(command_result_package);
 
@@ -119,7 +123,7 @@ void test_packages(){
     printf("-------------------------\n");
     char* file_name = "20170309_141802.mp3";
     int file_size = (int)(3.128*1024*1024);
-    package_t send_file_header_package = create_send_file_header_package(file_size, file_name);
+    package_t send_file_header_package = create_send_file_header_package(file_size, file_name, 0, 0, 0);
     test_package(send_file_header_package);
     delete_package(send_file_header_package);
 
@@ -130,6 +134,13 @@ void test_packages(){
     test_package(send_file_trailer_package);
     delete_package(send_file_trailer_package);
 
+    printf("--------------------\n");
+    printf("Window size package:\n");
+    printf("--------------------\n");
+    package_t window_size_package = create_window_size_package(8);
+    test_package(window_size_package);
+    delete_package(window_size_package);
+
     close_log_file();
 }
 
@@ -182,6 +193,7 @@ void print_package_content(uint32_t package_type, content_t content){
         case COMMAND_RESULT_CODE:
             printf("\tCommand result: 0x%x\n", content.command_result_content->result_code);
             printf("\tDelay time: %06ld.%06ld\n", content.command_result_content->execution_delay.tv_sec, content.command_result_content->execution_delay.tv_usec);
+            printf("\tPre-roll time: %06ld.%06ld\n", content.command_result_content->pre_roll.tv_sec, content.command_result_content->pre_roll.tv_usec);
             break;
         case SEND_FILE_HEADER_CODE:
             printf("\tFile header code: 0x%x\n", content.send_file_header_content->file_header);
@@ -205,6 +217,9 @@ void print_package_content(uint32_t package_type, content_t content){
         case SEND_FILE_TRAILER_CODE:
             printf("\tFile trailer code: 0x%x\n", content.send_file_trailer_content->file_trailer);
             break;
+        case WINDOW_SIZE_CODE:
+            printf("\tWindow size: %u\n", content.window_size_content->window_size);
+            break;
         default:
             printf("Unknown package type!\n");
             break;
@@ -0,0 +1,501 @@
+/*
+ * The objetive of this source file is to measure the encode and decode throughput of every bluetooth package type, along with the memory allocations and copies made per package.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "digest.h"
+#include "log.h"
+#include "return_codes.h"
+#include "bluetooth/package/codes.h"
+#include "bluetooth/package/content/codes.h"
+#include "bluetooth/package/package.h"
+
+/*
+ * Definitions.
+ */
+#define LOG_ROOT_DIRECTORY "../resources/tests/bluetooth/package_codec/"
+
+/* Largest payload measured. Same size of the file chunks sent by "send_file". */
+#define MAXIMUM_PAYLOAD_SIZE (1024*64)
+
+/* Minimum time (in seconds) spent measuring each operation. */
+#define MINIMUM_MEASURE_TIME 0.2
+
+/* Number of packages processed between each elapsed time check. */
+#define PACKAGES_PER_ROUND 64
+
+/* Maximum number of results which can be read from a baseline file. */
+#define MAXIMUM_BASELINE_RESULTS 256
+
+/* Size of the buffer used to read a line from a baseline file. */
+#define BASELINE_LINE_SIZE 512
+
+/* Size of the fields which identify a benchmark result. */
+#define RESULT_NAME_SIZE 32
+
+/*
+ * Structures.
+ */
+
+/* A package type to be measured. */
+typedef struct {
+    const char* name;
+    uint32_t type_code;
+    bool variable_payload;
+} package_type_t;
+
+/* The result of a measure. */
+typedef struct {
+    char operation[RESULT_NAME_SIZE];
+    char package_type[RESULT_NAME_SIZE];
+    size_t payload_size;
+    double packages_per_second;
+    double mallocs_per_package;
+} benchmark_result_t;
+
+/* An operation to be measured. */
+typedef int (*operation_t)(package_t, byte_array_t);
+
+/*
+ * Function headers.
+ */
+extern void* __libc_malloc(size_t);
+extern void* __libc_calloc(size_t, size_t);
+extern void* __libc_realloc(void*, size_t);
+extern void __libc_free(void*);
+
+void benchmark_package_codec(char*);
+package_t build_package(uint32_t, size_t);
+int convert_from_byte_array(package_t, byte_array_t);
+int convert_to_byte_array(package_t, byte_array_t);
+int decode(package_t, byte_array_t);
+int encode(package_t, byte_array_t);
+benchmark_result_t* find_baseline_result(const char*, const char*, size_t);
+double get_seconds();
+void measure_operation(const char*, operation_t, const package_type_t*, size_t);
+int read_baseline(char*);
+
+/*
+ * Variables.
+ */
+
+/* Package types measured. */
+const package_type_t _package_types[] = {
+    { "audio_catalog_page", AUDIO_CATALOG_PAGE_CODE, true },
+    { "check_connection", CHECK_CONNECTION_CODE, false },
+    { "command_result", COMMAND_RESULT_CODE, false },
+    { "confirmation", CONFIRMATION_CODE, false },
+    { "disconnect", DISCONNECT_CODE, false },
+    { "error", ERROR_CODE, true },
+    { "request_audio_catalog", REQUEST_AUDIO_CATALOG_CODE, false },
+    { "request_audio_file", REQUEST_AUDIO_FILE_CODE, false },
+    { "request_audio_file_tail", REQUEST_AUDIO_FILE_TAIL_CODE, false },
+    { "request_audio_record", REQUEST_AUDIO_RECORD_CODE, false },
+    { "request_audio_segments", REQUEST_AUDIO_SEGMENTS_CODE, false },
+    { "resume_transfer", RESUME_TRANSFER_CODE, false },
+    { "send_file_chunk", SEND_FILE_CHUNK_CODE, true },
+    { "send_file_header", SEND_FILE_HEADER_CODE, true },
+    { "send_file_trailer", SEND_FILE_TRAILER_CODE, false },
+    { "start_record", START_RECORD_CODE, false },
+    { "start_stream", START_STREAM_CODE, false },
+    { "stop_record", STOP_RECORD_CODE, false },
+    { "stop_stream", STOP_STREAM_CODE, false },
+    { "window_size", WINDOW_SIZE_CODE, false }
+};
+
+/* Payload sizes measured on package types with variable content. */
+const size_t _payload_sizes[] = { 0, 16, 256, 4096, 16384, MAXIMUM_PAYLOAD_SIZE };
+
+/* Contents of the package being measured. */
+content_storage_t _content_storage;
+
+/* Payload stored on the variable content packages. */
+uint8_t _payload[MAXIMUM_PAYLOAD_SIZE];
+
+/* Buffer used to encode the packages. */
+uint8_t _package_buffer[PACKAGE_MAXIMUM_SIZE];
+
+/* Allocation counters updated by the interposed allocator. */
+size_t _malloc_count = 0;
+size_t _allocated_bytes = 0;
+size_t _copied_bytes = 0;
+
+/* Results read from the baseline file. */
+benchmark_result_t _baseline_results[MAXIMUM_BASELINE_RESULTS];
+size_t _baseline_results_count = 0;
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ *
+ * Parameters
+ *  argv[1] - Path of a file with the results of a previous execution to compare with. (Optional)
+ */
+int main(int argc, char** argv){
+
+    benchmark_package_codec(argc > 1 ? argv[1] : NULL);
+    return 0;
+}
+
+/*
+ * Interposed allocator functions. They count the allocations made and forward them to the C library.
+ */
+void* malloc(size_t size) {
+    _malloc_count++;
+    _allocated_bytes += size;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    _malloc_count++;
+    _allocated_bytes += count*size;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+    _malloc_count++;
+    _allocated_bytes += size;
+    return __libc_realloc(pointer, size);
+}
+
+void free(void* pointer) {
+    __libc_free(pointer);
+}
+
+/*
+ * Interposed "memcpy" function. It counts the bytes copied.
+ *
+ * Observations
+ *  Copies of fixed size fields are inlined by the compiler and do not reach this function, so only the variable size copies are counted.
+ */
+void* memcpy(void* destination, const void* source, size_t size) {
+    _copied_bytes += size;
+    return memmove(destination, source, size);
+}
+
+/*
+ * Measures the encode and decode throughput of every package type and payload size.
+ */
+void benchmark_package_codec(char* baseline_file_path){
+    printf("Measuring encode and decode throughput of bluetooth packages.\n");
+
+    char log_directory[256];
+    size_t type_counter;
+    size_t payload_counter;
+    size_t payload_sizes_count;
+    const package_type_t* package_type;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    set_log_directory(log_directory);
+
+    open_log_file("test_package_codec");
+    set_log_level(LOG_MESSAGE_TYPE_ERROR);
+
+    if ( baseline_file_path != NULL && read_baseline(baseline_file_path) != SUCCESS ) {
+        printf("Could not read baseline file \"%s\".\n", baseline_file_path);
+        close_log_file();
+        return;
+    }
+
+    memset(_payload, 'a', MAXIMUM_PAYLOAD_SIZE);
+
+    printf("operation,package_type,payload_size,package_size,packages_per_second,megabytes_per_second,mallocs_per_package,allocated_bytes_per_package,copied_bytes_per_package");
+    if ( baseline_file_path != NULL ) {
+        printf(",baseline_packages_per_second,throughput_ratio,baseline_mallocs_per_package");
+    }
+    printf("\n");
+    fflush(stdout);
+
+    for ( type_counter = 0; type_counter < sizeof(_package_types)/sizeof(package_type_t); type_counter++ ) {
+        package_type = &_package_types[type_counter];
+
+        payload_sizes_count = 1;
+        if ( package_type->variable_payload == true ) {
+            payload_sizes_count = sizeof(_payload_sizes)/sizeof(size_t);
+        }
+
+        for ( payload_counter = 0; payload_counter < payload_sizes_count; payload_counter++ ) {
+            measure_operation("encode", encode, package_type, _payload_sizes[payload_counter]);
+            measure_operation("decode", decode, package_type, _payload_sizes[payload_counter]);
+            measure_operation("convert_to_byte_array", convert_to_byte_array, package_type, _payload_sizes[payload_counter]);
+            measure_operation("convert_from_byte_array", convert_from_byte_array, package_type, _payload_sizes[payload_counter]);
+        }
+    }
+
+    close_log_file();
+
+    printf("Measure of bluetooth packages throughput concluded.\n\n");
+}
+
+/*
+ * Builds a package of the type informed. Variable contents point to the payload buffer.
+ */
+package_t build_package(uint32_t type_code, size_t payload_size) {
+    package_t package;
+
+    package = create_package(type_code);
+    memset(&_content_storage, 0, sizeof(content_storage_t));
+
+    switch (type_code) {
+        case AUDIO_CATALOG_PAGE_CODE:
+            _content_storage.audio_catalog_page_content.next_record_id = 1;
+            _content_storage.audio_catalog_page_content.records_count = payload_size/AUDIO_CATALOG_RECORD_SIZE;
+            if ( _content_storage.audio_catalog_page_content.records_count > AUDIO_CATALOG_PAGE_MAXIMUM_RECORDS ) {
+                _content_storage.audio_catalog_page_content.records_count = AUDIO_CATALOG_PAGE_MAXIMUM_RECORDS;
+            }
+            _content_storage.audio_catalog_page_content.records_data = _payload;
+            package.content.audio_catalog_page_content = &_content_storage.audio_catalog_page_content;
+            break;
+
+        case COMMAND_RESULT_CODE:
+            _content_storage.command_result_content.result_code = SUCCESS;
+            package.content.command_result_content = &_content_storage.command_result_content;
+            break;
+
+        case CONFIRMATION_CODE:
+            _content_storage.confirmation_content.package_id = package.id;
+            package.content.confirmation_content = &_content_storage.confirmation_content;
+            break;
+
+        case ERROR_CODE:
+            _content_storage.error_content.error_code = GENERIC_ERROR;
+            _content_storage.error_content.error_message_size = payload_size;
+            _content_storage.error_content.error_message = _payload;
+            package.content.error_content = &_content_storage.error_content;
+            break;
+
+        case REQUEST_AUDIO_CATALOG_CODE:
+            _content_storage.audio_catalog_request_content.first_record_id = 1;
+            _content_storage.audio_catalog_request_content.records_count = AUDIO_CATALOG_PAGE_MAXIMUM_RECORDS;
+            package.content.audio_catalog_request_content = &_content_storage.audio_catalog_request_content;
+            break;
+
+        case REQUEST_AUDIO_FILE_TAIL_CODE:
+            _content_storage.file_tail_content.file_offset = MAXIMUM_PAYLOAD_SIZE;
+            _content_storage.file_tail_content.prefix_digest = DIGEST_INITIAL_VALUE;
+            package.content.file_tail_content = &_content_storage.file_tail_content;
+            break;
+
+        case REQUEST_AUDIO_RECORD_CODE:
+            _content_storage.audio_record_request_content.record_id = 1;
+            package.content.audio_record_request_content = &_content_storage.audio_record_request_content;
+            break;
+
+        case RESUME_TRANSFER_CODE:
+            _content_storage.resume_transfer_content.transfer_id = 1;
+            _content_storage.resume_transfer_content.file_offset = MAXIMUM_PAYLOAD_SIZE;
+            package.content.resume_transfer_content = &_content_storage.resume_transfer_content;
+            break;
+
+        case SEND_FILE_CHUNK_CODE:
+            _content_storage.send_file_chunk_content.file_content = SEND_FILE_CHUNK_CONTENT_CODE;
+            _content_storage.send_file_chunk_content.chunk_size = payload_size;
+            _content_storage.send_file_chunk_content.chunk_data = _payload;
+            package.content.send_file_chunk_content = &_content_storage.send_file_chunk_content;
+            break;
+
+        case SEND_FILE_HEADER_CODE:
+            _content_storage.send_file_header_content.file_header = SEND_FILE_HEADER_CONTENT_CODE;
+            _content_storage.send_file_header_content.file_size = MAXIMUM_PAYLOAD_SIZE;
+            _content_storage.send_file_header_content.file_name_size = payload_size;
+            _content_storage.send_file_header_content.file_name = _payload;
+            package.content.send_file_header_content = &_content_storage.send_file_header_content;
+            break;
+
+        case SEND_FILE_TRAILER_CODE:
+            _content_storage.send_file_trailer_content.file_trailer = SEND_FILE_TRAILER_CONTENT_CODE;
+            package.content.send_file_trailer_content = &_content_storage.send_file_trailer_content;
+            break;
+
+        case WINDOW_SIZE_CODE:
+            _content_storage.window_size_content.window_size = 1;
+            package.content.window_size_content = &_content_storage.window_size_content;
+            break;
+
+        default:
+            break;
+    }
+
+    return package;
+}
+
+/*
+ * Converts a byte array to a package through "convert_byte_array_to_package" and deletes it.
+ */
+int convert_from_byte_array(package_t package, byte_array_t byte_array) {
+    package_t package_converted;
+
+    if ( convert_byte_array_to_package(&package_converted, byte_array) != SUCCESS ) {
+        return GENERIC_ERROR;
+    }
+
+    return delete_package(package_converted);
+}
+
+/*
+ * Converts a package to a byte array through "convert_package_to_byte_array" and deletes it.
+ */
+int convert_to_byte_array(package_t package, byte_array_t byte_array) {
+    byte_array_t byte_array_converted;
+
+    if ( convert_package_to_byte_array(&byte_array_converted, package) != SUCCESS ) {
+        return GENERIC_ERROR;
+    }
+
+    return delete_byte_array(&byte_array_converted);
+}
+
+/*
+ * Decodes a byte array to a package through "decode_package".
+ */
+int decode(package_t package, byte_array_t byte_array) {
+    package_view_t package_view;
+
+    return decode_package(&package_view, byte_array);
+}
+
+/*
+ * Encodes a package through "encode_package".
+ */
+int encode(package_t package, byte_array_t byte_array) {
+    size_t package_size;
+
+    return encode_package(_package_buffer, PACKAGE_MAXIMUM_SIZE, package, &package_size);
+}
+
+/*
+ * Returns the result of a baseline file which matches the measure informed.
+ */
+benchmark_result_t* find_baseline_result(const char* operation, const char* package_type, size_t payload_size) {
+    size_t counter;
+
+    for ( counter = 0; counter < _baseline_results_count; counter++ ) {
+        if ( strcmp(_baseline_results[counter].operation, operation) == 0 &&
+             strcmp(_baseline_results[counter].package_type, package_type) == 0 &&
+             _baseline_results[counter].payload_size == payload_size ) {
+            return &_baseline_results[counter];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Returns the current monotonic time in seconds.
+ */
+double get_seconds() {
+    struct timespec current_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    return current_time.tv_sec + current_time.tv_nsec/1e9;
+}
+
+/*
+ * Measures an operation on a package type and prints its result.
+ */
+void measure_operation(const char* operation_name, operation_t operation, const package_type_t* package_type, size_t payload_size) {
+    package_t package;
+    byte_array_t byte_array;
+    size_t package_size;
+    size_t packages_processed = 0;
+    size_t malloc_count;
+    size_t allocated_bytes;
+    size_t copied_bytes;
+    size_t counter;
+    double start_time;
+    double elapsed_time;
+    double packages_per_second;
+    double mallocs_per_package;
+    benchmark_result_t* baseline_result;
+
+    package = build_package(package_type->type_code, payload_size);
+    if ( encode_package(_package_buffer, PACKAGE_MAXIMUM_SIZE, package, &package_size) != SUCCESS ) {
+        printf("Could not encode a \"%s\" package with %zu byte(s) of payload.\n", package_type->name, payload_size);
+        return;
+    }
+
+    byte_array.data = (uint8_t*)__libc_malloc(package_size);
+    byte_array.size = package_size;
+    memmove(byte_array.data, _package_buffer, package_size);
+
+    malloc_count = _malloc_count;
+    allocated_bytes = _allocated_bytes;
+    copied_bytes = _copied_bytes;
+    start_time = get_seconds();
+
+    do {
+        for ( counter = 0; counter < PACKAGES_PER_ROUND; counter++ ) {
+            if ( operation(package, byte_array) != SUCCESS ) {
+                printf("Error while measuring \"%s\" on a \"%s\" package.\n", operation_name, package_type->name);
+                __libc_free(byte_array.data);
+                return;
+            }
+        }
+        packages_processed += PACKAGES_PER_ROUND;
+        elapsed_time = get_seconds() - start_time;
+    } while ( elapsed_time < MINIMUM_MEASURE_TIME );
+
+    malloc_count = _malloc_count - malloc_count;
+    allocated_bytes = _allocated_bytes - allocated_bytes;
+    copied_bytes = _copied_bytes - copied_bytes;
+
+    __libc_free(byte_array.data);
+
+    packages_per_second = packages_processed/elapsed_time;
+    mallocs_per_package = (double)malloc_count/packages_processed;
+
+    printf("%s,%s,%zu,%zu,%.0f,%.2f,%.2f,%.1f,%.1f", operation_name, package_type->name, payload_size, package_size, packages_per_second, packages_per_second*package_size/(1024.0*1024.0), mallocs_per_package, (double)allocated_bytes/packages_processed, (double)copied_bytes/packages_processed);
+
+    if ( _baseline_results_count > 0 ) {
+        baseline_result = find_baseline_result(operation_name, package_type->name, payload_size);
+        if ( baseline_result != NULL ) {
+            printf(",%.0f,%.2f,%.2f", baseline_result->packages_per_second, packages_per_second/baseline_result->packages_per_second, baseline_result->mallocs_per_package);
+        }
+        else {
+            printf(",,,");
+        }
+    }
+
+    printf("\n");
+    fflush(stdout);
+}
+
+/*
+ * Reads the results of a previous execution from a file.
+ */
+int read_baseline(char* baseline_file_path) {
+    FILE* baseline_file;
+    char line[BASELINE_LINE_SIZE];
+    benchmark_result_t* result;
+    size_t package_size;
+    double megabytes_per_second;
+
+    baseline_file = fopen(baseline_file_path, "r");
+    if ( baseline_file == NULL ) {
+        return GENERIC_ERROR;
+    }
+
+    while ( fgets(line, BASELINE_LINE_SIZE, baseline_file) != NULL && _baseline_results_count < MAXIMUM_BASELINE_RESULTS ) {
+        result = &_baseline_results[_baseline_results_count];
+        if ( sscanf(line, "%31[^,],%31[^,],%zu,%zu,%lf,%lf,%lf", result->operation, result->package_type, &result->payload_size, &package_size, &result->packages_per_second, &megabytes_per_second, &result->mallocs_per_package) == 7 ) {
+            _baseline_results_count++;
+        }
+    }
+
+    fclose(baseline_file);
+    return SUCCESS;
+}
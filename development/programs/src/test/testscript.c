@@ -1,5 +1,7 @@
 /*
- * The objetive of this source file is to test all script functions. 
+ * The objetive of this source file is to test all script functions.
+ *
+ * The scripts used on tests are created on a test input directory, so the program scripts are not executed.
  *
  * Version: 0.1
  * Author: Marcelo Leite
@@ -8,15 +10,36 @@
 /*
  * Includes.
  */
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <time.h>
+
+#include "log.h"
+#include "return_codes.h"
 #include "script.h"
 
+/*
+ * Definitions.
+ */
+#define LOG_ROOT_DIRECTORY "../resources/tests/script/"
+#define TEST_INPUT_DIRECTORY "../resources/tests/script/input/"
+#define TEST_SCRIPT_DIRECTORY "../resources/tests/script/input/scripts/"
+
+/* Number of executions on each measure. */
+#define SCRIPT_EXECUTIONS 50
+
 /*
  * Function headers.
  */
+int create_test_script(const char*, const char*);
+uint64_t get_microseconds();
+void measure_script_cost();
+void print_script_statistics(const char*);
 void test_execute_script();
+void test_script_timeout();
 
 
 /*
@@ -27,20 +50,193 @@ void test_execute_script();
  * Main function.
  */
 int main(int argc, char** argv){
+    char log_directory[256];
+    struct stat stat_struct = {0};
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    if ( ( stat(log_directory, &stat_struct) == -1 && mkdir(log_directory, 0700) != 0 ) ||
+         ( stat(TEST_INPUT_DIRECTORY, &stat_struct) == -1 && mkdir(TEST_INPUT_DIRECTORY, 0700) != 0 ) ||
+         ( stat(TEST_SCRIPT_DIRECTORY, &stat_struct) == -1 && mkdir(TEST_SCRIPT_DIRECTORY, 0700) != 0 ) ) {
+        printf("Could not create the test directories.\n");
+        return 1;
+    }
+
+    set_log_directory(log_directory);
+
+    if ( open_log_file("test_script") != SUCCESS ) {
+        printf("Error opening log file.\n");
+        return 1;
+    }
+
+    /* The log level script of the test input directory only accepts the new level. */
+    setenv("ANNA_INPUT_DIRECTORY", TEST_INPUT_DIRECTORY, 1);
+    if ( create_test_script("change_log_level.sh", "exit 0;") != SUCCESS ) {
+        close_log_file();
+        return 1;
+    }
+    set_log_level(LOG_MESSAGE_TYPE_TRACE);
 
     test_execute_script();
+    test_script_timeout();
+    measure_script_cost();
+
+    close_log_file();
     return 0;
 }
 
+/*
+ * Creates a script on the test script directory.
+ */
+int create_test_script(const char* script_name, const char* script_content) {
+    char script_path[256];
+    FILE* script_file;
+
+    snprintf(script_path, sizeof(script_path), "%s%s", TEST_SCRIPT_DIRECTORY, script_name);
+
+    script_file = fopen(script_path, "w");
+    if ( script_file == NULL ) {
+        printf("Could not create script \"%s\".\n", script_path);
+        return GENERIC_ERROR;
+    }
+
+    fprintf(script_file, "#!/bin/bash\n%s\n", script_content);
+    fclose(script_file);
+
+    if ( chmod(script_path, 0700) != 0 ) {
+        printf("Could not allow execution of script \"%s\".\n", script_path);
+        return GENERIC_ERROR;
+    }
+
+    return SUCCESS;
+}
+
+/*
+ * Returns the current monotonic time in microseconds.
+ */
+uint64_t get_microseconds() {
+    struct timespec current_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    return (uint64_t)current_time.tv_sec*1000000 + current_time.tv_nsec/1000;
+}
 
 /*
- * Tests "execute_script" function.
+ * Measures the wall-clock cost of executing an empty script through "execute_script" and through "system".
+ */
+void measure_script_cost(){
+    printf("Measuring the cost of executing a script.\n");
+
+    char command[256];
+    uint64_t start_time;
+    uint64_t execute_script_time;
+    uint64_t system_time;
+    int counter;
+
+    if ( create_test_script("empty.sh", "exit 0;") != SUCCESS ) {
+        return;
+    }
+
+    /* Trace messages would be included on the measure. */
+    set_log_level(LOG_MESSAGE_TYPE_ERROR);
+
+    start_time = get_microseconds();
+    for ( counter = 0; counter < SCRIPT_EXECUTIONS; counter++ ) {
+        execute_script("empty.sh");
+    }
+    execute_script_time = get_microseconds() - start_time;
+
+    snprintf(command, sizeof(command), "%sempty.sh", TEST_SCRIPT_DIRECTORY);
+    start_time = get_microseconds();
+    for ( counter = 0; counter < SCRIPT_EXECUTIONS; counter++ ) {
+        if ( system(command) != 0 ) {
+            printf("Error executing \"%s\" through \"system\".\n", command);
+            break;
+        }
+    }
+    system_time = get_microseconds() - start_time;
+
+    printf("Executions on each measure: %d.\n", SCRIPT_EXECUTIONS);
+    printf("function,microseconds_per_execution\n");
+    printf("execute_script,%llu\n", (unsigned long long)(execute_script_time/SCRIPT_EXECUTIONS));
+    printf("system,%llu\n", (unsigned long long)(system_time/SCRIPT_EXECUTIONS));
+    print_script_statistics("empty.sh");
+
+    printf("Measure of the cost of executing a script concluded.\n\n");
+}
+
+/*
+ * Prints the execution statistics of a script.
+ */
+void print_script_statistics(const char* script_name) {
+    script_statistics_t statistics;
+
+    if ( get_script_statistics(script_name, &statistics) != SUCCESS ) {
+        printf("There are no statistics for script \"%s\".\n", script_name);
+        return;
+    }
+
+    printf("Statistics of \"%s\": %u executions, %u failures, %u timeouts, average time: %llu us, maximum time: %llu us.\n",
+           statistics.script_name,
+           statistics.executions,
+           statistics.failures,
+           statistics.timeouts,
+           (unsigned long long)(statistics.total_time/statistics.executions),
+           (unsigned long long)statistics.maximum_time);
+}
+
+/*
+ * Tests "execute_script" and "execute_script_with_arguments" functions.
  */
 void test_execute_script(){
     printf("Testing \"execute_script\" function.\n");
 
-    /* TODO: Conclude test function. */
-    printf("To be done.\n");
+    char* arguments[] = { "an argument with spaces", "\"quoted\"", "$HOME", NULL };
+    int result;
+
+    if ( create_test_script("print_arguments.sh", "echo \"Arguments: ${#}.\"; for argument in \"${@}\"; do echo \"[${argument}]\"; done; echo \"An error message.\" >&2; exit 3;") != SUCCESS ) {
+        return;
+    }
+
+    result = execute_script_with_arguments("print_arguments.sh", arguments, SCRIPT_DEFAULT_TIMEOUT);
+    printf("Result of \"print_arguments.sh\" (expected 3): %d.\n", result);
+
+    result = execute_script("print_arguments.sh");
+    printf("Result of \"print_arguments.sh\" without arguments (expected 3): %d.\n", result);
+
+    result = execute_script("missing.sh");
+    printf("Result of \"missing.sh\" (expected %d): %d.\n", GENERIC_ERROR, result);
+
+    print_script_statistics("print_arguments.sh");
+    print_script_statistics("missing.sh");
+    printf("The script outputs were written on log file.\n");
 
     printf("Test of function \"execute_script\" concluded.\n\n");
 }
+
+/*
+ * Tests the time limit of "execute_script_with_arguments" function.
+ */
+void test_script_timeout(){
+    printf("Testing the time limit of \"execute_script_with_arguments\" function.\n");
+
+    uint64_t start_time;
+    int result;
+
+    if ( create_test_script("sleep.sh", "sleep 5;") != SUCCESS ||
+         create_test_script("background.sh", "sleep 2 & echo \"Started a process on background.\"; exit 0;") != SUCCESS ) {
+        return;
+    }
+
+    start_time = get_microseconds();
+    result = execute_script_with_arguments("sleep.sh", NULL, 200);
+    printf("Result of \"sleep.sh\" with time limit of 200 ms (expected %d): %d, elapsed time: %llu ms.\n", SCRIPT_TIMED_OUT, result, (unsigned long long)((get_microseconds() - start_time)/1000));
+
+    start_time = get_microseconds();
+    result = execute_script_with_arguments("background.sh", NULL, 1000);
+    printf("Result of \"background.sh\" (expected 0): %d, elapsed time: %llu ms.\n", result, (unsigned long long)((get_microseconds() - start_time)/1000));
+
+    print_script_statistics("sleep.sh");
+
+    printf("Test of the time limit concluded.\n\n");
+}
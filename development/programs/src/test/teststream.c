@@ -0,0 +1,357 @@
+/*
+ * The objetive of this source file is to test the stream transmission for different round trip times.
+ *
+ * The stream content is produced at a fixed rate, as the audio encoder does, and discarded when the stream ring is full. On slow connections the content must be discarded instead of delaying the producer.
+ * Every byte produced must be received, discarded by the producer, discarded by "send_stream" or left on the stream ring.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "byte_ring.h"
+#include "log.h"
+#include "return_codes.h"
+#include "bluetooth/communication.h"
+#include "bluetooth/connection.h"
+#include "bluetooth/package/codes.h"
+
+/*
+ * Definitions.
+ */
+#define LOG_ROOT_DIRECTORY "../resources/tests/bluetooth/stream/"
+#define STREAM_RING_SIZE 32768
+#define FRAME_SIZE 418
+#define FRAME_INTERVAL 26
+#define STREAM_TIME 3000
+#define LINK_RATE 8192
+#define MAXIMUM_PENDING_CONFIRMATIONS 64
+
+/*
+ * Structures.
+ */
+
+/* A confirmation to be sent by the receiver after the round trip time injected. */
+typedef struct {
+    uint32_t package_id;
+    uint64_t due_time;
+} pending_confirmation_t;
+
+/*
+ * Variables.
+ */
+
+/* Ring which holds the stream content produced. */
+byte_ring_t _stream_ring;
+
+/* Indicates if the producer must stop. */
+atomic_bool _producer_finished;
+
+/* Number of bytes produced. */
+atomic_uint_least64_t _bytes_produced;
+
+/* Number of bytes discarded because the stream ring was full. */
+atomic_uint_least64_t _bytes_dropped;
+
+/*
+ * Function headers.
+ */
+uint64_t get_milliseconds();
+int measure_stream(int, int);
+void* produce_stream(void*);
+ssize_t read_test_stream(uint8_t*, size_t);
+void receive_stream(int, int, int, int);
+int test_stream();
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv){
+
+    return test_stream();
+}
+
+/*
+ * Tests "send_stream" for different round trip times and link rates.
+ *
+ * Returns
+ *  0 - If every byte produced was accounted on all measures.
+ *  1 - Otherwise.
+ */
+int test_stream(){
+    printf("Testing \"send_stream\" for different round trip times and link rates.\n");
+
+    char log_directory[256];
+    int round_trip_times[] = { 0, 40, 400 };
+    int link_rates[] = { 0, LINK_RATE };
+    size_t round_trip_counter;
+    size_t link_rate_counter;
+    int result = 0;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    set_log_directory(log_directory);
+
+    open_log_file("test_stream");
+    set_log_level(LOG_MESSAGE_TYPE_ERROR);
+
+    if ( create_byte_ring(&_stream_ring, STREAM_RING_SIZE) != SUCCESS ) {
+        printf("Could not create the stream ring.\n");
+        close_log_file();
+        return 1;
+    }
+
+    printf("Producer rate: %d bytes/s. Stream time: %d ms.\n", FRAME_SIZE*1000/FRAME_INTERVAL, STREAM_TIME);
+    printf("rtt_ms,link_bytes_s,produced,producer_dropped,sent,unconfirmed,sender_discarded,ring_residue,received,result\n");
+    fflush(stdout);
+
+    for ( link_rate_counter = 0; link_rate_counter < sizeof(link_rates)/sizeof(int); link_rate_counter++ ) {
+        for ( round_trip_counter = 0; round_trip_counter < sizeof(round_trip_times)/sizeof(int); round_trip_counter++ ) {
+            result |= measure_stream(round_trip_times[round_trip_counter], link_rates[link_rate_counter]);
+        }
+    }
+
+    delete_byte_ring(&_stream_ring);
+    close_log_file();
+
+    printf("Test of \"send_stream\" concluded.\n\n");
+
+    return result;
+}
+
+/*
+ * Returns the current monotonic time in milliseconds.
+ */
+uint64_t get_milliseconds() {
+    struct timespec current_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    return (uint64_t)current_time.tv_sec*1000 + current_time.tv_nsec/1000000;
+}
+
+/*
+ * Streams content through a local socket to a receiver which delays its confirmations and limits its reading rate.
+ *
+ * Returns
+ *  0 - If the bytes received are the ones sent and every byte produced was accounted.
+ *  1 - Otherwise.
+ *
+ * Observations
+ *  The local socket does not lose content, so the bytes not confirmed were also received.
+ */
+int measure_stream(int round_trip_time, int link_rate) {
+    int socket_fds[2];
+    int report_fds[2];
+    pid_t receiver_pid;
+    pthread_t producer_thread;
+    package_t package;
+    uint64_t bytes_received = 0;
+    uint64_t bytes_produced;
+    uint64_t bytes_dropped;
+    uint64_t ring_residue;
+    stream_statistics_t stream_statistics;
+    int send_stream_result;
+    int result = 0;
+
+    if ( socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds) != 0 || pipe(report_fds) != 0 ) {
+        printf("Could not create socket pair.\n");
+        return 1;
+    }
+
+    receiver_pid = fork();
+    if ( receiver_pid == 0 ) {
+        close(socket_fds[0]);
+        close(report_fds[0]);
+        receive_stream(socket_fds[1], report_fds[1], round_trip_time, link_rate);
+        close_socket(socket_fds[1]);
+        exit(0);
+    }
+
+    close(socket_fds[1]);
+    close(report_fds[1]);
+
+    reset_byte_ring(&_stream_ring);
+    atomic_store(&_producer_finished, false);
+    atomic_store(&_bytes_produced, 0);
+    atomic_store(&_bytes_dropped, 0);
+    pthread_create(&producer_thread, NULL, produce_stream, NULL);
+
+    send_stream_result = send_stream(socket_fds[0], "test_stream.mp3", read_test_stream, &package);
+    stream_statistics = get_stream_statistics();
+
+    atomic_store(&_producer_finished, true);
+    pthread_join(producer_thread, NULL);
+
+    bytes_produced = atomic_load(&_bytes_produced);
+    bytes_dropped = atomic_load(&_bytes_dropped);
+    ring_residue = get_byte_ring_content_size(&_stream_ring);
+
+    close_socket(socket_fds[0]);
+    waitpid(receiver_pid, NULL, 0);
+
+    if ( read(report_fds[0], &bytes_received, sizeof(uint64_t)) != sizeof(uint64_t) ) {
+        bytes_received = 0;
+    }
+    close(report_fds[0]);
+
+    if ( send_stream_result != SUCCESS ) {
+        printf("Error while sending stream (round trip time: %d ms): %d.\n", round_trip_time, send_stream_result);
+        return 1;
+    }
+
+    if ( bytes_received != stream_statistics.bytes_sent || bytes_produced != bytes_received + bytes_dropped + stream_statistics.bytes_discarded + ring_residue ) {
+        result = 1;
+    }
+
+    printf("%d,%d,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%s\n", round_trip_time, link_rate, (unsigned long long)bytes_produced, (unsigned long long)bytes_dropped,
+           (unsigned long long)stream_statistics.bytes_sent, (unsigned long long)stream_statistics.bytes_unconfirmed, (unsigned long long)stream_statistics.bytes_discarded,
+           (unsigned long long)ring_residue, (unsigned long long)bytes_received, ( result == 0 ? "OK" : "FAILED" ));
+    fflush(stdout);
+
+    return result;
+}
+
+/*
+ * Produces stream content at a fixed rate, discarding it when the stream ring is full.
+ */
+void* produce_stream(void* argument) {
+    uint8_t frame[FRAME_SIZE];
+    struct timespec frame_interval;
+
+    memset(frame, 0xff, FRAME_SIZE);
+    frame_interval.tv_sec = 0;
+    frame_interval.tv_nsec = FRAME_INTERVAL*1000000L;
+
+    while ( atomic_load(&_producer_finished) == false ) {
+        if ( write_byte_ring(&_stream_ring, frame, FRAME_SIZE) == false ) {
+            atomic_fetch_add(&_bytes_dropped, FRAME_SIZE);
+        }
+        atomic_fetch_add(&_bytes_produced, FRAME_SIZE);
+        nanosleep(&frame_interval, NULL);
+    }
+
+    return NULL;
+}
+
+/*
+ * Reads the stream content produced.
+ */
+ssize_t read_test_stream(uint8_t* buffer, size_t buffer_size) {
+    return (ssize_t)read_byte_ring(&_stream_ring, buffer, buffer_size);
+}
+
+/*
+ * Receives a stream, sending each package confirmation only after the round trip time informed, and requests it to stop after the stream time.
+ *
+ * The number of bytes received is reported through the report pipe. If a link rate is informed, the receiver waits after each chunk as a connection with that rate would.
+ */
+void receive_stream(int socket_fd, int report_fd, int round_trip_time, int link_rate) {
+    pending_confirmation_t pending_confirmations[MAXIMUM_PENDING_CONFIRMATIONS];
+    size_t pending_count = 0;
+    bool stream_received = false;
+    bool stop_requested = false;
+    byte_array_t byte_array = { .data = NULL, .size = 0 };
+    byte_array_t output_byte_array;
+    package_t package;
+    package_t output_package;
+    struct timeval wait_time;
+    struct timespec link_time;
+    uint64_t current_time;
+    uint64_t stop_time = 0;
+    uint64_t wait_milliseconds;
+    uint64_t bytes_received = 0;
+    int read_result;
+
+    while ( stream_received == false || pending_count > 0 ) {
+
+        read_result = read_socket_content(socket_fd, &byte_array);
+
+        if ( read_result == SUCCESS ) {
+            if ( convert_byte_array_to_package(&package, byte_array) == SUCCESS ) {
+                if ( package.type_code != CONFIRMATION_CODE && pending_count < MAXIMUM_PENDING_CONFIRMATIONS ) {
+                    pending_confirmations[pending_count].package_id = package.id;
+                    pending_confirmations[pending_count].due_time = get_milliseconds() + round_trip_time;
+                    pending_count++;
+                }
+
+                switch ( package.type_code ) {
+                    case SEND_FILE_HEADER_CODE:
+                        stop_time = get_milliseconds() + STREAM_TIME;
+                        break;
+
+                    case SEND_FILE_CHUNK_CODE:
+                        bytes_received += package.content.send_file_chunk_content->chunk_size;
+                        if ( link_rate > 0 ) {
+                            link_time.tv_sec = 0;
+                            link_time.tv_nsec = (long)package.content.send_file_chunk_content->chunk_size*1000000000L/link_rate;
+                            nanosleep(&link_time, NULL);
+                        }
+                        break;
+
+                    case SEND_FILE_TRAILER_CODE:
+                        stream_received = true;
+                        break;
+                }
+                delete_package(package);
+            }
+        }
+        else if ( read_result != NO_CONTENT_TO_READ ) {
+            break;
+        }
+
+        current_time = get_milliseconds();
+        while ( pending_count > 0 && pending_confirmations[0].due_time <= current_time ) {
+            output_package = create_confirmation_package(pending_confirmations[0].package_id);
+            convert_package_to_byte_array(&output_byte_array, output_package);
+            write_content_on_socket(socket_fd, output_byte_array);
+            delete_byte_array(&output_byte_array);
+            delete_package(output_package);
+
+            memmove(&pending_confirmations[0], &pending_confirmations[1], (pending_count - 1)*sizeof(pending_confirmation_t));
+            pending_count--;
+        }
+
+        if ( stop_requested == false && stop_time > 0 && current_time >= stop_time ) {
+            output_package = create_package(STOP_STREAM_CODE);
+            convert_package_to_byte_array(&output_byte_array, output_package);
+            write_content_on_socket(socket_fd, output_byte_array);
+            delete_byte_array(&output_byte_array);
+            delete_package(output_package);
+            stop_requested = true;
+        }
+
+        if ( read_result == NO_CONTENT_TO_READ ) {
+            wait_milliseconds = 20;
+            if ( pending_count > 0 && pending_confirmations[0].due_time - current_time < wait_milliseconds ) {
+                wait_milliseconds = pending_confirmations[0].due_time - current_time;
+            }
+            wait_time.tv_sec = 0;
+            wait_time.tv_usec = wait_milliseconds*1000;
+            check_socket_content(socket_fd, wait_time);
+        }
+    }
+
+    delete_byte_array(&byte_array);
+
+    if ( write(report_fd, &bytes_received, sizeof(uint64_t)) != sizeof(uint64_t) ) {
+        printf("Could not report the bytes received.\n");
+    }
+    close(report_fd);
+}
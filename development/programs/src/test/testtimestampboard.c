@@ -0,0 +1,194 @@
+/*
+ * The objetive of this source file is to test the timestamp board while its instants are published and read concurrently.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "return_codes.h"
+#include "timestamp_board.h"
+#include "timing.h"
+
+/*
+ * Definitions.
+ */
+
+/* Number of instants published by each publisher. */
+#define PUBLICATIONS 200000
+
+/* Number of publishers of the same event. */
+#define PUBLISHERS 2
+
+/* Number of calls executed on each measure. */
+#define CALLS_TO_EXECUTE 1000000
+
+/*
+ * Variables.
+ */
+
+/* Number of publishers still running. */
+atomic_int _publishers_running;
+
+/*
+ * Function headers.
+ */
+void measure_timestamp_board();
+void* publish_timestamps(void*);
+void test_event_timestamps();
+void test_concurrent_timestamps();
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv){
+
+    test_event_timestamps();
+    test_concurrent_timestamps();
+    measure_timestamp_board();
+    return 0;
+}
+
+/*
+ * Measures the cost of "publish_event_timestamp" and "get_event_timestamp" functions.
+ */
+void measure_timestamp_board(){
+    printf("Measuring the cost of \"publish_event_timestamp\" and \"get_event_timestamp\" functions.\n");
+
+    event_timestamp_t event_timestamp;
+    uint64_t start_time;
+    int64_t publish_cost;
+    int64_t read_cost;
+    int counter;
+
+    start_time = get_monotonic_time();
+    for ( counter = 0; counter < CALLS_TO_EXECUTE; counter++ ) {
+        publish_event_timestamp(TIMESTAMP_EVENT_AUDIO_CAPTURE_STARTED);
+    }
+    publish_cost = get_elapsed_time(start_time);
+
+    start_time = get_monotonic_time();
+    for ( counter = 0; counter < CALLS_TO_EXECUTE; counter++ ) {
+        get_event_timestamp(TIMESTAMP_EVENT_AUDIO_CAPTURE_STARTED, &event_timestamp);
+    }
+    read_cost = get_elapsed_time(start_time);
+
+    printf("Calls executed on each measure: %d.\n", CALLS_TO_EXECUTE);
+    printf("function,nanoseconds_per_call\n");
+    printf("publish_event_timestamp,%.1f\n", (double)publish_cost/CALLS_TO_EXECUTE);
+    printf("get_event_timestamp,%.1f\n", (double)read_cost/CALLS_TO_EXECUTE);
+
+    printf("Measure of the cost of the timestamp board concluded.\n\n");
+}
+
+/*
+ * Publishes instants of the "command received" event.
+ */
+void* publish_timestamps(void* argument) {
+    int counter;
+
+    for ( counter = 0; counter < PUBLICATIONS; counter++ ) {
+        publish_event_timestamp(TIMESTAMP_EVENT_COMMAND_RECEIVED);
+    }
+
+    atomic_fetch_sub(&_publishers_running, 1);
+    return NULL;
+}
+
+/*
+ * Tests "publish_event_timestamp", "clear_event_timestamp", "get_event_timestamp" and "get_events_interval" functions.
+ */
+void test_event_timestamps(){
+    printf("Testing \"publish_event_timestamp\", \"clear_event_timestamp\", \"get_event_timestamp\" and \"get_events_interval\" functions.\n");
+
+    event_timestamp_t event_timestamp;
+    struct timespec sleep_time = { .tv_sec = 0, .tv_nsec = 10*NANOSECONDS_PER_MILLISECOND };
+    int64_t interval;
+    int result;
+
+    result = get_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED, &event_timestamp);
+    printf("Result of reading an event never published (expected %d): %d.\n", TIMESTAMP_NOT_PUBLISHED, result);
+
+    result = get_event_timestamp(TIMESTAMP_EVENTS, &event_timestamp);
+    printf("Result of reading an unknown event (expected %d): %d.\n", GENERIC_ERROR, result);
+
+    publish_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED);
+    nanosleep(&sleep_time, NULL);
+    publish_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STOPPED);
+
+    result = get_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED, &event_timestamp);
+    printf("Result of reading an event published (expected %d): %d, publications: %u.\n", SUCCESS, result, event_timestamp.publications);
+
+    result = get_events_interval(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED, TIMESTAMP_EVENT_AUDIO_RECORD_STOPPED, &interval);
+    printf("Interval between events 10 ms apart (result %d): %lld us.\n", result, (long long)(interval/NANOSECONDS_PER_MICROSECOND));
+
+    result = get_events_interval(TIMESTAMP_EVENT_AUDIO_RECORD_STOPPED, TIMESTAMP_EVENT_AUDIO_RECORD_STARTED, &interval);
+    printf("Inverted interval (result %d): %lld us.\n", result, (long long)(interval/NANOSECONDS_PER_MICROSECOND));
+
+    clear_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED);
+    result = get_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED, &event_timestamp);
+    printf("Result of reading an event cleared (expected %d): %d.\n", TIMESTAMP_NOT_PUBLISHED, result);
+
+    publish_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED);
+    result = get_event_timestamp(TIMESTAMP_EVENT_AUDIO_RECORD_STARTED, &event_timestamp);
+    printf("Result of reading an event published after cleared (expected %d): %d, publications: %u.\n", SUCCESS, result, event_timestamp.publications);
+
+    printf("Test of functions \"publish_event_timestamp\", \"clear_event_timestamp\", \"get_event_timestamp\" and \"get_events_interval\" concluded.\n\n");
+}
+
+/*
+ * Reads an event while it is published by other threads, checking every instant read is consistent.
+ */
+void test_concurrent_timestamps(){
+    printf("Testing the timestamp board with %d publishers and one reader.\n", PUBLISHERS);
+
+    pthread_t publisher_threads[PUBLISHERS];
+    event_timestamp_t event_timestamp;
+    event_timestamp_t previous_timestamp = { 0 };
+    uint64_t reads = 0;
+    uint64_t inconsistencies = 0;
+    int counter;
+
+    atomic_store(&_publishers_running, PUBLISHERS);
+    for ( counter = 0; counter < PUBLISHERS; counter++ ) {
+        pthread_create(&publisher_threads[counter], NULL, publish_timestamps, NULL);
+    }
+
+    while ( atomic_load(&_publishers_running) > 0 ) {
+        if ( get_event_timestamp(TIMESTAMP_EVENT_COMMAND_RECEIVED, &event_timestamp) != SUCCESS ) {
+            continue;
+        }
+        reads++;
+
+        /* Instants are published in order, so neither the publications nor the times read can go back. */
+        if ( event_timestamp.publications < previous_timestamp.publications ||
+             event_timestamp.monotonic_time < previous_timestamp.monotonic_time ||
+             ( event_timestamp.publications == previous_timestamp.publications && event_timestamp.monotonic_time != previous_timestamp.monotonic_time ) ) {
+            inconsistencies++;
+        }
+        previous_timestamp = event_timestamp;
+    }
+
+    for ( counter = 0; counter < PUBLISHERS; counter++ ) {
+        pthread_join(publisher_threads[counter], NULL);
+    }
+
+    get_event_timestamp(TIMESTAMP_EVENT_COMMAND_RECEIVED, &event_timestamp);
+    printf("Publications (expected %d): %u.\n", PUBLISHERS*PUBLICATIONS, event_timestamp.publications);
+    printf("Instants read: %llu, inconsistencies (expected 0): %llu.\n", (unsigned long long)reads, (unsigned long long)inconsistencies);
+
+    printf("Test of the timestamp board concluded.\n\n");
+}
@@ -0,0 +1,130 @@
+/*
+ * The objetive of this source file is to test all timing functions and to measure their cost.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdio.h>
+
+#include "timing.h"
+
+/*
+ * Definitions.
+ */
+
+/* Number of calls executed on each measure. */
+#define CALLS_TO_EXECUTE 1000000
+
+/*
+ * Function headers.
+ */
+void measure_timing_functions();
+void print_conversion(int64_t);
+void test_time_conversions();
+void test_time_difference();
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv){
+
+    test_time_conversions();
+    test_time_difference();
+    measure_timing_functions();
+    return 0;
+}
+
+/*
+ * Measures the cost of "get_monotonic_time" and "get_boot_time" functions.
+ */
+void measure_timing_functions(){
+    printf("Measuring the cost of \"get_monotonic_time\" and \"get_boot_time\" functions.\n");
+
+    uint64_t start_time;
+    int64_t monotonic_time_cost;
+    int64_t boot_time_cost;
+    volatile uint64_t time_read;
+    int counter;
+
+    start_time = get_monotonic_time();
+    for ( counter = 0; counter < CALLS_TO_EXECUTE; counter++ ) {
+        time_read = get_monotonic_time();
+    }
+    monotonic_time_cost = get_elapsed_time(start_time);
+
+    start_time = get_monotonic_time();
+    for ( counter = 0; counter < CALLS_TO_EXECUTE; counter++ ) {
+        time_read = get_boot_time();
+    }
+    boot_time_cost = get_elapsed_time(start_time);
+    (void)time_read;
+
+    printf("Calls executed on each measure: %d.\n", CALLS_TO_EXECUTE);
+    printf("function,nanoseconds_per_call\n");
+    printf("get_monotonic_time,%.1f\n", (double)monotonic_time_cost/CALLS_TO_EXECUTE);
+    printf("get_boot_time,%.1f\n", (double)boot_time_cost/CALLS_TO_EXECUTE);
+
+    printf("Measure of the cost of timing functions concluded.\n\n");
+}
+
+/*
+ * Prints a time interval converted to "timespec" and "timeval" structures.
+ */
+void print_conversion(int64_t nanoseconds) {
+    struct timespec time_interval;
+    struct timeval time_value;
+
+    time_interval = convert_nanoseconds_to_timespec(nanoseconds);
+    time_value = convert_nanoseconds_to_timeval(nanoseconds);
+
+    printf("%lld ns: timespec %ld.%09ld, timeval %ld.%06ld.\n", (long long)nanoseconds, (long)time_interval.tv_sec, time_interval.tv_nsec, (long)time_value.tv_sec, (long)time_value.tv_usec);
+}
+
+/*
+ * Tests "convert_nanoseconds_to_timespec" and "convert_nanoseconds_to_timeval" functions.
+ */
+void test_time_conversions(){
+    printf("Testing \"convert_nanoseconds_to_timespec\" and \"convert_nanoseconds_to_timeval\" functions.\n");
+
+    print_conversion(0);
+    print_conversion(1500);
+    print_conversion(1234567890123LL);
+    print_conversion(-1500);
+    print_conversion(-2*NANOSECONDS_PER_SECOND);
+
+    /* A day and a microsecond, which a 24-bit mantissa could not represent. */
+    print_conversion(86400*NANOSECONDS_PER_SECOND + NANOSECONDS_PER_MICROSECOND);
+
+    printf("Test of functions \"convert_nanoseconds_to_timespec\" and \"convert_nanoseconds_to_timeval\" concluded.\n\n");
+}
+
+/*
+ * Tests "get_time_difference" and "get_elapsed_time" functions.
+ */
+void test_time_difference(){
+    printf("Testing \"get_time_difference\" and \"get_elapsed_time\" functions.\n");
+
+    uint64_t start_time;
+    uint64_t current_time;
+    struct timespec sleep_time = { .tv_sec = 0, .tv_nsec = 20*NANOSECONDS_PER_MILLISECOND };
+
+    start_time = get_monotonic_time();
+    nanosleep(&sleep_time, NULL);
+    current_time = get_monotonic_time();
+
+    printf("Difference after sleeping 20 ms: %lld ns.\n", (long long)get_time_difference(current_time, start_time));
+    printf("Inverted difference: %lld ns.\n", (long long)get_time_difference(start_time, current_time));
+    printf("Elapsed time is at least the difference: %s.\n", ( get_elapsed_time(start_time) >= get_time_difference(current_time, start_time) ? "yes" : "no" ));
+
+    printf("Test of functions \"get_time_difference\" and \"get_elapsed_time\" concluded.\n\n");
+}
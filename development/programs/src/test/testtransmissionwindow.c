@@ -0,0 +1,244 @@
+/*
+ * The objetive of this source file is to measure the file transmission throughput for different transmission window sizes and round trip times.
+ *
+ * Version: 0.1
+ * Author: Marcelo Leite
+ */
+
+/*
+ * Includes.
+ */
+
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "return_codes.h"
+#include "bluetooth/communication.h"
+#include "bluetooth/connection.h"
+#include "bluetooth/package/codes.h"
+
+/*
+ * Definitions.
+ */
+#define LOG_ROOT_DIRECTORY "../resources/tests/bluetooth/transmission_window/"
+#define TEST_FILE_PATH "/tmp/testtransmissionwindow.dat"
+#define TEST_FILE_SIZE (1024*1024*4)
+#define MAXIMUM_PENDING_CONFIRMATIONS 64
+
+/*
+ * Structures.
+ */
+
+/* A confirmation to be sent by the receiver after the round trip time injected. */
+typedef struct {
+    uint32_t package_id;
+    uint64_t due_time;
+} pending_confirmation_t;
+
+/*
+ * Function headers.
+ */
+int create_test_file(char*, size_t);
+uint64_t get_milliseconds();
+double measure_transmission(char*, size_t, uint32_t, int);
+void receive_file(int, int);
+void test_transmission_window();
+
+
+/*
+ * Function elaborations.
+ */
+
+/*
+ * Main function.
+ */
+int main(int argc, char** argv){
+
+    test_transmission_window();
+    return 0;
+}
+
+/*
+ * Tests "send_file" throughput for different "set_transmission_window_size" values and round trip times.
+ */
+void test_transmission_window(){
+    printf("Testing \"send_file\" throughput for different \"set_transmission_window_size\" values and round trip times.\n");
+
+    char log_directory[256];
+    uint32_t window_sizes[] = { 1, 2, 4, 8, 16, 32 };
+    int round_trip_times[] = { 0, 10, 40 };
+    size_t window_counter;
+    size_t round_trip_counter;
+    double throughput;
+
+    strcpy(log_directory, LOG_ROOT_DIRECTORY);
+
+    set_log_directory(log_directory);
+
+    open_log_file("test_transmission_window");
+    set_log_level(LOG_MESSAGE_TYPE_ERROR);
+
+    if ( create_test_file(TEST_FILE_PATH, TEST_FILE_SIZE) != SUCCESS ) {
+        printf("Could not create test file \"%s\".\n", TEST_FILE_PATH);
+        close_log_file();
+        return;
+    }
+
+    printf("File size: %d bytes.\n", TEST_FILE_SIZE);
+    printf("window_size,rtt_ms,throughput_kib_s\n");
+    fflush(stdout);
+
+    for ( round_trip_counter = 0; round_trip_counter < sizeof(round_trip_times)/sizeof(int); round_trip_counter++ ) {
+        for ( window_counter = 0; window_counter < sizeof(window_sizes)/sizeof(uint32_t); window_counter++ ) {
+            throughput = measure_transmission(TEST_FILE_PATH, TEST_FILE_SIZE, window_sizes[window_counter], round_trip_times[round_trip_counter]);
+            printf("%u,%d,%.1f\n", window_sizes[window_counter], round_trip_times[round_trip_counter], throughput);
+            fflush(stdout);
+        }
+    }
+
+    remove(TEST_FILE_PATH);
+    close_log_file();
+
+    printf("Test of \"send_file\" throughput concluded.\n\n");
+}
+
+/*
+ * Creates a file with random content.
+ */
+int create_test_file(char* file_path, size_t file_size) {
+    FILE* file;
+    size_t counter;
+
+    file = fopen(file_path, "w");
+    if ( file == NULL ) {
+        return GENERIC_ERROR;
+    }
+
+    for ( counter = 0; counter < file_size; counter++ ) {
+        fputc(rand(), file);
+    }
+
+    fclose(file);
+    return SUCCESS;
+}
+
+/*
+ * Returns the current monotonic time in milliseconds.
+ */
+uint64_t get_milliseconds() {
+    struct timespec current_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    return (uint64_t)current_time.tv_sec*1000 + current_time.tv_nsec/1000000;
+}
+
+/*
+ * Sends a file through a local socket to a receiver which delays its confirmations, returning the throughput in KiB/s.
+ */
+double measure_transmission(char* file_path, size_t file_size, uint32_t window_size, int round_trip_time) {
+    int socket_fds[2];
+    pid_t receiver_pid;
+    struct timespec start_time;
+    struct timespec end_time;
+    double elapsed_time;
+    int send_file_result;
+
+    if ( socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds) != 0 ) {
+        printf("Could not create socket pair.\n");
+        return 0;
+    }
+
+    receiver_pid = fork();
+    if ( receiver_pid == 0 ) {
+        close(socket_fds[0]);
+        receive_file(socket_fds[1], round_trip_time);
+        close_socket(socket_fds[1]);
+        exit(0);
+    }
+
+    close(socket_fds[1]);
+
+    set_transmission_window_size(window_size);
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    send_file_result = send_file(socket_fds[0], file_path);
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+
+    close_socket(socket_fds[0]);
+    waitpid(receiver_pid, NULL, 0);
+
+    if ( send_file_result != SUCCESS ) {
+        printf("Error while sending file (window size: %u, round trip time: %d ms).\n", window_size, round_trip_time);
+        return 0;
+    }
+
+    elapsed_time = (end_time.tv_sec - start_time.tv_sec) + (end_time.tv_nsec - start_time.tv_nsec)/1e9;
+    return (file_size/1024.0)/elapsed_time;
+}
+
+/*
+ * Receives a file, sending each package confirmation only after the round trip time informed.
+ */
+void receive_file(int socket_fd, int round_trip_time) {
+    pending_confirmation_t pending_confirmations[MAXIMUM_PENDING_CONFIRMATIONS];
+    size_t pending_count = 0;
+    bool file_received = false;
+    byte_array_t byte_array = { .data = NULL, .size = 0 };
+    byte_array_t confirmation_byte_array;
+    package_t package;
+    package_t confirmation_package;
+    struct timeval wait_time;
+    uint64_t current_time;
+    uint64_t wait_milliseconds;
+    int read_result;
+
+    while ( file_received == false || pending_count > 0 ) {
+
+        read_result = read_socket_content(socket_fd, &byte_array);
+
+        if ( read_result == SUCCESS ) {
+            if ( convert_byte_array_to_package(&package, byte_array) == SUCCESS ) {
+                if ( pending_count < MAXIMUM_PENDING_CONFIRMATIONS ) {
+                    pending_confirmations[pending_count].package_id = package.id;
+                    pending_confirmations[pending_count].due_time = get_milliseconds() + round_trip_time;
+                    pending_count++;
+                }
+                if ( package.type_code == SEND_FILE_TRAILER_CODE ) {
+                    file_received = true;
+                }
+                delete_package(package);
+            }
+        }
+        else if ( read_result != NO_CONTENT_TO_READ ) {
+            break;
+        }
+
+        current_time = get_milliseconds();
+        while ( pending_count > 0 && pending_confirmations[0].due_time <= current_time ) {
+            confirmation_package = create_confirmation_package(pending_confirmations[0].package_id);
+            convert_package_to_byte_array(&confirmation_byte_array, confirmation_package);
+            write_content_on_socket(socket_fd, confirmation_byte_array);
+            delete_byte_array(&confirmation_byte_array);
+            delete_package(confirmation_package);
+
+            memmove(&pending_confirmations[0], &pending_confirmations[1], (pending_count - 1)*sizeof(pending_confirmation_t));
+            pending_count--;
+        }
+
+        if ( read_result == NO_CONTENT_TO_READ ) {
+            wait_milliseconds = 100;
+            if ( pending_count > 0 ) {
+                wait_milliseconds = pending_confirmations[0].due_time - current_time;
+            }
+            wait_time.tv_sec = wait_milliseconds/1000;
+            wait_time.tv_usec = (wait_milliseconds%1000)*1000;
+            check_socket_content(socket_fd, wait_time);
+        }
+    }
+
+    delete_byte_array(&byte_array);
+}
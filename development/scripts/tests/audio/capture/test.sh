@@ -1,15 +0,0 @@
-#!/bin/bash
-
-# The objective of this script is to test all audio capture functions.
-#
-# Version: 0.1
-# Author: Marcelo Leite
-
-# Load audio capture functions.
-source "$(dirname ${BASH_SOURCE})/../../../deploy/audio/capture/functions.sh";
-
-# Load log functions.
-source "$(dirname ${BASH_SOURCE})/../../../deploy/log/functions.sh";
-
-# TODO: Test "start_audio_capture_process".
-# TODO: Test "stop_audio_capture_process".